@@ -42,6 +42,7 @@ ZnesContext* znes_context_new(bool scripting)
     ctx->program = znes_program_new(scripting);
     ctx->operands = znes_operand_pool_new();
     ctx->errors = NULL;
+    ctx->temp_slots = NULL;
     return ctx;
 }
 
@@ -58,6 +59,7 @@ void znes_context_free(ZnesContext *ctx)
     if (ctx->program) znes_program_free(ctx->program);
     if (ctx->errors) fl_list_free(ctx->errors);
     if (ctx->operands) znes_operand_pool_free(ctx->operands);
+    if (ctx->temp_slots) znes_temp_slots_free(ctx->temp_slots);
     fl_free(ctx);
 }
 
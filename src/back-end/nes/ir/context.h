@@ -3,6 +3,7 @@
 
 #include "program.h"
 #include "operands/pool.h"
+#include "liveness.h"
 
 /*
  * Macro: znes_context_error_count
@@ -60,11 +61,14 @@ typedef FlList ZnesErrorList;
  * Members:
  *  <ZnesErrorList> *errors: List of <ZnesError> objects that occur in the compilation process
  *  <ZnesProgram> *program: The object that contains the program being compiled
+ *  <ZnesOperandPool> *operands: Keeps track of the NES operands
+ *  <ZnesTempSlots> *temp_slots: Slots assigned to the temporal symbols of the ZIR block being visited
  */
 typedef struct ZnesContext {
     ZnesErrorList *errors;
     ZnesProgram *program;
     ZnesOperandPool *operands;
+    ZnesTempSlots *temp_slots;
 } ZnesContext;
 
 /*
@@ -4,6 +4,7 @@
 
 #include "utils.h"
 #include "operands/array.h"
+#include "operands/blob.h"
 #include "operands/bool.h"
 #include "operands/reference.h"
 #include "operands/struct.h"
@@ -23,14 +24,18 @@ typedef void(*ZirInstructionVisitor)(ZnesContext *znes_context, ZirInstr *instru
 static void visit_zir_instruction(ZnesContext *znes_context, ZirInstr *instruction, ZirBlock *block);
 static void visit_zir_variable_instruction(ZnesContext *znes_context, ZirVariableInstr *instruction, ZirBlock *block);
 static void visit_cast_instruction(ZnesContext *znes_context, ZirCastInstr *instruction, ZirBlock *block);
-static void visit_if_false_instruction(ZnesContext *znes_context, ZirIfFalseInstr *instruction, ZirBlock *block);
-static void visit_jump_instruction(ZnesContext *znes_context, ZirJumpInstr *instruction, ZirBlock *block);
+static void visit_phi_instruction(ZnesContext *znes_context, ZirPhiInstr *instruction, ZirBlock *block);
+static void visit_if_false_instruction(ZnesContext *znes_context, ZirIfFalseInstr *instruction, ZnesUintOperand *jump_offset);
+static void visit_jump_instruction(ZnesContext *znes_context, ZirJumpInstr *instruction, ZnesUintOperand *jump_offset);
+static bool reject_blob_copy(ZnesContext *znes_context, ZnesOperand *operand);
 
 static const ZirInstructionVisitor zir_instruction_visitors[] = {
     [ZIR_INSTR_VARIABLE]    = (ZirInstructionVisitor) &visit_zir_variable_instruction,
     [ZIR_INSTR_CAST]        = (ZirInstructionVisitor) &visit_cast_instruction,
-    [ZIR_INSTR_IF_FALSE]    = (ZirInstructionVisitor) &visit_if_false_instruction,
-    [ZIR_INSTR_JUMP]        = (ZirInstructionVisitor) &visit_jump_instruction,
+    // The terminators are visited by <visit_zir_terminator>
+    [ZIR_INSTR_IF_FALSE]    = NULL,
+    [ZIR_INSTR_JUMP]        = NULL,
+    [ZIR_INSTR_PHI]         = (ZirInstructionVisitor) &visit_phi_instruction,
 };
 
 static bool znes_allocation_setup_aggregates(ZnesContext *znes_context, ZnesAlloc *allocation, ZirType *zir_type)
@@ -68,6 +73,9 @@ static bool znes_allocation_setup_aggregates(ZnesContext *znes_context, ZnesAllo
                                                 znes_item_alloc_size,                               // The size of the allocation is defined by the members type
                                                 allocation->address + (znes_item_alloc_size * i));  // The address is based on the position of the item and its size
 
+            // The item lives in the same PRG-ROM bank of the array
+            znes_item_allocation->bank = allocation->bank;
+
             // The item might be an aggregate too, we ensure we setup all the allocations recursively
             znes_allocation_setup_aggregates(znes_context, znes_item_allocation, zir_array_type->member_type);
 
@@ -106,6 +114,9 @@ static bool znes_allocation_setup_aggregates(ZnesContext *znes_context, ZnesAllo
                                                                 znes_member_alloc_size,                 // The size of the allocation is defined by the members type
                                                                 allocation->address + gap);             // The address is based on the current gap
 
+            // The member lives in the same PRG-ROM bank of the struct
+            znes_member_allocation->bank = allocation->bank;
+
             // The member might be an aggregate too, we ensure we setup all the allocations recursively
             znes_allocation_setup_aggregates(znes_context, znes_member_allocation, zir_struct_member->type);
 
@@ -126,51 +137,59 @@ static bool znes_allocation_setup_aggregates(ZnesContext *znes_context, ZnesAllo
     return false;
 }
 
-static void visit_jump_instruction(ZnesContext *znes_context, ZirJumpInstr *zir_instruction, ZirBlock *zir_block)
+static void visit_jump_instruction(ZnesContext *znes_context, ZirJumpInstr *zir_instruction, ZnesUintOperand *jump_offset)
 {
-    // The destination of an jump instruction is a jump offset
-    // TODO: WE ARE USING UINT FOR THE JUMP, WE SHOULD UPDATE THIS TO SIGNED INT AS THE TYPES IN ZIR CHANGE
-    //       TO ALLOW JUMPING BACKWARDS
-    if (zir_instruction->base.destination->type != ZIR_OPERAND_UINT)
-    {
-        znes_context_error(znes_context, ZNES_ERROR_INTERNAL, "Invalid operand type for jump offset in visit_jump_instruction");
-        return;
-    }
+    ZnesJumpInstruction *jump_instruction = znes_jump_instruction_new(jump_offset);
+
+    znes_program_emit_instruction(znes_context->program, (ZnesInstruction*) jump_instruction);
+}
 
-    ZnesUintOperand *jump_offset = (ZnesUintOperand*) znes_utils_make_nes_operand(znes_context, zir_instruction->base.destination);
+static void visit_if_false_instruction(ZnesContext *znes_context, ZirIfFalseInstr *zir_instruction, ZnesUintOperand *jump_offset)
+{
+    // Create the source operand
+    ZnesOperand *znes_source_operand = znes_utils_make_nes_operand(znes_context, zir_instruction->source);
 
-    if (jump_offset == NULL)
+    if (znes_source_operand == NULL)
         return;
 
-    ZnesJumpInstruction *jump_instruction = znes_jump_instruction_new(jump_offset);
+    ZnesIfFalseInstruction *if_false_instruction = znes_if_false_instruction_new(jump_offset, znes_source_operand);
 
-    znes_program_emit_instruction(znes_context->program, (ZnesInstruction*) jump_instruction);
+    znes_program_emit_instruction(znes_context->program, (ZnesInstruction*) if_false_instruction);
 }
 
-static void visit_if_false_instruction(ZnesContext *znes_context, ZirIfFalseInstr *zir_instruction, ZirBlock *zir_block)
+/*
+ * Function: visit_zir_terminator
+ *  The NES IR does not have basic blocks, the jump and if-false instructions use the number of instructions
+ *  to skip as the jump offset. Each ZIR instruction becomes one NES IR instruction, so the offset is the
+ *  difference between the index of the target block's first instruction and the index of the terminator
+ *
+ * Parameters:
+ *  <ZnesContext> *znes_context: The NES context
+ *  <ZirInstr> *terminator: The jump or if-false instruction
+ *  <size_t> ip: The index of the terminator
+ *  <size_t> target_ip: The index of the first instruction of the target block
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+static void visit_zir_terminator(ZnesContext *znes_context, ZirInstr *terminator, size_t ip, size_t target_ip)
 {
-    // The destination of an if_false instruction is a jump offset
     // TODO: WE ARE USING UINT FOR THE JUMP, WE SHOULD UPDATE THIS TO SIGNED INT AS THE TYPES IN ZIR CHANGE
     //       TO ALLOW JUMPING BACKWARDS
-    if (zir_instruction->base.destination->type != ZIR_OPERAND_UINT)
+    if (target_ip < ip || target_ip - ip > UINT16_MAX)
     {
-        znes_context_error(znes_context, ZNES_ERROR_INTERNAL, "Invalid operand type for jump offset in visit_if_false_instruction");
+        znes_context_error(znes_context, ZNES_ERROR_INTERNAL, "Unaddressable jump from instruction %zu to instruction %zu", ip, target_ip);
         return;
     }
-    ZnesUintOperand *jump_offset = (ZnesUintOperand*) znes_utils_make_nes_operand(znes_context, zir_instruction->base.destination);
-
-    if (jump_offset == NULL)
-        return;
 
-    // Create the source operand
-    ZnesOperand *znes_source_operand = znes_utils_make_nes_operand(znes_context, zir_instruction->source);
+    ZnesUintOperand *jump_offset = znes_operand_pool_new_uint(znes_context->operands, ZNES_UINT_16, (ZnesUintValue) { .uint16 = (uint16_t) (target_ip - ip) });
 
-    if (znes_source_operand == NULL)
-        return;
-
-    ZnesIfFalseInstruction *if_false_instruction = znes_if_false_instruction_new(jump_offset, znes_source_operand);
+    znes_context->program->origin = terminator->origin;
 
-    znes_program_emit_instruction(znes_context->program, (ZnesInstruction*) if_false_instruction);
+    if (terminator->type == ZIR_INSTR_IF_FALSE)
+        visit_if_false_instruction(znes_context, (ZirIfFalseInstr*) terminator, jump_offset);
+    else
+        visit_jump_instruction(znes_context, (ZirJumpInstr*) terminator, jump_offset);
 }
 
 /*
@@ -192,7 +211,7 @@ static void visit_cast_instruction(ZnesContext *znes_context, ZirCastInstr *inst
     // A cast has a source value, we need to create a NES operand
     ZnesOperand *znes_source_operand = znes_utils_make_nes_operand(znes_context, instruction->source);
 
-    if (znes_source_operand == NULL)
+    if (znes_source_operand == NULL || reject_blob_copy(znes_context, znes_source_operand))
         return;
 
     // A cast creates has a destination symbol
@@ -221,12 +240,117 @@ static void visit_cast_instruction(ZnesContext *znes_context, ZirCastInstr *inst
         return;
 }
 
+static void visit_phi_instruction(ZnesContext *znes_context, ZirPhiInstr *instruction, ZirBlock *block)
+{
+    // The phi instructions are removed by the SSA destruction pass, the NES program does not support them
+    znes_context_error(znes_context, ZNES_ERROR_INTERNAL, 
+        "Unexpected phi instruction for symbol %s, the ZIR program must be out of SSA form",
+        ((ZirSymbolOperand*) instruction->base.destination)->symbol->name);
+}
+
+/*
+ * Function: is_constant_operand
+ *  Returns true if the operand is known at compile time, that is, it does not read nor reference
+ *  other variables
+ */
+static bool is_constant_operand(ZnesOperand *operand)
+{
+    if (operand->type == ZNES_OPERAND_UINT || operand->type == ZNES_OPERAND_BOOL || operand->type == ZNES_OPERAND_BLOB)
+        return true;
+
+    if (operand->type == ZNES_OPERAND_ARRAY)
+    {
+        ZnesArrayOperand *array_operand = (ZnesArrayOperand*) operand;
+
+        for (size_t i=0; i < fl_array_length(array_operand->elements); i++)
+            if (!is_constant_operand(array_operand->elements[i]))
+                return false;
+
+        return true;
+    }
+
+    if (operand->type == ZNES_OPERAND_STRUCT)
+    {
+        ZnesStructOperand *struct_operand = (ZnesStructOperand*) operand;
+
+        for (size_t i=0; i < fl_array_length(struct_operand->members); i++)
+            if (!is_constant_operand(struct_operand->members[i]->operand))
+                return false;
+
+        return true;
+    }
+
+    return false;
+}
+
+/*
+ * Function: find_blob_copy
+ *  The variables initialized with a blob do not have an allocation for each element, so they can be
+ *  referenced but not copied. This function returns the first variable of that kind the operand reads
+ *  from, or NULL if there is none
+ */
+static ZnesAlloc* find_blob_copy(ZnesOperand *operand)
+{
+    if (operand->type == ZNES_OPERAND_VARIABLE)
+    {
+        ZnesAlloc *variable = ((ZnesVariableOperand*) operand)->variable;
+
+        if (variable->type == ZNES_ALLOC_TYPE_ARRAY && variable->size > 0 && fl_array_length(((ZnesArrayAlloc*) variable)->elements) == 0)
+            return variable;
+
+        return NULL;
+    }
+
+    if (operand->type == ZNES_OPERAND_ARRAY)
+    {
+        ZnesArrayOperand *array_operand = (ZnesArrayOperand*) operand;
+
+        for (size_t i=0; i < fl_array_length(array_operand->elements); i++)
+        {
+            ZnesAlloc *variable = find_blob_copy(array_operand->elements[i]);
+
+            if (variable != NULL)
+                return variable;
+        }
+    }
+    else if (operand->type == ZNES_OPERAND_STRUCT)
+    {
+        ZnesStructOperand *struct_operand = (ZnesStructOperand*) operand;
+
+        for (size_t i=0; i < fl_array_length(struct_operand->members); i++)
+        {
+            ZnesAlloc *variable = find_blob_copy(struct_operand->members[i]->operand);
+
+            if (variable != NULL)
+                return variable;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Function: reject_blob_copy
+ *  Reports an error if the operand copies a variable initialized with a blob
+ */
+static bool reject_blob_copy(ZnesContext *znes_context, ZnesOperand *operand)
+{
+    ZnesAlloc *variable = find_blob_copy(operand);
+
+    if (variable == NULL)
+        return false;
+
+    znes_context_error(znes_context, ZNES_ERROR_ALLOC, "Variable '%s' is initialized with incbin, it can be referenced but not copied", variable->name);
+
+    return true;
+}
+
 static void visit_zir_variable_instruction(ZnesContext *znes_context, ZirVariableInstr *zir_instruction, ZirBlock *zir_block)
 {
     // A variable is initialized from its source value, we need to create a NES operand
     ZnesOperand *znes_source_operand = znes_utils_make_nes_operand(znes_context, zir_instruction->source);
     
-    if (znes_source_operand == NULL) return;
+    if (znes_source_operand == NULL || reject_blob_copy(znes_context, znes_source_operand)) return;
 
     // A variable definition has a destination symbol
     ZirSymbol *zir_destination_symbol = ((ZirSymbolOperand*) zir_instruction->base.destination)->symbol;
@@ -236,6 +360,13 @@ static void visit_zir_variable_instruction(ZnesContext *znes_context, ZirVariabl
     if (!znes_alloc_request_init(znes_context, zir_block, zir_destination_symbol, zir_instruction->attributes, &znes_alloc_request))
         return;
 
+    // The CHR-ROM bytes are written in the ROM file, there is no code that can initialize them at runtime
+    if (znes_alloc_request.segment == ZNES_SEGMENT_CHR && !is_constant_operand(znes_source_operand))
+    {
+        znes_context_error(znes_context, ZNES_ERROR_ALLOC, "Variable '%s' in the CHR segment must be initialized with constant values", zir_destination_symbol->name);
+        return;
+    }
+
     // With the allocation request and the initial value we can allocate the space for the variable
     ZnesAlloc *znes_allocation = znes_program_alloc_variable(znes_context->program, zir_destination_symbol->name, &znes_alloc_request, znes_source_operand);
 
@@ -249,6 +380,10 @@ static void visit_zir_variable_instruction(ZnesContext *znes_context, ZirVariabl
         return;
     }
 
+    // The bytes of a blob are written as a whole, so the variable does not need an allocation for each element
+    if (znes_source_operand->type == ZNES_OPERAND_BLOB)
+        return;
+
     // For arrays, structs, and other compund types, we need to configure its members
     if (!znes_allocation_setup_aggregates(znes_context, znes_allocation, zir_destination_symbol->type))
         return;
@@ -256,15 +391,51 @@ static void visit_zir_variable_instruction(ZnesContext *znes_context, ZirVariabl
 
 static void visit_zir_instruction(ZnesContext *znes_context, ZirInstr *zir_instruction, ZirBlock *zir_block)
 {
+    znes_context->program->origin = zir_instruction->origin;
     zir_instruction_visitors[zir_instruction->type](znes_context, zir_instruction, zir_block);
 }
 
 static void visit_zir_block(ZnesContext *znes_context, ZirBlock *zir_block)
 {
-    size_t instr_count = fl_array_length(zir_block->instructions);
+    ZirCfg *cfg = &zir_block->cfg;
+    size_t block_count = fl_array_length(cfg->blocks);
+
+    // Before visiting the instructions we compute the live ranges of the temporal symbols to assign them a slot
+    ZnesTempSlots *temp_slots = znes_temp_slots_compute(zir_block);
+    znes_context->temp_slots = temp_slots;
+
+    // The basic blocks are emitted in layout order, we need the index of the first instruction of each
+    // block to resolve the jumps
+    size_t *block_ip = fl_malloc(sizeof(size_t) * (block_count + 1));
+    block_ip[0] = 0;
+    for (size_t i=0; i < block_count; i++)
+        block_ip[i + 1] = block_ip[i] + fl_array_length(cfg->blocks[i]->instructions) + (cfg->blocks[i]->terminator != NULL ? 1 : 0);
+
+    for (size_t i=0; i < block_count; i++)
+    {
+        ZirBasicBlock *basic_block = cfg->blocks[i];
+
+        for (size_t j=0; j < fl_array_length(basic_block->instructions); j++)
+            visit_zir_instruction(znes_context, basic_block->instructions[j], zir_block);
+
+        if (basic_block->terminator != NULL)
+        {
+            ZirBasicBlock *target = zir_cfg_terminator_target(basic_block->terminator);
+            visit_zir_terminator(znes_context, basic_block->terminator, block_ip[i + 1] - 1, block_ip[target->index]);
+        }
+    }
+
+    fl_free(block_ip);
+
+    // Update the program's stats
+    ZnesTempStats *stats = &znes_context->program->temps;
+    stats->count += fl_array_length(temp_slots->ranges);
+    stats->total_size += temp_slots->total_size;
+    if (temp_slots->peak_size > stats->peak_size)
+        stats->peak_size = temp_slots->peak_size;
 
-    for (size_t i=0; i < instr_count; i++)
-        visit_zir_instruction(znes_context, zir_block->instructions[i], zir_block);
+    znes_context->temp_slots = NULL;
+    znes_temp_slots_free(temp_slots);
 }
 
 bool znes_generate_program(ZnesContext *znes_context, ZirProgram *zir_program)
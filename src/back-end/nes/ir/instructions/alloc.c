@@ -8,6 +8,7 @@ ZnesAllocInstruction* znes_alloc_instruction_new(ZnesAlloc *destination, ZnesOpe
     ZnesAllocInstruction *instruction = fl_malloc(sizeof(ZnesAllocInstruction));
 
     instruction->base.kind = ZNES_INSTRUCTION_ALLOC;
+    instruction->base.origin = (ZirSourceOrigin) { 0 };
     instruction->destination = destination;
     instruction->source = source;
 
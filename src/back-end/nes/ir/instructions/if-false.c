@@ -8,6 +8,7 @@ ZnesIfFalseInstruction* znes_if_false_instruction_new(ZnesUintOperand *offset, Z
     ZnesIfFalseInstruction *instruction = fl_malloc(sizeof(ZnesIfFalseInstruction));
 
     instruction->base.kind = ZNES_INSTRUCTION_IF_FALSE;
+    instruction->base.origin = (ZirSourceOrigin) { 0 };
     instruction->offset = offset;
     instruction->source = source;
 
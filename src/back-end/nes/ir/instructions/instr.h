@@ -4,7 +4,7 @@
 #include <fllib/Mem.h>
 #include <fllib/Cstring.h>
 #include <fllib/containers/List.h>
-#include "../../../../zir/instructions/operands/operand.h"
+#include "../../../../zir/instructions/instruction.h"
 
 typedef FlList ZnesInstructionList;
 typedef struct FlListNode ZnesInstructionListNode;
@@ -18,6 +18,7 @@ typedef enum ZnesInstructionKind {
 
 typedef struct ZnesInstruction {
     ZnesInstructionKind kind;
+    ZirSourceOrigin origin;
 } ZnesInstruction;
 
 void znes_instruction_free(ZnesInstruction *instr_builder);
@@ -8,6 +8,7 @@ ZnesJumpInstruction* znes_jump_instruction_new(ZnesUintOperand *offset)
     ZnesJumpInstruction *instruction = fl_malloc(sizeof(ZnesJumpInstruction));
 
     instruction->base.kind = ZNES_INSTRUCTION_JUMP;
+    instruction->base.origin = (ZirSourceOrigin) { 0 };
     instruction->offset = offset;
 
     return instruction;
@@ -0,0 +1,235 @@
+#include <fllib/Mem.h>
+#include <fllib/Array.h>
+#include <fllib/Cstring.h>
+#include "liveness.h"
+#include "../nes.h"
+#include "../../../zir/instructions/operands/array.h"
+#include "../../../zir/instructions/operands/reference.h"
+#include "../../../zir/instructions/operands/struct.h"
+#include "../../../zir/instructions/operands/symbol.h"
+
+static inline ZnesTempLiveRange* find_range(ZnesTempSlots *slots, const char *name)
+{
+    return (ZnesTempLiveRange*) fl_hashtable_get(slots->index, name);
+}
+
+/*
+ * Function: mark_operand_uses
+ *  Extends the live range of every temporal symbol referenced by the operand (or any of its nested
+ *  operands) up to the instruction at index *ip*
+ */
+static void mark_operand_uses(ZnesTempSlots *slots, ZirOperand *operand, size_t ip)
+{
+    if (operand == NULL)
+        return;
+
+    switch (operand->type)
+    {
+        case ZIR_OPERAND_SYMBOL:
+        {
+            ZirSymbol *symbol = ((ZirSymbolOperand*) operand)->symbol;
+
+            if (symbol->name[0] != '%')
+                return;
+
+            ZnesTempLiveRange *range = find_range(slots, symbol->name);
+
+            if (range != NULL && range->end < ip)
+                range->end = ip;
+
+            return;
+        }
+        case ZIR_OPERAND_REFERENCE:
+        {
+            mark_operand_uses(slots, (ZirOperand*) ((ZirReferenceOperand*) operand)->operand, ip);
+            return;
+        }
+        case ZIR_OPERAND_ARRAY:
+        {
+            ZirArrayOperand *array = (ZirArrayOperand*) operand;
+
+            for (size_t i=0; i < fl_array_length(array->elements); i++)
+                mark_operand_uses(slots, array->elements[i], ip);
+
+            return;
+        }
+        case ZIR_OPERAND_STRUCT:
+        {
+            ZirStructOperand *struct_operand = (ZirStructOperand*) operand;
+
+            for (size_t i=0; i < fl_array_length(struct_operand->members); i++)
+                mark_operand_uses(slots, struct_operand->members[i]->operand, ip);
+
+            return;
+        }
+
+        default: return;
+    }
+}
+
+static ZirOperand* instruction_source(ZirInstr *instruction)
+{
+    switch (instruction->type)
+    {
+        case ZIR_INSTR_VARIABLE:
+            return ((ZirVariableInstr*) instruction)->source;
+
+        case ZIR_INSTR_CAST:
+            return ((ZirCastInstr*) instruction)->source;
+
+        case ZIR_INSTR_IF_FALSE:
+            return ((ZirIfFalseInstr*) instruction)->source;
+
+        default: break;
+    }
+
+    return NULL;
+}
+
+/*
+ * Function: visit_instruction
+ *  Updates the live ranges with the uses and the definition of the instruction at index *ip*
+ */
+static void visit_instruction(ZnesTempSlots *slots, ZirInstr *instruction, size_t ip)
+{
+    // Uses go first, an instruction might consume a temporal symbol to define a new one
+    mark_operand_uses(slots, instruction_source(instruction), ip);
+
+    if (instruction->type != ZIR_INSTR_VARIABLE && instruction->type != ZIR_INSTR_CAST)
+        return;
+
+    if (instruction->destination == NULL || instruction->destination->type != ZIR_OPERAND_SYMBOL)
+        return;
+
+    ZirSymbol *symbol = ((ZirSymbolOperand*) instruction->destination)->symbol;
+
+    if (symbol->name[0] != '%' || find_range(slots, symbol->name) != NULL)
+        return;
+
+    ZnesTempLiveRange *range = fl_malloc(sizeof(ZnesTempLiveRange));
+    range->name = fl_cstring_dup(symbol->name);
+    range->start = ip;
+    range->end = ip;
+    range->size = zir_type_size(symbol->type, ZNES_POINTER_SIZE);
+    range->slot = 0;
+
+    slots->ranges = fl_array_append(slots->ranges, &range);
+    fl_hashtable_add(slots->index, range->name, range);
+    slots->total_size += range->size;
+}
+
+/*
+ * Function: znes_temp_slots_compute
+ *  The live ranges are computed in one pass: a temporal symbol is born in the instruction that uses it as
+ *  destination and dies in the last instruction that uses it as a source operand. The terminators of the
+ *  basic blocks only target blocks placed after them and temporal symbols are consumed within the statement
+ *  that defines them, so no jump can re-enter a live range and a single linear pass is enough.
+ *  Once the ranges are known, a linear scan (the ranges are already sorted by their start index) expires
+ *  the active ranges that ended before the current one and places the current range at the lowest offset
+ *  that does not overlap an active range.
+ */
+ZnesTempSlots* znes_temp_slots_compute(ZirBlock *block)
+{
+    ZnesTempSlots *slots = fl_malloc(sizeof(ZnesTempSlots));
+    slots->ranges = fl_array_new(sizeof(ZnesTempLiveRange*), 0);
+    slots->index = fl_hashtable_new_args((struct FlHashtableArgs) {
+        .hash_function = fl_hashtable_hash_string,
+        .key_allocator = fl_container_allocator_string,
+        .key_comparer = fl_container_equals_string,
+        .key_cleaner = fl_container_cleaner_pointer,
+        .value_cleaner = NULL,
+        .value_allocator = NULL
+    });
+    slots->total_size = 0;
+    slots->peak_size = 0;
+
+    // The instructions are numbered following the layout of the basic blocks, terminators included
+    size_t ip = 0;
+    for (size_t i=0; i < fl_array_length(block->cfg.blocks); i++)
+    {
+        ZirBasicBlock *basic_block = block->cfg.blocks[i];
+
+        for (size_t j=0; j < fl_array_length(basic_block->instructions); j++)
+            visit_instruction(slots, basic_block->instructions[j], ip++);
+
+        if (basic_block->terminator != NULL)
+            visit_instruction(slots, basic_block->terminator, ip++);
+    }
+
+    size_t range_count = fl_array_length(slots->ranges);
+    ZnesTempLiveRange **active = fl_malloc(sizeof(ZnesTempLiveRange*) * (range_count > 0 ? range_count : 1));
+    size_t active_count = 0;
+
+    for (size_t i=0; i < range_count; i++)
+    {
+        ZnesTempLiveRange *current = slots->ranges[i];
+
+        // Expire the ranges that ended before the current one starts. We keep the ones that end at the
+        // current instruction, because the instruction reads them while it writes the current range
+        size_t kept = 0;
+        for (size_t j=0; j < active_count; j++)
+        {
+            if (active[j]->end >= current->start)
+                active[kept++] = active[j];
+        }
+        active_count = kept;
+
+        // Find the lowest offset that does not overlap any active range
+        size_t offset = 0;
+        bool moved = true;
+        while (moved)
+        {
+            moved = false;
+            for (size_t j=0; j < active_count; j++)
+            {
+                size_t active_start = active[j]->slot;
+                size_t active_end = active_start + active[j]->size;
+
+                if (offset < active_end && active_start < offset + current->size)
+                {
+                    offset = active_end;
+                    moved = true;
+                }
+            }
+        }
+
+        current->slot = (uint16_t) offset;
+
+        if (offset + current->size > slots->peak_size)
+            slots->peak_size = offset + current->size;
+
+        active[active_count++] = current;
+    }
+
+    fl_free(active);
+
+    return slots;
+}
+
+bool znes_temp_slots_get(ZnesTempSlots *slots, const char *name, uint16_t *slot)
+{
+    ZnesTempLiveRange *range = find_range(slots, name);
+
+    if (range == NULL)
+        return false;
+
+    *slot = range->slot;
+
+    return true;
+}
+
+void znes_temp_slots_free(ZnesTempSlots *slots)
+{
+    if (!slots)
+        return;
+
+    for (size_t i=0; i < fl_array_length(slots->ranges); i++)
+    {
+        fl_cstring_free(slots->ranges[i]->name);
+        fl_free(slots->ranges[i]);
+    }
+
+    fl_array_free(slots->ranges);
+    fl_hashtable_free(slots->index);
+    fl_free(slots);
+}
@@ -0,0 +1,89 @@
+#ifndef ZNES_LIVENESS_H
+#define ZNES_LIVENESS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <fllib/containers/Hashtable.h>
+#include "../../../zir/block.h"
+
+/*
+ * Struct: ZnesTempLiveRange
+ *  The live range of a temporal symbol within a ZIR block
+ *
+ * Members:
+ *  <const char> *name: The name of the temporal symbol (names starting with '%')
+ *  <size_t> start: Index of the instruction that defines the temporal symbol
+ *  <size_t> end: Index of the last instruction that uses the temporal symbol
+ *  <size_t> size: Size in bytes of the temporal symbol
+ *  <uint16_t> slot: Offset of the temporal symbol within the temporaries area
+ */
+typedef struct ZnesTempLiveRange {
+    const char *name;
+    size_t start;
+    size_t end;
+    size_t size;
+    uint16_t slot;
+} ZnesTempLiveRange;
+
+/*
+ * Struct: ZnesTempSlots
+ *  The result of running the linear-scan slot allocator over the temporal symbols of a ZIR block
+ *
+ * Members:
+ *  <ZnesTempLiveRange> **ranges: Live ranges sorted by their start index
+ *  <FlHashtable> *index: Map of temporal symbol names to their live ranges
+ *  <size_t> total_size: Bytes needed if every temporal symbol had its own slot
+ *  <size_t> peak_size: Bytes needed once the temporal symbols with disjoint live ranges share slots
+ */
+typedef struct ZnesTempSlots {
+    ZnesTempLiveRange **ranges;
+    FlHashtable *index;
+    size_t total_size;
+    size_t peak_size;
+} ZnesTempSlots;
+
+/*
+ * Function: znes_temp_slots_compute
+ *  Computes the live range of every temporal symbol defined in the block's instructions and assigns
+ *  each of them a slot within the temporaries area. Temporal symbols whose live ranges do not overlap
+ *  share the same bytes.
+ *
+ * Parameters:
+ *  <ZirBlock> *block: The ZIR block to analyze
+ *
+ * Returns:
+ *  ZnesTempSlots*: The slot assignment of the block's temporal symbols
+ *
+ * Notes:
+ *  The object returned by this function must be freed using the <znes_temp_slots_free> function
+ */
+ZnesTempSlots* znes_temp_slots_compute(ZirBlock *block);
+
+/*
+ * Function: znes_temp_slots_get
+ *  Retrieves the slot assigned to the temporal symbol identified by *name*
+ *
+ * Parameters:
+ *  <ZnesTempSlots> *slots: The slot assignment object
+ *  <const char> *name: The temporal symbol name
+ *  <uint16_t> *slot: If the temporal symbol exists, the slot is stored in this pointer
+ *
+ * Returns:
+ *  bool: *true* if the temporal symbol has a slot, otherwise *false*
+ */
+bool znes_temp_slots_get(ZnesTempSlots *slots, const char *name, uint16_t *slot);
+
+/*
+ * Function: znes_temp_slots_free
+ *  Releases the memory of a slot assignment object
+ *
+ * Parameters:
+ *  <ZnesTempSlots> *slots: The object to be freed
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void znes_temp_slots_free(ZnesTempSlots *slots);
+
+#endif /* ZNES_LIVENESS_H */
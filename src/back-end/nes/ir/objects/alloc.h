@@ -25,6 +25,7 @@ typedef struct ZnesAllocRequest {
     ZnesAllocType type;
     size_t size;
     uint16_t address;
+    uint8_t bank;
     bool use_address;
     bool is_global;
 } ZnesAllocRequest;
@@ -34,6 +35,7 @@ typedef struct ZnesAlloc {
     ZnesSegmentKind segment;
     char *name;
     uint16_t address;
+    uint8_t bank;
     size_t size;
 } ZnesAlloc;
 
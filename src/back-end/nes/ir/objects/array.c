@@ -8,6 +8,7 @@ ZnesArrayAlloc* znes_array_alloc_new(const char *name, ZnesSegmentKind segment,
 {
     ZnesArrayAlloc *array_symbol = fl_malloc(sizeof(ZnesArrayAlloc));
     array_symbol->base.address = address;
+    array_symbol->base.bank = 0;
     array_symbol->base.name = name != NULL ? fl_cstring_dup(name) : NULL;
     array_symbol->base.segment = segment;
     array_symbol->base.type = ZNES_ALLOC_TYPE_ARRAY;
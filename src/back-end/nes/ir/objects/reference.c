@@ -6,6 +6,7 @@ ZnesReferenceAlloc* znes_reference_alloc_new(const char *name, ZnesSegmentKind s
 {
     ZnesReferenceAlloc *ref_symbol = fl_malloc(sizeof(ZnesReferenceAlloc));
     ref_symbol->base.address = address;
+    ref_symbol->base.bank = 0;
     ref_symbol->base.name = name != NULL ? fl_cstring_dup(name) : NULL;
     ref_symbol->base.segment = segment;
     ref_symbol->base.type = ZNES_ALLOC_TYPE_REFERENCE;
@@ -9,6 +9,7 @@ ZnesStructAlloc* znes_struct_alloc_new(const char *name, ZnesSegmentKind segment
 {
     ZnesStructAlloc *struct_symbol = fl_malloc(sizeof(ZnesStructAlloc));
     struct_symbol->base.address = address;
+    struct_symbol->base.bank = 0;
     struct_symbol->base.name = name != NULL ? fl_cstring_dup(name) : NULL;
     struct_symbol->base.segment = segment;
     struct_symbol->base.type = ZNES_ALLOC_TYPE_STRUCT;
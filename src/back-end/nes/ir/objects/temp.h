@@ -3,11 +3,9 @@
 
 #include <stdint.h>
 #include "alloc.h"
-#include "../operands/operand.h"
 
 typedef struct ZnesTempAlloc {
     ZnesAlloc base;
-    ZnesOperand *source;
 } ZnesTempAlloc;
 
 ZnesTempAlloc* znes_temp_alloc_new(const char *name, size_t size);
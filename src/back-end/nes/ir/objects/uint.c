@@ -6,6 +6,7 @@ ZnesUintAlloc* znes_uint_alloc_new(const char *name, ZnesSegmentKind segment, si
     ZnesUintAlloc *uint_symbol = fl_malloc(sizeof(ZnesUintAlloc));
 
     uint_symbol->base.address = address;
+    uint_symbol->base.bank = 0;
     uint_symbol->base.name = name != NULL ? fl_cstring_dup(name) : NULL;
     uint_symbol->base.segment = segment;
     uint_symbol->base.type = ZNES_ALLOC_TYPE_UINT;
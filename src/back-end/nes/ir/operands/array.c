@@ -4,25 +4,20 @@
 #include <fllib/Cstring.h>
 #include "array.h"
 
-ZnesArrayOperand* znes_array_operand_new(size_t element_size, size_t length)
+void znes_array_operand_init(ZnesArrayOperand *operand, size_t element_size, size_t length)
 {
-    ZnesArrayOperand *operand = fl_malloc(sizeof(ZnesArrayOperand));
     operand->base.type = ZNES_OPERAND_ARRAY;
     operand->element_size = element_size;
     operand->length = length;
     operand->elements = fl_array_new(sizeof(ZnesOperand*), length);
-
-    return operand;
 }
 
-void znes_array_operand_free(ZnesArrayOperand *array_operand)
+void znes_array_operand_release(ZnesArrayOperand *array_operand)
 {
     if (!array_operand)
         return;
 
     fl_array_free(array_operand->elements);
-
-    fl_free(array_operand);
 }
 
 size_t znes_array_operand_size(ZnesArrayOperand *array_operand)
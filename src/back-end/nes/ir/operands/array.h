@@ -11,8 +11,8 @@ typedef struct ZnesArrayOperand {
     size_t length;
 } ZnesArrayOperand;
 
-ZnesArrayOperand* znes_array_operand_new(size_t element_size, size_t length);
-void znes_array_operand_free(ZnesArrayOperand *array_operand);
+void znes_array_operand_init(ZnesArrayOperand *operand, size_t element_size, size_t length);
+void znes_array_operand_release(ZnesArrayOperand *array_operand);
 char* znes_array_operand_dump(ZnesArrayOperand *array_operand, char *output);
 size_t znes_array_operand_size(ZnesArrayOperand *array_operand);
 
@@ -0,0 +1,17 @@
+
+#include <fllib/Cstring.h>
+#include "blob.h"
+
+void znes_blob_operand_init(ZnesBlobOperand *operand, const uint8_t *bytes, size_t length)
+{
+    // The bytes are owned by the ZIR blob operand, and the ZIR program outlives the NES program
+    operand->base.type = ZNES_OPERAND_BLOB;
+    operand->bytes = bytes;
+    operand->length = length;
+}
+
+char* znes_blob_operand_dump(ZnesBlobOperand *blob_operand, char *output)
+{
+    fl_cstring_vappend(&output, "incbin(%zu bytes)", blob_operand->length);
+    return output;
+}
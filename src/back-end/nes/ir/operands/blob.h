@@ -0,0 +1,21 @@
+#ifndef ZNES_OPERAND_BLOB_H
+#define ZNES_OPERAND_BLOB_H
+
+#include <stdint.h>
+#include "operand.h"
+
+typedef struct ZnesBlobOperand {
+    ZnesOperand base;
+    const uint8_t *bytes;
+    size_t length;
+} ZnesBlobOperand;
+
+void znes_blob_operand_init(ZnesBlobOperand *operand, const uint8_t *bytes, size_t length);
+char* znes_blob_operand_dump(ZnesBlobOperand *blob_operand, char *output);
+
+static inline size_t znes_blob_operand_size(ZnesBlobOperand *blob_operand)
+{
+    return blob_operand->length;
+}
+
+#endif /* ZNES_OPERAND_BLOB_H */
@@ -9,8 +9,7 @@ typedef struct ZnesBoolOperand {
     bool value;
 } ZnesBoolOperand;
 
-ZnesBoolOperand* znes_bool_operand_new(bool value);
-void znes_bool_operand_free(ZnesBoolOperand *bool_operand);
+void znes_bool_operand_init(ZnesBoolOperand *bool_operand, bool value);
 char* znes_bool_operand_dump(ZnesBoolOperand *bool_operand, char *output);
 
 static inline size_t znes_bool_operand_size(ZnesBoolOperand *bool_operand)
@@ -1,44 +1,12 @@
 #include "operand.h"
 #include "array.h"
+#include "blob.h"
 #include "bool.h"
 #include "uint.h"
 #include "reference.h"
 #include "struct.h"
 #include "variable.h"
 
-void znes_operand_free(ZnesOperand *operand)
-{
-    if (!operand)
-        return;
-
-    switch (operand->type)
-    {
-        case ZNES_OPERAND_UINT:
-            znes_uint_operand_free((ZnesUintOperand*) operand);
-            break;
-
-        case ZNES_OPERAND_BOOL:
-            znes_bool_operand_free((ZnesBoolOperand*) operand);
-            break;
-
-        case ZNES_OPERAND_ARRAY:
-            znes_array_operand_free((ZnesArrayOperand*) operand);
-            break;
-
-        case ZNES_OPERAND_STRUCT:
-            znes_struct_operand_free((ZnesStructOperand*) operand);
-            break;
-
-        case ZNES_OPERAND_VARIABLE:
-            znes_variable_operand_free((ZnesVariableOperand*) operand);
-            break;
-
-        case ZNES_OPERAND_REFERENCE:
-            znes_reference_operand_free((ZnesReferenceOperand*) operand);
-            break;
-    }
-}
-
 char* znes_operand_dump(ZnesOperand *operand, char *output)
 {
     switch (operand->type)
@@ -52,6 +20,9 @@ char* znes_operand_dump(ZnesOperand *operand, char *output)
         case ZNES_OPERAND_ARRAY:
             return znes_array_operand_dump((ZnesArrayOperand*) operand, output);
 
+        case ZNES_OPERAND_BLOB:
+            return znes_blob_operand_dump((ZnesBlobOperand*) operand, output);
+
         case ZNES_OPERAND_STRUCT:
             return znes_struct_operand_dump((ZnesStructOperand*) operand, output);
 
@@ -78,6 +49,9 @@ size_t znes_operand_size(ZnesOperand *operand)
         case ZNES_OPERAND_ARRAY:
             return znes_array_operand_size((ZnesArrayOperand*) operand);
 
+        case ZNES_OPERAND_BLOB:
+            return znes_blob_operand_size((ZnesBlobOperand*) operand);
+
         case ZNES_OPERAND_STRUCT:
             return znes_struct_operand_size((ZnesStructOperand*) operand);
 
@@ -4,20 +4,74 @@
 ZnesOperandPool* znes_operand_pool_new(void)
 {
     ZnesOperandPool *pool = fl_malloc(sizeof(ZnesOperandPool));
-    pool->operands = fl_list_new_args((struct FlListArgs) {
-        .value_cleaner = (FlContainerCleanupFn) znes_operand_free
-    });
+    pool->arrays = zir_slab_new(sizeof(ZnesArrayOperand));
+    pool->blobs = zir_slab_new(sizeof(ZnesBlobOperand));
+    pool->structs = zir_slab_new(sizeof(ZnesStructOperand));
+    pool->references = zir_slab_new(sizeof(ZnesReferenceOperand));
+    pool->variables = zir_slab_new(sizeof(ZnesVariableOperand));
+    pool->uints = zir_slab_new(sizeof(ZnesUintOperand));
+    pool->bools = zir_slab_new(sizeof(ZnesBoolOperand));
 
     return pool;
 }
 
 void znes_operand_pool_free(ZnesOperandPool *pool)
 {
-    fl_list_free(pool->operands);
+    zir_slab_free(&pool->arrays, (ZirSlabCleanupFn) znes_array_operand_release);
+    zir_slab_free(&pool->blobs, NULL);
+    zir_slab_free(&pool->structs, (ZirSlabCleanupFn) znes_struct_operand_release);
+    zir_slab_free(&pool->references, NULL);
+    zir_slab_free(&pool->variables, NULL);
+    zir_slab_free(&pool->uints, NULL);
+    zir_slab_free(&pool->bools, NULL);
     fl_free(pool);
 }
 
-void znes_operand_pool_register(ZnesOperandPool *pool, ZnesOperand *operand)
+ZnesArrayOperand* znes_operand_pool_new_array(ZnesOperandPool *pool, size_t element_size, size_t length)
 {
-    fl_list_append(pool->operands, operand);
+    ZnesArrayOperand *array_operand = zir_slab_alloc(&pool->arrays);
+    znes_array_operand_init(array_operand, element_size, length);
+    return array_operand;
+}
+
+ZnesBlobOperand* znes_operand_pool_new_blob(ZnesOperandPool *pool, const uint8_t *bytes, size_t length)
+{
+    ZnesBlobOperand *blob_operand = zir_slab_alloc(&pool->blobs);
+    znes_blob_operand_init(blob_operand, bytes, length);
+    return blob_operand;
+}
+
+ZnesStructOperand* znes_operand_pool_new_struct(ZnesOperandPool *pool)
+{
+    ZnesStructOperand *struct_operand = zir_slab_alloc(&pool->structs);
+    znes_struct_operand_init(struct_operand);
+    return struct_operand;
+}
+
+ZnesReferenceOperand* znes_operand_pool_new_reference(ZnesOperandPool *pool, ZnesVariableOperand *operand)
+{
+    ZnesReferenceOperand *reference_operand = zir_slab_alloc(&pool->references);
+    znes_reference_operand_init(reference_operand, operand);
+    return reference_operand;
+}
+
+ZnesVariableOperand* znes_operand_pool_new_variable(ZnesOperandPool *pool, ZnesAlloc *variable)
+{
+    ZnesVariableOperand *variable_operand = zir_slab_alloc(&pool->variables);
+    znes_variable_operand_init(variable_operand, variable);
+    return variable_operand;
+}
+
+ZnesUintOperand* znes_operand_pool_new_uint(ZnesOperandPool *pool, ZnesUintSize size, ZnesUintValue value)
+{
+    ZnesUintOperand *uint_operand = zir_slab_alloc(&pool->uints);
+    znes_uint_operand_init(uint_operand, size, value);
+    return uint_operand;
+}
+
+ZnesBoolOperand* znes_operand_pool_new_bool(ZnesOperandPool *pool, bool value)
+{
+    ZnesBoolOperand *bool_operand = zir_slab_alloc(&pool->bools);
+    znes_bool_operand_init(bool_operand, value);
+    return bool_operand;
 }
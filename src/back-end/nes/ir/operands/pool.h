@@ -3,18 +3,32 @@
 
 
 #include "array.h"
+#include "blob.h"
 #include "bool.h"
 #include "reference.h"
 #include "struct.h"
 #include "variable.h"
 #include "uint.h"
+#include "../../../../zir/slab.h"
 
 typedef struct ZnesOperandPool {
-    FlList *operands;
+    ZirSlab arrays;
+    ZirSlab blobs;
+    ZirSlab structs;
+    ZirSlab references;
+    ZirSlab variables;
+    ZirSlab uints;
+    ZirSlab bools;
 } ZnesOperandPool;
 
 ZnesOperandPool* znes_operand_pool_new(void);
 void znes_operand_pool_free(ZnesOperandPool *pool);
-void znes_operand_pool_register(ZnesOperandPool *pool, ZnesOperand *operand);
+ZnesArrayOperand* znes_operand_pool_new_array(ZnesOperandPool *pool, size_t element_size, size_t length);
+ZnesBlobOperand* znes_operand_pool_new_blob(ZnesOperandPool *pool, const uint8_t *bytes, size_t length);
+ZnesStructOperand* znes_operand_pool_new_struct(ZnesOperandPool *pool);
+ZnesReferenceOperand* znes_operand_pool_new_reference(ZnesOperandPool *pool, ZnesVariableOperand *operand);
+ZnesVariableOperand* znes_operand_pool_new_variable(ZnesOperandPool *pool, ZnesAlloc *variable);
+ZnesUintOperand* znes_operand_pool_new_uint(ZnesOperandPool *pool, ZnesUintSize size, ZnesUintValue value);
+ZnesBoolOperand* znes_operand_pool_new_bool(ZnesOperandPool *pool, bool value);
 
 #endif /* ZNES_OPERAND_POOL_H */
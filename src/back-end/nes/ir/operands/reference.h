@@ -9,8 +9,7 @@ typedef struct ZnesReferenceOperand {
     ZnesVariableOperand *operand;
 } ZnesReferenceOperand;
 
-ZnesReferenceOperand* znes_reference_operand_new(ZnesVariableOperand *operand);
-void znes_reference_operand_free(ZnesReferenceOperand *reference_operand);
+void znes_reference_operand_init(ZnesReferenceOperand *reference, ZnesVariableOperand *operand);
 char* znes_reference_operand_dump(ZnesReferenceOperand *reference_operand, char *output);
 
 static inline size_t znes_reference_operand_size(ZnesReferenceOperand *reference_operand)
@@ -17,13 +17,10 @@ static void member_free(void *ptr)
     fl_free(member);
 }
 
-ZnesStructOperand* znes_struct_operand_new(void)
+void znes_struct_operand_init(ZnesStructOperand *operand)
 {
-    ZnesStructOperand *operand = fl_malloc(sizeof(ZnesStructOperand));
     operand->base.type = ZNES_OPERAND_STRUCT;
     operand->members = fl_array_new(sizeof(ZnesOperand*), 0);
-
-    return operand;
 }
 
 void znes_struct_operand_add_member(ZnesStructOperand *struct_operand, const char *name, ZnesOperand *member_operand)
@@ -34,14 +31,12 @@ void znes_struct_operand_add_member(ZnesStructOperand *struct_operand, const cha
     struct_operand->members = fl_array_append(struct_operand->members, &member);
 }
 
-void znes_struct_operand_free(ZnesStructOperand *struct_operand)
+void znes_struct_operand_release(ZnesStructOperand *struct_operand)
 {
     if (!struct_operand)
         return;
 
     fl_array_free_each_pointer(struct_operand->members, member_free);
-
-    fl_free(struct_operand);
 }
 
 size_t znes_struct_operand_size(ZnesStructOperand *struct_operand)
@@ -13,9 +13,9 @@ typedef struct ZnesStructOperand {
     ZnesStructOperandMember **members;
 } ZnesStructOperand;
 
-ZnesStructOperand* znes_struct_operand_new(void);
+void znes_struct_operand_init(ZnesStructOperand *operand);
 void znes_struct_operand_add_member(ZnesStructOperand *struct_operand, const char *name, ZnesOperand *operand);
-void znes_struct_operand_free(ZnesStructOperand *struct_operand);
+void znes_struct_operand_release(ZnesStructOperand *struct_operand);
 size_t znes_struct_operand_size(ZnesStructOperand *struct_operand);
 char* znes_struct_operand_dump(ZnesStructOperand *struct_operand, char *output);
 
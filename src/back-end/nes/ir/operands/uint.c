@@ -2,22 +2,11 @@
 #include <fllib/Cstring.h>
 #include "uint.h"
 
-ZnesUintOperand* znes_uint_operand_new(ZnesUintSize size, ZnesUintValue value)
+void znes_uint_operand_init(ZnesUintOperand *uint, ZnesUintSize size, ZnesUintValue value)
 {
-    ZnesUintOperand *uint = fl_malloc(sizeof(ZnesUintOperand));
     uint->base.type = ZNES_OPERAND_UINT;
     uint->size = size;
     uint->value = value;
-
-    return uint;
-}
-
-void znes_uint_operand_free(ZnesUintOperand *uint)
-{
-    if (!uint)
-        return;
-
-    fl_free(uint);
 }
 
 char* znes_uint_operand_dump(ZnesUintOperand *uint, char *output)
@@ -21,8 +21,7 @@ typedef struct ZnesUintOperand {
     ZnesUintValue value;
 } ZnesUintOperand;
 
-ZnesUintOperand* znes_uint_operand_new(ZnesUintSize size, ZnesUintValue value);
-void znes_uint_operand_free(ZnesUintOperand *uint_operand);
+void znes_uint_operand_init(ZnesUintOperand *uint, ZnesUintSize size, ZnesUintValue value);
 char* znes_uint_operand_dump(ZnesUintOperand *uint_operand, char *output);
 
 static inline size_t znes_uint_operand_size(ZnesUintOperand *uint_operand)
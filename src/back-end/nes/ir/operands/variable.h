@@ -9,8 +9,7 @@ typedef struct ZnesVariableOperand {
     ZnesAlloc *variable;
 } ZnesVariableOperand;
 
-ZnesVariableOperand* znes_variable_operand_new(ZnesAlloc *variable);
-void znes_variable_operand_free(ZnesVariableOperand *variable_operand);
+void znes_variable_operand_init(ZnesVariableOperand *operand, ZnesAlloc *variable);
 char* znes_variable_operand_dump(ZnesVariableOperand *variable_operand, char *output);
 
 static inline size_t znes_variable_operand_size(ZnesVariableOperand *variable_operand)
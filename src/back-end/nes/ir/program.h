@@ -11,14 +11,37 @@
 #include "objects/alloc.h"
 #include "objects/temp.h"
 #include "operands/operand.h"
+#include "../nes.h"
+
+/*
+ * Struct: ZnesTempStats
+ *  Keeps track of the space used by the temporal symbols of the program
+ *
+ * Members:
+ *  <size_t> count: Number of temporal symbols
+ *  <size_t> total_size: Bytes the temporal symbols would use if each one had its own slot
+ *  <size_t> peak_size: Bytes used by the temporal symbols once the slots are reused
+ */
+typedef struct ZnesTempStats {
+    size_t count;
+    size_t total_size;
+    size_t peak_size;
+} ZnesTempStats;
 
 typedef struct ZnesProgram {
     ZnesDataSegment *data;
+    ZnesDataSegment *banks[ZNES_BANK_COUNT];
+    ZnesDataSegment *chr;
     ZnesTextSegment *startup;
     ZnesTextSegment *code;
     ZnesZeroPageSegment *zp;
     ZnesAllocMap *allocations;
+    ZnesTempStats temps;
     bool startup_context;
+    bool reset_clears_ram;
+    uint32_t peephole_rules;
+    ZnesMapper mapper;
+    ZirSourceOrigin origin;
 } ZnesProgram;
 
 static inline ZnesProgram* znes_program_new(bool scripting)
@@ -26,10 +49,24 @@ static inline ZnesProgram* znes_program_new(bool scripting)
     ZnesProgram *program = fl_malloc(sizeof(ZnesProgram));
 
     program->startup_context = !scripting;
-    program->data = znes_data_segment_new(0x8000);
+    program->data = znes_data_segment_new(0x8000, 0x8000);
+    // The CHR segment is not visible to the CPU, its addresses are the ones of the PPU pattern tables
+    program->chr = znes_data_segment_new(0x0000, ZNES_CHR_SIZE);
     program->startup = znes_text_segment_new(0x0);
     program->code = znes_text_segment_new(0x0);
     program->zp = znes_zp_segment_new();
+    program->temps = (ZnesTempStats) { 0 };
+    // If the reset routine wipes the RAM, the zero-initialized variables do not need to be cleared again
+    program->reset_clears_ram = false;
+    // Bitmask of the peephole rules the RP2A03 generator applies to the text segments, all of them by default
+    program->peephole_rules = UINT32_MAX;
+    // The board of the ROM. With NROM the PRG-ROM is the $8000-$FFFF address space, the other mappers add the
+    // switchable banks requested with the "bank" property of the NES attribute (the bank 0 is the default one)
+    program->mapper = ZNES_MAPPER_NROM;
+    for (size_t i=0; i < ZNES_BANK_COUNT; i++)
+        program->banks[i] = NULL;
+    // The origin of the ZIR instruction being lowered, the instructions take it when they are emitted
+    program->origin = (ZirSourceOrigin) { 0 };
 
     program->allocations = fl_hashtable_new_args((struct FlHashtableArgs) {
         .hash_function = fl_hashtable_hash_string,
@@ -46,6 +83,9 @@ static inline ZnesProgram* znes_program_new(bool scripting)
 static inline void znes_program_free(ZnesProgram *program)
 {
     znes_data_segment_free(program->data);
+    for (size_t i=0; i < ZNES_BANK_COUNT; i++)
+        if (program->banks[i]) znes_data_segment_free(program->banks[i]);
+    znes_data_segment_free(program->chr);
     znes_text_segment_free(program->code);
     znes_text_segment_free(program->startup);
     znes_zp_segment_free(program->zp);
@@ -63,7 +103,9 @@ static ZnesAlloc* znes_program_alloc_variable(ZnesProgram *program, const char *
         case ZNES_SEGMENT_TEMP:
         {
             ZnesTempAlloc *temp = znes_temp_alloc_new(name, alloc->size);
-            temp->source = source;
+            // The address of a temporal symbol is its slot within the temporaries area
+            if (alloc->use_address)
+                temp->base.address = alloc->address;
             variable = (ZnesAlloc*) temp;
             break;
         }   
@@ -74,7 +116,28 @@ static ZnesAlloc* znes_program_alloc_variable(ZnesProgram *program, const char *
         }
         case ZNES_SEGMENT_DATA:
         {
-            variable = znes_data_segment_alloc_variable(program->data, name, alloc, source);
+            if (alloc->bank == 0)
+            {
+                variable = znes_data_segment_alloc_variable(program->data, name, alloc, source);
+                break;
+            }
+
+            // Each switchable bank is packed on its own within the $8000-$BFFF window
+            if (program->banks[alloc->bank] == NULL)
+                program->banks[alloc->bank] = znes_data_segment_new(ZNES_BANK_WINDOW_ADDRESS, ZNES_BANK_WINDOW_SIZE);
+
+            variable = znes_data_segment_alloc_variable(program->banks[alloc->bank], name, alloc, source);
+
+            if (variable != NULL)
+                variable->bank = alloc->bank;
+            break;
+        }
+        case ZNES_SEGMENT_CHR:
+        {
+            variable = znes_data_segment_alloc_variable(program->chr, name, alloc, source);
+
+            if (variable != NULL)
+                variable->segment = ZNES_SEGMENT_CHR;
             break;
         }
         case ZNES_SEGMENT_TEXT:
@@ -90,6 +153,7 @@ static ZnesAlloc* znes_program_alloc_variable(ZnesProgram *program, const char *
         fl_hashtable_add(program->allocations, variable->name, variable);
 
         ZnesAllocInstruction *instr = znes_alloc_instruction_new(variable, source);
+        instr->base.origin = program->origin;
         znes_text_segment_add_instr(program->startup_context ? program->startup : program->code, (ZnesInstruction*) instr);
     }
 
@@ -98,6 +162,7 @@ static ZnesAlloc* znes_program_alloc_variable(ZnesProgram *program, const char *
 
 static inline void znes_program_emit_instruction(ZnesProgram *program, ZnesInstruction *instruction)
 {
+    instruction->origin = program->origin;
     znes_text_segment_add_instr(program->startup_context ? program->startup : program->code, instruction);
 }
 
@@ -111,8 +176,23 @@ static inline char* znes_program_dump(ZnesProgram *program)
     output = znes_text_segment_dump(program->startup, output);
     fl_cstring_append(&output, "\n");
     output = znes_data_segment_dump(program->data, output);
+    for (size_t i=0; i < ZNES_BANK_COUNT; i++)
+    {
+        if (program->banks[i] == NULL)
+            continue;
+
+        fl_cstring_vappend(&output, "\n; Bank %zu\n", i);
+        output = znes_data_segment_dump(program->banks[i], output);
+    }
+    if (fl_list_length(program->chr->allocations) > 0)
+    {
+        fl_cstring_append(&output, "\n; CHR-ROM\n");
+        output = znes_data_segment_dump(program->chr, output);
+    }
     fl_cstring_append(&output, "\n; Main routine\n");
     output = znes_text_segment_dump(program->code, output);
+    fl_cstring_vappend(&output, "\n; Temporaries: %zu (%zu bytes without slot reuse, peak %zu bytes)\n", 
+        program->temps.count, program->temps.total_size, program->temps.peak_size);
 
     return output;
 }
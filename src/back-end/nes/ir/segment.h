@@ -6,6 +6,7 @@ typedef enum ZnesSegmentKind {
     ZNES_SEGMENT_DATA,
     ZNES_SEGMENT_TEXT,
     ZNES_SEGMENT_TEMP,
+    ZNES_SEGMENT_CHR,
 } ZnesSegmentKind;
 
 static const char *znes_segment_kind_str[] = {
@@ -13,6 +14,7 @@ static const char *znes_segment_kind_str[] = {
     [ZNES_SEGMENT_DATA] = "DATA",
     [ZNES_SEGMENT_TEXT] = "TEXT",
     [ZNES_SEGMENT_TEMP] = "TEMP",
+    [ZNES_SEGMENT_CHR]  = "CHR",
 };
 
 #endif /* ZNES_SEGMENT_H */
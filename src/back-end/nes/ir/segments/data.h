@@ -10,15 +10,18 @@
 typedef struct ZnesDataSegment {
     ZnesAllocInstructionList *allocations;
     uint16_t base_address;
+    size_t end_address;
     size_t used;
 } ZnesDataSegment;
 
-static inline ZnesDataSegment* znes_data_segment_new(uint16_t base_address)
+static inline ZnesDataSegment* znes_data_segment_new(uint16_t base_address, size_t size)
 {
     ZnesDataSegment *data = fl_malloc(sizeof(ZnesDataSegment));
 
     data->allocations = znes_alloc_instruction_list_new();
     data->base_address = base_address;
+    // The first address after the segment, the allocations must end before it
+    data->end_address = base_address + size;
     data->used = base_address;
 
     return data;
@@ -35,19 +38,18 @@ static inline ZnesAlloc* znes_data_segment_alloc_variable(ZnesDataSegment *data,
 {
     size_t needed_space = alloc->size;
 
-    /*// If there is no available space to store the symbol, we can't do anything
-    if (data->used + needed_space > ???DATA_SIZE)
-        return false;
-
     // If the address is outside of DATA or the element does not fit, we can't do anything
-    if (address != NULL && (*address > ???DATA_SIZE || *address + needed_space > ???DATA_SIZE))
-        return false;    */
+    if (alloc->use_address && (alloc->address < data->base_address || alloc->address + needed_space > data->end_address))
+        return NULL;
 
     ZnesAlloc *nes_symbol = NULL;
     struct FlListNode *head = fl_list_head(data->allocations);
 
     if (head == NULL)
     {
+        if (data->base_address + needed_space > data->end_address)
+            return NULL;
+
         // When there are no symbols, we can directly insert the symbol
         nes_symbol = znes_alloc_new(alloc->type, name, ZNES_SEGMENT_DATA, alloc->size, alloc->use_address ? alloc->address : data->base_address);
         fl_list_append(data->allocations, znes_alloc_instruction_new(nes_symbol, source));
@@ -69,7 +71,7 @@ static inline ZnesAlloc* znes_data_segment_alloc_variable(ZnesDataSegment *data,
             // can be:
             //  a)  We are at the last element of the list, so it is safe to place the symbol at the end (calculating the address)
             //  b)  There is space between the last symbol we visited (node->prev) and the current symbol being visited
-            bool fits_at_the_end = node->next == NULL;
+            bool fits_at_the_end = node->next == NULL && symbol->address + symbol->size + needed_space <= data->end_address;
 
             // If the address overflows, we break the loop
             if (fl_std_uint_add_overflow(probe_address, needed_space, UINT16_MAX))
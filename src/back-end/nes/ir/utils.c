@@ -3,6 +3,7 @@
 #include "utils.h"
 #include "context.h"
 #include "operands/array.h"
+#include "operands/blob.h"
 #include "operands/bool.h"
 #include "operands/reference.h"
 #include "operands/struct.h"
@@ -62,6 +63,7 @@ ZnesAllocType znes_utils_variable_type_from_operand(ZnesOperand *operand)
             break;
 
         case ZNES_OPERAND_ARRAY:
+        case ZNES_OPERAND_BLOB:
             var_type = ZNES_ALLOC_TYPE_ARRAY;
             break;
 
@@ -109,7 +111,7 @@ ZnesAllocType znes_utils_zir_type_to_nes_type(ZirSymbol *zir_symbol)
     return ZNES_ALLOC_TYPE_UNK;
 }
 
-static inline ZnesOperand* internal_make_nes_operand(ZnesContext *znes_context, ZirOperand *zir_opn)
+ZnesOperand* znes_utils_make_nes_operand(ZnesContext *znes_context, ZirOperand *zir_opn)
 {
     switch (zir_opn->type)
     {
@@ -134,13 +136,13 @@ static inline ZnesOperand* internal_make_nes_operand(ZnesContext *znes_context,
                 default: break;
             }
             
-            return (ZnesOperand*) znes_uint_operand_new(size, value);
+            return (ZnesOperand*) znes_operand_pool_new_uint(znes_context->operands, size, value);
         }
         case ZIR_OPERAND_BOOL:
         {
             ZirBoolOperand *zir_bool_opn = (ZirBoolOperand*) zir_opn;
 
-            return (ZnesOperand*) znes_bool_operand_new(zir_bool_opn->value);
+            return (ZnesOperand*) znes_operand_pool_new_bool(znes_context->operands, zir_bool_opn->value);
         }
         case ZIR_OPERAND_ARRAY:
         {
@@ -149,23 +151,40 @@ static inline ZnesOperand* internal_make_nes_operand(ZnesContext *znes_context,
             size_t member_size = zir_type_size(zir_array_opn->type->member_type, ZNES_POINTER_SIZE);
             size_t length = zir_array_opn->type->length;
 
-            ZnesArrayOperand *array_operand = znes_array_operand_new(member_size, length);
+            ZnesArrayOperand *array_operand = znes_operand_pool_new_array(znes_context->operands, member_size, length);
 
             for (size_t i=0; i < fl_array_length(zir_array_opn->elements); i++)
+            {
                 array_operand->elements[i] = znes_utils_make_nes_operand(znes_context, zir_array_opn->elements[i]);
 
+                if (array_operand->elements[i] == NULL)
+                    return NULL;
+            }
+
             return (ZnesOperand*) array_operand;
         }
+        case ZIR_OPERAND_BLOB:
+        {
+            ZirBlobOperand *zir_blob_opn = (ZirBlobOperand*) zir_opn;
+
+            // The NES operand shares the bytes of the ZIR operand
+            return (ZnesOperand*) znes_operand_pool_new_blob(znes_context->operands, zir_blob_opn->bytes, zir_blob_opn->length);
+        }
         case ZIR_OPERAND_STRUCT:
         {
             ZirStructOperand *zir_struct_opn = (ZirStructOperand*) zir_opn;
 
-            ZnesStructOperand *struct_operand = znes_struct_operand_new();
+            ZnesStructOperand *struct_operand = znes_operand_pool_new_struct(znes_context->operands);
 
             for (size_t i = 0; i < fl_array_length(zir_struct_opn->members); i++)
             {
                 ZirStructOperandMember *member = zir_struct_opn->members[i];
-                znes_struct_operand_add_member(struct_operand, member->name, znes_utils_make_nes_operand(znes_context, member->operand));
+                ZnesOperand *member_operand = znes_utils_make_nes_operand(znes_context, member->operand);
+
+                if (member_operand == NULL)
+                    return NULL;
+
+                znes_struct_operand_add_member(struct_operand, member->name, member_operand);
             }
 
             return (ZnesOperand*) struct_operand;
@@ -176,7 +195,18 @@ static inline ZnesOperand* internal_make_nes_operand(ZnesContext *znes_context,
 
             ZnesAlloc *variable = fl_hashtable_get(znes_context->program->allocations, zir_symbol_opn->symbol->name);
 
-            return (ZnesOperand*) znes_variable_operand_new(variable);
+            // The allocation of the variable failed, and the error has already been reported
+            if (variable == NULL && znes_context_has_errors(znes_context))
+                return NULL;
+
+            // The pattern tables are only visible to the PPU
+            if (variable != NULL && variable->segment == ZNES_SEGMENT_CHR)
+            {
+                znes_context_error(znes_context, ZNES_ERROR_ALLOC, "Variable '%s' lives in the CHR-ROM, the CPU cannot read it", variable->name);
+                return NULL;
+            }
+
+            return (ZnesOperand*) znes_operand_pool_new_variable(znes_context->operands, variable);
         }
         case ZIR_OPERAND_REFERENCE:
         {
@@ -184,8 +214,11 @@ static inline ZnesOperand* internal_make_nes_operand(ZnesContext *znes_context,
 
             ZnesOperand *operand = znes_utils_make_nes_operand(znes_context, (ZirOperand*) zir_ref_opn->operand);
             
+            if (operand == NULL)
+                return NULL;
+
             if (operand->type == ZNES_OPERAND_VARIABLE)
-                return (ZnesOperand*) znes_reference_operand_new((ZnesVariableOperand*) operand);
+                return (ZnesOperand*) znes_operand_pool_new_reference(znes_context->operands, (ZnesVariableOperand*) operand);
 
             znes_context_error(znes_context, ZNES_ERROR_INTERNAL, "Operand of a ZIR reference operand is not a NES variable operand");
 
@@ -193,21 +226,11 @@ static inline ZnesOperand* internal_make_nes_operand(ZnesContext *znes_context,
         }
     }
 
-    znes_context_error(znes_context, ZNES_ERROR_INTERNAL, "Unhandled ZIR operand type in internal_make_nes_operand");
+    znes_context_error(znes_context, ZNES_ERROR_INTERNAL, "Unhandled ZIR operand type in znes_utils_make_nes_operand");
 
     return NULL;
 }
 
-ZnesOperand* znes_utils_make_nes_operand(ZnesContext *znes_context, ZirOperand *zir_opn)
-{
-    ZnesOperand *operand = internal_make_nes_operand(znes_context, zir_opn);
-
-    if (operand != NULL)
-        znes_operand_pool_register(znes_context->operands, operand);
-
-    return operand;
-}
-
 bool znes_alloc_request_init(ZnesContext *znes_context, ZirBlock *zir_block, ZirSymbol *zir_symbol, ZirAttributeMap *zir_attributes, ZnesAllocRequest *znes_alloc_request)
 {
     if (zir_symbol->name[0] == '%')
@@ -219,6 +242,14 @@ bool znes_alloc_request_init(ZnesContext *znes_context, ZirBlock *zir_block, Zir
         znes_alloc_request->use_address = false;
         znes_alloc_request->size = zir_type_size(zir_symbol->type, ZNES_POINTER_SIZE);
 
+        // Temporal symbols with disjoint lifetimes share the same slot, we use the one assigned by the liveness analysis
+        uint16_t temp_slot = 0;
+        if (znes_context->temp_slots != NULL && znes_temp_slots_get(znes_context->temp_slots, zir_symbol->name, &temp_slot))
+        {
+            znes_alloc_request->address = temp_slot;
+            znes_alloc_request->use_address = true;
+        }
+
         // Return, we don't need anything else
         return true;
     }
@@ -285,6 +316,33 @@ bool znes_alloc_request_init(ZnesContext *znes_context, ZirBlock *zir_block, Zir
             {
                 znes_alloc_request->segment = ZNES_SEGMENT_DATA;
             }
+            else if (flm_cstring_equals(symbol_operand->symbol->name, "chr"))
+            {
+                // The CHR-ROM is written once in the ROM file, so only the global variables can live there
+                if (!znes_alloc_request->is_global)
+                {
+                    znes_context_error(znes_context, ZNES_ERROR_ALLOC, "Variable '%s' must be a global variable to be placed in the CHR segment", zir_symbol->name);
+                    return false;
+                }
+
+                znes_alloc_request->segment = ZNES_SEGMENT_CHR;
+
+                // In the CHR segment, the address property is an address of the PPU pattern tables
+                if (zir_property_map_has_key(nes_attribute->properties, "address"))
+                {
+                    ZirProperty *address_property = zir_property_map_get(nes_attribute->properties, "address");
+
+                    if (address_property->value->type != ZIR_OPERAND_UINT)
+                    {
+                        znes_context_error(znes_context, ZNES_ERROR_INTERNAL, "Property 'address' in attribute 'NES' is not a valid number");
+                        return false;
+                    }
+
+                    ZirUintOperand *uint_value = (ZirUintOperand*) address_property->value;
+                    znes_alloc_request->use_address = true;
+                    znes_alloc_request->address = uint_value->type->size == ZIR_UINT_8 ? uint_value->value.uint8 : uint_value->value.uint16;
+                }
+            }
             else
             {
                 znes_context_error(znes_context, ZNES_ERROR_INTERNAL, "Unknown property '%s' in attribute 'NES'", symbol_operand->symbol->name);
@@ -338,6 +396,47 @@ bool znes_alloc_request_init(ZnesContext *znes_context, ZirBlock *zir_block, Zir
             }
             
         }
+
+        // If the "bank" property is present, the variable lives in one of the switchable PRG-ROM banks that the
+        // mapper places at $8000-$BFFF. The bank 0 is the default one, it is mapped whenever the code is not
+        // reading from other bank
+        if (zir_property_map_has_key(nes_attribute->properties, "bank"))
+        {
+            ZirProperty *bank_property = zir_property_map_get(nes_attribute->properties, "bank");
+
+            if (bank_property->value->type != ZIR_OPERAND_UINT)
+            {
+                znes_context_error(znes_context, ZNES_ERROR_INTERNAL, "Property 'bank' in attribute 'NES' is not a valid number");
+                return false;
+            }
+
+            ZirUintOperand *uint_value = (ZirUintOperand*) bank_property->value;
+            unsigned int bank = uint_value->type->size == ZIR_UINT_8 ? uint_value->value.uint8 : uint_value->value.uint16;
+
+            if (znes_context->program->mapper == ZNES_MAPPER_NROM)
+            {
+                znes_context_error(znes_context, ZNES_ERROR_ALLOC, "Variable '%s' uses the 'bank' property, but the NROM board does not switch banks", zir_symbol->name);
+                return false;
+            }
+
+            // The last bank is the fixed one
+            if (bank > ZNES_BANK_COUNT - 2)
+            {
+                znes_context_error(znes_context, ZNES_ERROR_ALLOC, "Bank %u of variable '%s' is out of range, the last switchable bank is %u", bank, zir_symbol->name, ZNES_BANK_COUNT - 2);
+                return false;
+            }
+
+            bool in_window = znes_alloc_request->address >= ZNES_BANK_WINDOW_ADDRESS && znes_alloc_request->address < ZNES_BANK_WINDOW_ADDRESS + ZNES_BANK_WINDOW_SIZE;
+
+            if (znes_alloc_request->segment != ZNES_SEGMENT_DATA || (znes_alloc_request->use_address && !in_window))
+            {
+                znes_context_error(znes_context, ZNES_ERROR_ALLOC, "Variable '%s' in bank %u must be placed in the DATA segment between $%04X and $%04X", 
+                    zir_symbol->name, bank, ZNES_BANK_WINDOW_ADDRESS, ZNES_BANK_WINDOW_ADDRESS + ZNES_BANK_WINDOW_SIZE - 1);
+                return false;
+            }
+
+            znes_alloc_request->bank = (uint8_t) bank;
+        }
     }
 
     return true;
@@ -3,4 +3,24 @@
 
 #define ZNES_POINTER_SIZE 2 /* bytes */
 
+// Number of 16KB PRG-ROM banks the supported mappers can switch (the last one is always fixed at $C000)
+#define ZNES_BANK_COUNT 16
+
+// The CPU window where the switchable banks are mapped ($8000-$BFFF)
+#define ZNES_BANK_WINDOW_ADDRESS 0x8000
+#define ZNES_BANK_WINDOW_SIZE 0x4000
+
+// The CHR-ROM fills the pattern tables of the PPU address space ($0000-$1FFF)
+#define ZNES_CHR_SIZE 0x2000
+
+/*
+ * Enum: ZnesMapper
+ *  The boards supported by the NES backend, the values are the iNES mapper numbers
+ */
+typedef enum ZnesMapper {
+    ZNES_MAPPER_NROM = 0,
+    ZNES_MAPPER_MMC1 = 1,
+    ZNES_MAPPER_UXROM = 2,
+} ZnesMapper;
+
 #endif /* ZNES_NES_H */
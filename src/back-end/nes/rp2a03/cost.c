@@ -0,0 +1,400 @@
+#include <inttypes.h>
+#include <string.h>
+#include <fllib/Mem.h>
+#include <fllib/Array.h>
+#include <fllib/Cstring.h>
+#include "cost.h"
+#include "instruction.h"
+#include "link.h"
+
+/*
+ * Function: reads_operand
+ *  The indexed reads pay an extra cycle when the index crosses a page, the stores and the read-modify-write
+ *  instructions always pay it (it is part of their base cycles)
+ */
+static inline bool reads_operand(Rp2a03Mnemonic mnemonic)
+{
+    switch (mnemonic)
+    {
+        case NES_OP_ADC: case NES_OP_AND: case NES_OP_CMP: case NES_OP_EOR:
+        case NES_OP_LDA: case NES_OP_LDX: case NES_OP_LDY: case NES_OP_ORA:
+        case NES_OP_SBC:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*
+ * Function: rp2a03_cost_instruction
+ *  Adds the size and the cycles of the instruction at *bytes* to the cost. The best case is the base
+ *  cycles of the opcode (branches not taken), the worst case adds the penalties that might apply:
+ *
+ *  - A taken branch costs 1 cycle more, and 2 if the target is in another page (known once the segment
+ *    is placed)
+ *  - An indexed read (abs,X abs,Y) costs 1 cycle more if the index crosses a page, which cannot happen
+ *    when the base address is page aligned
+ *  - An indirect indexed read ((zp),Y) might always cross a page
+ *
+ * Parameters:
+ *  <const uint8_t> *bytes: The instruction's bytes
+ *  <uint16_t> address: The address of the instruction in the PRG-ROM
+ *  <Rp2a03Cost> *cost: The cost to update
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void rp2a03_cost_instruction(const uint8_t *bytes, uint16_t address, Rp2a03Cost *cost)
+{
+    const Rp2a03Instruction *instr = rp2a03_instruction_lookup(bytes[0]);
+
+    size_t penalty = 0;
+
+    switch (instr->mode)
+    {
+        case NES_ADDR_REL:
+        {
+            uint16_t next = address + 2;
+            uint16_t target = next + (int8_t) bytes[1];
+            penalty = (next & 0xFF00) != (target & 0xFF00) ? 2 : 1;
+            break;
+        }
+
+        case NES_ADDR_ABX:
+        case NES_ADDR_ABY:
+            penalty = reads_operand(instr->mnemonic) && bytes[1] != 0 ? 1 : 0;
+            break;
+
+        case NES_ADDR_INY:
+            penalty = reads_operand(instr->mnemonic) ? 1 : 0;
+            break;
+
+        default:
+            break;
+    }
+
+    cost->instructions++;
+    cost->bytes += instr->size;
+    cost->best_cycles += instr->cycles;
+    cost->worst_cycles += instr->cycles + penalty;
+}
+
+static void add_cost(Rp2a03Cost *cost, const Rp2a03Cost *other)
+{
+    cost->instructions += other->instructions;
+    cost->bytes += other->bytes;
+    cost->best_cycles += other->best_cycles;
+    cost->worst_cycles += other->worst_cycles;
+    cost->unbounded = cost->unbounded || other->unbounded;
+}
+
+static Rp2a03CostEntry* entry_for(Rp2a03CostEntry **entries, const char *segment, uint16_t origin, uint16_t address)
+{
+    size_t count = fl_array_length(*entries);
+
+    for (size_t i=0; i < count; i++)
+        if ((*entries)[i].segment == segment && (*entries)[i].origin == origin)
+            return *entries + i;
+
+    Rp2a03CostEntry entry = { .segment = segment, .origin = origin, .address = address, .cost = { 0 } };
+    *entries = fl_array_append(*entries, &entry);
+
+    return *entries + count;
+}
+
+/*
+ * Function: loop_trip_count
+ *  The loops emitted by the compiler (copy, fill and clear loops, see <emit_copy_loops> and <emit_bss_range>)
+ *  use X as their counter: a LDX #n right before the first instruction of the body, and a DEX or INX right
+ *  before the BNE that closes the loop. Returns the number of iterations of the loop closed by the backward
+ *  branch at *pc*, and stores the address of the first instruction of the body in *start*. If the branch
+ *  does not close a loop like that, or the body contains other jumps, it returns 0.
+ */
+static size_t loop_trip_count(Rp2a03TextSegment *segment, const bool *starts, uint16_t pc, uint16_t *start)
+{
+    int target = (int) pc + 2 + (int8_t) segment->bytes[pc + 1];
+
+    if (segment->bytes[pc] != rp2a03_opcode_lookup(NES_OP_BNE, NES_ADDR_REL) || target < 2 || !starts[target] || !starts[target - 2] || !starts[pc - 1])
+        return 0;
+
+    if (segment->bytes[target - 2] != rp2a03_opcode_lookup(NES_OP_LDX, NES_ADDR_IMM))
+        return 0;
+
+    for (uint16_t body = (uint16_t) target; body < pc - 1; body += rp2a03_instruction_lookup(segment->bytes[body])->size)
+    {
+        const Rp2a03Instruction *instr = rp2a03_instruction_lookup(segment->bytes[body]);
+
+        if (instr->mode == NES_ADDR_REL || instr->mnemonic == NES_OP_JMP || instr->mnemonic == NES_OP_JSR || instr->mnemonic == NES_OP_LDX)
+            return 0;
+    }
+
+    uint8_t initial = segment->bytes[target - 1];
+    *start = (uint16_t) target;
+
+    // LDX #0 and DEX runs 256 times, the INX loops run until X wraps around
+    if (segment->bytes[pc - 1] == rp2a03_opcode_lookup(NES_OP_DEX, NES_ADDR_IMP))
+        return initial == 0 ? 256 : initial;
+
+    if (segment->bytes[pc - 1] == rp2a03_opcode_lookup(NES_OP_INX, NES_ADDR_IMP))
+        return 256 - (size_t) initial;
+
+    return 0;
+}
+
+/*
+ * Function: add_loop_iterations
+ *  The first pass counts each instruction once, this function adds the other iterations of the loops
+ *  to the cost of the declarations their instructions come from. In those iterations the closing branch
+ *  is taken. The backward branches that do not close a known loop make the cost of their entry unbounded.
+ */
+static Rp2a03CostEntry* add_loop_iterations(Rp2a03CostEntry *entries, Rp2a03TextSegment *segment, const char *name)
+{
+    bool *starts = fl_malloc(sizeof(bool) * (segment->pc + 1));
+    memset(starts, 0, sizeof(bool) * (segment->pc + 1));
+
+    for (uint16_t pc=0; pc < segment->pc; pc += rp2a03_instruction_lookup(segment->bytes[pc])->size)
+        starts[pc] = true;
+
+    for (uint16_t pc=0; pc < segment->pc; pc += rp2a03_instruction_lookup(segment->bytes[pc])->size)
+    {
+        const Rp2a03Instruction *instr = rp2a03_instruction_lookup(segment->bytes[pc]);
+
+        if (instr->mode != NES_ADDR_REL || (int8_t) segment->bytes[pc + 1] >= 0)
+            continue;
+
+        uint16_t start = 0;
+        size_t trip_count = loop_trip_count(segment, starts, pc, &start);
+
+        if (trip_count == 0)
+        {
+            entry_for(&entries, name, segment->origins[pc], segment->base_address + pc)->cost.unbounded = true;
+            continue;
+        }
+
+        for (uint16_t body = start; body <= pc; body += rp2a03_instruction_lookup(segment->bytes[body])->size)
+        {
+            Rp2a03Cost iteration = { 0 };
+            rp2a03_cost_instruction(segment->bytes + body, segment->base_address + body, &iteration);
+
+            // The worst case of the branch is the taken branch
+            if (body == pc)
+                iteration.best_cycles = iteration.worst_cycles;
+
+            Rp2a03CostEntry *entry = entry_for(&entries, name, segment->origins[body], segment->base_address + body);
+            entry->cost.best_cycles += iteration.best_cycles * (trip_count - 1);
+            entry->cost.worst_cycles += iteration.worst_cycles * (trip_count - 1);
+        }
+    }
+
+    fl_free(starts);
+
+    return entries;
+}
+
+static Rp2a03CostEntry* analyze_segment(Rp2a03Program *program, Rp2a03CostEntry *entries, Rp2a03TextSegment *segment, const char *name)
+{
+    for (uint16_t pc=0; pc < segment->pc;)
+    {
+        const Rp2a03Instruction *instr = rp2a03_instruction_lookup(segment->bytes[pc]);
+        uint16_t address = segment->base_address + pc;
+
+        Rp2a03CostEntry *entry = entry_for(&entries, name, segment->origins[pc], address);
+        rp2a03_cost_instruction(segment->bytes + pc, address, &entry->cost);
+
+        pc += instr->size;
+    }
+
+    entries = add_loop_iterations(entries, segment, name);
+
+    // The linker chains the reset sequence with a JMP at the end of the segment
+    if (segment->pc > 0 && (segment == program->startup || segment == program->code))
+    {
+        Rp2a03CostEntry *entry = entry_for(&entries, name, 0, segment->base_address + segment->pc);
+        const uint8_t jmp[RP2A03_LINK_JMP_SIZE] = { rp2a03_opcode_lookup(NES_OP_JMP, NES_ADDR_ABS), 0, 0 };
+        rp2a03_cost_instruction(jmp, segment->base_address + segment->pc, &entry->cost);
+    }
+
+    return entries;
+}
+
+/*
+ * Function: rp2a03_cost_analyze
+ *  Computes the static cost of the program's text segments: the bytes and the best and worst case
+ *  cycles of the instructions, attributed to the declarations they come from (see <rp2a03_program_add_origin>).
+ *  The program must be placed (see <rp2a03_link_place>), because the branch penalties depend on the
+ *  addresses. The code of a declaration counts once per segment, even if it is not contiguous, and the
+ *  code that does not come from a declaration (BSS clearing, the JMPs of the linker) is attributed to
+ *  the origin 0. The cycles of the loops emitted by the compiler are multiplied by their trip count (see
+ *  <loop_trip_count>), any other loop makes the worst case of its entry unbounded.
+ *
+ * Parameters:
+ *  <Rp2a03Program> *program: The program object
+ *
+ * Returns:
+ *  Rp2a03CostEntry*: An array with one entry for each declaration and segment, in order of appearance. The
+ *                    array must be freed with <fl_array_free>
+ */
+Rp2a03CostEntry* rp2a03_cost_analyze(Rp2a03Program *program)
+{
+    Rp2a03CostEntry *entries = fl_array_new(sizeof(Rp2a03CostEntry), 0);
+
+    entries = analyze_segment(program, entries, program->startup, "STARTUP");
+    entries = analyze_segment(program, entries, program->code, "CODE");
+
+    for (size_t i=0; i < fl_array_length(program->blobs); i++)
+        entries = analyze_segment(program, entries, program->blobs[i], "BLOB");
+
+    return entries;
+}
+
+/*
+ * Function: rp2a03_cost_total
+ *  Returns the sum of the cost of the entries of a segment, or of all of them if *segment* is NULL
+ */
+Rp2a03Cost rp2a03_cost_total(Rp2a03CostEntry *entries, const char *segment)
+{
+    Rp2a03Cost total = { 0 };
+
+    for (size_t i=0; i < fl_array_length(entries); i++)
+        if (segment == NULL || flm_cstring_equals(entries[i].segment, segment))
+            add_cost(&total, &entries[i].cost);
+
+    return total;
+}
+
+static inline const char* origin_name(Rp2a03Program *program, uint16_t origin)
+{
+    return origin == 0 ? "(compiler)" : program->origins[origin].declaration;
+}
+
+static inline void worst_cycles(const Rp2a03Cost *cost, char *buffer, size_t size)
+{
+    if (cost->unbounded)
+        snprintf(buffer, size, "inf");
+    else
+        snprintf(buffer, size, "%zu", cost->worst_cycles);
+}
+
+/*
+ * Function: rp2a03_cost_report
+ *  Appends a table with the cost of each entry (the location is line:col of the declaration) and the
+ *  totals of the STARTUP and CODE segments and of the whole program. The unbounded worst cases are
+ *  reported as "inf".
+ */
+char* rp2a03_cost_report(Rp2a03Program *program, Rp2a03CostEntry *entries, char *output)
+{
+    fl_cstring_vappend(&output, "%-8s %-20s %-12s %-6s %6s %6s %6s %6s\n", "segment", "declaration", "location", "addr", "instrs", "bytes", "best", "worst");
+
+    for (size_t i=0; i < fl_array_length(entries); i++)
+    {
+        Rp2a03CostEntry *entry = entries + i;
+        Rp2a03Origin *origin = program->origins + entry->origin;
+
+        char location[32] = "-";
+        if (entry->origin != 0)
+            snprintf(location, sizeof(location), "%u:%u", origin->line, origin->col);
+
+        char worst[32];
+        worst_cycles(&entry->cost, worst, sizeof(worst));
+
+        fl_cstring_vappend(&output, "%-8s %-20s %-12s $%04"PRIX16" %6zu %6zu %6zu %6s\n",
+            entry->segment, origin_name(program, entry->origin), location, entry->address,
+            entry->cost.instructions, entry->cost.bytes, entry->cost.best_cycles, worst);
+    }
+
+    const char *segments[] = { "STARTUP", "CODE", NULL };
+
+    for (size_t i=0; i < sizeof(segments) / sizeof(segments[0]); i++)
+    {
+        Rp2a03Cost total = rp2a03_cost_total(entries, segments[i]);
+        char worst[32];
+        worst_cycles(&total, worst, sizeof(worst));
+
+        fl_cstring_vappend(&output, "%-8s %-20s %-12s %-5s %6zu %6zu %6zu %6s\n",
+            "total", segments[i] != NULL ? segments[i] : "", "", "", total.instructions, total.bytes, total.best_cycles, worst);
+    }
+
+    return output;
+}
+
+static char* append_json_string(char *output, const char *string)
+{
+    if (string == NULL)
+    {
+        fl_cstring_append(&output, "null");
+        return output;
+    }
+
+    fl_cstring_append(&output, "\"");
+
+    for (const char *c = string; *c; c++)
+    {
+        if (*c == '"' || *c == '\\')
+            fl_cstring_vappend(&output, "\\%c", *c);
+        else if ((unsigned char) *c < 0x20)
+            fl_cstring_vappend(&output, "\\u%04x", (unsigned char) *c);
+        else
+            fl_cstring_vappend(&output, "%c", *c);
+    }
+
+    fl_cstring_append(&output, "\"");
+
+    return output;
+}
+
+static char* append_json_cost(char *output, const Rp2a03Cost *cost)
+{
+    fl_cstring_vappend(&output, "\"instructions\": %zu, \"bytes\": %zu, \"best_cycles\": %zu, \"worst_cycles\": ",
+        cost->instructions, cost->bytes, cost->best_cycles);
+
+    if (cost->unbounded)
+        fl_cstring_append(&output, "null");
+    else
+        fl_cstring_vappend(&output, "%zu", cost->worst_cycles);
+
+    return output;
+}
+
+/*
+ * Function: rp2a03_cost_report_json
+ *  Appends the same information of <rp2a03_cost_report> as a JSON object with the "entries" array and the
+ *  "totals" object. The code that does not come from a declaration has a null declaration, and the
+ *  unbounded worst cases are null.
+ */
+char* rp2a03_cost_report_json(Rp2a03Program *program, Rp2a03CostEntry *entries, char *output)
+{
+    fl_cstring_append(&output, "{\n  \"entries\": [");
+
+    for (size_t i=0; i < fl_array_length(entries); i++)
+    {
+        Rp2a03CostEntry *entry = entries + i;
+        Rp2a03Origin *origin = program->origins + entry->origin;
+
+        fl_cstring_vappend(&output, "%s\n    { \"segment\": \"%s\", \"declaration\": ", i > 0 ? "," : "", entry->segment);
+        output = append_json_string(output, entry->origin != 0 ? origin->declaration : NULL);
+        fl_cstring_append(&output, ", \"file\": ");
+        output = append_json_string(output, origin->filename);
+        fl_cstring_vappend(&output, ", \"line\": %u, \"col\": %u, \"address\": %"PRIu16", ", origin->line, origin->col, entry->address);
+        output = append_json_cost(output, &entry->cost);
+        fl_cstring_append(&output, " }");
+    }
+
+    fl_cstring_append(&output, "\n  ],\n  \"totals\": {");
+
+    const char *segments[] = { "STARTUP", "CODE" };
+
+    for (size_t i=0; i < sizeof(segments) / sizeof(segments[0]); i++)
+    {
+        Rp2a03Cost total = rp2a03_cost_total(entries, segments[i]);
+        fl_cstring_vappend(&output, "\n    \"%s\": { ", segments[i]);
+        output = append_json_cost(output, &total);
+        fl_cstring_append(&output, " },");
+    }
+
+    Rp2a03Cost total = rp2a03_cost_total(entries, NULL);
+    fl_cstring_append(&output, "\n    \"total\": { ");
+    output = append_json_cost(output, &total);
+    fl_cstring_append(&output, " }\n  }\n}\n");
+
+    return output;
+}
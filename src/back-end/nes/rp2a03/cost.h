@@ -0,0 +1,30 @@
+#ifndef RP2A03_COST_H
+#define RP2A03_COST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "program.h"
+
+typedef struct Rp2a03Cost {
+    size_t instructions;
+    size_t bytes;
+    size_t best_cycles;
+    size_t worst_cycles;
+    bool unbounded;
+} Rp2a03Cost;
+
+typedef struct Rp2a03CostEntry {
+    const char *segment;
+    uint16_t origin;
+    uint16_t address;
+    Rp2a03Cost cost;
+} Rp2a03CostEntry;
+
+void rp2a03_cost_instruction(const uint8_t *bytes, uint16_t address, Rp2a03Cost *cost);
+Rp2a03CostEntry* rp2a03_cost_analyze(Rp2a03Program *program);
+Rp2a03Cost rp2a03_cost_total(Rp2a03CostEntry *entries, const char *segment);
+char* rp2a03_cost_report(Rp2a03Program *program, Rp2a03CostEntry *entries, char *output);
+char* rp2a03_cost_report_json(Rp2a03Program *program, Rp2a03CostEntry *entries, char *output);
+
+#endif /* RP2A03_COST_H */
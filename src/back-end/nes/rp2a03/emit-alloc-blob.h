@@ -0,0 +1,71 @@
+#ifndef RP2A03_EMIT_ALLOC_BLOB_H
+#define RP2A03_EMIT_ALLOC_BLOB_H
+
+#include <string.h>
+#include "program.h"
+#include "../ir/operands/blob.h"
+#include "../ir/program.h"
+#include "../ir/instructions/alloc.h"
+
+/*
+ * Function: build_blob_image
+ *  Writes the bytes of the blob into the *size* bytes of the *image* buffer. If the members of the destination
+ *  are wider than a byte (e.g. [N]uint16), each byte of the blob is the low byte of a member
+ */
+static inline void build_blob_image(ZnesBlobOperand *blob, uint8_t *image, size_t size)
+{
+    size_t member_size = blob->length > 0 ? size / blob->length : 1;
+
+    if (member_size <= 1)
+    {
+        size_t to_copy = blob->length < size ? blob->length : size;
+
+        memcpy(image, blob->bytes, to_copy);
+        memset(image + to_copy, 0, size - to_copy);
+        return;
+    }
+
+    memset(image, 0, size);
+
+    for (size_t i=0; i < blob->length; i++)
+        image[i * member_size] = blob->bytes[i];
+}
+
+static inline bool emit_alloc_from_blob(Rp2a03Program *program, Rp2a03TextSegment *segment, bool is_startup, ZnesAllocInstruction *instruction)
+{
+    ZnesBlobOperand *blob = (ZnesBlobOperand*) instruction->source;
+    ZnesAlloc *destination = instruction->destination;
+
+    if (destination->size == 0)
+        return true;
+
+    // The CHR-ROM is not visible to the CPU, its bytes are always written in the ROM
+    if ((destination->segment == ZNES_SEGMENT_DATA && is_startup) || destination->segment == ZNES_SEGMENT_CHR)
+    {
+        // The blob is copied straight into the segment
+        Rp2a03DataSegment *data = rp2a03_program_alloc_segment(program, destination);
+        build_blob_image(blob, data->bytes + (destination->address - data->base_address), destination->size);
+        return true;
+    }
+
+    // In RAM, the bytes are stored one by one. The initializer replaces this code with copy loops
+    // when they need less ROM space (see <rp2a03_emit_alloc_initializer>)
+    uint8_t *image = fl_malloc(destination->size);
+    build_blob_image(blob, image, destination->size);
+
+    for (size_t i=0; i < destination->size; i++)
+    {
+        rp2a03_program_emit_imm(program, segment, NES_OP_LDA, image[i]);
+
+        if (destination->segment == ZNES_SEGMENT_ZP)
+            rp2a03_program_emit_zpg(program, segment, NES_OP_STA, (uint8_t)(destination->address + i));
+        else
+            rp2a03_program_emit_abs(program, segment, NES_OP_STA, destination->address + i);
+    }
+
+    fl_free(image);
+
+    return true;
+}
+
+#endif /* RP2A03_EMIT_ALLOC_BLOB_H */
@@ -11,11 +11,7 @@ static inline bool emit_alloc_from_reference(Rp2a03Program *program, Rp2a03TextS
     ZnesReferenceOperand *reference_operand = (ZnesReferenceOperand*) instruction->source;
     ZnesAlloc *ref_variable = reference_operand->operand->variable;
 
-    // TODO: Should we loop through the temp object?
-    if (ref_variable->type == ZNES_ALLOC_TYPE_TEMP)
-        ref_variable = ((ZnesVariableOperand*) ((ZnesTempAlloc*) ref_variable)->source)->variable;
-
-    if (ref_variable == NULL)
+    if (ref_variable == NULL || ref_variable->type == ZNES_ALLOC_TYPE_TEMP)
         return false;
 
     if (instruction->destination->segment == ZNES_SEGMENT_ZP)
@@ -36,7 +32,8 @@ static inline bool emit_alloc_from_reference(Rp2a03Program *program, Rp2a03TextS
     {
         if (is_startup)
         {
-            uint8_t *data_seg_slot = program->data->bytes + (instruction->destination->address - program->data->base_address);
+            Rp2a03DataSegment *data = rp2a03_program_data_segment(program, instruction->destination->bank);
+            uint8_t *data_seg_slot = data->bytes + (instruction->destination->address - data->base_address);
             *data_seg_slot       = ref_variable->address & 0xFF;
             *(data_seg_slot+1)   = (ref_variable->address >> 8) & 0xFF;
         }
@@ -0,0 +1,312 @@
+#ifndef RP2A03_EMIT_ALLOC_TABLE_H
+#define RP2A03_EMIT_ALLOC_TABLE_H
+
+#include "program.h"
+#include "emit-alloc.h"
+#include "../ir/program.h"
+#include "../ir/operands/array.h"
+#include "../ir/operands/blob.h"
+#include "../ir/operands/bool.h"
+#include "../ir/operands/reference.h"
+#include "../ir/operands/struct.h"
+#include "../ir/operands/uint.h"
+#include "../ir/operands/variable.h"
+#include "../ir/objects/array.h"
+#include "../ir/objects/struct.h"
+#include "../ir/instructions/alloc.h"
+
+/*
+ * Constant: COPY_LOOP_SIZE
+ *  Bytes used by the loop that copies a chunk of the ROM table into RAM:
+ *      LDX #len; LDA table-1,X; STA dest-1,X; DEX; BNE loop
+ *  or, for a full page:
+ *      LDX #0; LDA table,X; STA dest,X; INX; BNE loop
+ */
+#define COPY_LOOP_SIZE 11
+
+/*
+ * Constant: FILL_LOOP_SIZE
+ *  Bytes used by the loop that fills a chunk of RAM with the same value (a run):
+ *      LDA #value; LDX #len; STA dest-1,X; DEX; BNE loop
+ *  or, for a full page:
+ *      LDA #value; LDX #0; STA dest,X; INX; BNE loop
+ */
+#define FILL_LOOP_SIZE 10
+
+/*
+ * Constant: LOOP_CHUNK_SIZE
+ *  The X register is used as the loop counter, so each loop handles up to 256 bytes
+ */
+#define LOOP_CHUNK_SIZE 0x100
+
+/*
+ * Struct: Rp2a03LoopCounter
+ *  How the X register walks a chunk of up to <LOOP_CHUNK_SIZE> bytes. A chunk shorter than a page counts
+ *  X down from its length to 1, so the indexed addresses are one byte behind the chunk. X cannot hold 256,
+ *  so a full page counts X up from 0 until it wraps around to 0, and the addresses are not adjusted.
+ *
+ * Members:
+ *  <uint8_t> initial: The value loaded into X before the loop
+ *  <uint16_t> offset: Bytes to subtract from the base addresses of the indexed instructions
+ *  <Rp2a03Mnemonic> step: DEX or INX
+ */
+typedef struct Rp2a03LoopCounter {
+    uint8_t initial;
+    uint16_t offset;
+    Rp2a03Mnemonic step;
+} Rp2a03LoopCounter;
+
+static inline Rp2a03LoopCounter loop_counter(size_t chunk_size)
+{
+    if (chunk_size == LOOP_CHUNK_SIZE)
+        return (Rp2a03LoopCounter) { .initial = 0, .offset = 0, .step = NES_OP_INX };
+
+    return (Rp2a03LoopCounter) { .initial = (uint8_t) chunk_size, .offset = 1, .step = NES_OP_DEX };
+}
+
+/*
+ * Function: build_constant_image
+ *  Writes the bytes the *destination* allocation holds once it is initialized with the *source* operand
+ *  into the *image* buffer (the buffer starts at the *base* address). If the source operand is not known
+ *  at compile time, this function returns *false*
+ */
+static inline bool build_constant_image(ZnesAlloc *destination, ZnesOperand *source, uint16_t base, uint8_t *image)
+{
+    uint8_t *slot = image + (destination->address - base);
+
+    switch (source->type)
+    {
+        case ZNES_OPERAND_UINT:
+        {
+            ZnesUintOperand *uint_operand = (ZnesUintOperand*) source;
+            uint16_t value = uint_operand->size == ZNES_UINT_8 ? uint_operand->value.uint8 : uint_operand->value.uint16;
+
+            for (size_t i=0; i < destination->size; i++)
+                slot[i] = i < 2 ? (uint8_t)((value >> (8 * i)) & 0xFF) : 0;
+
+            return true;
+        }
+        case ZNES_OPERAND_BOOL:
+        {
+            for (size_t i=0; i < destination->size; i++)
+                slot[i] = 0;
+
+            slot[0] = ((ZnesBoolOperand*) source)->value ? 0x1 : 0x0;
+
+            return true;
+        }
+        case ZNES_OPERAND_REFERENCE:
+        {
+            ZnesAlloc *ref_variable = ((ZnesReferenceOperand*) source)->operand->variable;
+
+            if (ref_variable == NULL || ref_variable->type == ZNES_ALLOC_TYPE_TEMP || destination->size < 2)
+                return false;
+
+            slot[0] = ref_variable->address & 0xFF;
+            slot[1] = (ref_variable->address >> 8) & 0xFF;
+
+            return true;
+        }
+        case ZNES_OPERAND_ARRAY:
+        {
+            if (destination->type != ZNES_ALLOC_TYPE_ARRAY)
+                return false;
+
+            ZnesArrayOperand *array_operand = (ZnesArrayOperand*) source;
+            ZnesArrayAlloc *array_alloc = (ZnesArrayAlloc*) destination;
+
+            for (size_t i=0; i < fl_array_length(array_alloc->elements); i++)
+                if (!build_constant_image(array_alloc->elements[i], array_operand->elements[i], base, image))
+                    return false;
+
+            return true;
+        }
+        case ZNES_OPERAND_BLOB:
+        {
+            build_blob_image((ZnesBlobOperand*) source, slot, destination->size);
+
+            return true;
+        }
+        case ZNES_OPERAND_STRUCT:
+        {
+            if (destination->type != ZNES_ALLOC_TYPE_STRUCT)
+                return false;
+
+            ZnesStructOperand *struct_operand = (ZnesStructOperand*) source;
+            ZnesStructAlloc *struct_alloc = (ZnesStructAlloc*) destination;
+
+            for (size_t i=0; i < fl_array_length(struct_operand->members); i++)
+                if (!build_constant_image(struct_alloc->members[i], struct_operand->members[i]->operand, base, image))
+                    return false;
+
+            return true;
+        }
+
+        // Variables are not constant, their value is known at runtime
+        default: break;
+    }
+
+    return false;
+}
+
+/*
+ * Function: is_run
+ *  Returns *true* if all the bytes of the chunk have the same value
+ */
+static inline bool is_run(const uint8_t *chunk, size_t size)
+{
+    for (size_t i=1; i < size; i++)
+        if (chunk[i] != chunk[0])
+            return false;
+
+    return true;
+}
+
+/*
+ * Function: emit_copy_loops
+ *  Initializes the RAM range that starts at *address* with the *image* bytes, using a fill loop for the
+ *  chunks that are a run of the same value, and a loop that copies from a ROM table for the rest of them.
+ *  If a table does not fit in the DATA segment, the tables reserved for the previous chunks are released
+ *  and the function returns *false*
+ */
+static inline bool emit_copy_loops(Rp2a03Program *program, Rp2a03TextSegment *segment, uint16_t address, const uint8_t *image, size_t size)
+{
+    uint16_t *tables = fl_array_new(sizeof(uint16_t), 0);
+    size_t *table_sizes = fl_array_new(sizeof(size_t), 0);
+    bool success = true;
+
+    for (size_t offset=0; offset < size && success; offset += LOOP_CHUNK_SIZE)
+    {
+        size_t chunk_size = size - offset > LOOP_CHUNK_SIZE ? LOOP_CHUNK_SIZE : size - offset;
+        const uint8_t *chunk = image + offset;
+        Rp2a03LoopCounter counter = loop_counter(chunk_size);
+        uint16_t destination = address + offset - counter.offset;
+
+        if (is_run(chunk, chunk_size))
+        {
+            rp2a03_program_emit_imm(program, segment, NES_OP_LDA, chunk[0]);
+            rp2a03_program_emit_imm(program, segment, NES_OP_LDX, counter.initial);
+            rp2a03_program_emit_abx(program, segment, NES_OP_STA, destination);
+            rp2a03_program_emit_imp(program, segment, counter.step);
+            // The branch goes back to the STA instruction (-6 bytes from the next instruction)
+            rp2a03_program_emit_rel(program, segment, NES_OP_BNE, (uint8_t) -6);
+            continue;
+        }
+
+        uint16_t table_address = 0;
+        if (!rp2a03_data_segment_reserve(program->data, chunk, chunk_size, &table_address))
+        {
+            success = false;
+            break;
+        }
+
+        tables = fl_array_append(tables, &table_address);
+        table_sizes = fl_array_append(table_sizes, &chunk_size);
+
+        rp2a03_program_emit_imm(program, segment, NES_OP_LDX, counter.initial);
+        rp2a03_program_emit_abx(program, segment, NES_OP_LDA, table_address - counter.offset);
+        rp2a03_program_emit_abx(program, segment, NES_OP_STA, destination);
+        rp2a03_program_emit_imp(program, segment, counter.step);
+        // The branch goes back to the LDA instruction (-9 bytes from the next instruction)
+        rp2a03_program_emit_rel(program, segment, NES_OP_BNE, (uint8_t) -9);
+    }
+
+    // The caller goes back to the unrolled version, the tables would be dead bytes in the ROM
+    if (!success)
+    {
+        for (size_t i=0; i < fl_array_length(tables); i++)
+            rp2a03_data_segment_release(program->data, tables[i], table_sizes[i]);
+    }
+
+    fl_array_free(tables);
+    fl_array_free(table_sizes);
+
+    return success;
+}
+
+/*
+ * Function: copy_loops_size
+ *  Returns the ROM bytes (code and table) needed to initialize the image using loops
+ */
+static inline size_t copy_loops_size(const uint8_t *image, size_t size)
+{
+    size_t total = 0;
+
+    for (size_t offset=0; offset < size; offset += LOOP_CHUNK_SIZE)
+    {
+        size_t chunk_size = size - offset > LOOP_CHUNK_SIZE ? LOOP_CHUNK_SIZE : size - offset;
+
+        total += is_run(image + offset, chunk_size) ? FILL_LOOP_SIZE : COPY_LOOP_SIZE + chunk_size;
+    }
+
+    return total;
+}
+
+/*
+ * Function: rp2a03_emit_alloc_initializer
+ *  Emits the initialization of a variable. Aggregates placed in RAM (TEXT segment) that are initialized with
+ *  constant values can be initialized either with unrolled LDA/STA sequences or with loops that copy their
+ *  bytes from a table in ROM. This function emits the unrolled version, and if the loop-based one needs
+ *  less ROM space, it rolls the unrolled code back and emits the loops instead.
+ *
+ * Parameters:
+ *  <Rp2a03Program> *program: The program object
+ *  <Rp2a03TextSegment> *segment: The text segment where the initialization is emitted
+ *  <bool> is_startup: *true* if the instruction is emitted in the startup routine
+ *  <ZnesAllocInstruction> *instruction: The allocation instruction
+ *
+ * Returns:
+ *  bool: *true* if the initialization is emitted successfully, otherwise *false*
+ */
+static inline bool rp2a03_emit_alloc_initializer(Rp2a03Program *program, Rp2a03TextSegment *segment, bool is_startup, ZnesAllocInstruction *instruction)
+{
+    ZnesAlloc *destination = instruction->destination;
+
+    bool is_candidate = destination->segment == ZNES_SEGMENT_TEXT
+                        && (instruction->source->type == ZNES_OPERAND_ARRAY || instruction->source->type == ZNES_OPERAND_BLOB || instruction->source->type == ZNES_OPERAND_STRUCT)
+                        && destination->size > 0;
+
+    if (!is_candidate)
+        return rp2a03_emit_alloc_instruction(program, segment, is_startup, instruction);
+
+    // The size of the unrolled version is measured in bytes, so there cannot be pending instructions, and
+    // the rollback needs the state of the registers at the start
+    rp2a03_text_segment_flush(segment);
+    uint16_t start_pc = segment->pc;
+    Rp2a03RegisterState start_registers = segment->registers;
+
+    if (!rp2a03_emit_alloc_instruction(program, segment, is_startup, instruction))
+        return false;
+
+    rp2a03_text_segment_flush(segment);
+
+    uint8_t *image = fl_malloc(destination->size);
+    memset(image, 0, destination->size);
+
+    if (build_constant_image(destination, instruction->source, destination->address, image)
+        && copy_loops_size(image, destination->size) < (size_t) (segment->pc - start_pc))
+    {
+        // Roll back the unrolled initialization and emit the loops
+        segment->pc = start_pc;
+        segment->registers = start_registers;
+
+        if (!emit_copy_loops(program, segment, destination->address, image, destination->size))
+        {
+            // If there is no room for the table in ROM, we go back to the unrolled version
+            segment->pc = start_pc;
+            segment->registers = start_registers;
+
+            if (!rp2a03_emit_alloc_instruction(program, segment, is_startup, instruction))
+            {
+                fl_free(image);
+                return false;
+            }
+        }
+    }
+
+    fl_free(image);
+
+    return true;
+}
+
+#endif /* RP2A03_EMIT_ALLOC_TABLE_H */
@@ -73,11 +73,13 @@ static inline bool emit_alloc_from_uint(Rp2a03Program *program, Rp2a03TextSegmen
                 rp2a03_program_emit_abs(program, segment, NES_OP_STX, instruction->destination->address + i + 2);
         }
     }
-    else if (instruction->destination->segment == ZNES_SEGMENT_DATA)
+    else if (instruction->destination->segment == ZNES_SEGMENT_DATA || instruction->destination->segment == ZNES_SEGMENT_CHR)
     {
-        if (is_startup)
+        // The CHR-ROM is not visible to the CPU, its bytes are always written in the ROM
+        if (is_startup || instruction->destination->segment == ZNES_SEGMENT_CHR)
         {
-            uint8_t *data_seg_slot = program->data->bytes + (instruction->destination->address - program->data->base_address);
+            Rp2a03DataSegment *data = rp2a03_program_alloc_segment(program, instruction->destination);
+            uint8_t *data_seg_slot = data->bytes + (instruction->destination->address - data->base_address);
             *data_seg_slot = source_value & 0xFF;
             
             // If the element size is greater than or equals to 2, we need to store the highest 8 bits of the
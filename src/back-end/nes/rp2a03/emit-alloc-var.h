@@ -8,8 +8,6 @@
 #include "../ir/objects/struct.h"
 #include "../ir/instructions/alloc.h"
 
-static inline bool rp2a03_emit_alloc_instruction(Rp2a03Program *program, Rp2a03TextSegment *segment, bool is_startup, ZnesAllocInstruction *instruction);
-
 static bool emit_alloc_from_zp_var_to_zp_var(Rp2a03Program *program, Rp2a03TextSegment *segment, bool is_startup, ZnesAlloc *source, ZnesAlloc *destination)
 {
     if (source->type != destination->type)
@@ -179,8 +177,10 @@ static bool emit_alloc_from_data_var_to_data_var(Rp2a03Program *program, Rp2a03T
         if (is_startup)
         {
             // NOTE: In static context we can directly copy from one part of the DATA segment to another at compile time
-            uint8_t *source_data_seg_slot = program->data->bytes + source->address - program->data->base_address;
-            uint8_t *dest_data_seg_slot = program->data->bytes + (destination->address - program->data->base_address);
+            Rp2a03DataSegment *source_data = rp2a03_program_data_segment(program, source->bank);
+            Rp2a03DataSegment *dest_data = rp2a03_program_data_segment(program, destination->bank);
+            uint8_t *source_data_seg_slot = source_data->bytes + (source->address - source_data->base_address);
+            uint8_t *dest_data_seg_slot = dest_data->bytes + (destination->address - dest_data->base_address);
 
             size_t to_copy = source->size > destination->size
                                 ? destination->size
@@ -250,7 +250,8 @@ static bool emit_alloc_from_data_var_to_zp_var(Rp2a03Program *program, Rp2a03Tex
             if (is_startup)
             {
                 // NOTE: In startup context we can directly copy the value from the DATA segment
-                rp2a03_program_emit_imm(program, segment, NES_OP_LDA, program->data->bytes[source->address - program->data->base_address + i]);
+                Rp2a03DataSegment *source_data = rp2a03_program_data_segment(program, source->bank);
+                rp2a03_program_emit_imm(program, segment, NES_OP_LDA, source_data->bytes[source->address - source_data->base_address + i]);
             }
             else
             {
@@ -463,13 +464,6 @@ static inline bool emit_alloc_from_variable(Rp2a03Program *program, Rp2a03TextSe
 {
     ZnesAlloc *source_variable = ((ZnesVariableOperand*) instruction->source)->variable;
 
-    // If the source is a temp symbol, we need to "emit" the store in a special way
-    if (source_variable->type == ZNES_ALLOC_TYPE_TEMP)
-    {
-        ZnesAllocInstruction temp_alloc = znes_alloc_instruction_new_local(instruction->destination, ((ZnesTempAlloc*) source_variable)->source);
-        return rp2a03_emit_alloc_instruction(program, segment, is_startup, &temp_alloc);
-    }
-
     if (instruction->destination->segment == ZNES_SEGMENT_ZP)
     {
         if (source_variable->segment == ZNES_SEGMENT_ZP)
@@ -5,6 +5,7 @@
 #include "../ir/program.h"
 
 #include "emit-alloc-array.h"
+#include "emit-alloc-blob.h"
 #include "emit-alloc-bool.h"
 #include "emit-alloc-ref.h"
 #include "emit-alloc-struct.h"
@@ -13,17 +14,16 @@
 
 static inline bool rp2a03_emit_alloc_instruction(Rp2a03Program *program, Rp2a03TextSegment *segment, bool is_startup, ZnesAllocInstruction *instruction)
 {
-    // TODO: Temp
+    // The temporal symbols do not have memory, the ZIR pass forwards them into their uses (see <zir_forward_temporaries>)
     if (instruction->destination->type == ZNES_ALLOC_TYPE_TEMP)
-    {
-        ((ZnesTempAlloc*) instruction->destination)->source = instruction->source;
-        return true;
-    }
+        return false;
 
-    if (instruction->destination->segment == ZNES_SEGMENT_DATA)
+    if (instruction->destination->segment == ZNES_SEGMENT_DATA || instruction->destination->segment == ZNES_SEGMENT_CHR)
     {
+        Rp2a03DataSegment *data = rp2a03_program_alloc_segment(program, instruction->destination);
+
         for (size_t i=0; i < instruction->destination->size; i++)
-            program->data->slots[instruction->destination->address - program->data->base_address + i] = 1;
+            data->slots[instruction->destination->address - data->base_address + i] = 1;
     }
 
     if (instruction->source->type == ZNES_OPERAND_UINT)
@@ -35,6 +35,9 @@ static inline bool rp2a03_emit_alloc_instruction(Rp2a03Program *program, Rp2a03T
     if (instruction->source->type == ZNES_OPERAND_ARRAY)
         return emit_alloc_from_array(program, segment, is_startup, instruction);
     
+    if (instruction->source->type == ZNES_OPERAND_BLOB)
+        return emit_alloc_from_blob(program, segment, is_startup, instruction);
+    
     if (instruction->source->type == ZNES_OPERAND_STRUCT)
         return emit_alloc_from_struct(program, segment, is_startup, instruction);
     
@@ -0,0 +1,224 @@
+#ifndef RP2A03_EMIT_BSS_H
+#define RP2A03_EMIT_BSS_H
+
+#include <stdlib.h>
+#include "program.h"
+#include "emit-alloc-table.h"
+#include "../ir/program.h"
+#include "../ir/instructions/alloc.h"
+
+/*
+ * Struct: Rp2a03BssRange
+ *  A range of RAM (ZP or TEXT) that needs to be cleared on startup
+ *
+ * Members:
+ *  <uint16_t> address: First address of the range
+ *  <size_t> size: Number of bytes of the range
+ */
+typedef struct Rp2a03BssRange {
+    uint16_t address;
+    size_t size;
+} Rp2a03BssRange;
+
+/*
+ * Constant: BSS_CLEAR_LOOP_SIZE
+ *  Bytes used by the loop that clears a BSS range (A is already 0):
+ *      LDX #len; STA addr-1,X; DEX; BNE loop
+ *  or, for a full page:
+ *      LDX #0; STA addr,X; INX; BNE loop
+ *  Zero page ranges use STA zp,X that is 1 byte shorter
+ */
+#define BSS_CLEAR_LOOP_SIZE 8
+
+static int bss_range_compare(const void *a, const void *b)
+{
+    const Rp2a03BssRange *ra = (const Rp2a03BssRange*) a;
+    const Rp2a03BssRange *rb = (const Rp2a03BssRange*) b;
+
+    return (int) ra->address - (int) rb->address;
+}
+
+/*
+ * Function: is_bss_candidate
+ *  An allocation is part of the BSS if it lives in RAM and its initial value is all zeros
+ */
+static inline bool is_bss_candidate(ZnesAllocInstruction *instruction)
+{
+    ZnesAlloc *destination = instruction->destination;
+
+    if (destination->segment != ZNES_SEGMENT_ZP && destination->segment != ZNES_SEGMENT_TEXT)
+        return false;
+
+    if (destination->size == 0)
+        return false;
+
+    uint8_t *image = fl_malloc(destination->size);
+    memset(image, 0, destination->size);
+
+    bool is_zero = build_constant_image(destination, instruction->source, destination->address, image);
+
+    for (size_t i=0; i < destination->size && is_zero; i++)
+        is_zero = image[i] == 0;
+
+    fl_free(image);
+
+    return is_zero;
+}
+
+static inline bool bss_overlaps(Rp2a03BssRange *range, ZnesAlloc *alloc)
+{
+    return range->address < alloc->address + alloc->size && alloc->address < range->address + range->size;
+}
+
+/*
+ * Function: emit_bss_range
+ *  Clears the range of RAM using a loop over chunks of up to 256 bytes, or using one store per byte
+ *  when it is cheaper than the loop. The A register must be 0.
+ */
+static inline void emit_bss_range(Rp2a03Program *program, Rp2a03TextSegment *segment, Rp2a03BssRange *range)
+{
+    for (size_t offset=0; offset < range->size; offset += LOOP_CHUNK_SIZE)
+    {
+        size_t chunk_size = range->size - offset > LOOP_CHUNK_SIZE ? LOOP_CHUNK_SIZE : range->size - offset;
+        size_t address = range->address + offset;
+        bool zero_page = address + chunk_size <= 0x100;
+
+        // Each store takes 2 bytes (ZP) or 3 bytes (absolute)
+        size_t unrolled_size = chunk_size * (zero_page ? 2 : 3);
+        size_t loop_size = BSS_CLEAR_LOOP_SIZE - (zero_page ? 1 : 0);
+
+        if (unrolled_size <= loop_size)
+        {
+            for (size_t i=0; i < chunk_size; i++)
+            {
+                if (zero_page)
+                    rp2a03_program_emit_zpg(program, segment, NES_OP_STA, (uint8_t) (address + i));
+                else
+                    rp2a03_program_emit_abs(program, segment, NES_OP_STA, (uint16_t) (address + i));
+            }
+
+            continue;
+        }
+
+        Rp2a03LoopCounter counter = loop_counter(chunk_size);
+        rp2a03_program_emit_imm(program, segment, NES_OP_LDX, counter.initial);
+
+        if (zero_page)
+        {
+            // Zero page indexed addressing wraps around within the zero page, $FF,X with X=1 is $00
+            rp2a03_program_emit_zpx(program, segment, NES_OP_STA, (uint8_t) ((address - counter.offset) & 0xFF));
+            rp2a03_program_emit_imp(program, segment, counter.step);
+            rp2a03_program_emit_rel(program, segment, NES_OP_BNE, (uint8_t) -5);
+        }
+        else
+        {
+            rp2a03_program_emit_abx(program, segment, NES_OP_STA, (uint16_t) (address - counter.offset));
+            rp2a03_program_emit_imp(program, segment, counter.step);
+            rp2a03_program_emit_rel(program, segment, NES_OP_BNE, (uint8_t) -6);
+        }
+    }
+}
+
+/*
+ * Function: rp2a03_emit_bss
+ *  Collects the zero-initialized RAM allocations that are placed at the beginning of the startup routine (before
+ *  any conditional code), coalesces the adjacent ones, and clears them all at once. If the reset routine already
+ *  clears the RAM, the allocations are just dropped.
+ *
+ * Parameters:
+ *  <Rp2a03Program> *program: The program object
+ *  <Rp2a03TextSegment> *segment: The startup segment
+ *  <ZnesTextSegment> *ir_segment: The IR's startup segment
+ *  <bool> ram_cleared: *true* if the RAM is already cleared on reset
+ *
+ * Returns:
+ *  ZnesAllocInstruction**: An array with the allocation instructions that are handled by the BSS clearing code, in
+ *                          the order they appear in the IR segment. The caller must not emit these instructions
+ *                          and it must free the array with <fl_array_free>
+ */
+static inline ZnesAllocInstruction** rp2a03_emit_bss(Rp2a03Program *program, Rp2a03TextSegment *segment, ZnesTextSegment *ir_segment, bool ram_cleared)
+{
+    ZnesAllocInstruction **bss_instructions = fl_array_new(sizeof(ZnesAllocInstruction*), 0);
+    ZnesAllocInstruction **other_instructions = fl_array_new(sizeof(ZnesAllocInstruction*), 0);
+
+    ZnesInstructionListNode *node = znes_instruction_list_head(ir_segment->instructions);
+    while (node)
+    {
+        ZnesInstruction *instruction = (ZnesInstruction*) node->value;
+
+        // Conditional code might not run, we can only move the allocations that run unconditionally
+        if (instruction->kind != ZNES_INSTRUCTION_ALLOC)
+            break;
+
+        ZnesAllocInstruction *alloc_instruction = (ZnesAllocInstruction*) instruction;
+
+        if (alloc_instruction->destination->type != ZNES_ALLOC_TYPE_TEMP)
+        {
+            if (is_bss_candidate(alloc_instruction))
+                bss_instructions = fl_array_append(bss_instructions, &alloc_instruction);
+            else
+                other_instructions = fl_array_append(other_instructions, &alloc_instruction);
+        }
+
+        node = node->next;
+    }
+
+    // Allocations that share memory with other allocations keep their place in the startup routine, the order
+    // of the stores matters in that case
+    size_t count = 0;
+    for (size_t i=0; i < fl_array_length(bss_instructions); i++)
+    {
+        Rp2a03BssRange range = { .address = bss_instructions[i]->destination->address, .size = bss_instructions[i]->destination->size };
+
+        bool overlaps = false;
+        for (size_t j=0; j < fl_array_length(other_instructions) && !overlaps; j++)
+            overlaps = bss_overlaps(&range, other_instructions[j]->destination);
+
+        for (size_t j=0; j < fl_array_length(bss_instructions) && !overlaps; j++)
+            overlaps = j != i && bss_overlaps(&range, bss_instructions[j]->destination);
+
+        if (!overlaps)
+            bss_instructions[count++] = bss_instructions[i];
+    }
+
+    fl_array_free(other_instructions);
+
+    ZnesAllocInstruction **result = fl_array_new(sizeof(ZnesAllocInstruction*), count);
+    if (count > 0)
+        memcpy(result, bss_instructions, sizeof(ZnesAllocInstruction*) * count);
+    fl_array_free(bss_instructions);
+
+    // Without candidates there is nothing to do, and if the RAM is cleared on reset, there is no need to
+    // emit code for them
+    if (count == 0 || ram_cleared)
+        return result;
+
+    // Sort and coalesce the ranges
+    Rp2a03BssRange *ranges = fl_malloc(sizeof(Rp2a03BssRange) * count);
+    for (size_t i=0; i < count; i++)
+        ranges[i] = (Rp2a03BssRange) { .address = result[i]->destination->address, .size = result[i]->destination->size };
+
+    qsort(ranges, count, sizeof(Rp2a03BssRange), bss_range_compare);
+
+    size_t range_count = 1;
+    for (size_t i=1; i < count; i++)
+    {
+        Rp2a03BssRange *last = &ranges[range_count - 1];
+
+        if (ranges[i].address == last->address + last->size)
+            last->size += ranges[i].size;
+        else
+            ranges[range_count++] = ranges[i];
+    }
+
+    rp2a03_program_emit_imm(program, segment, NES_OP_LDA, 0x00);
+
+    for (size_t i=0; i < range_count; i++)
+        emit_bss_range(program, segment, &ranges[i]);
+
+    fl_free(ranges);
+
+    return result;
+}
+
+#endif /* RP2A03_EMIT_BSS_H */
@@ -2,28 +2,16 @@
 #define RP2A03_EMIT_IF_FALSE_H
 
 #include "program.h"
+#include "mapper.h"
 #include "../ir/program.h"
 #include "../ir/instructions/if-false.h"
 
 static inline bool rp2a03_emit_if_false_instruction(Rp2a03Program *program, Rp2a03TextSegment *segment, bool is_startup, ZnesIfFalseInstruction *instruction)
 {
-    ZnesOperand *source_operand = NULL;
+    ZnesOperand *source_operand = instruction->source;
 
-    if (instruction->source->type == ZNES_OPERAND_BOOL)
-    {
-        source_operand = instruction->source;
-    }
-    else if (instruction->source->type == ZNES_OPERAND_VARIABLE)
-    {
-        if (((ZnesVariableOperand*) instruction->source)->variable->type == ZNES_ALLOC_TYPE_TEMP)
-            source_operand = ((ZnesTempAlloc*)((ZnesVariableOperand*) instruction->source)->variable)->source;
-        else
-            source_operand = instruction->source;
-    }
-    else
-    {
+    if (source_operand->type != ZNES_OPERAND_BOOL && source_operand->type != ZNES_OPERAND_VARIABLE)
         return false;
-    }
 
     if (source_operand->type == ZNES_OPERAND_BOOL)
     {
@@ -63,7 +51,19 @@ static inline bool rp2a03_emit_if_false_instruction(Rp2a03Program *program, Rp2a
 
         ZnesAlloc *source_allocation = variable_operand->variable;
 
-        if (variable_operand->variable->segment == ZNES_SEGMENT_DATA || variable_operand->variable->segment == ZNES_SEGMENT_TEXT)
+        if (variable_operand->variable->segment == ZNES_SEGMENT_DATA && source_allocation->bank != 0)
+        {
+            // The condition lives in a switchable bank: the result is kept in X while the default bank is
+            // mapped again, so that both paths of the branch run with the default bank
+            rp2a03_mapper_emit_switch(program, segment, source_allocation->bank);
+            rp2a03_program_emit_abs(program, segment, NES_OP_LDA, (source_allocation->address));
+            for (size_t i=1; i < source_allocation->size; i++)
+                rp2a03_program_emit_abs(program, segment, NES_OP_ORA, (source_allocation->address + i));
+            rp2a03_program_emit_imp(program, segment, NES_OP_TAX);
+            rp2a03_mapper_emit_switch(program, segment, 0);
+            rp2a03_program_emit_imp(program, segment, NES_OP_TXA);
+        }
+        else if (variable_operand->variable->segment == ZNES_SEGMENT_DATA || variable_operand->variable->segment == ZNES_SEGMENT_TEXT)
         {
             rp2a03_program_emit_abs(program, segment, NES_OP_LDA, (source_allocation->address));
             for (size_t i=1; i < source_allocation->size; i++)
@@ -75,9 +75,10 @@ static inline bool rp2a03_emit_if_false_instruction(Rp2a03Program *program, Rp2a
             for (size_t i=1; i < source_allocation->size; i++)
                 rp2a03_program_emit_zpg(program, segment, NES_OP_ORA, (uint8_t) (source_allocation->address + i));
         }
-        else if (variable_operand->variable->segment == ZNES_SEGMENT_TEMP)
+        else
         {
-
+            // The temporal symbols do not have memory (see <zir_forward_temporaries>)
+            return false;
         }
 
         // If bool_value is 0, the Z flag is equals to 1 which means the expression is "false"
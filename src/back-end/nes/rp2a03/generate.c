@@ -1,14 +1,123 @@
+#include <fllib/Cstring.h>
 #include "generate.h"
 #include "emit-alloc.h"
+#include "emit-alloc-table.h"
+#include "emit-bss.h"
 #include "emit-if-false.h"
 #include "emit-jump.h"
+#include "link.h"
+#include "mapper.h"
+
+/*
+ * Function: merge_bank
+ *  Keeps the switchable bank an operand reads from, and flags a conflict if it reads from two of them
+ */
+static uint8_t merge_bank(uint8_t bank, uint8_t other, bool *conflict)
+{
+    if (other == 0)
+        return bank;
+
+    if (bank != 0 && bank != other)
+        *conflict = true;
+
+    return other;
+}
+
+/*
+ * Function: operand_bank
+ *  Returns the switchable bank the operand reads from, following the temporal symbols and the elements of
+ *  the aggregates, or 0 if it does not read from one. The references only need the address of the variable,
+ *  they do not read from the bank.
+ */
+static uint8_t operand_bank(ZnesOperand *operand, bool *conflict)
+{
+    uint8_t bank = 0;
+
+    if (operand == NULL)
+        return bank;
+
+    if (operand->type == ZNES_OPERAND_VARIABLE)
+    {
+        ZnesAlloc *variable = ((ZnesVariableOperand*) operand)->variable;
+
+        return variable->segment == ZNES_SEGMENT_DATA ? variable->bank : 0;
+    }
+
+    if (operand->type == ZNES_OPERAND_ARRAY)
+    {
+        ZnesArrayOperand *array = (ZnesArrayOperand*) operand;
+
+        for (size_t i=0; i < fl_array_length(array->elements); i++)
+            bank = merge_bank(bank, operand_bank(array->elements[i], conflict), conflict);
+    }
+    else if (operand->type == ZNES_OPERAND_STRUCT)
+    {
+        ZnesStructOperand *struct_operand = (ZnesStructOperand*) operand;
+
+        for (size_t i=0; i < fl_array_length(struct_operand->members); i++)
+            bank = merge_bank(bank, operand_bank(struct_operand->members[i]->operand, conflict), conflict);
+    }
+
+    return bank;
+}
+
+/*
+ * Function: emit_banked_alloc
+ *  Emits an allocation instruction. With a mapper, if the source reads from a switchable bank, the bank is mapped
+ *  before the instruction, and the default bank is mapped again after it. The writes to the PRG-ROM are writes to
+ *  the mapper registers, so the default bank is selected again after them too. If the instruction does not emit
+ *  code (the value is copied at compile time), the bank switches are rolled back.
+ */
+static bool emit_banked_alloc(Rp2a03Program *program, Rp2a03TextSegment *segment, bool is_startup, ZnesAllocInstruction *instruction)
+{
+    if (program->mapper == ZNES_MAPPER_NROM || instruction->destination->type == ZNES_ALLOC_TYPE_TEMP)
+        return rp2a03_emit_alloc_initializer(program, segment, is_startup, instruction);
+
+    bool conflict = false;
+    uint8_t bank = operand_bank(instruction->source, &conflict);
+
+    // Only one bank can be mapped at $8000
+    if (conflict)
+        return false;
+
+    if (bank == 0 && instruction->destination->segment != ZNES_SEGMENT_DATA)
+        return rp2a03_emit_alloc_initializer(program, segment, is_startup, instruction);
+
+    rp2a03_text_segment_flush(segment);
+    uint16_t start_pc = segment->pc;
+    Rp2a03RegisterState start_registers = segment->registers;
+
+    if (bank != 0)
+    {
+        rp2a03_mapper_emit_switch(program, segment, bank);
+        rp2a03_text_segment_flush(segment);
+    }
+
+    uint16_t code_pc = segment->pc;
+
+    if (!rp2a03_emit_alloc_initializer(program, segment, is_startup, instruction))
+        return false;
+
+    rp2a03_text_segment_flush(segment);
+
+    if (segment->pc == code_pc)
+    {
+        segment->pc = start_pc;
+        segment->registers = start_registers;
+        return true;
+    }
+
+    rp2a03_mapper_emit_switch(program, segment, 0);
+
+    return true;
+}
 
 static bool emit_instruction(Rp2a03Program *program, Rp2a03TextSegment *segment, bool is_startup, ZnesInstruction *instruction)
 {
     switch (instruction->kind)
     {
         case ZNES_INSTRUCTION_ALLOC:
-            return rp2a03_emit_alloc_instruction(program, segment, is_startup, (ZnesAllocInstruction*) instruction);
+            return emit_banked_alloc(program, segment, is_startup, (ZnesAllocInstruction*) instruction);
 
         case ZNES_INSTRUCTION_IF_FALSE:
             return rp2a03_emit_if_false_instruction(program, segment, is_startup, (ZnesIfFalseInstruction*) instruction);
@@ -22,110 +131,146 @@ static bool emit_instruction(Rp2a03Program *program, Rp2a03TextSegment *segment,
     return false;
 }
 
-static void emit_segment_instructions(Rp2a03Program *rp2a03_program, Rp2a03TextSegment *rp2a03_segment, ZnesProgram *ir_prog, ZnesTextSegment *ir_segment)
+/*
+ * Function: segment_name
+ *  Returns the name of the text segment used in the error messages
+ */
+static const char* segment_name(Rp2a03Program *program, Rp2a03TextSegment *segment)
+{
+    return segment == program->startup ? "startup routine" : "CODE segment";
+}
+
+static bool emit_segment_instructions(Rp2a03Program *rp2a03_program, Rp2a03TextSegment *rp2a03_segment, ZnesProgram *ir_prog, ZnesTextSegment *ir_segment, ZnesAllocInstruction **skip, char **message)
 {
     ZnesInstructionListNode *inst_node = znes_instruction_list_head(ir_segment->instructions);
 
+    // The instructions to skip are sorted in the same order they appear in the segment
+    size_t skip_index = 0;
+    size_t skip_count = skip != NULL ? fl_array_length(skip) : 0;
+
     while (inst_node)
     {
         ZnesInstruction *instr = (ZnesInstruction*) inst_node->value;
-        
-        if (!emit_instruction(rp2a03_program, rp2a03_segment, ir_prog->startup_context, instr))
+
+        if (skip_index < skip_count && (ZnesInstruction*) skip[skip_index] == instr)
         {
-            // TODO: Error handling
-            break;
+            skip_index++;
+        }
+        else
+        {
+            // The bytes of the instruction are attributed to the declaration it comes from
+            rp2a03_segment->origin = rp2a03_program_add_origin(rp2a03_program, instr->origin.declaration, instr->origin.filename, instr->origin.line, instr->origin.col);
+
+            if (!emit_instruction(rp2a03_program, rp2a03_segment, ir_prog->startup_context, instr))
+            {
+                if (message != NULL && instr->origin.declaration != NULL)
+                    *message = fl_cstring_vdup("%s:%u:%u: Cannot generate the code of '%s'",
+                                                instr->origin.filename != NULL ? instr->origin.filename : "<source>",
+                                                instr->origin.line, instr->origin.col, instr->origin.declaration);
+                else if (message != NULL)
+                    *message = fl_cstring_vdup("Cannot generate the code of an instruction of the %s", segment_name(rp2a03_program, rp2a03_segment));
+
+                return false;
+            }
         }
 
         rp2a03_text_segment_backpatch_jumps(rp2a03_segment);
 
         inst_node = inst_node->next;
     }
+
+    // The segment ends with a jump to the next one (see <rp2a03_link_place>)
+    rp2a03_text_segment_label(rp2a03_segment);
+    rp2a03_segment->origin = 0;
+    rp2a03_peephole_optimize(rp2a03_segment, ir_prog->peephole_rules, &rp2a03_program->peephole);
+
+    if (!rp2a03_text_segment_relax_branches(rp2a03_segment))
+    {
+        if (message != NULL)
+            *message = fl_cstring_vdup("The %s is too big, there is no room for the jumps of its long branches", segment_name(rp2a03_program, rp2a03_segment));
+
+        return false;
+    }
+
+    return true;
 }
 
-Rp2a03Program* rp2a03_generate_program(ZnesProgram *ir_prog)
+/*
+ * Function: rp2a03_generate_program
+ *  Emits the code of the IR program and places its text segments in the PRG-ROM
+ *
+ * Parameters:
+ *  <ZnesProgram> *ir_prog: The NES IR program
+ *  <char> **message: If not NULL, receives the reason why the program could not be generated
+ *
+ * Returns:
+ *  Rp2a03Program*: The program object, or NULL on error. The message must be freed with <fl_cstring_free>
+ */
+Rp2a03Program* rp2a03_generate_program(ZnesProgram *ir_prog, char **message)
 {
     Rp2a03Program *program = rp2a03_program_new(ir_prog->data->base_address, ir_prog->startup->base_address, ir_prog->code->base_address);
+    program->mapper = ir_prog->mapper;
 
-    // DATA segment is allocated using the startup routine:
-    //  a) if a symbol within the DATA segment is initialized with a constant value, the value is copied on compilation
-    //  b) if the value is not constant (reading from ZP, or CODE) the startup routine emits an instruction to initialize it
-    ir_prog->startup_context = true;
-    emit_segment_instructions(program, program->startup, ir_prog, ir_prog->startup);
-    ir_prog->startup_context = false;
-    emit_segment_instructions(program, program->code, ir_prog, ir_prog->code);
-
-    // 0x00 is used as an special sentinel. Address $00 is ZP, it never can be a valid base address, we need to 
-    // find the place for the startup routine
-    if (program->startup->base_address == 0x0)
+    // We flag the DATA segment slots used by the variables before emitting the instructions, because the emitters
+    // can place tables within the DATA segment (see <rp2a03_emit_alloc_initializer>)
+    for (size_t bank=0; bank < ZNES_BANK_COUNT; bank++)
     {
-        // PC points to the last byte + 1, but also let space for the JMP instruction to jump to
-        // the user defined reset interrupt handler (the startup routine will be the ACTUAL reset handler)
-        size_t needed_space = program->startup->pc + 3;
-
-        // We start looking from the DATA segment address
-        size_t i = 0, j = 0;
-        for (; i < fl_array_length(program->data->slots); i++)
-        {
-            if (program->data->slots[i] != 0)
-            {
-                j = i + 1;
-                continue;
-            }
+        ZnesDataSegment *ir_data = bank == 0 ? ir_prog->data : ir_prog->banks[bank];
 
-            if (i - j >= needed_space)
-                break;
-        }
+        if (ir_data == NULL)
+            continue;
 
-        if (i - j < needed_space)
+        Rp2a03DataSegment *data = rp2a03_program_data_segment(program, (uint8_t) bank);
+        struct FlListNode *data_node = fl_list_head(ir_data->allocations);
+        while (data_node)
         {
-            // TODO: Error handling
-            rp2a03_program_free(program);
-            return NULL;
-        }        
+            ZnesAlloc *data_alloc = ((ZnesAllocInstruction*) data_node->value)->destination;
 
-        program->startup->base_address = program->data->base_address + j;
+            for (size_t i=0; i < data_alloc->size; i++)
+                data->slots[data_alloc->address - data->base_address + i] = 1;
 
-        // Flag the DATA segment as used on the startup range
-        /*for (; j < i; j++)
-            program->data->slots[j] = 1;*/
-
-        rp2a03_text_segment_backpatch_absolute_jumps(program->startup);
+            data_node = data_node->next;
+        }
     }
 
-    // 0x00 is used as an special sentinel. Address $00 is ZP, it never can be a valid base address, we need to 
-    // find the place for the CODE segment
-    if (program->code->base_address == 0x0)
+    // With a mapper, the bank switching routines live in the fixed bank, and the startup routine sets up
+    // the mapper before anything else
+    if (!rp2a03_mapper_add_trampolines(program))
     {
-        // We start looking from the DATA segment address
-        size_t needed_space = program->code->pc; // PC points to the last byte + 1
+        if (message != NULL)
+            *message = fl_cstring_dup("There is no room for the bank switching routines in the fixed bank");
 
-        size_t i = 0, j = 0;
-        for (; i < fl_array_length(program->data->slots); i++)
-        {
-            if (program->data->slots[i] != 0)
-            {
-                j = i + 1;
-                continue;
-            }
+        rp2a03_program_free(program);
+        return NULL;
+    }
 
-            if (i - j >= needed_space)
-                break;
-        }
+    rp2a03_mapper_emit_init(program, program->startup);
 
-        if (i - j < needed_space)
-        {
-            // TODO: Error handling
-            rp2a03_program_free(program);
-            return NULL;
-        }
+    // DATA segment is allocated using the startup routine:
+    //  a) if a symbol within the DATA segment is initialized with a constant value, the value is copied on compilation
+    //  b) if the value is not constant (reading from ZP, or CODE) the startup routine emits an instruction to initialize it
+    //  c) zero-initialized variables in RAM (ZP and TEXT) are cleared at once at the beginning of the startup routine
+    ir_prog->startup_context = true;
+    ZnesAllocInstruction **bss_instructions = rp2a03_emit_bss(program, program->startup, ir_prog->startup, ir_prog->reset_clears_ram);
+    bool success = emit_segment_instructions(program, program->startup, ir_prog, ir_prog->startup, bss_instructions, message);
+    fl_array_free(bss_instructions);
 
-        program->code->base_address = program->data->base_address + j;
+    ir_prog->startup_context = false;
 
-        // Flag the DATA segment as used on the startup range
-        /*for (; j < i; j++)
-            program->data->slots[j] = 1;*/
+    if (!success || !emit_segment_instructions(program, program->code, ir_prog, ir_prog->code, NULL, message))
+    {
+        rp2a03_program_free(program);
+        return NULL;
+    }
 
-        rp2a03_text_segment_backpatch_absolute_jumps(program->code);
+    // The DATA segment is complete at this point (the emitters might have placed tables in it), so we build
+    // the map of the free PRG-ROM ranges and place the text segments
+    program->prg = rp2a03_prg_map_new_from(program->data, rp2a03_mapper_code_address(program));
+
+    if (!rp2a03_link_place(program, message))
+    {
+        rp2a03_program_free(program);
+        return NULL;
     }
 
     return program;
@@ -4,6 +4,6 @@
 #include "program.h"
 #include "../ir/program.h"
 
-Rp2a03Program* rp2a03_generate_program(ZnesProgram *ir_prog);
+Rp2a03Program* rp2a03_generate_program(ZnesProgram *ir_prog, char **message);
 
 #endif /* RP2A03_GENERATE_H */
@@ -8,24 +8,26 @@ typedef struct Rp2a03RomHeader {
     uint8_t prg_rom; // Size of PRG-ROM in 16KB units
     uint8_t chr_rom; // Size of CHR-ROM in 8KB units (0 means the board uses CHR-RAM)
 
+    // The bit-fields are declared from the least significant bit (bit 0) to the most significant one
     union {
         uint8_t raw;
         struct {
-            uint8_t mapper_low  : 4;    // Lower nybble of mapper number
-            uint8_t vram_4s     : 1;    // 1: Ignore mirroring control or above mirroring bit; instead provide four-screen VRAM
-            uint8_t trainer     : 1;    // 1: 512-byte trainer at $7000-$71FF (stored before PRG data)
-            uint8_t battery     : 1;    // 1: Cartridge contains battery-backed PRG RAM ($6000-7FFF) or other persistent memory
             uint8_t mirroring   : 1;    // Mirroring: 0: horizontal (vertical arrangement) (CIRAM A10 = PPU A11)
-        } flags;                        //            1: vertical (horizontal arrangement) (CIRAM A10 = PPU A10)
+                                        //            1: vertical (horizontal arrangement) (CIRAM A10 = PPU A10)
+            uint8_t battery     : 1;    // 1: Cartridge contains battery-backed PRG RAM ($6000-7FFF) or other persistent memory
+            uint8_t trainer     : 1;    // 1: 512-byte trainer at $7000-$71FF (stored before PRG data)
+            uint8_t vram_4s     : 1;    // 1: Ignore mirroring control or above mirroring bit; instead provide four-screen VRAM
+            uint8_t mapper_low  : 4;    // Lower nybble of mapper number
+        } flags;
     } flag6;
 
     union {
         uint8_t raw;
         struct {
-            uint8_t mapper_hi   : 4;    // Upper nybble of mapper number
-            uint8_t nes2        : 2;    // If equal to 2, flags 8-15 are in NES 2.0 format
-            uint8_t playchoice  : 1;    // PlayChoice-10 (8KB of Hint Screen data stored after CHR data)
             uint8_t vsu         : 1;    // VS Unisystem
+            uint8_t playchoice  : 1;    // PlayChoice-10 (8KB of Hint Screen data stored after CHR data)
+            uint8_t nes2        : 2;    // If equal to 2, flags 8-15 are in NES 2.0 format
+            uint8_t mapper_hi   : 4;    // Upper nybble of mapper number
         } flags;
     } flag7;
 
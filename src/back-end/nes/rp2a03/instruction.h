@@ -8,9 +8,10 @@ typedef struct Rp2a03Instruction {
     Rp2a03Mnemonic mnemonic;
     Rp2a03AddressMode mode;
     uint8_t size;
+    uint8_t cycles;
     const char *format;
 } Rp2a03Instruction;
 
-Rp2a03Instruction* rp2a03_instruction_lookup(uint8_t opcode);
+const Rp2a03Instruction* rp2a03_instruction_lookup(uint8_t opcode);
 
 #endif /* ZNES_INSTR_H */
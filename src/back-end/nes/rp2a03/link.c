@@ -0,0 +1,260 @@
+#include <fllib/Mem.h>
+#include <fllib/Array.h>
+#include <fllib/Cstring.h>
+#include "link.h"
+#include "mnemonic.h"
+#include "mapper.h"
+
+/*
+ * Function: collect_segments
+ *  Returns an array with all the text segments of the program: the startup routine, the CODE
+ *  segment, and the additional text blobs. The array must be freed with <fl_array_free>
+ */
+static Rp2a03TextSegment** collect_segments(Rp2a03Program *program)
+{
+    Rp2a03TextSegment **segments = fl_array_new(sizeof(Rp2a03TextSegment*), 0);
+
+    segments = fl_array_append(segments, &program->startup);
+    segments = fl_array_append(segments, &program->code);
+
+    for (size_t i=0; i < fl_array_length(program->blobs); i++)
+        segments = fl_array_append(segments, &program->blobs[i]);
+
+    return segments;
+}
+
+/*
+ * Function: linked_size
+ *  Returns the ROM bytes the segment needs once it is linked
+ */
+static size_t linked_size(Rp2a03Program *program, Rp2a03TextSegment *segment)
+{
+    if (segment->pc == 0)
+        return 0;
+
+    if (segment == program->startup || segment == program->code)
+        return segment->pc + RP2A03_LINK_JMP_SIZE;
+
+    return segment->pc;
+}
+
+/*
+ * Function: segment_name
+ *  Returns the name of the text segment used in the error messages
+ */
+static const char* segment_name(Rp2a03Program *program, Rp2a03TextSegment *segment)
+{
+    if (segment == program->startup)
+        return "startup routine";
+
+    if (segment == program->code)
+        return "CODE segment";
+
+    return "text blob";
+}
+
+/*
+ * Function: rp2a03_link_place
+ *  First pass of the linker: it computes the final size of every text segment and places the ones that
+ *  do not have a base address yet within the free ranges of the PRG-ROM, from the biggest to the smallest.
+ *  Once a segment has its base address, its absolute jumps are resolved.
+ *
+ * Parameters:
+ *  <Rp2a03Program> *program: The program object
+ *  <char> **message: If not NULL, receives the reason why a segment could not be placed
+ *
+ * Returns:
+ *  bool: *true* if all the segments fit in the PRG-ROM, otherwise *false*. The message must be freed
+ *        with <fl_cstring_free>
+ */
+bool rp2a03_link_place(Rp2a03Program *program, char **message)
+{
+    if (program->prg == NULL)
+        program->prg = rp2a03_prg_map_new_from(program->data, rp2a03_mapper_code_address(program));
+
+    Rp2a03TextSegment **segments = collect_segments(program);
+    size_t count = fl_array_length(segments);
+
+    // The segments must not have instructions waiting to be emitted
+    for (size_t i=0; i < count; i++)
+        rp2a03_text_segment_flush(segments[i]);
+
+    // Sort by size (stable), big segments are harder to place
+    for (size_t i=1; i < count; i++)
+    {
+        Rp2a03TextSegment *segment = segments[i];
+        size_t j = i;
+
+        for (; j > 0 && linked_size(program, segments[j - 1]) < linked_size(program, segment); j--)
+            segments[j] = segments[j - 1];
+
+        segments[j] = segment;
+    }
+
+    bool success = true;
+
+    for (size_t i=0; i < count && success; i++)
+    {
+        Rp2a03TextSegment *segment = segments[i];
+        size_t size = linked_size(program, segment);
+
+        // 0x00 is used as an special sentinel. Address $00 is ZP, it never can be a valid base address
+        if (size == 0 || segment->base_address != 0x0)
+            continue;
+
+        size_t largest = program->prg->largest;
+        success = rp2a03_prg_map_allocate(program->prg, size, &segment->base_address);
+
+        if (success)
+            rp2a03_text_segment_backpatch_absolute_jumps(segment);
+        else if (message != NULL)
+            *message = fl_cstring_vdup("The %s needs %zu bytes, but the largest free range of the PRG-ROM%s has %zu bytes",
+                                        segment_name(program, segment), size,
+                                        program->mapper == ZNES_MAPPER_NROM ? "" : " in the fixed bank", largest);
+    }
+
+    fl_array_free(segments);
+
+    return success;
+}
+
+/*
+ * Function: is_valid_vector
+ *  An interrupt vector is valid if it is not set (0), or if it points to a used byte within the PRG-ROM
+ */
+static bool is_valid_vector(Rp2a03Program *program, Rp2a03TextSegment **segments, uint16_t vector)
+{
+    if (vector == 0)
+        return true;
+
+    if (vector < program->data->base_address || vector >= program->data->base_address + sizeof(((Rp2a03Nrom256*) 0)->bank))
+        return false;
+
+    if (program->data->slots[vector - program->data->base_address] != 0)
+        return true;
+
+    for (size_t i=0; i < fl_array_length(segments); i++)
+    {
+        if (segments[i]->pc > 0 && vector >= segments[i]->base_address && vector < segments[i]->base_address + segments[i]->pc)
+            return true;
+    }
+
+    return false;
+}
+
+/*
+ * Function: rp2a03_link_prg_usage
+ *  Returns an array with one flag per byte of the $8000-$FFFF address space that is 1 if the byte is used
+ *  by the DATA segment, by a placed text segment (including the JMP the linker adds), or by the interrupt
+ *  vectors, that are always written. The array must be freed with <fl_array_free>
+ *
+ * Parameters:
+ *  <Rp2a03Program> *program: The program object, its segments must be placed by <rp2a03_link_place>
+ *
+ * Returns:
+ *  uint8_t*: The usage flags
+ */
+uint8_t* rp2a03_link_prg_usage(Rp2a03Program *program)
+{
+    size_t bank_length = sizeof(((Rp2a03Nrom256*) 0)->bank);
+    uint8_t *used = fl_array_new(sizeof(uint8_t), sizeof(Rp2a03Nrom256));
+
+    memcpy(used, program->data->slots, fl_array_length(program->data->slots) < sizeof(Rp2a03Nrom256) ? fl_array_length(program->data->slots) : sizeof(Rp2a03Nrom256));
+    memset(used + bank_length, 1, sizeof(Rp2a03Nrom256) - bank_length);
+
+    Rp2a03TextSegment **segments = collect_segments(program);
+
+    for (size_t i=0; i < fl_array_length(segments); i++)
+    {
+        size_t size = linked_size(program, segments[i]);
+
+        if (size == 0 || segments[i]->base_address < program->data->base_address)
+            continue;
+
+        size_t offset = (size_t) (segments[i]->base_address - program->data->base_address);
+
+        if (offset < bank_length)
+            memset(used + offset, 1, offset + size > bank_length ? bank_length - offset : size);
+    }
+
+    fl_array_free(segments);
+
+    return used;
+}
+
+static void write_jmp(Rp2a03Program *program, Rp2a03Nrom256 *prg_rom, uint16_t address, uint16_t target)
+{
+    uint8_t *bytes = prg_rom->bank + (address - program->data->base_address);
+
+    bytes[0] = rp2a03_opcode_lookup(NES_OP_JMP, NES_ADDR_ABS);
+    bytes[1] = (uint8_t) (target & 0xFF);
+    bytes[2] = (uint8_t) ((target >> 8) & 0xFF);
+}
+
+/*
+ * Function: rp2a03_link_patch
+ *  Second pass of the linker: it validates the interrupt vectors defined by the program, copies every
+ *  text segment to its place in the PRG-ROM, and chains the reset sequence: the RESET vector points to
+ *  the startup routine, that jumps to the CODE segment, that jumps to the user-defined RESET handler.
+ *  If the program does not define a RESET handler, the last segment loops forever.
+ *
+ * Parameters:
+ *  <Rp2a03Program> *program: The program object, its segments must be placed by <rp2a03_link_place>
+ *  <Rp2a03Nrom256> *prg_rom: The PRG-ROM that already contains the DATA segment
+ *
+ * Returns:
+ *  bool: *true* if the program is linked successfully, otherwise *false*
+ */
+bool rp2a03_link_patch(Rp2a03Program *program, Rp2a03Nrom256 *prg_rom)
+{
+    Rp2a03TextSegment **segments = collect_segments(program);
+    size_t bank_length = sizeof(prg_rom->bank);
+    bool success = is_valid_vector(program, segments, prg_rom->nmi_addr)
+                    && is_valid_vector(program, segments, prg_rom->res_addr)
+                    && is_valid_vector(program, segments, prg_rom->irq_addr);
+
+    for (size_t i=0; i < fl_array_length(segments) && success; i++)
+    {
+        Rp2a03TextSegment *segment = segments[i];
+        size_t size = linked_size(program, segment);
+
+        if (size == 0)
+            continue;
+
+        size_t offset = (size_t) (segment->base_address - program->data->base_address);
+
+        if (segment->base_address < program->data->base_address || offset + size > bank_length)
+        {
+            success = false;
+            break;
+        }
+
+        memcpy(prg_rom->bank + offset, segment->bytes, segment->pc);
+    }
+
+    fl_array_free(segments);
+
+    if (!success)
+        return false;
+
+    // We chain the reset sequence backwards
+    Rp2a03TextSegment *reset_sequence[] = { program->startup, program->code };
+    uint16_t entry_point = prg_rom->res_addr;
+
+    for (size_t i = sizeof(reset_sequence) / sizeof(reset_sequence[0]); i > 0; i--)
+    {
+        Rp2a03TextSegment *segment = reset_sequence[i - 1];
+
+        if (segment->pc == 0)
+            continue;
+
+        uint16_t jmp_address = segment->base_address + segment->pc;
+        write_jmp(program, prg_rom, jmp_address, entry_point != 0 ? entry_point : jmp_address);
+
+        entry_point = segment->base_address;
+    }
+
+    prg_rom->res_addr = entry_point;
+
+    return true;
+}
@@ -0,0 +1,20 @@
+#ifndef RP2A03_LINK_H
+#define RP2A03_LINK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "program.h"
+#include "rom.h"
+
+/*
+ * Constant: RP2A03_LINK_JMP_SIZE
+ *  The startup routine and the CODE segment run one after the other on reset, each of them ends with
+ *  a JMP (3 bytes) that is added by the linker
+ */
+#define RP2A03_LINK_JMP_SIZE 3
+
+bool rp2a03_link_place(Rp2a03Program *program, char **message);
+bool rp2a03_link_patch(Rp2a03Program *program, Rp2a03Nrom256 *prg_rom);
+uint8_t* rp2a03_link_prg_usage(Rp2a03Program *program);
+
+#endif /* RP2A03_LINK_H */
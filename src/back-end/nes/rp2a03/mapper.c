@@ -0,0 +1,203 @@
+#include "mapper.h"
+#include "mnemonic.h"
+
+/*
+ * Constant: MMC1_CONTROL
+ *  Value of the MMC1 control register: horizontal mirroring (the one of the NROM header), $8000 switchable
+ *  and $C000 fixed to the last bank, and 8KB of CHR
+ */
+#define MMC1_CONTROL 0x0F
+
+/*
+ * Constant: TRAMPOLINE_MAX_SIZE
+ *  The MMC1 routines are the biggest ones (48 bytes)
+ */
+#define TRAMPOLINE_MAX_SIZE 64
+
+/*
+ * Function: put
+ *  Assembles an instruction into *bytes* at *offset* and returns the offset of the next instruction
+ */
+static size_t put(uint8_t *bytes, size_t offset, Rp2a03Mnemonic mnemonic, Rp2a03AddressMode mode, uint16_t operand)
+{
+    bytes[offset++] = rp2a03_opcode_lookup(mnemonic, mode);
+
+    if (mode == NES_ADDR_IMM)
+    {
+        bytes[offset++] = (uint8_t) operand;
+    }
+    else if (mode == NES_ADDR_ABS || mode == NES_ADDR_ABY)
+    {
+        bytes[offset++] = (uint8_t) (operand & 0xFF);
+        bytes[offset++] = (uint8_t) ((operand >> 8) & 0xFF);
+    }
+
+    return offset;
+}
+
+/*
+ * Function: put_serial_write
+ *  MMC1 registers are written one bit at a time: five writes of the bit 0 of A, shifting A between them
+ */
+static size_t put_serial_write(uint8_t *bytes, size_t offset, uint16_t address)
+{
+    for (size_t i=0; i < 5; i++)
+    {
+        if (i > 0)
+            offset = put(bytes, offset, NES_OP_LSR, NES_ADDR_IMP, 0);
+
+        offset = put(bytes, offset, NES_OP_STA, NES_ADDR_ABS, address);
+    }
+
+    return offset;
+}
+
+/*
+ * Function: rp2a03_mapper_bank_count
+ *  Returns the number of 16KB banks of the PRG-ROM: the default bank (0), the switchable banks up to the last one
+ *  used by the program, and the fixed bank. The boards expect a power of two, so the count is rounded up.
+ *
+ * Parameters:
+ *  <Rp2a03Program> *program: The program object
+ *
+ * Returns:
+ *  size_t: Number of PRG-ROM banks
+ */
+size_t rp2a03_mapper_bank_count(Rp2a03Program *program)
+{
+    size_t count = 2;
+
+    for (size_t i=1; i < ZNES_BANK_COUNT; i++)
+    {
+        while (program->banks[i] != NULL && count < i + 2)
+            count *= 2;
+    }
+
+    return count;
+}
+
+/*
+ * Function: rp2a03_mapper_code_address
+ *  Returns the lowest address where the linker can place the text segments. With NROM it is the start of the
+ *  PRG-ROM, but with a mapper the code must live in the fixed bank: the reset routine runs before the default
+ *  bank is selected, and the code keeps running while other bank is mapped at $8000.
+ *
+ * Parameters:
+ *  <Rp2a03Program> *program: The program object
+ *
+ * Returns:
+ *  uint16_t: The lowest address of the text segments
+ */
+uint16_t rp2a03_mapper_code_address(Rp2a03Program *program)
+{
+    return program->mapper == ZNES_MAPPER_NROM ? program->data->base_address : RP2A03_MAPPER_FIXED_ADDRESS;
+}
+
+/*
+ * Function: rp2a03_mapper_add_trampolines
+ *  Reserves the bank switching routines in the fixed bank. Both of them take the bank number in A:
+ *
+ *  - UxROM: the write to the bank register goes through a table that contains the bank numbers, so the byte
+ *    in ROM matches the written value (the board has bus conflicts). Y is clobbered.
+ *          init:   LDA #0
+ *          select: TAY
+ *                  STA table,Y
+ *                  RTS
+ *
+ *  - MMC1: the init routine resets the shift register and writes the control register, then the PRG bank
+ *    register ($E000) is written one bit at a time.
+ *          init:   LDA #$80
+ *                  STA $8000
+ *                  LDA #MMC1_CONTROL
+ *                  (serial write to $8000)
+ *                  LDA #0
+ *          select: (serial write to $E000)
+ *                  RTS
+ *
+ *  The startup routine calls *init* before anything else (see <rp2a03_mapper_emit_init>), and the code that
+ *  reads from a switchable bank calls *select* (see <rp2a03_mapper_emit_switch>).
+ *
+ * Parameters:
+ *  <Rp2a03Program> *program: The program object, its DATA segment must contain the variables
+ *
+ * Returns:
+ *  bool: *false* if the routines do not fit in the fixed bank
+ */
+bool rp2a03_mapper_add_trampolines(Rp2a03Program *program)
+{
+    if (program->mapper == ZNES_MAPPER_NROM)
+        return true;
+
+    uint8_t bytes[TRAMPOLINE_MAX_SIZE] = { 0 };
+    size_t size = 0;
+    size_t select_offset = 0;
+
+    if (program->mapper == ZNES_MAPPER_UXROM)
+    {
+        size_t count = rp2a03_mapper_bank_count(program);
+        uint8_t table[ZNES_BANK_COUNT] = { 0 };
+
+        for (size_t i=0; i < count; i++)
+            table[i] = (uint8_t) i;
+
+        uint16_t table_address = 0;
+        if (!rp2a03_data_segment_reserve_from(program->data, RP2A03_MAPPER_FIXED_ADDRESS, table, count, &table_address))
+            return false;
+
+        size = put(bytes, size, NES_OP_LDA, NES_ADDR_IMM, 0);
+        select_offset = size;
+        size = put(bytes, size, NES_OP_TAY, NES_ADDR_IMP, 0);
+        size = put(bytes, size, NES_OP_STA, NES_ADDR_ABY, table_address);
+        size = put(bytes, size, NES_OP_RTS, NES_ADDR_IMP, 0);
+    }
+    else if (program->mapper == ZNES_MAPPER_MMC1)
+    {
+        size = put(bytes, size, NES_OP_LDA, NES_ADDR_IMM, 0x80);
+        size = put(bytes, size, NES_OP_STA, NES_ADDR_ABS, 0x8000);
+        size = put(bytes, size, NES_OP_LDA, NES_ADDR_IMM, MMC1_CONTROL);
+        size = put_serial_write(bytes, size, 0x8000);
+        size = put(bytes, size, NES_OP_LDA, NES_ADDR_IMM, 0);
+        select_offset = size;
+        size = put_serial_write(bytes, size, 0xE000);
+        size = put(bytes, size, NES_OP_RTS, NES_ADDR_IMP, 0);
+    }
+    else
+    {
+        return false;
+    }
+
+    uint16_t address = 0;
+    if (!rp2a03_data_segment_reserve_from(program->data, RP2A03_MAPPER_FIXED_ADDRESS, bytes, size, &address))
+        return false;
+
+    program->bank_init = address;
+    program->bank_select = (uint16_t) (address + select_offset);
+
+    return true;
+}
+
+/*
+ * Function: rp2a03_mapper_emit_init
+ *  Emits the call to the routine that sets up the mapper and selects the default bank
+ */
+void rp2a03_mapper_emit_init(Rp2a03Program *program, Rp2a03TextSegment *segment)
+{
+    if (program->bank_init == 0)
+        return;
+
+    rp2a03_program_emit_abs(program, segment, NES_OP_JSR, program->bank_init);
+}
+
+/*
+ * Function: rp2a03_mapper_emit_switch
+ *  Emits the call to the routine that maps the *bank* at $8000. The registers A and Y and the flags are
+ *  clobbered.
+ */
+void rp2a03_mapper_emit_switch(Rp2a03Program *program, Rp2a03TextSegment *segment, uint8_t bank)
+{
+    if (program->bank_select == 0)
+        return;
+
+    rp2a03_program_emit_imm(program, segment, NES_OP_LDA, bank);
+    rp2a03_program_emit_abs(program, segment, NES_OP_JSR, program->bank_select);
+}
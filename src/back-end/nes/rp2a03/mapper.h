@@ -0,0 +1,19 @@
+#ifndef RP2A03_MAPPER_H
+#define RP2A03_MAPPER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "program.h"
+#include "segment-text.h"
+
+// The last 16KB bank is fixed at $C000 with the supported mappers
+#define RP2A03_MAPPER_FIXED_ADDRESS 0xC000
+
+size_t rp2a03_mapper_bank_count(Rp2a03Program *program);
+uint16_t rp2a03_mapper_code_address(Rp2a03Program *program);
+bool rp2a03_mapper_add_trampolines(Rp2a03Program *program);
+void rp2a03_mapper_emit_init(Rp2a03Program *program, Rp2a03TextSegment *segment);
+void rp2a03_mapper_emit_switch(Rp2a03Program *program, Rp2a03TextSegment *segment, uint8_t bank);
+
+#endif /* RP2A03_MAPPER_H */
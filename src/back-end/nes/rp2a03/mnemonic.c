@@ -2,7 +2,7 @@
 
 #include <stdint.h>
 
-static struct Rp2a03MnemonicMap {
+static const struct Rp2a03MnemonicMap {
     Rp2a03Mnemonic opcode;
     Rp2a03AddressMode mode;
     const char *mnemonic;
@@ -274,3 +274,55 @@ uint8_t rp2a03_opcode_lookup(Rp2a03Mnemonic opcode, Rp2a03AddressMode mode)
 
     return 0xff;
 }
+
+bool rp2a03_mnemonic_sets_nz_flags(Rp2a03Mnemonic mnemonic)
+{
+    switch (mnemonic)
+    {
+        case NES_OP_ADC: case NES_OP_AND: case NES_OP_ASL: case NES_OP_BIT:
+        case NES_OP_CMP: case NES_OP_CPX: case NES_OP_CPY: case NES_OP_DEC:
+        case NES_OP_DEX: case NES_OP_DEY: case NES_OP_EOR: case NES_OP_INC:
+        case NES_OP_INX: case NES_OP_INY: case NES_OP_LDA: case NES_OP_LDX:
+        case NES_OP_LDY: case NES_OP_LSR: case NES_OP_ORA: case NES_OP_PLA:
+        case NES_OP_PLP: case NES_OP_ROL: case NES_OP_ROR: case NES_OP_SBC:
+        case NES_OP_TAX: case NES_OP_TAY: case NES_OP_TSX: case NES_OP_TXA:
+        case NES_OP_TYA: case NES_OP_RTI:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/*
+ * Function: rp2a03_mnemonic_writes_register
+ *  Returns *true* if the instruction changes the contents of the register. The shifts and rotations only
+ *  write A in their accumulator (implied) version, and the subroutine calls and returns are considered to
+ *  write all of them.
+ */
+bool rp2a03_mnemonic_writes_register(Rp2a03Mnemonic mnemonic, Rp2a03AddressMode mode, Rp2a03Register reg)
+{
+    switch (mnemonic)
+    {
+        case NES_OP_ASL: case NES_OP_LSR: case NES_OP_ROL: case NES_OP_ROR:
+            return reg == RP2A03_REG_A && mode == NES_ADDR_IMP;
+
+        case NES_OP_LDA: case NES_OP_PLA: case NES_OP_TXA: case NES_OP_TYA:
+        case NES_OP_ADC: case NES_OP_SBC: case NES_OP_AND: case NES_OP_ORA:
+        case NES_OP_EOR:
+            return reg == RP2A03_REG_A;
+
+        case NES_OP_LDX: case NES_OP_TAX: case NES_OP_TSX: case NES_OP_INX:
+        case NES_OP_DEX:
+            return reg == RP2A03_REG_X;
+
+        case NES_OP_LDY: case NES_OP_TAY: case NES_OP_INY: case NES_OP_DEY:
+            return reg == RP2A03_REG_Y;
+
+        case NES_OP_JSR: case NES_OP_RTS: case NES_OP_RTI: case NES_OP_BRK:
+            return true;
+
+        default:
+            return false;
+    }
+}
@@ -2,6 +2,7 @@
 #define RP2A03_OPCODE_H
 
 #include <stdint.h>
+#include <stdbool.h>
 
 typedef enum Rp2a03Mnemonic {
     NES_OP_ADC, NES_OP_AND, NES_OP_ASL, NES_OP_BCC, NES_OP_BCS, 
@@ -33,6 +34,15 @@ typedef enum Rp2a03AddressMode {
     NES_ADDR_ZPY
 } Rp2a03AddressMode;
 
+typedef enum Rp2a03Register {
+    RP2A03_REG_A,
+    RP2A03_REG_X,
+    RP2A03_REG_Y,
+    RP2A03_REG_COUNT
+} Rp2a03Register;
+
 uint8_t rp2a03_opcode_lookup(Rp2a03Mnemonic opcode, Rp2a03AddressMode mode);
+bool rp2a03_mnemonic_sets_nz_flags(Rp2a03Mnemonic mnemonic);
+bool rp2a03_mnemonic_writes_register(Rp2a03Mnemonic mnemonic, Rp2a03AddressMode mode, Rp2a03Register reg);
 
 #endif /* RP2A03_OPCODE_H */
@@ -0,0 +1,579 @@
+#include <fllib/Mem.h>
+#include <fllib/Cstring.h>
+#include "peephole.h"
+#include "instruction.h"
+#include "mnemonic.h"
+
+static const char *rule_names[RP2A03_PEEPHOLE_RULE_COUNT] = {
+    [RP2A03_PEEPHOLE_STORE_LOAD]        = "store-load",
+    [RP2A03_PEEPHOLE_JUMP_THREADING]    = "jump-threading",
+    [RP2A03_PEEPHOLE_JUMP_NEXT]         = "jump-next",
+    [RP2A03_PEEPHOLE_REUSE_REGISTER]    = "reuse-register",
+};
+
+static const Rp2a03Mnemonic load_mnemonics[RP2A03_REG_COUNT] = { NES_OP_LDA, NES_OP_LDX, NES_OP_LDY };
+static const Rp2a03Mnemonic store_mnemonics[RP2A03_REG_COUNT] = { NES_OP_STA, NES_OP_STX, NES_OP_STY };
+
+/*
+ * Struct: PeepholeInstruction
+ *  An instruction decoded from the text segment. The *label* flag marks the instructions that are the target
+ *  of a jump, the instructions that own a pending jump keep it in *jump*, and the relative branches that were
+ *  resolved by the emitters (the loops) keep their original target in *target*
+ */
+typedef struct PeepholeInstruction {
+    uint16_t pc;
+    uint16_t operand;
+    uint8_t size;
+    Rp2a03Mnemonic mnemonic;
+    Rp2a03AddressMode mode;
+    Rp2a03PendingJump *jump;
+    int32_t target;
+    bool label;
+    bool removed;
+} PeepholeInstruction;
+
+typedef struct Peephole {
+    Rp2a03TextSegment *text;
+    PeepholeInstruction *instructions;
+    size_t count;
+    size_t *index;
+    Rp2a03PeepholeStats *stats;
+} Peephole;
+
+const char* rp2a03_peephole_rule_name(Rp2a03PeepholeRule rule)
+{
+    return rule < RP2A03_PEEPHOLE_RULE_COUNT ? rule_names[rule] : NULL;
+}
+
+bool rp2a03_peephole_rule_parse(const char *name, Rp2a03PeepholeRule *rule)
+{
+    for (size_t i=0; i < RP2A03_PEEPHOLE_RULE_COUNT; i++)
+    {
+        if (flm_cstring_equals(name, rule_names[i]))
+        {
+            *rule = (Rp2a03PeepholeRule) i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Function: instruction_cycles
+ *  Returns the base cycles of the instructions the rules remove, without the page crossing and the taken
+ *  branch penalties
+ */
+static size_t instruction_cycles(PeepholeInstruction *instruction)
+{
+    switch (instruction->mode)
+    {
+        case NES_ADDR_ZPG:
+            return 3;
+
+        case NES_ADDR_ABS:
+            return instruction->mnemonic == NES_OP_JMP ? 3 : 4;
+
+        default:
+            return 2;
+    }
+}
+
+static void record(Peephole *peephole, Rp2a03PeepholeRule rule, size_t bytes, size_t cycles)
+{
+    peephole->stats->applied[rule]++;
+    peephole->stats->bytes[rule] += bytes;
+    peephole->stats->cycles[rule] += cycles;
+}
+
+static size_t next_kept(Peephole *peephole, size_t index)
+{
+    do {
+        index++;
+    } while (index < peephole->count && peephole->instructions[index].removed);
+
+    return index;
+}
+
+/*
+ * Function: resolve
+ *  Returns the index of the instruction that executes when the code jumps to *pc*: the first one that is not
+ *  removed at or after it. The end of the segment is *count*
+ */
+static size_t resolve(Peephole *peephole, uint16_t pc)
+{
+    size_t index = peephole->index[pc];
+
+    while (index < peephole->count && peephole->instructions[index].removed)
+        index++;
+
+    return index;
+}
+
+static size_t jump_target(Peephole *peephole, PeepholeInstruction *instruction)
+{
+    return resolve(peephole, instruction->jump != NULL ? instruction->jump->target_pc : (uint16_t) instruction->target);
+}
+
+static int register_of(const Rp2a03Mnemonic *mnemonics, Rp2a03Mnemonic mnemonic)
+{
+    for (int i=0; i < RP2A03_REG_COUNT; i++)
+        if (mnemonics[i] == mnemonic)
+            return i;
+
+    return -1;
+}
+
+/*
+ * Function: overwrites
+ *  Returns *true* if the instruction writes the register and the N and Z flags without reading the previous
+ *  value of the register
+ */
+static bool overwrites(PeepholeInstruction *instruction, Rp2a03Register reg)
+{
+    if (instruction->mnemonic == load_mnemonics[reg])
+        return true;
+
+    switch (instruction->mnemonic)
+    {
+        case NES_OP_PLA: case NES_OP_TXA: case NES_OP_TYA:
+            return reg == RP2A03_REG_A;
+
+        case NES_OP_TAX: case NES_OP_TSX:
+            return reg == RP2A03_REG_X;
+
+        case NES_OP_TAY:
+            return reg == RP2A03_REG_Y;
+
+        default:
+            return false;
+    }
+}
+
+/*
+ * Function: decode
+ *  Decodes the bytes of the segment into the instruction list, links the pending jumps with their
+ *  instructions, and marks the labels. It returns *false* if the segment cannot be optimized: unknown
+ *  opcodes, or jumps whose target is not known yet or is not an instruction boundary.
+ */
+static bool decode(Peephole *peephole)
+{
+    Rp2a03TextSegment *text = peephole->text;
+
+    for (size_t pc=0; pc <= text->pc; pc++)
+        peephole->index[pc] = SIZE_MAX;
+
+    for (uint16_t pc=0; pc < text->pc;)
+    {
+        const Rp2a03Instruction *info = rp2a03_instruction_lookup(text->bytes[pc]);
+
+        if (info->mnemonic == NES_OP_XXX || pc + info->size > text->pc)
+            return false;
+
+        PeepholeInstruction *instruction = peephole->instructions + peephole->count;
+        *instruction = (PeepholeInstruction) {
+            .pc = pc,
+            .operand = info->size == 1 ? 0 : (info->size == 2 ? text->bytes[pc + 1] : (uint16_t) (text->bytes[pc + 1] | (text->bytes[pc + 2] << 8))),
+            .size = info->size,
+            .mnemonic = info->mnemonic,
+            .mode = info->mode,
+            .jump = NULL,
+            .target = -1,
+            .label = false,
+            .removed = false
+        };
+
+        peephole->index[pc] = peephole->count++;
+        pc += info->size;
+    }
+
+    peephole->index[text->pc] = peephole->count;
+
+    Rp2a03PendingJumpListNode *node = fl_list_head(text->pending_jumps);
+    while (node)
+    {
+        Rp2a03PendingJump *jump = (Rp2a03PendingJump*) node->value;
+        node = node->next;
+
+        if (jump->ir_offset != 0 || jump->byte_index == 0 || jump->target_pc > text->pc)
+            return false;
+
+        size_t owner = peephole->index[jump->byte_index - 1];
+        size_t target = peephole->index[jump->target_pc];
+
+        if (owner == SIZE_MAX || target == SIZE_MAX)
+            return false;
+
+        peephole->instructions[owner].jump = jump;
+
+        if (target < peephole->count)
+            peephole->instructions[target].label = true;
+    }
+
+    for (size_t i=0; i < peephole->count; i++)
+    {
+        PeepholeInstruction *instruction = peephole->instructions + i;
+
+        if (instruction->mode != NES_ADDR_REL || instruction->jump != NULL)
+            continue;
+
+        int32_t target = (int32_t) instruction->pc + 2 + (int8_t) instruction->operand;
+
+        if (target < 0 || target > text->pc || peephole->index[target] == SIZE_MAX)
+            return false;
+
+        instruction->target = target;
+
+        if (peephole->index[target] < peephole->count)
+            peephole->instructions[peephole->index[target]].label = true;
+    }
+
+    return true;
+}
+
+/*
+ * Function: store_load
+ *  STA x; LDA x -> STA x (same for X and Y). The load sets the N and Z flags, so it can be removed if the
+ *  instruction before the store already set them with the value of the register, or if the instruction
+ *  after the load sets them again
+ */
+static bool store_load(Peephole *peephole, size_t index)
+{
+    PeepholeInstruction *store = peephole->instructions + index;
+    int reg = register_of(store_mnemonics, store->mnemonic);
+
+    if (reg < 0 || (store->mode != NES_ADDR_ZPG && store->mode != NES_ADDR_ABS) || RP2A03_IS_IO_REGISTER(store->operand))
+        return false;
+
+    size_t load_index = next_kept(peephole, index);
+
+    if (load_index >= peephole->count)
+        return false;
+
+    PeepholeInstruction *load = peephole->instructions + load_index;
+
+    if (load->label || load->mnemonic != load_mnemonics[reg] || load->mode != store->mode || load->operand != store->operand)
+        return false;
+
+    // The instruction before the store always runs before it if the store is not a label
+    size_t previous = index;
+    while (previous > 0 && peephole->instructions[previous - 1].removed)
+        previous--;
+
+    bool flags_set = !store->label && previous > 0
+                        && rp2a03_mnemonic_writes_register(peephole->instructions[previous - 1].mnemonic, peephole->instructions[previous - 1].mode, (Rp2a03Register) reg)
+                        && rp2a03_mnemonic_sets_nz_flags(peephole->instructions[previous - 1].mnemonic);
+
+    size_t after = next_kept(peephole, load_index);
+    if (!flags_set && (after >= peephole->count || rp2a03_mnemonic_sets_nz_flags(peephole->instructions[after].mnemonic)))
+        flags_set = true;
+
+    if (!flags_set)
+        return false;
+
+    load->removed = true;
+    record(peephole, RP2A03_PEEPHOLE_STORE_LOAD, load->size, instruction_cycles(load));
+
+    return true;
+}
+
+/*
+ * Function: jump_threading
+ *  A jump to a JMP goes straight to the final target. The relative branches are threaded only if the final
+ *  target is within their range, otherwise they would need to be relaxed
+ */
+static bool jump_threading(Peephole *peephole, size_t index)
+{
+    PeepholeInstruction *jump = peephole->instructions + index;
+
+    if (jump->jump == NULL)
+        return false;
+
+    size_t target = jump_target(peephole, jump);
+    size_t hops = 0;
+
+    while (target < peephole->count && hops < peephole->count)
+    {
+        PeepholeInstruction *next_jump = peephole->instructions + target;
+
+        if (next_jump->mnemonic != NES_OP_JMP || next_jump->jump == NULL)
+            break;
+
+        size_t next_target = jump_target(peephole, next_jump);
+
+        if (next_target == target)
+            break;
+
+        target = next_target;
+        hops++;
+    }
+
+    // A cycle of jumps cannot be threaded
+    if (hops == 0 || hops >= peephole->count)
+        return false;
+
+    uint16_t target_pc = target < peephole->count ? peephole->instructions[target].pc : peephole->text->pc;
+
+    if (jump->mode == NES_ADDR_REL)
+    {
+        // Removing instructions can only shorten the distance
+        int distance = (int) target_pc - (int) (jump->pc + 2);
+        if (distance < -128 || distance > 127)
+            return false;
+    }
+
+    jump->jump->target_pc = target_pc;
+
+    if (target < peephole->count)
+        peephole->instructions[target].label = true;
+
+    record(peephole, RP2A03_PEEPHOLE_JUMP_THREADING, 0, 3 * hops);
+
+    return true;
+}
+
+/*
+ * Function: jump_next
+ *  A JMP or a branch to the next instruction does nothing
+ */
+static bool jump_next(Peephole *peephole, size_t index)
+{
+    PeepholeInstruction *jump = peephole->instructions + index;
+
+    if (jump->jump == NULL || jump_target(peephole, jump) != next_kept(peephole, index))
+        return false;
+
+    jump->removed = true;
+    record(peephole, RP2A03_PEEPHOLE_JUMP_NEXT, jump->size, instruction_cycles(jump));
+
+    return true;
+}
+
+/*
+ * Function: reuse_register
+ *  LDA #v; STA x; ...; STA y -> STX x; ...; STX y when X is known to contain v (same for the other registers).
+ *  The values of the registers are tracked from the start of the segment and the labels, and the load can go
+ *  away only if the instruction after the stores overwrites the register and the flags
+ */
+static bool reuse_register(Peephole *peephole)
+{
+    int16_t known[RP2A03_REG_COUNT] = { -1, -1, -1 };
+    bool changed = false;
+
+    for (size_t i=0; i < peephole->count; i++)
+    {
+        PeepholeInstruction *instruction = peephole->instructions + i;
+
+        if (instruction->removed)
+            continue;
+
+        if (instruction->label)
+            known[RP2A03_REG_A] = known[RP2A03_REG_X] = known[RP2A03_REG_Y] = -1;
+
+        int reg = register_of(load_mnemonics, instruction->mnemonic);
+
+        if (reg >= 0 && instruction->mode == NES_ADDR_IMM)
+        {
+            int other = -1;
+            for (int j=0; j < RP2A03_REG_COUNT && other < 0; j++)
+                if (j != reg && known[j] == instruction->operand)
+                    other = j;
+
+            size_t after = next_kept(peephole, i);
+            size_t stores = 0;
+
+            while (after < peephole->count)
+            {
+                PeepholeInstruction *store = peephole->instructions + after;
+
+                if (store->label || store->mnemonic != store_mnemonics[reg] || (store->mode != NES_ADDR_ZPG && store->mode != NES_ADDR_ABS))
+                    break;
+
+                stores++;
+                after = next_kept(peephole, after);
+            }
+
+            if (other >= 0 && stores > 0 && (after >= peephole->count || overwrites(peephole->instructions + after, (Rp2a03Register) reg)))
+            {
+                instruction->removed = true;
+
+                for (size_t j=next_kept(peephole, i); j < after; j = next_kept(peephole, j))
+                    peephole->instructions[j].mnemonic = store_mnemonics[other];
+
+                record(peephole, RP2A03_PEEPHOLE_REUSE_REGISTER, instruction->size, instruction_cycles(instruction));
+                changed = true;
+                continue;
+            }
+
+            known[reg] = instruction->operand;
+            continue;
+        }
+
+        for (int j=0; j < RP2A03_REG_COUNT; j++)
+            if (rp2a03_mnemonic_writes_register(instruction->mnemonic, instruction->mode, (Rp2a03Register) j))
+                known[j] = -1;
+    }
+
+    return changed;
+}
+
+/*
+ * Function: encode
+ *  Writes the instructions that are not removed back to the segment, and updates the pending jumps and the
+ *  relative offsets of the loops. The bytes keep the origin of their instruction
+ */
+static void encode(Peephole *peephole)
+{
+    Rp2a03TextSegment *text = peephole->text;
+
+    // New PC of each instruction, the last entry is the end of the segment
+    uint16_t *new_pc = fl_malloc(sizeof(uint16_t) * (peephole->count + 1));
+    uint16_t pc = 0;
+
+    for (size_t i=0; i < peephole->count; i++)
+    {
+        new_pc[i] = pc;
+
+        if (!peephole->instructions[i].removed)
+            pc += peephole->instructions[i].size;
+    }
+    new_pc[peephole->count] = pc;
+
+    // The pending jumps of the removed instructions go away
+    Rp2a03PendingJumpListNode *node = fl_list_head(text->pending_jumps);
+    while (node)
+    {
+        Rp2a03PendingJump *jump = (Rp2a03PendingJump*) node->value;
+        Rp2a03PendingJumpListNode *current = node;
+        node = node->next;
+
+        size_t owner = peephole->index[jump->byte_index - 1];
+
+        if (peephole->instructions[owner].removed)
+        {
+            fl_list_remove(text->pending_jumps, current);
+            continue;
+        }
+
+        jump->byte_index = new_pc[owner] + 1;
+        jump->base_jump_pc = new_pc[owner] + peephole->instructions[owner].size;
+        jump->target_pc = new_pc[resolve(peephole, jump->target_pc)];
+    }
+
+    uint8_t *bytes = fl_malloc(sizeof(uint8_t) * (text->pc > 0 ? text->pc : 1));
+    uint16_t *origins = fl_malloc(sizeof(uint16_t) * (text->pc > 0 ? text->pc : 1));
+
+    for (size_t i=0; i < peephole->count; i++)
+    {
+        PeepholeInstruction *instruction = peephole->instructions + i;
+
+        if (instruction->removed)
+            continue;
+
+        uint16_t at = new_pc[i];
+        bytes[at] = rp2a03_opcode_lookup(instruction->mnemonic, instruction->mode);
+        memcpy(bytes + at + 1, text->bytes + instruction->pc + 1, instruction->size - 1);
+
+        for (uint8_t j=0; j < instruction->size; j++)
+            origins[at + j] = text->origins[instruction->pc];
+
+        if (instruction->target >= 0)
+            bytes[at + 1] = (uint8_t) ((new_pc[resolve(peephole, (uint16_t) instruction->target)] - (at + 2)) & 0xFF);
+    }
+
+    memcpy(text->bytes, bytes, pc);
+    memcpy(text->origins, origins, sizeof(uint16_t) * pc);
+    text->pc = pc;
+
+    fl_free(bytes);
+    fl_free(origins);
+    fl_free(new_pc);
+}
+
+/*
+ * Function: rp2a03_peephole_optimize
+ *  Decodes the bytes of the text segment into a list of instructions, applies the enabled rules until none of
+ *  them changes the code, and encodes the instructions back. The pending jumps are updated, so this runs once
+ *  the targets of all the jumps are known, before the branches are relaxed.
+ *
+ * Parameters:
+ *  <Rp2a03TextSegment> *text: The text segment
+ *  <uint32_t> rules: The enabled rules (<RP2A03_PEEPHOLE_RULE_FLAG> of each rule)
+ *  <Rp2a03PeepholeStats> *stats: Receives the number of times each rule is applied, and the bytes and cycles it saves
+ *
+ * Returns:
+ *  size_t: The number of bytes removed from the segment
+ */
+size_t rp2a03_peephole_optimize(Rp2a03TextSegment *text, uint32_t rules, Rp2a03PeepholeStats *stats)
+{
+    if (text->pc == 0 || (rules & RP2A03_PEEPHOLE_ALL) == 0)
+        return 0;
+
+    Peephole peephole = {
+        .text = text,
+        .instructions = fl_malloc(sizeof(PeepholeInstruction) * text->pc),
+        .count = 0,
+        .index = fl_malloc(sizeof(size_t) * (text->pc + 1)),
+        .stats = stats
+    };
+
+    uint16_t original_size = text->pc;
+
+    if (decode(&peephole))
+    {
+        bool changed = true;
+
+        while (changed)
+        {
+            changed = false;
+
+            for (size_t i=0; i < peephole.count; i++)
+            {
+                if (peephole.instructions[i].removed)
+                    continue;
+
+                if ((rules & RP2A03_PEEPHOLE_RULE_FLAG(RP2A03_PEEPHOLE_STORE_LOAD)) && store_load(&peephole, i))
+                    changed = true;
+
+                // A JMP to the next instruction is removed before it is threaded
+                if ((rules & RP2A03_PEEPHOLE_RULE_FLAG(RP2A03_PEEPHOLE_JUMP_NEXT)) && jump_next(&peephole, i))
+                {
+                    changed = true;
+                    continue;
+                }
+
+                if ((rules & RP2A03_PEEPHOLE_RULE_FLAG(RP2A03_PEEPHOLE_JUMP_THREADING)) && jump_threading(&peephole, i))
+                    changed = true;
+            }
+
+            if ((rules & RP2A03_PEEPHOLE_RULE_FLAG(RP2A03_PEEPHOLE_REUSE_REGISTER)) && reuse_register(&peephole))
+                changed = true;
+        }
+
+        encode(&peephole);
+    }
+
+    fl_free(peephole.index);
+    fl_free(peephole.instructions);
+
+    return original_size - text->pc;
+}
+
+char* rp2a03_peephole_report(Rp2a03PeepholeStats *stats, char *output)
+{
+    fl_cstring_vappend(&output, "%-16s %8s %8s %8s\n", "rule", "applied", "bytes", "cycles");
+
+    size_t total_bytes = 0;
+    size_t total_cycles = 0;
+
+    for (size_t i=0; i < RP2A03_PEEPHOLE_RULE_COUNT; i++)
+    {
+        fl_cstring_vappend(&output, "%-16s %8zu %8zu %8zu\n", rule_names[i], stats->applied[i], stats->bytes[i], stats->cycles[i]);
+        total_bytes += stats->bytes[i];
+        total_cycles += stats->cycles[i];
+    }
+
+    fl_cstring_vappend(&output, "%-16s %8s %8zu %8zu\n", "total", "", total_bytes, total_cycles);
+
+    return output;
+}
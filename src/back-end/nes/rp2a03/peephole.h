@@ -0,0 +1,31 @@
+#ifndef RP2A03_PEEPHOLE_H
+#define RP2A03_PEEPHOLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "segment-text.h"
+
+typedef enum Rp2a03PeepholeRule {
+    RP2A03_PEEPHOLE_STORE_LOAD,
+    RP2A03_PEEPHOLE_JUMP_THREADING,
+    RP2A03_PEEPHOLE_JUMP_NEXT,
+    RP2A03_PEEPHOLE_REUSE_REGISTER,
+    RP2A03_PEEPHOLE_RULE_COUNT
+} Rp2a03PeepholeRule;
+
+#define RP2A03_PEEPHOLE_RULE_FLAG(rule) (1u << (rule))
+#define RP2A03_PEEPHOLE_ALL ((1u << RP2A03_PEEPHOLE_RULE_COUNT) - 1)
+
+typedef struct Rp2a03PeepholeStats {
+    size_t applied[RP2A03_PEEPHOLE_RULE_COUNT];
+    size_t bytes[RP2A03_PEEPHOLE_RULE_COUNT];
+    size_t cycles[RP2A03_PEEPHOLE_RULE_COUNT];
+} Rp2a03PeepholeStats;
+
+const char* rp2a03_peephole_rule_name(Rp2a03PeepholeRule rule);
+bool rp2a03_peephole_rule_parse(const char *name, Rp2a03PeepholeRule *rule);
+size_t rp2a03_peephole_optimize(Rp2a03TextSegment *text, uint32_t rules, Rp2a03PeepholeStats *stats);
+char* rp2a03_peephole_report(Rp2a03PeepholeStats *stats, char *output);
+
+#endif /* RP2A03_PEEPHOLE_H */
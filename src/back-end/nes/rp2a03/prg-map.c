@@ -0,0 +1,156 @@
+#include <fllib/Mem.h>
+#include <fllib/Array.h>
+#include <fllib/Cstring.h>
+#include "prg-map.h"
+
+/*
+ * Constant: PRG_VECTORS_ADDRESS
+ *  The NMI, RESET, and IRQ vectors live in the last 6 bytes of the address space. Even if the program
+ *  does not define them, the ROM writes them, so they are never free.
+ */
+#define PRG_VECTORS_ADDRESS 0xFFFA
+
+static void update_largest(Rp2a03PrgMap *map)
+{
+    map->largest = 0;
+
+    for (size_t i=0; i < map->count; i++)
+    {
+        if (map->ranges[i].size > map->largest)
+            map->largest = map->ranges[i].size;
+    }
+}
+
+/*
+ * Function: rp2a03_prg_map_new
+ *  Builds the free-range index with one pass over the DATA segment slots
+ */
+Rp2a03PrgMap* rp2a03_prg_map_new(Rp2a03DataSegment *data)
+{
+    return rp2a03_prg_map_new_from(data, data->base_address);
+}
+
+/*
+ * Function: rp2a03_prg_map_new_from
+ *  Same as <rp2a03_prg_map_new>, but the bytes below *from_address* are not part of the map (e.g. the
+ *  switchable bank window when the text segments must live in the fixed bank)
+ */
+Rp2a03PrgMap* rp2a03_prg_map_new_from(Rp2a03DataSegment *data, uint16_t from_address)
+{
+    Rp2a03PrgMap *map = fl_malloc(sizeof(Rp2a03PrgMap));
+
+    size_t length = fl_array_length(data->slots);
+
+    if (data->base_address + length > PRG_VECTORS_ADDRESS)
+        length = data->base_address < PRG_VECTORS_ADDRESS ? PRG_VECTORS_ADDRESS - data->base_address : 0;
+
+    size_t first = from_address > data->base_address ? (size_t) (from_address - data->base_address) : 0;
+
+    if (first > length)
+        first = length;
+
+    // There are at most length / 2 + 1 free ranges (every other byte used)
+    map->ranges = fl_malloc(sizeof(Rp2a03PrgRange) * (length / 2 + 1));
+    map->count = 0;
+    map->free_bytes = 0;
+
+    size_t start = first;
+    for (size_t i=first; i <= length; i++)
+    {
+        if (i < length && data->slots[i] == 0)
+            continue;
+
+        if (i > start)
+        {
+            map->ranges[map->count++] = (Rp2a03PrgRange) {
+                .address = (uint16_t) (data->base_address + start),
+                .size = i - start
+            };
+            map->free_bytes += i - start;
+        }
+
+        start = i + 1;
+    }
+
+    update_largest(map);
+
+    return map;
+}
+
+void rp2a03_prg_map_free(Rp2a03PrgMap *map)
+{
+    if (!map)
+        return;
+
+    fl_free(map->ranges);
+    fl_free(map);
+}
+
+/*
+ * Function: rp2a03_prg_map_allocate
+ *  Places a blob of *size* bytes in the smallest free range that can hold it (the lowest address wins
+ *  on ties), and stores the blob's address in the *address* pointer. If no range is big enough, the
+ *  function returns *false* without looking at the ranges.
+ */
+bool rp2a03_prg_map_allocate(Rp2a03PrgMap *map, size_t size, uint16_t *address)
+{
+    if (size == 0 || size > map->largest)
+        return false;
+
+    size_t best = map->count;
+    for (size_t i=0; i < map->count; i++)
+    {
+        if (map->ranges[i].size < size)
+            continue;
+
+        if (best == map->count || map->ranges[i].size < map->ranges[best].size)
+            best = i;
+
+        // Exact fit, there is nothing better
+        if (map->ranges[best].size == size)
+            break;
+    }
+
+    Rp2a03PrgRange *range = &map->ranges[best];
+    bool was_largest = range->size == map->largest;
+
+    *address = range->address;
+    range->address += size;
+    range->size -= size;
+    map->free_bytes -= size;
+
+    if (range->size == 0)
+    {
+        memmove(map->ranges + best, map->ranges + best + 1, sizeof(Rp2a03PrgRange) * (map->count - best - 1));
+        map->count--;
+    }
+
+    if (was_largest)
+        update_largest(map);
+
+    return true;
+}
+
+/*
+ * Function: rp2a03_prg_map_fragmentation
+ *  Returns the percentage of free bytes that are not part of the largest free range. 0% means all the
+ *  free space is contiguous.
+ */
+unsigned int rp2a03_prg_map_fragmentation(Rp2a03PrgMap *map)
+{
+    if (map->free_bytes == 0)
+        return 0;
+
+    return (unsigned int) (((map->free_bytes - map->largest) * 100) / map->free_bytes);
+}
+
+char* rp2a03_prg_map_dump(Rp2a03PrgMap *map, char *output)
+{
+    fl_cstring_vappend(&output, "; PRG free ranges: %zu (%zu bytes free, largest %zu bytes, fragmentation %u%%)\n",
+                        map->count, map->free_bytes, map->largest, rp2a03_prg_map_fragmentation(map));
+
+    for (size_t i=0; i < map->count; i++)
+        fl_cstring_vappend(&output, "; %04X-%04zX | %zu bytes\n", map->ranges[i].address, map->ranges[i].address + map->ranges[i].size - 1, map->ranges[i].size);
+
+    return output;
+}
@@ -0,0 +1,47 @@
+#ifndef RP2A03_PRG_MAP_H
+#define RP2A03_PRG_MAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "segment-data.h"
+
+/*
+ * Struct: Rp2a03PrgRange
+ *  A range of free bytes within the PRG-ROM
+ *
+ * Members:
+ *  <uint16_t> address: CPU address of the first free byte
+ *  <size_t> size: Number of free bytes
+ */
+typedef struct Rp2a03PrgRange {
+    uint16_t address;
+    size_t size;
+} Rp2a03PrgRange;
+
+/*
+ * Struct: Rp2a03PrgMap
+ *  Index of the free ranges within the PRG-ROM, built from the DATA segment slots once the DATA
+ *  segment is complete. Text segments (STARTUP, CODE) are placed in these ranges.
+ *
+ * Members:
+ *  <Rp2a03PrgRange> *ranges: Free ranges sorted by address
+ *  <size_t> count: Number of free ranges
+ *  <size_t> free_bytes: Total number of free bytes
+ *  <size_t> largest: Size of the largest free range
+ */
+typedef struct Rp2a03PrgMap {
+    Rp2a03PrgRange *ranges;
+    size_t count;
+    size_t free_bytes;
+    size_t largest;
+} Rp2a03PrgMap;
+
+Rp2a03PrgMap* rp2a03_prg_map_new(Rp2a03DataSegment *data);
+Rp2a03PrgMap* rp2a03_prg_map_new_from(Rp2a03DataSegment *data, uint16_t from_address);
+void rp2a03_prg_map_free(Rp2a03PrgMap *map);
+bool rp2a03_prg_map_allocate(Rp2a03PrgMap *map, size_t size, uint16_t *address);
+unsigned int rp2a03_prg_map_fragmentation(Rp2a03PrgMap *map);
+char* rp2a03_prg_map_dump(Rp2a03PrgMap *map, char *output);
+
+#endif /* RP2A03_PRG_MAP_H */
@@ -1,4 +1,5 @@
 #include <inttypes.h>
+#include <fllib/Array.h>
 #include <fllib/Cstring.h>
 #include "program.h"
 
@@ -8,10 +9,32 @@ Rp2a03Program* rp2a03_program_new(size_t data_base_address, size_t startup_base_
 
     program->startup = rp2a03_text_segment_new(startup_base_address);
     program->code = rp2a03_text_segment_new(code_base_address);
+    program->blobs = fl_array_new(sizeof(Rp2a03TextSegment*), 0);
 
-    // Size: 1 bank NROM-256 or 2 banks NROM-128 (actually, mirrored)
+    // Size: 1 bank NROM-256 or 2 banks NROM-128 (actually, mirrored). With a mapper, it is the default
+    // bank ($8000-$BFFF) followed by the fixed bank ($C000-$FFFF)
     program->data = rp2a03_data_segment_new(data_base_address, 0x8000);
 
+    // The switchable banks are created on demand (see <rp2a03_program_data_segment>), and the bank switching
+    // routines are added by <rp2a03_mapper_add_trampolines>
+    for (size_t i=0; i < ZNES_BANK_COUNT; i++)
+        program->banks[i] = NULL;
+
+    // The CHR-ROM is created with the first allocation in the CHR segment, without it the board uses CHR-RAM
+    program->chr = NULL;
+
+    program->mapper = ZNES_MAPPER_NROM;
+    program->bank_init = 0;
+    program->bank_select = 0;
+
+    // The free-range map is built once the DATA segment is complete
+    program->prg = NULL;
+    program->peephole = (Rp2a03PeepholeStats) { 0 };
+
+    // The origin 0 is the code that does not come from a declaration
+    program->origins = fl_array_new(sizeof(Rp2a03Origin), 1);
+    program->origins[0] = (Rp2a03Origin) { 0 };
+
     return program;
 }
 
@@ -22,18 +45,160 @@ void rp2a03_program_free(Rp2a03Program *program)
 
     rp2a03_text_segment_free(program->code);
     rp2a03_text_segment_free(program->startup);
+
+    for (size_t i=0; i < fl_array_length(program->blobs); i++)
+        rp2a03_text_segment_free(program->blobs[i]);
+    fl_array_free(program->blobs);
+
     rp2a03_data_segment_free(program->data);
+    for (size_t i=0; i < ZNES_BANK_COUNT; i++)
+        if (program->banks[i]) rp2a03_data_segment_free(program->banks[i]);
+    if (program->chr) rp2a03_data_segment_free(program->chr);
+    rp2a03_prg_map_free(program->prg);
+
+    for (size_t i=0; i < fl_array_length(program->origins); i++)
+    {
+        if (program->origins[i].declaration) fl_cstring_free(program->origins[i].declaration);
+        if (program->origins[i].filename) fl_cstring_free(program->origins[i].filename);
+    }
+    fl_array_free(program->origins);
 
     fl_free(program);
 }
 
+/*
+ * Function: rp2a03_program_data_segment
+ *  Returns the DATA segment of a PRG-ROM bank. The bank 0 is the program's DATA segment, that also holds the
+ *  fixed bank, and the switchable banks are created the first time they are requested.
+ *
+ * Parameters:
+ *  <Rp2a03Program> *program: The program object
+ *  <uint8_t> bank: The bank number, it must be lesser than ZNES_BANK_COUNT
+ *
+ * Returns:
+ *  Rp2a03DataSegment*: The DATA segment of the bank
+ */
+Rp2a03DataSegment* rp2a03_program_data_segment(Rp2a03Program *program, uint8_t bank)
+{
+    if (bank == 0)
+        return program->data;
+
+    if (program->banks[bank] == NULL)
+        program->banks[bank] = rp2a03_data_segment_new(ZNES_BANK_WINDOW_ADDRESS, ZNES_BANK_WINDOW_SIZE);
+
+    return program->banks[bank];
+}
+
+/*
+ * Function: rp2a03_program_alloc_segment
+ *  Returns the segment that holds the bytes of an allocation of the DATA or CHR segments. The CHR
+ *  segment is created the first time it is requested.
+ *
+ * Parameters:
+ *  <Rp2a03Program> *program: The program object
+ *  <ZnesAlloc> *alloc: An allocation of the DATA or CHR segments
+ *
+ * Returns:
+ *  Rp2a03DataSegment*: The CHR segment, or the DATA segment of the allocation's bank
+ */
+Rp2a03DataSegment* rp2a03_program_alloc_segment(Rp2a03Program *program, ZnesAlloc *alloc)
+{
+    if (alloc->segment != ZNES_SEGMENT_CHR)
+        return rp2a03_program_data_segment(program, alloc->bank);
+
+    if (program->chr == NULL)
+        program->chr = rp2a03_data_segment_new(0x0000, ZNES_CHR_SIZE);
+
+    return program->chr;
+}
+
+/*
+ * Function: rp2a03_program_add_blob
+ *  Adds a new text segment to the program. Text blobs are not part of the reset sequence, the linker
+ *  places them in the PRG-ROM where they fit best (see <rp2a03_link_place>)
+ */
+Rp2a03TextSegment* rp2a03_program_add_blob(Rp2a03Program *program)
+{
+    Rp2a03TextSegment *blob = rp2a03_text_segment_new(0x0);
+    program->blobs = fl_array_append(program->blobs, &blob);
+
+    return blob;
+}
+
+/*
+ * Function: rp2a03_program_add_origin
+ *  Returns the index of the declaration in the program's table of origins, adding it if it is not there.
+ *  The text segments keep the origin of each byte (see <Rp2a03TextSegment>), so that the cost of the
+ *  generated code can be attributed to the declarations (see <rp2a03_cost_analyze>).
+ *
+ * Parameters:
+ *  <Rp2a03Program> *program: The program object
+ *  <const char> *declaration: The name of the declaration, NULL if the code does not come from one
+ *  <const char> *filename: The source file, NULL if the source is a string
+ *  <unsigned int> line: Line of the declaration
+ *  <unsigned int> col: Column of the declaration
+ *
+ * Returns:
+ *  uint16_t: The index of the origin, 0 for the code that does not come from a declaration
+ */
+uint16_t rp2a03_program_add_origin(Rp2a03Program *program, const char *declaration, const char *filename, unsigned int line, unsigned int col)
+{
+    if (declaration == NULL)
+        return 0;
+
+    size_t count = fl_array_length(program->origins);
+
+    for (size_t i=1; i < count; i++)
+    {
+        Rp2a03Origin *origin = program->origins + i;
+
+        if (origin->line == line && origin->col == col && flm_cstring_equals(origin->declaration, declaration)
+            && (origin->filename == filename || (origin->filename && filename && flm_cstring_equals(origin->filename, filename))))
+            return (uint16_t) i;
+    }
+
+    // Too many declarations, the rest are not attributed
+    if (count > UINT16_MAX)
+        return 0;
+
+    Rp2a03Origin origin = {
+        .declaration = fl_cstring_dup(declaration),
+        .filename = filename != NULL ? fl_cstring_dup(filename) : NULL,
+        .line = line,
+        .col = col
+    };
+
+    program->origins = fl_array_append(program->origins, &origin);
+
+    return (uint16_t) count;
+}
+
 char* rp2a03_program_disassemble(Rp2a03Program *program)
 {
     char *output = fl_cstring_dup("; RP2A03 PROGRAM DISASSEMBLY\n");
     output = rp2a03_data_segment_disassemble(program->data, true, output);
+
+    for (size_t i=0; i < ZNES_BANK_COUNT; i++)
+    {
+        if (program->banks[i] == NULL)
+            continue;
+
+        fl_cstring_vappend(&output, "; Bank %zu\n", i);
+        output = rp2a03_data_segment_disassemble(program->banks[i], false, output);
+    }
+
+    if (program->chr != NULL)
+    {
+        fl_cstring_append(&output, "; CHR-ROM\n");
+        output = rp2a03_data_segment_disassemble(program->chr, false, output);
+    }
+
     output = rp2a03_text_segment_disassemble(program->startup, "STARTUP segment", output);
     output = rp2a03_text_segment_disassemble(program->code, "CODE segment", output);
 
+    for (size_t i=0; i < fl_array_length(program->blobs); i++)
+        output = rp2a03_text_segment_disassemble(program->blobs[i], "TEXT blob", output);
+
     return output;
 }
 
@@ -53,171 +218,60 @@ uint8_t rp2a03_program_calc_rel_addr(Rp2a03TextSegment *code, uint16_t address)
 */
 void rp2a03_program_emit_abs(Rp2a03Program *program, Rp2a03TextSegment *code, Rp2a03Mnemonic opcode, uint16_t bytes)
 {
-    if (code->pc == UINT16_MAX)
-    {
-        // FIXME: Handle overflow
-        return;
-    }
-
-    // We lookup the actual hex code
-    uint8_t opcode_hex = rp2a03_opcode_lookup(opcode, NES_ADDR_ABS);
-    code->bytes[code->pc++] = opcode_hex;
-    code->bytes[code->pc++] = (uint8_t)(bytes);
-    code->bytes[code->pc++] = (uint8_t)(bytes >> 8);    
+    rp2a03_text_segment_emit(code, opcode, NES_ADDR_ABS, bytes);
 }
 
 void rp2a03_program_emit_abx(Rp2a03Program *program, Rp2a03TextSegment *code, Rp2a03Mnemonic opcode, uint16_t bytes)
 {
-    if (code->pc == UINT16_MAX)
-    {
-        // FIXME: Handle overflow
-        return;
-    }
-
-    // We lookup the actual hex code
-    uint8_t opcode_hex = rp2a03_opcode_lookup(opcode, NES_ADDR_ABX);
-    code->bytes[code->pc++] = opcode_hex;
-    code->bytes[code->pc++] = (uint8_t)(bytes);
-    code->bytes[code->pc++] = (uint8_t)(bytes >> 8);
+    rp2a03_text_segment_emit(code, opcode, NES_ADDR_ABX, bytes);
 }
 
 void rp2a03_program_emit_aby(Rp2a03Program *program, Rp2a03TextSegment *code, Rp2a03Mnemonic opcode, uint16_t bytes)
 {
-    if (code->pc == UINT16_MAX)
-    {
-        // FIXME: Handle overflow
-        return;
-    }
-
-    // We lookup the actual hex code
-    uint8_t opcode_hex = rp2a03_opcode_lookup(opcode, NES_ADDR_ABY);
-    code->bytes[code->pc++] = opcode_hex;
-    code->bytes[code->pc++] = (uint8_t)(bytes);
-    code->bytes[code->pc++] = (uint8_t)(bytes >> 8);
+    rp2a03_text_segment_emit(code, opcode, NES_ADDR_ABY, bytes);
 }
 
 void rp2a03_program_emit_imm(Rp2a03Program *program, Rp2a03TextSegment *code, Rp2a03Mnemonic opcode, uint8_t byte)
 {
-    if (code->pc == UINT16_MAX)
-    {
-        // FIXME: Handle overflow
-        return;
-    }
-
-    // We lookup the actual hex code
-    uint8_t opcode_hex = rp2a03_opcode_lookup(opcode, NES_ADDR_IMM);
-    code->bytes[code->pc++] = opcode_hex;
-    code->bytes[code->pc++] = byte;
+    rp2a03_text_segment_emit(code, opcode, NES_ADDR_IMM, byte);
 }
 
 void rp2a03_program_emit_imp(Rp2a03Program *program, Rp2a03TextSegment *code, Rp2a03Mnemonic opcode)
 {
-    if (code->pc == UINT16_MAX)
-    {
-        // FIXME: Handle overflow
-        return;
-    }
-
-    // We lookup the actual hex code
-    uint8_t opcode_hex = rp2a03_opcode_lookup(opcode, NES_ADDR_IMP);
-    code->bytes[code->pc++] = opcode_hex;
+    rp2a03_text_segment_emit(code, opcode, NES_ADDR_IMP, 0);
 }
 
 void rp2a03_program_emit_ind(Rp2a03Program *program, Rp2a03TextSegment *code, Rp2a03Mnemonic opcode, uint16_t bytes)
 {
-    if (code->pc == UINT16_MAX)
-    {
-        // FIXME: Handle overflow
-        return;
-    }
-
-    // We lookup the actual hex code
-    uint8_t opcode_hex = rp2a03_opcode_lookup(opcode, NES_ADDR_IND);
-    code->bytes[code->pc++] = opcode_hex;
-    code->bytes[code->pc++] = (uint8_t)(bytes);
-    code->bytes[code->pc++] = (uint8_t)(bytes >> 8);
+    rp2a03_text_segment_emit(code, opcode, NES_ADDR_IND, bytes);
 }
 
 void rp2a03_program_emit_inx(Rp2a03Program *program, Rp2a03TextSegment *code, Rp2a03Mnemonic opcode, uint8_t byte)
 {
-    if (code->pc == UINT16_MAX)
-    {
-        // FIXME: Handle overflow
-        return;
-    }
-
-    // We lookup the actual hex code
-    uint8_t opcode_hex = rp2a03_opcode_lookup(opcode, NES_ADDR_INX);
-    code->bytes[code->pc++] = opcode_hex;
-    code->bytes[code->pc++] = byte;
+    rp2a03_text_segment_emit(code, opcode, NES_ADDR_INX, byte);
 }
 
 void rp2a03_program_emit_iny(Rp2a03Program *program, Rp2a03TextSegment *code, Rp2a03Mnemonic opcode, uint8_t byte)
 {
-    if (code->pc == UINT16_MAX)
-    {
-        // FIXME: Handle overflow
-        return;
-    }
-
-    // We lookup the actual hex code
-    uint8_t opcode_hex = rp2a03_opcode_lookup(opcode, NES_ADDR_INY);
-    code->bytes[code->pc++] = opcode_hex;
-    code->bytes[code->pc++] = byte;
+    rp2a03_text_segment_emit(code, opcode, NES_ADDR_INY, byte);
 }
 
 void rp2a03_program_emit_rel(Rp2a03Program *program, Rp2a03TextSegment *code, Rp2a03Mnemonic opcode, uint8_t byte)
 {
-    if (code->pc == UINT16_MAX)
-    {
-        // FIXME: Handle overflow
-        return;
-    }
-
-    // We lookup the actual hex code
-    uint8_t opcode_hex = rp2a03_opcode_lookup(opcode, NES_ADDR_REL);
-    code->bytes[code->pc++] = opcode_hex;
-    code->bytes[code->pc++] = byte;
+    rp2a03_text_segment_emit(code, opcode, NES_ADDR_REL, byte);
 }
 
 void rp2a03_program_emit_zpg(Rp2a03Program *program, Rp2a03TextSegment *code, Rp2a03Mnemonic opcode, uint8_t byte)
 {
-    if (code->pc == UINT16_MAX)
-    {
-        // FIXME: Handle overflow
-        return;
-    }
-
-    // We lookup the actual hex code
-    uint8_t opcode_hex = rp2a03_opcode_lookup(opcode, NES_ADDR_ZPG);
-    code->bytes[code->pc++] = opcode_hex;
-    code->bytes[code->pc++] = byte;
+    rp2a03_text_segment_emit(code, opcode, NES_ADDR_ZPG, byte);
 }
 
 void rp2a03_program_emit_zpx(Rp2a03Program *program, Rp2a03TextSegment *code, Rp2a03Mnemonic opcode, uint8_t byte)
 {
-    if (code->pc == UINT16_MAX)
-    {
-        // FIXME: Handle overflow
-        return;
-    }
-
-    // We lookup the actual hex code
-    uint8_t opcode_hex = rp2a03_opcode_lookup(opcode, NES_ADDR_ZPX);
-    code->bytes[code->pc++] = opcode_hex;
-    code->bytes[code->pc++] = byte;
+    rp2a03_text_segment_emit(code, opcode, NES_ADDR_ZPX, byte);
 }
 
 void rp2a03_program_emit_zpy(Rp2a03Program *program, Rp2a03TextSegment *code, Rp2a03Mnemonic opcode, uint8_t byte)
 {
-    if (code->pc == UINT16_MAX)
-    {
-        // FIXME: Handle overflow
-        return;
-    }
-
-    // We lookup the actual hex code
-    uint8_t opcode_hex = rp2a03_opcode_lookup(opcode, NES_ADDR_ZPY);
-    code->bytes[code->pc++] = opcode_hex;
-    code->bytes[code->pc++] = byte;
+    rp2a03_text_segment_emit(code, opcode, NES_ADDR_ZPY, byte);
 }
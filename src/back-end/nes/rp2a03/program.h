@@ -5,16 +5,40 @@
 #include <stdbool.h>
 #include "segment-data.h"
 #include "segment-text.h"
+#include "prg-map.h"
+#include "peephole.h"
 #include "mnemonic.h"
+#include "../nes.h"
+#include "../ir/objects/alloc.h"
+
+typedef struct Rp2a03Origin {
+    char *declaration;
+    char *filename;
+    unsigned int line;
+    unsigned int col;
+} Rp2a03Origin;
 
 typedef struct Rp2a03Program {
     Rp2a03DataSegment *data;
+    Rp2a03DataSegment *banks[ZNES_BANK_COUNT];
+    Rp2a03DataSegment *chr;
+    ZnesMapper mapper;
+    uint16_t bank_init;
+    uint16_t bank_select;
     Rp2a03TextSegment *startup;
     Rp2a03TextSegment *code;
+    Rp2a03TextSegment **blobs;
+    Rp2a03PrgMap *prg;
+    Rp2a03PeepholeStats peephole;
+    Rp2a03Origin *origins;
 } Rp2a03Program;
 
 Rp2a03Program* rp2a03_program_new(size_t data_base_address, size_t startup_base_address, size_t code_base_address);
 void rp2a03_program_free(Rp2a03Program *program);
+Rp2a03DataSegment* rp2a03_program_data_segment(Rp2a03Program *program, uint8_t bank);
+Rp2a03DataSegment* rp2a03_program_alloc_segment(Rp2a03Program *program, ZnesAlloc *alloc);
+Rp2a03TextSegment* rp2a03_program_add_blob(Rp2a03Program *program);
+uint16_t rp2a03_program_add_origin(Rp2a03Program *program, const char *declaration, const char *filename, unsigned int line, unsigned int col);
 char* rp2a03_program_disassemble(Rp2a03Program *program);
 void rp2a03_program_emit_abs(Rp2a03Program *program, Rp2a03TextSegment *segment, Rp2a03Mnemonic mnemonic, uint16_t bytes);
 void rp2a03_program_emit_abx(Rp2a03Program *program, Rp2a03TextSegment *segment, Rp2a03Mnemonic mnemonic, uint16_t bytes);
@@ -1,26 +1,80 @@
 
 #include <fllib/IO.h>
+#include <fllib/Array.h>
 #include "rom.h"
+#include "link.h"
+#include "mapper.h"
 
-Rp2a03Rom* rp2a03_rom_new(Rp2a03Program *program)
+/*
+ * Function: layout_prg_banks
+ *  The PRG-ROM is written in the smallest layout that holds the program. NROM-128 boards have a single
+ *  16KB bank that the CPU sees at $8000 and mirrored at $C000, so if the used bytes of the two halves
+ *  of the address space do not overlap once mirrored, they are merged into one bank (the vectors live
+ *  at the end of the upper half). Otherwise, the PRG-ROM uses the two banks of an NROM-256 board.
+ */
+static uint8_t* layout_prg_banks(Rp2a03Program *program, Rp2a03Nrom256 *prg_rom)
+{
+    const uint8_t *image = (const uint8_t*) prg_rom;
+    uint8_t *used = rp2a03_link_prg_usage(program);
+
+    bool mirrored = true;
+    for (size_t i=0; i < RP2A03_PRG_BANK_SIZE && mirrored; i++)
+        mirrored = !used[i] || !used[i + RP2A03_PRG_BANK_SIZE];
+
+    uint8_t *banks = NULL;
+
+    if (mirrored)
+    {
+        banks = fl_array_new(sizeof(uint8_t), RP2A03_PRG_BANK_SIZE);
+
+        for (size_t i=0; i < RP2A03_PRG_BANK_SIZE; i++)
+            banks[i] = used[i] ? image[i] : image[i + RP2A03_PRG_BANK_SIZE];
+    }
+    else
+    {
+        banks = fl_array_new(sizeof(uint8_t), sizeof(Rp2a03Nrom256));
+        memcpy(banks, image, sizeof(Rp2a03Nrom256));
+    }
+
+    fl_array_free(used);
+
+    return banks;
+}
+
+/*
+ * Function: layout_mapper_banks
+ *  With a mapper, the PRG-ROM is the default bank (the CPU view of $8000-$BFFF), the switchable banks, and the
+ *  fixed bank (the CPU view of $C000-$FFFF) as the last one. The banks the program does not use are filled
+ *  with zeros.
+ */
+static uint8_t* layout_mapper_banks(Rp2a03Program *program, Rp2a03Nrom256 *prg_rom)
 {
-    //size_t data_size = fl_array_length(program->data->bytes);
-    //size_t startup_size = fl_array_length(program->startup->bytes);
-    //size_t code_size = fl_array_length(program->code.bytes);
-    //size_t total_size = data_size + startup_size + code_size;
-//
-    //// wrap
-    //if (total_size < data_size || total_size < startup_size || total_size < code_size)
-    //    return NULL;
-//
-    //if (total_size > sizeof(Rp2a03Nrom256))
-    //    return NULL;    
+    const uint8_t *image = (const uint8_t*) prg_rom;
+    size_t count = rp2a03_mapper_bank_count(program);
+
+    uint8_t *banks = fl_array_new(sizeof(uint8_t), count * RP2A03_PRG_BANK_SIZE);
+    memset(banks, 0, count * RP2A03_PRG_BANK_SIZE);
+
+    memcpy(banks, image, RP2A03_PRG_BANK_SIZE);
 
+    for (size_t i=1; i < count - 1; i++)
+    {
+        if (program->banks[i] != NULL)
+            memcpy(banks + i * RP2A03_PRG_BANK_SIZE, program->banks[i]->bytes, RP2A03_PRG_BANK_SIZE);
+    }
+
+    memcpy(banks + (count - 1) * RP2A03_PRG_BANK_SIZE, image + RP2A03_PRG_BANK_SIZE, RP2A03_PRG_BANK_SIZE);
+
+    return banks;
+}
+
+Rp2a03Rom* rp2a03_rom_new(Rp2a03Program *program)
+{
     Rp2a03Rom default_rom = {
         .header = {
             .magic = { 0x4E, 0x45, 0x53, 0x1A },
-            .prg_rom = 2,
-            .chr_rom = 1,
+            .prg_rom = 0,
+            .chr_rom = 0,
             .flag6 = 0,
             .flag7 = 0,
             .flag8 = 0,
@@ -33,46 +87,35 @@ Rp2a03Rom* rp2a03_rom_new(Rp2a03Program *program)
             .nmi_addr = 0,
             .res_addr = 0,
             .irq_addr = 0,
-        }
+        },
+        .prg_banks = NULL,
+        .chr_banks = NULL
     };
 
     // First we copy the data segment that actually uses the whole PRG-ROM (on purpose)
     memcpy(&default_rom.prg_rom, program->data->bytes, sizeof(Rp2a03Nrom256));
 
-    // We need to copy the startup routine, we need to find the space for it
-    if (program->startup->pc > 0)
+    // The linker copies the text segments to the places reserved for them, chains the reset sequence, and
+    // validates the interrupt vectors
+    if (!rp2a03_link_patch(program, &default_rom.prg_rom))
+        return NULL;
+
+    // The header describes the PRG-ROM that is actually written and the board
+    default_rom.prg_banks = program->mapper == ZNES_MAPPER_NROM
+                                ? layout_prg_banks(program, &default_rom.prg_rom)
+                                : layout_mapper_banks(program, &default_rom.prg_rom);
+    default_rom.header.prg_rom = (uint8_t) (fl_array_length(default_rom.prg_banks) / RP2A03_PRG_BANK_SIZE);
+    default_rom.header.flag6.flags.mapper_low = program->mapper & 0x0F;
+    default_rom.header.flag7.flags.mapper_hi = (program->mapper >> 4) & 0x0F;
+
+    // The CHR-ROM follows the PRG-ROM. Without it, the header declares 0 banks and the board uses CHR-RAM
+    if (program->chr != NULL)
     {
-        // The startup routine will replace the original RESET vector, so we need to add a JMP at the end
-        rp2a03_program_emit_abs(program, program->startup, NES_OP_JMP, default_rom.prg_rom.res_addr);
-
-        size_t i=0;
-        size_t bank_length = sizeof(default_rom.prg_rom.bank) / sizeof(default_rom.prg_rom.bank[0]);
-        for (; i + program->startup->pc < bank_length; i++)
-        {
-            if (default_rom.prg_rom.bank[i] != 0 || default_rom.prg_rom.bank[i + program->startup->pc] != 0)
-                continue;
-
-            size_t j=i;
-            for (; j < program->startup->pc + i; j++)
-            {
-                if (default_rom.prg_rom.bank[j] != 0)
-                    break;
-            }
-
-            if (j == program->startup->pc + i)
-            {
-                memcpy(default_rom.prg_rom.bank + i, program->startup->bytes, program->startup->pc);
-                default_rom.prg_rom.res_addr = program->data->base_address + i;
-                break;
-            }
-        }
-
-        if (i == bank_length - 1)
-            return NULL;
+        default_rom.chr_banks = fl_array_new(sizeof(uint8_t), RP2A03_CHR_BANK_SIZE);
+        memcpy(default_rom.chr_banks, program->chr->bytes, RP2A03_CHR_BANK_SIZE);
+        default_rom.header.chr_rom = 1;
     }
 
-    // FIXME: Copy the code segment
-
     Rp2a03Rom *rom = fl_malloc(sizeof(Rp2a03Rom));
     memcpy(rom, &default_rom, sizeof(Rp2a03Rom));
 
@@ -84,6 +127,12 @@ void rp2a03_rom_free(Rp2a03Rom *rom)
     if (!rom)
         return;
 
+    if (rom->prg_banks)
+        fl_array_free(rom->prg_banks);
+
+    if (rom->chr_banks)
+        fl_array_free(rom->chr_banks);
+
     fl_free(rom);
 }
 
@@ -91,6 +140,9 @@ void rp2a03_rom_dump(Rp2a03Rom *rom, const char *filename)
 {
     FILE *file = fl_io_file_open(filename, "w+b");
     fl_io_file_write_bytes(file, sizeof(Rp2a03RomHeader), (const FlByte*)&rom->header);
-    fl_io_file_write_bytes(file, sizeof(Rp2a03Nrom256), (const FlByte*)&rom->prg_rom);
+    fl_io_file_write_bytes(file, fl_array_length(rom->prg_banks), (const FlByte*)rom->prg_banks);
+
+    if (rom->chr_banks)
+        fl_io_file_write_bytes(file, fl_array_length(rom->chr_banks), (const FlByte*)rom->chr_banks);
     fl_io_file_close(file);
 }
@@ -5,13 +5,8 @@
 #include "header.h"
 #include "program.h"
 
-typedef struct Rp2a03Nrom128 {
-    uint8_t bank0[0x4000];
-    uint8_t bank1[0x3FFA];
-    uint16_t nmi_addr;
-    uint16_t res_addr;
-    uint16_t irq_addr;
-} Rp2a03Nrom128;
+#define RP2A03_PRG_BANK_SIZE 0x4000
+#define RP2A03_CHR_BANK_SIZE 0x2000
 
 typedef struct Rp2a03Nrom256 {
     uint8_t bank[0x7FFA];
@@ -23,6 +18,8 @@ typedef struct Rp2a03Nrom256 {
 typedef struct Rp2a03Rom {
     Rp2a03RomHeader header;
     Rp2a03Nrom256 prg_rom;
+    uint8_t *prg_banks;
+    uint8_t *chr_banks;
 } Rp2a03Rom;
 
 Rp2a03Rom* rp2a03_rom_new(Rp2a03Program *program);
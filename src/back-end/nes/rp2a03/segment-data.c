@@ -23,6 +23,60 @@ void rp2a03_data_segment_free(Rp2a03DataSegment *data)
     fl_free(data);
 }
 
+/*
+ * Function: rp2a03_data_segment_reserve
+ *  Finds the first range of *size* free slots in the DATA segment, marks it as used, and copies
+ *  the *bytes* into it. The absolute address of the range is stored in the *address* pointer.
+ *  It returns *false* if there is no free range big enough to hold the bytes.
+ */
+bool rp2a03_data_segment_reserve(Rp2a03DataSegment *data, const uint8_t *bytes, size_t size, uint16_t *address)
+{
+    return rp2a03_data_segment_reserve_from(data, data->base_address, bytes, size, address);
+}
+
+/*
+ * Function: rp2a03_data_segment_reserve_from
+ *  Same as <rp2a03_data_segment_reserve>, but the range must start at or after *from_address* (e.g.
+ *  the routines that must live in the fixed PRG-ROM bank)
+ */
+bool rp2a03_data_segment_reserve_from(Rp2a03DataSegment *data, uint16_t from_address, const uint8_t *bytes, size_t size, uint16_t *address)
+{
+    size_t length = fl_array_length(data->slots);
+    size_t start = from_address > data->base_address ? (size_t) (from_address - data->base_address) : 0;
+
+    for (size_t i=start; i < length; i++)
+    {
+        if (data->slots[i] != 0)
+        {
+            start = i + 1;
+            continue;
+        }
+
+        if (i + 1 - start < size)
+            continue;
+
+        memcpy(data->bytes + start, bytes, size);
+        memset(data->slots + start, 1, size);
+        *address = data->base_address + start;
+
+        return true;
+    }
+
+    return false;
+}
+
+/*
+ * Function: rp2a03_data_segment_release
+ *  Frees a range reserved with <rp2a03_data_segment_reserve> and clears its bytes
+ */
+void rp2a03_data_segment_release(Rp2a03DataSegment *data, uint16_t address, size_t size)
+{
+    size_t start = (size_t) (address - data->base_address);
+
+    memset(data->bytes + start, 0, size);
+    memset(data->slots + start, 0, size);
+}
+
 char* rp2a03_data_segment_disassemble(Rp2a03DataSegment *data, bool as_code, char *output)
 {
     size_t size = 0;
@@ -94,7 +148,7 @@ char* rp2a03_data_segment_disassemble(Rp2a03DataSegment *data, bool as_code, cha
                 skipped = false;
             }
 
-            Rp2a03Instruction *instr = rp2a03_instruction_lookup(data->bytes[pc]);
+            const Rp2a03Instruction *instr = rp2a03_instruction_lookup(data->bytes[pc]);
 
             fl_cstring_vappend(&output, "%04zX: %s", data->base_address + pc, "    ");
 
@@ -3,6 +3,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 typedef struct Rp2a03DataSegment {
     uint8_t *bytes;
@@ -13,5 +14,8 @@ typedef struct Rp2a03DataSegment {
 Rp2a03DataSegment* rp2a03_data_segment_new(uint16_t base_address, size_t size);
 void rp2a03_data_segment_free(Rp2a03DataSegment *data);
 char* rp2a03_data_segment_disassemble(Rp2a03DataSegment *data, bool as_code, char *output);
+bool rp2a03_data_segment_reserve(Rp2a03DataSegment *data, const uint8_t *bytes, size_t size, uint16_t *address);
+bool rp2a03_data_segment_reserve_from(Rp2a03DataSegment *data, uint16_t from_address, const uint8_t *bytes, size_t size, uint16_t *address);
+void rp2a03_data_segment_release(Rp2a03DataSegment *data, uint16_t address, size_t size);
 
 #endif /* RP2A03_DATA_SEGMENT_H */
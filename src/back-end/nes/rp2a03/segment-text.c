@@ -3,6 +3,7 @@
 #include <fllib/Cstring.h>
 #include "segment-text.h"
 #include "instruction.h"
+#include "mnemonic.h"
 
 void allocate_pending_jump(FlByte **dest, const FlByte *src)
 {
@@ -10,12 +11,32 @@ void allocate_pending_jump(FlByte **dest, const FlByte *src)
     memcpy(*dest, src, sizeof(Rp2a03PendingJump));
 }
 
+static const Rp2a03Mnemonic load_mnemonics[RP2A03_REG_COUNT] = { NES_OP_LDA, NES_OP_LDX, NES_OP_LDY };
+static const Rp2a03Mnemonic store_mnemonics[RP2A03_REG_COUNT] = { NES_OP_STA, NES_OP_STX, NES_OP_STY };
+
+static void reset_registers(Rp2a03RegisterState *state)
+{
+    for (size_t i=0; i < RP2A03_REG_COUNT; i++)
+    {
+        state->value[i] = -1;
+        state->pending[i] = -1;
+        state->pending_origin[i] = 0;
+    }
+
+    state->flags = -1;
+    state->flags_register = -1;
+}
+
 Rp2a03TextSegment* rp2a03_text_segment_new(size_t base_address)
 {
     Rp2a03TextSegment *text = fl_malloc(sizeof(Rp2a03TextSegment));
 
     text->pc = 0;
+    text->pending_stores = fl_array_new(sizeof(Rp2a03PendingStore), 0);
+    reset_registers(&text->registers);
     text->bytes = fl_array_new(sizeof(uint8_t), UINT16_MAX);
+    text->origins = fl_array_new(sizeof(uint16_t), UINT16_MAX);
+    text->origin = 0;
     text->base_address = base_address;
     text->pending_jumps = fl_list_new_args((struct FlListArgs) { .value_allocator = allocate_pending_jump, .value_cleaner = fl_container_cleaner_pointer });
 
@@ -25,54 +46,416 @@ Rp2a03TextSegment* rp2a03_text_segment_new(size_t base_address)
 void rp2a03_text_segment_free(Rp2a03TextSegment *text)
 {
     fl_array_free(text->bytes);
+    fl_array_free(text->origins);
+    fl_array_free(text->pending_stores);
     if (text->pending_jumps) fl_list_free(text->pending_jumps);
     fl_free(text);
 }
 
+static void emit_bytes(Rp2a03TextSegment *text, Rp2a03Mnemonic mnemonic, Rp2a03AddressMode mode, uint16_t operand)
+{
+    if (text->pc == UINT16_MAX)
+    {
+        // FIXME: Handle overflow
+        return;
+    }
+
+    uint16_t start = text->pc;
+
+    // We lookup the actual hex code
+    text->bytes[text->pc++] = rp2a03_opcode_lookup(mnemonic, mode);
+
+    switch (mode)
+    {
+        case NES_ADDR_IMP:
+            break;
+
+        case NES_ADDR_ABS:
+        case NES_ADDR_ABX:
+        case NES_ADDR_ABY:
+        case NES_ADDR_IND:
+            text->bytes[text->pc++] = (uint8_t)(operand);
+            text->bytes[text->pc++] = (uint8_t)(operand >> 8);
+            break;
+
+        default:
+            text->bytes[text->pc++] = (uint8_t)(operand);
+            break;
+    }
+
+    for (uint16_t i=start; i < text->pc; i++)
+        text->origins[i] = text->origin;
+}
+
+static int register_of(const Rp2a03Mnemonic *mnemonics, Rp2a03Mnemonic mnemonic)
+{
+    for (int i=0; i < RP2A03_REG_COUNT; i++)
+        if (mnemonics[i] == mnemonic)
+            return i;
+
+    return -1;
+}
+
+/*
+ * Function: same_flags
+ *  Loading two values leaves the same N and Z flags if both are zero or non-zero and have the same
+ *  sign bit
+ */
+static inline bool same_flags(int16_t a, int16_t b)
+{
+    return a >= 0 && b >= 0 && (a == 0) == (b == 0) && (a & 0x80) == (b & 0x80);
+}
+
+/*
+ * Function: clobber_registers
+ *  Updates the state of the registers after an instruction that is not tracked: the registers it
+ *  writes are unknown, and so are the flags if the instruction sets them
+ */
+static void clobber_registers(Rp2a03RegisterState *state, Rp2a03Mnemonic mnemonic, Rp2a03AddressMode mode)
+{
+    for (size_t i=0; i < RP2A03_REG_COUNT; i++)
+        if (rp2a03_mnemonic_writes_register(mnemonic, mode, (Rp2a03Register) i))
+            state->value[i] = -1;
+
+    if (rp2a03_mnemonic_sets_nz_flags(mnemonic) || mnemonic == NES_OP_JSR)
+        state->flags = -1;
+}
+
+static void emit_load(Rp2a03TextSegment *text, Rp2a03Register reg, uint8_t value)
+{
+    emit_bytes(text, load_mnemonics[reg], NES_ADDR_IMM, value);
+    text->registers.value[reg] = value;
+    text->registers.flags = value;
+}
+
+/*
+ * Function: flush_pending
+ *  Emits the stores and the immediate loads that are waiting in the segment. The stores are grouped
+ *  by value, so each value is loaded once, in the register that already contains it if there is one,
+ *  or in the register of the first store of the group. The groups whose value must end up in a register
+ *  are emitted last so that the register does not need to be loaded again. If *load_registers* is
+ *  *true*, the registers with pending loads are loaded, and if the next instruction does not set the N
+ *  and Z flags itself, the flags are restored to the ones of the last pending load (the branch after a
+ *  *LDA #imm* depends on them).
+ *  The emitted instructions keep the origin of the load or the store they come from, a load shared by a
+ *  group of stores takes the origin of the first one.
+ */
+static void flush_pending(Rp2a03TextSegment *text, bool load_registers, bool needs_flags)
+{
+    Rp2a03RegisterState *state = &text->registers;
+    uint16_t current_origin = text->origin;
+
+    // The values the registers must contain once the pending instructions are emitted
+    int16_t expected[RP2A03_REG_COUNT];
+    for (size_t i=0; i < RP2A03_REG_COUNT; i++)
+        expected[i] = state->pending[i] >= 0 ? state->pending[i] : state->value[i];
+
+    size_t store_count = fl_array_length(text->pending_stores);
+
+    if (store_count > 0)
+    {
+        bool *emitted = fl_malloc(sizeof(bool) * store_count);
+        memset(emitted, 0, sizeof(bool) * store_count);
+
+        for (int last_groups=0; last_groups < 2; last_groups++)
+        {
+            for (size_t i=0; i < store_count; i++)
+            {
+                Rp2a03PendingStore *store = text->pending_stores + i;
+
+                bool is_expected = false;
+                for (size_t j=0; j < RP2A03_REG_COUNT; j++)
+                    is_expected = is_expected || expected[j] == store->value;
+
+                if (emitted[i] || is_expected != (last_groups == 1))
+                    continue;
+
+                // The register of the store is always free to use: its last load was an immediate one
+                Rp2a03Register reg = store->reg;
+                for (size_t j=0; j < RP2A03_REG_COUNT; j++)
+                {
+                    if (state->value[j] == store->value)
+                    {
+                        reg = (Rp2a03Register) j;
+                        break;
+                    }
+                }
+
+                text->origin = store->origin;
+                if (state->value[reg] != store->value)
+                    emit_load(text, reg, store->value);
+
+                for (size_t j=i; j < store_count; j++)
+                {
+                    if (emitted[j] || text->pending_stores[j].value != store->value)
+                        continue;
+
+                    text->origin = text->pending_stores[j].origin;
+                    emit_bytes(text, store_mnemonics[reg], text->pending_stores[j].mode, text->pending_stores[j].address);
+                    emitted[j] = true;
+                }
+            }
+        }
+
+        fl_free(emitted);
+        text->pending_stores = fl_array_resize(text->pending_stores, 0);
+    }
+
+    // The register that holds the flags is loaded last
+    for (int i=0; i <= RP2A03_REG_COUNT && load_registers; i++)
+    {
+        int reg = i < RP2A03_REG_COUNT ? i : state->flags_register;
+
+        if (reg < 0 || (i < RP2A03_REG_COUNT && i == state->flags_register))
+            continue;
+
+        if (expected[reg] >= 0 && state->value[reg] != expected[reg])
+        {
+            text->origin = state->pending_origin[reg];
+            emit_load(text, (Rp2a03Register) reg, (uint8_t) expected[reg]);
+        }
+    }
+
+    if (load_registers && needs_flags && state->flags_register >= 0 && !same_flags(state->flags, expected[state->flags_register]))
+    {
+        text->origin = state->pending_origin[state->flags_register];
+        emit_load(text, (Rp2a03Register) state->flags_register, (uint8_t) expected[state->flags_register]);
+    }
+
+    text->origin = current_origin;
+
+    for (size_t i=0; i < RP2A03_REG_COUNT; i++)
+        state->pending[i] = -1;
+
+    state->flags_register = -1;
+}
+
+/*
+ * Function: rp2a03_text_segment_emit
+ *  Emits an instruction in the text segment, keeping track of the known contents of the A, X, and Y registers
+ *  and the N and Z flags. The immediate loads and the stores of known values to RAM are not emitted right away:
+ *  the loads of values that are already in the register are dropped, and the stores are kept until another
+ *  instruction needs them, so that the stores of the same value share a load (see <flush_pending>). A
+ *  store to an address that is stored again before being read is dropped. The stores to the I/O registers
+ *  have side effects, they are never reordered.
+ *
+ *  The state is valid while the code runs straight, branch targets must call <rp2a03_text_segment_label>,
+ *  and the code that needs the *pc* of the segment must call <rp2a03_text_segment_flush> first.
+ */
+void rp2a03_text_segment_emit(Rp2a03TextSegment *text, Rp2a03Mnemonic mnemonic, Rp2a03AddressMode mode, uint16_t operand)
+{
+    Rp2a03RegisterState *state = &text->registers;
+
+    int reg = register_of(load_mnemonics, mnemonic);
+    if (reg >= 0 && mode == NES_ADDR_IMM)
+    {
+        state->pending[reg] = (uint8_t) operand;
+        state->pending_origin[reg] = text->origin;
+        state->flags_register = reg;
+        return;
+    }
+
+    reg = register_of(store_mnemonics, mnemonic);
+    if (reg >= 0 && (mode == NES_ADDR_ZPG || mode == NES_ADDR_ABS) && !RP2A03_IS_IO_REGISTER(operand))
+    {
+        int16_t value = state->pending[reg] >= 0 ? state->pending[reg] : state->value[reg];
+
+        if (value >= 0)
+        {
+            size_t store_count = fl_array_length(text->pending_stores);
+            size_t kept = 0;
+
+            // The previous store to the same address is dead
+            for (size_t i=0; i < store_count; i++)
+                if (text->pending_stores[i].address != operand)
+                    text->pending_stores[kept++] = text->pending_stores[i];
+
+            if (kept != store_count)
+                text->pending_stores = fl_array_resize(text->pending_stores, kept);
+
+            Rp2a03PendingStore store = { .address = operand, .value = (uint8_t) value, .reg = (Rp2a03Register) reg, .mode = mode, .origin = text->origin };
+            text->pending_stores = fl_array_append(text->pending_stores, &store);
+            return;
+        }
+    }
+
+    flush_pending(text, true, !rp2a03_mnemonic_sets_nz_flags(mnemonic));
+    emit_bytes(text, mnemonic, mode, operand);
+    clobber_registers(state, mnemonic, mode);
+}
+
+/*
+ * Function: rp2a03_text_segment_flush
+ *  Emits the pending loads and stores, the known state of the registers is kept
+ */
+void rp2a03_text_segment_flush(Rp2a03TextSegment *text)
+{
+    flush_pending(text, true, true);
+}
+
+/*
+ * Function: rp2a03_text_segment_label
+ *  Marks the current *pc* as a branch target (or the end of the segment): the pending stores are emitted,
+ *  and the state of the registers is unknown from here on, because the code can be reached from other
+ *  places. The emitters do not keep values in the registers between ZNES instructions, so the pending
+ *  loads are dropped.
+ */
+void rp2a03_text_segment_label(Rp2a03TextSegment *text)
+{
+    flush_pending(text, false, false);
+    reset_registers(&text->registers);
+}
+
 void rp2a03_text_segment_add_pending_jump(Rp2a03TextSegment *text, Rp2a03PendingJump *pending_jump)
 {
     fl_list_append(text->pending_jumps, pending_jump);
 }
 
+/*
+ * Function: rp2a03_text_segment_backpatch_jumps
+ *  Decrements the IR offset of every pending jump, and once a jump reaches its target instruction, it
+ *  keeps the target PC. Relative branches are written by <rp2a03_text_segment_relax_branches> and absolute
+ *  jumps by <rp2a03_text_segment_backpatch_absolute_jumps>, once the segment is complete.
+ */
 void rp2a03_text_segment_backpatch_jumps(Rp2a03TextSegment *text)
 {
     Rp2a03PendingJumpListNode *node = fl_list_head(text->pending_jumps);
 
-    Rp2a03PendingJumpListNode *remove = NULL;
+    // If a jump reaches its target, the pending instructions go before it
+    while (node)
+    {
+        if (((Rp2a03PendingJump*) node->value)->ir_offset == 1)
+        {
+            rp2a03_text_segment_label(text);
+            break;
+        }
+
+        node = node->next;
+    }
+
+    node = fl_list_head(text->pending_jumps);
+
     while (node)
     {
         Rp2a03PendingJump *pending_jump = (Rp2a03PendingJump*) node->value;
 
+        // Jumps that already reached their target wait for the end of the segment
         if (pending_jump->ir_offset > 0)
+        {
             pending_jump->ir_offset--;
 
-        if (pending_jump->ir_offset == 0)
+            if (pending_jump->ir_offset == 0)
+                pending_jump->target_pc = text->pc;
+        }
+
+        node = node->next;
+    }
+}
+
+/*
+ * Function: relax_branch
+ *  Replaces the relative branch with the inverted branch that skips an absolute JMP to the original target:
+ *      BEQ target      ->      BNE +3
+ *                              JMP target
+ *  The 3 bytes of the JMP are inserted after the branch, so every jump after it is moved.
+ */
+static void relax_branch(Rp2a03TextSegment *text, Rp2a03PendingJump *branch)
+{
+    uint16_t insert_at = branch->base_jump_pc;
+
+    memmove(text->bytes + insert_at + 3, text->bytes + insert_at, text->pc - insert_at);
+    memmove(text->origins + insert_at + 3, text->origins + insert_at, sizeof(uint16_t) * (text->pc - insert_at));
+    text->pc += 3;
+
+    // The JMP is part of the branch
+    for (uint16_t i=insert_at; i < insert_at + 3; i++)
+        text->origins[i] = text->origins[branch->byte_index - 1];
+
+    Rp2a03PendingJumpListNode *node = fl_list_head(text->pending_jumps);
+    while (node)
+    {
+        Rp2a03PendingJump *pending_jump = (Rp2a03PendingJump*) node->value;
+
+        if (pending_jump != branch)
         {
-            if (pending_jump->absolute)
-            {
-                // Absolute
-                // We don't have the base address yet, so we store the "base" offset
-                pending_jump->base_jump_pc = text->pc;
-            }
-            else
-            {
-                // Relative
-                uint8_t jump_offset = (uint8_t) ((text->pc - pending_jump->base_jump_pc) & 0xFF);
-                text->bytes[pending_jump->byte_index] = jump_offset;
-                // Relative nodes can be removed, they are not needed once they are backpatched
-                remove = node;
-            }
+            if (pending_jump->byte_index >= insert_at)
+                pending_jump->byte_index += 3;
 
+            if (pending_jump->base_jump_pc >= insert_at)
+                pending_jump->base_jump_pc += 3;
         }
 
+        if (pending_jump->ir_offset == 0 && pending_jump->target_pc >= insert_at)
+            pending_jump->target_pc += 3;
+
         node = node->next;
+    }
 
-        if (remove)
+    // The conditional branch opcodes come in pairs that only differ in the bit 5 (BEQ $F0 - BNE $D0, BCC $90 - BCS $B0, ...)
+    text->bytes[branch->byte_index - 1] ^= 0x20;
+    text->bytes[branch->byte_index] = 3;
+    text->bytes[insert_at] = rp2a03_opcode_lookup(NES_OP_JMP, NES_ADDR_ABS);
+
+    // The JMP is an absolute jump that needs the base address of the segment
+    branch->absolute = true;
+    branch->byte_index = insert_at + 1;
+}
+
+/*
+ * Function: rp2a03_text_segment_relax_branches
+ *  Every relative branch starts as a short branch. The branches whose targets are out of range (-128 to 127
+ *  bytes) are relaxed (see <relax_branch>). Relaxing a branch moves the code after it, so other branches can
+ *  go out of range, which is why the process is repeated until there are no changes. Once the branches are
+ *  stable, the relative offsets are written. If there is no room in the segment for the JMP of a relaxed
+ *  branch, the function returns *false* and the branches are not written.
+ */
+bool rp2a03_text_segment_relax_branches(Rp2a03TextSegment *text)
+{
+    bool changed = true;
+
+    while (changed)
+    {
+        changed = false;
+
+        Rp2a03PendingJumpListNode *node = fl_list_head(text->pending_jumps);
+        while (node)
         {
-            fl_list_remove(text->pending_jumps, remove);
-            remove = NULL;
+            Rp2a03PendingJump *pending_jump = (Rp2a03PendingJump*) node->value;
+            node = node->next;
+
+            if (pending_jump->absolute || pending_jump->ir_offset != 0)
+                continue;
+
+            int distance = (int) pending_jump->target_pc - (int) pending_jump->base_jump_pc;
+
+            if (distance >= -128 && distance <= 127)
+                continue;
+
+            if (text->pc > UINT16_MAX - 3)
+                return false;
+
+            relax_branch(text, pending_jump);
+            changed = true;
         }
     }
+
+    Rp2a03PendingJumpListNode *node = fl_list_head(text->pending_jumps);
+    while (node)
+    {
+        Rp2a03PendingJump *pending_jump = (Rp2a03PendingJump*) node->value;
+        Rp2a03PendingJumpListNode *current = node;
+        node = node->next;
+
+        if (pending_jump->absolute || pending_jump->ir_offset != 0)
+            continue;
+
+        text->bytes[pending_jump->byte_index] = (uint8_t) ((pending_jump->target_pc - pending_jump->base_jump_pc) & 0xFF);
+
+        // Relative nodes can be removed, they are not needed once they are backpatched
+        fl_list_remove(text->pending_jumps, current);
+    }
+
+    return true;
 }
 
 void rp2a03_text_segment_backpatch_absolute_jumps(Rp2a03TextSegment *text)
@@ -89,7 +472,7 @@ void rp2a03_text_segment_backpatch_absolute_jumps(Rp2a03TextSegment *text)
         if (pending_jump->absolute)
         {
             // Update the base address
-            uint16_t jump_dest = pending_jump->base_jump_pc + text->base_address;
+            uint16_t jump_dest = pending_jump->target_pc + text->base_address;
             text->bytes[pending_jump->byte_index] = (uint8_t) (jump_dest & 0xFF);
             text->bytes[pending_jump->byte_index + 1] = (uint8_t) ((jump_dest >> 8) & 0xFF);
         }
@@ -110,7 +493,7 @@ char* rp2a03_text_segment_disassemble(Rp2a03TextSegment *text, char *title, char
     fl_cstring_vappend(&output, "; %s\n\n", title);
     for (size_t pc = 0; pc < text->pc;)
     {
-        Rp2a03Instruction *instr = rp2a03_instruction_lookup(text->bytes[pc]);
+        const Rp2a03Instruction *instr = rp2a03_instruction_lookup(text->bytes[pc]);
 
         fl_cstring_vappend(&output, "%04zX: %s", text->base_address + pc, "    ");
 
@@ -2,29 +2,59 @@
 #define RP2A03_TEXT_SEGMENT_H
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <fllib/containers/List.h>
+#include "mnemonic.h"
+
+// The PPU ($2000-$3FFF, mirrored) and the APU and I/O ($4000-$401F) registers
+#define RP2A03_IS_IO_REGISTER(address) ((address) >= 0x2000 && (address) <= 0x401F)
 
 typedef FlList Rp2a03PendingJumpList;
 typedef struct FlListNode Rp2a03PendingJumpListNode;
 
 typedef struct Rp2a03PendingJump {
     uint16_t base_jump_pc;
+    uint16_t target_pc;
     uint16_t byte_index;
     uint16_t ir_offset;
     bool absolute;
 } Rp2a03PendingJump;
 
+typedef struct Rp2a03PendingStore {
+    uint16_t address;
+    uint8_t value;
+    Rp2a03Register reg;
+    Rp2a03AddressMode mode;
+    uint16_t origin;
+} Rp2a03PendingStore;
+
+typedef struct Rp2a03RegisterState {
+    int16_t value[RP2A03_REG_COUNT];
+    int16_t pending[RP2A03_REG_COUNT];
+    uint16_t pending_origin[RP2A03_REG_COUNT];
+    int16_t flags;
+    int8_t flags_register;
+} Rp2a03RegisterState;
+
 typedef struct Rp2a03TextSegment {
     Rp2a03PendingJumpList *pending_jumps;
+    Rp2a03PendingStore *pending_stores;
+    Rp2a03RegisterState registers;
     uint8_t *bytes;
+    uint16_t *origins;
+    uint16_t origin;
     uint16_t pc;
     uint16_t base_address;
 } Rp2a03TextSegment;
 
 Rp2a03TextSegment* rp2a03_text_segment_new(size_t base_address);
 void rp2a03_text_segment_free(Rp2a03TextSegment *text);
+void rp2a03_text_segment_emit(Rp2a03TextSegment *text, Rp2a03Mnemonic mnemonic, Rp2a03AddressMode mode, uint16_t operand);
+void rp2a03_text_segment_flush(Rp2a03TextSegment *text);
+void rp2a03_text_segment_label(Rp2a03TextSegment *text);
 void rp2a03_text_segment_add_pending_jump(Rp2a03TextSegment *text, Rp2a03PendingJump *pending_jump);
 void rp2a03_text_segment_backpatch_jumps(Rp2a03TextSegment *text);
+bool rp2a03_text_segment_relax_branches(Rp2a03TextSegment *text);
 void rp2a03_text_segment_backpatch_absolute_jumps(Rp2a03TextSegment *text);
 char* rp2a03_text_segment_disassemble(Rp2a03TextSegment *text, char *title, char *output);
 
@@ -0,0 +1,508 @@
+#include <stdio.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <fllib/Mem.h>
+#include <fllib/Array.h>
+#include <fllib/Cstring.h>
+#include <fllib/threading/Thread.h>
+#include "driver.h"
+#include "../front-end/type-check/check.h"
+#include "../front-end/inference/infer.h"
+#include "../front-end/parser/parse.h"
+#include "../front-end/binding/resolve.h"
+#include "../front-end/codegen/zir.h"
+#include "../zir/link.h"
+#include "../zir/passes/dead-globals.h"
+#include "../back-end/nes/nes.h"
+#include "../back-end/nes/rp2a03/generate.h"
+#include "../back-end/nes/ir/generate.h"
+#include "../back-end/nes/rp2a03/cost.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+static void sleep_milliseconds(unsigned int milliseconds)
+{
+#ifdef _WIN32
+    Sleep(milliseconds);
+#else
+    struct timespec duration = { .tv_sec = milliseconds / 1000, .tv_nsec = (milliseconds % 1000) * 1000000L };
+    nanosleep(&duration, NULL);
+#endif
+}
+
+static bool modification_time(const char *path, uint64_t *modified)
+{
+    struct stat info;
+
+    if (stat(path, &info) != 0)
+        return false;
+
+    // Editors can save a file twice in the same second, so we use the nanoseconds where they are available
+#ifdef _WIN32
+    *modified = (uint64_t) info.st_mtime * 1000000000ULL;
+#else
+    *modified = (uint64_t) info.st_mtim.tv_sec * 1000000000ULL + (uint64_t) info.st_mtim.tv_nsec;
+#endif
+    return true;
+}
+
+static void print_report(char *report)
+{
+    fprintf(stderr, "%s", report);
+    fl_cstring_free(report);
+}
+
+/*
+ * Function: set_error
+ *  Replaces the error of the driver, and prints it if the options say so
+ */
+static void set_error(ZenitDriver *driver, char *message)
+{
+    if (driver->error)
+        fl_cstring_free(driver->error);
+
+    driver->error = message;
+
+    if (message != NULL && driver->options.print_errors)
+        fprintf(stderr, "%s\n", message);
+}
+
+/*
+ * Function: compile_unit
+ *  Creates a new context for the unit and runs the front-end passes on it. The previous context,
+ *  if any, is released.
+ */
+static void compile_unit(ZenitDriver *driver, ZenitDriverUnit *unit)
+{
+    if (unit->compilations > 0)
+        zenit_context_free(&unit->context);
+
+    if (unit->source != NULL)
+    {
+        unit->context = zenit_context_new(ZENIT_SOURCE_STRING, unit->source);
+
+        if (unit->context.srcinfo != NULL)
+            unit->context.srcinfo->location.filename = fl_cstring_dup(unit->name);
+    }
+    else
+    {
+        // If the file does not exist we keep trying in the next refresh
+        if (!modification_time(unit->name, &unit->modified))
+            unit->modified = 0;
+
+        unit->context = zenit_context_new(ZENIT_SOURCE_FILE, unit->name);
+    }
+
+    zenit_context_set_error_limit(&unit->context, driver->options.error_limit);
+
+    unit->stale = false;
+    unit->compilations++;
+
+    if (unit->context.srcinfo == NULL)
+    {
+        unit->status = ZENIT_DRIVER_ERROR_FRONT_END;
+        return;
+    }
+
+    unit->status = zenit_parse_source(&unit->context)
+                    && zenit_resolve_symbols(&unit->context)
+                    && zenit_infer_types(&unit->context)
+                    && zenit_check_types(&unit->context)
+                        ? ZENIT_DRIVER_OK
+                        : ZENIT_DRIVER_ERROR_FRONT_END;
+}
+
+/*
+ * Struct: UnitJob
+ *  The unit a thread compiles with <compile_unit>
+ */
+typedef struct UnitJob {
+    ZenitDriver *driver;
+    ZenitDriverUnit *unit;
+} UnitJob;
+
+#ifdef _WIN32
+static DWORD WINAPI compile_unit_job(LPVOID args)
+#else
+static void* compile_unit_job(void *args)
+#endif
+{
+    UnitJob *job = (UnitJob*) args;
+    compile_unit(job->driver, job->unit);
+
+    return 0;
+}
+
+/*
+ * Function: compile_stale_units
+ *  The units do not depend on each other until the link step, so the stale units are compiled in
+ *  parallel, each one of them on its own thread. The threads only read the driver's options and
+ *  each one writes its own unit.
+ */
+static void compile_stale_units(ZenitDriver *driver)
+{
+    size_t count = fl_array_length(driver->units);
+    UnitJob *jobs = fl_array_new(sizeof(UnitJob), 0);
+
+    for (size_t i=0; i < count; i++)
+    {
+        if (!driver->units[i].stale)
+            continue;
+
+        UnitJob job = { .driver = driver, .unit = driver->units + i };
+        jobs = fl_array_append(jobs, &job);
+    }
+
+    size_t job_count = fl_array_length(jobs);
+
+    // A single unit does not need a thread
+    if (job_count == 1)
+    {
+        compile_unit(driver, jobs[0].unit);
+    }
+    else if (job_count > 1)
+    {
+        FlThread *threads = fl_malloc(sizeof(FlThread) * job_count);
+
+        for (size_t i=0; i < job_count; i++)
+            threads[i] = fl_thread_create(&compile_unit_job, jobs + i);
+
+        fl_thread_join_all(threads, job_count);
+        fl_free(threads);
+    }
+
+    fl_array_free(jobs);
+}
+
+/*
+ * Function: report_unit
+ *  Reports the errors of a unit that could not be compiled
+ */
+static void report_unit(ZenitDriver *driver, ZenitDriverUnit *unit)
+{
+    if (unit->context.srcinfo == NULL)
+        set_error(driver, fl_cstring_vdup("Could not read the source file '%s'", unit->name));
+    else if (driver->options.print_errors)
+        zenit_context_print_errors(&unit->context);
+}
+
+/*
+ * Function: generate_program
+ *  Generates the ZIR of each unit and links the programs
+ */
+static ZirProgram* generate_program(ZenitDriver *driver)
+{
+    size_t count = fl_array_length(driver->units);
+    ZirProgram **programs = fl_array_new(sizeof(ZirProgram*), count);
+    const char **names = fl_array_new(sizeof(char*), count);
+
+    ZirProgram *zir_program = NULL;
+    size_t generated = 0;
+
+    for (; generated < count; generated++)
+    {
+        ZenitDriverUnit *unit = driver->units + generated;
+        names[generated] = unit->name;
+        programs[generated] = zenit_generate_zir(&unit->context);
+
+        if (programs[generated] == NULL)
+        {
+            // The errors of the code generation stay in the context, so the unit fails until it changes
+            unit->status = ZENIT_DRIVER_ERROR_ZIR;
+            report_unit(driver, unit);
+            break;
+        }
+    }
+
+    if (generated == count)
+    {
+        // The link step also resolves the external variables of a single unit (or reports them as undefined)
+        char *message = NULL;
+        zir_program = zir_link_programs(programs, names, count, &message);
+
+        if (zir_program == NULL)
+            set_error(driver, message);
+    }
+
+    if (zir_program == NULL)
+    {
+        for (size_t i=0; i < generated; i++)
+            zir_program_free(programs[i]);
+    }
+
+    fl_array_free(names);
+    fl_array_free(programs);
+
+    return zir_program;
+}
+
+static bool run_passes(ZenitDriver *driver, ZirProgram *zir_program)
+{
+    ZenitDriverOptions *options = &driver->options;
+    ZirPassManager *pass_manager = zir_pass_manager_new(options->opt_level);
+    zir_pass_manager_register_defaults(pass_manager);
+
+    bool success = zir_pass_manager_run(pass_manager, zir_program);
+
+    if (!success)
+        set_error(driver, fl_cstring_dup(pass_manager->error));
+    else if (options->time_passes)
+        print_report(zir_pass_manager_report(pass_manager, fl_cstring_new(0)));
+
+    zir_pass_manager_free(pass_manager);
+
+    if (success && options->report_dead_globals)
+        print_report(zir_dead_globals_report(zir_program, ZNES_POINTER_SIZE, fl_cstring_new(0)));
+
+    return success;
+}
+
+static ZenitDriverStatus generate_rom(ZenitDriver *driver, ZirProgram *zir_program, Rp2a03Rom **rom)
+{
+    ZenitDriverOptions *options = &driver->options;
+
+    ZnesContext *znes_context = znes_context_new(false);
+    znes_context->program->mapper = options->mapper;
+    znes_context->program->reset_clears_ram = options->reset_clears_ram;
+
+    if (!znes_generate_program(znes_context, zir_program))
+    {
+        znes_context_free(znes_context);
+        return ZENIT_DRIVER_ERROR_BACK_END;
+    }
+
+    znes_context->program->peephole_rules = options->peephole_rules;
+    char *message = NULL;
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, &message);
+
+    if (!rp2a03_program)
+    {
+        set_error(driver, message);
+        znes_context_free(znes_context);
+        return ZENIT_DRIVER_ERROR_BACK_END;
+    }
+
+    if (options->report_peephole)
+        print_report(rp2a03_peephole_report(&rp2a03_program->peephole, fl_cstring_new(0)));
+
+    if (options->report_cost || options->report_cost_json)
+    {
+        Rp2a03CostEntry *entries = rp2a03_cost_analyze(rp2a03_program);
+        print_report(options->report_cost_json
+                        ? rp2a03_cost_report_json(rp2a03_program, entries, fl_cstring_new(0))
+                        : rp2a03_cost_report(rp2a03_program, entries, fl_cstring_new(0)));
+        fl_array_free(entries);
+    }
+
+    *rom = rp2a03_rom_new(rp2a03_program);
+
+    rp2a03_program_free(rp2a03_program);
+    znes_context_free(znes_context);
+
+    return *rom != NULL ? ZENIT_DRIVER_OK : ZENIT_DRIVER_ERROR_ROM;
+}
+
+ZenitDriverOptions zenit_driver_options_default(void)
+{
+    return (ZenitDriverOptions) {
+        .opt_level = ZIR_OPT_O1,
+        .peephole_rules = RP2A03_PEEPHOLE_ALL,
+        .error_limit = 0,
+        .print_errors = true,
+        .time_passes = false,
+        .report_dead_globals = false,
+        .report_peephole = false,
+        .report_cost = false,
+        .report_cost_json = false,
+        .mapper = ZNES_MAPPER_NROM,
+        .reset_clears_ram = false
+    };
+}
+
+ZenitDriver* zenit_driver_new(ZenitDriverOptions options)
+{
+    ZenitDriver *driver = fl_malloc(sizeof(ZenitDriver));
+    driver->options = options;
+    driver->units = fl_array_new(sizeof(ZenitDriverUnit), 0);
+    driver->error = NULL;
+
+    return driver;
+}
+
+void zenit_driver_free(ZenitDriver *driver)
+{
+    if (!driver)
+        return;
+
+    for (size_t i=0; i < fl_array_length(driver->units); i++)
+    {
+        if (driver->units[i].compilations > 0)
+            zenit_context_free(&driver->units[i].context);
+
+        fl_cstring_free(driver->units[i].name);
+
+        if (driver->units[i].source)
+            fl_cstring_free(driver->units[i].source);
+    }
+
+    if (driver->error)
+        fl_cstring_free(driver->error);
+
+    fl_array_free(driver->units);
+    fl_free(driver);
+}
+
+void zenit_driver_add_file(ZenitDriver *driver, const char *path)
+{
+    ZenitDriverUnit unit = {
+        .name = fl_cstring_dup(path),
+        .source = NULL,
+        .status = ZENIT_DRIVER_OK,
+        .modified = 0,
+        .stale = true,
+        .compilations = 0
+    };
+
+    driver->units = fl_array_append(driver->units, &unit);
+}
+
+size_t zenit_driver_add_source(ZenitDriver *driver, const char *name, const char *source)
+{
+    ZenitDriverUnit unit = {
+        .name = fl_cstring_dup(name),
+        .source = fl_cstring_dup(source),
+        .status = ZENIT_DRIVER_OK,
+        .modified = 0,
+        .stale = true,
+        .compilations = 0
+    };
+
+    driver->units = fl_array_append(driver->units, &unit);
+
+    return fl_array_length(driver->units) - 1;
+}
+
+bool zenit_driver_set_source(ZenitDriver *driver, size_t unit, const char *source)
+{
+    if (unit >= fl_array_length(driver->units) || driver->units[unit].source == NULL)
+        return false;
+
+    fl_cstring_free(driver->units[unit].source);
+    driver->units[unit].source = fl_cstring_dup(source);
+    driver->units[unit].stale = true;
+
+    return true;
+}
+
+bool zenit_driver_refresh(ZenitDriver *driver)
+{
+    bool changed = false;
+
+    for (size_t i=0; i < fl_array_length(driver->units); i++)
+    {
+        ZenitDriverUnit *unit = driver->units + i;
+        uint64_t modified;
+
+        // A file that is missing now is probably being saved, it is checked again in the next refresh
+        if (unit->source != NULL || !modification_time(unit->name, &modified))
+        {
+            changed = changed || unit->stale;
+            continue;
+        }
+
+        if (modified != unit->modified)
+            unit->stale = true;
+
+        changed = changed || unit->stale;
+    }
+
+    return changed;
+}
+
+ZenitDriverStatus zenit_driver_compile_zir(ZenitDriver *driver, ZirProgram **program)
+{
+    set_error(driver, NULL);
+
+    compile_stale_units(driver);
+
+    // The errors are reported in link order, the first unit that fails stops the compilation
+    for (size_t i=0; i < fl_array_length(driver->units); i++)
+    {
+        ZenitDriverUnit *unit = driver->units + i;
+
+        if (unit->status != ZENIT_DRIVER_OK)
+        {
+            report_unit(driver, unit);
+            return unit->status;
+        }
+    }
+
+    ZirProgram *zir_program = generate_program(driver);
+
+    if (!zir_program)
+        return ZENIT_DRIVER_ERROR_ZIR;
+
+    if (!run_passes(driver, zir_program))
+    {
+        zir_program_free(zir_program);
+        return ZENIT_DRIVER_ERROR_ZIR;
+    }
+
+    *program = zir_program;
+
+    return ZENIT_DRIVER_OK;
+}
+
+ZenitDriverStatus zenit_driver_compile(ZenitDriver *driver, Rp2a03Rom **rom)
+{
+    ZirProgram *zir_program = NULL;
+    ZenitDriverStatus status = zenit_driver_compile_zir(driver, &zir_program);
+
+    if (status != ZENIT_DRIVER_OK)
+        return status;
+
+    status = generate_rom(driver, zir_program, rom);
+
+    zir_program_free(zir_program);
+
+    return status;
+}
+
+ZenitDriverStatus zenit_driver_build(ZenitDriver *driver, const char *output)
+{
+    Rp2a03Rom *rom = NULL;
+    ZenitDriverStatus status = zenit_driver_compile(driver, &rom);
+
+    if (status != ZENIT_DRIVER_OK)
+        return status;
+
+    rp2a03_rom_dump(rom, output);
+    rp2a03_rom_free(rom);
+
+    return ZENIT_DRIVER_OK;
+}
+
+void zenit_driver_watch(ZenitDriver *driver, const char *output, unsigned int interval)
+{
+    bool changed = true;
+
+    while (true)
+    {
+        if (changed)
+        {
+            clock_t start = clock();
+            ZenitDriverStatus status = zenit_driver_build(driver, output);
+            double elapsed = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+
+            if (status == ZENIT_DRIVER_OK)
+                fprintf(stderr, "Wrote '%s' in %.3f ms, watching for changes...\n", output, elapsed);
+            else
+                fprintf(stderr, "Build failed, watching for changes...\n");
+        }
+
+        sleep_milliseconds(interval);
+        changed = zenit_driver_refresh(driver);
+    }
+}
@@ -0,0 +1,257 @@
+#ifndef ZENIT_DRIVER_H
+#define ZENIT_DRIVER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../front-end/context.h"
+#include "../zir/passes/manager.h"
+#include "../back-end/nes/nes.h"
+#include "../back-end/nes/rp2a03/rom.h"
+
+/*
+ * Enum: ZenitDriverStatus
+ *  The result of a build, the values are the exit codes of the *zenit* executable
+ */
+typedef enum ZenitDriverStatus {
+    ZENIT_DRIVER_OK = 0,
+    ZENIT_DRIVER_ERROR_FRONT_END = -2,
+    ZENIT_DRIVER_ERROR_ZIR = -3,
+    ZENIT_DRIVER_ERROR_BACK_END = -4,
+    ZENIT_DRIVER_ERROR_ROM = -5,
+} ZenitDriverStatus;
+
+/*
+ * Struct: ZenitDriverOptions
+ *  The options of the compilation and the reports the driver prints to stderr
+ *
+ * Members:
+ *  <ZirOptLevel> opt_level: The optimization level of the ZIR passes
+ *  <uint32_t> peephole_rules: The enabled peephole rules
+ *  <size_t> error_limit: Maximum number of errors reported by each unit, 0 means no limit
+ *  <bool> print_errors: Prints the errors to stderr. The errors are always available in the context of each
+ *                       unit and in the *error* member of the driver
+ *  <bool> time_passes: Prints the time and changes of each ZIR pass
+ *  <bool> report_dead_globals: Prints the globals that are not reachable from the roots
+ *  <bool> report_peephole: Prints the peephole statistics
+ *  <bool> report_cost: Prints the cycle and size costs of each declaration
+ *  <bool> report_cost_json: Prints the cost report in JSON format
+ *  <ZnesMapper> mapper: The board of the ROM, only the boards with a mapper can place variables in switchable banks
+ *  <bool> reset_clears_ram: The reset handler clears the RAM, so the startup routine does not clear the
+ *                           zero-initialized variables
+ */
+typedef struct ZenitDriverOptions {
+    ZirOptLevel opt_level;
+    uint32_t peephole_rules;
+    size_t error_limit;
+    bool print_errors;
+    bool time_passes;
+    bool report_dead_globals;
+    bool report_peephole;
+    bool report_cost;
+    bool report_cost_json;
+    ZnesMapper mapper;
+    bool reset_clears_ram;
+} ZenitDriverOptions;
+
+/*
+ * Struct: ZenitDriverUnit
+ *  A source file, or a source code in memory, and the state of its front-end passes. The context of a unit is kept
+ *  between builds, and it is only recreated when the source changes.
+ *
+ * Members:
+ *  <char> *name: The path of the source file, or the name of the in-memory source used in the error messages
+ *  <char> *source: The source code of an in-memory unit, or NULL if the unit is a file
+ *  <ZenitContext> context: The context with the AST, symbols and types of the unit
+ *  <ZenitDriverStatus> status: The result of the front-end passes and the ZIR generation
+ *  <uint64_t> modified: The modification time of the file when it was compiled, in nanoseconds
+ *  <bool> stale: *true* if the unit must be compiled in the next build
+ *  <size_t> compilations: Number of times the unit went through the front-end passes
+ */
+typedef struct ZenitDriverUnit {
+    char *name;
+    char *source;
+    ZenitContext context;
+    ZenitDriverStatus status;
+    uint64_t modified;
+    bool stale;
+    size_t compilations;
+} ZenitDriverUnit;
+
+/*
+ * Struct: ZenitDriver
+ *  Compiles a set of source files to a ROM, keeping the front-end state of each file so the
+ *  next builds only compile the files that changed. The drivers do not share state, so different
+ *  threads can compile at the same time as long as each one of them uses its own driver.
+ *
+ * Members:
+ *  <ZenitDriverOptions> options: The compilation options
+ *  <ZenitDriverUnit> *units: The source files in link order
+ *  <char> *error: The message of the last error of the link step, the ZIR passes or the code generation,
+ *                 NULL if the last compilation did not fail in those stages
+ */
+typedef struct ZenitDriver {
+    ZenitDriverOptions options;
+    ZenitDriverUnit *units;
+    char *error;
+} ZenitDriver;
+
+/*
+ * Function: zenit_driver_options_default
+ *  Returns the default options: -O1, all the peephole rules enabled, no error limit, the errors printed to
+ *  stderr, no reports, the NROM board and the zero-initialized variables cleared on startup
+ *
+ * Parameters:
+ *  This function does not take parameters
+ *
+ * Returns:
+ *  ZenitDriverOptions: The default options
+ */
+ZenitDriverOptions zenit_driver_options_default(void);
+
+/*
+ * Function: zenit_driver_new
+ *  Creates a driver without source files
+ *
+ * Parameters:
+ *  <ZenitDriverOptions> options: The compilation options
+ *
+ * Returns:
+ *  ZenitDriver*: The driver object
+ *
+ * Notes:
+ *  The object returned by this function must be freed using the <zenit_driver_free> function
+ */
+ZenitDriver* zenit_driver_new(ZenitDriverOptions options);
+
+/*
+ * Function: zenit_driver_free
+ *  Releases the units of the driver and the driver itself
+ *
+ * Parameters:
+ *  <ZenitDriver> *driver: The driver object
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void zenit_driver_free(ZenitDriver *driver);
+
+/*
+ * Function: zenit_driver_add_file
+ *  Adds a source file as a new unit, the units are linked in the order they are added
+ *
+ * Parameters:
+ *  <ZenitDriver> *driver: The driver object
+ *  <const char> *path: The path of the source file
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void zenit_driver_add_file(ZenitDriver *driver, const char *path);
+
+/*
+ * Function: zenit_driver_add_source
+ *  Adds a source code in memory as a new unit, the units are linked in the order they are added
+ *
+ * Parameters:
+ *  <ZenitDriver> *driver: The driver object
+ *  <const char> *name: The name of the unit used in the error messages
+ *  <const char> *source: The source code, the driver keeps a copy of it
+ *
+ * Returns:
+ *  size_t: The index of the unit, used to replace its source code with <zenit_driver_set_source>
+ */
+size_t zenit_driver_add_source(ZenitDriver *driver, const char *name, const char *source);
+
+/*
+ * Function: zenit_driver_set_source
+ *  Replaces the source code of an in-memory unit, the unit is compiled again in the next build and
+ *  the other units are reused
+ *
+ * Parameters:
+ *  <ZenitDriver> *driver: The driver object
+ *  <size_t> unit: The index of the unit returned by <zenit_driver_add_source>
+ *  <const char> *source: The new source code, the driver keeps a copy of it
+ *
+ * Returns:
+ *  bool: *false* if the index is not valid or the unit is a file
+ */
+bool zenit_driver_set_source(ZenitDriver *driver, size_t unit, const char *source);
+
+/*
+ * Function: zenit_driver_refresh
+ *  Compares the modification time of each source file with the one it had when it was compiled, and
+ *  marks the units that changed as stale. The in-memory units are not affected.
+ *
+ * Parameters:
+ *  <ZenitDriver> *driver: The driver object
+ *
+ * Returns:
+ *  bool: *true* if at least one unit changed since the last build
+ */
+bool zenit_driver_refresh(ZenitDriver *driver);
+
+/*
+ * Function: zenit_driver_compile_zir
+ *  Runs the front-end passes on the stale units (in parallel threads if more than one unit is stale),
+ *  generates and links the ZIR of all the units, and runs the ZIR passes
+ *
+ * Parameters:
+ *  <ZenitDriver> *driver: The driver object
+ *  <ZirProgram> **program: Receives the linked program if the compilation succeeds
+ *
+ * Returns:
+ *  ZenitDriverStatus: <ZENIT_DRIVER_OK> if the program has been compiled, or the stage that failed
+ *
+ * Notes:
+ *  A unit whose front-end passes fail keeps its errors until its source changes. The units that did not
+ *  change are not parsed, resolved or checked again, only their ZIR is generated again, because the
+ *  linker takes the ownership of the unit programs. The program must be freed with <zir_program_free>
+ *  before the next compilation or the release of the driver.
+ */
+ZenitDriverStatus zenit_driver_compile_zir(ZenitDriver *driver, ZirProgram **program);
+
+/*
+ * Function: zenit_driver_compile
+ *  Compiles the units with <zenit_driver_compile_zir> and generates the ROM with the NES back-end
+ *
+ * Parameters:
+ *  <ZenitDriver> *driver: The driver object
+ *  <Rp2a03Rom> **rom: Receives the ROM if the compilation succeeds
+ *
+ * Returns:
+ *  ZenitDriverStatus: <ZENIT_DRIVER_OK> if the ROM has been generated, or the stage that failed
+ *
+ * Notes:
+ *  The ROM does not depend on the driver, and it must be freed with <rp2a03_rom_free>
+ */
+ZenitDriverStatus zenit_driver_compile(ZenitDriver *driver, Rp2a03Rom **rom);
+
+/*
+ * Function: zenit_driver_build
+ *  Compiles the units with <zenit_driver_compile> and writes the ROM to the *output* file
+ *
+ * Parameters:
+ *  <ZenitDriver> *driver: The driver object
+ *  <const char> *output: The path of the ROM file
+ *
+ * Returns:
+ *  ZenitDriverStatus: <ZENIT_DRIVER_OK> if the ROM has been written, or the stage that failed
+ */
+ZenitDriverStatus zenit_driver_build(ZenitDriver *driver, const char *output);
+
+/*
+ * Function: zenit_driver_watch
+ *  Builds the ROM and then polls the source files, rebuilding it each time one of them changes. This
+ *  function does not return, the process is expected to be stopped by the user.
+ *
+ * Parameters:
+ *  <ZenitDriver> *driver: The driver object
+ *  <const char> *output: The path of the ROM file
+ *  <unsigned int> interval: Milliseconds between two checks of the source files
+ *
+ * Returns:
+ *  void: This function does not return
+ */
+void zenit_driver_watch(ZenitDriver *driver, const char *output, unsigned int interval);
+
+#endif /* ZENIT_DRIVER_H */
@@ -6,6 +6,7 @@
 #include "../types/type.h"
 
 #include "array.h"
+#include "blob.h"
 #include "block.h"
 #include "bool.h"
 #include "attribute.h"
@@ -0,0 +1,42 @@
+
+#include <fllib/Cstring.h>
+#include "blob.h"
+
+ZenitBlobNode* zenit_blob_node_new(ZenitSourceLocation location, const char *path, uint8_t *bytes, size_t length)
+{
+    ZenitBlobNode *blob_node = fl_malloc(sizeof(ZenitBlobNode));
+    blob_node->base.nodekind = ZENIT_AST_NODE_BLOB;
+    blob_node->base.location = location;
+    blob_node->path = fl_cstring_dup(path);
+    blob_node->bytes = bytes;
+    blob_node->length = length;
+
+    return blob_node;
+}
+
+char* zenit_blob_node_uid(ZenitBlobNode *blob_node)
+{
+    if (!blob_node)
+        return NULL;
+
+    return fl_cstring_vdup("%%L%u:C%u_blob", blob_node->base.location.line, blob_node->base.location.col);
+}
+
+char* zenit_blob_node_dump(ZenitBlobNode *blob_node, char *output)
+{
+    fl_cstring_vappend(&output, "(incbin \"%s\" %zu)", blob_node->path, blob_node->length);
+    return output;
+}
+
+void zenit_blob_node_free(ZenitBlobNode *blob_node)
+{
+    if (!blob_node)
+        return;
+
+    fl_cstring_free(blob_node->path);
+
+    if (blob_node->bytes)
+        fl_free(blob_node->bytes);
+
+    fl_free(blob_node);
+}
@@ -0,0 +1,95 @@
+#ifndef ZENIT_AST_BLOB_H
+#define ZENIT_AST_BLOB_H
+
+#include <stdint.h>
+#include "node.h"
+
+/*
+ * Struct: ZenitBlobNode
+ *  An AST node that represents the content of a binary file included with the *incbin* expression. The
+ *  bytes are kept in a single buffer, they are not expanded to an array literal
+ *
+ * Members:
+ *  <ZenitNode> base: Basic information of the node object
+ *  <char> *path: The path of the file as it is written in the source code
+ *  <uint8_t> *bytes: The content of the file
+ *  <size_t> length: The number of bytes of the file
+ *
+ */
+typedef struct ZenitBlobNode {
+    ZenitNode base;
+    char *path;
+    uint8_t *bytes;
+    size_t length;
+} ZenitBlobNode;
+
+/*
+ * Function: zenit_blob_node_new
+ *  Creates a new AST node that represents a binary file included in the source code
+ *
+ * Parameters:
+ *  <ZenitSourceLocation> location: Location information about the incbin expression
+ *  <const char> *path: The path of the file as it is written in the source code
+ *  <uint8_t> *bytes: The content of the file, allocated with <fl_malloc>
+ *  <size_t> length: The number of bytes of the file
+ *
+ * Returns:
+ *  ZenitBlobNode*: Blob node
+ *
+ * Notes:
+ *  The node takes the ownership of the *bytes* buffer. The object returned by this function must be freed
+ *  using the <zenit_blob_node_free> function
+ */
+ZenitBlobNode* zenit_blob_node_new(ZenitSourceLocation location, const char *path, uint8_t *bytes, size_t length);
+
+/*
+ * Function: zenit_blob_node_uid
+ *  Returns a UID for the blob node
+ *
+ * Parameters:
+ *  <ZenitBlobNode> *blob_node: Blob node
+ *
+ * Returns:
+ *  char*: UID of the blob node
+ *
+ * Notes:
+ *  The object returned by this function must be freed using the
+ *  <fl_cstring_free> function
+ */
+char* zenit_blob_node_uid(ZenitBlobNode *blob_node);
+
+/*
+ * Function: zenit_blob_node_dump
+ *  Appends a dump of the blob node to the output pointer, and
+ *  returns a pointer to the -possibly reallocated- output
+ *
+ * Parameters:
+ *  <ZenitBlobNode> *blob_node: Blob node to dump to the output
+ *  <char> *output: Pointer to a heap allocated string
+ *
+ * Returns:
+ *  char*: Pointer to the output string
+ *
+ * Notes:
+ *  Because the *output* pointer can be modified, this function returns
+ *  a pointer to the new location in case the memory is reallocated or
+ *  to the old location in case the pointer does not need to be modified. Either
+ *  way, it is safe to use the function as:
+ *      output = zenit_blob_node_dump(blob, output);
+ *  If the memory of *output* cannot be reallocated this function frees the memory.
+ */
+char* zenit_blob_node_dump(ZenitBlobNode *blob_node, char *output);
+
+/*
+ * Function: zenit_blob_node_free
+ *  Frees the memory used by the blob node, including the content of the file
+ *
+ * Parameters:
+ *  <ZenitBlobNode> *blob_node: Blob node
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void zenit_blob_node_free(ZenitBlobNode *blob_node);
+
+#endif /* ZENIT_AST_BLOB_H */
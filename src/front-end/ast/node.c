@@ -1,4 +1,5 @@
 #include "array.h"
+#include "blob.h"
 #include "block.h"
 #include "attribute.h"
 #include "bool.h"
@@ -46,6 +47,9 @@ char* zenit_node_uid(ZenitNode *node)
         case ZENIT_AST_NODE_BOOL:
             return zenit_bool_node_uid((ZenitBoolNode*) node);
 
+        case ZENIT_AST_NODE_BLOB:
+            return zenit_blob_node_uid((ZenitBlobNode*) node);
+
         case ZENIT_AST_NODE_IF:
             return zenit_if_node_uid((ZenitIfNode*) node);
 
@@ -117,6 +121,9 @@ char* zenit_node_dump(ZenitNode *node, char *output)
         case ZENIT_AST_NODE_BOOL:
             return zenit_bool_node_dump((ZenitBoolNode*) node, output);
 
+        case ZENIT_AST_NODE_BLOB:
+            return zenit_blob_node_dump((ZenitBlobNode*) node, output);
+
         case ZENIT_AST_NODE_IF:
             return zenit_if_node_dump((ZenitIfNode*) node, output);
 
@@ -196,6 +203,10 @@ void zenit_node_free(ZenitNode *node)
             zenit_bool_node_free((ZenitBoolNode*) node);
             break;
 
+        case ZENIT_AST_NODE_BLOB:
+            zenit_blob_node_free((ZenitBlobNode*) node);
+            break;
+
         case ZENIT_AST_NODE_IF:
             zenit_if_node_free((ZenitIfNode*) node);
             break;
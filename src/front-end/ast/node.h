@@ -11,6 +11,7 @@
 typedef enum ZenitNodeKind {
     ZENIT_AST_NODE_UINT,
     ZENIT_AST_NODE_BOOL,
+    ZENIT_AST_NODE_BLOB,
     ZENIT_AST_NODE_IF,
     ZENIT_AST_NODE_BLOCK,
     ZENIT_AST_NODE_VARIABLE,
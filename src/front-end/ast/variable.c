@@ -22,15 +22,18 @@ char* zenit_variable_node_uid(ZenitVariableNode *variable)
 
 char* zenit_variable_node_dump(ZenitVariableNode *variable, char *output)
 {
-    fl_cstring_vappend(&output, "(var %s ", variable->name);
+    fl_cstring_vappend(&output, variable->external ? "(extern var %s " : "(var %s ", variable->name);
 
     if (variable->type_decl != NULL)
     {
         output = zenit_node_dump((ZenitNode*) variable->type_decl, output);
-        fl_cstring_append(&output, " ");
+
+        if (variable->rvalue != NULL)
+            fl_cstring_append(&output, " ");
     }
 
-    output = zenit_node_dump((ZenitNode*) variable->rvalue, output);
+    if (variable->rvalue != NULL)
+        output = zenit_node_dump((ZenitNode*) variable->rvalue, output);
 
     ZenitAttributeNode **attrs = zenit_attribute_node_map_values(variable->attributes);
     size_t length = fl_array_length(attrs);
@@ -14,8 +14,9 @@
  *  <ZenitNode> base: Basic information of the node object
  *  <char> *name: The variable name
  *  <ZenitTypeNode> *type_decl: If present in the declaration, the variable's type
- *  <ZenitNode> *rvalue: The right-hand side expression that initializes the variable
+ *  <ZenitNode> *rvalue: The right-hand side expression that initializes the variable, NULL for external declarations
  *  <ZenitAttributeNodeMap> *attributes: If present, a list of all the variable's attributes
+ *  <bool> external: *true* if the variable is defined in another source file (extern var)
  * 
  */
 typedef struct ZenitVariableNode {
@@ -24,6 +25,7 @@ typedef struct ZenitVariableNode {
     ZenitTypeNode *type_decl;
     ZenitNode *rvalue;
     ZenitAttributeNodeMap *attributes;
+    bool external;
 } ZenitVariableNode;
 
 /*
@@ -21,6 +21,7 @@ typedef ZenitSymbol*(*ZenitSymbolResolver)(ZenitContext *ctx, ZenitNode *node, e
 static ZenitSymbol* visit_node(ZenitContext *ctx, ZenitNode *node, enum ResolvePass pass);
 static ZenitSymbol* visit_uint_node(ZenitContext *ctx, ZenitUintNode *uint_node, enum ResolvePass pass);
 static ZenitSymbol* visit_bool_node(ZenitContext *ctx, ZenitBoolNode *bool_node, enum ResolvePass pass);
+static ZenitSymbol* visit_blob_node(ZenitContext *ctx, ZenitBlobNode *blob_node, enum ResolvePass pass);
 static ZenitSymbol* visit_variable_node(ZenitContext *ctx, ZenitVariableNode *Variable_node, enum ResolvePass pass);
 static ZenitSymbol* visit_array_node(ZenitContext *ctx, ZenitArrayNode *array_node, enum ResolvePass pass);
 static ZenitSymbol* visit_identifier_node(ZenitContext *ctx, ZenitIdentifierNode *id_node, enum ResolvePass pass);
@@ -44,6 +45,7 @@ static const ZenitSymbolResolver symbol_resolvers[] = {
     [ZENIT_AST_NODE_CAST]           = (ZenitSymbolResolver) &visit_cast_node,
     [ZENIT_AST_NODE_UINT]           = (ZenitSymbolResolver) &visit_uint_node,
     [ZENIT_AST_NODE_BOOL]           = (ZenitSymbolResolver) &visit_bool_node,
+    [ZENIT_AST_NODE_BLOB]           = (ZenitSymbolResolver) &visit_blob_node,
     [ZENIT_AST_NODE_FIELD_DECL]     = (ZenitSymbolResolver) &visit_field_decl_node,
     [ZENIT_AST_NODE_STRUCT_DECL]    = (ZenitSymbolResolver) &visit_struct_decl_node,
     [ZENIT_AST_NODE_STRUCT]         = (ZenitSymbolResolver) &visit_struct_node,
@@ -93,6 +95,30 @@ static ZenitSymbol* visit_bool_node(ZenitContext *ctx, ZenitBoolNode *bool_node,
     return zenit_utils_new_tmp_symbol(ctx->program, (ZenitNode*) bool_node, (ZenitType*) zenit_type_ctx_new_bool(ctx->types));
 }
 
+/*
+ * Function: visit_blob_node
+ *  We create a temporal symbol with an array of uint8 with the length of the blob. The type is created once,
+ *  the bytes of the blob do not need a symbol
+ *
+ * Parameters:
+ *  <ZenitContext> *ctx - Context object
+ *  <ZenitBlobNode> *blob_node - Node object
+ *
+ * Returns:
+ *  ZenitSymbol* - Temporal symbol
+ *
+ */
+static ZenitSymbol* visit_blob_node(ZenitContext *ctx, ZenitBlobNode *blob_node, enum ResolvePass pass)
+{
+    if (pass != RESOLVE_ALL)
+        return NULL;
+
+    ZenitArrayType *array_type = zenit_type_ctx_new_array(ctx->types, (ZenitType*) zenit_type_ctx_new_uint(ctx->types, ZENIT_UINT_8));
+    array_type->length = blob_node->length;
+
+    return zenit_utils_new_tmp_symbol(ctx->program, (ZenitNode*) blob_node, (ZenitType*) array_type);
+}
+
 /*
  * Function: visit_cast_node
  *  If the cast has a type hint, we need to get that information to build a temporal symbol that will be
@@ -265,6 +291,10 @@ static void visit_attribute_node_map(ZenitContext *ctx, ZenitAttributeNodeMap *a
         {
             ZenitPropertyNode *prop = properties[j];
 
+            // The names do not refer to symbols
+            if (zenit_utils_is_name_property(attr, prop))
+                continue;
+
             // Visit the property's value
             ZenitSymbol *value_symbol = visit_node(ctx, prop->value, pass);
 
@@ -589,8 +619,16 @@ static ZenitSymbol* visit_variable_node(ZenitContext *ctx, ZenitVariableNode *va
     if (pass != RESOLVE_ALL)
         return NULL;
 
-    // We don't care about the returned symbol -if any- at this pass
-    ZenitSymbol *rhs_symbol = visit_node(ctx, variable_node->rvalue, pass);
+    // The definition of an external variable is in another unit's global scope
+    if (variable_node->external && ctx->program->current_scope != ctx->program->global_scope)
+    {
+        zenit_context_error(ctx, variable_node->base.location, ZENIT_ERROR_SYNTAX, 
+            "External variable '%s' must be declared in the global scope", variable_node->name);
+        return NULL;
+    }
+
+    // We don't care about the returned symbol -if any- at this pass (external variables do not have a value)
+    ZenitSymbol *rhs_symbol = variable_node->rvalue != NULL ? visit_node(ctx, variable_node->rvalue, pass) : NULL;
 
     // If the symbol already exists add an error
     if (zenit_program_has_symbol(ctx->program, variable_node->name))
@@ -688,7 +726,7 @@ static ZenitSymbol* visit_node(ZenitContext *ctx, ZenitNode *node, enum ResolveP
  */
 bool zenit_resolve_symbols(ZenitContext *ctx)
 {
-    if (!ctx || !ctx->ast || !ctx->ast->decls)
+    if (!ctx || !ctx->ast || !ctx->ast->decls || zenit_context_error_limit_reached(ctx))
         return false;
 
     size_t errors = zenit_context_error_count(ctx);
@@ -697,10 +735,10 @@ bool zenit_resolve_symbols(ZenitContext *ctx)
     // (by now), in the first pass we resolve user-defined types
     // and the second pass register all the symbols, including variables,
     // struct members, etc
-    for (size_t i=0; i < fl_array_length(ctx->ast->decls); i++)
+    for (size_t i=0; i < fl_array_length(ctx->ast->decls) && !zenit_context_error_limit_reached(ctx); i++)
         visit_node(ctx, ctx->ast->decls[i], RESOLVE_TYPES);
 
-    for (size_t i=0; i < fl_array_length(ctx->ast->decls); i++)
+    for (size_t i=0; i < fl_array_length(ctx->ast->decls) && !zenit_context_error_limit_reached(ctx); i++)
         visit_node(ctx, ctx->ast->decls[i], RESOLVE_ALL);
 
     return errors == zenit_context_error_count(ctx);
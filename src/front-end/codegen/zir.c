@@ -19,10 +19,29 @@ ZirAttributeMap* zenit_attr_map_to_zir_attr_map(ZenitContext *ctx, ZirProgram *p
 
 typedef ZirOperand*(*ZirGenerator)(ZenitContext *ctx, ZirProgram *program, ZenitNode *node);
 
+/*
+ * Function: enter_declaration
+ *  The instructions emitted from here on come from the declaration (or statement) at *location*, the
+ *  back-end uses the origin to attribute the cost of the generated code. Returns the previous origin
+ *  to be restored once the declaration is visited.
+ */
+static inline ZirSourceOrigin enter_declaration(ZirProgram *program, const char *declaration, ZenitSourceLocation location)
+{
+    ZirSourceOrigin previous = program->origin;
+    program->origin = (ZirSourceOrigin) { 
+        .declaration = declaration, 
+        .filename = location.filename, 
+        .line = location.line, 
+        .col = location.col 
+    };
+    return previous;
+}
+
 // Visitor functions
 static ZirOperand* visit_node(ZenitContext *ctx, ZirProgram *program, ZenitNode *node);
 static ZirOperand* visit_uint_node(ZenitContext *ctx, ZirProgram *program, ZenitUintNode *uint_node);
 static ZirOperand* visit_bool_node(ZenitContext *ctx, ZirProgram *program, ZenitBoolNode *bool_node);
+static ZirOperand* visit_blob_node(ZenitContext *ctx, ZirProgram *program, ZenitBlobNode *blob_node);
 static ZirOperand* visit_variable_node(ZenitContext *ctx, ZirProgram *program, ZenitVariableNode *variable_node);
 static ZirOperand* visit_array_node(ZenitContext *ctx, ZirProgram *program, ZenitArrayNode *array_node);
 static ZirOperand* visit_identifier_node(ZenitContext *ctx, ZirProgram *program, ZenitIdentifierNode *id_node);
@@ -41,6 +60,7 @@ static ZirOperand* visit_block_node(ZenitContext *ctx, ZirProgram *program, Zeni
 static const ZirGenerator generators[] = {
     [ZENIT_AST_NODE_UINT]           = (ZirGenerator) &visit_uint_node,
     [ZENIT_AST_NODE_BOOL]           = (ZirGenerator) &visit_bool_node,
+    [ZENIT_AST_NODE_BLOB]           = (ZirGenerator) &visit_blob_node,
     [ZENIT_AST_NODE_VARIABLE]       = (ZirGenerator) &visit_variable_node,
     [ZENIT_AST_NODE_ARRAY]          = (ZirGenerator) &visit_array_node,
     [ZENIT_AST_NODE_IDENTIFIER]     = (ZirGenerator) &visit_identifier_node,
@@ -73,6 +93,7 @@ static ZirSymbol* new_temp_symbol(ZirProgram *program, ZirType *type)
     snprintf(name, 1024, "%%tmp%llu", program->current->temp_counter++);
 
     ZirSymbol *zir_symbol = zir_symbol_new(name, type);
+    zir_symbol->linkage = ZIR_LINKAGE_LOCAL;
 
     zir_program_add_symbol(program, zir_symbol);
 
@@ -103,7 +124,8 @@ static ZirSymbol* import_zir_symbol_from_zenit_symbol(ZirProgram *program, Zenit
 
 /*
  * Function: new_zir_type_from_zenit_type
- *  Converts a Zenit type object to its counterpart's ZIR type 
+ *  Converts a Zenit type object to its counterpart's ZIR type. The ZIR type is owned by the
+ *  program's type context, so equal types are the same object
  *
  * Parameters:
  *  <ZirProgram> *program: ZIR program
@@ -134,24 +156,29 @@ static inline ZirType* new_zir_type_from_zenit_type(ZirProgram *program, ZenitTy
                 break;
         }
 
-        return (ZirType*) zir_uint_type_new(size);
+        return (ZirType*) zir_type_ctx_new_uint(program->types, size);
     }
 
     if (zenit_type->typekind == ZENIT_TYPE_BOOL)
     {
-        return (ZirType*) zir_bool_type_new();
+        return (ZirType*) zir_type_ctx_new_bool(program->types);
     }
 
     if (zenit_type->typekind == ZENIT_TYPE_REFERENCE)
     {
         ZenitReferenceType *zenit_ref = (ZenitReferenceType*) zenit_type;
         ZirType *zir_element_type = new_zir_type_from_zenit_type(program, zenit_ref->element);
-        return (ZirType*) zir_reference_type_new(zir_element_type);
+        return (ZirType*) zir_type_ctx_new_reference(program->types, zir_element_type);
     }
 
     if (zenit_type->typekind == ZENIT_TYPE_STRUCT)
     {
         ZenitStructType *zenit_struct = (ZenitStructType*) zenit_type;
+
+        // Named structs are converted once
+        if (zenit_struct->name != NULL && zir_type_ctx_get_named_struct(program->types, zenit_struct->name) != NULL)
+            return (ZirType*) zir_type_ctx_get_named_struct(program->types, zenit_struct->name);
+
         ZirStructType *zir_struct_type = zir_struct_type_new(zenit_struct->name);
 
         struct FlListNode *zenit_node = fl_list_head(zenit_struct->members);
@@ -163,21 +190,20 @@ static inline ZirType* new_zir_type_from_zenit_type(ZirProgram *program, ZenitTy
             zenit_node = zenit_node->next;
         }
 
-        return (ZirType*) zir_struct_type;
+        return (ZirType*) zir_type_ctx_intern_struct(program->types, zir_struct_type);
     }
 
     if (zenit_type->typekind == ZENIT_TYPE_ARRAY)
     {
         ZenitArrayType *zenit_array = (ZenitArrayType*) zenit_type;
         
-        ZirArrayType *zir_array = zir_array_type_new(new_zir_type_from_zenit_type(program, zenit_array->member_type));
-        zir_array->length = zenit_array->length;
-        
-        return (ZirType*) zir_array;
+        ZirType *zir_member_type = new_zir_type_from_zenit_type(program, zenit_array->member_type);
+
+        return (ZirType*) zir_type_ctx_new_array(program->types, zir_member_type, zenit_array->length);
     }
 
     if (zenit_type->typekind == ZENIT_TYPE_NONE)
-        return zir_none_type_new();
+        return zir_type_ctx_new_none(program->types);
 
     return NULL;
 }
@@ -220,8 +246,13 @@ ZirAttributeMap* zenit_attr_map_to_zir_attr_map(ZenitContext *ctx, ZirProgram *p
             // Get the Zenit property
             ZenitPropertyNode *zenit_prop = zenit_property_node_map_get(zenit_attr->properties, zenit_prop_names[j]);
 
-            // Create the ZIR property with the operand obtained from visiting the property's value
-            ZirProperty *zir_prop = zir_property_new(zenit_prop->name, visit_node(ctx, program, zenit_prop->value));
+            // Create the ZIR property with the operand obtained from visiting the property's value. The names
+            // do not have a symbol in the symbol table
+            ZirOperand *zir_value = zenit_utils_is_name_property(zenit_attr, zenit_prop)
+                ? (ZirOperand*) zir_operand_pool_new_name(program->operands, ((ZenitIdentifierNode*) zenit_prop->value)->name)
+                : visit_node(ctx, program, zenit_prop->value);
+
+            ZirProperty *zir_prop = zir_property_new(zenit_prop->name, zir_value);
 
             // We add the parsed property to the attribute's properties map
             zir_property_map_add(zir_attr->properties, zir_prop);
@@ -337,6 +368,30 @@ static ZirOperand* visit_bool_node(ZenitContext *ctx, ZirProgram *program, Zenit
     return (ZirOperand*) zir_bool_operand;
 }
 
+/*
+ * Function: visit_blob_node
+ *  Returns a blob operand with the content of the included file
+ *
+ * Parameters:
+ *  <ZenitContext> *ctx: Context object
+ *  <ZirProgram> *program: Program object
+ *  <ZenitBlobNode> *zenit_blob - Blob node
+ *
+ * Returns:
+ *  ZirOperand - The blob operand object
+ *
+ */
+static ZirOperand* visit_blob_node(ZenitContext *ctx, ZirProgram *program, ZenitBlobNode *zenit_blob)
+{
+    ZenitSymbol *zenit_blob_symbol = zenit_utils_get_tmp_symbol(ctx->program, (ZenitNode*) zenit_blob);
+
+    // The bytes are copied as a whole, the blob does not have an operand for each one of them
+    ZirArrayType *zir_array_type = (ZirArrayType*) new_zir_type_from_zenit_type(program, zenit_blob_symbol->type);
+    ZirBlobOperand *zir_blob = zir_operand_pool_new_blob(program->operands, zir_array_type, zenit_blob->path, zenit_blob->bytes, zenit_blob->length);
+
+    return (ZirOperand*) zir_blob;
+}
+
 /*
  * Function: visit_reference_node
  *  Returns a reference operand for the referenced expression
@@ -548,9 +603,22 @@ static ZirOperand* visit_variable_node(ZenitContext *ctx, ZirProgram *program, Z
     ZirSymbol *zir_symbol = import_zir_symbol_from_zenit_symbol(program, zenit_symbol, &zenit_variable->base.location);
     assert_or_return(ctx, zir_symbol != NULL, zenit_variable->base.location, "Could not create ZIR symbol");
 
+    // The variables of the nested blocks are private to the program
+    if (zenit_variable->external)
+        zir_symbol->linkage = ZIR_LINKAGE_EXTERNAL;
+    else if (ctx->program->current_scope != ctx->program->global_scope)
+        zir_symbol->linkage = ZIR_LINKAGE_LOCAL;
+
     // The destination operand is a symbol operand (the created ZIR symbol)
     ZirOperand *lhs = (ZirOperand*) zir_operand_pool_new_symbol(program->operands, zir_symbol);
 
+    // External variables are defined by another program, the linker resolves them
+    if (zenit_variable->external)
+        return lhs;
+
+    // The instructions of the variable's value are part of the declaration
+    ZirSourceOrigin previous_origin = enter_declaration(program, zenit_variable->name, zenit_variable->base.location);
+
     // The source operand is the one we get from the visit to the <ZenitVariableNode>'s value
     ZirOperand *rhs = visit_node(ctx, program, zenit_variable->rvalue);
 
@@ -561,111 +629,63 @@ static ZirOperand* visit_variable_node(ZenitContext *ctx, ZirProgram *program, Z
     var_instr->attributes = zenit_attr_map_to_zir_attr_map(ctx, program, zenit_variable->attributes);
 
     // Add the variable instruction to the program and finally return the destination operand
-    return zir_program_emit(program, (ZirInstr*) var_instr)->destination;
+    zir_program_emit(program, (ZirInstr*) var_instr);
+    program->origin = previous_origin;
+
+    return lhs;
 }
 
 static ZirOperand* visit_if_node(ZenitContext *ctx, ZirProgram *program, ZenitIfNode *if_node)
 {
     zenit_program_push_scope(ctx->program, ZENIT_SCOPE_BLOCK, if_node->id);
 
+    // The condition and the jumps are attributed to the if statement
+    ZirSourceOrigin previous_origin = enter_declaration(program, "if", if_node->base.location);
+
     // We need to visit the condition expression to emit it. We get the operand because it
     // is the *source* condition of the if-false instruction
     ZirOperand *source_operand = visit_node(ctx, program, if_node->condition);
 
-    // TODO: WE ARE USING UINT FOR THE JUMP, WE SHOULD UPDATE THIS TO SIGNED INT AS THE TYPES IN ZIR CHANGE
-    //       TO ALLOW JUMPING BACKWARDS
-
-    // Create a uint operand for the jump offset with a value of 0 symbolizing a jump that needs to be backpatched 
-    ZirOperand *if_jump_destination = (ZirOperand*) zir_operand_pool_new_uint(program->operands, zir_uint_type_new(ZIR_UINT_16), (ZirUintValue){ .uint16 = 0 });
-
-    // Emit the if-false instruction. We keep a reference to it to backpatch the jump destination
-    ZirInstr *if_false_instr = zir_program_emit(program, (ZirInstr*) zir_if_false_instr_new(if_jump_destination, source_operand));
+    // The if statement splits the control flow in basic blocks:
+    //
+    //      <current block>
+    //          ...
+    //          if_false <condition> jump <else or exit block>  ---.
+    //      <then block>                                            |
+    //          ...                                                 |
+    //          jump <exit block>  (only if there is an else)  --.  |
+    //      <else block>                                         | <´
+    //          ...                                              |
+    //      <exit block>                                      <--´
+    //
+    // The blocks are created upfront, so that the terminators can target them before they are placed
+    ZirBasicBlock *then_block = zir_program_new_basic_block(program);
+    ZirBasicBlock *else_block = if_node->else_branch != NULL ? zir_program_new_basic_block(program) : NULL;
+    ZirBasicBlock *exit_block = zir_program_new_basic_block(program);
 
-    // Get the IP at the if-false instruction to calculate the jump
-    size_t if_instr_ip = zir_block_get_ip(program->current);
-    if (if_instr_ip > (size_t) UINT16_MAX)
-    {
-        zenit_context_error(ctx, if_node->base.location, ZENIT_ERROR_INTERNAL, "Unaddressable jump of %zu instructions", if_instr_ip);
-        goto unaddressable_jump;
-    }
+    // The if-false instruction jumps to the "else" branch if it exists, otherwise, it jumps out of the "then" branch
+    zir_program_emit(program, (ZirInstr*) zir_if_false_instr_new(source_operand, else_block != NULL ? else_block : exit_block));
 
     // Visit the "then" branch to emit the ZIR instructions when the if-false instruction is not satisfied
+    zir_program_place_basic_block(program, then_block);
     visit_node(ctx, program, if_node->then_branch);
 
-    // At this point, the value of the IP of the block is 'k' which is placed in the last instruction that belongs to 
-    // the "then" branch. We say we are 'q' instructions ahead of the IP 'n' we saved before (the if_instr_ip variable):
-    //
-    //      if_false <condition> jump <unknown>                 <-- IP: 'n' ---.
-    //          ...                                                             | Difference of 'k' - 'n' instructions => 'q'
-    //      <last instruction within "then" branch>             <-- IP: 'k' ---´
-    //      <first instruction outside of the "then" branch>    <-- IP: 'k' + 1 
-    //
-    // Depending on the existence of an else branch, we need to calculate the offset of the jump from the if-false instruction
-    if (if_node->else_branch == NULL)
-    {
-        // If there is no "else" branch, the jump destination is the instruction placed at 'k' + 1
-        // The following line retrieves the current IP ('k')
-        size_t current_ip = zir_block_get_ip(program->current);
-
-        // Because the if-false instruction works with offsets, we need to calculate it:
-        //  target offset = 'k' + 1 - 'n'
-        if (fl_std_uint_add_overflow(current_ip, 1, UINT16_MAX))
-        {
-            zenit_context_error(ctx, if_node->base.location, ZENIT_ERROR_INTERNAL, "Unaddressable jump of %zu + 1 instructions", current_ip);
-            goto unaddressable_jump;
-        } 
-        ((ZirUintOperand*) if_false_instr->destination)->value.uint16 = current_ip - if_instr_ip + 1;
-    }
-    else
+    if (else_block != NULL)
     {
-        // If there is an "else" branch, the jump destination of the if-false instruction is the first instruction within the "else" branch,
-        // but to not fall from the "then" branch to the "else" branch when the if-false instruction is not met, we need to add an instruction 
-        // to "exit" the "then" branch. That instruction is an unconditional jump, and the destination of that jump needs to be backpatched to jump
-        // to the next instruction following the "else" branch:
-        //
-        //      if_false <condition> jump <unknown>                 <-- IP: 'n' ------.
-        //          ...                                                                |
-        //      <last instruction within "then" branch>             <-- IP: 'k'        | Difference of 'j' + 1 - 'n' instructions
-        //      jump ??                                             <-- IP: 'j'        |
-        //      <first instruction of the "else" branch>            <-- IP: 'j' + 1 --´
-        //          ...
-        //      <last instruction within "else" branch>             <-- IP: 'm'
-        //      <first instruction outside of the "else" branch>    <-- IP: 'm' + 1 (the target of the jump instruction)
-        //
-        ZirOperand *jump_destination = (ZirOperand*) zir_operand_pool_new_uint(program->operands, zir_uint_type_new(ZIR_UINT_16), (ZirUintValue){ .uint16 = 0 });
-        ZirInstr *jump_instr = zir_program_emit(program, (ZirInstr*) zir_jump_instr_new(jump_destination));
-
-        // Similar to what we did with the if-false instruction, we save the IP ('j') at the jump place to calculate the offset
-        size_t jump_inst_ip = zir_block_get_ip(program->current);
-
-        // As mentioned above, the entry point of the "else" branch is the instruction 'j' + 1, which means that the if-false instruction
-        // needs to jump 'j' + 1 - 'n' instruction forward:
-        if (fl_std_uint_add_overflow(jump_inst_ip, 1, UINT16_MAX))
-        {
-            zenit_context_error(ctx, if_node->base.location, ZENIT_ERROR_INTERNAL, "Unaddressable jump of %zu + 1 instructions", jump_inst_ip);
-            goto unaddressable_jump;
-        } 
-        ((ZirUintOperand*) if_false_instr->destination)->value.uint16 = jump_inst_ip + 1 - if_instr_ip;
+        // To not fall from the "then" branch to the "else" branch, we need an unconditional jump to "exit" the "then" branch
+        zir_program_emit(program, (ZirInstr*) zir_jump_instr_new(exit_block));
 
         // We visit the "else" branch
+        zir_program_place_basic_block(program, else_block);
         visit_node(ctx, program, if_node->else_branch);
-
-        // We retrieve the current IP ('m')
-        size_t last_else_ip = zir_block_get_ip(program->current);
-        
-        // Finally, the destination of the unconditional jump is the instruction 'm' + 1, and the offset from the jump instruction
-        // is: 'm' + 1 - 'j'
-        if (fl_std_uint_add_overflow(last_else_ip, 1, UINT16_MAX))
-        {
-            zenit_context_error(ctx, if_node->base.location, ZENIT_ERROR_INTERNAL, "Unaddressable jump of %zu + 1 instructions", last_else_ip);
-            goto unaddressable_jump;
-        }
-        ((ZirUintOperand*) jump_instr->destination)->value.uint16 = last_else_ip + 1 - jump_inst_ip;
     }
 
-unaddressable_jump:
+    // The following instructions are emitted into the exit block
+    zir_program_place_basic_block(program, exit_block);
+
     // Jump out of the Zenit block
     zenit_program_pop_scope(ctx->program);
+    program->origin = previous_origin;
 
     // No need to return anything
     return NULL;
@@ -755,7 +775,7 @@ static void convert_zenit_scope_to_zir_block(ZenitScope *scope, ZirBlock *block)
  */
 ZirProgram* zenit_generate_zir(ZenitContext *ctx)
 {
-    if (!ctx || !ctx->ast || !ctx->ast->decls)
+    if (!ctx || !ctx->ast || !ctx->ast->decls || zenit_context_error_limit_reached(ctx))
         return NULL;
 
     ZirProgram *program = zir_program_new();
@@ -765,7 +785,7 @@ ZirProgram* zenit_generate_zir(ZenitContext *ctx)
     // We make sure all the functions, structs, etc are "declared" in ZIR
     convert_zenit_scope_to_zir_block(ctx->program->global_scope, program->global);
 
-    for (size_t i=0; i < fl_array_length(ctx->ast->decls); i++)
+    for (size_t i=0; i < fl_array_length(ctx->ast->decls) && !zenit_context_error_limit_reached(ctx); i++)
         visit_node(ctx, program, ctx->ast->decls[i]);
 
     if (errors == zenit_context_error_count(ctx))
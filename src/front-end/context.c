@@ -1,4 +1,4 @@
-
+#include <ctype.h>
 #include "ast/ast.h"
 #include "context.h"
 #include "program.h"
@@ -6,33 +6,421 @@
 #include "types/type.h"
 
 /*
- * Function: error_free
- *  Frees the memory of an error object allocated with the <zenit_context_error> function
+ * Constant: ERRORS_INITIAL_CAPACITY
+ *  Number of errors the <ZenitErrorList> object can hold before growing its storage the first time
+ */
+#define ERRORS_INITIAL_CAPACITY 16
+
+/*
+ * Enum: LengthModifier
+ *  The length modifier of a conversion specifier
+ */
+typedef enum LengthModifier {
+    LENGTH_NONE,
+    LENGTH_HH,
+    LENGTH_H,
+    LENGTH_L,
+    LENGTH_LL,
+    LENGTH_J,
+    LENGTH_Z,
+    LENGTH_T,
+    LENGTH_LONG_DOUBLE,
+} LengthModifier;
+
+/*
+ * Struct: FormatSpecifier
+ *  A conversion specifier of a format string
+ *
+ * Members:
+ *  <const char> *start: Pointer to the '%' character
+ *  <size_t> modifier_offset: Offset from *start* to the length modifier
+ *  <const char> *end: Pointer to the character after the conversion character
+ *  <char> conversion: The conversion character
+ *  <LengthModifier> length: The length modifier
+ *  <bool> star_width: *true* if the width is taken from the argument list
+ *  <bool> star_precision: *true* if the precision is taken from the argument list
+ *  <int> precision: The precision if it is part of the specifier, otherwise -1
+ */
+typedef struct FormatSpecifier {
+    const char *start;
+    size_t modifier_offset;
+    const char *end;
+    char conversion;
+    LengthModifier length;
+    bool star_width;
+    bool star_precision;
+    int precision;
+} FormatSpecifier;
+
+/*
+ * Function: next_specifier
+ *  Scans the format string looking for the next conversion specifier, "%%" sequences are not
+ *  conversion specifiers so they are skipped
  *
  * Parameters:
- * <void> *errorptr: Pointer to a <ZenitError> object
+ *  <const char> *format: The format string to scan
+ *  <FormatSpecifier> *spec: The specifier object to populate
+ *
+ * Returns:
+ *  bool: *true* if a conversion specifier has been found, otherwise *false*
+ */
+static bool next_specifier(const char *format, FormatSpecifier *spec)
+{
+    const char *c = format;
+
+    while ((c = strchr(c, '%')) != NULL)
+    {
+        if (c[1] == '%')
+        {
+            c += 2;
+            continue;
+        }
+
+        *spec = (FormatSpecifier) { .start = c, .length = LENGTH_NONE, .precision = -1 };
+        c++;
+
+        while (*c && strchr("-+ #0", *c))
+            c++;
+
+        if (*c == '*')
+        {
+            spec->star_width = true;
+            c++;
+        }
+
+        while (isdigit((unsigned char) *c))
+            c++;
+
+        if (*c == '.')
+        {
+            c++;
+
+            if (*c == '*')
+            {
+                spec->star_precision = true;
+                c++;
+            }
+            else
+            {
+                spec->precision = 0;
+            }
+
+            while (isdigit((unsigned char) *c))
+                spec->precision = spec->precision * 10 + (*c++ - '0');
+        }
+
+        spec->modifier_offset = (size_t) (c - spec->start);
+
+        switch (*c)
+        {
+            case 'h':
+                spec->length = c[1] == 'h' ? LENGTH_HH : LENGTH_H;
+                c += spec->length == LENGTH_HH ? 2 : 1;
+                break;
+            case 'l':
+                spec->length = c[1] == 'l' ? LENGTH_LL : LENGTH_L;
+                c += spec->length == LENGTH_LL ? 2 : 1;
+                break;
+            case 'j': spec->length = LENGTH_J; c++; break;
+            case 'z': spec->length = LENGTH_Z; c++; break;
+            case 't': spec->length = LENGTH_T; c++; break;
+            case 'L': spec->length = LENGTH_LONG_DOUBLE; c++; break;
+            default: break;
+        }
+
+        if (*c == '\0')
+            return false;
+
+        spec->conversion = *c;
+        spec->end = c + 1;
+
+        return true;
+    }
+
+    return false;
+}
+
+/*
+ * Function: capture_args
+ *  Copies the values of the argument list that are referenced by the format string, the strings are
+ *  duplicated honoring the precision, if present
+ *
+ * Parameters:
+ *  <const char> *format: The format string
+ *  <va_list> args: The argument list
+ *
+ * Returns:
+ *  ZenitErrorArg*: An array of captured arguments, NULL if the format string does not contain specifiers
+ */
+static ZenitErrorArg* capture_args(const char *format, va_list args)
+{
+    ZenitErrorArg *captured = NULL;
+    FormatSpecifier spec;
+
+    while (next_specifier(format, &spec))
+    {
+        format = spec.end;
+
+        if (captured == NULL)
+            captured = fl_array_new(sizeof(ZenitErrorArg), 0);
+
+        int precision = spec.precision;
+        ZenitErrorArg arg = { .kind = ZENIT_ERROR_ARG_INT };
+
+        if (spec.star_width)
+        {
+            arg.value.sint = va_arg(args, int);
+            captured = fl_array_append(captured, &arg);
+        }
+
+        if (spec.star_precision)
+        {
+            precision = va_arg(args, int);
+            arg.value.sint = precision;
+            captured = fl_array_append(captured, &arg);
+        }
+
+        switch (spec.conversion)
+        {
+            case 'd':
+            case 'i':
+                arg.kind = ZENIT_ERROR_ARG_INT;
+                switch (spec.length)
+                {
+                    case LENGTH_L: arg.value.sint = va_arg(args, long); break;
+                    case LENGTH_LL: arg.value.sint = va_arg(args, long long); break;
+                    case LENGTH_J: arg.value.sint = va_arg(args, intmax_t); break;
+                    case LENGTH_Z: arg.value.sint = (intmax_t) va_arg(args, size_t); break;
+                    case LENGTH_T: arg.value.sint = va_arg(args, ptrdiff_t); break;
+                    default: arg.value.sint = va_arg(args, int); break;
+                }
+                break;
+
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+                arg.kind = ZENIT_ERROR_ARG_UINT;
+                switch (spec.length)
+                {
+                    case LENGTH_L: arg.value.uint = va_arg(args, unsigned long); break;
+                    case LENGTH_LL: arg.value.uint = va_arg(args, unsigned long long); break;
+                    case LENGTH_J: arg.value.uint = va_arg(args, uintmax_t); break;
+                    case LENGTH_Z: arg.value.uint = va_arg(args, size_t); break;
+                    case LENGTH_T: arg.value.uint = (uintmax_t) va_arg(args, ptrdiff_t); break;
+                    default: arg.value.uint = va_arg(args, unsigned int); break;
+                }
+                break;
+
+            case 'c':
+                arg.kind = ZENIT_ERROR_ARG_INT;
+                arg.value.sint = va_arg(args, int);
+                break;
+
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                arg.kind = ZENIT_ERROR_ARG_DOUBLE;
+                arg.value.dbl = spec.length == LENGTH_LONG_DOUBLE ? (double) va_arg(args, long double) : va_arg(args, double);
+                break;
+
+            case 's':
+            {
+                const char *str = va_arg(args, const char*);
+
+                if (str == NULL)
+                    str = "(null)";
+
+                // The string might not be null-terminated when the precision is present (%.*s)
+                size_t length = 0;
+                while ((precision < 0 || length < (size_t) precision) && str[length] != '\0')
+                    length++;
+
+                arg.kind = ZENIT_ERROR_ARG_STRING;
+                arg.value.str = fl_cstring_dup_n(str, length);
+                break;
+            }
+
+            default:
+                arg.kind = ZENIT_ERROR_ARG_POINTER;
+                arg.value.ptr = va_arg(args, const void*);
+                break;
+        }
+
+        captured = fl_array_append(captured, &arg);
+    }
+
+    return captured;
+}
+
+/*
+ * Macro: append_formatted
+ *  Appends the *value* formatted with the *spec* format string, passing the captured width and precision
+ *  first if the specifier takes them from the argument list
+ */
+#define append_formatted(output, spec, stars, star_count, value)            \
+    do {                                                                    \
+        if ((star_count) == 2)                                              \
+            fl_cstring_vappend((output), (spec), (stars)[0], (stars)[1], (value)); \
+        else if ((star_count) == 1)                                         \
+            fl_cstring_vappend((output), (spec), (stars)[0], (value));      \
+        else                                                                \
+            fl_cstring_vappend((output), (spec), (value));                  \
+    } while (0)
+
+/*
+ * Function: format_message
+ *  Formats the error message using the format string and the captured arguments
+ *
+ * Parameters:
+ *  <ZenitError> *error: The error object
+ *
+ * Returns:
+ *  char*: The formatted message
+ */
+static char* format_message(const ZenitError *error)
+{
+    char *output = fl_cstring_new(0);
+    const char *format = error->format;
+    size_t arg_index = 0;
+    FormatSpecifier spec;
+
+    while (next_specifier(format, &spec))
+    {
+        if (spec.start > format)
+            fl_cstring_vappend(&output, "%.*s", (int) (spec.start - format), format);
+
+        format = spec.end;
+
+        int stars[2];
+        size_t star_count = 0;
+
+        if (spec.star_width)
+            stars[star_count++] = (int) error->args[arg_index++].value.sint;
+
+        if (spec.star_precision)
+            stars[star_count++] = (int) error->args[arg_index++].value.sint;
+
+        const ZenitErrorArg *arg = &error->args[arg_index++];
+
+        // The captured values are promoted to the widest type of their kind, so we rebuild the specifier
+        // keeping the flags, width, and precision, and replacing the length modifier accordingly
+        char spec_str[32];
+        size_t prefix = spec.modifier_offset < sizeof(spec_str) - 4 ? spec.modifier_offset : sizeof(spec_str) - 4;
+        memcpy(spec_str, spec.start, prefix);
+
+        size_t length = prefix;
+        if (arg->kind == ZENIT_ERROR_ARG_INT && spec.conversion != 'c')
+            spec_str[length++] = 'j';
+        else if (arg->kind == ZENIT_ERROR_ARG_UINT)
+            spec_str[length++] = 'j';
+
+        spec_str[length++] = spec.conversion;
+        spec_str[length] = '\0';
+
+        switch (arg->kind)
+        {
+            case ZENIT_ERROR_ARG_INT:
+                if (spec.conversion == 'c')
+                    append_formatted(&output, spec_str, stars, star_count, (int) arg->value.sint);
+                else
+                    append_formatted(&output, spec_str, stars, star_count, arg->value.sint);
+                break;
+
+            case ZENIT_ERROR_ARG_UINT:
+                append_formatted(&output, spec_str, stars, star_count, arg->value.uint);
+                break;
+
+            case ZENIT_ERROR_ARG_DOUBLE:
+                append_formatted(&output, spec_str, stars, star_count, arg->value.dbl);
+                break;
+
+            case ZENIT_ERROR_ARG_STRING:
+                append_formatted(&output, spec_str, stars, star_count, arg->value.str);
+                break;
+
+            case ZENIT_ERROR_ARG_POINTER:
+                append_formatted(&output, spec_str, stars, star_count, arg->value.ptr);
+                break;
+        }
+    }
+
+    // The rest of the format string might contain "%%" sequences
+    for (const char *c = format; *c; c++)
+    {
+        fl_cstring_append_char(&output, *c);
+
+        if (c[0] == '%' && c[1] == '%')
+            c++;
+    }
+
+    return output;
+}
+
+/*
+ * Function: error_release
+ *  Frees the memory owned by an error object
+ *
+ * Parameters:
+ * <ZenitError> *error: Pointer to a <ZenitError> object
  *
  * Returns:
  *  void: This function does not return a value
  *
  */
-static void error_free(void *errorptr)
+static void error_release(ZenitError *error)
 {
-    if (!errorptr)
-        return;
+    if (error->args)
+    {
+        for (size_t i=0; i < fl_array_length(error->args); i++)
+        {
+            if (error->args[i].kind == ZENIT_ERROR_ARG_STRING)
+                fl_cstring_free(error->args[i].value.str);
+        }
 
-    ZenitError *error = (ZenitError*) errorptr;
+        fl_array_free(error->args);
+    }
 
     if (error->message)
         fl_cstring_free(error->message);
-
-    fl_free(error);
 }
 
-static void error_add(FlByte **dest, const FlByte *src)
+/*
+ * Function: error_compare
+ *  Orders the errors by file, line, and column. Errors at the same location keep the report order, because
+ *  qsort is not stable.
+ */
+static int error_compare(const void *a, const void *b)
 {
-    *dest = fl_malloc(sizeof(ZenitError));
-    memcpy(*dest, src, sizeof(ZenitError));
+    const ZenitError *error_a = (const ZenitError*) a;
+    const ZenitError *error_b = (const ZenitError*) b;
+
+    if (error_a->location.filename != error_b->location.filename)
+    {
+        if (error_a->location.filename == NULL || error_b->location.filename == NULL)
+            return error_a->location.filename == NULL ? -1 : 1;
+
+        int cmp = strcmp(error_a->location.filename, error_b->location.filename);
+
+        if (cmp != 0)
+            return cmp;
+    }
+
+    if (error_a->location.line != error_b->location.line)
+        return error_a->location.line < error_b->location.line ? -1 : 1;
+
+    if (error_a->location.col != error_b->location.col)
+        return error_a->location.col < error_b->location.col ? -1 : 1;
+
+    if (error_a->sequence != error_b->sequence)
+        return error_a->sequence < error_b->sequence ? -1 : 1;
+
+    return 0;
 }
 
 /*
@@ -45,7 +433,7 @@ ZenitContext zenit_context_new(ZenitSourceType type, const char *input)
         .program = zenit_program_new(),
         .srcinfo = zenit_source_new(type, input),
         .types = zenit_type_ctx_new(),
-        .errors = NULL
+        .errors = { .errors = NULL, .sorted = true }
     };
 
     return ctx;
@@ -65,56 +453,85 @@ void zenit_context_free(ZenitContext *ctx)
     if (ctx->program) zenit_program_free(ctx->program);
     if (ctx->srcinfo) zenit_source_free(ctx->srcinfo);
     if (ctx->ast) zenit_ast_free(ctx->ast);
-    if (ctx->errors) fl_list_free(ctx->errors);
     if (ctx->types) zenit_type_ctx_free(ctx->types);
+
+    for (size_t i=0; i < ctx->errors.length; i++)
+        error_release(ctx->errors.errors + i);
+
+    if (ctx->errors.errors) fl_free(ctx->errors.errors);
 }
 
 /*
  * Function: zenit_context_error
- *  Initializes the *errors* array if needed and appends a new error object to it. The memory allocated for the *errors*
- *  array and the memory allocated for each error object is freed in the <zenit_context_free> function
+ *  Appends a new error object to the *errors* array, growing it geometrically so the insertion
+ *  is constant in amortized time. The memory allocated for the *errors* array and the memory owned by
+ *  each error object is freed in the <zenit_context_free> function
  */
 void zenit_context_error(ZenitContext *ctx, ZenitSourceLocation location, ZenitErrorType type, const char *message, ...)
 {
     if (message == NULL)
         return;
 
-    if (ctx->errors == NULL)
+    ZenitErrorList *errors = &ctx->errors;
+
+    if (zenit_context_error_limit_reached(ctx))
+    {
+        errors->dropped++;
+        return;
+    }
+
+    if (errors->length == errors->capacity)
     {
-        ctx->errors = fl_list_new_args((struct FlListArgs) {
-            .value_allocator = (FlContainerAllocatorFn) error_add,
-            .value_cleaner = (FlContainerCleanupFn) error_free
-        });
+        errors->capacity = errors->capacity == 0 ? ERRORS_INITIAL_CAPACITY : errors->capacity * 2;
+        errors->errors = fl_realloc(errors->errors, sizeof(ZenitError) * errors->capacity);
     }
 
     va_list args;
     va_start(args, message);
-    char *formatted_msg = fl_cstring_vadup(message, args);
+    ZenitErrorArg *captured = capture_args(message, args);
     va_end(args);
 
-    ZenitError error = {
-        .type = type,
+    errors->errors[errors->length] = (ZenitError) {
+        .format = message,
+        .args = captured,
+        .message = NULL,
         .location = location,
-        .message = formatted_msg
+        .type = type,
+        .sequence = errors->length
     };
 
-    struct FlListNode *tmp = fl_list_head(ctx->errors);
+    // The new error is sorted only if it does not precede the last one
+    if (errors->sorted && errors->length > 0)
+        errors->sorted = error_compare(errors->errors + errors->length - 1, errors->errors + errors->length) <= 0;
 
-    while (tmp != NULL)
-    {
-        ZenitError *err = (ZenitError*) tmp->value;
+    errors->length++;
+}
 
-        if (error.location.filename == err->location.filename 
-            && (error.location.line < err->location.line || (error.location.line == err->location.line && error.location.col < err->location.col)))
-        {
-            fl_list_insert_before(ctx->errors, tmp, &error);
-            return;
-        }
+void zenit_context_set_error_limit(ZenitContext *ctx, size_t limit)
+{
+    ctx->errors.limit = limit;
+}
 
-        tmp = tmp->next;
+ZenitError* zenit_context_get_errors(ZenitContext *ctx)
+{
+    if (ctx->errors.length == 0)
+        return NULL;
+
+    if (!ctx->errors.sorted)
+    {
+        qsort(ctx->errors.errors, ctx->errors.length, sizeof(ZenitError), error_compare);
+        ctx->errors.sorted = true;
     }
 
-    fl_list_append(ctx->errors, &error);
+    return ctx->errors.errors;
+}
+
+const char* zenit_error_message(ZenitError *error)
+{
+    if (error->message == NULL)
+        error->message = format_message(error);
+
+    return error->message;
 }
 
 void zenit_context_print_errors(ZenitContext *ctx)
@@ -122,19 +539,20 @@ void zenit_context_print_errors(ZenitContext *ctx)
     if (!zenit_context_has_errors(ctx))
         return;
 
-    struct FlListNode *tmp = fl_list_head(ctx->errors);
+    ZenitError *errors = zenit_context_get_errors(ctx);
 
-    while (tmp != NULL)
+    for (size_t i=0; i < ctx->errors.length; i++)
     {
-        ZenitError *error = (ZenitError*) tmp->value;
+        ZenitError *error = errors + i;
 
         fprintf(stderr, "%s:%d:%d: %s\n", 
             error->location.filename, 
             error->location.line, 
             error->location.col, 
-            error->message
+            zenit_error_message(error)
         );
-
-        tmp = tmp->next;
     }
+
+    if (ctx->errors.dropped > 0)
+        fprintf(stderr, "Too many errors, %zu more errors were not reported\n", ctx->errors.dropped);
 }
@@ -1,6 +1,7 @@
 #ifndef ZENIT_CONTEXT_H
 #define ZENIT_CONTEXT_H
 
+#include <stdint.h>
 #include "ast/ast.h"
 #include "symtable.h"
 #include "source.h"
@@ -9,12 +10,13 @@
 
 /*
  * Macro: zenit_context_error_count
- *  Returns the number of *errors* registered in the <ZenitContext> object
+ *  Returns the number of *errors* registered in the <ZenitContext> object, including the errors dropped
+ *  after reaching the error limit. The count is cached, so this is a constant time operation.
  *
  * Parameters:
  *  <ZenitContext> *ctxptr: A pointer to a <ZenitContext> object
  */
-#define zenit_context_error_count(ctxptr) ((size_t)((ctxptr)->errors ? fl_list_length((ctxptr)->errors) : 0))
+#define zenit_context_error_count(ctxptr) ((ctxptr)->errors.length + (ctxptr)->errors.dropped)
 
 
 /*
@@ -24,7 +26,17 @@
  * Parameters:
  *  <ZenitContext> *ctxptr: A pointer to a <ZenitContext> object
  */
-#define zenit_context_has_errors(ctxptr) ((ctxptr)->errors && fl_list_head((ctxptr)->errors) != NULL)
+#define zenit_context_has_errors(ctxptr) (zenit_context_error_count(ctxptr) > 0)
+
+/*
+ * Macro: zenit_context_error_limit_reached
+ *  Evaluates to *true* if the <ZenitContext> object has an error limit and the number of *errors* reached it. The
+ *  compilation passes use it to stop as soon as possible.
+ *
+ * Parameters:
+ *  <ZenitContext> *ctxptr: A pointer to a <ZenitContext> object
+ */
+#define zenit_context_error_limit_reached(ctxptr) ((ctxptr)->errors.limit > 0 && (ctxptr)->errors.length >= (ctxptr)->errors.limit)
 
 /*
  * Enum: ZenitErrorType 
@@ -62,25 +74,88 @@ typedef enum ZenitErrorType {
 
     // A member of a compound type is not initialized on type instance creation
     ZENIT_ERROR_UNINITIALIZED_MEMBER,
+
+    // A file included in the source code cannot be read
+    ZENIT_ERROR_FILE,
 } ZenitErrorType;
 
+/*
+ * Enum: ZenitErrorArgKind
+ *  The kind of value captured from the argument list of <zenit_context_error>
+ *
+ */
+typedef enum ZenitErrorArgKind {
+    ZENIT_ERROR_ARG_INT,
+    ZENIT_ERROR_ARG_UINT,
+    ZENIT_ERROR_ARG_DOUBLE,
+    ZENIT_ERROR_ARG_STRING,
+    ZENIT_ERROR_ARG_POINTER,
+} ZenitErrorArgKind;
+
+/*
+ * Struct: ZenitErrorArg
+ *  An argument of an error message captured at report time. Strings are copied, because the objects
+ *  that own them might be freed before the message is formatted.
+ *
+ * Members:
+ *  <ZenitErrorArgKind> kind: The kind of the captured value
+ *  <union> value: The captured value
+ */
+typedef struct ZenitErrorArg {
+    ZenitErrorArgKind kind;
+    union {
+        intmax_t sint;
+        uintmax_t uint;
+        double dbl;
+        char *str;
+        const void *ptr;
+    } value;
+} ZenitErrorArg;
+
 /*
  * Struct: ZenitError
- *  All the errors that occur in the compilation are tracked by objects of this type
+ *  All the errors that occur in the compilation are tracked by objects of this type. The message is
+ *  formatted on demand by the <zenit_error_message> function.
  * 
  * Members:
- *  <const char> *message: The error explanation
+ *  <const char> *format: The format string of the error explanation, it must be a string literal
+ *  <ZenitErrorArg> *args: The arguments of the format string
+ *  <char> *message: The formatted message, NULL until the first call to <zenit_error_message>
  *  <ZenitSourceLocation> location: Where in the source the error occurred tracked by a <ZenitSourceLocation> object
  *  <ZenitErrorType> type: The type of the error being one of the <ZenitErrorType> values
+ *  <size_t> sequence: The order in which the error has been reported
  * 
  */
 typedef struct ZenitError {
-    const char *message;
+    const char *format;
+    ZenitErrorArg *args;
+    char *message;
     ZenitSourceLocation location;
     ZenitErrorType type;
+    size_t sequence;
 } ZenitError;
 
-typedef FlList ZenitErrorList;
+/*
+ * Struct: ZenitErrorList
+ *  Append-only storage of <ZenitError> objects. The errors are kept in report order and sorted by
+ *  location only once, when they are requested through <zenit_context_get_errors>.
+ *
+ * Members:
+ *  <ZenitError> *errors: The errors
+ *  <size_t> length: Number of errors in the *errors* array
+ *  <size_t> capacity: Number of errors the *errors* array can hold
+ *  <size_t> limit: Maximum number of errors to keep, 0 means there is no limit
+ *  <size_t> dropped: Number of errors reported after reaching the *limit*
+ *  <bool> sorted: *true* if the *errors* array is sorted by location
+ */
+typedef struct ZenitErrorList {
+    ZenitError *errors;
+    size_t length;
+    size_t capacity;
+    size_t limit;
+    size_t dropped;
+    bool sorted;
+} ZenitErrorList;
 
 /*
  * Struct: ZenitContext
@@ -88,13 +163,13 @@ typedef FlList ZenitErrorList;
  *  process.
  * 
  * Members:
- *  <ZenitErrorList> *errors: List of <ZenitError> objects that occur in the compilation process
+ *  <ZenitErrorList> errors: The <ZenitError> objects that occur in the compilation process
  *  <ZenitAst> *ast: Contains a reference to the AST generated by the parser
  *  <ZenitSourceInfo> *srcinfo: <ZenitSourceInfo> object to track files, lines and columns
  *  <ZenitProgram> *program: The object that contains the program being compiled
  */
 typedef struct ZenitContext {
-    ZenitErrorList *errors;
+    ZenitErrorList errors;
     ZenitAst *ast;
     ZenitSourceInfo *srcinfo;
     ZenitProgram *program;
@@ -138,15 +213,61 @@ void zenit_context_free(ZenitContext* ctx);
  *  <ZenitContext> *ctx: Context object
  *  <ZenitSourceLocation> location: Object that contains information of where in the source code the error happened
  *  <ZenitErrorType> type: The code that represents the type of the error
- *  <const char> *message: A string that accepts format specifiers containing information about the error
+ *  <const char> *message: A string literal that accepts format specifiers containing information about the error
  *  *...*: Depending on the format string, the function may expect a sequence of additional arguments, each containing 
  *          a value to be used to replace a format specifier in the format string.
  *
  * Returns:
  *  void: This function does not return a value
+ *
+ * Notes:
+ *  The message is not formatted until it is needed, the function only keeps the format string and
+ *  a copy of the arguments. If the context reached its error limit, the error is only counted.
  */
 void zenit_context_error(ZenitContext *ctx, ZenitSourceLocation location, ZenitErrorType type, const char *message, ...);
 
+/*
+ * Function: zenit_context_set_error_limit
+ *  Sets the maximum number of errors the context keeps. When the limit is reached, the compilation
+ *  passes stop and the following errors are only counted.
+ *
+ * Parameters:
+ *  <ZenitContext> *ctx: Context object
+ *  <size_t> limit: The maximum number of errors, 0 means there is no limit
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void zenit_context_set_error_limit(ZenitContext *ctx, size_t limit);
+
+/*
+ * Function: zenit_context_get_errors
+ *  Returns the errors registered in the context sorted by file, line and column. Errors reported at the
+ *  same location keep the report order.
+ *
+ * Parameters:
+ *  <ZenitContext> *ctx: Context object
+ *
+ * Returns:
+ *  ZenitError*: Array of *errors.length* errors, NULL if there are no errors
+ *
+ * Notes:
+ *  The array is owned by the context and it is valid until the next call to <zenit_context_error>
+ */
+ZenitError* zenit_context_get_errors(ZenitContext *ctx);
+
+/*
+ * Function: zenit_error_message
+ *  Returns the formatted message of the error, formatting it on the first call
+ *
+ * Parameters:
+ *  <ZenitError> *error: Error object
+ *
+ * Returns:
+ *  const char*: The error message, owned by the error object
+ */
+const char* zenit_error_message(ZenitError *error);
+
 /*
  * Function: zenit_context_print_errors
  *  Print all the errors registered in the context object to the standard error
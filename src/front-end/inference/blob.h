@@ -0,0 +1,32 @@
+#ifndef ZENIT_INFER_BLOB_H
+#define ZENIT_INFER_BLOB_H
+
+#include "infer.h"
+#include "../utils.h"
+
+/*
+ * Function: zenit_infer_types_in_blob_node
+ *  A blob node always has a type (an array of uint8 with the length of the file) therefore we just return it
+ *
+ * Parameters:
+ *  <ZenitContext> *ctx - Context object
+ *  <ZenitBlobNode> *blob_node - Blob node
+ *  <ZenitType> *ctx_type: Contextual type information
+ *  <ZenitInferenceKind> *infer_kind: Contextual information about the inference process
+ *
+ * Returns:
+ *  <ZenitSymbol>*: The temporal symbol of the blob
+ */
+static inline ZenitSymbol* zenit_infer_types_in_blob_node(ZenitContext *ctx, ZenitBlobNode *blob_node, ZenitType **ctx_type, ZenitInferenceKind infer_kind)
+{
+    ZenitSymbol *blob_symbol = zenit_utils_get_tmp_symbol(ctx->program, (ZenitNode*) blob_node);
+
+    // NOTE: The bytes of the blob cannot change their type, but the context might ask for type 
+    // information, and in that case, we update just the ctx_type object
+    if (ctx_type != NULL && infer_kind == ZENIT_INFER_BIDIRECTIONAL)
+        zenit_try_type_unification(ctx->types, ZENIT_UNIFY_B, &blob_symbol->type, ctx_type);
+
+    return blob_symbol;
+}
+
+#endif /* ZENIT_INFER_BLOB_H */
@@ -1,6 +1,7 @@
 #include "infer.h"
 
 #include "array.h"
+#include "blob.h"
 #include "block.h"
 #include "bool.h"
 #include "cast.h"
@@ -25,6 +26,7 @@
 static const ZenitTypeInferrer inferrers[] = {
     [ZENIT_AST_NODE_UINT]           = (ZenitTypeInferrer) &zenit_infer_types_in_uint_node,
     [ZENIT_AST_NODE_BOOL]           = (ZenitTypeInferrer) &zenit_infer_types_in_bool_node,
+    [ZENIT_AST_NODE_BLOB]           = (ZenitTypeInferrer) &zenit_infer_types_in_blob_node,
     [ZENIT_AST_NODE_VARIABLE]       = (ZenitTypeInferrer) &zenit_infer_types_in_variable_node,
     [ZENIT_AST_NODE_ARRAY]          = (ZenitTypeInferrer) &zenit_infer_types_in_array_node,
     [ZENIT_AST_NODE_IDENTIFIER]     = (ZenitTypeInferrer) &zenit_infer_types_in_identifier_node,
@@ -114,12 +116,12 @@ ZenitSymbol* zenit_infer_types_in_node(ZenitContext *ctx, ZenitNode *node, Zenit
  */
 bool zenit_infer_types(ZenitContext *ctx)
 {
-    if (!ctx || !ctx->ast || !ctx->ast->decls)
+    if (!ctx || !ctx->ast || !ctx->ast->decls || zenit_context_error_limit_reached(ctx))
         return false;
 
     size_t errors = zenit_context_error_count(ctx);
 
-    for (size_t i=0; i < fl_array_length(ctx->ast->decls); i++)
+    for (size_t i=0; i < fl_array_length(ctx->ast->decls) && !zenit_context_error_limit_reached(ctx); i++)
         zenit_infer_types_in_node(ctx, ctx->ast->decls[i], NULL, ZENIT_INFER_NONE);
 
     return errors == zenit_context_error_count(ctx);
@@ -36,6 +36,10 @@ static inline ZenitSymbol* zenit_infer_types_in_variable_node(ZenitContext *ctx,
     // We need the symbol we introduced in the <zenit_resolve_symbols> pass
     ZenitSymbol *symbol = zenit_program_get_symbol(ctx->program, variable_node->name);
 
+    // The type of an external variable is always declared
+    if (variable_node->external)
+        return symbol;
+
     // We need to get the symbol of the right-hand side expression. (if the variable definition has a type hint, we pass that hint to the visitor)
     ZenitSymbol *rhs_symbol = zenit_infer_types_in_node(ctx, 
                                             variable_node->rvalue, 
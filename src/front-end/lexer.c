@@ -51,14 +51,14 @@
  *  Group of synchronization characters of length 1
  *
  */
-static char sync_char[] = { '\0', '\n', ' ', '\t', '\r', '#', ';', '=' };
+static const char sync_char[] = { '\0', '\n', ' ', '\t', '\r', '#', ';', '=' };
 
 /*
  * Variable: sync_chars
  *  Group of synchronization characters of length greater than 1
  *
  */
-static char *sync_chars[] = { "//", "/*" };
+static const char *sync_chars[] = { "//", "/*" };
 
 /*
  * Function: has_input
@@ -459,6 +459,19 @@ ZenitToken zenit_lexer_consume(ZenitLexer *lexer)
 
             // Fall to unknown!
         }
+        else if (c == '"')
+        {
+            // The string literal cannot span multiple lines, and the token includes both quotes
+            size_t chars = 1;
+            while (peek_at(lexer, chars) != '\0' && peek_at(lexer, chars) != '"' && peek_at(lexer, chars) != '\n')
+                chars++;
+
+            if (peek_at(lexer, chars) == '"')
+                return create_token(lexer, ZENIT_TOKEN_STRING, chars + 1);
+
+            // Fall to unknown!
+            break;
+        }
         else if (is_number(c))
         {
             // Take as much numbers as possible
@@ -489,6 +502,10 @@ ZenitToken zenit_lexer_consume(ZenitLexer *lexer)
                 token.type = ZENIT_TOKEN_IF;
             else if (is_reserved_keyword(&token.value, "else"))
                 token.type = ZENIT_TOKEN_ELSE;
+            else if (is_reserved_keyword(&token.value, "extern"))
+                token.type = ZENIT_TOKEN_EXTERN;
+            else if (is_reserved_keyword(&token.value, "incbin"))
+                token.type = ZENIT_TOKEN_INCBIN;
 
             return token;
         }
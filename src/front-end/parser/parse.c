@@ -1,6 +1,8 @@
 
 #include <errno.h>
 #include <limits.h>
+#include <stdio.h>
+#include <string.h>
 #include "parse.h"
 #include "../lexer.h"
 #include "../parser.h"
@@ -88,12 +90,14 @@ static ZenitNode* parse_named_struct_literal(ZenitParser *parser, ZenitContext *
 static ZenitNode* parse_identifier_expression(ZenitParser *parser, ZenitContext *ctx);
 static ZenitNode* parse_unary_expression(ZenitParser *parser, ZenitContext *ctx);
 static ZenitNode* parse_cast_expression(ZenitParser *parser, ZenitContext *ctx);
+static ZenitNode* parse_incbin_expression(ZenitParser *parser, ZenitContext *ctx);
 static ZenitNode* parse_expression(ZenitParser *parser, ZenitContext *ctx);
 static ZenitNode* parse_expression_statement(ZenitParser *parser, ZenitContext *ctx);
 static ZenitNode* parse_if_statement(ZenitParser *parser, ZenitContext *ctx);
 static ZenitNode* parse_block(ZenitParser *parser, ZenitContext *ctx);
 static ZenitNode* parse_statement(ZenitParser *parser, ZenitContext *ctx);
 static ZenitNode* parse_variable_declaration(ZenitParser *parser, ZenitContext *ctx);
+static ZenitNode* parse_extern_declaration(ZenitParser *parser, ZenitContext *ctx);
 static ZenitNode* parse_struct_field_declaration(ZenitParser *parser, ZenitContext *ctx);
 static ZenitNode* parse_struct_declaration(ZenitParser *parser, ZenitContext *ctx);
 static ZenitNode* parse_attribute_declaration(ZenitParser *parser, ZenitContext *ctx);
@@ -102,6 +106,7 @@ static ZenitTypeNode* parse_type_declaration(ZenitParser *parser, ZenitContext *
 static ZenitTypeNode* parse_type_array_declaration(ZenitParser *parser, ZenitContext *ctx, bool allow_partial_types);
 static ZenitTypeNode* parse_type_reference_declaration(ZenitParser *parser, ZenitContext *ctx, bool allow_partial_types);
 static bool parse_uint_value(ZenitContext *ctx, ZenitToken *primitive_token, ZenitUintTypeSize *size, ZenitUintValue *value);
+static uint8_t* read_binary_file(ZenitContext *ctx, const char *path, size_t *length);
 static inline bool synchronize(ZenitParser *parser, ZenitTokenType *tokens, size_t length);
 
 /*
@@ -738,6 +743,105 @@ static ZenitNode* parse_cast_expression(ZenitParser *parser, ZenitContext *ctx)
     return NULL;
 }
 
+/*
+ * Function: read_binary_file
+ *  Reads the whole content of a binary file. A relative *path* is resolved from the directory of the
+ *  source file, or from the working directory if the source code does not come from a file
+ *
+ * Parameters:
+ *  <ZenitContext> *ctx: Context object
+ *  <const char> *path: The path of the file as it is written in the source code
+ *  <size_t> *length: Receives the number of bytes of the file
+ *
+ * Returns:
+ *  uint8_t* - The content of the file, or NULL if it cannot be read. The buffer must be freed with
+ *             <fl_free>
+ */
+static uint8_t* read_binary_file(ZenitContext *ctx, const char *path, size_t *length)
+{
+    const char *filename = ctx->srcinfo->location.filename;
+    const char *separator = filename != NULL ? strrchr(filename, '/') : NULL;
+
+    char *resolved_path = path[0] != '/' && separator != NULL
+                            ? fl_cstring_vdup("%.*s%s", (int) (separator - filename + 1), filename, path)
+                            : fl_cstring_dup(path);
+
+    FILE *file = fopen(resolved_path, "rb");
+    fl_cstring_free(resolved_path);
+
+    if (file == NULL)
+        return NULL;
+
+    uint8_t *bytes = NULL;
+    long size = 0;
+
+    if (fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < 0 || fseek(file, 0, SEEK_SET) != 0)
+        goto on_error;
+
+    // The buffer is never empty, so an empty file does not look like an error to the caller
+    bytes = fl_malloc((size_t) size + 1);
+
+    if (fread(bytes, 1, (size_t) size, file) != (size_t) size)
+        goto on_error;
+
+    fclose(file);
+    *length = (size_t) size;
+
+    return bytes;
+
+    on_error:
+        if (bytes != NULL)
+            fl_free(bytes);
+        fclose(file);
+
+    return NULL;
+}
+
+/*
+ * Function: parse_incbin_expression
+ *  Parses an incbin expression. The content of the file is read once and it is kept in a single
+ *  <ZenitBlobNode>, so large tables do not create a node for each byte
+ *
+ * Parameters:
+ *  <ZenitParser> *parser: Parser object
+ *  <ZenitContext> *ctx: Context object
+ *
+ * Returns:
+ *  ZenitNode* - Parsed incbin expression
+ * 
+ * Grammar:
+ *  incbin_expression = 'incbin' '(' STRING ')' ;
+ *
+ */
+static ZenitNode* parse_incbin_expression(ZenitParser *parser, ZenitContext *ctx)
+{
+    ZenitToken incbin_token;
+    ZenitToken path_token;
+
+    consume_or_return(ctx, parser, ZENIT_TOKEN_INCBIN, &incbin_token);
+    consume_or_return(ctx, parser, ZENIT_TOKEN_LPAREN, NULL);
+    consume_or_return(ctx, parser, ZENIT_TOKEN_STRING, &path_token);
+    consume_or_return(ctx, parser, ZENIT_TOKEN_RPAREN, NULL);
+
+    // The token includes the quotes
+    char *path = fl_cstring_dup_n((const char*) path_token.value.sequence + 1, path_token.value.length - 2);
+
+    size_t length = 0;
+    uint8_t *bytes = read_binary_file(ctx, path, &length);
+
+    if (bytes == NULL)
+    {
+        zenit_context_error(ctx, path_token.location, ZENIT_ERROR_FILE, "Cannot read the file '%s'", path);
+        fl_cstring_free(path);
+        return NULL;
+    }
+
+    ZenitBlobNode *blob_node = zenit_blob_node_new(incbin_token.location, path, bytes, length);
+    fl_cstring_free(path);
+
+    return (ZenitNode*) blob_node;
+}
+
 /*
  * Function: parse_unary_expression
  *  Parses a unary expression
@@ -750,7 +854,7 @@ static ZenitNode* parse_cast_expression(ZenitParser *parser, ZenitContext *ctx)
  *  ZenitNode* - Parsed unary expression
  * 
  * Grammar:
- *  unary_expression = cast_expression | array_literal | reference_expression | identifier_expression | literal_expression ;
+ *  unary_expression = cast_expression | incbin_expression | array_literal | reference_expression | identifier_expression | literal_expression ;
  *
  */
 static ZenitNode* parse_unary_expression(ZenitParser *parser, ZenitContext *ctx)
@@ -758,6 +862,9 @@ static ZenitNode* parse_unary_expression(ZenitParser *parser, ZenitContext *ctx)
     if (zenit_parser_next_is(parser, ZENIT_TOKEN_CAST))
         return parse_cast_expression(parser, ctx);
 
+    if (zenit_parser_next_is(parser, ZENIT_TOKEN_INCBIN))
+        return parse_incbin_expression(parser, ctx);
+
     if (zenit_parser_next_is(parser, ZENIT_TOKEN_LBRACKET))
         return parse_array_literal(parser, ctx);
 
@@ -1025,6 +1132,60 @@ static ZenitNode* parse_variable_declaration(ZenitParser *parser, ZenitContext *
     return NULL;
 }
 
+/*
+ * Function: parse_extern_declaration
+ *  Parses the declaration of a variable defined in another source file. The declaration does not
+ *  have an initializer, so the type information is required and it cannot be a partial type.
+ *
+ * Parameters:
+ *  <ZenitParser> *parser: Parser object
+ *  <ZenitContext> *ctx: Context object
+ *
+ * Returns:
+ *  ZenitNode* - Variable declaration node
+ * 
+ * Grammar:
+ *  extern_declaration = 'extern' 'var' ID ':' type_information ';' ;
+ *
+ */
+static ZenitNode* parse_extern_declaration(ZenitParser *parser, ZenitContext *ctx)
+{
+    ZenitToken extern_token;
+    ZenitToken name_token;
+
+    consume_or_return(ctx, parser, ZENIT_TOKEN_EXTERN, &extern_token);
+    consume_or_return(ctx, parser, ZENIT_TOKEN_VAR, NULL);
+
+    if (!zenit_parser_expects(parser, ZENIT_TOKEN_ID, &name_token))
+    {
+        zenit_context_error(ctx, ctx->srcinfo->location, ZENIT_ERROR_SYNTAX, "Missing variable name");
+        return NULL;
+    }
+
+    ZenitVariableNode *var_node = zenit_variable_node_new(extern_token.location, token_to_string(&name_token));
+
+    assert_or_return(ctx, var_node != NULL, ZENIT_ERROR_INTERNAL, "Could not initialize a variable node");
+
+    var_node->external = true;
+
+    // External variables do not accept attributes, but the passes expect a map
+    var_node->attributes = zenit_attribute_node_map_new();
+
+    // The type information is mandatory, there is no initializer to infer it from
+    consume_or_goto(ctx, parser, ZENIT_TOKEN_COLON, NULL, on_error);
+
+    var_node->type_decl = parse_type_declaration(parser, ctx, false);
+    assert_or_goto(ctx, var_node->type_decl != NULL, ZENIT_ERROR_SYNTAX, NULL, on_error);
+
+    consume_or_goto(ctx, parser, ZENIT_TOKEN_SEMICOLON, NULL, on_error);
+
+    return (ZenitNode*) var_node;
+
+    on_error: zenit_variable_node_free(var_node);
+
+    return NULL;
+}
+
 /*
  * Function: parse_struct_field_declaration
  *  Parses a struct member declaration
@@ -1279,7 +1440,7 @@ static ZenitAttributeNodeMap* parse_attribute_declaration_list(ZenitParser *pars
  * ZenitNode* - Parsed declaration node
  * 
  * Grammar:
- *  declaration = attribute_declaration* ( variable_declaration | struct_declaration ) | statement ;
+ *  declaration = attribute_declaration* ( variable_declaration | struct_declaration ) | extern_declaration | statement ;
  *
  */
 static ZenitNode* parse_declaration(ZenitParser *parser, ZenitContext *ctx)
@@ -1315,13 +1476,17 @@ static ZenitNode* parse_declaration(ZenitParser *parser, ZenitContext *ctx)
         return (ZenitNode*) struct_decl;
     }
 
-    // If the attribute map is not empty at this point, it means their usage is invalid
+    // If the attribute map is not empty at this point, it means their usage is invalid (the attributes of
+    // an external variable belong to its definition)
     if (zenit_attribute_node_map_length(attributes) > 0)
         zenit_context_error(ctx, location, ZENIT_ERROR_SYNTAX, "Invalid use of attributes");
         
     // At this point we always free the attributes map, no one will use it
     zenit_attribute_node_map_free(attributes);
 
+    if (zenit_parser_next_is(parser, ZENIT_TOKEN_EXTERN))
+        return parse_extern_declaration(parser, ctx);
+
     // If there are no variables or functions declarations, it is a statement
     return parse_statement(parser, ctx);
 
@@ -1347,8 +1512,8 @@ bool zenit_parse_source(ZenitContext *ctx)
     ZenitParser parser = zenit_parser_new(ctx->srcinfo);
 
     // Each iteration processes a declaration which is a subtree of the
-    // final AST object
-    while (zenit_parser_has_input(&parser))
+    // final AST object. If the context reaches its error limit, we stop
+    while (zenit_parser_has_input(&parser) && !zenit_context_error_limit_reached(ctx))
     {
         ZenitNode *declaration = parse_declaration(&parser, ctx);
 
@@ -1384,5 +1549,5 @@ bool zenit_parse_source(ZenitContext *ctx)
     ctx->ast = zenit_ast_new(decls);
     fl_list_free(templist);
 
-    return !ctx->errors;
+    return !zenit_context_has_errors(ctx);
 }
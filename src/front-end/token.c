@@ -5,6 +5,7 @@ static const char *TokenTypeString[] = {
     
     [ZENIT_TOKEN_INTEGER]       = "INTEGER",
     [ZENIT_TOKEN_BOOL]          = "BOOL",
+    [ZENIT_TOKEN_STRING]        = "STRING",
 
     [ZENIT_TOKEN_ID]            = "IDENTIFIER",
     [ZENIT_TOKEN_VAR]           = "VAR \"var\"",
@@ -12,6 +13,8 @@ static const char *TokenTypeString[] = {
     [ZENIT_TOKEN_CAST]          = "CAST \"cast\"",
     [ZENIT_TOKEN_IF]            = "IF \"if\"",
     [ZENIT_TOKEN_ELSE]          = "ELSE \"else\"",
+    [ZENIT_TOKEN_EXTERN]        = "EXTERN \"extern\"",
+    [ZENIT_TOKEN_INCBIN]        = "INCBIN \"incbin\"",
 
     [ZENIT_TOKEN_AMPERSAND]     = "AMPERSAND \"&\"",
     [ZENIT_TOKEN_ASSIGN]        = "ASSIGN \"=\"",
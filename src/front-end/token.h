@@ -14,6 +14,7 @@ typedef enum ZenitTokenType {
     // Types
     ZENIT_TOKEN_INTEGER,
     ZENIT_TOKEN_BOOL,
+    ZENIT_TOKEN_STRING,
 
     // Keywords
     ZENIT_TOKEN_ID,
@@ -22,6 +23,8 @@ typedef enum ZenitTokenType {
     ZENIT_TOKEN_CAST,
     ZENIT_TOKEN_IF,
     ZENIT_TOKEN_ELSE,
+    ZENIT_TOKEN_EXTERN,
+    ZENIT_TOKEN_INCBIN,
 
     // Operators
     ZENIT_TOKEN_AMPERSAND,
@@ -9,6 +9,7 @@ typedef ZenitSymbol*(*ZenitTypeChecker)(ZenitContext *ctx, ZenitNode *node);
 static ZenitSymbol* visit_node(ZenitContext *ctx, ZenitNode *node);
 static ZenitSymbol* visit_uint_node(ZenitContext *ctx, ZenitUintNode *uint_node);
 static ZenitSymbol* visit_bool_node(ZenitContext *ctx, ZenitBoolNode *bool_node);
+static ZenitSymbol* visit_blob_node(ZenitContext *ctx, ZenitBlobNode *blob_node);
 static ZenitSymbol* visit_variable_node(ZenitContext *ctx, ZenitVariableNode *variable_node);
 static ZenitSymbol* visit_array_node(ZenitContext *ctx, ZenitArrayNode *array_node);
 static ZenitSymbol* visit_identifier_node(ZenitContext *ctx, ZenitIdentifierNode *id_node);
@@ -27,6 +28,7 @@ static ZenitSymbol* visit_block_node(ZenitContext *ctx, ZenitBlockNode *block_no
 static const ZenitTypeChecker checkers[] = {
     [ZENIT_AST_NODE_UINT]           = (ZenitTypeChecker) &visit_uint_node,
     [ZENIT_AST_NODE_BOOL]           = (ZenitTypeChecker) &visit_bool_node,
+    [ZENIT_AST_NODE_BLOB]           = (ZenitTypeChecker) &visit_blob_node,
     [ZENIT_AST_NODE_VARIABLE]       = (ZenitTypeChecker) &visit_variable_node,
     [ZENIT_AST_NODE_ARRAY]          = (ZenitTypeChecker) &visit_array_node,
     [ZENIT_AST_NODE_IDENTIFIER]     = (ZenitTypeChecker) &visit_identifier_node,
@@ -104,6 +106,22 @@ static ZenitSymbol* visit_bool_node(ZenitContext *ctx, ZenitBoolNode *bool_node)
     return zenit_utils_get_tmp_symbol(ctx->program, (ZenitNode*) bool_node);
 }
 
+/*
+ * Function: visit_blob_node
+ *  The blob visitor doesn't need to check anything, it just returns the blob temporal symbol
+ *
+ * Parameters:
+ *  <ZenitContext> *ctx - Context object
+ *  <ZenitBlobNode> *blob_node - Node to visit
+ *
+ * Returns:
+ *  <ZenitSymbol>* - The blob symbol
+ */
+static ZenitSymbol* visit_blob_node(ZenitContext *ctx, ZenitBlobNode *blob_node)
+{
+    return zenit_utils_get_tmp_symbol(ctx->program, (ZenitNode*) blob_node);
+}
+
 /*
  * Function: visit_identifier_node
  *  It just returns the identifier symbol
@@ -225,6 +243,11 @@ static void visit_attribute_node_map(ZenitContext *ctx, ZenitAttributeNodeMap *a
         for (size_t j=0; j < fl_array_length(properties); j++)
         {
             ZenitPropertyNode *prop = properties[j];
+
+            // The names do not have a type (see the resolve pass)
+            if (zenit_utils_is_name_property(attr, prop))
+                continue;
+
             ZenitSymbol *prop_symbol = zenit_utils_get_tmp_symbol(ctx->program, (ZenitNode*) prop);
             visit_node(ctx, prop->value);
 
@@ -383,6 +406,10 @@ static ZenitSymbol* visit_variable_node(ZenitContext *ctx, ZenitVariableNode *va
             "Type '%s' is not defined", zenit_type_to_string(type));
     }
 
+    // External variables are initialized in the unit that defines them
+    if (variable_node->external)
+        return symbol;
+
     // We visit the right-hand side expression to do type checking with it
     ZenitSymbol* rhs_symbol = visit_node(ctx, variable_node->rvalue);
     
@@ -473,12 +500,12 @@ static ZenitSymbol* visit_node(ZenitContext *ctx, ZenitNode *node)
  */
 bool zenit_check_types(ZenitContext *ctx)
 {
-    if (!ctx || !ctx->ast || !ctx->ast->decls)
+    if (!ctx || !ctx->ast || !ctx->ast->decls || zenit_context_error_limit_reached(ctx))
         return false;
 
     size_t errors = zenit_context_error_count(ctx);
 
-    for (size_t i=0; i < fl_array_length(ctx->ast->decls); i++)
+    for (size_t i=0; i < fl_array_length(ctx->ast->decls) && !zenit_context_error_limit_reached(ctx); i++)
         visit_node(ctx, ctx->ast->decls[i]);
 
     return errors == zenit_context_error_count(ctx);
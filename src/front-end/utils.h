@@ -166,6 +166,15 @@ static inline ZenitSymbol* zenit_utils_get_update_symbol(ZenitProgram *program,
 }
 
 
+// The value of the segment property of the NES attribute is the name of a segment (#[NES(segment: zp)]), so it
+// does not refer to a symbol
+static inline bool zenit_utils_is_name_property(ZenitAttributeNode *attribute, ZenitPropertyNode *property)
+{
+    return flm_cstring_equals(attribute->name, "NES") 
+        && flm_cstring_equals(property->name, "segment") 
+        && property->value->nodekind == ZENIT_AST_NODE_IDENTIFIER;
+}
+
 static inline ZenitSymbol* zenit_utils_get_tmp_symbol(ZenitProgram *program, ZenitNode *node)
 {
     char *name = zenit_node_uid(node);
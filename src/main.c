@@ -1,59 +1,116 @@
-#include "front-end/type-check/check.h"
-#include "front-end/inference/infer.h"
-#include "front-end/parser/parse.h"
-#include "front-end/binding/resolve.h"
-#include "front-end/symtable.h"
-#include "front-end/codegen/zir.h"
-#include "back-end/nes/rp2a03/generate.h"
-#include "back-end/nes/ir/generate.h"
-#include "back-end/nes/rp2a03/rom.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "driver/driver.h"
+#include "back-end/nes/rp2a03/peephole.h"
+
+static void print_usage(const char *program)
+{
+    fprintf(stderr, "Usage: %s <input.zenit> <output.nes> [-O0|-O1|-O2] [--time-passes] [--report-dead-globals] [--no-peephole] "
+        "[--no-peephole-rule=<rule>] [--report-peephole] [--report-cost[=json]] [--error-limit=<n>] [--unit=<file>] "
+        "[--mapper=nrom|uxrom|mmc1] [--reset-clears-ram] [--watch[=<ms>]]\n", program);
+}
 
 int main(int argc, char **argv)
 {
     if (argc < 3)
+    {
+        print_usage(argv[0]);
         return -1;
+    }
 
-    ZenitContext zenit_context = zenit_context_new(ZENIT_SOURCE_FILE, argv[1]);
+    // Optional flags after the input and output files: -O0, -O1 (default), -O2, --time-passes, --report-dead-globals,
+    // --no-peephole, --no-peephole-rule=<rule>, --report-peephole, --report-cost, --report-cost=json, --error-limit=<n>,
+    // --unit=<file> (once per additional source file, each one is compiled as its own unit and then linked),
+    // --mapper=nrom|uxrom|mmc1 (the board of the ROM, NROM by default), --reset-clears-ram (the reset handler clears
+    // the RAM, the zero-initialized variables are not cleared again on startup) and --watch[=<ms>] (rebuilds the ROM
+    // each time a source file changes, polling every 250 ms by default)
+    ZenitDriverOptions options = zenit_driver_options_default();
+    ZenitDriver *driver = zenit_driver_new(options);
+    zenit_driver_add_file(driver, argv[1]);
 
-    if (!zenit_parse_source(&zenit_context)
-        || !zenit_resolve_symbols(&zenit_context)
-        || !zenit_infer_types(&zenit_context)
-        || !zenit_check_types(&zenit_context))
-    {
-        zenit_context_print_errors(&zenit_context);
-        return -2;
-    }
-    
-    ZirProgram *zir_program = zenit_generate_zir(&zenit_context);
+    bool watch = false;
+    unsigned long watch_interval = 250;
+    const char *invalid_flag = NULL;
 
-    if (!zir_program)
+    for (int i=3; i < argc; i++)
     {
-        zenit_context_print_errors(&zenit_context);
-        return -3;
+        invalid_flag = argv[i];
+
+        if (flm_cstring_equals(argv[i], "-O0"))
+            options.opt_level = ZIR_OPT_O0;
+        else if (flm_cstring_equals(argv[i], "-O1"))
+            options.opt_level = ZIR_OPT_O1;
+        else if (flm_cstring_equals(argv[i], "-O2"))
+            options.opt_level = ZIR_OPT_O2;
+        else if (flm_cstring_equals(argv[i], "--time-passes"))
+            options.time_passes = true;
+        else if (flm_cstring_equals(argv[i], "--report-dead-globals"))
+            options.report_dead_globals = true;
+        else if (flm_cstring_equals(argv[i], "--no-peephole"))
+            options.peephole_rules = 0;
+        else if (flm_cstring_equals(argv[i], "--report-peephole"))
+            options.report_peephole = true;
+        else if (flm_cstring_equals(argv[i], "--report-cost"))
+            options.report_cost = true;
+        else if (flm_cstring_equals(argv[i], "--report-cost=json"))
+            options.report_cost_json = true;
+        else if (flm_cstring_equals(argv[i], "--watch"))
+            watch = true;
+        else if (flm_cstring_equals(argv[i], "--mapper=nrom"))
+            options.mapper = ZNES_MAPPER_NROM;
+        else if (flm_cstring_equals(argv[i], "--mapper=uxrom"))
+            options.mapper = ZNES_MAPPER_UXROM;
+        else if (flm_cstring_equals(argv[i], "--mapper=mmc1"))
+            options.mapper = ZNES_MAPPER_MMC1;
+        else if (flm_cstring_equals(argv[i], "--reset-clears-ram"))
+            options.reset_clears_ram = true;
+        else if (strncmp(argv[i], "--no-peephole-rule=", strlen("--no-peephole-rule=")) == 0)
+        {
+            Rp2a03PeepholeRule rule;
+            if (!rp2a03_peephole_rule_parse(argv[i] + strlen("--no-peephole-rule="), &rule))
+                goto on_invalid_flag;
+
+            options.peephole_rules &= ~RP2A03_PEEPHOLE_RULE_FLAG(rule);
+        }
+        else if (strncmp(argv[i], "--error-limit=", strlen("--error-limit=")) == 0)
+        {
+            char *end = NULL;
+            options.error_limit = strtoul(argv[i] + strlen("--error-limit="), &end, 10);
+
+            if (end == argv[i] + strlen("--error-limit=") || *end != '\0')
+                goto on_invalid_flag;
+        }
+        else if (strncmp(argv[i], "--watch=", strlen("--watch=")) == 0)
+        {
+            char *end = NULL;
+            watch_interval = strtoul(argv[i] + strlen("--watch="), &end, 10);
+
+            if (end == argv[i] + strlen("--watch=") || *end != '\0' || watch_interval == 0)
+                goto on_invalid_flag;
+
+            watch = true;
+        }
+        else if (strncmp(argv[i], "--unit=", strlen("--unit=")) == 0 && argv[i][strlen("--unit=")] != '\0')
+            zenit_driver_add_file(driver, argv[i] + strlen("--unit="));
+        else
+            goto on_invalid_flag;
     }
 
-    ZnesContext *znes_context = znes_context_new(false);
+    driver->options = options;
 
-    if (!znes_generate_program(znes_context, zir_program))
-        return -4;
+    if (watch)
+        zenit_driver_watch(driver, argv[2], (unsigned int) watch_interval);
 
-    
-    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program);
+    ZenitDriverStatus status = zenit_driver_build(driver, argv[2]);
+    zenit_driver_free(driver);
 
-    if (!rp2a03_program)
-        return -4;
+    return status;
 
-    Rp2a03Rom *rom = rp2a03_rom_new(rp2a03_program);
+    on_invalid_flag: zenit_driver_free(driver);
 
-    if (!rom)
-        return -5;
+    fprintf(stderr, "Invalid flag '%s'\n", invalid_flag);
+    print_usage(argv[0]);
 
-    rp2a03_rom_dump(rom, argv[2]);
-    
-    rp2a03_rom_free(rom);
-    rp2a03_program_free(rp2a03_program);
-    znes_context_free(znes_context);
-    zir_program_free(zir_program);
-    zenit_context_free(&zenit_context);
-    return 0;
+    return -1;
 }
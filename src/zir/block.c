@@ -5,7 +5,7 @@ ZirBlock* zir_block_new(const char *id, ZirBlockType type, ZirBlock *parent)
 {
     ZirBlock *block = fl_malloc(sizeof(ZirBlock));
     block->parent = parent;
-    block->instructions = fl_array_new(sizeof(ZirInstr*), 0);
+    block->cfg = zir_cfg_new();
     block->children = fl_array_new(sizeof(ZirBlock*), 0);
     block->symtable = zir_symtable_new();
     block->temp_counter = 0;
@@ -31,13 +31,7 @@ void zir_block_free(ZirBlock *block)
         fl_array_free(block->children);
     }
 
-    if (block->instructions)
-    {
-        for (size_t i=0; i < fl_array_length(block->instructions); i++)
-            zir_instruction_free(block->instructions[i]);
-
-        fl_array_free(block->instructions);
-    }
+    zir_cfg_free(&block->cfg);
 
     zir_symtable_free(&block->symtable);
 
@@ -59,16 +53,23 @@ char* zir_block_dump(ZirBlock *block, char *output)
         fl_cstring_append(&output, " }\n");
     }
 
-    if (block->instructions)
-        for (size_t i=0; i < fl_array_length(block->instructions); i++)
-            output = zir_instruction_dump(block->instructions[i], output);
+    // The external symbols do not have instructions, the declaration is all we have
+    ZirSymbol **symbols = zir_symtable_get_all(&block->symtable);
 
-    return output;
-}
+    if (symbols)
+    {
+        for (size_t i=0; i < fl_array_length(symbols); i++)
+        {
+            if (symbols[i]->linkage == ZIR_LINKAGE_EXTERNAL)
+                fl_cstring_vappend(&output, "extern @%s : %s\n", symbols[i]->name, zir_type_to_string(symbols[i]->type));
+        }
 
-size_t zir_block_get_ip(ZirBlock *block)
-{
-    return fl_array_length(block->instructions);
+        fl_array_free(symbols);
+    }
+
+    output = zir_cfg_dump(&block->cfg, output);
+
+    return output;
 }
 
 bool zir_block_has_symbol(ZirBlock *block, const char *name)
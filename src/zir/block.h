@@ -2,10 +2,12 @@
 #define ZIR_BLOCK_H
 
 #include "symtable.h"
+#include "cfg.h"
 #include "instructions/instruction.h"
 #include "instructions/cast.h"
 #include "instructions/if-false.h"
 #include "instructions/jump.h"
+#include "instructions/phi.h"
 #include "instructions/variable.h"
 
 /*
@@ -21,13 +23,13 @@ typedef enum ZirBlockType {
 
 /*
  * Struct: zir_block_new
- *  A ZIR block represents a scope in the program that contains a symbol table and a set
- *  of instructions
+ *  A ZIR block represents a scope in the program that contains a symbol table and the
+ *  control flow graph of its instructions
  * 
  * Members:
  *  <ZirBlock> *parent: Pointer to the parent block
  *  <ZirBlock> **children: Set of children blocks
- *  <ZirInstr> **instructions: Set of block instructions
+ *  <ZirCfg> cfg: The basic blocks that contain the block instructions
  *  <ZirSymtable> symtable: Symbol table of the current block
  * 
  */
@@ -35,7 +37,7 @@ typedef struct ZirBlock {
     const char *id;
     struct ZirBlock *parent;
     struct ZirBlock **children;
-    ZirInstr **instructions;
+    ZirCfg cfg;
     ZirSymtable symtable;
     unsigned long long temp_counter;
     ZirBlockType type;
@@ -90,19 +92,6 @@ void zir_block_free(ZirBlock *block);
  */
 char* zir_block_dump(ZirBlock *block, char *output);
 
-/*
- * Function: zir_block_get_ip
- *  Returns the block's instruction pointer, which is the pointer to the last instruction
- *  within the block
- *
- * Parameters:
- *  block - The block object
- *
- * Returns:
- *  size_t - Instruction pointer value
- */
-size_t zir_block_get_ip(ZirBlock *block);
-
 /*
  * Function: zir_block_has_symbol
  *  Returns true if a symbol with the provided name exists in the block
@@ -0,0 +1,347 @@
+#include <fllib/Mem.h>
+#include <fllib/Array.h>
+#include <fllib/Cstring.h>
+#include "cfg.h"
+#include "instructions/if-false.h"
+#include "instructions/jump.h"
+#include "instructions/phi.h"
+
+static ZirBasicBlock* basic_block_new(void)
+{
+    ZirBasicBlock *block = fl_malloc(sizeof(ZirBasicBlock));
+    block->index = 0;
+    block->instructions = fl_array_new(sizeof(ZirInstr*), 0);
+    block->terminator = NULL;
+    block->successors = fl_array_new(sizeof(ZirBasicBlock*), 0);
+    block->predecessors = fl_array_new(sizeof(ZirBasicBlock*), 0);
+
+    return block;
+}
+
+static void basic_block_free(ZirBasicBlock *block)
+{
+    for (size_t i=0; i < fl_array_length(block->instructions); i++)
+        zir_instruction_free(block->instructions[i]);
+
+    fl_array_free(block->instructions);
+
+    if (block->terminator)
+        zir_instruction_free(block->terminator);
+
+    fl_array_free(block->successors);
+    fl_array_free(block->predecessors);
+    fl_free(block);
+}
+
+static void add_edge(ZirBasicBlock *from, ZirBasicBlock *to)
+{
+    // An if-false instruction that targets its fall-through block adds the same edge twice
+    for (size_t i=0; i < fl_array_length(from->successors); i++)
+        if (from->successors[i] == to)
+            return;
+
+    from->successors = fl_array_append(from->successors, &to);
+    to->predecessors = fl_array_append(to->predecessors, &from);
+}
+
+static bool falls_through(ZirBasicBlock *block)
+{
+    return block->terminator == NULL || block->terminator->type == ZIR_INSTR_IF_FALSE;
+}
+
+ZirCfg zir_cfg_new(void)
+{
+    ZirBasicBlock *entry = basic_block_new();
+
+    ZirCfg cfg = {
+        .blocks = fl_array_new(sizeof(ZirBasicBlock*), 0),
+        .current = entry
+    };
+
+    cfg.blocks = fl_array_append(cfg.blocks, &entry);
+
+    return cfg;
+}
+
+void zir_cfg_free(ZirCfg *cfg)
+{
+    if (!cfg || !cfg->blocks)
+        return;
+
+    for (size_t i=0; i < fl_array_length(cfg->blocks); i++)
+        basic_block_free(cfg->blocks[i]);
+
+    fl_array_free(cfg->blocks);
+    cfg->blocks = NULL;
+    cfg->current = NULL;
+}
+
+ZirBasicBlock* zir_cfg_new_basic_block(ZirCfg *cfg)
+{
+    return basic_block_new();
+}
+
+void zir_cfg_place_basic_block(ZirCfg *cfg, ZirBasicBlock *block)
+{
+    size_t length = fl_array_length(cfg->blocks);
+
+    if (length > 0 && falls_through(cfg->blocks[length - 1]))
+        add_edge(cfg->blocks[length - 1], block);
+
+    block->index = length;
+    cfg->blocks = fl_array_append(cfg->blocks, &block);
+    cfg->current = block;
+}
+
+void zir_cfg_insert_basic_block(ZirCfg *cfg, size_t index, ZirBasicBlock *block)
+{
+    size_t length = fl_array_length(cfg->blocks);
+
+    cfg->blocks = fl_array_resize(cfg->blocks, length + 1);
+    memmove(cfg->blocks + index + 1, cfg->blocks + index, sizeof(ZirBasicBlock*) * (length - index));
+    cfg->blocks[index] = block;
+
+    for (size_t i=index; i <= length; i++)
+        cfg->blocks[i]->index = i;
+}
+
+ZirInstr* zir_cfg_emit(ZirCfg *cfg, ZirInstr *instruction)
+{
+    // The current block is closed, the instruction starts a new one
+    if (cfg->current->terminator != NULL)
+        zir_cfg_place_basic_block(cfg, basic_block_new());
+
+    ZirBasicBlock *target = zir_cfg_terminator_target(instruction);
+
+    if (target != NULL)
+    {
+        cfg->current->terminator = instruction;
+        add_edge(cfg->current, target);
+    }
+    else
+    {
+        cfg->current->instructions = fl_array_append(cfg->current->instructions, &instruction);
+    }
+
+    return instruction;
+}
+
+ZirBasicBlock* zir_cfg_next_block(ZirCfg *cfg, ZirBasicBlock *block)
+{
+    if (block->index + 1 >= fl_array_length(cfg->blocks))
+        return NULL;
+
+    return cfg->blocks[block->index + 1];
+}
+
+ZirBasicBlock* zir_cfg_terminator_target(ZirInstr *terminator)
+{
+    if (terminator == NULL)
+        return NULL;
+
+    if (terminator->type == ZIR_INSTR_IF_FALSE)
+        return ((ZirIfFalseInstr*) terminator)->target;
+
+    if (terminator->type == ZIR_INSTR_JUMP)
+        return ((ZirJumpInstr*) terminator)->target;
+
+    return NULL;
+}
+
+void zir_cfg_update_edges(ZirCfg *cfg)
+{
+    size_t length = fl_array_length(cfg->blocks);
+
+    for (size_t i=0; i < length; i++)
+    {
+        ZirBasicBlock *block = cfg->blocks[i];
+        block->index = i;
+        fl_array_free(block->successors);
+        fl_array_free(block->predecessors);
+        block->successors = fl_array_new(sizeof(ZirBasicBlock*), 0);
+        block->predecessors = fl_array_new(sizeof(ZirBasicBlock*), 0);
+    }
+
+    for (size_t i=0; i < length; i++)
+    {
+        ZirBasicBlock *block = cfg->blocks[i];
+        ZirBasicBlock *target = zir_cfg_terminator_target(block->terminator);
+
+        if (target != NULL)
+            add_edge(block, target);
+
+        if (falls_through(block) && i + 1 < length)
+            add_edge(block, cfg->blocks[i + 1]);
+    }
+}
+
+/*
+ * Function: remove_unreachable_blocks
+ *  Walks the CFG from the entry block and removes the blocks that are not visited. The edges
+ *  must be up to date.
+ */
+static size_t remove_unreachable_blocks(ZirCfg *cfg)
+{
+    size_t length = fl_array_length(cfg->blocks);
+
+    bool *reachable = fl_malloc(sizeof(bool) * length);
+    memset(reachable, 0, sizeof(bool) * length);
+
+    // Every block is pushed at most once
+    ZirBasicBlock **stack = fl_malloc(sizeof(ZirBasicBlock*) * length);
+    size_t top = 0;
+
+    stack[top++] = cfg->blocks[0];
+    reachable[0] = true;
+
+    while (top > 0)
+    {
+        ZirBasicBlock *block = stack[--top];
+
+        for (size_t i=0; i < fl_array_length(block->successors); i++)
+        {
+            ZirBasicBlock *successor = block->successors[i];
+
+            if (reachable[successor->index])
+                continue;
+
+            reachable[successor->index] = true;
+            stack[top++] = successor;
+        }
+    }
+
+    // The phi instructions lose the sources that come from the removed blocks
+    for (size_t i=0; i < length; i++)
+    {
+        if (!reachable[i])
+            continue;
+
+        ZirBasicBlock *block = cfg->blocks[i];
+
+        for (size_t j=0; j < fl_array_length(block->instructions) && block->instructions[j]->type == ZIR_INSTR_PHI; j++)
+        {
+            ZirPhiInstr *phi = (ZirPhiInstr*) block->instructions[j];
+            size_t sources = 0;
+
+            for (size_t k=0; k < fl_array_length(phi->sources); k++)
+            {
+                if (!reachable[phi->blocks[k]->index])
+                    continue;
+
+                phi->sources[sources] = phi->sources[k];
+                phi->blocks[sources] = phi->blocks[k];
+                sources++;
+            }
+
+            phi->sources = fl_array_resize(phi->sources, sources);
+            phi->blocks = fl_array_resize(phi->blocks, sources);
+        }
+    }
+
+    size_t kept = 0;
+    for (size_t i=0; i < length; i++)
+    {
+        if (reachable[i])
+            cfg->blocks[kept++] = cfg->blocks[i];
+        else
+            basic_block_free(cfg->blocks[i]);
+    }
+
+    fl_free(stack);
+    fl_free(reachable);
+
+    if (kept < length)
+    {
+        cfg->blocks = fl_array_resize(cfg->blocks, kept);
+        zir_cfg_update_edges(cfg);
+    }
+
+    return length - kept;
+}
+
+size_t zir_cfg_simplify(ZirCfg *cfg)
+{
+    size_t removed = 0;
+    bool changed = true;
+
+    zir_cfg_update_edges(cfg);
+
+    while (changed)
+    {
+        size_t count = remove_unreachable_blocks(cfg);
+        changed = count > 0;
+        removed += count;
+
+        for (size_t i=0; i < fl_array_length(cfg->blocks); i++)
+        {
+            ZirBasicBlock *block = cfg->blocks[i];
+
+            if (block->terminator == NULL || block->terminator->type != ZIR_INSTR_JUMP)
+                continue;
+
+            if (zir_cfg_terminator_target(block->terminator) != zir_cfg_next_block(cfg, block))
+                continue;
+
+            zir_instruction_free(block->terminator);
+            block->terminator = NULL;
+            changed = true;
+        }
+
+        if (changed)
+            zir_cfg_update_edges(cfg);
+    }
+
+    cfg->current = cfg->blocks[fl_array_length(cfg->blocks) - 1];
+
+    return removed;
+}
+
+size_t zir_cfg_instruction_count(ZirCfg *cfg)
+{
+    size_t count = 0;
+
+    for (size_t i=0; i < fl_array_length(cfg->blocks); i++)
+        count += fl_array_length(cfg->blocks[i]->instructions) + (cfg->blocks[i]->terminator != NULL ? 1 : 0);
+
+    return count;
+}
+
+/*
+ * Function: needs_label
+ *  A block's label is printed if a terminator targets the block, or if a phi instruction references it
+ */
+static bool needs_label(ZirBasicBlock *block)
+{
+    for (size_t i=0; i < fl_array_length(block->predecessors); i++)
+        if (zir_cfg_terminator_target(block->predecessors[i]->terminator) == block)
+            return true;
+
+    for (size_t i=0; i < fl_array_length(block->successors); i++)
+    {
+        ZirBasicBlock *successor = block->successors[i];
+
+        if (fl_array_length(successor->instructions) > 0 && successor->instructions[0]->type == ZIR_INSTR_PHI)
+            return true;
+    }
+
+    return false;
+}
+
+char* zir_cfg_dump(ZirCfg *cfg, char *output)
+{
+    for (size_t i=0; i < fl_array_length(cfg->blocks); i++)
+    {
+        ZirBasicBlock *block = cfg->blocks[i];
+
+        if (needs_label(block))
+            fl_cstring_vappend(&output, "L%zu:\n", block->index);
+
+        for (size_t j=0; j < fl_array_length(block->instructions); j++)
+            output = zir_instruction_dump(block->instructions[j], output);
+
+        if (block->terminator)
+            output = zir_instruction_dump(block->terminator, output);
+    }
+
+    return output;
+}
@@ -0,0 +1,210 @@
+#ifndef ZIR_CFG_H
+#define ZIR_CFG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "instructions/instruction.h"
+
+/*
+ * Struct: ZirBasicBlock
+ *  A basic block is a sequence of instructions with a single entry point and a single exit point. The
+ *  last instruction of the block, the *terminator*, is the only one that can transfer the control to
+ *  another basic block. If the block does not have a terminator, or if the terminator is an if-false
+ *  instruction whose condition is truthy, the execution falls through to the next block in the layout.
+ *
+ * Members:
+ *  <size_t> index: Position of the block within the CFG layout, it is used as the block's label (L<index>)
+ *  <ZirInstr> **instructions: Set of instructions of the block, none of them is a terminator
+ *  <ZirInstr> *terminator: A jump or if-false instruction, or NULL if the block falls through
+ *  <struct ZirBasicBlock> **successors: Blocks that can receive the control from this block
+ *  <struct ZirBasicBlock> **predecessors: Blocks that can transfer the control to this block
+ */
+typedef struct ZirBasicBlock {
+    size_t index;
+    ZirInstr **instructions;
+    ZirInstr *terminator;
+    struct ZirBasicBlock **successors;
+    struct ZirBasicBlock **predecessors;
+} ZirBasicBlock;
+
+/*
+ * Struct: ZirCfg
+ *  The control flow graph of a ZIR block. The basic blocks are kept in layout order: the first one is
+ *  the entry block, and the fall-through successor of every block is the one that follows it.
+ *
+ * Members:
+ *  <ZirBasicBlock> **blocks: The basic blocks in layout order
+ *  <ZirBasicBlock> *current: The basic block that receives the emitted instructions
+ */
+typedef struct ZirCfg {
+    ZirBasicBlock **blocks;
+    ZirBasicBlock *current;
+} ZirCfg;
+
+/*
+ * Function: zir_cfg_new
+ *  Creates a new CFG that contains an empty entry block
+ *
+ * Parameters:
+ *  void: This function does not take parameters
+ *
+ * Returns:
+ *  <ZirCfg>: The created CFG
+ *
+ * Notes:
+ *  The object returned by this function must be freed using the
+ *  <zir_cfg_free> function
+ */
+ZirCfg zir_cfg_new(void);
+
+/*
+ * Function: zir_cfg_free
+ *  Releases the memory allocated in the *cfg* object, including its basic blocks and their instructions
+ *
+ * Parameters:
+ *  <ZirCfg> *cfg: The CFG to be freed
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void zir_cfg_free(ZirCfg *cfg);
+
+/*
+ * Function: zir_cfg_new_basic_block
+ *  Creates a basic block that is not part of the layout yet. The block can be used as the target of a
+ *  terminator before its instructions are emitted
+ *
+ * Parameters:
+ *  <ZirCfg> *cfg: The CFG
+ *
+ * Returns:
+ *  <ZirBasicBlock>*: The new basic block
+ *
+ * Notes:
+ *  The block must be added to the CFG with the <zir_cfg_place_basic_block> function, otherwise the
+ *  caller is responsible of its memory
+ */
+ZirBasicBlock* zir_cfg_new_basic_block(ZirCfg *cfg);
+
+/*
+ * Function: zir_cfg_place_basic_block
+ *  Appends the basic block to the layout of the CFG and makes it the current block. If the previous
+ *  block does not end with a jump, the new block becomes its fall-through successor
+ *
+ * Parameters:
+ *  <ZirCfg> *cfg: The CFG
+ *  <ZirBasicBlock> *block: The basic block created by <zir_cfg_new_basic_block>
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void zir_cfg_place_basic_block(ZirCfg *cfg, ZirBasicBlock *block);
+
+/*
+ * Function: zir_cfg_insert_basic_block
+ *  Inserts the basic block at the *index* position of the layout. The blocks that fall through to the
+ *  block at that position will fall through to the inserted block, the caller must update the
+ *  terminators and the edges (<zir_cfg_update_edges>) accordingly
+ *
+ * Parameters:
+ *  <ZirCfg> *cfg: The CFG
+ *  <size_t> index: Position of the new block within the layout, it cannot be 0 (the entry block)
+ *  <ZirBasicBlock> *block: The basic block created by <zir_cfg_new_basic_block>
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void zir_cfg_insert_basic_block(ZirCfg *cfg, size_t index, ZirBasicBlock *block);
+
+/*
+ * Function: zir_cfg_emit
+ *  Adds the instruction to the current basic block. If the instruction is a terminator, it closes
+ *  the current block, and the following instructions are emitted into a new block
+ *
+ * Parameters:
+ *  <ZirCfg> *cfg: The CFG
+ *  <ZirInstr> *instruction: The instruction to be added
+ *
+ * Returns:
+ *  <ZirInstr>*: The added instruction
+ */
+ZirInstr* zir_cfg_emit(ZirCfg *cfg, ZirInstr *instruction);
+
+/*
+ * Function: zir_cfg_next_block
+ *  Returns the fall-through successor of the block
+ *
+ * Parameters:
+ *  <ZirCfg> *cfg: The CFG
+ *  <ZirBasicBlock> *block: The basic block
+ *
+ * Returns:
+ *  <ZirBasicBlock>*: The next block in the layout, or NULL if *block* is the last one
+ */
+ZirBasicBlock* zir_cfg_next_block(ZirCfg *cfg, ZirBasicBlock *block);
+
+/*
+ * Function: zir_cfg_terminator_target
+ *  Returns the basic block targeted by a terminator instruction
+ *
+ * Parameters:
+ *  <ZirInstr> *terminator: A jump or if-false instruction
+ *
+ * Returns:
+ *  <ZirBasicBlock>*: The target basic block, or NULL if the instruction is not a terminator
+ */
+ZirBasicBlock* zir_cfg_terminator_target(ZirInstr *terminator);
+
+/*
+ * Function: zir_cfg_update_edges
+ *  Rebuilds the successors and predecessors lists of all the basic blocks, and the blocks' indexes.
+ *  Transformations that change terminators or remove blocks must call this function once they finish
+ *
+ * Parameters:
+ *  <ZirCfg> *cfg: The CFG
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void zir_cfg_update_edges(ZirCfg *cfg);
+
+/*
+ * Function: zir_cfg_simplify
+ *  Removes the basic blocks that cannot be reached from the entry block, and the jumps that target
+ *  the block that follows them in the layout
+ *
+ * Parameters:
+ *  <ZirCfg> *cfg: The CFG
+ *
+ * Returns:
+ *  size_t: The number of removed basic blocks
+ */
+size_t zir_cfg_simplify(ZirCfg *cfg);
+
+/*
+ * Function: zir_cfg_instruction_count
+ *  Returns the number of instructions in the CFG, terminators included
+ *
+ * Parameters:
+ *  <ZirCfg> *cfg: The CFG
+ *
+ * Returns:
+ *  size_t: Number of instructions
+ */
+size_t zir_cfg_instruction_count(ZirCfg *cfg);
+
+/*
+ * Function: zir_cfg_dump
+ *  Dumps the instructions of the CFG in layout order. The blocks that are targeted by a terminator
+ *  or referenced by a phi instruction are preceded by their label
+ *
+ * Parameters:
+ *  <ZirCfg> *cfg: The CFG
+ *  <char> *output: Output buffer
+ *
+ * Returns:
+ *  char*: *output* pointer
+ */
+char* zir_cfg_dump(ZirCfg *cfg, char *output);
+
+#endif /* ZIR_CFG_H */
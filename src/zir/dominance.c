@@ -0,0 +1,210 @@
+#include <fllib/Mem.h>
+#include <fllib/Array.h>
+#include "dominance.h"
+
+/*
+ * Function: compute_postorder
+ *  Numbers the blocks reachable from the entry block in postorder. The *order* array receives the blocks
+ *  sorted by their postorder number, and the *number* array (indexed by the blocks' index) receives their
+ *  postorder number. The function returns the number of reachable blocks.
+ */
+static size_t compute_postorder(ZirCfg *cfg, ZirBasicBlock **order, size_t *number, bool *visited)
+{
+    size_t count = fl_array_length(cfg->blocks);
+
+    // Iterative DFS: each entry of the stack keeps the block and the next successor to visit
+    ZirBasicBlock **stack = fl_malloc(sizeof(ZirBasicBlock*) * count);
+    size_t *next = fl_malloc(sizeof(size_t) * count);
+    size_t top = 0;
+    size_t visited_count = 0;
+
+    stack[top] = cfg->blocks[0];
+    next[top++] = 0;
+    visited[0] = true;
+
+    while (top > 0)
+    {
+        ZirBasicBlock *block = stack[top - 1];
+
+        if (next[top - 1] < fl_array_length(block->successors))
+        {
+            ZirBasicBlock *successor = block->successors[next[top - 1]++];
+
+            if (!visited[successor->index])
+            {
+                visited[successor->index] = true;
+                stack[top] = successor;
+                next[top++] = 0;
+            }
+
+            continue;
+        }
+
+        number[block->index] = visited_count;
+        order[visited_count++] = block;
+        top--;
+    }
+
+    fl_free(next);
+    fl_free(stack);
+
+    return visited_count;
+}
+
+static ZirBasicBlock* intersect(ZirBasicBlock **idom, size_t *number, ZirBasicBlock *a, ZirBasicBlock *b)
+{
+    while (a != b)
+    {
+        while (number[a->index] < number[b->index])
+            a = idom[a->index];
+
+        while (number[b->index] < number[a->index])
+            b = idom[b->index];
+    }
+
+    return a;
+}
+
+/*
+ * Function: zir_dominance_new
+ *  The immediate dominators are computed with the iterative algorithm described by Cooper, Harvey, and
+ *  Kennedy in "A Simple, Fast Dominance Algorithm": the blocks are visited in reverse postorder until
+ *  the immediate dominators do not change. The dominance frontiers are computed walking up the dominator
+ *  tree from the predecessors of every join point.
+ */
+ZirDominance* zir_dominance_new(ZirCfg *cfg)
+{
+    size_t count = fl_array_length(cfg->blocks);
+
+    ZirDominance *dominance = fl_malloc(sizeof(ZirDominance));
+    dominance->count = count;
+    dominance->idom = fl_malloc(sizeof(ZirBasicBlock*) * count);
+    dominance->children = fl_malloc(sizeof(ZirBasicBlock**) * count);
+    dominance->frontier = fl_malloc(sizeof(ZirBasicBlock**) * count);
+
+    for (size_t i=0; i < count; i++)
+    {
+        dominance->idom[i] = NULL;
+        dominance->children[i] = fl_array_new(sizeof(ZirBasicBlock*), 0);
+        dominance->frontier[i] = fl_array_new(sizeof(ZirBasicBlock*), 0);
+    }
+
+    ZirBasicBlock **order = fl_malloc(sizeof(ZirBasicBlock*) * count);
+    size_t *number = fl_malloc(sizeof(size_t) * count);
+    bool *reachable = fl_malloc(sizeof(bool) * count);
+    memset(reachable, 0, sizeof(bool) * count);
+
+    size_t reachable_count = compute_postorder(cfg, order, number, reachable);
+
+    ZirBasicBlock *entry = cfg->blocks[0];
+    dominance->idom[entry->index] = entry;
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+
+        // Reverse postorder, skipping the entry block (the last one in postorder)
+        for (size_t i = reachable_count - 1; i > 0; i--)
+        {
+            ZirBasicBlock *block = order[i - 1];
+            ZirBasicBlock *new_idom = NULL;
+
+            for (size_t j=0; j < fl_array_length(block->predecessors); j++)
+            {
+                ZirBasicBlock *predecessor = block->predecessors[j];
+
+                if (dominance->idom[predecessor->index] == NULL)
+                    continue;
+
+                new_idom = new_idom == NULL ? predecessor : intersect(dominance->idom, number, predecessor, new_idom);
+            }
+
+            if (dominance->idom[block->index] != new_idom)
+            {
+                dominance->idom[block->index] = new_idom;
+                changed = true;
+            }
+        }
+    }
+
+    for (size_t i=0; i < count; i++)
+    {
+        ZirBasicBlock *block = cfg->blocks[i];
+        ZirBasicBlock *idom = dominance->idom[i];
+
+        if (!reachable[i] || block == entry)
+            continue;
+
+        dominance->children[idom->index] = fl_array_append(dominance->children[idom->index], &block);
+
+        if (fl_array_length(block->predecessors) < 2)
+            continue;
+
+        for (size_t j=0; j < fl_array_length(block->predecessors); j++)
+        {
+            ZirBasicBlock *runner = block->predecessors[j];
+
+            if (!reachable[runner->index])
+                continue;
+
+            while (runner != idom)
+            {
+                ZirBasicBlock ***frontier = &dominance->frontier[runner->index];
+                bool found = false;
+
+                for (size_t k=0; k < fl_array_length(*frontier) && !found; k++)
+                    found = (*frontier)[k] == block;
+
+                if (!found)
+                    *frontier = fl_array_append(*frontier, &block);
+
+                runner = dominance->idom[runner->index];
+            }
+        }
+    }
+
+    fl_free(reachable);
+    fl_free(number);
+    fl_free(order);
+
+    return dominance;
+}
+
+void zir_dominance_free(ZirDominance *dominance)
+{
+    if (!dominance)
+        return;
+
+    for (size_t i=0; i < dominance->count; i++)
+    {
+        fl_array_free(dominance->children[i]);
+        fl_array_free(dominance->frontier[i]);
+    }
+
+    fl_free(dominance->children);
+    fl_free(dominance->frontier);
+    fl_free(dominance->idom);
+    fl_free(dominance);
+}
+
+bool zir_dominance_dominates(ZirDominance *dominance, ZirBasicBlock *a, ZirBasicBlock *b)
+{
+    ZirBasicBlock *runner = b;
+
+    while (runner != NULL)
+    {
+        if (runner == a)
+            return true;
+
+        ZirBasicBlock *idom = dominance->idom[runner->index];
+
+        // The entry block is its own immediate dominator
+        if (idom == runner)
+            break;
+
+        runner = idom;
+    }
+
+    return false;
+}
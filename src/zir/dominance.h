@@ -0,0 +1,71 @@
+#ifndef ZIR_DOMINANCE_H
+#define ZIR_DOMINANCE_H
+
+#include <stdbool.h>
+#include "cfg.h"
+
+/*
+ * Struct: ZirDominance
+ *  Dominance information of a CFG. A block *A* dominates a block *B* if every path from the entry block
+ *  to *B* goes through *A*. The immediate dominator of a block is its closest strict dominator, and the
+ *  dominance frontier of a block *A* contains the blocks where the dominance of *A* ends: the blocks that
+ *  have a predecessor dominated by *A* but are not strictly dominated by *A*.
+ *
+ * Members:
+ *  <size_t> count: Number of basic blocks, the arrays are indexed by the blocks' index
+ *  <ZirBasicBlock> **idom: The immediate dominator of each block. The entry block is its own immediate dominator,
+ *                          and the unreachable blocks do not have one (NULL)
+ *  <ZirBasicBlock> ***children: The children of each block in the dominator tree
+ *  <ZirBasicBlock> ***frontier: The dominance frontier of each block
+ */
+typedef struct ZirDominance {
+    size_t count;
+    ZirBasicBlock **idom;
+    ZirBasicBlock ***children;
+    ZirBasicBlock ***frontier;
+} ZirDominance;
+
+/*
+ * Function: zir_dominance_new
+ *  Computes the dominator tree and the dominance frontiers of the CFG. The edges of the CFG
+ *  must be up to date
+ *
+ * Parameters:
+ *  <ZirCfg> *cfg: The CFG
+ *
+ * Returns:
+ *  <ZirDominance>*: The dominance information
+ *
+ * Notes:
+ *  The object returned by this function must be freed using the
+ *  <zir_dominance_free> function. It is not updated if the CFG changes
+ */
+ZirDominance* zir_dominance_new(ZirCfg *cfg);
+
+/*
+ * Function: zir_dominance_free
+ *  Releases the memory used by the dominance object
+ *
+ * Parameters:
+ *  <ZirDominance> *dominance: The object to be freed
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void zir_dominance_free(ZirDominance *dominance);
+
+/*
+ * Function: zir_dominance_dominates
+ *  Returns *true* if the block *a* dominates the block *b*. A block dominates itself
+ *
+ * Parameters:
+ *  <ZirDominance> *dominance: The dominance information
+ *  <ZirBasicBlock> *a: The dominator block
+ *  <ZirBasicBlock> *b: The dominated block
+ *
+ * Returns:
+ *  bool: *true* if *a* dominates *b*, otherwise *false*
+ */
+bool zir_dominance_dominates(ZirDominance *dominance, ZirBasicBlock *a, ZirBasicBlock *b);
+
+#endif /* ZIR_DOMINANCE_H */
@@ -6,6 +6,7 @@ ZirCastInstr* zir_cast_instr_new(ZirOperand *destination, ZirOperand *source)
 {
     ZirCastInstr *instruction = fl_malloc(sizeof(ZirCastInstr));
     instruction->base.type = ZIR_INSTR_CAST;
+    instruction->base.origin = (ZirSourceOrigin) { 0 };
     instruction->base.destination = destination;
     instruction->source = source;
 
@@ -1,13 +1,16 @@
 #include <stdio.h>
 #include <fllib/Cstring.h>
 #include "if-false.h"
+#include "../cfg.h"
 
-ZirIfFalseInstr* zir_if_false_instr_new(ZirOperand *destination, ZirOperand *source)
+ZirIfFalseInstr* zir_if_false_instr_new(ZirOperand *source, struct ZirBasicBlock *target)
 {
     ZirIfFalseInstr *instruction = fl_malloc(sizeof(ZirIfFalseInstr));
     instruction->base.type = ZIR_INSTR_IF_FALSE;
-    instruction->base.destination = destination;
+    instruction->base.origin = (ZirSourceOrigin) { 0 };
+    instruction->base.destination = NULL;
     instruction->source = source;
+    instruction->target = target;
 
     return instruction;
 }
@@ -22,9 +25,7 @@ char* zir_if_false_instr_dump(ZirIfFalseInstr *if_false, char *output)
 
     fl_cstring_append(&output, "if_false ");
     output = zir_operand_dump(if_false->source, output);
-    fl_cstring_append(&output, " jump ");
-    output = zir_operand_dump(if_false->base.destination, output);
-    fl_cstring_append(&output, "\n");
+    fl_cstring_vappend(&output, " jump L%zu\n", if_false->target->index);
 
     return output;
 }
@@ -6,18 +6,23 @@
 #include "operands/symbol.h"
 #include "../types/type.h"
 
+struct ZirBasicBlock;
+
 /*
  * Struct: ZirIfFalseInstr
- *  The if-false instruction uses the *destination* operand to calculate the next jump if the 
- *  *source* operand is a non-truthy value. Otherwise, the execution of the program must flow normally
+ *  The if-false instruction terminates a basic block. If the *source* operand is a non-truthy value
+ *  the control is transferred to the *target* basic block, otherwise, the execution of the program 
+ *  falls through to the next basic block
  * 
  * Members:
  *  <ZirInstr> base: Basic information of the instruction
  *  <ZirOperand> *source: The source operand of the if-false instruction
+ *  <struct ZirBasicBlock> *target: The basic block that receives the control if the source is non-truthy
  */
 typedef struct ZirIfFalseInstr {
     ZirInstr base;
     ZirOperand *source;
+    struct ZirBasicBlock *target;
 } ZirIfFalseInstr;
 
 /*
@@ -25,8 +30,8 @@ typedef struct ZirIfFalseInstr {
  *  Creates and returns a new if-false instruction
  *
  * Parameters:
- *  <ZirOperand> *destination: The destination operand of the if-false instruction
  *  <ZirOperand> *source: The source operand of the if-false instruction
+ *  <struct ZirBasicBlock> *target: The basic block the instruction jumps to if the source is non-truthy
  *
  * Returns:
  *  <ZirIfFalseInstr>*: If-true instruction object
@@ -35,7 +40,7 @@ typedef struct ZirIfFalseInstr {
  *  The object returned by this function must be freed with the
  *  <zir_if_false_instr_free> function
  */
-ZirIfFalseInstr* zir_if_false_instr_new(ZirOperand *destination, ZirOperand *source);
+ZirIfFalseInstr* zir_if_false_instr_new(ZirOperand *source, struct ZirBasicBlock *target);
 
 /*
  * Function: zir_if_false_instr_free
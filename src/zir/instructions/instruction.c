@@ -3,6 +3,7 @@
 #include "cast.h"
 #include "if-false.h"
 #include "jump.h"
+#include "phi.h"
 #include "variable.h"
 
 void zir_instruction_free(ZirInstr *instruction)
@@ -24,6 +25,10 @@ void zir_instruction_free(ZirInstr *instruction)
         case ZIR_INSTR_JUMP:
             zir_jump_instr_free((ZirJumpInstr*) instruction);
             break;
+
+        case ZIR_INSTR_PHI:
+            zir_phi_instr_free((ZirPhiInstr*) instruction);
+            break;
     }
 }
 
@@ -42,6 +47,9 @@ char* zir_instruction_dump(ZirInstr *instruction, char *output)
 
         case ZIR_INSTR_JUMP:
             return zir_jump_instr_dump((ZirJumpInstr*) instruction, output);
+
+        case ZIR_INSTR_PHI:
+            return zir_phi_instr_dump((ZirPhiInstr*) instruction, output);
     }
 
     return output;
@@ -13,8 +13,29 @@ typedef enum ZirInstrType {
     ZIR_INSTR_IF_FALSE,
     ZIR_INSTR_CAST,
     ZIR_INSTR_JUMP,
+    ZIR_INSTR_PHI,
 } ZirInstrType;
 
+/*
+ * Struct: ZirSourceOrigin
+ *  The Zenit declaration or statement an instruction comes from. The strings are owned by the
+ *  front-end.
+ * 
+ * Members:
+ *  <const char> *declaration: The name of the declared variable, or the kind of statement ("if"). NULL if the
+ *                             instruction does not come from the source code (e.g. copies inserted by a pass)
+ *  <const char> *filename: The source file, NULL if the source is a string
+ *  <unsigned int> line: Line of the declaration
+ *  <unsigned int> col: Column of the declaration
+ * 
+ */
+typedef struct ZirSourceOrigin {
+    const char *declaration;
+    const char *filename;
+    unsigned int line;
+    unsigned int col;
+} ZirSourceOrigin;
+
 /*
  * Struct: ZirInstr
  *  Base object that contains basic information between the
@@ -23,11 +44,13 @@ typedef enum ZirInstrType {
  * Members:
  *  <ZirInstrType> type: Instruction's internal type
  *  <ZirOperand> *destination: The destination operand for the instruction's result
+ *  <ZirSourceOrigin> origin: The declaration the instruction comes from
  * 
  */
 typedef struct ZirInstr {
     ZirInstrType type;
     ZirOperand *destination;
+    ZirSourceOrigin origin;
 } ZirInstr;
 
 /*
@@ -1,12 +1,15 @@
 #include <stdio.h>
 #include <fllib/Cstring.h>
 #include "jump.h"
+#include "../cfg.h"
 
-ZirJumpInstr* zir_jump_instr_new(ZirOperand *destination)
+ZirJumpInstr* zir_jump_instr_new(struct ZirBasicBlock *target)
 {
     ZirJumpInstr *instruction = fl_malloc(sizeof(ZirJumpInstr));
     instruction->base.type = ZIR_INSTR_JUMP;
-    instruction->base.destination = destination;
+    instruction->base.origin = (ZirSourceOrigin) { 0 };
+    instruction->base.destination = NULL;
+    instruction->target = target;
 
     return instruction;
 }
@@ -16,11 +19,9 @@ void zir_jump_instr_free(ZirJumpInstr *instruction)
     fl_free(instruction);
 }
 
-char* zir_jump_instr_dump(ZirJumpInstr *cast, char *output)
+char* zir_jump_instr_dump(ZirJumpInstr *jump, char *output)
 {
-    fl_cstring_append(&output, "jump ");
-    output = zir_operand_dump(cast->base.destination, output);
-    fl_cstring_append(&output, "\n");
+    fl_cstring_vappend(&output, "jump L%zu\n", jump->target->index);
 
     return output;
 }
@@ -6,15 +6,19 @@
 #include "operands/symbol.h"
 #include "../types/type.h"
 
+struct ZirBasicBlock;
+
 /*
  * Struct: ZirJumpInstr
- *  The jump instruction changes the program's IP applying the *destination* operand as an offset
+ *  The jump instruction terminates a basic block transferring the control to the *target* basic block
  * 
  * Members:
  *  <ZirInstr> base: Basic information of the instruction
+ *  <struct ZirBasicBlock> *target: The basic block that receives the control
  */
 typedef struct ZirJumpInstr {
     ZirInstr base;
+    struct ZirBasicBlock *target;
 } ZirJumpInstr;
 
 /*
@@ -22,7 +26,7 @@ typedef struct ZirJumpInstr {
  *  Creates and returns a new jump instruction
  *
  * Parameters:
- *  <ZirOperand> *destination: The destination operand of the jump instruction
+ *  <struct ZirBasicBlock> *target: The basic block the jump instruction transfers the control to
  *
  * Returns:
  *  <ZirJumpInstr>*: Jump instruction object
@@ -31,7 +35,7 @@ typedef struct ZirJumpInstr {
  *  The object returned by this function must be freed with the
  *  <zir_jump_instr_free> function
  */
-ZirJumpInstr* zir_jump_instr_new(ZirOperand *destination);
+ZirJumpInstr* zir_jump_instr_new(struct ZirBasicBlock *target);
 
 /*
  * Function: zir_jump_instr_free
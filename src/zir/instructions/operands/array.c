@@ -5,14 +5,11 @@
 #include "array.h"
 #include "../../types/array.h"
 
-ZirArrayOperand* zir_array_operand_new(ZirArrayType *type)
+void zir_array_operand_init(ZirArrayOperand *operand, ZirArrayType *type)
 {
-    ZirArrayOperand *operand = fl_malloc(sizeof(ZirArrayOperand));
     operand->base.type = ZIR_OPERAND_ARRAY;
     operand->elements = fl_array_new(sizeof(ZirOperand*), 0);
     operand->type = type;
-
-    return operand;
 }
 
 void zir_array_operand_add_element(ZirArrayOperand *array_operand, ZirOperand *member_operand)
@@ -20,17 +17,12 @@ void zir_array_operand_add_element(ZirArrayOperand *array_operand, ZirOperand *m
     array_operand->elements = fl_array_append(array_operand->elements, &member_operand);
 }
 
-void zir_array_operand_free(ZirArrayOperand *array_operand)
+void zir_array_operand_release(ZirArrayOperand *array_operand)
 {
     if (!array_operand)
         return;
 
     fl_array_free(array_operand->elements);
-
-    if (array_operand->type)
-        zir_array_type_free(array_operand->type);
-
-    fl_free(array_operand);
 }
 
 char* zir_array_operand_dump(ZirArrayOperand *array, char *output)
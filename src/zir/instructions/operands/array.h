@@ -21,22 +21,23 @@ typedef struct ZirArrayOperand {
 } ZirArrayOperand;
 
 /*
- * Function: zir_array_operand_new
- *  Creates a new array operand object with an empty set of elements. The *type* object represents
+ * Function: zir_array_operand_init
+ *  Initializes an array operand object with an empty set of elements. The *type* object represents
  *  the type of each array member
  *
  * Parameters:
+ *  <ZirArrayOperand> *operand: The operand object to initialize
  *  <ZirArrayType> *type: The type of the array's members
  *
  * Returns:
- *  ZirArrayOperand*: The new array operand object
+ *  void: This function does not return a value
  *
  * Notes:
- *  The object returned by this function must be freed using the <zir_array_operand_free> function.
- *  The array operand takes ownership of the <ZirArrayType> object, which means it will release
- *  the type object memory too when <zir_array_operand_free> is called with the array operand as argument.
+ *  The operand's memory is owned by a <ZirOperandPool>, its resources must be released with
+ *  <zir_array_operand_release>.
+ *  The type object is not owned by the operand, it must be owned by a <ZirTypeContext>.
  */
-ZirArrayOperand* zir_array_operand_new(ZirArrayType *type);
+void zir_array_operand_init(ZirArrayOperand *operand, ZirArrayType *type);
 
 /*
  * Function: zir_array_operand_add_element
@@ -52,8 +53,8 @@ ZirArrayOperand* zir_array_operand_new(ZirArrayType *type);
 void zir_array_operand_add_element(ZirArrayOperand *array_operand, ZirOperand *operand);
 
 /*
- * Function: zir_array_operand_free
- *  Frees the memory of the array operand
+ * Function: zir_array_operand_release
+ *  Releases the resources owned by the array operand (the list of elements), but not the operand's memory
  *
  * Parameters:
  *  <ZirArrayOperand> *array_operand: Array operand object
@@ -61,7 +62,7 @@ void zir_array_operand_add_element(ZirArrayOperand *array_operand, ZirOperand *o
  * Returns:
  *  void: This function does not return a value
  */
-void zir_array_operand_free(ZirArrayOperand *array_operand);
+void zir_array_operand_release(ZirArrayOperand *array_operand);
 
 /*
  * Function: zir_array_operand_dump
@@ -0,0 +1,39 @@
+
+#include <string.h>
+#include <fllib/Mem.h>
+#include <fllib/Cstring.h>
+#include "blob.h"
+#include "../../types/array.h"
+
+void zir_blob_operand_init(ZirBlobOperand *operand, ZirArrayType *type, const char *path, const uint8_t *bytes, size_t length)
+{
+    operand->base.type = ZIR_OPERAND_BLOB;
+    operand->type = type;
+    operand->path = fl_cstring_dup(path);
+    operand->length = length;
+
+    // The AST that owns the original buffer might be released before the ZIR program
+    operand->bytes = fl_malloc(length + 1);
+    memcpy(operand->bytes, bytes, length);
+}
+
+void zir_blob_operand_release(ZirBlobOperand *blob_operand)
+{
+    if (!blob_operand)
+        return;
+
+    fl_cstring_free(blob_operand->path);
+    fl_free(blob_operand->bytes);
+}
+
+char* zir_blob_operand_dump(ZirBlobOperand *blob_operand, char *output)
+{
+    fl_cstring_vappend(&output, "incbin(\"%s\")", blob_operand->path);
+    return output;
+}
+
+char* zir_blob_operand_type_dump(ZirBlobOperand *blob_operand, char *output)
+{
+    fl_cstring_vappend(&output, "%s", zir_array_type_to_string(blob_operand->type));
+    return output;
+}
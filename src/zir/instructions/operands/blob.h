@@ -0,0 +1,105 @@
+#ifndef ZIR_OPERAND_BLOB_H
+#define ZIR_OPERAND_BLOB_H
+
+#include <stdint.h>
+#include "operand.h"
+#include "../../types/array.h"
+
+/*
+ * Struct: ZirBlobOperand
+ *  A blob operand holds the content of a binary file as a single buffer of bytes. Its type is an array of
+ *  uint8, but unlike the <ZirArrayOperand> it does not have an operand for each element
+ * 
+ * Members:
+ *  <ZirOperand> base: Basic operand information
+ *  <ZirArrayType> *type: The type of the blob, an array of uint8 with the length of the file
+ *  <char> *path: The path of the file as it is written in the source code
+ *  <uint8_t> *bytes: The content of the file
+ *  <size_t> length: The number of bytes of the file
+ */
+typedef struct ZirBlobOperand {
+    ZirOperand base;
+    ZirArrayType *type;
+    char *path;
+    uint8_t *bytes;
+    size_t length;
+} ZirBlobOperand;
+
+/*
+ * Function: zir_blob_operand_init
+ *  Initializes a blob operand with a copy of the path and the bytes of the file
+ *
+ * Parameters:
+ *  <ZirBlobOperand> *operand: The operand object to initialize
+ *  <ZirArrayType> *type: The type of the blob
+ *  <const char> *path: The path of the file
+ *  <const uint8_t> *bytes: The content of the file
+ *  <size_t> length: The number of bytes of the file
+ *
+ * Returns:
+ *  void: This function does not return a value
+ *
+ * Notes:
+ *  The operand's memory is owned by a <ZirOperandPool>, its resources must be released with
+ *  <zir_blob_operand_release>.
+ *  The type object is not owned by the operand, it must be owned by a <ZirTypeContext>.
+ */
+void zir_blob_operand_init(ZirBlobOperand *operand, ZirArrayType *type, const char *path, const uint8_t *bytes, size_t length);
+
+/*
+ * Function: zir_blob_operand_release
+ *  Releases the resources owned by the blob operand (the path and the bytes), but not the operand's memory
+ *
+ * Parameters:
+ *  <ZirBlobOperand> *blob_operand: Blob operand object
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void zir_blob_operand_release(ZirBlobOperand *blob_operand);
+
+/*
+ * Function: zir_blob_operand_dump
+ *  Dumps the string representation of the blob operand to the *output* pointer. The bytes are not
+ *  dumped, only the path of the file. Because the *output* pointer can be modified this function
+ *  returns the same pointer, so it is safe to use it as:
+ * 
+ * ==== C ====
+ *  output = zir_blob_operand_dump(blob_operand, output);
+ * ===========
+ *
+ * Parameters:
+ *  <ZirBlobOperand> *blob_operand: Blob operand object
+ *  <char> *output: Output buffer
+ *
+ * Returns:
+ *  <char>*: *output* pointer
+ *
+ * Notes:
+ *  If the reallocation of the *output* pointer fails, this function frees its memory.
+ */
+char* zir_blob_operand_dump(ZirBlobOperand *blob_operand, char *output);
+
+/*
+ * Function: zir_blob_operand_type_dump
+ *  Dumps the string representation of the type of the blob operand to the *output* 
+ *  pointer. Because the *output* pointer can be modified this function returns 
+ *  the same pointer, so it is safe to use it as:
+ * 
+ * ==== C ====
+ *  output = zir_blob_operand_type_dump(blob_operand, output);
+ * ===========
+ *
+ * Parameters:
+ *  <ZirBlobOperand> *blob_operand: Operand object
+ *  <char> *output: Output buffer
+ *
+ * Returns:
+ *  <char>*: *output* pointer
+ *
+ * Notes:
+ *  If the reallocation of the *output* pointer fails, this function frees its memory.
+ */
+char* zir_blob_operand_type_dump(ZirBlobOperand *blob_operand, char *output);
+
+#endif /* ZIR_OPERAND_BLOB_H */
@@ -3,25 +3,11 @@
 #include "bool.h"
 #include "../../types/bool.h"
 
-ZirBoolOperand* zir_bool_operand_new(ZirBoolType *type, bool value)
+void zir_bool_operand_init(ZirBoolOperand *bool_operand, ZirBoolType *type, bool value)
 {
-    ZirBoolOperand *bool_operand = fl_malloc(sizeof(ZirBoolOperand));
     bool_operand->base.type = ZIR_OPERAND_BOOL;
     bool_operand->value = value;
     bool_operand->type = type;
-
-    return bool_operand;
-}
-
-void zir_bool_operand_free(ZirBoolOperand *bool_operand)
-{
-    if (!bool_operand)
-        return;
-
-    if (bool_operand->type)
-        zir_bool_type_free(bool_operand->type);
-
-    fl_free(bool_operand);
 }
 
 char* zir_bool_operand_dump(ZirBoolOperand *bool_operand, char *output)
@@ -21,34 +21,22 @@ typedef struct ZirBoolOperand {
 } ZirBoolOperand;
 
 /*
- * Function: zir_bool_operand_new
- *  Creates a new boolean operand with the provided type, size, and value
+ * Function: zir_bool_operand_init
+ *  Initializes a boolean operand with the provided type and value
  *
  * Parameters:
+ *  <ZirBoolOperand> *bool_operand: The operand object to initialize
  *  <ZirBoolType> *type: The type of the boolean object
  *  <bool> value: The value of the boolean object
  *
  * Returns:
- *  ZirBoolOperand*: The new boolean operand object
+ *  void: This function does not return a value
  *
  * Notes:
- *  The object returned by this function must be freed using the <zir_bool_operand_free> function.
- *  The boolean operand takes ownership of the <ZirBoolType> object, which means it will release
- *  the type object memory too when <zir_bool_operand_free> is called with the boolean operand as argument.
- */
-ZirBoolOperand* zir_bool_operand_new(ZirBoolType *type, bool value);
-
-/*
- * Function: zir_bool_operand_free
- *  Frees the memory of the boolean operand
- *
- * Parameters:
- *  <ZirBoolOperand> *bool_operand: Bool operand object
- *
- * Returns:
- *  void: This function does not return a value
+ *  The operand's memory is owned by a <ZirOperandPool>.
+ *  The type object is not owned by the operand, it must be owned by a <ZirTypeContext>.
  */
-void zir_bool_operand_free(ZirBoolOperand *bool_operand);
+void zir_bool_operand_init(ZirBoolOperand *bool_operand, ZirBoolType *type, bool value);
 
 /*
  * Function: zir_bool_operand_dump
@@ -1,44 +1,12 @@
 #include "operand.h"
 #include "array.h"
+#include "blob.h"
 #include "bool.h"
 #include "uint.h"
 #include "reference.h"
 #include "struct.h"
 #include "symbol.h"
 
-void zir_operand_free(ZirOperand *operand)
-{
-    if (!operand)
-        return;
-
-    switch (operand->type)
-    {
-        case ZIR_OPERAND_UINT:
-            zir_uint_operand_free((ZirUintOperand*) operand);
-            break;
-
-        case ZIR_OPERAND_BOOL:
-            zir_bool_operand_free((ZirBoolOperand*) operand);
-            break;
-
-        case ZIR_OPERAND_ARRAY:
-            zir_array_operand_free((ZirArrayOperand*) operand);
-            break;
-
-        case ZIR_OPERAND_STRUCT:
-            zir_struct_operand_free((ZirStructOperand*) operand);
-            break;
-
-        case ZIR_OPERAND_SYMBOL:
-            zir_symbol_operand_free((ZirSymbolOperand*) operand);
-            break;
-
-        case ZIR_OPERAND_REFERENCE:
-            zir_reference_operand_free((ZirReferenceOperand*) operand);
-            break;
-    }
-}
-
 char* zir_operand_dump(ZirOperand *operand, char *output)
 {
     switch (operand->type)
@@ -52,6 +20,9 @@ char* zir_operand_dump(ZirOperand *operand, char *output)
         case ZIR_OPERAND_ARRAY:
             return zir_array_operand_dump((ZirArrayOperand*) operand, output);
 
+        case ZIR_OPERAND_BLOB:
+            return zir_blob_operand_dump((ZirBlobOperand*) operand, output);
+
         case ZIR_OPERAND_STRUCT:
             return zir_struct_operand_dump((ZirStructOperand*) operand, output);
 
@@ -78,6 +49,9 @@ char* zir_operand_type_dump(ZirOperand *operand, char *output)
         case ZIR_OPERAND_ARRAY:
             return zir_array_operand_type_dump((ZirArrayOperand*) operand, output);
 
+        case ZIR_OPERAND_BLOB:
+            return zir_blob_operand_type_dump((ZirBlobOperand*) operand, output);
+
         case ZIR_OPERAND_STRUCT:
             return zir_struct_operand_type_dump((ZirStructOperand*) operand, output);
 
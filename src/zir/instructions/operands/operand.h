@@ -12,6 +12,7 @@ typedef enum ZirOperandType {
     ZIR_OPERAND_UINT,
     ZIR_OPERAND_BOOL,
     ZIR_OPERAND_ARRAY,
+    ZIR_OPERAND_BLOB,
     ZIR_OPERAND_STRUCT,
     ZIR_OPERAND_SYMBOL,
     ZIR_OPERAND_REFERENCE
@@ -28,18 +29,6 @@ typedef struct ZirOperand {
     ZirOperandType type;
 } ZirOperand;
 
-/*
- * Function: zir_operand_free
- *  This function frees the memory used by the operand object
- *
- * Parameters:
- *  <ZirOperand> *operand: Operand object from where to free some members based on the <ZirOperandType>
- *
- * Returns:
- *  <void>: This function does not return a value
- */
-void zir_operand_free(ZirOperand *operand);
-
 /*
  * Function: zir_operand_dump
  *  Dumps the string representation of the operand to the *output* pointer. Because
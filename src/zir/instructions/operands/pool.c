@@ -1,60 +1,136 @@
+#include <stdio.h>
+#include <fllib/containers/Hashtable.h>
 #include "pool.h"
 #include "operand.h"
 
 ZirOperandPool* zir_operand_pool_new(void)
 {
     ZirOperandPool *pool = fl_malloc(sizeof(ZirOperandPool));
-    pool->operands = fl_list_new_args((struct FlListArgs) {
-        .value_cleaner = (FlContainerCleanupFn) zir_operand_free
+    pool->arrays = zir_slab_new(sizeof(ZirArrayOperand));
+    pool->blobs = zir_slab_new(sizeof(ZirBlobOperand));
+    pool->structs = zir_slab_new(sizeof(ZirStructOperand));
+    pool->references = zir_slab_new(sizeof(ZirReferenceOperand));
+    pool->symbols = zir_slab_new(sizeof(ZirSymbolOperand));
+    pool->uints = zir_slab_new(sizeof(ZirUintOperand));
+    pool->bools = zir_slab_new(sizeof(ZirBoolOperand));
+
+    // The operands are owned by the slabs, the hashtable only indexes the constants
+    pool->constants = fl_hashtable_new_args((struct FlHashtableArgs) {
+        .hash_function = fl_hashtable_hash_string,
+        .key_allocator = fl_container_allocator_string,
+        .key_comparer = fl_container_equals_string,
+        .key_cleaner = fl_container_cleaner_pointer,
+        .value_cleaner = NULL,
+        .value_allocator = NULL
+    });
+
+    pool->names = fl_hashtable_new_args((struct FlHashtableArgs) {
+        .hash_function = fl_hashtable_hash_string,
+        .key_allocator = fl_container_allocator_string,
+        .key_comparer = fl_container_equals_string,
+        .key_cleaner = fl_container_cleaner_pointer,
+        .value_cleaner = (FlContainerCleanupFn) zir_symbol_free,
+        .value_allocator = NULL
     });
 
     return pool;
 }
+
 void zir_operand_pool_free(ZirOperandPool *pool)
 {
-    fl_list_free(pool->operands);
+    fl_hashtable_free(pool->constants);
+    fl_hashtable_free(pool->names);
+
+    // Only the arrays, blobs and structs own resources besides their memory
+    zir_slab_free(&pool->arrays, (ZirSlabCleanupFn) zir_array_operand_release);
+    zir_slab_free(&pool->blobs, (ZirSlabCleanupFn) zir_blob_operand_release);
+    zir_slab_free(&pool->structs, (ZirSlabCleanupFn) zir_struct_operand_release);
+    zir_slab_free(&pool->references, NULL);
+    zir_slab_free(&pool->symbols, NULL);
+    zir_slab_free(&pool->uints, NULL);
+    zir_slab_free(&pool->bools, NULL);
+
     fl_free(pool);
 }
 
 ZirArrayOperand* zir_operand_pool_new_array(ZirOperandPool *pool, ZirArrayType *type)
 {
-    ZirArrayOperand *array_operand = zir_array_operand_new(type);
-    fl_list_append(pool->operands, array_operand);
+    ZirArrayOperand *array_operand = zir_slab_alloc(&pool->arrays);
+    zir_array_operand_init(array_operand, type);
     return array_operand;
 }
 
+ZirBlobOperand* zir_operand_pool_new_blob(ZirOperandPool *pool, ZirArrayType *type, const char *path, const uint8_t *bytes, size_t length)
+{
+    ZirBlobOperand *blob_operand = zir_slab_alloc(&pool->blobs);
+    zir_blob_operand_init(blob_operand, type, path, bytes, length);
+    return blob_operand;
+}
+
 ZirStructOperand* zir_operand_pool_new_struct(ZirOperandPool *pool, ZirStructType *type)
 {
-    ZirStructOperand *struct_operand = zir_struct_operand_new(type);
-    fl_list_append(pool->operands, struct_operand);
+    ZirStructOperand *struct_operand = zir_slab_alloc(&pool->structs);
+    zir_struct_operand_init(struct_operand, type);
     return struct_operand;
 }
 
 ZirReferenceOperand* zir_operand_pool_new_reference(ZirOperandPool *pool, ZirReferenceType *type, ZirSymbolOperand *operand)
 {
-    ZirReferenceOperand *reference_operand = zir_reference_operand_new(type, operand);
-    fl_list_append(pool->operands, reference_operand);
+    ZirReferenceOperand *reference_operand = zir_slab_alloc(&pool->references);
+    zir_reference_operand_init(reference_operand, type, operand);
     return reference_operand;
 }
 
 ZirSymbolOperand* zir_operand_pool_new_symbol(ZirOperandPool *pool, ZirSymbol *symbol)
 {
-    ZirSymbolOperand *symbol_operand = zir_symbol_operand_new(symbol);
-    fl_list_append(pool->operands, symbol_operand);
+    ZirSymbolOperand *symbol_operand = zir_slab_alloc(&pool->symbols);
+    zir_symbol_operand_init(symbol_operand, symbol);
     return symbol_operand;
 }
 
+ZirSymbolOperand* zir_operand_pool_new_name(ZirOperandPool *pool, const char *name)
+{
+    ZirSymbol *symbol = fl_hashtable_get(pool->names, name);
+
+    if (symbol == NULL)
+    {
+        symbol = zir_symbol_new(name, NULL);
+        fl_hashtable_add(pool->names, name, symbol);
+    }
+
+    return zir_operand_pool_new_symbol(pool, symbol);
+}
+
 ZirUintOperand* zir_operand_pool_new_uint(ZirOperandPool *pool, ZirUintType *type, ZirUintValue value)
 {
-    ZirUintOperand *uint_operand = zir_uint_operand_new(type, value);
-    fl_list_append(pool->operands, uint_operand);
+    // The types are interned, so the type's address identifies the size
+    char key[64] = { 0 };
+    snprintf(key, sizeof(key), "uint:%p:%u", (void*) type, type->size == ZIR_UINT_8 ? value.uint8 : value.uint16);
+
+    ZirUintOperand *uint_operand = fl_hashtable_get(pool->constants, key);
+
+    if (uint_operand != NULL)
+        return uint_operand;
+
+    uint_operand = zir_slab_alloc(&pool->uints);
+    zir_uint_operand_init(uint_operand, type, value);
+    fl_hashtable_add(pool->constants, key, uint_operand);
     return uint_operand;
 }
 
 ZirBoolOperand* zir_operand_pool_new_bool(ZirOperandPool *pool, ZirBoolType *type, bool value)
 {
-    ZirBoolOperand *bool_operand = zir_bool_operand_new(type, value);
-    fl_list_append(pool->operands, bool_operand);
+    char key[64] = { 0 };
+    snprintf(key, sizeof(key), "bool:%p:%d", (void*) type, value);
+
+    ZirBoolOperand *bool_operand = fl_hashtable_get(pool->constants, key);
+
+    if (bool_operand != NULL)
+        return bool_operand;
+
+    bool_operand = zir_slab_alloc(&pool->bools);
+    zir_bool_operand_init(bool_operand, type, value);
+    fl_hashtable_add(pool->constants, key, bool_operand);
     return bool_operand;
 }
 
@@ -3,21 +3,41 @@
 
 
 #include "array.h"
+#include "blob.h"
 #include "bool.h"
 #include "reference.h"
 #include "struct.h"
 #include "symbol.h"
 #include "uint.h"
+#include "../../slab.h"
 
 /*
  * Struct: ZirOperandPool
- *  An object that keeps track of the creation of operand objects
+ *  An object that keeps track of the creation of operand objects. The operands of each kind are
+ *  allocated from their own <ZirSlab>, and they are all released at once by <zir_operand_pool_free>
  * 
  * Members:
- *  <FlList> *operands: The list of created operands
+ *  <ZirSlab> arrays: The array operands
+ *  <ZirSlab> blobs: The blob operands
+ *  <ZirSlab> structs: The struct operands
+ *  <ZirSlab> references: The reference operands
+ *  <ZirSlab> symbols: The symbol operands
+ *  <ZirSlab> uints: The uint operands
+ *  <ZirSlab> bools: The boolean operands
+ *  <FlHashtable> *constants: The uint and boolean operands indexed by type and value, so that
+ *                            each constant is created once
+ *  <FlHashtable> *names: The symbols of the name operands indexed by name, the pool owns them
  */
 typedef struct ZirOperandPool {
-    FlList *operands;
+    ZirSlab arrays;
+    ZirSlab blobs;
+    ZirSlab structs;
+    ZirSlab references;
+    ZirSlab symbols;
+    ZirSlab uints;
+    ZirSlab bools;
+    FlHashtable *constants;
+    FlHashtable *names;
 } ZirOperandPool;
 
 /*
@@ -66,6 +86,27 @@ void zir_operand_pool_free(ZirOperandPool *pool);
  */
 ZirArrayOperand* zir_operand_pool_new_array(ZirOperandPool *pool, ZirArrayType *type);
 
+/*
+ * Function: zir_operand_pool_new_blob
+ *  Creates a new blob operand with a copy of the content of a binary file and adds it to the pool
+ *
+ * Parameters:
+ *  <ZirOperandPool> *pool: The pool object
+ *  <ZirArrayType> *type: The type of the blob, an array of uint8 with the length of the file
+ *  <const char> *path: The path of the file
+ *  <const uint8_t> *bytes: The content of the file
+ *  <size_t> length: The number of bytes of the file
+ *
+ * Returns:
+ *  ZirBlobOperand*: The blob operand
+ *
+ * Notes:
+ *  The pool object takes ownership of the <ZirBlobOperand> object, which means it will release
+ *  the blob operand memory and its copy of the bytes when the <zir_operand_pool_free> function is
+ *  called with the pool object as argument.
+ */
+ZirBlobOperand* zir_operand_pool_new_blob(ZirOperandPool *pool, ZirArrayType *type, const char *path, const uint8_t *bytes, size_t length);
+
 /*
  * Function: zir_operand_pool_new_struct
  *  Creates a new struct operand and adds it to the pool
@@ -121,9 +162,29 @@ ZirReferenceOperand* zir_operand_pool_new_reference(ZirOperandPool *pool, ZirRef
  */
 ZirSymbolOperand* zir_operand_pool_new_symbol(ZirOperandPool *pool, ZirSymbol *symbol);
 
+/*
+ * Function: zir_operand_pool_new_name
+ *  Creates a new symbol operand for a plain name, like the identifiers used as the values of the
+ *  attribute properties (e.g. the segment in #[NES(segment: zp)]). The symbol of a name does not belong
+ *  to any symbol table and it does not have a type.
+ *
+ * Parameters:
+ *  <ZirOperandPool> *pool: The pool object
+ *  <const char> *name: The name
+ *
+ * Returns:
+ *  ZirSymbolOperand*: The symbol operand
+ *
+ * Notes:
+ *  The pool object takes ownership of the <ZirSymbolOperand> object and its symbol, the names are
+ *  created once and shared by all the operands that use them.
+ */
+ZirSymbolOperand* zir_operand_pool_new_name(ZirOperandPool *pool, const char *name);
+
 /*
  * Function: zir_operand_pool_new_uint
- *  Creates a new uint operand and adds it to the pool
+ *  Returns the uint operand with the provided type and value, creating it and adding it to the pool the
+ *  first time it is requested
  *
  * Parameters:
  *  <ZirOperandPool> *pool: The pool object
@@ -137,12 +198,15 @@ ZirSymbolOperand* zir_operand_pool_new_symbol(ZirOperandPool *pool, ZirSymbol *s
  *  The pool object takes ownership of the <ZirUintOperand> object, which means it will release
  *  the uint operand memory when the <zir_operand_pool_free> function is called with the pool object 
  *  as argument.
+ *  Constant operands are shared: they must not be modified, and two constants are equals if and only if
+ *  they are the same object (as long as their types come from the same <ZirTypeContext>).
  */
 ZirUintOperand* zir_operand_pool_new_uint(ZirOperandPool *pool, ZirUintType *type, ZirUintValue value);
 
 /*
  * Function: zir_operand_pool_new_bool
- *  Creates a new boolean operand and adds it to the pool
+ *  Returns the boolean operand with the provided type and value, creating it and adding it to the pool
+ *  the first time it is requested
  *
  * Parameters:
  *  <ZirOperandPool> *pool: The pool object
@@ -156,6 +220,7 @@ ZirUintOperand* zir_operand_pool_new_uint(ZirOperandPool *pool, ZirUintType *typ
  *  The pool object takes ownership of the <ZirBoolOperand> object, which means it will release
  *  the boolean operand memory when the <zir_operand_pool_free> function is called with the pool object 
  *  as argument.
+ *  Constant operands are shared, see <zir_operand_pool_new_uint>.
  */
 ZirBoolOperand* zir_operand_pool_new_bool(ZirOperandPool *pool, ZirBoolType *type, bool value);
 
@@ -21,35 +21,23 @@ typedef struct ZirReferenceOperand {
 } ZirReferenceOperand;
 
 /*
- * Function: zir_reference_operand_new
- *  Creates a new reference operand object that references the symbol pointed by the symbol operand. The
+ * Function: zir_reference_operand_init
+ *  Initializes a reference operand object that references the symbol pointed by the symbol operand. The
  *  *type* object is the reference's type
  *
  * Parameters:
+ *  <ZirReferenceOperand> *reference: The operand object to initialize
  *  <ZirReferenceType> *type: The type of the reference
  *  <ZirSymbolOperand> *operand: The referenced symbol operand
  *
  * Returns:
- *  ZirReferenceOperand*: The new reference operand object
+ *  void: This function does not return a value
  *
  * Notes:
- *  The object returned by this function must be freed using the <zir_reference_operand_free> function.
- *  The reference operand takes ownership of the <ZirReferenceType> object, which means it will release
- *  the type object memory too when <zir_reference_operand_free> is called with the reference operand as argument.
- */
-ZirReferenceOperand* zir_reference_operand_new(ZirReferenceType *type, ZirSymbolOperand *operand);
-
-/*
- * Function: zir_reference_operand_free
- *  Frees the memory of the reference operand
- *
- * Parameters:
- *  <ZirReferenceOperand> *reference_operand: Reference operand object
- *
- * Returns:
- *  void: This function does not return a value
+ *  The operand's memory is owned by a <ZirOperandPool>.
+ *  The type object is not owned by the operand, it must be owned by a <ZirTypeContext>.
  */
-void zir_reference_operand_free(ZirReferenceOperand *reference_operand);
+void zir_reference_operand_init(ZirReferenceOperand *reference, ZirReferenceType *type, ZirSymbolOperand *operand);
 
 /*
  * Function: zir_reference_operand_dump
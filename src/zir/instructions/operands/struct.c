@@ -18,14 +18,11 @@ static void member_free(void *ptr)
     fl_free(member);
 }
 
-ZirStructOperand* zir_struct_operand_new(ZirStructType *type)
+void zir_struct_operand_init(ZirStructOperand *operand, ZirStructType *type)
 {
-    ZirStructOperand *operand = fl_malloc(sizeof(ZirStructOperand));
     operand->base.type = ZIR_OPERAND_STRUCT;
     operand->members = fl_array_new(sizeof(ZirOperand*), 0);
     operand->type = type;
-
-    return operand;
 }
 
 void zir_struct_operand_add_member(ZirStructOperand *struct_operand, const char *name, ZirOperand *member_operand)
@@ -36,17 +33,12 @@ void zir_struct_operand_add_member(ZirStructOperand *struct_operand, const char
     struct_operand->members = fl_array_append(struct_operand->members, &member);
 }
 
-void zir_struct_operand_free(ZirStructOperand *struct_operand)
+void zir_struct_operand_release(ZirStructOperand *struct_operand)
 {
     if (!struct_operand)
         return;
 
     fl_array_free_each_pointer(struct_operand->members, member_free);
-
-    if (struct_operand->type)
-        zir_struct_type_free(struct_operand->type);
-
-    fl_free(struct_operand);
 }
 
 char* zir_struct_operand_dump(ZirStructOperand *struct_operand, char *output)
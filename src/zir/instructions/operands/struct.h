@@ -26,22 +26,23 @@ typedef struct ZirStructOperand {
 } ZirStructOperand;
 
 /*
- * Function: zir_struct_operand_new
- *  Creates a new struct operand object with an empty set of members. The *type* object represents
+ * Function: zir_struct_operand_init
+ *  Initializes a struct operand object with an empty set of members. The *type* object represents
  *  the type of the struct operand
  *
  * Parameters:
+ *  <ZirStructOperand> *operand: The operand object to initialize
  *  <ZirStructType> *type: The type of the struct operand
  *
  * Returns:
- *  ZirStructOperand*: The new struct operand object
+ *  void: This function does not return a value
  *
  * Notes:
- *  The object returned by this function must be freed using the <zir_struct_operand_free> function.
- *  The struct operand takes ownership of the <ZirStructType> object, which means it will release
- *  the type object memory too when <zir_struct_operand_free> is called with the struct operand as argument.
+ *  The operand's memory is owned by a <ZirOperandPool>, its resources must be released with
+ *  <zir_struct_operand_release>.
+ *  The type object is not owned by the operand, it must be owned by a <ZirTypeContext>.
  */
-ZirStructOperand* zir_struct_operand_new(ZirStructType *type);
+void zir_struct_operand_init(ZirStructOperand *operand, ZirStructType *type);
 
 /*
  * Function: zir_struct_operand_add_member
@@ -58,8 +59,8 @@ ZirStructOperand* zir_struct_operand_new(ZirStructType *type);
 void zir_struct_operand_add_member(ZirStructOperand *struct_operand, const char *name, ZirOperand *operand);
 
 /*
- * Function: zir_struct_operand_free
- *  Frees the memory of the struct operand
+ * Function: zir_struct_operand_release
+ *  Releases the resources owned by the struct operand (the list of members), but not the operand's memory
  *
  * Parameters:
  *  <ZirStructOperand> *struct_operand: Struct operand object
@@ -67,7 +68,7 @@ void zir_struct_operand_add_member(ZirStructOperand *struct_operand, const char
  * Returns:
  *  void: This function does not return a value
  */
-void zir_struct_operand_free(ZirStructOperand *struct_operand);
+void zir_struct_operand_release(ZirStructOperand *struct_operand);
 
 /*
  * Function: zir_struct_operand_dump
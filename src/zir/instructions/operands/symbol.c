@@ -2,28 +2,22 @@
 #include <fllib/Cstring.h>
 #include "symbol.h"
 
-ZirSymbolOperand* zir_symbol_operand_new(ZirSymbol *symbol)
+void zir_symbol_operand_init(ZirSymbolOperand *operand, ZirSymbol *symbol)
 {
     flm_assert(symbol != NULL, "Symbol must not be NULL");
 
-    ZirSymbolOperand *operand = fl_malloc(sizeof(ZirSymbolOperand));
     operand->base.type = ZIR_OPERAND_SYMBOL;
     operand->symbol = symbol;
-
-    return operand;
-}
-
-void zir_symbol_operand_free(ZirSymbolOperand *operand)
-{
-    if (!operand)
-        return;
-
-    fl_free(operand);
+    operand->version = 0;
 }
 
 char* zir_symbol_operand_dump(ZirSymbolOperand *operand, char *output)
 {
     fl_cstring_vappend(&output, "%s%s", operand->symbol->name && operand->symbol->name[0] == '%' ? "" : "@", operand->symbol->name);
+
+    if (operand->version > 0)
+        fl_cstring_vappend(&output, ".%u", operand->version);
+
     return output;
 }
 
@@ -11,38 +11,29 @@
  * Members:
  *  <ZirOperand> base: Basic operand information
  *  <ZirSymbol> *symbol: The symbol object
+ *  <unsigned int> version: In SSA form, the definition of the symbol the operand refers to (0 if the operand is not versioned)
  */
 typedef struct ZirSymbolOperand {
     ZirOperand base;
     ZirSymbol *symbol;
+    unsigned int version;
 } ZirSymbolOperand;
 
 /*
- * Function: zir_symbol_operand_new
- *  Creates a new symbol operand object
+ * Function: zir_symbol_operand_init
+ *  Initializes a symbol operand object
  *
  * Parameters:
+ *  <ZirSymbolOperand> *operand: The operand object to initialize
  *  <ZirSymbol> *symbol: The symbol object
  *
  * Returns:
- *  ZirSymbolOperand*: The new symbol operand object
+ *  void: This function does not return a value
  *
  * Notes:
- *  The object returned by this function must be freed using the <zir_symbol_operand_free> function.
- */
-ZirSymbolOperand* zir_symbol_operand_new(ZirSymbol *symbol);
-
-/*
- * Function: zir_symbol_operand_free
- *  Frees the memory of the symbol operand
- *
- * Parameters:
- *  <ZirSymbolOperand> *symbol_operand: Symbol operand object
- *
- * Returns:
- *  void: This function does not return a value
+ *  The operand's memory is owned by a <ZirOperandPool>.
  */
-void zir_symbol_operand_free(ZirSymbolOperand *symbol_operand);
+void zir_symbol_operand_init(ZirSymbolOperand *operand, ZirSymbol *symbol);
 
 /*
  * Function: zir_symbol_operand_dump
@@ -3,25 +3,11 @@
 #include "uint.h"
 #include "../../types/uint.h"
 
-ZirUintOperand* zir_uint_operand_new(ZirUintType *type, ZirUintValue value)
+void zir_uint_operand_init(ZirUintOperand *uint, ZirUintType *type, ZirUintValue value)
 {
-    ZirUintOperand *uint = fl_malloc(sizeof(ZirUintOperand));
     uint->base.type = ZIR_OPERAND_UINT;
     uint->value = value;
     uint->type = type;
-
-    return uint;
-}
-
-void zir_uint_operand_free(ZirUintOperand *uint)
-{
-    if (!uint)
-        return;
-
-    if (uint->type)
-        zir_uint_type_free(uint->type);
-
-    fl_free(uint);
 }
 
 char* zir_uint_operand_dump(ZirUintOperand *uint, char *output)
@@ -34,34 +34,22 @@ typedef struct ZirUintOperand {
 } ZirUintOperand;
 
 /*
- * Function: zir_uint_operand_new
- *  Creates a new uint operand with the provided type, size, and value
+ * Function: zir_uint_operand_init
+ *  Initializes a uint operand with the provided type, size, and value
  *
  * Parameters:
+ *  <ZirUintOperand> *uint: The operand object to initialize
  *  <ZirUintType> *type: The type and size of the uint object
  *  <struct ZirUintValue> value: The value of the uint object
  *
  * Returns:
- *  ZirUintOperand*: The new uint operand object
+ *  void: This function does not return a value
  *
  * Notes:
- *  The object returned by this function must be freed using the <zir_uint_operand_free> function.
- *  The uint operand takes ownership of the <ZirUintType> object, which means it will release
- *  the type object memory too when <zir_uint_operand_free> is called with the uint operand as argument.
- */
-ZirUintOperand* zir_uint_operand_new(ZirUintType *type, ZirUintValue value);
-
-/*
- * Function: zir_uint_operand_free
- *  Frees the memory of the uint operand
- *
- * Parameters:
- *  <ZirUintOperand> *uint_operand: Uint operand object
- *
- * Returns:
- *  void: This function does not return a value
+ *  The operand's memory is owned by a <ZirOperandPool>.
+ *  The type object is not owned by the operand, it must be owned by a <ZirTypeContext>.
  */
-void zir_uint_operand_free(ZirUintOperand *uint_operand);
+void zir_uint_operand_init(ZirUintOperand *uint, ZirUintType *type, ZirUintValue value);
 
 /*
  * Function: zir_uint_operand_dump
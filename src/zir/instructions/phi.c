@@ -0,0 +1,51 @@
+#include <stdio.h>
+#include <fllib/Array.h>
+#include <fllib/Cstring.h>
+#include "phi.h"
+#include "../cfg.h"
+
+ZirPhiInstr* zir_phi_instr_new(ZirOperand *destination)
+{
+    ZirPhiInstr *instruction = fl_malloc(sizeof(ZirPhiInstr));
+    instruction->base.type = ZIR_INSTR_PHI;
+    instruction->base.origin = (ZirSourceOrigin) { 0 };
+    instruction->base.destination = destination;
+    instruction->sources = fl_array_new(sizeof(ZirOperand*), 0);
+    instruction->blocks = fl_array_new(sizeof(ZirBasicBlock*), 0);
+
+    return instruction;
+}
+
+void zir_phi_instr_add_source(ZirPhiInstr *instruction, ZirOperand *source, struct ZirBasicBlock *block)
+{
+    instruction->sources = fl_array_append(instruction->sources, &source);
+    instruction->blocks = fl_array_append(instruction->blocks, &block);
+}
+
+void zir_phi_instr_free(ZirPhiInstr *instruction)
+{
+    fl_array_free(instruction->sources);
+    fl_array_free(instruction->blocks);
+    fl_free(instruction);
+}
+
+char* zir_phi_instr_dump(ZirPhiInstr *phi, char *output)
+{
+    output = zir_operand_dump(phi->base.destination, output);
+    fl_cstring_append(&output, " : ");
+    output = zir_operand_type_dump(phi->base.destination, output);
+    fl_cstring_append(&output, " = phi(");
+
+    for (size_t i=0; i < fl_array_length(phi->sources); i++)
+    {
+        output = zir_operand_dump(phi->sources[i], output);
+        fl_cstring_vappend(&output, " L%zu", phi->blocks[i]->index);
+
+        if (i != fl_array_length(phi->sources) - 1)
+            fl_cstring_append(&output, ", ");
+    }
+
+    fl_cstring_append(&output, ")\n");
+
+    return output;
+}
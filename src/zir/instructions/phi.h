@@ -0,0 +1,90 @@
+#ifndef ZIR_INSTRUCTION_PHI_H
+#define ZIR_INSTRUCTION_PHI_H
+
+#include "instruction.h"
+#include "operands/operand.h"
+#include "operands/symbol.h"
+
+struct ZirBasicBlock;
+
+/*
+ * Struct: ZirPhiInstr
+ *  In SSA form, the phi instruction merges the definitions of a symbol that reach a basic block from
+ *  its predecessors. The *destination* operand takes the value of the source that flows from the
+ *  predecessor the control comes from. Phi instructions are always placed at the beginning of the
+ *  basic block
+ *
+ * Members:
+ *  <ZirInstr> base: Basic information of the instruction
+ *  <ZirOperand> **sources: One source operand for each predecessor
+ *  <struct ZirBasicBlock> **blocks: The predecessor each source operand comes from
+ */
+typedef struct ZirPhiInstr {
+    ZirInstr base;
+    ZirOperand **sources;
+    struct ZirBasicBlock **blocks;
+} ZirPhiInstr;
+
+/*
+ * Function: zir_phi_instr_new
+ *  Creates and returns a new phi instruction without sources
+ *
+ * Parameters:
+ *  <ZirOperand> *destination: The destination operand of the phi instruction
+ *
+ * Returns:
+ *  <ZirPhiInstr>*: Phi instruction object
+ *
+ * Notes:
+ *  The object returned by this function must be freed with the
+ *  <zir_phi_instr_free> function
+ */
+ZirPhiInstr* zir_phi_instr_new(ZirOperand *destination);
+
+/*
+ * Function: zir_phi_instr_add_source
+ *  Adds the value that flows into the phi instruction from the *block* predecessor
+ *
+ * Parameters:
+ *  <ZirPhiInstr> *instruction: The phi instruction
+ *  <ZirOperand> *source: The source operand
+ *  <struct ZirBasicBlock> *block: The predecessor block
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void zir_phi_instr_add_source(ZirPhiInstr *instruction, ZirOperand *source, struct ZirBasicBlock *block);
+
+/*
+ * Function: zir_phi_instr_free
+ *  Releases the memory used by the phi instruction object
+ *
+ * Parameters:
+ *  <ZirPhiInstr> *instruction: The phi instruction object to be freed
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void zir_phi_instr_free(ZirPhiInstr *instruction);
+
+/*
+ * Function: zir_phi_instr_dump
+ *  Dumps the string representation of the instruction to the *output* pointer. Because
+ *  the *output* pointer can be modified this function returns the same pointer, so
+ *  it is safe to use it as:
+ *
+ * ==== C ====
+ *  output = zir_phi_instr_dump(instruction, output);
+ * ===========
+ *
+ * Parameters:
+ *  instruction: Instruction object
+ *  output: Output buffer
+ *
+ * Returns:
+ *  char*: *output* pointer
+ *
+ */
+char* zir_phi_instr_dump(ZirPhiInstr *instruction, char *output);
+
+#endif /* ZIR_INSTRUCTION_PHI_H */
@@ -6,6 +6,7 @@ ZirVariableInstr* zir_variable_instr_new(ZirOperand *destination, ZirOperand *so
 {
     ZirVariableInstr *instruction = fl_malloc(sizeof(ZirVariableInstr));
     instruction->base.type = ZIR_INSTR_VARIABLE;
+    instruction->base.origin = (ZirSourceOrigin) { 0 };
     instruction->base.destination = destination;
     instruction->source = source;
 
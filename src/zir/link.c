@@ -0,0 +1,509 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <fllib/Mem.h>
+#include <fllib/Array.h>
+#include <fllib/Cstring.h>
+#include <fllib/containers/Hashtable.h>
+#include "link.h"
+#include "instructions/operands/symbol.h"
+#include "instructions/operands/uint.h"
+
+/*
+ * Constant: LINK_POINTER_SIZE
+ *  The fixed addresses are only available through the NES attribute, so the linker uses the size
+ *  of the NES pointers to compute the space of a variable
+ */
+#define LINK_POINTER_SIZE 2
+
+/*
+ * Struct: LinkDefinition
+ *  A global symbol and the unit that defines it
+ */
+typedef struct LinkDefinition {
+    ZirSymbol *symbol;
+    size_t unit;
+} LinkDefinition;
+
+/*
+ * Struct: LinkFixedRange
+ *  The memory range of a variable placed at a fixed address, the variables of different PRG-ROM banks
+ *  can use the same addresses, and the variables of the CHR segment use the PPU address space
+ */
+typedef struct LinkFixedRange {
+    ZirSymbol *symbol;
+    size_t unit;
+    size_t start;
+    size_t end;
+    size_t bank;
+    bool chr;
+} LinkFixedRange;
+
+/*
+ * Struct: LinkContext
+ *  Keeps track of the linker state
+ *
+ * Members:
+ *  <const char> **names: The name of each unit
+ *  <char> **message: Receives the first error message
+ *  <FlHashtable> *definitions: Global symbols by name (<LinkDefinition> objects)
+ *  <FlHashtable> *structs: The first declaration of each struct by name (<ZirStructType> objects)
+ */
+typedef struct LinkContext {
+    const char **names;
+    char **message;
+    FlHashtable *definitions;
+    FlHashtable *structs;
+} LinkContext;
+
+static bool report(LinkContext *ctx, const char *format, ...)
+{
+    if (ctx->message == NULL || *ctx->message != NULL)
+        return false;
+
+    char buffer[512];
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    *ctx->message = fl_cstring_dup(buffer);
+
+    return false;
+}
+
+static inline bool is_local(ZirSymbol *symbol)
+{
+    return symbol->linkage == ZIR_LINKAGE_LOCAL || symbol->name[0] == '%';
+}
+
+static ZirSymbol** get_global_symbols(ZirProgram *unit)
+{
+    ZirSymbol **symbols = zir_symtable_get_all(&unit->global->symtable);
+    return symbols != NULL ? symbols : fl_array_new(sizeof(ZirSymbol*), 0);
+}
+
+static bool has_struct_block(ZirBlock *block, const char *id)
+{
+    for (size_t i=0; i < fl_array_length(block->children); i++)
+        if (block->children[i]->type == ZIR_BLOCK_STRUCT && flm_cstring_equals(block->children[i]->id, id))
+            return true;
+
+    return false;
+}
+
+static bool collect_definitions(LinkContext *ctx, ZirProgram **units, size_t count)
+{
+    for (size_t i=0; i < count; i++)
+    {
+        ZirSymbol **symbols = get_global_symbols(units[i]);
+
+        for (size_t j=0; j < fl_array_length(symbols); j++)
+        {
+            ZirSymbol *symbol = symbols[j];
+
+            if (symbol->linkage != ZIR_LINKAGE_GLOBAL || is_local(symbol))
+                continue;
+
+            LinkDefinition *definition = fl_hashtable_get(ctx->definitions, symbol->name);
+
+            if (definition != NULL)
+            {
+                fl_array_free(symbols);
+                return report(ctx, "Symbol '%s' is defined in '%s' and in '%s'", symbol->name, ctx->names[definition->unit], ctx->names[i]);
+            }
+
+            definition = fl_malloc(sizeof(LinkDefinition));
+            definition->symbol = symbol;
+            definition->unit = i;
+            fl_hashtable_add(ctx->definitions, symbol->name, definition);
+        }
+
+        fl_array_free(symbols);
+    }
+
+    return true;
+}
+
+static bool check_externals(LinkContext *ctx, ZirProgram **units, size_t count)
+{
+    for (size_t i=0; i < count; i++)
+    {
+        ZirSymbol **symbols = get_global_symbols(units[i]);
+        bool valid = true;
+
+        for (size_t j=0; j < fl_array_length(symbols) && valid; j++)
+        {
+            ZirSymbol *symbol = symbols[j];
+
+            if (symbol->linkage != ZIR_LINKAGE_EXTERNAL)
+                continue;
+
+            LinkDefinition *definition = fl_hashtable_get(ctx->definitions, symbol->name);
+
+            if (definition == NULL)
+            {
+                valid = report(ctx, "Undefined external symbol '%s' in '%s'", symbol->name, ctx->names[i]);
+            }
+            else if (!zir_type_equals(symbol->type, definition->symbol->type))
+            {
+                valid = report(ctx, "External symbol '%s' is declared as '%s' in '%s' but it is defined as '%s' in '%s'",
+                    symbol->name, zir_type_to_string(symbol->type), ctx->names[i],
+                    zir_type_to_string(definition->symbol->type), ctx->names[definition->unit]);
+            }
+        }
+
+        fl_array_free(symbols);
+
+        if (!valid)
+            return false;
+    }
+
+    return true;
+}
+
+static bool check_structs(LinkContext *ctx, ZirProgram **units, size_t count)
+{
+    for (size_t i=0; i < count; i++)
+    {
+        ZirBlock *global = units[i]->global;
+
+        for (size_t j=0; j < fl_array_length(global->children); j++)
+        {
+            ZirBlock *child = global->children[j];
+
+            if (child->type != ZIR_BLOCK_STRUCT)
+                continue;
+
+            ZirStructType *struct_type = zir_type_ctx_get_named_struct(units[i]->types, child->id);
+            ZirStructType *first = fl_hashtable_get(ctx->structs, child->id);
+
+            if (first == NULL)
+            {
+                fl_hashtable_add(ctx->structs, child->id, struct_type);
+                continue;
+            }
+
+            if (struct_type != NULL && !zir_struct_type_structurally_equals(first, struct_type))
+                return report(ctx, "Struct '%s' in '%s' does not match its declaration in another unit", child->id, ctx->names[i]);
+        }
+    }
+
+    return true;
+}
+
+static bool fixed_range(ZirInstr *instruction, LinkFixedRange *range)
+{
+    if (instruction->type != ZIR_INSTR_VARIABLE)
+        return false;
+
+    ZirAttributeMap *attributes = ((ZirVariableInstr*) instruction)->attributes;
+
+    if (attributes == NULL || !zir_attribute_map_has_key(attributes, "NES"))
+        return false;
+
+    ZirAttribute *nes_attribute = zir_attribute_map_get(attributes, "NES");
+
+    if (!zir_property_map_has_key(nes_attribute->properties, "address"))
+        return false;
+
+    ZirProperty *address_property = zir_property_map_get(nes_attribute->properties, "address");
+
+    // The back-end reports the invalid addresses
+    if (address_property->value->type != ZIR_OPERAND_UINT)
+        return false;
+
+    ZirUintOperand *address = (ZirUintOperand*) address_property->value;
+    ZirSymbol *symbol = ((ZirSymbolOperand*) instruction->destination)->symbol;
+
+    range->symbol = symbol;
+    range->start = address->type->size == ZIR_UINT_8 ? address->value.uint8 : address->value.uint16;
+    range->end = range->start + zir_type_size(symbol->type, LINK_POINTER_SIZE);
+    range->bank = 0;
+    range->chr = false;
+
+    if (zir_property_map_has_key(nes_attribute->properties, "bank"))
+    {
+        ZirProperty *bank_property = zir_property_map_get(nes_attribute->properties, "bank");
+
+        if (bank_property->value->type == ZIR_OPERAND_UINT)
+        {
+            ZirUintOperand *bank = (ZirUintOperand*) bank_property->value;
+            range->bank = bank->type->size == ZIR_UINT_8 ? bank->value.uint8 : bank->value.uint16;
+        }
+    }
+
+    if (zir_property_map_has_key(nes_attribute->properties, "segment"))
+    {
+        ZirProperty *segment_property = zir_property_map_get(nes_attribute->properties, "segment");
+
+        range->chr = segment_property->value->type == ZIR_OPERAND_SYMBOL
+                        && flm_cstring_equals(((ZirSymbolOperand*) segment_property->value)->symbol->name, "chr");
+    }
+
+    return true;
+}
+
+static bool check_fixed_addresses(LinkContext *ctx, ZirProgram **units, size_t count)
+{
+    LinkFixedRange *ranges = fl_array_new(sizeof(LinkFixedRange), 0);
+
+    for (size_t i=0; i < count; i++)
+    {
+        ZirCfg *cfg = &units[i]->global->cfg;
+
+        for (size_t j=0; j < fl_array_length(cfg->blocks); j++)
+        {
+            ZirBasicBlock *block = cfg->blocks[j];
+
+            for (size_t k=0; k < fl_array_length(block->instructions); k++)
+            {
+                LinkFixedRange range = { .unit = i };
+
+                if (fixed_range(block->instructions[k], &range))
+                    ranges = fl_array_append(ranges, &range);
+            }
+        }
+    }
+
+    // The overlaps within a unit are the back-end's business, we only check the ones between units
+    bool valid = true;
+    size_t length = fl_array_length(ranges);
+
+    for (size_t i=0; i < length && valid; i++)
+    {
+        for (size_t j=i + 1; j < length && valid; j++)
+        {
+            if (ranges[i].unit == ranges[j].unit || ranges[i].bank != ranges[j].bank || ranges[i].chr != ranges[j].chr || ranges[i].end <= ranges[j].start || ranges[j].end <= ranges[i].start)
+                continue;
+
+            valid = report(ctx, "Variable '%s' in '%s' overlaps variable '%s' in '%s' at address 0x%04zX",
+                ranges[i].symbol->name, ctx->names[ranges[i].unit],
+                ranges[j].symbol->name, ctx->names[ranges[j].unit],
+                ranges[i].start > ranges[j].start ? ranges[i].start : ranges[j].start);
+        }
+    }
+
+    fl_array_free(ranges);
+
+    return valid;
+}
+
+/*
+ * Function: sort_units
+ *  The globals must be defined before their first use, so a unit is placed after the units that define the
+ *  external symbols it uses. Among the units that can be placed, the one that comes first in the *units*
+ *  array is placed first. The global instructions of a unit are not split, so the units that use symbols of
+ *  each other (directly or through other units) cannot be placed.
+ */
+static bool sort_units(LinkContext *ctx, ZirProgram **units, size_t count, size_t *order)
+{
+    bool *depends = fl_malloc(sizeof(bool) * count * count);
+    bool *placed = fl_malloc(sizeof(bool) * count);
+    memset(depends, 0, sizeof(bool) * count * count);
+    memset(placed, 0, sizeof(bool) * count);
+
+    for (size_t i=0; i < count; i++)
+    {
+        ZirSymbol **symbols = get_global_symbols(units[i]);
+
+        for (size_t j=0; j < fl_array_length(symbols); j++)
+        {
+            if (symbols[j]->linkage != ZIR_LINKAGE_EXTERNAL)
+                continue;
+
+            LinkDefinition *definition = fl_hashtable_get(ctx->definitions, symbols[j]->name);
+
+            if (definition->unit != i)
+                depends[i * count + definition->unit] = true;
+        }
+
+        fl_array_free(symbols);
+    }
+
+    bool valid = true;
+
+    for (size_t placed_count = 0; placed_count < count && valid; placed_count++)
+    {
+        size_t next = count;
+
+        for (size_t i=0; i < count && next == count; i++)
+        {
+            if (placed[i])
+                continue;
+
+            bool ready = true;
+            for (size_t j=0; j < count && ready; j++)
+                ready = !depends[i * count + j] || placed[j];
+
+            if (ready)
+                next = i;
+        }
+
+        if (next == count)
+        {
+            // Every unit that is not placed depends on another unit that is not placed
+            size_t unit = 0, dependency = 0;
+
+            while (placed[unit])
+                unit++;
+
+            while (!depends[unit * count + dependency] || placed[dependency])
+                dependency++;
+
+            valid = report(ctx, "Circular dependency between units: '%s' uses symbols of '%s', and the initializers of a unit run "
+                "after the ones of the units it uses, so units cannot use symbols of each other", ctx->names[unit], ctx->names[dependency]);
+            break;
+        }
+
+        placed[next] = true;
+        order[placed_count] = next;
+    }
+
+    fl_free(placed);
+    fl_free(depends);
+
+    return valid;
+}
+
+static void rename_symbol(ZirSymtable *symtable, LinkContext *ctx, ZirSymbol *symbol, size_t unit)
+{
+    if (!zir_symtable_has(symtable, symbol->name) && !fl_hashtable_has_key(ctx->definitions, symbol->name))
+        return;
+
+    char *name = fl_cstring_vdup("%s$u%zu", symbol->name, unit);
+
+    for (size_t suffix = 1; zir_symtable_has(symtable, name) || fl_hashtable_has_key(ctx->definitions, name); suffix++)
+    {
+        fl_cstring_free(name);
+        name = fl_cstring_vdup("%s$u%zu_%zu", symbol->name, unit, suffix);
+    }
+
+    fl_cstring_free(symbol->name);
+    symbol->name = name;
+}
+
+static void resolve_symbol_operand(void *element, void *user_data)
+{
+    ZirSymbolOperand *operand = (ZirSymbolOperand*) element;
+
+    if (operand->symbol->linkage != ZIR_LINKAGE_EXTERNAL)
+        return;
+
+    LinkDefinition *definition = fl_hashtable_get((FlHashtable*) user_data, operand->symbol->name);
+    operand->symbol = definition->symbol;
+}
+
+static void move_unit(LinkContext *ctx, ZirProgram *linked, ZirProgram *unit, size_t index)
+{
+    ZirBlock *global = unit->global;
+
+    // The struct blocks declared by a previous unit are released with the unit
+    size_t kept = 0;
+    for (size_t i=0; i < fl_array_length(global->children); i++)
+    {
+        ZirBlock *child = global->children[i];
+
+        if (child->type == ZIR_BLOCK_STRUCT && has_struct_block(linked->global, child->id))
+        {
+            global->children[kept++] = child;
+            continue;
+        }
+
+        child->parent = linked->global;
+        linked->global->children = fl_array_append(linked->global->children, &child);
+    }
+    global->children = fl_array_resize(global->children, kept);
+
+    // The symbols keep the unit's order
+    ZirSymbol **symbols = get_global_symbols(unit);
+    ZirSymbol **externals = fl_array_new(sizeof(ZirSymbol*), 0);
+
+    for (size_t i=0; i < fl_array_length(symbols); i++)
+    {
+        ZirSymbol *symbol = zir_symtable_remove(&global->symtable, symbols[i]->name);
+
+        if (symbol->linkage == ZIR_LINKAGE_EXTERNAL)
+        {
+            externals = fl_array_append(externals, &symbol);
+            continue;
+        }
+
+        if (is_local(symbol))
+            rename_symbol(&linked->global->symtable, ctx, symbol, index);
+
+        zir_symtable_add(&linked->global->symtable, symbol);
+    }
+
+    fl_array_free(symbols);
+
+    // The symbol operands of the unit point to the definitions of the external symbols, which are not needed anymore
+    if (fl_array_length(externals) > 0)
+        zir_slab_foreach(&unit->operands->symbols, resolve_symbol_operand, ctx->definitions);
+
+    fl_array_free_each_pointer(externals, (FlArrayFreeElementFunc) zir_symbol_free);
+
+    // The basic blocks of the unit follow the ones of the previous unit
+    for (size_t i=0; i < fl_array_length(global->cfg.blocks); i++)
+        zir_cfg_place_basic_block(&linked->global->cfg, global->cfg.blocks[i]);
+
+    global->cfg.blocks = fl_array_resize(global->cfg.blocks, 0);
+    global->cfg.current = NULL;
+
+    if (global->temp_counter > linked->global->temp_counter)
+        linked->global->temp_counter = global->temp_counter;
+
+    linked->units = fl_array_append(linked->units, &unit);
+}
+
+ZirProgram* zir_link_programs(ZirProgram **units, const char **names, size_t count, char **message)
+{
+    if (units == NULL || count == 0)
+        return NULL;
+
+    LinkContext ctx = {
+        .names = names,
+        .message = message,
+        .definitions = fl_hashtable_new_args((struct FlHashtableArgs) {
+            .hash_function = fl_hashtable_hash_string,
+            .key_allocator = fl_container_allocator_string,
+            .key_comparer = fl_container_equals_string,
+            .key_cleaner = fl_container_cleaner_pointer,
+            .value_cleaner = fl_container_cleaner_pointer,
+            .value_allocator = NULL
+        }),
+        .structs = fl_hashtable_new_args((struct FlHashtableArgs) {
+            .hash_function = fl_hashtable_hash_string,
+            .key_allocator = fl_container_allocator_string,
+            .key_comparer = fl_container_equals_string,
+            .key_cleaner = fl_container_cleaner_pointer,
+            .value_cleaner = NULL,
+            .value_allocator = NULL
+        })
+    };
+
+    ZirProgram *linked = NULL;
+    size_t *order = fl_malloc(sizeof(size_t) * count);
+
+    // The units are not modified until we know the link succeeds
+    if (collect_definitions(&ctx, units, count)
+        && check_externals(&ctx, units, count)
+        && check_structs(&ctx, units, count)
+        && check_fixed_addresses(&ctx, units, count)
+        && sort_units(&ctx, units, count, order))
+    {
+        linked = zir_program_new();
+
+        for (size_t i=0; i < count; i++)
+            move_unit(&ctx, linked, units[order[i]], order[i]);
+
+        zir_cfg_update_edges(&linked->global->cfg);
+    }
+
+    fl_free(order);
+    fl_hashtable_free(ctx.structs);
+    fl_hashtable_free(ctx.definitions);
+
+    return linked;
+}
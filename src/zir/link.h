@@ -0,0 +1,36 @@
+#ifndef ZIR_LINK_H
+#define ZIR_LINK_H
+
+#include <stdbool.h>
+#include "program.h"
+
+/*
+ * Function: zir_link_programs
+ *  Merges the ZIR programs generated from different source files into a single program. The global
+ *  instructions of each unit are placed after the ones of the units that define the external symbols it
+ *  uses (and otherwise in the order of the *units* array), the external symbols are
+ *  resolved to the global symbols defined in other units, the local symbols (temporals and variables of
+ *  nested blocks) are renamed if their names clash, and the struct declarations shared by more than one
+ *  unit are merged.
+ *
+ * Parameters:
+ *  <ZirProgram> **units: The programs to link
+ *  <const char> **names: The name of each unit (e.g. its source file) used in the error message
+ *  <size_t> count: Number of units
+ *  <char> **message: If not NULL, receives a description of the first link error
+ *
+ * Returns:
+ *  ZirProgram*: The linked program, or NULL if there are duplicated global symbols, undefined external
+ *               symbols, external declarations with a type different from the definition, struct
+ *               declarations that do not match, variables of different units placed at overlapping
+ *               fixed addresses of the same PRG-ROM bank, or units that use symbols of each other (the
+ *               initializers of a unit run after the ones of the units it uses)
+ *
+ * Notes:
+ *  On success, the linked program takes ownership of the units and it releases them in the
+ *  <zir_program_free> function. On failure, the units are not modified and the caller keeps the
+ *  ownership of them. The message must be freed with <fl_cstring_free>.
+ */
+ZirProgram* zir_link_programs(ZirProgram **units, const char **names, size_t count, char **message);
+
+#endif /* ZIR_LINK_H */
@@ -0,0 +1,295 @@
+#include <fllib/Mem.h>
+#include <fllib/Array.h>
+#include <fllib/Cstring.h>
+#include <fllib/containers/Hashtable.h>
+#include "dead-globals.h"
+#include "../instructions/operands/array.h"
+#include "../instructions/operands/reference.h"
+#include "../instructions/operands/struct.h"
+#include "../instructions/operands/symbol.h"
+
+typedef struct DeadGlobalsContext {
+    FlHashtable *definitions;
+    FlHashtable *live;
+    ZirSymbol **worklist;
+} DeadGlobalsContext;
+
+typedef struct SymbolDefinitions {
+    ZirInstr **instructions;
+} SymbolDefinitions;
+
+static void free_definitions(void *value)
+{
+    SymbolDefinitions *definitions = (SymbolDefinitions*) value;
+    fl_array_free(definitions->instructions);
+    fl_free(definitions);
+}
+
+static ZirOperand* instruction_source(ZirInstr *instruction)
+{
+    switch (instruction->type)
+    {
+        case ZIR_INSTR_VARIABLE:
+            return ((ZirVariableInstr*) instruction)->source;
+
+        case ZIR_INSTR_CAST:
+            return ((ZirCastInstr*) instruction)->source;
+
+        case ZIR_INSTR_IF_FALSE:
+            return ((ZirIfFalseInstr*) instruction)->source;
+
+        default: break;
+    }
+
+    return NULL;
+}
+
+static ZirSymbol* defined_symbol(ZirInstr *instruction)
+{
+    if (instruction->type != ZIR_INSTR_VARIABLE && instruction->type != ZIR_INSTR_CAST && instruction->type != ZIR_INSTR_PHI)
+        return NULL;
+
+    if (instruction->destination == NULL || instruction->destination->type != ZIR_OPERAND_SYMBOL)
+        return NULL;
+
+    return ((ZirSymbolOperand*) instruction->destination)->symbol;
+}
+
+/*
+ * Function: is_root
+ *  A variable is a root if it has a fixed address (the hardware or another program might read it), if it
+ *  lives in the CHR segment (the PPU reads it), or if it is marked with the keep attribute
+ */
+static bool is_root(ZirInstr *instruction)
+{
+    if (instruction->type != ZIR_INSTR_VARIABLE)
+        return false;
+
+    ZirAttributeMap *attributes = ((ZirVariableInstr*) instruction)->attributes;
+
+    if (attributes == NULL)
+        return false;
+
+    if (zir_attribute_map_has_key(attributes, "keep"))
+        return true;
+
+    if (!zir_attribute_map_has_key(attributes, "NES"))
+        return false;
+
+    ZirAttribute *nes_attribute = zir_attribute_map_get(attributes, "NES");
+
+    if (zir_property_map_has_key(nes_attribute->properties, "segment"))
+    {
+        ZirProperty *segment_property = zir_property_map_get(nes_attribute->properties, "segment");
+
+        if (segment_property->value->type == ZIR_OPERAND_SYMBOL
+            && flm_cstring_equals(((ZirSymbolOperand*) segment_property->value)->symbol->name, "chr"))
+            return true;
+    }
+
+    return zir_property_map_has_key(nes_attribute->properties, "address");
+}
+
+static void mark_live(DeadGlobalsContext *ctx, ZirSymbol *symbol)
+{
+    if (fl_hashtable_has_key(ctx->live, symbol->name))
+        return;
+
+    fl_hashtable_add(ctx->live, symbol->name, symbol);
+    ctx->worklist = fl_array_append(ctx->worklist, &symbol);
+}
+
+static void mark_operand(DeadGlobalsContext *ctx, ZirOperand *operand)
+{
+    if (operand == NULL)
+        return;
+
+    switch (operand->type)
+    {
+        case ZIR_OPERAND_SYMBOL:
+            mark_live(ctx, ((ZirSymbolOperand*) operand)->symbol);
+            return;
+
+        case ZIR_OPERAND_REFERENCE:
+            mark_live(ctx, ((ZirReferenceOperand*) operand)->operand->symbol);
+            return;
+
+        case ZIR_OPERAND_ARRAY:
+        {
+            ZirArrayOperand *array = (ZirArrayOperand*) operand;
+
+            for (size_t i=0; i < fl_array_length(array->elements); i++)
+                mark_operand(ctx, array->elements[i]);
+
+            return;
+        }
+        case ZIR_OPERAND_STRUCT:
+        {
+            ZirStructOperand *struct_operand = (ZirStructOperand*) operand;
+
+            for (size_t i=0; i < fl_array_length(struct_operand->members); i++)
+                mark_operand(ctx, struct_operand->members[i]->operand);
+
+            return;
+        }
+
+        default: return;
+    }
+}
+
+static void mark_instruction_uses(DeadGlobalsContext *ctx, ZirInstr *instruction)
+{
+    mark_operand(ctx, instruction_source(instruction));
+
+    if (instruction->type == ZIR_INSTR_PHI)
+    {
+        ZirPhiInstr *phi = (ZirPhiInstr*) instruction;
+
+        for (size_t i=0; i < fl_array_length(phi->sources); i++)
+            mark_operand(ctx, phi->sources[i]);
+    }
+}
+
+static void collect_instruction(DeadGlobalsContext *ctx, ZirInstr *instruction)
+{
+    ZirSymbol *symbol = defined_symbol(instruction);
+
+    if (symbol == NULL)
+        return;
+
+    SymbolDefinitions *definitions = (SymbolDefinitions*) fl_hashtable_get(ctx->definitions, symbol->name);
+
+    if (definitions == NULL)
+    {
+        definitions = fl_malloc(sizeof(SymbolDefinitions));
+        definitions->instructions = fl_array_new(sizeof(ZirInstr*), 0);
+        fl_hashtable_add(ctx->definitions, symbol->name, definitions);
+    }
+
+    definitions->instructions = fl_array_append(definitions->instructions, &instruction);
+}
+
+static size_t remove_dead_instructions(ZirProgram *program, DeadGlobalsContext *ctx, ZirCfg *cfg)
+{
+    size_t removed = 0;
+
+    for (size_t i=0; i < fl_array_length(cfg->blocks); i++)
+    {
+        ZirBasicBlock *block = cfg->blocks[i];
+        size_t kept = 0;
+
+        for (size_t j=0; j < fl_array_length(block->instructions); j++)
+        {
+            ZirInstr *instruction = block->instructions[j];
+            ZirSymbol *symbol = defined_symbol(instruction);
+
+            if (symbol == NULL || fl_hashtable_has_key(ctx->live, symbol->name))
+            {
+                block->instructions[kept++] = instruction;
+                continue;
+            }
+
+            // The temporal symbols do not use memory, we only report the variables
+            if (symbol->name[0] != '%')
+            {
+                bool reported = false;
+                for (size_t k=0; k < fl_array_length(program->dead_globals) && !reported; k++)
+                    reported = program->dead_globals[k] == symbol;
+
+                if (!reported)
+                    program->dead_globals = fl_array_append(program->dead_globals, &symbol);
+            }
+
+            zir_instruction_free(instruction);
+            removed++;
+        }
+
+        block->instructions = fl_array_resize(block->instructions, kept);
+    }
+
+    return removed;
+}
+
+size_t zir_eliminate_dead_globals(ZirProgram *program)
+{
+    if (!program)
+        return 0;
+
+    ZirCfg *cfg = &program->global->cfg;
+
+    DeadGlobalsContext ctx = {
+        .definitions = fl_hashtable_new_args((struct FlHashtableArgs) {
+            .hash_function = fl_hashtable_hash_string,
+            .key_allocator = fl_container_allocator_string,
+            .key_comparer = fl_container_equals_string,
+            .key_cleaner = fl_container_cleaner_pointer,
+            .value_cleaner = free_definitions,
+            .value_allocator = NULL
+        }),
+        .live = fl_hashtable_new_args((struct FlHashtableArgs) {
+            .hash_function = fl_hashtable_hash_string,
+            .key_allocator = fl_container_allocator_string,
+            .key_comparer = fl_container_equals_string,
+            .key_cleaner = fl_container_cleaner_pointer,
+            .value_cleaner = NULL,
+            .value_allocator = NULL
+        }),
+        .worklist = fl_array_new(sizeof(ZirSymbol*), 0)
+    };
+
+    // The roots are the variables with a fixed placement or the keep attribute, and the conditions of the branches
+    for (size_t i=0; i < fl_array_length(cfg->blocks); i++)
+    {
+        ZirBasicBlock *block = cfg->blocks[i];
+
+        for (size_t j=0; j < fl_array_length(block->instructions); j++)
+        {
+            ZirInstr *instruction = block->instructions[j];
+            collect_instruction(&ctx, instruction);
+
+            if (is_root(instruction))
+                mark_live(&ctx, defined_symbol(instruction));
+        }
+
+        if (block->terminator != NULL)
+            mark_instruction_uses(&ctx, block->terminator);
+    }
+
+    // The worklist grows while the symbols used by the live definitions are marked
+    for (size_t i=0; i < fl_array_length(ctx.worklist); i++)
+    {
+        SymbolDefinitions *definitions = (SymbolDefinitions*) fl_hashtable_get(ctx.definitions, ctx.worklist[i]->name);
+
+        if (definitions == NULL)
+            continue;
+
+        for (size_t j=0; j < fl_array_length(definitions->instructions); j++)
+            mark_instruction_uses(&ctx, definitions->instructions[j]);
+    }
+
+    size_t removed = remove_dead_instructions(program, &ctx, cfg);
+
+    fl_array_free(ctx.worklist);
+    fl_hashtable_free(ctx.live);
+    fl_hashtable_free(ctx.definitions);
+
+    return removed;
+}
+
+char* zir_dead_globals_report(ZirProgram *program, size_t ref_size, char *output)
+{
+    size_t total = 0;
+
+    for (size_t i=0; i < fl_array_length(program->dead_globals); i++)
+    {
+        ZirSymbol *symbol = program->dead_globals[i];
+        size_t size = zir_type_size(symbol->type, ref_size);
+
+        fl_cstring_vappend(&output, "removed @%s (%zu bytes)\n", symbol->name, size);
+        total += size;
+    }
+
+    fl_cstring_vappend(&output, "%zu unused globals removed, %zu bytes\n", fl_array_length(program->dead_globals), total);
+
+    return output;
+}
@@ -0,0 +1,40 @@
+#ifndef ZIR_PASS_DEAD_GLOBALS_H
+#define ZIR_PASS_DEAD_GLOBALS_H
+
+#include <stddef.h>
+#include "../program.h"
+
+/*
+ * Function: zir_eliminate_dead_globals
+ *  Removes the global variables that are not reachable from a root, along with the instructions that
+ *  initialize them. The roots are:
+ *      - The variables placed at a fixed address (#[NES(address: ...)]), like vectors and hardware registers
+ *      - The variables of the CHR segment (#[NES(segment: chr)]), the pattern tables are read by the PPU
+ *      - The variables marked with the keep attribute (#[keep])
+ *      - The symbols used by the if-false instructions
+ *  A symbol is reachable if a reachable variable uses it (or references it) in its initialization. The
+ *  removed variables are added to the program's *dead_globals* list.
+ *
+ * Parameters:
+ *  <ZirProgram> *program: The ZIR program
+ *
+ * Returns:
+ *  size_t: The number of removed instructions
+ */
+size_t zir_eliminate_dead_globals(ZirProgram *program);
+
+/*
+ * Function: zir_dead_globals_report
+ *  Appends to the output the list of removed global variables and the number of bytes they used
+ *
+ * Parameters:
+ *  <ZirProgram> *program: The ZIR program
+ *  <size_t> ref_size: The size of the references in the target (back-end specific)
+ *  <char> *output: Pointer to a heap allocated string
+ *
+ * Returns:
+ *  char*: Pointer to the output string
+ */
+char* zir_dead_globals_report(ZirProgram *program, size_t ref_size, char *output);
+
+#endif /* ZIR_PASS_DEAD_GLOBALS_H */
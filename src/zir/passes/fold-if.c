@@ -0,0 +1,116 @@
+#include <fllib/Mem.h>
+#include <fllib/Array.h>
+#include <fllib/Cstring.h>
+#include "fold-if.h"
+#include "../instructions/operands/bool.h"
+#include "../instructions/operands/symbol.h"
+
+/*
+ * Function: constant_condition
+ *  If the condition of the if-false terminator of the basic block is known at compile time, this function
+ *  stores its value in the *value* pointer. If the condition is a temporal symbol defined by the last
+ *  instruction of the block, the *definition* pointer is set to *true*
+ */
+static bool constant_condition(ZirBasicBlock *block, bool *value, bool *definition)
+{
+    ZirOperand *source = ((ZirIfFalseInstr*) block->terminator)->source;
+    *definition = false;
+
+    if (source->type == ZIR_OPERAND_BOOL)
+    {
+        *value = ((ZirBoolOperand*) source)->value;
+        return true;
+    }
+
+    size_t count = fl_array_length(block->instructions);
+
+    if (source->type != ZIR_OPERAND_SYMBOL || count == 0)
+        return false;
+
+    // The code generator emits the condition right before the if-false instruction
+    ZirSymbol *symbol = ((ZirSymbolOperand*) source)->symbol;
+    ZirInstr *previous = block->instructions[count - 1];
+
+    if (symbol->name[0] != '%' || previous->type != ZIR_INSTR_CAST)
+        return false;
+
+    if (previous->destination == NULL || previous->destination->type != ZIR_OPERAND_SYMBOL)
+        return false;
+
+    if (!flm_cstring_equals(((ZirSymbolOperand*) previous->destination)->symbol->name, symbol->name))
+        return false;
+
+    ZirOperand *cast_source = ((ZirCastInstr*) previous)->source;
+
+    if (cast_source->type != ZIR_OPERAND_BOOL)
+        return false;
+
+    *value = ((ZirBoolOperand*) cast_source)->value;
+    *definition = true;
+
+    return true;
+}
+
+static size_t fold_cfg(ZirCfg *cfg)
+{
+    size_t folded = 0;
+
+    for (size_t i=0; i < fl_array_length(cfg->blocks); i++)
+    {
+        ZirBasicBlock *block = cfg->blocks[i];
+
+        if (block->terminator == NULL || block->terminator->type != ZIR_INSTR_IF_FALSE)
+            continue;
+
+        bool value = false;
+        bool definition = false;
+
+        if (!constant_condition(block, &value, &definition))
+            continue;
+
+        // The temporal symbol is not used anymore
+        if (definition)
+        {
+            size_t count = fl_array_length(block->instructions);
+            zir_instruction_free(block->instructions[count - 1]);
+            block->instructions = fl_array_resize(block->instructions, count - 1);
+        }
+
+        ZirBasicBlock *target = ((ZirIfFalseInstr*) block->terminator)->target;
+        ZirSourceOrigin origin = block->terminator->origin;
+        zir_instruction_free(block->terminator);
+
+        // If the condition is true, the block falls through to the "then" branch, otherwise, it always
+        // jumps to the "else" branch (or out of the "then" branch)
+        block->terminator = value ? NULL : (ZirInstr*) zir_jump_instr_new(target);
+
+        if (block->terminator != NULL)
+            block->terminator->origin = origin;
+
+        folded++;
+    }
+
+    // The branches that can never be executed are not reachable anymore
+    if (folded > 0)
+        zir_cfg_simplify(cfg);
+
+    return folded;
+}
+
+static size_t fold_block_tree(ZirBlock *block)
+{
+    size_t folded = fold_cfg(&block->cfg);
+
+    for (size_t i=0; i < fl_array_length(block->children); i++)
+        folded += fold_block_tree(block->children[i]);
+
+    return folded;
+}
+
+size_t zir_fold_constant_ifs(ZirProgram *program)
+{
+    if (!program)
+        return 0;
+
+    return fold_block_tree(program->global);
+}
@@ -0,0 +1,22 @@
+#ifndef ZIR_PASS_FOLD_IF_H
+#define ZIR_PASS_FOLD_IF_H
+
+#include <stddef.h>
+#include "../program.h"
+
+/*
+ * Function: zir_fold_constant_ifs
+ *  Evaluates at compile time the if-false instructions whose condition is a boolean literal (or a temporal
+ *  symbol initialized with a boolean literal). The instruction is replaced by a jump to the branch that is
+ *  always executed (or removed if it is the fall-through branch), and the basic blocks that become unreachable
+ *  are removed from the CFG.
+ *
+ * Parameters:
+ *  <ZirProgram> *program: The ZIR program
+ *
+ * Returns:
+ *  size_t: The number of if-false instructions that have been folded
+ */
+size_t zir_fold_constant_ifs(ZirProgram *program);
+
+#endif /* ZIR_PASS_FOLD_IF_H */
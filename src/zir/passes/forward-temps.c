@@ -0,0 +1,404 @@
+#include <fllib/Mem.h>
+#include <fllib/Array.h>
+#include <fllib/containers/Hashtable.h>
+#include "forward-temps.h"
+#include "../instructions/operands/array.h"
+#include "../instructions/operands/reference.h"
+#include "../instructions/operands/struct.h"
+#include "../instructions/operands/symbol.h"
+#include "../instructions/operands/uint.h"
+#include "../types/uint.h"
+
+/*
+ * Struct: TempUses
+ *  The uses of a temporal symbol in a CFG
+ *
+ * Members:
+ *  <size_t> count: Number of times the symbol is used
+ *  <bool> pinned: *true* if the symbol cannot be forwarded (a phi instruction uses it)
+ */
+typedef struct TempUses {
+    size_t count;
+    bool pinned;
+} TempUses;
+
+static bool is_temp_symbol(ZirSymbol *symbol)
+{
+    return symbol->name[0] == '%';
+}
+
+static ZirOperand** instruction_source(ZirInstr *instruction)
+{
+    switch (instruction->type)
+    {
+        case ZIR_INSTR_VARIABLE:
+            return &((ZirVariableInstr*) instruction)->source;
+
+        case ZIR_INSTR_CAST:
+            return &((ZirCastInstr*) instruction)->source;
+
+        case ZIR_INSTR_IF_FALSE:
+            return &((ZirIfFalseInstr*) instruction)->source;
+
+        default: break;
+    }
+
+    return NULL;
+}
+
+static ZirSymbol* defined_temp(ZirInstr *instruction)
+{
+    if (instruction->type != ZIR_INSTR_VARIABLE && instruction->type != ZIR_INSTR_CAST)
+        return NULL;
+
+    if (instruction->destination == NULL || instruction->destination->type != ZIR_OPERAND_SYMBOL)
+        return NULL;
+
+    ZirSymbol *symbol = ((ZirSymbolOperand*) instruction->destination)->symbol;
+
+    return is_temp_symbol(symbol) ? symbol : NULL;
+}
+
+static TempUses* get_uses(FlHashtable *uses, ZirSymbol *symbol)
+{
+    TempUses *temp_uses = (TempUses*) fl_hashtable_get(uses, symbol->name);
+
+    if (temp_uses != NULL)
+        return temp_uses;
+
+    temp_uses = fl_malloc(sizeof(TempUses));
+    temp_uses->count = 0;
+    temp_uses->pinned = false;
+    fl_hashtable_add(uses, symbol->name, temp_uses);
+
+    return temp_uses;
+}
+
+static void count_uses(FlHashtable *uses, ZirOperand *operand, bool pinned)
+{
+    if (operand == NULL)
+        return;
+
+    switch (operand->type)
+    {
+        case ZIR_OPERAND_SYMBOL:
+        {
+            ZirSymbol *symbol = ((ZirSymbolOperand*) operand)->symbol;
+
+            if (!is_temp_symbol(symbol))
+                return;
+
+            TempUses *temp_uses = get_uses(uses, symbol);
+            temp_uses->count++;
+            temp_uses->pinned = temp_uses->pinned || pinned;
+            return;
+        }
+        case ZIR_OPERAND_REFERENCE:
+            count_uses(uses, (ZirOperand*) ((ZirReferenceOperand*) operand)->operand, pinned);
+            return;
+
+        case ZIR_OPERAND_ARRAY:
+        {
+            ZirArrayOperand *array = (ZirArrayOperand*) operand;
+
+            for (size_t i=0; i < fl_array_length(array->elements); i++)
+                count_uses(uses, array->elements[i], pinned);
+
+            return;
+        }
+        case ZIR_OPERAND_STRUCT:
+        {
+            ZirStructOperand *struct_operand = (ZirStructOperand*) operand;
+
+            for (size_t i=0; i < fl_array_length(struct_operand->members); i++)
+                count_uses(uses, struct_operand->members[i]->operand, pinned);
+
+            return;
+        }
+
+        default: return;
+    }
+}
+
+static void count_instruction_uses(FlHashtable *uses, ZirInstr *instruction)
+{
+    ZirOperand **source = instruction_source(instruction);
+
+    if (source != NULL)
+        count_uses(uses, *source, false);
+
+    if (instruction->type == ZIR_INSTR_PHI)
+    {
+        ZirPhiInstr *phi = (ZirPhiInstr*) instruction;
+
+        for (size_t i=0; i < fl_array_length(phi->sources); i++)
+            count_uses(uses, phi->sources[i], true);
+    }
+}
+
+/*
+ * Function: find_use
+ *  Returns the slot that holds the *symbol* within the operand, or NULL if the operand does not use it.
+ *  If the slot is the operand of a reference, *in_reference* is set to *true*.
+ */
+static ZirOperand** find_use(ZirOperand **slot, ZirSymbol *symbol, bool *in_reference)
+{
+    ZirOperand *operand = *slot;
+
+    if (operand == NULL)
+        return NULL;
+
+    switch (operand->type)
+    {
+        case ZIR_OPERAND_SYMBOL:
+            return ((ZirSymbolOperand*) operand)->symbol == symbol ? slot : NULL;
+
+        case ZIR_OPERAND_REFERENCE:
+        {
+            ZirReferenceOperand *reference = (ZirReferenceOperand*) operand;
+
+            if (reference->operand->symbol != symbol)
+                return NULL;
+
+            *in_reference = true;
+            return (ZirOperand**) &reference->operand;
+        }
+        case ZIR_OPERAND_ARRAY:
+        {
+            ZirArrayOperand *array = (ZirArrayOperand*) operand;
+
+            for (size_t i=0; i < fl_array_length(array->elements); i++)
+            {
+                ZirOperand **use = find_use(&array->elements[i], symbol, in_reference);
+
+                if (use != NULL)
+                    return use;
+            }
+
+            return NULL;
+        }
+        case ZIR_OPERAND_STRUCT:
+        {
+            ZirStructOperand *struct_operand = (ZirStructOperand*) operand;
+
+            for (size_t i=0; i < fl_array_length(struct_operand->members); i++)
+            {
+                ZirOperand **use = find_use(&struct_operand->members[i]->operand, symbol, in_reference);
+
+                if (use != NULL)
+                    return use;
+            }
+
+            return NULL;
+        }
+
+        default: return NULL;
+    }
+}
+
+static bool defines_symbol(ZirInstr *instruction, ZirSymbol *symbol)
+{
+    if (instruction->type != ZIR_INSTR_VARIABLE && instruction->type != ZIR_INSTR_CAST && instruction->type != ZIR_INSTR_PHI)
+        return false;
+
+    return instruction->destination != NULL
+        && instruction->destination->type == ZIR_OPERAND_SYMBOL
+        && ((ZirSymbolOperand*) instruction->destination)->symbol == symbol;
+}
+
+/*
+ * Function: definition_value
+ *  Returns the value the temporal symbol holds. The casts of uint literals are evaluated, so that the
+ *  literal has the type of the cast (truncated if needed)
+ */
+static ZirOperand* definition_value(ZirProgram *program, ZirInstr *definition)
+{
+    ZirOperand *source = *instruction_source(definition);
+
+    if (definition->type != ZIR_INSTR_CAST || source->type != ZIR_OPERAND_UINT)
+        return source;
+
+    ZirType *cast_type = ((ZirSymbolOperand*) definition->destination)->symbol->type;
+
+    if (cast_type->typekind != ZIR_TYPE_UINT)
+        return source;
+
+    ZirUintOperand *literal = (ZirUintOperand*) source;
+    uint16_t value = literal->type->size == ZIR_UINT_8 ? literal->value.uint8 : literal->value.uint16;
+
+    ZirUintTypeSize size = ((ZirUintType*) cast_type)->size;
+    ZirUintValue cast_value = { 0 };
+
+    if (size == ZIR_UINT_8)
+        cast_value.uint8 = (uint8_t) (value & 0xFF);
+    else if (size == ZIR_UINT_16)
+        cast_value.uint16 = value;
+    else
+        return source;
+
+    return (ZirOperand*) zir_operand_pool_new_uint(program->operands, zir_type_ctx_new_uint(program->types, size), cast_value);
+}
+
+static ZirUintTypeSize uint_size(ZirType *type)
+{
+    return type->typekind == ZIR_TYPE_UINT ? ((ZirUintType*) type)->size : ZIR_UINT_UNK;
+}
+
+/*
+ * Function: is_exact_cast_chain
+ *  Returns *true* if casting the inner cast's source straight to the outer cast's type gives the same value,
+ *  which is the case when the inner cast does not truncate any of the bits the outer cast keeps
+ */
+static bool is_exact_cast_chain(ZirInstr *inner, ZirInstr *outer)
+{
+    ZirOperand *source = *instruction_source(inner);
+
+    if (source->type != ZIR_OPERAND_SYMBOL)
+        return false;
+
+    ZirUintTypeSize source_size = uint_size(((ZirSymbolOperand*) source)->symbol->type);
+    ZirUintTypeSize inner_size = uint_size(((ZirSymbolOperand*) inner->destination)->symbol->type);
+    ZirUintTypeSize outer_size = uint_size(((ZirSymbolOperand*) outer->destination)->symbol->type);
+
+    if (source_size == ZIR_UINT_UNK || inner_size == ZIR_UINT_UNK || outer_size == ZIR_UINT_UNK)
+        return false;
+
+    return inner_size >= source_size || inner_size >= outer_size;
+}
+
+/*
+ * Function: forward_definition
+ *  Looks for the use of the temporal symbol defined by the instruction at *index* in the rest of the basic
+ *  block, and if it can be forwarded, it replaces the use with the definition's source.
+ */
+static bool forward_definition(ZirProgram *program, ZirBasicBlock *block, size_t index, ZirSymbol *temp)
+{
+    ZirInstr *definition = block->instructions[index];
+    ZirOperand *value = *instruction_source(definition);
+
+    // If the value is a symbol, it must not be redefined before the use
+    ZirSymbol *value_symbol = value->type == ZIR_OPERAND_SYMBOL ? ((ZirSymbolOperand*) value)->symbol : NULL;
+
+    // A cast of a temporal symbol is kept, forwarding it would skip the cast that defines the inner symbol
+    if (definition->type == ZIR_INSTR_CAST && value_symbol != NULL && is_temp_symbol(value_symbol))
+        return false;
+
+    size_t length = fl_array_length(block->instructions);
+
+    for (size_t i=index + 1; i <= length; i++)
+    {
+        ZirInstr *instruction = i < length ? block->instructions[i] : block->terminator;
+
+        if (instruction == NULL)
+            return false;
+
+        bool in_reference = false;
+        ZirOperand **source = instruction_source(instruction);
+        ZirOperand **use = source != NULL ? find_use(source, temp, &in_reference) : NULL;
+
+        if (use != NULL)
+        {
+            ZirOperand *forwarded = definition_value(program, definition);
+
+            // A reference can only point to a symbol
+            if (in_reference && forwarded->type != ZIR_OPERAND_SYMBOL)
+                return false;
+
+            // A cast of a cast keeps the inner one if it truncates a value that is not known at compile time
+            if (instruction->type == ZIR_INSTR_CAST && definition->type == ZIR_INSTR_CAST
+                && forwarded->type != ZIR_OPERAND_UINT && !is_exact_cast_chain(definition, instruction))
+                return false;
+
+            *use = forwarded;
+            return true;
+        }
+
+        if (value_symbol != NULL && defines_symbol(instruction, value_symbol))
+            return false;
+    }
+
+    return false;
+}
+
+static size_t forward_cfg(ZirProgram *program, ZirCfg *cfg)
+{
+    FlHashtable *uses = fl_hashtable_new_args((struct FlHashtableArgs) {
+        .hash_function = fl_hashtable_hash_string,
+        .key_allocator = fl_container_allocator_string,
+        .key_comparer = fl_container_equals_string,
+        .key_cleaner = fl_container_cleaner_pointer,
+        .value_cleaner = fl_container_cleaner_pointer,
+        .value_allocator = NULL
+    });
+
+    for (size_t i=0; i < fl_array_length(cfg->blocks); i++)
+    {
+        ZirBasicBlock *block = cfg->blocks[i];
+
+        for (size_t j=0; j < fl_array_length(block->instructions); j++)
+            count_instruction_uses(uses, block->instructions[j]);
+
+        if (block->terminator != NULL)
+            count_instruction_uses(uses, block->terminator);
+    }
+
+    size_t removed = 0;
+
+    for (size_t i=0; i < fl_array_length(cfg->blocks); i++)
+    {
+        ZirBasicBlock *block = cfg->blocks[i];
+
+        // The blocks are walked backwards so that chains of temporal symbols collapse in a single walk
+        for (size_t j = fl_array_length(block->instructions); j > 0; j--)
+        {
+            ZirInstr *instruction = block->instructions[j - 1];
+            ZirSymbol *temp = defined_temp(instruction);
+
+            if (temp == NULL)
+                continue;
+
+            TempUses *temp_uses = (TempUses*) fl_hashtable_get(uses, temp->name);
+
+            if (temp_uses == NULL || temp_uses->count != 1 || temp_uses->pinned)
+                continue;
+
+            if (!forward_definition(program, block, j - 1, temp))
+                continue;
+
+            zir_instruction_free(instruction);
+
+            size_t length = fl_array_length(block->instructions);
+            memmove(block->instructions + j - 1, block->instructions + j, sizeof(ZirInstr*) * (length - j));
+            block->instructions = fl_array_resize(block->instructions, length - 1);
+
+            removed++;
+        }
+    }
+
+    fl_hashtable_free(uses);
+
+    return removed;
+}
+
+static size_t forward_block_tree(ZirProgram *program, ZirBlock *block)
+{
+    size_t removed = 0;
+    size_t count = 0;
+
+    // Forwarding a literal into a cast turns the cast into a candidate, we repeat until nothing changes
+    while ((count = forward_cfg(program, &block->cfg)) > 0)
+        removed += count;
+
+    for (size_t i=0; i < fl_array_length(block->children); i++)
+        removed += forward_block_tree(program, block->children[i]);
+
+    return removed;
+}
+
+size_t zir_forward_temporaries(ZirProgram *program)
+{
+    if (!program)
+        return 0;
+
+    return forward_block_tree(program, program->global);
+}
@@ -0,0 +1,31 @@
+#ifndef ZIR_PASS_FORWARD_TEMPS_H
+#define ZIR_PASS_FORWARD_TEMPS_H
+
+#include <stddef.h>
+#include "../program.h"
+
+/*
+ * Function: zir_forward_temporaries
+ *  Replaces the single use of a temporal symbol (%tmpN) by the source of the instruction that defines it,
+ *  and removes the definition. A temporal symbol is forwarded if it is used once, in the same basic block,
+ *  as the source of a variable instruction (directly or as an array element or struct member), as the
+ *  operand of a reference, or as the condition of an if-false instruction. The casts of uint literals are
+ *  evaluated, and the result is forwarded as a literal of the cast's type. The symbols used by phi
+ *  instructions are kept, and so are the casts of runtime values used by other casts if the inner cast
+ *  truncates bits the outer cast keeps.
+ *
+ * Parameters:
+ *  <ZirProgram> *program: The ZIR program
+ *
+ * Returns:
+ *  size_t: The number of temporal symbols that have been removed
+ *
+ * Notes:
+ *  The pass runs at every optimization level: the NES back end does not allocate memory for the temporal
+ *  symbols, and it cannot generate the code of the ones that are kept. It stores a cast by copying its
+ *  source into the destination's size, so replacing the temporal symbol by the cast's source generates
+ *  the same code.
+ */
+size_t zir_forward_temporaries(ZirProgram *program);
+
+#endif /* ZIR_PASS_FORWARD_TEMPS_H */
@@ -0,0 +1,112 @@
+#include <time.h>
+#include <fllib/Mem.h>
+#include <fllib/Array.h>
+#include <fllib/Cstring.h>
+#include "manager.h"
+#include "dead-globals.h"
+#include "fold-if.h"
+#include "forward-temps.h"
+#include "ssa.h"
+#include "../verify.h"
+
+static const char *level_names[] = {
+    [ZIR_OPT_O0] = "O0",
+    [ZIR_OPT_O1] = "O1",
+    [ZIR_OPT_O2] = "O2",
+};
+
+ZirPassManager* zir_pass_manager_new(ZirOptLevel level)
+{
+    ZirPassManager *manager = fl_malloc(sizeof(ZirPassManager));
+    manager->level = level;
+    manager->passes = fl_array_new(sizeof(ZirPass), 0);
+    manager->error = NULL;
+
+    return manager;
+}
+
+void zir_pass_manager_free(ZirPassManager *manager)
+{
+    if (!manager)
+        return;
+
+    if (manager->error)
+        fl_cstring_free(manager->error);
+
+    fl_array_free(manager->passes);
+    fl_free(manager);
+}
+
+void zir_pass_manager_register(ZirPassManager *manager, const char *name, ZirOptLevel level, ZirPassFunction run)
+{
+    ZirPass pass = {
+        .name = name,
+        .level = level,
+        .run = run,
+        .executed = false,
+        .changes = 0,
+        .elapsed = 0
+    };
+
+    manager->passes = fl_array_append(manager->passes, &pass);
+}
+
+void zir_pass_manager_register_defaults(ZirPassManager *manager)
+{
+    zir_pass_manager_register(manager, "forward-temps", ZIR_OPT_O0, &zir_forward_temporaries);
+    zir_pass_manager_register(manager, "fold-if", ZIR_OPT_O1, &zir_fold_constant_ifs);
+    zir_pass_manager_register(manager, "dead-globals", ZIR_OPT_O1, &zir_eliminate_dead_globals);
+    zir_pass_manager_register(manager, "ssa-construct", ZIR_OPT_O2, &zir_ssa_construct);
+    zir_pass_manager_register(manager, "ssa-destruct", ZIR_OPT_O2, &zir_ssa_destruct);
+}
+
+bool zir_pass_manager_run(ZirPassManager *manager, ZirProgram *program)
+{
+    for (size_t i=0; i < fl_array_length(manager->passes); i++)
+    {
+        ZirPass *pass = &manager->passes[i];
+
+        if (pass->level > manager->level)
+            continue;
+
+        clock_t start = clock();
+        pass->changes = pass->run(program);
+        pass->elapsed = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+        pass->executed = true;
+
+        char *message = NULL;
+        if (!zir_program_verify(program, &message))
+        {
+            manager->error = fl_cstring_vdup("Pass '%s' produced an invalid program: %s", pass->name, message != NULL ? message : "unknown error");
+
+            if (message)
+                fl_cstring_free(message);
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+char* zir_pass_manager_report(ZirPassManager *manager, char *output)
+{
+    fl_cstring_vappend(&output, "%-16s %-6s %8s %12s\n", "pass", "level", "changes", "time (ms)");
+
+    double total = 0;
+
+    for (size_t i=0; i < fl_array_length(manager->passes); i++)
+    {
+        ZirPass *pass = &manager->passes[i];
+
+        if (!pass->executed)
+            continue;
+
+        fl_cstring_vappend(&output, "%-16s %-6s %8zu %12.3f\n", pass->name, level_names[pass->level], pass->changes, pass->elapsed);
+        total += pass->elapsed;
+    }
+
+    fl_cstring_vappend(&output, "%-16s %-6s %8s %12.3f\n", "total", "", "", total);
+
+    return output;
+}
@@ -0,0 +1,149 @@
+#ifndef ZIR_PASS_MANAGER_H
+#define ZIR_PASS_MANAGER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "../program.h"
+
+/*
+ * Enum: ZirOptLevel
+ *  The optimization levels. A pass runs if the level of the pass manager is greater than or equal
+ *  to the level the pass has been registered with
+ */
+typedef enum ZirOptLevel {
+    ZIR_OPT_O0,
+    ZIR_OPT_O1,
+    ZIR_OPT_O2,
+} ZirOptLevel;
+
+/*
+ * Type: ZirPassFunction
+ *  A pass takes the ZIR program and returns the number of changes it made
+ */
+typedef size_t(*ZirPassFunction)(ZirProgram *program);
+
+/*
+ * Struct: ZirPass
+ *  A registered pass and the statistics of its last run
+ *
+ * Members:
+ *  <const char> *name: The name of the pass
+ *  <ZirOptLevel> level: The minimum optimization level that enables the pass
+ *  <ZirPassFunction> run: The pass function
+ *  <bool> executed: *true* if the pass has been executed
+ *  <size_t> changes: The number of changes the pass made
+ *  <double> elapsed: The time it took to run the pass, in milliseconds
+ */
+typedef struct ZirPass {
+    const char *name;
+    ZirOptLevel level;
+    ZirPassFunction run;
+    bool executed;
+    size_t changes;
+    double elapsed;
+} ZirPass;
+
+/*
+ * Struct: ZirPassManager
+ *  Runs the registered passes in order, and verifies the program after each one of them
+ *
+ * Members:
+ *  <ZirOptLevel> level: The optimization level
+ *  <ZirPass> *passes: The registered passes
+ *  <char> *error: If a pass leaves the program in an invalid state, the name of the pass and the error
+ */
+typedef struct ZirPassManager {
+    ZirOptLevel level;
+    ZirPass *passes;
+    char *error;
+} ZirPassManager;
+
+/*
+ * Function: zir_pass_manager_new
+ *  Creates a new pass manager without passes
+ *
+ * Parameters:
+ *  <ZirOptLevel> level: The optimization level
+ *
+ * Returns:
+ *  <ZirPassManager>*: The pass manager
+ *
+ * Notes:
+ *  The object returned by this function must be freed using the
+ *  <zir_pass_manager_free> function
+ */
+ZirPassManager* zir_pass_manager_new(ZirOptLevel level);
+
+/*
+ * Function: zir_pass_manager_free
+ *  Releases the memory used by the pass manager
+ *
+ * Parameters:
+ *  <ZirPassManager> *manager: The pass manager
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void zir_pass_manager_free(ZirPassManager *manager);
+
+/*
+ * Function: zir_pass_manager_register
+ *  Adds a pass at the end of the pass pipeline
+ *
+ * Parameters:
+ *  <ZirPassManager> *manager: The pass manager
+ *  <const char> *name: The name of the pass
+ *  <ZirOptLevel> level: The minimum optimization level that enables the pass
+ *  <ZirPassFunction> run: The pass function
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void zir_pass_manager_register(ZirPassManager *manager, const char *name, ZirOptLevel level, ZirPassFunction run);
+
+/*
+ * Function: zir_pass_manager_register_defaults
+ *  Registers the compiler's pass pipeline:
+ *      - forward-temps (O0): Forwards the temporal symbols into their single use, the back end does not allocate them
+ *      - fold-if (O1): Folds the constant if-false instructions
+ *      - dead-globals (O1): Removes the global variables that are not reachable from a root
+ *      - ssa-construct (O2): Converts the program to SSA form
+ *      - ssa-destruct (O2): Takes the program out of SSA form, the back end does not support phi instructions
+ *
+ * Parameters:
+ *  <ZirPassManager> *manager: The pass manager
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void zir_pass_manager_register_defaults(ZirPassManager *manager);
+
+/*
+ * Function: zir_pass_manager_run
+ *  Runs the passes enabled by the optimization level, in order. The program is verified after each pass
+ *  and the manager stops at the first pass that leaves the program in an invalid state
+ *
+ * Parameters:
+ *  <ZirPassManager> *manager: The pass manager
+ *  <ZirProgram> *program: The ZIR program
+ *
+ * Returns:
+ *  bool: *true* if all the passes left the program in a valid state, otherwise *false*, and the
+ *        error is available in the *error* member
+ */
+bool zir_pass_manager_run(ZirPassManager *manager, ZirProgram *program);
+
+/*
+ * Function: zir_pass_manager_report
+ *  Appends to the output a table with the number of changes and the time of each executed pass
+ *
+ * Parameters:
+ *  <ZirPassManager> *manager: The pass manager
+ *  <char> *output: Pointer to a heap allocated string
+ *
+ * Returns:
+ *  char*: Pointer to the output string
+ */
+char* zir_pass_manager_report(ZirPassManager *manager, char *output);
+
+#endif /* ZIR_PASS_MANAGER_H */
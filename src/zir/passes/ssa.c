@@ -0,0 +1,794 @@
+#include <stdio.h>
+#include <fllib/Mem.h>
+#include <fllib/Array.h>
+#include <fllib/Cstring.h>
+#include <fllib/containers/Hashtable.h>
+#include "ssa.h"
+#include "../dominance.h"
+#include "../instructions/operands/array.h"
+#include "../instructions/operands/reference.h"
+#include "../instructions/operands/struct.h"
+#include "../instructions/operands/symbol.h"
+
+/*
+ * Struct: SsaVariable
+ *  Keeps track of the definitions of a symbol while the CFG is converted to SSA form
+ *
+ * Members:
+ *  <ZirSymbol> *symbol: The symbol
+ *  <size_t> definitions: Number of instructions that define the symbol
+ *  <bool> address_taken: *true* if a reference operand points to the symbol
+ *  <ZirBasicBlock> **def_blocks: The blocks that define the symbol
+ *  <unsigned int> counter: The last version assigned to the symbol
+ *  <unsigned int> *stack: The versions that reach the block being renamed (the top is the current one)
+ */
+typedef struct SsaVariable {
+    ZirSymbol *symbol;
+    size_t definitions;
+    bool address_taken;
+    ZirBasicBlock **def_blocks;
+    unsigned int counter;
+    unsigned int *stack;
+} SsaVariable;
+
+typedef struct SsaContext {
+    ZirProgram *program;
+    ZirBlock *block;
+    ZirCfg *cfg;
+    ZirDominance *dominance;
+    FlHashtable *index;
+    SsaVariable **variables;
+} SsaContext;
+
+static ZirOperand** instruction_source(ZirInstr *instruction)
+{
+    switch (instruction->type)
+    {
+        case ZIR_INSTR_VARIABLE:
+            return &((ZirVariableInstr*) instruction)->source;
+
+        case ZIR_INSTR_CAST:
+            return &((ZirCastInstr*) instruction)->source;
+
+        case ZIR_INSTR_IF_FALSE:
+            return &((ZirIfFalseInstr*) instruction)->source;
+
+        default: break;
+    }
+
+    return NULL;
+}
+
+static ZirSymbol* defined_symbol(ZirInstr *instruction)
+{
+    if (instruction->type != ZIR_INSTR_VARIABLE && instruction->type != ZIR_INSTR_CAST && instruction->type != ZIR_INSTR_PHI)
+        return NULL;
+
+    if (instruction->destination == NULL || instruction->destination->type != ZIR_OPERAND_SYMBOL)
+        return NULL;
+
+    return ((ZirSymbolOperand*) instruction->destination)->symbol;
+}
+
+static SsaVariable* get_variable(SsaContext *ctx, ZirSymbol *symbol)
+{
+    SsaVariable *variable = (SsaVariable*) fl_hashtable_get(ctx->index, symbol->name);
+
+    if (variable != NULL)
+        return variable;
+
+    variable = fl_malloc(sizeof(SsaVariable));
+    variable->symbol = symbol;
+    variable->definitions = 0;
+    variable->address_taken = false;
+    variable->def_blocks = fl_array_new(sizeof(ZirBasicBlock*), 0);
+    variable->counter = 0;
+    variable->stack = fl_array_new(sizeof(unsigned int), 0);
+
+    fl_hashtable_add(ctx->index, symbol->name, variable);
+    ctx->variables = fl_array_append(ctx->variables, &variable);
+
+    return variable;
+}
+
+/*
+ * Function: get_candidate
+ *  Returns the SSA information of the symbol if it must be renamed, otherwise NULL
+ */
+static SsaVariable* get_candidate(SsaContext *ctx, ZirSymbol *symbol)
+{
+    SsaVariable *variable = (SsaVariable*) fl_hashtable_get(ctx->index, symbol->name);
+
+    if (variable == NULL || variable->definitions < 2 || variable->address_taken)
+        return NULL;
+
+    return variable;
+}
+
+static void collect_references(SsaContext *ctx, ZirOperand *operand)
+{
+    if (operand == NULL)
+        return;
+
+    switch (operand->type)
+    {
+        case ZIR_OPERAND_REFERENCE:
+            get_variable(ctx, ((ZirReferenceOperand*) operand)->operand->symbol)->address_taken = true;
+            return;
+
+        case ZIR_OPERAND_ARRAY:
+        {
+            ZirArrayOperand *array = (ZirArrayOperand*) operand;
+
+            for (size_t i=0; i < fl_array_length(array->elements); i++)
+                collect_references(ctx, array->elements[i]);
+
+            return;
+        }
+        case ZIR_OPERAND_STRUCT:
+        {
+            ZirStructOperand *struct_operand = (ZirStructOperand*) operand;
+
+            for (size_t i=0; i < fl_array_length(struct_operand->members); i++)
+                collect_references(ctx, struct_operand->members[i]->operand);
+
+            return;
+        }
+
+        default: return;
+    }
+}
+
+static void collect_instruction(SsaContext *ctx, ZirBasicBlock *block, ZirInstr *instruction)
+{
+    ZirOperand **source = instruction_source(instruction);
+
+    if (source != NULL)
+        collect_references(ctx, *source);
+
+    ZirSymbol *symbol = defined_symbol(instruction);
+
+    if (symbol == NULL)
+        return;
+
+    SsaVariable *variable = get_variable(ctx, symbol);
+    variable->definitions++;
+
+    size_t def_count = fl_array_length(variable->def_blocks);
+
+    // The blocks are visited in order, we just need to check the last one to not add the same block twice
+    if (def_count == 0 || variable->def_blocks[def_count - 1] != block)
+        variable->def_blocks = fl_array_append(variable->def_blocks, &block);
+}
+
+static void collect_definitions(SsaContext *ctx)
+{
+    for (size_t i=0; i < fl_array_length(ctx->cfg->blocks); i++)
+    {
+        ZirBasicBlock *block = ctx->cfg->blocks[i];
+
+        for (size_t j=0; j < fl_array_length(block->instructions); j++)
+            collect_instruction(ctx, block, block->instructions[j]);
+
+        if (block->terminator != NULL)
+            collect_instruction(ctx, block, block->terminator);
+    }
+}
+
+static size_t count_phis(ZirBasicBlock *block)
+{
+    size_t count = 0;
+
+    while (count < fl_array_length(block->instructions) && block->instructions[count]->type == ZIR_INSTR_PHI)
+        count++;
+
+    return count;
+}
+
+static void insert_phi(SsaContext *ctx, ZirBasicBlock *block, SsaVariable *variable)
+{
+    ZirOperand *destination = (ZirOperand*) zir_operand_pool_new_symbol(ctx->program->operands, variable->symbol);
+    ZirInstr *phi = (ZirInstr*) zir_phi_instr_new(destination);
+
+    size_t length = fl_array_length(block->instructions);
+    block->instructions = fl_array_resize(block->instructions, length + 1);
+    memmove(block->instructions + 1, block->instructions, sizeof(ZirInstr*) * length);
+    block->instructions[0] = phi;
+}
+
+/*
+ * Function: insert_phis
+ *  Places the phi instructions of each candidate symbol in the iterated dominance frontier of the
+ *  blocks that define it
+ */
+static size_t insert_phis(SsaContext *ctx)
+{
+    size_t count = fl_array_length(ctx->cfg->blocks);
+    size_t inserted = 0;
+
+    bool *has_phi = fl_malloc(sizeof(bool) * count);
+    bool *queued = fl_malloc(sizeof(bool) * count);
+    ZirBasicBlock **worklist = fl_malloc(sizeof(ZirBasicBlock*) * count);
+
+    for (size_t i=0; i < fl_array_length(ctx->variables); i++)
+    {
+        SsaVariable *variable = ctx->variables[i];
+
+        if (get_candidate(ctx, variable->symbol) == NULL)
+            continue;
+
+        memset(has_phi, 0, sizeof(bool) * count);
+        memset(queued, 0, sizeof(bool) * count);
+        size_t top = 0;
+
+        for (size_t j=0; j < fl_array_length(variable->def_blocks); j++)
+        {
+            queued[variable->def_blocks[j]->index] = true;
+            worklist[top++] = variable->def_blocks[j];
+        }
+
+        while (top > 0)
+        {
+            ZirBasicBlock *block = worklist[--top];
+            ZirBasicBlock **frontier = ctx->dominance->frontier[block->index];
+
+            for (size_t j=0; j < fl_array_length(frontier); j++)
+            {
+                ZirBasicBlock *join = frontier[j];
+
+                if (has_phi[join->index])
+                    continue;
+
+                insert_phi(ctx, join, variable);
+                has_phi[join->index] = true;
+                inserted++;
+
+                // The phi instruction is a new definition of the symbol
+                if (!queued[join->index])
+                {
+                    queued[join->index] = true;
+                    worklist[top++] = join;
+                }
+            }
+        }
+    }
+
+    fl_free(worklist);
+    fl_free(queued);
+    fl_free(has_phi);
+
+    return inserted;
+}
+
+static unsigned int current_version(SsaVariable *variable)
+{
+    size_t length = fl_array_length(variable->stack);
+
+    // If no definition reaches the use, the symbol is used before it is defined
+    return length > 0 ? variable->stack[length - 1] : 0;
+}
+
+static ZirOperand* versioned_operand(SsaContext *ctx, SsaVariable *variable, unsigned int version)
+{
+    ZirSymbolOperand *operand = zir_operand_pool_new_symbol(ctx->program->operands, variable->symbol);
+    operand->version = version;
+
+    return (ZirOperand*) operand;
+}
+
+static void rename_uses(SsaContext *ctx, ZirOperand **slot)
+{
+    ZirOperand *operand = *slot;
+
+    if (operand == NULL)
+        return;
+
+    switch (operand->type)
+    {
+        case ZIR_OPERAND_SYMBOL:
+        {
+            SsaVariable *variable = get_candidate(ctx, ((ZirSymbolOperand*) operand)->symbol);
+
+            // The operands might be shared between instructions, we replace the operand instead of updating it
+            if (variable != NULL)
+                *slot = versioned_operand(ctx, variable, current_version(variable));
+
+            return;
+        }
+        case ZIR_OPERAND_ARRAY:
+        {
+            ZirArrayOperand *array = (ZirArrayOperand*) operand;
+
+            for (size_t i=0; i < fl_array_length(array->elements); i++)
+                rename_uses(ctx, &array->elements[i]);
+
+            return;
+        }
+        case ZIR_OPERAND_STRUCT:
+        {
+            ZirStructOperand *struct_operand = (ZirStructOperand*) operand;
+
+            for (size_t i=0; i < fl_array_length(struct_operand->members); i++)
+                rename_uses(ctx, &struct_operand->members[i]->operand);
+
+            return;
+        }
+
+        default: return;
+    }
+}
+
+static void rename_instruction(SsaContext *ctx, ZirInstr *instruction, SsaVariable ***pushed)
+{
+    ZirOperand **source = instruction_source(instruction);
+
+    // Uses go first, the instruction might use the previous version of the symbol it defines
+    if (source != NULL)
+        rename_uses(ctx, source);
+
+    ZirSymbol *symbol = defined_symbol(instruction);
+    SsaVariable *variable = symbol != NULL ? get_candidate(ctx, symbol) : NULL;
+
+    if (variable == NULL)
+        return;
+
+    unsigned int version = ++variable->counter;
+    variable->stack = fl_array_append(variable->stack, &version);
+    instruction->destination = versioned_operand(ctx, variable, version);
+
+    *pushed = fl_array_append(*pushed, &variable);
+}
+
+/*
+ * Function: rename_block
+ *  Renames the definitions and uses of the candidate symbols walking the dominator tree, so that each
+ *  use refers to the version defined by its closest dominating definition
+ */
+static void rename_block(SsaContext *ctx, ZirBasicBlock *block)
+{
+    SsaVariable **pushed = fl_array_new(sizeof(SsaVariable*), 0);
+
+    for (size_t i=0; i < fl_array_length(block->instructions); i++)
+        rename_instruction(ctx, block->instructions[i], &pushed);
+
+    if (block->terminator != NULL)
+        rename_instruction(ctx, block->terminator, &pushed);
+
+    // Fill the phi instructions of the successors with the versions that flow from this block
+    for (size_t i=0; i < fl_array_length(block->successors); i++)
+    {
+        ZirBasicBlock *successor = block->successors[i];
+        size_t phi_count = count_phis(successor);
+
+        for (size_t j=0; j < phi_count; j++)
+        {
+            ZirPhiInstr *phi = (ZirPhiInstr*) successor->instructions[j];
+            SsaVariable *variable = get_candidate(ctx, defined_symbol((ZirInstr*) phi));
+
+            zir_phi_instr_add_source(phi, versioned_operand(ctx, variable, current_version(variable)), block);
+        }
+    }
+
+    ZirBasicBlock **children = ctx->dominance->children[block->index];
+    for (size_t i=0; i < fl_array_length(children); i++)
+        rename_block(ctx, children[i]);
+
+    for (size_t i=0; i < fl_array_length(pushed); i++)
+        pushed[i]->stack = fl_array_resize(pushed[i]->stack, fl_array_length(pushed[i]->stack) - 1);
+
+    fl_array_free(pushed);
+}
+
+static size_t construct_cfg(ZirProgram *program, ZirBlock *block)
+{
+    ZirCfg *cfg = &block->cfg;
+
+    SsaContext ctx = {
+        .program = program,
+        .block = block,
+        .cfg = cfg,
+        .dominance = NULL,
+        .index = fl_hashtable_new_args((struct FlHashtableArgs) {
+            .hash_function = fl_hashtable_hash_string,
+            .key_allocator = fl_container_allocator_string,
+            .key_comparer = fl_container_equals_string,
+            .key_cleaner = fl_container_cleaner_pointer,
+            .value_cleaner = NULL,
+            .value_allocator = NULL
+        }),
+        .variables = fl_array_new(sizeof(SsaVariable*), 0)
+    };
+
+    zir_cfg_update_edges(cfg);
+    collect_definitions(&ctx);
+
+    bool has_candidates = false;
+    for (size_t i=0; i < fl_array_length(ctx.variables) && !has_candidates; i++)
+        has_candidates = get_candidate(&ctx, ctx.variables[i]->symbol) != NULL;
+
+    size_t inserted = 0;
+
+    // If every symbol is defined once, the CFG is already in SSA form
+    if (has_candidates)
+    {
+        ctx.dominance = zir_dominance_new(cfg);
+        inserted = insert_phis(&ctx);
+        rename_block(&ctx, cfg->blocks[0]);
+        zir_dominance_free(ctx.dominance);
+    }
+
+    for (size_t i=0; i < fl_array_length(ctx.variables); i++)
+    {
+        fl_array_free(ctx.variables[i]->def_blocks);
+        fl_array_free(ctx.variables[i]->stack);
+        fl_free(ctx.variables[i]);
+    }
+
+    fl_array_free(ctx.variables);
+    fl_hashtable_free(ctx.index);
+
+    return inserted;
+}
+
+static size_t construct_block_tree(ZirProgram *program, ZirBlock *block)
+{
+    size_t inserted = construct_cfg(program, block);
+
+    for (size_t i=0; i < fl_array_length(block->children); i++)
+        inserted += construct_block_tree(program, block->children[i]);
+
+    return inserted;
+}
+
+size_t zir_ssa_construct(ZirProgram *program)
+{
+    if (!program)
+        return 0;
+
+    return construct_block_tree(program, program->global);
+}
+
+static void strip_versions(ZirOperand *operand)
+{
+    if (operand == NULL)
+        return;
+
+    switch (operand->type)
+    {
+        case ZIR_OPERAND_SYMBOL:
+            ((ZirSymbolOperand*) operand)->version = 0;
+            return;
+
+        case ZIR_OPERAND_REFERENCE:
+            ((ZirReferenceOperand*) operand)->operand->version = 0;
+            return;
+
+        case ZIR_OPERAND_ARRAY:
+        {
+            ZirArrayOperand *array = (ZirArrayOperand*) operand;
+
+            for (size_t i=0; i < fl_array_length(array->elements); i++)
+                strip_versions(array->elements[i]);
+
+            return;
+        }
+        case ZIR_OPERAND_STRUCT:
+        {
+            ZirStructOperand *struct_operand = (ZirStructOperand*) operand;
+
+            for (size_t i=0; i < fl_array_length(struct_operand->members); i++)
+                strip_versions(struct_operand->members[i]->operand);
+
+            return;
+        }
+
+        default: return;
+    }
+}
+
+static void strip_instruction_versions(ZirInstr *instruction)
+{
+    ZirOperand **source = instruction_source(instruction);
+
+    if (source != NULL)
+        strip_versions(*source);
+
+    if (instruction->type == ZIR_INSTR_PHI)
+    {
+        ZirPhiInstr *phi = (ZirPhiInstr*) instruction;
+
+        for (size_t i=0; i < fl_array_length(phi->sources); i++)
+            strip_versions(phi->sources[i]);
+    }
+
+    if (instruction->type != ZIR_INSTR_IF_FALSE && instruction->type != ZIR_INSTR_JUMP)
+        strip_versions(instruction->destination);
+}
+
+static bool reads_symbol(ZirOperand *operand, ZirSymbol *symbol)
+{
+    return operand != NULL && operand->type == ZIR_OPERAND_SYMBOL && ((ZirSymbolOperand*) operand)->symbol == symbol;
+}
+
+/*
+ * Function: split_edge
+ *  Places a new basic block in the edge that goes from *from* to *to*, and returns it. The new block is
+ *  placed right before *to*, so that it falls through to it. If *from* reaches *to* through its terminator,
+ *  the terminator is retargeted to the new block, and the block that used to fall through to *to* gets a
+ *  jump to keep its successor.
+ */
+static ZirBasicBlock* split_edge(ZirCfg *cfg, ZirBasicBlock *from, ZirBasicBlock *to)
+{
+    ZirBasicBlock *edge_block = zir_cfg_new_basic_block(cfg);
+
+    if (zir_cfg_terminator_target(from->terminator) == to)
+    {
+        ZirBasicBlock *previous = cfg->blocks[to->index - 1];
+
+        ((ZirIfFalseInstr*) from->terminator)->target = edge_block;
+
+        if (previous->terminator == NULL)
+        {
+            previous->terminator = (ZirInstr*) zir_jump_instr_new(to);
+        }
+        else if (previous->terminator->type == ZIR_INSTR_IF_FALSE)
+        {
+            ZirBasicBlock *jump_block = zir_cfg_new_basic_block(cfg);
+            jump_block->terminator = (ZirInstr*) zir_jump_instr_new(to);
+            zir_cfg_insert_basic_block(cfg, to->index, jump_block);
+        }
+    }
+
+    zir_cfg_insert_basic_block(cfg, to->index, edge_block);
+    zir_cfg_update_edges(cfg);
+
+    return edge_block;
+}
+
+/*
+ * Struct: SsaCopies
+ *  The copies the phi instructions of a block need in one of its incoming edges
+ */
+typedef struct SsaCopies {
+    ZirBasicBlock *predecessor;
+    ZirSymbol **destinations;
+    ZirOperand **sources;
+} SsaCopies;
+
+/*
+ * Function: new_swap_symbol
+ *  Creates a symbol in the block to save the value of *symbol* while a cycle of copies runs. It is not a
+ *  temporal symbol (those are forwarded into their uses), its name cannot clash with a Zenit identifier.
+ */
+static ZirSymbol* new_swap_symbol(SsaContext *ctx, ZirSymbol *symbol)
+{
+    char name[1024] = { 0 };
+    snprintf(name, 1024, "$swap%llu", ctx->block->temp_counter++);
+
+    ZirSymbol *swap_symbol = zir_symbol_new(name, symbol->type);
+    swap_symbol->linkage = ZIR_LINKAGE_LOCAL;
+
+    return zir_symtable_add(&ctx->block->symtable, swap_symbol);
+}
+
+/*
+ * Function: sequentialize_copies
+ *  The copies of an edge run in parallel: a copy cannot overwrite a symbol that another pending copy
+ *  still needs to read. The function sorts the copies in an order that respects that. If the copies
+ *  depend on each other (a cycle, like a swap), the value of one of the symbols is saved in a new
+ *  symbol and the pending copies read it from there, which breaks the cycle.
+ */
+static void sequentialize_copies(SsaContext *ctx, SsaCopies *copies)
+{
+    size_t count = fl_array_length(copies->sources);
+
+    ZirSymbol **destinations = fl_array_new(sizeof(ZirSymbol*), 0);
+    ZirOperand **sources = fl_array_new(sizeof(ZirOperand*), 0);
+    bool *emitted = fl_malloc(sizeof(bool) * (count > 0 ? count : 1));
+    memset(emitted, 0, sizeof(bool) * (count > 0 ? count : 1));
+
+    size_t emitted_count = 0;
+
+    while (emitted_count < count)
+    {
+        bool progress = false;
+
+        for (size_t i=0; i < count; i++)
+        {
+            if (emitted[i])
+                continue;
+
+            bool is_read = false;
+
+            for (size_t j=0; j < count && !is_read; j++)
+                is_read = !emitted[j] && j != i && reads_symbol(copies->sources[j], copies->destinations[i]);
+
+            if (is_read)
+                continue;
+
+            destinations = fl_array_append(destinations, &copies->destinations[i]);
+            sources = fl_array_append(sources, &copies->sources[i]);
+            emitted[i] = true;
+            emitted_count++;
+            progress = true;
+        }
+
+        if (progress)
+            continue;
+
+        // Every pending copy is part of a cycle: we save the destination of one of them, and the copies
+        // that read it read the saved value
+        size_t pending = 0;
+        while (emitted[pending])
+            pending++;
+
+        ZirSymbol *symbol = copies->destinations[pending];
+        ZirSymbol *swap_symbol = new_swap_symbol(ctx, symbol);
+        ZirOperand *saved = (ZirOperand*) zir_operand_pool_new_symbol(ctx->program->operands, symbol);
+        ZirOperand *swap = (ZirOperand*) zir_operand_pool_new_symbol(ctx->program->operands, swap_symbol);
+
+        destinations = fl_array_append(destinations, &swap_symbol);
+        sources = fl_array_append(sources, &saved);
+
+        for (size_t j=0; j < count; j++)
+            if (!emitted[j] && reads_symbol(copies->sources[j], symbol))
+                copies->sources[j] = swap;
+    }
+
+    fl_free(emitted);
+    fl_array_free(copies->sources);
+    fl_array_free(copies->destinations);
+
+    copies->destinations = destinations;
+    copies->sources = sources;
+}
+
+/*
+ * Function: destruct_join
+ *  Places the copies the phi instructions of the *block* need in its incoming edges and removes the phi
+ *  instructions. Returns the number of removed phi instructions.
+ */
+static size_t destruct_join(SsaContext *ctx, ZirBasicBlock *block)
+{
+    size_t phi_count = count_phis(block);
+
+    if (phi_count == 0)
+        return 0;
+
+    // The edges are split while the copies are placed, we collect the copies of each predecessor first. The
+    // fall-through predecessor goes first, because splitting a jump edge might need to reroute it
+    size_t pred_count = fl_array_length(block->predecessors);
+    SsaCopies *edges = fl_malloc(sizeof(SsaCopies) * (pred_count > 0 ? pred_count : 1));
+    size_t sorted = 0;
+
+    for (size_t pass=0; pass < 2; pass++)
+    {
+        for (size_t i=0; i < pred_count; i++)
+        {
+            ZirBasicBlock *predecessor = block->predecessors[i];
+            bool jumps = zir_cfg_terminator_target(predecessor->terminator) == block;
+
+            if ((pass == 0) == jumps)
+                continue;
+
+            SsaCopies *copies = &edges[sorted++];
+            copies->predecessor = predecessor;
+            copies->destinations = fl_array_new(sizeof(ZirSymbol*), 0);
+            copies->sources = fl_array_new(sizeof(ZirOperand*), 0);
+
+            for (size_t j=0; j < phi_count; j++)
+            {
+                ZirPhiInstr *phi = (ZirPhiInstr*) block->instructions[j];
+                ZirSymbol *symbol = ((ZirSymbolOperand*) phi->base.destination)->symbol;
+
+                for (size_t k=0; k < fl_array_length(phi->blocks); k++)
+                {
+                    // A version of the phi's own symbol does not need a copy
+                    if (phi->blocks[k] != predecessor || reads_symbol(phi->sources[k], symbol))
+                        continue;
+
+                    copies->destinations = fl_array_append(copies->destinations, &symbol);
+                    copies->sources = fl_array_append(copies->sources, &phi->sources[k]);
+                }
+            }
+        }
+    }
+
+    for (size_t i=0; i < pred_count; i++)
+        sequentialize_copies(ctx, &edges[i]);
+
+    for (size_t i=0; i < pred_count; i++)
+    {
+        SsaCopies *copies = &edges[i];
+        size_t copy_count = fl_array_length(copies->sources);
+
+        if (copy_count > 0)
+        {
+            ZirBasicBlock *target = copies->predecessor;
+
+            if (fl_array_length(target->successors) > 1)
+                target = split_edge(ctx->cfg, target, block);
+
+            for (size_t j=0; j < copy_count; j++)
+            {
+                ZirOperand *destination = (ZirOperand*) zir_operand_pool_new_symbol(ctx->program->operands, copies->destinations[j]);
+                ZirVariableInstr *copy = zir_variable_instr_new(destination, copies->sources[j]);
+                copy->attributes = zir_attribute_map_new();
+
+                target->instructions = fl_array_append(target->instructions, &copy);
+            }
+        }
+
+        fl_array_free(copies->destinations);
+        fl_array_free(copies->sources);
+    }
+
+    fl_free(edges);
+
+    for (size_t i=0; i < phi_count; i++)
+        zir_instruction_free(block->instructions[i]);
+
+    size_t length = fl_array_length(block->instructions);
+    memmove(block->instructions, block->instructions + phi_count, sizeof(ZirInstr*) * (length - phi_count));
+    block->instructions = fl_array_resize(block->instructions, length - phi_count);
+
+    return phi_count;
+}
+
+static size_t destruct_cfg(ZirProgram *program, ZirBlock *block)
+{
+    ZirCfg *cfg = &block->cfg;
+
+    SsaContext ctx = {
+        .program = program,
+        .block = block,
+        .cfg = cfg,
+        .dominance = NULL,
+        .index = NULL,
+        .variables = NULL
+    };
+
+    zir_cfg_update_edges(cfg);
+
+    // The edges that are split add blocks to the layout, we work on a copy of it
+    size_t count = fl_array_length(cfg->blocks);
+    ZirBasicBlock **blocks = fl_malloc(sizeof(ZirBasicBlock*) * count);
+    memcpy(blocks, cfg->blocks, sizeof(ZirBasicBlock*) * count);
+
+    size_t removed = 0;
+    for (size_t i=0; i < count; i++)
+        removed += destruct_join(&ctx, blocks[i]);
+
+    fl_free(blocks);
+
+    for (size_t i=0; i < fl_array_length(cfg->blocks); i++)
+    {
+        ZirBasicBlock *block = cfg->blocks[i];
+
+        for (size_t j=0; j < fl_array_length(block->instructions); j++)
+            strip_instruction_versions(block->instructions[j]);
+
+        if (block->terminator != NULL)
+            strip_instruction_versions(block->terminator);
+    }
+
+    return removed;
+}
+
+static size_t destruct_block_tree(ZirProgram *program, ZirBlock *block)
+{
+    size_t removed = destruct_cfg(program, block);
+
+    for (size_t i=0; i < fl_array_length(block->children); i++)
+        removed += destruct_block_tree(program, block->children[i]);
+
+    return removed;
+}
+
+size_t zir_ssa_destruct(ZirProgram *program)
+{
+    if (!program)
+        return 0;
+
+    return destruct_block_tree(program, program->global);
+}
@@ -0,0 +1,43 @@
+#ifndef ZIR_PASS_SSA_H
+#define ZIR_PASS_SSA_H
+
+#include <stddef.h>
+#include "../program.h"
+
+/*
+ * Function: zir_ssa_construct
+ *  Converts the program to SSA form. The symbols that are defined more than once get a version on
+ *  each definition (@a.1, @a.2, ...), the uses are renamed to the version that reaches them, and phi
+ *  instructions are inserted where different versions merge (the iterated dominance frontier of the
+ *  definitions). Symbols with a single definition are already in SSA form and keep their names, and
+ *  symbols whose address is taken are not renamed.
+ *
+ * Parameters:
+ *  <ZirProgram> *program: The ZIR program
+ *
+ * Returns:
+ *  size_t: The number of inserted phi instructions
+ */
+size_t zir_ssa_construct(ZirProgram *program);
+
+/*
+ * Function: zir_ssa_destruct
+ *  Takes the program out of SSA form: the versions of a symbol are merged back into the symbol and the
+ *  phi instructions are removed. If a source of a phi instruction is not a version of the phi's symbol
+ *  (because an optimization replaced it), a copy is placed at the end of the predecessor, splitting the
+ *  edge if the predecessor has more than one successor.
+ *
+ * Parameters:
+ *  <ZirProgram> *program: The ZIR program
+ *
+ * Returns:
+ *  size_t: The number of removed phi instructions
+ *
+ * Notes:
+ *  The versions of a symbol must not interfere with each other (the program must be in conventional
+ *  SSA form). When the copies of an edge depend on each other (a cycle, like a swap), one of the values
+ *  is saved in a new local symbol of the block (named $swapN) to break the cycle.
+ */
+size_t zir_ssa_destruct(ZirProgram *program);
+
+#endif /* ZIR_PASS_SSA_H */
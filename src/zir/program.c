@@ -9,6 +9,10 @@ ZirProgram* zir_program_new()
     program->global = zir_block_new("global", ZIR_BLOCK_GLOBAL, NULL);
     program->current = program->global;
     program->operands = zir_operand_pool_new();
+    program->types = zir_type_ctx_new();
+    program->dead_globals = fl_array_new(sizeof(ZirSymbol*), 0);
+    program->origin = (ZirSourceOrigin) { 0 };
+    program->units = fl_array_new(sizeof(ZirProgram*), 0);
 
     return program;
 }
@@ -19,9 +23,17 @@ void zir_program_free(ZirProgram *program)
         return;
 
     zir_operand_pool_free(program->operands);
+
+    fl_array_free(program->dead_globals);
         
     zir_block_free(program->global);
 
+    // The linked units own the operands and types of the moved instructions and symbols
+    fl_array_free_each_pointer(program->units, (FlArrayFreeElementFunc) zir_program_free);
+
+    // The symbols and the operands reference the types, so the context goes last
+    zir_type_ctx_free(program->types);
+
     fl_free(program);
 }
 
@@ -105,8 +117,18 @@ ZirSymbol* zir_program_add_symbol(ZirProgram *program, ZirSymbol *symbol)
 
 ZirInstr* zir_program_emit(ZirProgram *program, ZirInstr *instruction)
 {
-    program->current->instructions = fl_array_append(program->current->instructions, &instruction);
-    return instruction;
+    instruction->origin = program->origin;
+    return zir_cfg_emit(&program->current->cfg, instruction);
+}
+
+ZirBasicBlock* zir_program_new_basic_block(ZirProgram *program)
+{
+    return zir_cfg_new_basic_block(&program->current->cfg);
+}
+
+void zir_program_place_basic_block(ZirProgram *program, ZirBasicBlock *basic_block)
+{
+    zir_cfg_place_basic_block(&program->current->cfg, basic_block);
 }
 
 char* zir_program_dump(ZirProgram *program)
@@ -3,6 +3,7 @@
 
 #include "block.h"
 #include "instructions/operands/pool.h"
+#include "types/context.h"
 
 /*
  * Struct: ZirProgram
@@ -12,11 +13,20 @@
  *  <ZirBlock> *global: A pointer to the global block
  *  <ZirBlock> *current: A pointer to the current block
  *  <ZirOperandPool> *operands: Keeps track of the operands. (Work as a root aggregate for operand objects)
+ *  <ZirTypeContext> *types: Owns the types of the symbols and operands of the program
+ *  <ZirSymbol> **dead_globals: The global variables removed by the dead globals elimination pass
+ *  <ZirSourceOrigin> origin: The origin of the emitted instructions (see <zir_program_emit>)
+ *  <ZirProgram> **units: The programs merged into this one by the linker (see <zir_link_programs>). They keep
+ *                        the operands and types referenced by the moved instructions
  */
 typedef struct ZirProgram {
     ZirBlock *global;
     ZirBlock *current;
     ZirOperandPool *operands;
+    ZirTypeContext *types;
+    ZirSymbol **dead_globals;
+    ZirSourceOrigin origin;
+    struct ZirProgram **units;
 } ZirProgram;
 
 /*
@@ -131,7 +141,8 @@ ZirSymbol* zir_program_add_symbol(ZirProgram *program, ZirSymbol *symbol);
 
 /*
  * Function: zir_program_emit
- *  Adds a new instruction to the current program's block
+ *  Adds a new instruction to the current program's block. The instruction takes the program's
+ *  current *origin*, the code generator updates it on each declaration.
  *
  * Parameters:
  *  <ZirProgram> *program - Program object
@@ -143,6 +154,35 @@ ZirSymbol* zir_program_add_symbol(ZirProgram *program, ZirSymbol *symbol);
  */
 ZirInstr* zir_program_emit(ZirProgram *program, ZirInstr *instruction);
 
+/*
+ * Function: zir_program_new_basic_block
+ *  Creates a basic block in the current program's block that can be used as the target of a jump or
+ *  if-false instruction. The basic block is not placed until <zir_program_place_basic_block> is called
+ *
+ * Parameters:
+ *  <ZirProgram> *program - Program object
+ * 
+ * Returns:
+ *  <ZirBasicBlock>* - The new basic block
+ * 
+ */
+ZirBasicBlock* zir_program_new_basic_block(ZirProgram *program);
+
+/*
+ * Function: zir_program_place_basic_block
+ *  Places the basic block at the end of the current program's block, the following instructions are
+ *  emitted into it
+ *
+ * Parameters:
+ *  <ZirProgram> *program - Program object
+ *  <ZirBasicBlock> *basic_block - Basic block created by <zir_program_new_basic_block>
+ * 
+ * Returns:
+ *  void - This function does not return a value
+ * 
+ */
+void zir_program_place_basic_block(ZirProgram *program, ZirBasicBlock *basic_block);
+
 /*
  * Function: zir_program_dump
  *  Returns a heap allocated string containing a dump of the program object
@@ -0,0 +1,77 @@
+#include <string.h>
+#include <fllib/Mem.h>
+#include <fllib/Array.h>
+#include "slab.h"
+
+static inline size_t chunk_capacity(size_t chunk_index)
+{
+    return (size_t) ZIR_SLAB_FIRST_CHUNK << chunk_index;
+}
+
+ZirSlab zir_slab_new(size_t element_size)
+{
+    return (ZirSlab) {
+        .element_size = element_size,
+        .chunks = fl_array_new(sizeof(FlByte*), 0),
+        .used = 0,
+        .length = 0
+    };
+}
+
+void* zir_slab_alloc(ZirSlab *slab)
+{
+    size_t chunks = fl_array_length(slab->chunks);
+
+    if (chunks == 0 || slab->used == chunk_capacity(chunks - 1))
+    {
+        FlByte *chunk = fl_malloc(chunk_capacity(chunks) * slab->element_size);
+        slab->chunks = fl_array_append(slab->chunks, &chunk);
+        slab->used = 0;
+        chunks++;
+    }
+
+    void *element = slab->chunks[chunks - 1] + slab->used * slab->element_size;
+    memset(element, 0, slab->element_size);
+
+    slab->used++;
+    slab->length++;
+
+    return element;
+}
+
+void zir_slab_foreach(ZirSlab *slab, ZirSlabVisitorFn visitor, void *user_data)
+{
+    size_t chunks = fl_array_length(slab->chunks);
+
+    for (size_t i=0; i < chunks; i++)
+    {
+        size_t used = i == chunks - 1 ? slab->used : chunk_capacity(i);
+
+        for (size_t j=0; j < used; j++)
+            visitor(slab->chunks[i] + j * slab->element_size, user_data);
+    }
+}
+
+void zir_slab_free(ZirSlab *slab, ZirSlabCleanupFn cleaner)
+{
+    size_t chunks = fl_array_length(slab->chunks);
+
+    for (size_t i=0; i < chunks; i++)
+    {
+        if (cleaner != NULL)
+        {
+            size_t used = i == chunks - 1 ? slab->used : chunk_capacity(i);
+
+            for (size_t j=0; j < used; j++)
+                cleaner(slab->chunks[i] + j * slab->element_size);
+        }
+
+        fl_free(slab->chunks[i]);
+    }
+
+    fl_array_free(slab->chunks);
+
+    slab->chunks = NULL;
+    slab->used = 0;
+    slab->length = 0;
+}
@@ -0,0 +1,100 @@
+#ifndef ZIR_SLAB_H
+#define ZIR_SLAB_H
+
+#include <stddef.h>
+#include <fllib/Types.h>
+
+/*
+ * Constant: ZIR_SLAB_FIRST_CHUNK
+ *  Number of elements of the first chunk of a slab, each new chunk doubles the capacity of the previous one
+ */
+#define ZIR_SLAB_FIRST_CHUNK 32
+
+/*
+ * Type: ZirSlabCleanupFn
+ *  Releases the resources owned by an element of a slab, but not the element's memory
+ */
+typedef void(*ZirSlabCleanupFn)(void *element);
+
+/*
+ * Type: ZirSlabVisitorFn
+ *  Receives an element of a slab and the user data passed to <zir_slab_foreach>
+ */
+typedef void(*ZirSlabVisitorFn)(void *element, void *user_data);
+
+/*
+ * Struct: ZirSlab
+ *  An arena of fixed-size elements. The elements are allocated from chunks that double their capacity, so
+ *  the number of allocations is logarithmic in the number of elements, the address of an element does not
+ *  change while the slab is alive, and all the elements are released at once by <zir_slab_free>.
+ *
+ * Members:
+ *  <size_t> element_size: The size of each element
+ *  <FlByte> **chunks: The allocated chunks
+ *  <size_t> used: The number of elements allocated from the last chunk
+ *  <size_t> length: The total number of elements
+ */
+typedef struct ZirSlab {
+    size_t element_size;
+    FlByte **chunks;
+    size_t used;
+    size_t length;
+} ZirSlab;
+
+/*
+ * Function: zir_slab_new
+ *  Creates an empty slab, the memory for the elements is not allocated until the first
+ *  call to <zir_slab_alloc>
+ *
+ * Parameters:
+ *  <size_t> element_size: The size of each element
+ *
+ * Returns:
+ *  ZirSlab: The slab object
+ *
+ * Notes:
+ *  The object returned by this function must be freed using the <zir_slab_free> function
+ */
+ZirSlab zir_slab_new(size_t element_size);
+
+/*
+ * Function: zir_slab_alloc
+ *  Returns the memory for a new element, initialized to zero
+ *
+ * Parameters:
+ *  <ZirSlab> *slab: The slab object
+ *
+ * Returns:
+ *  void*: Pointer to the new element, it is valid until the slab is freed
+ */
+void* zir_slab_alloc(ZirSlab *slab);
+
+/*
+ * Function: zir_slab_foreach
+ *  Calls the *visitor* function with each element in allocation order
+ *
+ * Parameters:
+ *  <ZirSlab> *slab: The slab object
+ *  <ZirSlabVisitorFn> visitor: Function to call with each element
+ *  <void> *user_data: Data passed to each call of the *visitor* function
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void zir_slab_foreach(ZirSlab *slab, ZirSlabVisitorFn visitor, void *user_data);
+
+/*
+ * Function: zir_slab_free
+ *  Calls the *cleaner* function with each element in allocation order, and then frees the memory of
+ *  all the chunks
+ *
+ * Parameters:
+ *  <ZirSlab> *slab: The slab object
+ *  <ZirSlabCleanupFn> cleaner: Function to release the resources owned by each element, or NULL
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void zir_slab_free(ZirSlab *slab, ZirSlabCleanupFn cleaner);
+
+#endif /* ZIR_SLAB_H */
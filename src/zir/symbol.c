@@ -9,6 +9,7 @@ ZirSymbol* zir_symbol_new(const char *name, ZirType *type)
 
     symbol->name = fl_cstring_dup(name);
     symbol->type = type;
+    symbol->linkage = ZIR_LINKAGE_GLOBAL;
 
     return symbol;
 }
@@ -21,9 +22,6 @@ void zir_symbol_free(ZirSymbol *symbol)
     if (symbol->name)
         fl_cstring_free(symbol->name);
 
-    if (symbol->type)
-        zir_type_free(symbol->type);
-
     fl_free(symbol);
 }
 
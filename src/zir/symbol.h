@@ -4,14 +4,34 @@
 #include <stdbool.h>
 #include "types/system.h"
 
+/*
+ * Enum: ZirSymbolLinkage
+ *  The visibility of a symbol when the program is linked with other programs
+ *
+ *  ZIR_LINKAGE_GLOBAL - The symbol is a global variable that other programs can declare as external
+ *  ZIR_LINKAGE_LOCAL - The symbol is a temporal or a variable of a nested block, it is private to its program
+ *  ZIR_LINKAGE_EXTERNAL - The symbol is declared in this program but it is defined by another one
+ */
+typedef enum ZirSymbolLinkage {
+    ZIR_LINKAGE_GLOBAL,
+    ZIR_LINKAGE_LOCAL,
+    ZIR_LINKAGE_EXTERNAL,
+} ZirSymbolLinkage;
+
 /*
  * Struct: ZirSymbol
  *  Represents a symbol of a ZIR program containing the identifier name and
  *  the type information.
+ *
+ * Members:
+ *  <const char> *name: The symbol name
+ *  <ZirType> *type: The type information
+ *  <ZirSymbolLinkage> linkage: The visibility of the symbol, <ZIR_LINKAGE_GLOBAL> by default
  */
 typedef struct ZirSymbol {
     const char *name;
     ZirType *type;
+    ZirSymbolLinkage linkage;
 } ZirSymbol;
 
 /*
@@ -28,7 +48,8 @@ typedef struct ZirSymbol {
  *  ZirSymbol* - The new symbol
  * 
  * Notes:
- *  The object returned by this function must be freed with the <zir_symbol_free> function
+ *  The object returned by this function must be freed with the <zir_symbol_free> function. The
+ *  type object is not owned by the symbol, it must be owned by a <ZirTypeContext>
  *
  */
 ZirSymbol* zir_symbol_new(const char *name, ZirType *type);
@@ -49,6 +49,34 @@ ZirSymbol* zir_symtable_get(ZirSymtable *symtable, const char *symbol_name)
     return (ZirSymbol*)fl_hashtable_get(symtable->symbols, symbol_name);
 }
 
+ZirSymbol* zir_symtable_remove(ZirSymtable *symtable, const char *symbol_name)
+{
+    ZirSymbol *symbol = fl_hashtable_get(symtable->symbols, symbol_name);
+
+    if (symbol == NULL)
+        return NULL;
+
+    struct FlListNode *tmp = fl_list_head(symtable->names);
+
+    while (tmp)
+    {
+        char *name = (char*) tmp->value;
+
+        if (flm_cstring_equals(name, symbol->name))
+        {
+            fl_list_remove(symtable->names, tmp);
+            break;
+        }
+
+        tmp = tmp->next;
+    }
+
+    // The key is compared against the symbol's name, so we remove the entry after the lookup
+    fl_hashtable_remove(symtable->symbols, symbol->name, true, false);
+
+    return symbol;
+}
+
 ZirSymbol** zir_symtable_get_all(ZirSymtable *symtable)
 {
     struct FlListNode *tmp = fl_list_head(symtable->names);
@@ -93,6 +93,24 @@ bool zir_symtable_has(ZirSymtable *symtable, const char *symbol_name);
  */
 ZirSymbol* zir_symtable_get(ZirSymtable *symtable, const char *symbol_name);
 
+/*
+ * Function: zir_symtable_remove
+ *  This function removes the symbol that matches with the *symbol_name* from the symbol table
+ *  and returns the removed object
+ *
+ * Parameters:
+ *  <ZirSymtable> *symtable: Symbol table
+ *  <const char> *symbol_name: Key to lookup the symbol to remove
+ *
+ * Returns:
+ *  ZirSymbol*: Removed symbol, or NULL if it does not exist
+ *
+ * Notes:
+ *  The symbol table losses ownership of the symbol returned by this function, which means that caller
+ *  is in charge of releasing the memory of the symbol.
+ */
+ZirSymbol* zir_symtable_remove(ZirSymtable *symtable, const char *symbol_name);
+
 /*
  * Function: zir_symtable_get_all
  *  Returns an array of all the symbols within the symbol table in the order they were inserted
@@ -138,7 +138,5 @@ void zir_array_type_free(ZirArrayType *type)
     if (type->base.to_string.value != NULL)
         fl_cstring_free(type->base.to_string.value);
 
-    zir_type_free(type->member_type);
-
     fl_free(type);
 }
@@ -120,7 +120,8 @@ size_t zir_array_type_size(ZirArrayType *type, size_t ref_size);
 
 /*
  * Function: zir_array_type_free
- *  Frees the memory of the array type object
+ *  Frees the memory of the array type object. The member type is not freed, it is owned
+ *  by the <ZirTypeContext>
  *
  * Parameters:
  *  <ZirArrayType> *type: Type object
@@ -0,0 +1,184 @@
+#include "context.h"
+
+ZirTypeContext* zir_type_ctx_new(void)
+{
+    ZirTypeContext *type_ctx = fl_malloc(sizeof(ZirTypeContext));
+
+    type_ctx->pool = fl_hashtable_new_args((struct FlHashtableArgs) {
+        .hash_function = fl_hashtable_hash_string,
+        .key_allocator = fl_container_allocator_string,
+        .key_comparer = fl_container_equals_string,
+        .key_cleaner = fl_container_cleaner_pointer,
+        .value_cleaner = (FlContainerCleanupFn) zir_type_free,
+        .value_allocator = NULL
+    });
+
+    type_ctx->composites = fl_list_new_args((struct FlListArgs) {
+        .value_cleaner = (FlContainerCleanupFn) zir_type_free
+    });
+
+    return type_ctx;
+}
+
+ZirUintType* zir_type_ctx_new_uint(ZirTypeContext *type_ctx, ZirUintTypeSize size)
+{
+    const char *key = NULL;
+
+    switch (size)
+    {
+        case ZIR_UINT_8:
+            key = "uint8";
+            break;
+
+        case ZIR_UINT_16:
+            key = "uint16";
+            break;
+
+        default:
+            key = "uint";
+            break;
+    }
+
+    ZirUintType *uint_type = NULL;
+
+    if (fl_hashtable_has_key(type_ctx->pool, key))
+    {
+        uint_type = fl_hashtable_get(type_ctx->pool, key);
+    }
+    else
+    {
+        // First time
+        uint_type = zir_uint_type_new(size);
+        fl_hashtable_add(type_ctx->pool, key, uint_type);
+    }
+
+    return uint_type;
+}
+
+ZirBoolType* zir_type_ctx_new_bool(ZirTypeContext *type_ctx)
+{
+    ZirBoolType *bool_type = NULL;
+
+    if (fl_hashtable_has_key(type_ctx->pool, "bool"))
+    {
+        bool_type = fl_hashtable_get(type_ctx->pool, "bool");
+    }
+    else
+    {
+        // First time
+        bool_type = zir_bool_type_new();
+        fl_hashtable_add(type_ctx->pool, "bool", bool_type);
+    }
+
+    return bool_type;
+}
+
+ZirType* zir_type_ctx_new_none(ZirTypeContext *type_ctx)
+{
+    ZirType *none_type = NULL;
+
+    if (fl_hashtable_has_key(type_ctx->pool, "none"))
+    {
+        none_type = fl_hashtable_get(type_ctx->pool, "none");
+    }
+    else
+    {
+        // First time
+        none_type = zir_none_type_new();
+        fl_hashtable_add(type_ctx->pool, "none", none_type);
+    }
+
+    return none_type;
+}
+
+ZirArrayType* zir_type_ctx_new_array(ZirTypeContext *type_ctx, ZirType *member_type, size_t length)
+{
+    // The member types are interned too, so they can be compared by address
+    struct FlListNode *node = fl_list_head(type_ctx->composites);
+    while (node)
+    {
+        ZirArrayType *array_type = (ZirArrayType*) node->value;
+
+        if (array_type->base.typekind == ZIR_TYPE_ARRAY && array_type->member_type == member_type && array_type->length == length)
+            return array_type;
+
+        node = node->next;
+    }
+
+    ZirArrayType *array_type = zir_array_type_new(member_type);
+    array_type->length = length;
+
+    fl_list_append(type_ctx->composites, array_type);
+
+    return array_type;
+}
+
+ZirReferenceType* zir_type_ctx_new_reference(ZirTypeContext *type_ctx, ZirType *element)
+{
+    struct FlListNode *node = fl_list_head(type_ctx->composites);
+    while (node)
+    {
+        ZirReferenceType *ref_type = (ZirReferenceType*) node->value;
+
+        if (ref_type->base.typekind == ZIR_TYPE_REFERENCE && ref_type->element == element)
+            return ref_type;
+
+        node = node->next;
+    }
+
+    ZirReferenceType *ref_type = zir_reference_type_new(element);
+
+    fl_list_append(type_ctx->composites, ref_type);
+
+    return ref_type;
+}
+
+ZirStructType* zir_type_ctx_get_named_struct(ZirTypeContext *type_ctx, const char *name)
+{
+    if (fl_hashtable_has_key(type_ctx->pool, name))
+        return fl_hashtable_get(type_ctx->pool, name);
+
+    return NULL;
+}
+
+ZirStructType* zir_type_ctx_intern_struct(ZirTypeContext *type_ctx, ZirStructType *struct_type)
+{
+    if (struct_type->name != NULL)
+    {
+        ZirStructType *named_struct = zir_type_ctx_get_named_struct(type_ctx, struct_type->name);
+
+        if (named_struct != NULL)
+        {
+            zir_struct_type_free(struct_type);
+            return named_struct;
+        }
+
+        fl_hashtable_add(type_ctx->pool, struct_type->name, struct_type);
+        return struct_type;
+    }
+
+    struct FlListNode *node = fl_list_head(type_ctx->composites);
+    while (node)
+    {
+        ZirType *type = (ZirType*) node->value;
+
+        if (type->typekind == ZIR_TYPE_STRUCT && zir_struct_type_equals((ZirStructType*) type, (ZirType*) struct_type))
+        {
+            zir_struct_type_free(struct_type);
+            return (ZirStructType*) type;
+        }
+
+        node = node->next;
+    }
+
+    fl_list_append(type_ctx->composites, struct_type);
+
+    return struct_type;
+}
+
+void zir_type_ctx_free(ZirTypeContext *type_ctx)
+{
+    fl_list_free(type_ctx->composites);
+    fl_hashtable_free(type_ctx->pool);
+    fl_free(type_ctx);
+}
@@ -0,0 +1,171 @@
+#ifndef ZIR_TYPE_CONTEXT_H
+#define ZIR_TYPE_CONTEXT_H
+
+#include <fllib/containers/List.h>
+#include <fllib/containers/Hashtable.h>
+#include "system.h"
+
+typedef FlHashtable ZirStringToTypeMap;
+typedef FlList ZirTypeList;
+
+/*
+ * Struct: ZirTypeContext
+ *  Owns the types of a ZIR program. The primitive types are singletons and the composite types are
+ *  interned structurally, which means two types created through the context are equals if and only if
+ *  they are the same object.
+ *
+ * Members:
+ *  <ZirStringToTypeMap> *pool: The primitive types and the named structs, indexed by name
+ *  <ZirTypeList> *composites: The interned array, reference and unnamed struct types
+ */
+typedef struct ZirTypeContext {
+    ZirStringToTypeMap *pool;
+    ZirTypeList *composites;
+} ZirTypeContext;
+
+/*
+ * Function: zir_type_ctx_new
+ *  Creates a new type context
+ *
+ * Parameters:
+ *  This function does not take parameters
+ *
+ * Returns:
+ *  ZirTypeContext*: The type context object
+ *
+ * Notes:
+ *  The object returned by this function must be freed using the
+ *  <zir_type_ctx_free> function
+ */
+ZirTypeContext* zir_type_ctx_new(void);
+
+/*
+ * Function: zir_type_ctx_new_uint
+ *  Returns the uint type of the given size
+ *
+ * Parameters:
+ *  <ZirTypeContext> *type_ctx: The type context object
+ *  <ZirUintTypeSize> size: The size of the uint type
+ *
+ * Returns:
+ *  ZirUintType*: The uint type object
+ *
+ * Notes:
+ *  The <ZirTypeContext> object owns the type, which means that the caller must not free it.
+ */
+ZirUintType* zir_type_ctx_new_uint(ZirTypeContext *type_ctx, ZirUintTypeSize size);
+
+/*
+ * Function: zir_type_ctx_new_bool
+ *  Returns the boolean type
+ *
+ * Parameters:
+ *  <ZirTypeContext> *type_ctx: The type context object
+ *
+ * Returns:
+ *  ZirBoolType*: The boolean type object
+ *
+ * Notes:
+ *  The <ZirTypeContext> object owns the type, which means that the caller must not free it.
+ */
+ZirBoolType* zir_type_ctx_new_bool(ZirTypeContext *type_ctx);
+
+/*
+ * Function: zir_type_ctx_new_none
+ *  Returns the none type
+ *
+ * Parameters:
+ *  <ZirTypeContext> *type_ctx: The type context object
+ *
+ * Returns:
+ *  ZirType*: The none type object
+ *
+ * Notes:
+ *  The <ZirTypeContext> object owns the type, which means that the caller must not free it.
+ */
+ZirType* zir_type_ctx_new_none(ZirTypeContext *type_ctx);
+
+/*
+ * Function: zir_type_ctx_new_array
+ *  Returns the array type with the given member type and length, creating it the first time it is
+ *  requested
+ *
+ * Parameters:
+ *  <ZirTypeContext> *type_ctx: The type context object
+ *  <ZirType> *member_type: The type of the array's members, it must be owned by the context
+ *  <size_t> length: The number of elements of the array
+ *
+ * Returns:
+ *  ZirArrayType*: The array type object
+ *
+ * Notes:
+ *  The <ZirTypeContext> object owns the type, which means that the caller must not free it nor
+ *  modify it.
+ */
+ZirArrayType* zir_type_ctx_new_array(ZirTypeContext *type_ctx, ZirType *member_type, size_t length);
+
+/*
+ * Function: zir_type_ctx_new_reference
+ *  Returns the reference type to the given element type, creating it the first time it is requested
+ *
+ * Parameters:
+ *  <ZirTypeContext> *type_ctx: The type context object
+ *  <ZirType> *element: Type of the referenced symbol, it must be owned by the context
+ *
+ * Returns:
+ *  ZirReferenceType*: The reference type object
+ *
+ * Notes:
+ *  The <ZirTypeContext> object owns the type, which means that the caller must not free it nor
+ *  modify it.
+ */
+ZirReferenceType* zir_type_ctx_new_reference(ZirTypeContext *type_ctx, ZirType *element);
+
+/*
+ * Function: zir_type_ctx_get_named_struct
+ *  Returns a named struct that must be already present in the type context
+ *
+ * Parameters:
+ *  <ZirTypeContext> *type_ctx: The type context object
+ *  <const char> *name: A valid string for the name of the struct type. It cannot be <NULL>
+ *
+ * Returns:
+ *  ZirStructType*: The named struct type or NULL if it doesn't exist
+ */
+ZirStructType* zir_type_ctx_get_named_struct(ZirTypeContext *type_ctx, const char *name);
+
+/*
+ * Function: zir_type_ctx_intern_struct
+ *  Interns a struct type created with <zir_struct_type_new> once all its members have been added. If the
+ *  context already contains an equal struct type (same name, or same members for unnamed structs) the
+ *  provided object is freed and the existing one is returned.
+ *
+ * Parameters:
+ *  <ZirTypeContext> *type_ctx: The type context object
+ *  <ZirStructType> *struct_type: The struct type to intern. The members' types must be owned by the context
+ *
+ * Returns:
+ *  ZirStructType*: The interned struct type object
+ *
+ * Notes:
+ *  The <ZirTypeContext> object takes ownership of *struct_type*, which means that the caller must not use
+ *  it after this call, but the returned object.
+ */
+ZirStructType* zir_type_ctx_intern_struct(ZirTypeContext *type_ctx, ZirStructType *struct_type);
+
+/*
+ * Function: zir_type_ctx_free
+ *  Frees the memory used by the type context object, including all the types owned by the context.
+ *
+ * Parameters:
+ *  <ZirTypeContext> *type_ctx: The type context object
+ *
+ * Returns:
+ *  void: This function does not return a value
+ *
+ * Notes:
+ *  The types created by this context cannot be used once the context is freed.
+ */
+void zir_type_ctx_free(ZirTypeContext *type_ctx);
+
+#endif /* ZIR_TYPE_CONTEXT_H */
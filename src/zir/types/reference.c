@@ -122,8 +122,5 @@ void zir_reference_type_free(ZirReferenceType *type)
     if (type->base.to_string.value != NULL)
         fl_cstring_free(type->base.to_string.value);
 
-    if (type->element)
-        zir_type_free(type->element);
-
     fl_free(type);
 }
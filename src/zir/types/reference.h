@@ -117,7 +117,8 @@ bool zir_reference_type_is_castable_to(ZirReferenceType *ref_type, ZirType *targ
 
 /*
  * Function: zir_reference_type_free
- *  Frees the memory of the reference type object
+ *  Frees the memory of the reference type object. The element type is not freed, it is owned
+ *  by the <ZirTypeContext>
  *
  * Parameters:
  *  <ZirReferenceType> *type: Type object
@@ -13,8 +13,6 @@ static void member_free(void *ptr)
     if (member->name)
         fl_cstring_free(member->name);
 
-    zir_type_free(member->type);
-
     fl_free(member);
 }
 
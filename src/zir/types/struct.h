@@ -176,7 +176,8 @@ size_t zir_struct_type_size(ZirStructType *type, size_t ref_size);
 
 /*
  * Function: zir_struct_type_free
- *  Frees the memory of the struct type object
+ *  Frees the memory of the struct type object. The members' types are not freed, they are
+ *  owned by the <ZirTypeContext>
  *
  * Parameters:
  *  <ZirStructType> *type: Type object
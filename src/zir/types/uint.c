@@ -3,7 +3,7 @@
 #include <fllib/Cstring.h>
 #include "uint.h"
 
-static struct TypeMapping {
+static const struct TypeMapping {
     char *string;
     ZirUintTypeSize size;
 } type_mappings[] = {
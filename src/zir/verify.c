@@ -0,0 +1,193 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <fllib/Mem.h>
+#include <fllib/Array.h>
+#include <fllib/Cstring.h>
+#include <fllib/containers/Hashtable.h>
+#include "verify.h"
+#include "instructions/operands/symbol.h"
+
+typedef struct VerifyContext {
+    FlHashtable *versions;
+    char **message;
+} VerifyContext;
+
+static bool report(VerifyContext *ctx, const char *format, ...)
+{
+    if (ctx->message == NULL || *ctx->message != NULL)
+        return false;
+
+    char buffer[256];
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    *ctx->message = fl_cstring_dup(buffer);
+
+    return false;
+}
+
+static bool contains(ZirBasicBlock **blocks, ZirBasicBlock *block)
+{
+    for (size_t i=0; i < fl_array_length(blocks); i++)
+        if (blocks[i] == block)
+            return true;
+
+    return false;
+}
+
+static bool verify_definition(VerifyContext *ctx, ZirBasicBlock *block, ZirInstr *instruction)
+{
+    ZirOperand *destination = instruction->destination;
+
+    if (destination == NULL || destination->type != ZIR_OPERAND_SYMBOL)
+        return true;
+
+    ZirSymbolOperand *operand = (ZirSymbolOperand*) destination;
+
+    if (operand->version == 0)
+        return true;
+
+    char *key = fl_cstring_vdup("%s.%u", operand->symbol->name, operand->version);
+    bool defined = fl_hashtable_has_key(ctx->versions, key);
+
+    if (!defined)
+        fl_hashtable_add(ctx->versions, key, operand);
+
+    fl_cstring_free(key);
+
+    if (defined)
+        return report(ctx, "L%zu: @%s.%u is defined more than once", block->index, operand->symbol->name, operand->version);
+
+    return true;
+}
+
+static bool verify_phi(VerifyContext *ctx, ZirBasicBlock *block, ZirPhiInstr *phi)
+{
+    size_t source_count = fl_array_length(phi->sources);
+
+    if (source_count != fl_array_length(block->predecessors))
+        return report(ctx, "L%zu: phi instruction has %zu sources but the block has %zu predecessors",
+                        block->index, source_count, fl_array_length(block->predecessors));
+
+    for (size_t i=0; i < source_count; i++)
+    {
+        if (!contains(block->predecessors, phi->blocks[i]))
+            return report(ctx, "L%zu: phi instruction source comes from L%zu, which is not a predecessor", block->index, phi->blocks[i]->index);
+    }
+
+    return true;
+}
+
+static bool verify_cfg(VerifyContext *ctx, ZirCfg *cfg)
+{
+    size_t length = fl_array_length(cfg->blocks);
+
+    for (size_t i=0; i < length; i++)
+    {
+        ZirBasicBlock *block = cfg->blocks[i];
+
+        if (block->index != i)
+            return report(ctx, "L%zu: block is placed at position %zu", block->index, i);
+
+        ZirBasicBlock *target = zir_cfg_terminator_target(block->terminator);
+
+        if (block->terminator != NULL && target == NULL)
+            return report(ctx, "L%zu: terminator does not have a target", i);
+
+        if (target != NULL)
+        {
+            if (target->index >= length || cfg->blocks[target->index] != target)
+                return report(ctx, "L%zu: terminator targets a block that is not in the CFG", i);
+
+            // The NES back end only supports forward branches
+            if (target->index <= i)
+                return report(ctx, "L%zu: terminator targets L%zu, which is not placed after the block", i, target->index);
+
+            if (!contains(block->successors, target))
+                return report(ctx, "L%zu: L%zu is not a successor of the block", i, target->index);
+        }
+
+        bool falls_through = block->terminator == NULL || block->terminator->type == ZIR_INSTR_IF_FALSE;
+
+        if (falls_through && i + 1 < length && !contains(block->successors, cfg->blocks[i + 1]))
+            return report(ctx, "L%zu: L%zu is not a successor of the block", i, i + 1);
+
+        for (size_t j=0; j < fl_array_length(block->successors); j++)
+        {
+            if (!contains(block->successors[j]->predecessors, block))
+                return report(ctx, "L%zu: block is not a predecessor of its successor L%zu", i, block->successors[j]->index);
+        }
+
+        for (size_t j=0; j < fl_array_length(block->predecessors); j++)
+        {
+            if (!contains(block->predecessors[j]->successors, block))
+                return report(ctx, "L%zu: block is not a successor of its predecessor L%zu", i, block->predecessors[j]->index);
+        }
+
+        bool in_phis = true;
+        for (size_t j=0; j < fl_array_length(block->instructions); j++)
+        {
+            ZirInstr *instruction = block->instructions[j];
+
+            if (instruction->type == ZIR_INSTR_IF_FALSE || instruction->type == ZIR_INSTR_JUMP)
+                return report(ctx, "L%zu: terminator placed in the middle of the block", i);
+
+            if (instruction->type == ZIR_INSTR_PHI)
+            {
+                if (!in_phis)
+                    return report(ctx, "L%zu: phi instruction placed after a non-phi instruction", i);
+
+                if (!verify_phi(ctx, block, (ZirPhiInstr*) instruction))
+                    return false;
+            }
+            else
+            {
+                in_phis = false;
+            }
+
+            if (!verify_definition(ctx, block, instruction))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+static bool verify_block_tree(VerifyContext *ctx, ZirBlock *block)
+{
+    if (!verify_cfg(ctx, &block->cfg))
+        return false;
+
+    for (size_t i=0; i < fl_array_length(block->children); i++)
+        if (!verify_block_tree(ctx, block->children[i]))
+            return false;
+
+    return true;
+}
+
+bool zir_program_verify(ZirProgram *program, char **message)
+{
+    if (message != NULL)
+        *message = NULL;
+
+    VerifyContext ctx = {
+        .versions = fl_hashtable_new_args((struct FlHashtableArgs) {
+            .hash_function = fl_hashtable_hash_string,
+            .key_allocator = fl_container_allocator_string,
+            .key_comparer = fl_container_equals_string,
+            .key_cleaner = fl_container_cleaner_pointer,
+            .value_cleaner = NULL,
+            .value_allocator = NULL
+        }),
+        .message = message
+    };
+
+    bool valid = verify_block_tree(&ctx, program->global);
+
+    fl_hashtable_free(ctx.versions);
+
+    return valid;
+}
@@ -0,0 +1,27 @@
+#ifndef ZIR_VERIFY_H
+#define ZIR_VERIFY_H
+
+#include <stdbool.h>
+#include "program.h"
+
+/*
+ * Function: zir_program_verify
+ *  Checks the structural invariants of the CFG of every block in the program:
+ *      - The index of each basic block matches its position in the layout
+ *      - The terminators target blocks that are in the layout, and only forward
+ *      - The successors and predecessors of the blocks match each other
+ *      - The phi instructions are placed at the beginning of the blocks, and they have one source per
+ *        predecessor
+ *      - Each version of a symbol (@a.1, @a.2, ...) is defined once
+ *
+ * Parameters:
+ *  <ZirProgram> *program: The ZIR program
+ *  <char> **message: If it is not NULL and the program is not valid, it receives a description of the
+ *                    first error found. It must be freed using <fl_cstring_free>
+ *
+ * Returns:
+ *  bool: *true* if the program is valid, otherwise *false*
+ */
+bool zir_program_verify(ZirProgram *program, char **message);
+
+#endif /* ZIR_VERIFY_H */
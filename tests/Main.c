@@ -14,6 +14,7 @@
 #include "front-end/symtable/tests.h"
 #include "zir/tests.h"
 #include "back-end/nes/tests.h"
+#include "driver/tests.h"
 
 int main(int argc, char **argv) 
 {
@@ -36,15 +37,18 @@ int main(int argc, char **argv)
             { "Variable decl. with type",               &zenit_test_parser_variable_literal_type        },
             { "Array Variable decl. with type",         &zenit_test_parser_array_variable_literal_type  },
             { "Variable decl. errors",                  &zenit_test_parser_variable_errors              },
+            { "Error reporting",                        &zenit_test_parser_error_reporting              },
             { "Reference variables declarations",       &zenit_test_parser_variable_ref                 },
             { "Reference variables decl. with type",    &zenit_test_parser_variable_ref                 },
             { "Integer literals",                       &zenit_test_parser_literal_integer              },
             { "Integer literal errors",                 &zenit_test_parser_literal_integer_error        },
             { "Boolean literals",                       &zenit_test_parser_literal_boolean              },
             { "Array initializers",                     &zenit_test_parser_literal_array_literal        },
+            { "Included binary files",                  &zenit_test_parser_literal_incbin               },
             { "Variable attributes",                    &zenit_test_parser_attributes_variables         },
             { "Struct definition",                      &zenit_test_parser_struct_decl                  },
             { "Struct variables",                       &zenit_test_parser_variable_struct              },
+            { "External variables",                     &zenit_test_parser_variable_extern              },
             { "Parse blocks",                           &zenit_test_parser_blocks                       },
             { "Parse if statements",                    &zenit_test_parser_if_statements                },
         ),
@@ -82,9 +86,20 @@ int main(int argc, char **argv)
             { "Generate ZIR variables",         &zenit_test_generate_ir_variables       },
             { "Generate ZIR variable clash",    &zenit_test_generate_ir_variables_clash },
             { "Generate ZIR casts",             &zenit_test_generate_ir_casts           },
+            { "Forward ZIR temporaries",        &zenit_test_forward_ir_temporaries      },
             { "Generate ZIR struct decl",       &zenit_test_generate_ir_struct_decl     },
             { "Generate ZIR struct",            &zenit_test_generate_ir_struct          },
             { "Generate ZIR if",                &zenit_test_generate_ir_if              },
+            { "Fold ZIR constant if",           &zenit_test_fold_ir_if                  },
+            { "Generate ZIR if CFG",            &zenit_test_generate_ir_if_cfg          },
+            { "ZIR SSA construction",           &zenit_test_ssa_construct               },
+            { "ZIR SSA destruction copies",     &zenit_test_ssa_destruct_copies         },
+            { "ZIR SSA destruction swap",       &zenit_test_ssa_destruct_swap           },
+            { "ZIR pass manager",               &zenit_test_zir_pass_manager            },
+            { "Eliminate ZIR dead globals",     &zenit_test_eliminate_dead_globals      },
+            { "ZIR type interning",             &zenit_test_zir_type_interning          },
+            { "ZIR slab arenas",                &zenit_test_zir_slab                    },
+            { "ZIR linker",                     &zenit_test_zir_link                    },
         ),
         flut_suite("nes",
             { "NES global variables",               &zenit_test_nes_global_vars             },
@@ -92,11 +107,40 @@ int main(int argc, char **argv)
             { "NES global variables (ZP)",          &zenit_test_nes_global_vars_zp          },
             { "NES global variables (DATA)",        &zenit_test_nes_global_vars_data        },
             { "NES global variables (CODE)",        &zenit_test_nes_global_vars_code        },
+            { "NES global variables (CODE tables)", &zenit_test_nes_global_vars_code_tables },
+            { "NES global variables (BSS)",         &zenit_test_nes_global_vars_bss         },
             { "NES global variables name clash",    &zenit_test_nes_global_var_name_clash   },
             { "Cast operations",                    &zenit_test_nes_cast                    },
+            { "Temporary slots reuse",              &zenit_test_nes_temp_slots              },
+            { "Temporary slots overlap",            &zenit_test_nes_temp_slots_overlap      },
+            { "Temporary slots of references",      &zenit_test_nes_temp_slots_reference    },
             { "Conditionals",                       &zenit_test_nes_conditionals            },
+            { "Conditionals (long branch)",         &zenit_test_nes_conditionals_long_branch },
+            { "Branch relaxation",                  &zenit_test_nes_branch_relaxation       },
+            { "Register state tracking",            &zenit_test_nes_register_tracking       },
+            { "Peephole optimizer",                 &zenit_test_nes_peephole                },
             { "Compile NES program",                &zenit_test_nes_program                 },
             { "Compile NES ROM",                    &zenit_test_nes_rom                     },
+            { "PRG free ranges map",                &zenit_test_nes_prg_map                 },
+            { "Compile NES ROM (best fit)",         &zenit_test_nes_rom_best_fit            },
+            { "Compile NES ROM (CODE segment)",     &zenit_test_nes_rom_code                },
+            { "Compile NES ROM (vectors)",          &zenit_test_nes_rom_vectors             },
+            { "Compile NES ROM (PRG layout)",       &zenit_test_nes_rom_layout              },
+            { "Compile NES ROM (mapper banks)",     &zenit_test_nes_rom_banks               },
+            { "Compile NES ROM (CHR-ROM)",          &zenit_test_nes_rom_chr                 },
+            { "Compile NES ROM (incbin)",           &zenit_test_nes_rom_incbin              },
+            { "Compile NES ROM (errors)",           &zenit_test_nes_rom_errors              },
+            { "Simulate NES ROM",                   &zenit_test_nes_simulate_rom            },
+            { "Simulator cycle counting",           &zenit_test_nes_simulate_cycles         },
+            { "Simulate initialization loops",      &zenit_test_nes_simulate_init_loops     },
+            { "Static cost model",                  &zenit_test_nes_cost                    },
+            { "Static cost model (loops)",          &zenit_test_nes_cost_loops              },
+        ),
+        flut_suite("Driver",
+            { "Rebuild changed units",          &zenit_test_driver_rebuild              },
+            { "Compile in-memory units",        &zenit_test_driver_in_memory            },
+            { "RAM cleared on reset",           &zenit_test_driver_reset_clears_ram     },
+            { "Compile in parallel threads",    &zenit_test_driver_parallel             },
         ),
         NULL
     );
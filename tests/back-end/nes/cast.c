@@ -7,6 +7,7 @@
 #include "../../../src/front-end/binding/resolve.h"
 #include "../../../src/front-end/symtable.h"
 #include "../../../src/front-end/codegen/zir.h"
+#include "../../../src/zir/passes/forward-temps.h"
 #include "../../../src/back-end/nes/rp2a03/generate.h"
 #include "../../../src/back-end/nes/ir/generate.h"
 #include "tests.h"
@@ -33,11 +34,12 @@ void zenit_test_nes_cast(void)
     flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
     
     ZirProgram *zir_program = zenit_generate_zir(&ctx);
+    zir_forward_temporaries(zir_program);
 
     ZnesContext *znes_context = znes_context_new(false);
     flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
 
-    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program);
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
     
     
     flut_expect_compat("Data segment at 0x00 should be 0xFF (a[0] lo)",  rp2a03_program->data->bytes[0x00] == 0xFF);
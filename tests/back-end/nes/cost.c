@@ -0,0 +1,187 @@
+#include <stdio.h>
+
+#include <flut/flut.h>
+#include "../../../src/front-end/type-check/check.h"
+#include "../../../src/front-end/inference/infer.h"
+#include "../../../src/front-end/parser/parse.h"
+#include "../../../src/front-end/binding/resolve.h"
+#include "../../../src/front-end/symtable.h"
+#include "../../../src/front-end/codegen/zir.h"
+#include "../../../src/back-end/nes/ir/generate.h"
+#include "../../../src/back-end/nes/rp2a03/generate.h"
+#include "../../../src/back-end/nes/rp2a03/rom.h"
+#include "../../../src/back-end/nes/rp2a03/cost.h"
+#include "simulator.h"
+#include "tests.h"
+
+void zenit_test_nes_cost(void)
+{
+    const char *zenit_source =
+        "#[NES(address: 0x00)]"                         "\n"
+        "var a = 3;"                                    "\n"
+        "var b = true;"                                 "\n"
+        "if (b) {"                                      "\n"
+        "   #[NES(address: 0x01)] var c = 8;"           "\n"
+        "} else {"                                      "\n"
+        "   #[NES(address: 0x01)] var c = 5;"           "\n"
+        "}"                                             "\n"
+    ;
+
+    const char *cost_report =
+        "segment  declaration          location     addr   instrs  bytes   best  worst"    "\n"
+        // LDA #$03, STA $00
+        "STARTUP  a                    2:1          $8001      2      4      5      5"    "\n"
+        // LDA $8000, BEQ (the taken branch does not cross a page), JMP
+        "STARTUP  if                   4:1          $8005      3      8      9     10"    "\n"
+        // LDA #$08, STA $01
+        "STARTUP  c                    5:26         $800A      2      4      5      5"    "\n"
+        // LDA #$05, STA $01
+        "STARTUP  c                    7:26         $8011      2      4      5      5"    "\n"
+        // The JMP to the CODE segment added by the linker
+        "STARTUP  (compiler)           -            $8015      1      3      3      3"    "\n"
+        "total    STARTUP                                     10     23     27     28"    "\n"
+        "total    CODE                                         0      0      0      0"    "\n"
+        "total                                                10     23     27     28"    "\n"
+    ;
+
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+
+    ZirProgram *zir_program = zenit_generate_zir(&ctx);
+
+    ZnesContext *znes_context = znes_context_new(false);
+    flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
+
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
+
+    flut_expect_compat("RP2A03 program must be valid", rp2a03_program != NULL);
+
+    Rp2a03CostEntry *entries = rp2a03_cost_analyze(rp2a03_program);
+
+    flut_expect_compat("Cost model must contain an entry for each declaration", fl_array_length(entries) == 5);
+    flut_expect_compat("Both declarations of c must have their own entry", entries[2].origin != entries[3].origin
+        && flm_cstring_equals(rp2a03_program->origins[entries[2].origin].declaration, "c")
+        && flm_cstring_equals(rp2a03_program->origins[entries[3].origin].declaration, "c"));
+    flut_expect_compat("Declarations from a string source must not have a file name", rp2a03_program->origins[entries[0].origin].filename == NULL);
+
+    char *report = rp2a03_cost_report(rp2a03_program, entries, fl_cstring_new(0));
+    flut_expect_compat("Cost report must attribute the code to the declarations", flm_cstring_equals(report, cost_report));
+    fl_cstring_free(report);
+
+    report = rp2a03_cost_report_json(rp2a03_program, entries, fl_cstring_new(0));
+    flut_expect_compat("JSON cost report must contain the declarations", strstr(report,
+        "{ \"segment\": \"STARTUP\", \"declaration\": \"c\", \"file\": null, \"line\": 7, \"col\": 26, \"address\": 32785, "
+        "\"instructions\": 2, \"bytes\": 4, \"best_cycles\": 5, \"worst_cycles\": 5 }") != NULL);
+    flut_expect_compat("JSON cost report must contain the totals", strstr(report,
+        "\"total\": { \"instructions\": 10, \"bytes\": 23, \"best_cycles\": 27, \"worst_cycles\": 28 }") != NULL);
+    fl_cstring_free(report);
+
+    // The program runs the "then" branch: the static cost of the path is the sum of the entries without the "else" branch,
+    // and the simulator does not execute the final JMP (the program loops forever)
+    Rp2a03Rom *nes_rom = rp2a03_rom_new(rp2a03_program);
+    Rp2a03Simulator sim;
+    rp2a03_simulator_init(&sim, nes_rom);
+    rp2a03_simulator_run(&sim, 1000);
+
+    flut_expect_compat("Simulated cycles must match the static cost of the executed path",
+        sim.cycles == entries[0].cost.best_cycles + entries[1].cost.best_cycles + entries[2].cost.best_cycles);
+
+    rp2a03_rom_free(nes_rom);
+    fl_array_free(entries);
+    rp2a03_program_free(rp2a03_program);
+    znes_context_free(znes_context);
+    zir_program_free(zir_program);
+    zenit_context_free(&ctx);
+}
+
+void zenit_test_nes_cost_loops(void)
+{
+    // The table is copied with a loop (see emit_copy_loops), and the array of zeros is cleared with
+    // the BSS loop, attributed to the compiler
+    char *zenit_source = fl_cstring_dup("#[NES(address: 0x300)]\nvar table = [");
+
+    for (size_t i=0; i < 64; i++)
+        fl_cstring_vappend(&zenit_source, "%s%zu", i > 0 ? ", " : " ", (i * 7 + 3) % 256);
+
+    fl_cstring_append(&zenit_source, " ];\n#[NES(address: 0x500)]\nvar zeros : [200]uint8 = [");
+
+    for (size_t i=0; i < 200; i++)
+        fl_cstring_append(&zenit_source, i > 0 ? ", 0" : " 0");
+
+    fl_cstring_append(&zenit_source, " ];\n");
+
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+
+    ZirProgram *zir_program = zenit_generate_zir(&ctx);
+
+    ZnesContext *znes_context = znes_context_new(false);
+    flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
+
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
+
+    flut_expect_compat("RP2A03 program must be valid", rp2a03_program != NULL);
+
+    Rp2a03CostEntry *entries = rp2a03_cost_analyze(rp2a03_program);
+    Rp2a03CostEntry *table = NULL;
+
+    for (size_t i=0; i < fl_array_length(entries); i++)
+        if (entries[i].origin != 0 && flm_cstring_equals(rp2a03_program->origins[entries[i].origin].declaration, "table"))
+            table = entries + i;
+
+    flut_expect_compat("Cost model must contain an entry for the table", table != NULL);
+
+    // LDX #64, then 64 times LDA abs,X (4) STA abs,X (5) DEX (2) BNE (3 when taken, 2 the last time)
+    flut_vexpect_compat(table->cost.best_cycles == 2 + 64 * 14 - 1,
+        "The copy loop of the table must cost its 64 iterations (expected %d cycles, got %zu)", 2 + 64 * 14 - 1, table->cost.best_cycles);
+    flut_expect_compat("The loops emitted by the compiler must be bounded", !rp2a03_cost_total(entries, NULL).unbounded);
+
+    // The simulator does not execute the final JMP of the STARTUP segment (the program loops forever). The indexed
+    // reads of the copy loop might cross a page, so the simulated cycles are between the best and the worst case
+    Rp2a03Rom *nes_rom = rp2a03_rom_new(rp2a03_program);
+    Rp2a03Simulator sim;
+    rp2a03_simulator_init(&sim, nes_rom);
+    rp2a03_simulator_run(&sim, 10000);
+
+    Rp2a03Cost startup = rp2a03_cost_total(entries, "STARTUP");
+    flut_vexpect_compat(sim.cycles >= startup.best_cycles - 3 && sim.cycles <= startup.worst_cycles - 3,
+        "Simulated cycles must be within the static cost of the loops (expected %zu to %zu cycles, got %zu)",
+        startup.best_cycles - 3, startup.worst_cycles - 3, (size_t) sim.cycles);
+    flut_expect_compat("Simulated cycles must include every iteration of the loops", sim.cycles > 200 * 10 + 64 * 14);
+
+    rp2a03_rom_free(nes_rom);
+    fl_array_free(entries);
+    rp2a03_program_free(rp2a03_program);
+    znes_context_free(znes_context);
+    zir_program_free(zir_program);
+    zenit_context_free(&ctx);
+    fl_cstring_free(zenit_source);
+
+    // A loop that is not counted with X has an unknown trip count
+    Rp2a03Program *program = rp2a03_program_new(0x8000, 0x0, 0x0);
+    rp2a03_program_emit_imm(program, program->code, NES_OP_LDY, 0x03);
+    rp2a03_program_emit_imp(program, program->code, NES_OP_DEY);
+    rp2a03_program_emit_rel(program, program->code, NES_OP_BNE, (uint8_t) -3);
+
+    entries = rp2a03_cost_analyze(program);
+    flut_expect_compat("A loop with an unknown trip count must make its entry unbounded", rp2a03_cost_total(entries, "CODE").unbounded);
+
+    char *report = rp2a03_cost_report(program, entries, fl_cstring_new(0));
+    flut_expect_compat("Cost report must show the unbounded worst case", strstr(report, "    inf\n") != NULL);
+    fl_cstring_free(report);
+
+    report = rp2a03_cost_report_json(program, entries, fl_cstring_new(0));
+    flut_expect_compat("JSON cost report must have a null worst case", strstr(report, "\"worst_cycles\": null") != NULL);
+    fl_cstring_free(report);
+
+    fl_array_free(entries);
+    rp2a03_program_free(program);
+}
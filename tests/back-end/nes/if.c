@@ -7,6 +7,7 @@
 #include "../../../src/front-end/binding/resolve.h"
 #include "../../../src/front-end/symtable.h"
 #include "../../../src/front-end/codegen/zir.h"
+#include "../../../src/zir/passes/forward-temps.h"
 #include "../../../src/back-end/nes/rp2a03/generate.h"
 #include "../../../src/back-end/nes/ir/generate.h"
 #include "tests.h"
@@ -51,38 +52,36 @@ void zenit_test_nes_conditionals(void)
         // The "true" value
         "8003:     LDA #$01"                                        "\n"
         // if_false true jump to the "else" branch
-        "8005:     BEQ $07"                                         "\n"
-        // then branch: var zp = 1
-        "8007:     LDA #$01"                                        "\n"
-        "8009:     STA $00"                                         "\n"
+        "8005:     BEQ $05"                                         "\n"
+        // then branch: var zp = 1 (A already contains 1)
+        "8007:     STA $00"                                         "\n"
         // then branch: jump out of the "then" branch skiping the "else"
-        "800B:     JMP $8032"                                       "\n"
+        "8009:     JMP $8010"                                       "\n"
         // else branch: var zp = 2
-        "800E:     LDA #$02"                                        "\n"
-        "8010:     STA $00"                                         "\n"
+        "800C:     LDA #$02"                                        "\n"
+        "800E:     STA $00"                                         "\n"
 
         // var b = true
-        "8012:     LDA #$01"                                        "\n"
-        "8014:     STA $8000"                                       "\n"
-        "8017:     LDA $8000"                                       "\n"
-        // if_false b jump to the "else" branch
-        "801A:     BEQ $08"                                         "\n"
+        "8010:     LDA #$01"                                        "\n"
+        "8012:     STA $8000"                                       "\n"
+        // if_false b jump to the "else" branch (A and the flags already contain b, the LDA is removed)
+        "8015:     BEQ $08"                                         "\n"
         // then branch: var data = 8
-        "801C:     LDA #$08"                                        "\n"
-        "801E:     STA $8001"                                       "\n"
+        "8017:     LDA #$08"                                        "\n"
+        "8019:     STA $8001"                                       "\n"
         // then branch: jump out of the "then" branch skiping the "else"
-        "8021:     JMP $8032"                                       "\n"
+        "801C:     JMP $8024"                                       "\n"
         // else branch: var data = 5
-        "8024:     LDA #$05"                                        "\n"
-        "8026:     STA $8001"                                       "\n"
+        "801F:     LDA #$05"                                        "\n"
+        "8021:     STA $8001"                                       "\n"
 
         // cast(true) value
-        "8029:     LDA #$01"                                        "\n"
+        "8024:     LDA #$01"                                        "\n"
         // if_false cast(true) skip the "if"
-        "802B:     BEQ $05"                                         "\n"
+        "8026:     BEQ $05"                                         "\n"
         // then branch: var data = 4
-        "802D:     LDA #$04"                                        "\n"
-        "802F:     STA $8002"                                       "\n"
+        "8028:     LDA #$04"                                        "\n"
+        "802A:     STA $8002"                                       "\n"
         ""                                                          "\n"
     ;
 
@@ -94,11 +93,12 @@ void zenit_test_nes_conditionals(void)
     flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
     
     ZirProgram *zir_program = zenit_generate_zir(&ctx);
+    zir_forward_temporaries(zir_program);
 
     ZnesContext *znes_context = znes_context_new(true);
     flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
 
-    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program);
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
 
     char *rp2a03_program_dump_str = rp2a03_program_disassemble(rp2a03_program);
     flut_expect_compat("Disassemble of RP2A03 program must be equals to the handcrafted source", flm_cstring_equals(rp2a03_program_dump_str, rp2a03_disassembly));
@@ -109,3 +109,258 @@ void zenit_test_nes_conditionals(void)
     zir_program_free(zir_program);
     zenit_context_free(&ctx);
 }
+
+void zenit_test_nes_conditionals_long_branch(void)
+{
+    const char *zenit_source = 
+        "var b = true;"                                         "\n"
+        "if (b) {"                                              "\n"
+        // 26 variables with different values: 130 bytes of code, the BEQ cannot reach the end of the "then" branch
+        "   #[NES(address: 0x300)] var v0 : uint8 = 1;"   "\n"
+        "   #[NES(address: 0x301)] var v1 : uint8 = 2;"   "\n"
+        "   #[NES(address: 0x302)] var v2 : uint8 = 3;"   "\n"
+        "   #[NES(address: 0x303)] var v3 : uint8 = 4;"   "\n"
+        "   #[NES(address: 0x304)] var v4 : uint8 = 5;"   "\n"
+        "   #[NES(address: 0x305)] var v5 : uint8 = 6;"   "\n"
+        "   #[NES(address: 0x306)] var v6 : uint8 = 7;"   "\n"
+        "   #[NES(address: 0x307)] var v7 : uint8 = 8;"   "\n"
+        "   #[NES(address: 0x308)] var v8 : uint8 = 9;"   "\n"
+        "   #[NES(address: 0x309)] var v9 : uint8 = 10;"   "\n"
+        "   #[NES(address: 0x30A)] var v10 : uint8 = 11;"   "\n"
+        "   #[NES(address: 0x30B)] var v11 : uint8 = 12;"   "\n"
+        "   #[NES(address: 0x30C)] var v12 : uint8 = 13;"   "\n"
+        "   #[NES(address: 0x30D)] var v13 : uint8 = 14;"   "\n"
+        "   #[NES(address: 0x30E)] var v14 : uint8 = 15;"   "\n"
+        "   #[NES(address: 0x30F)] var v15 : uint8 = 16;"   "\n"
+        "   #[NES(address: 0x310)] var v16 : uint8 = 17;"   "\n"
+        "   #[NES(address: 0x311)] var v17 : uint8 = 18;"   "\n"
+        "   #[NES(address: 0x312)] var v18 : uint8 = 19;"   "\n"
+        "   #[NES(address: 0x313)] var v19 : uint8 = 20;"   "\n"
+        "   #[NES(address: 0x314)] var v20 : uint8 = 21;"   "\n"
+        "   #[NES(address: 0x315)] var v21 : uint8 = 22;"   "\n"
+        "   #[NES(address: 0x316)] var v22 : uint8 = 23;"   "\n"
+        "   #[NES(address: 0x317)] var v23 : uint8 = 24;"   "\n"
+        "   #[NES(address: 0x318)] var v24 : uint8 = 25;"   "\n"
+        "   #[NES(address: 0x319)] var v25 : uint8 = 26;"   "\n"
+        "}"                                                     "\n"
+    ;
+
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+    
+    ZirProgram *zir_program = zenit_generate_zir(&ctx);
+
+    ZnesContext *znes_context = znes_context_new(true);
+    flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
+
+    // The test checks the relaxation of the emitted code
+    znes_context->program->peephole_rules = 0;
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
+    Rp2a03TextSegment *code = rp2a03_program->code;
+
+    // var b = true; LDA b
+    flut_expect_compat("CODE segment at 0x05 should be 0xAD (LDA)",          code->bytes[0x05] == 0xAD);
+    // BEQ is relaxed into BNE +3; JMP end
+    flut_expect_compat("CODE segment at 0x08 should be 0xD0 (BNE)",          code->bytes[0x08] == 0xD0);
+    flut_expect_compat("CODE segment at 0x09 should be 0x03 (+3)",           code->bytes[0x09] == 0x03);
+    flut_expect_compat("CODE segment at 0x0A should be 0x4C (JMP)",          code->bytes[0x0A] == 0x4C);
+    flut_expect_compat("CODE segment at 0x0B should be 0x90 ($8090 lo)",     code->bytes[0x0B] == 0x90);
+    flut_expect_compat("CODE segment at 0x0C should be 0x80 ($8090 hi)",     code->bytes[0x0C] == 0x80);
+    flut_expect_compat("CODE segment at 0x0D should be 0xA9 (LDA)",          code->bytes[0x0D] == 0xA9);
+    flut_expect_compat("CODE segment must be 143 bytes long",                code->pc == 0x8F);
+    flut_expect_compat("CODE segment must start at $8001",                   code->base_address == 0x8001);
+
+    rp2a03_program_free(rp2a03_program);
+    znes_context_free(znes_context);
+    zir_program_free(zir_program);
+    zenit_context_free(&ctx);
+}
+
+static void emit_nops(Rp2a03Program *program, Rp2a03TextSegment *segment, size_t count)
+{
+    for (size_t i=0; i < count; i++)
+        rp2a03_program_emit_imp(program, segment, NES_OP_NOP);
+}
+
+void zenit_test_nes_branch_relaxation(void)
+{
+    Rp2a03Program *program = rp2a03_program_new(0x8000, 0x0, 0x0);
+    Rp2a03TextSegment *code = program->code;
+
+    // A: BEQ that skips 3 "IR instructions"
+    rp2a03_program_emit_rel(program, code, NES_OP_BEQ, 0);
+    rp2a03_text_segment_add_pending_jump(code, &(Rp2a03PendingJump) { .base_jump_pc = code->pc, .byte_index = code->pc - 1, .ir_offset = 3, .absolute = false });
+    rp2a03_text_segment_backpatch_jumps(code);
+
+    // B: BNE that skips 3 "IR instructions"
+    rp2a03_program_emit_rel(program, code, NES_OP_BNE, 0);
+    rp2a03_text_segment_add_pending_jump(code, &(Rp2a03PendingJump) { .base_jump_pc = code->pc, .byte_index = code->pc - 1, .ir_offset = 3, .absolute = false });
+    rp2a03_text_segment_backpatch_jumps(code);
+
+    // A's target is 126 bytes away (in range)
+    emit_nops(program, code, 124);
+    rp2a03_text_segment_backpatch_jumps(code);
+
+    // B's target is 250 bytes away (out of range)
+    emit_nops(program, code, 126);
+    rp2a03_text_segment_backpatch_jumps(code);
+
+    // Relaxing B moves A's target out of range, so A is relaxed too
+    rp2a03_text_segment_relax_branches(code);
+
+    flut_expect_compat("Segment at 0x00 should be 0xD0 (BNE)",       code->bytes[0x00] == 0xD0);
+    flut_expect_compat("Segment at 0x01 should be 0x03 (+3)",        code->bytes[0x01] == 0x03);
+    flut_expect_compat("Segment at 0x02 should be 0x4C (JMP)",       code->bytes[0x02] == 0x4C);
+    flut_expect_compat("Segment at 0x05 should be 0xF0 (BEQ)",       code->bytes[0x05] == 0xF0);
+    flut_expect_compat("Segment at 0x06 should be 0x03 (+3)",        code->bytes[0x06] == 0x03);
+    flut_expect_compat("Segment at 0x07 should be 0x4C (JMP)",       code->bytes[0x07] == 0x4C);
+    flut_expect_compat("Segment at 0x0A should be NOP",              code->bytes[0x0A] == rp2a03_opcode_lookup(NES_OP_NOP, NES_ADDR_IMP));
+    flut_expect_compat("Segment must grow 6 bytes",                  code->pc == 260);
+
+    code->base_address = 0x8000;
+    rp2a03_text_segment_backpatch_absolute_jumps(code);
+
+    flut_expect_compat("Segment at 0x03 should be 0x86 ($8086 lo)",  code->bytes[0x03] == 0x86);
+    flut_expect_compat("Segment at 0x04 should be 0x80 ($8086 hi)",  code->bytes[0x04] == 0x80);
+    flut_expect_compat("Segment at 0x08 should be 0x04 ($8104 lo)",  code->bytes[0x08] == 0x04);
+    flut_expect_compat("Segment at 0x09 should be 0x81 ($8104 hi)",  code->bytes[0x09] == 0x81);
+
+    rp2a03_program_free(program);
+
+    // A full segment has no room for the JMP of a relaxed branch
+    program = rp2a03_program_new(0x8000, 0x0, 0x0);
+    code = program->code;
+
+    rp2a03_program_emit_rel(program, code, NES_OP_BEQ, 0);
+    rp2a03_text_segment_flush(code);
+    rp2a03_text_segment_add_pending_jump(code, &(Rp2a03PendingJump) { .base_jump_pc = code->pc, .target_pc = UINT16_MAX - 1, .byte_index = code->pc - 1, .ir_offset = 0, .absolute = false });
+    code->pc = UINT16_MAX - 1;
+
+    flut_expect_compat("Branches must not be relaxed if the segment overflows", !rp2a03_text_segment_relax_branches(code));
+
+    rp2a03_program_free(program);
+}
+
+void zenit_test_nes_register_tracking(void)
+{
+    Rp2a03Program *program = rp2a03_program_new(0x8000, 0x0, 0x0);
+    Rp2a03TextSegment *code = program->code;
+
+    // Stores of constants to RAM wait for the next instruction, the first store to $10 is dead
+    rp2a03_program_emit_imm(program, code, NES_OP_LDA, 0x00);
+    rp2a03_program_emit_zpg(program, code, NES_OP_STA, 0x10);
+    rp2a03_program_emit_imm(program, code, NES_OP_LDX, 0x00);
+    rp2a03_program_emit_abs(program, code, NES_OP_STX, 0x0300);
+    rp2a03_program_emit_imm(program, code, NES_OP_LDA, 0x05);
+    rp2a03_program_emit_zpg(program, code, NES_OP_STA, 0x11);
+    rp2a03_program_emit_imm(program, code, NES_OP_LDA, 0x00);
+    rp2a03_program_emit_zpg(program, code, NES_OP_STA, 0x12);
+    rp2a03_program_emit_imm(program, code, NES_OP_LDA, 0x07);
+    rp2a03_program_emit_zpg(program, code, NES_OP_STA, 0x10);
+
+    // The stores to the PPU registers are not reordered
+    rp2a03_program_emit_imm(program, code, NES_OP_LDA, 0x01);
+    rp2a03_program_emit_abs(program, code, NES_OP_STA, 0x2000);
+
+    // A and the flags already contain 1
+    rp2a03_program_emit_imm(program, code, NES_OP_LDA, 0x01);
+    rp2a03_program_emit_rel(program, code, NES_OP_BEQ, 0x00);
+
+    // X contains 0, but the branch needs the Z flag
+    rp2a03_program_emit_imm(program, code, NES_OP_LDX, 0x00);
+    rp2a03_program_emit_rel(program, code, NES_OP_BNE, 0x00);
+
+    // The state of the registers is unknown at a branch target
+    rp2a03_text_segment_label(code);
+    rp2a03_program_emit_imm(program, code, NES_OP_LDA, 0x01);
+    rp2a03_program_emit_zpg(program, code, NES_OP_STA, 0x13);
+    rp2a03_text_segment_label(code);
+
+    const uint8_t expected[] = {
+        0xA9, 0x05,         // LDA #$05
+        0x85, 0x11,         // STA $11
+        0xA9, 0x07,         // LDA #$07
+        0x85, 0x10,         // STA $10
+        0xA2, 0x00,         // LDX #$00 (X ends up with 0, so the group of 0s goes last)
+        0x8E, 0x00, 0x03,   // STX $0300
+        0x86, 0x12,         // STX $12
+        0xA9, 0x01,         // LDA #$01
+        0x8D, 0x00, 0x20,   // STA $2000
+        0xF0, 0x00,         // BEQ
+        0xA2, 0x00,         // LDX #$00
+        0xD0, 0x00,         // BNE
+        0xA9, 0x01,         // LDA #$01
+        0x85, 0x13,         // STA $13
+    };
+
+    flut_expect_compat("Segment must be 30 bytes long", code->pc == sizeof(expected));
+    flut_expect_compat("Segment must drop the redundant loads and group the stores", memcmp(expected, code->bytes, sizeof(expected)) == 0);
+
+    rp2a03_program_free(program);
+}
+
+void zenit_test_nes_peephole(void)
+{
+    Rp2a03Program *program = rp2a03_program_new(0x8000, 0x0, 0x0);
+    Rp2a03TextSegment *code = program->code;
+
+    const uint8_t source[] = {
+        0xA2, 0x03,         // 00: LDX #$03
+        0x85, 0x10,         // 02: STA $10          <- loop
+        0xA5, 0x10,         // 04: LDA $10          store-load: DEX sets the flags again
+        0xCA,               // 06: DEX
+        0xD0, 0xF9,         // 07: BNE $02
+        0xA2, 0x00,         // 09: LDX #$00
+        0xA5, 0x20,         // 0B: LDA $20
+        0xF0, 0x00,         // 0D: BEQ $18          jump-threading: $18 jumps to the end
+        0xA9, 0x00,         // 0F: LDA #$00         reuse-register: X contains 0, and A is loaded again
+        0x85, 0x11,         // 11: STA $11
+        0xA5, 0x21,         // 13: LDA $21
+        0x4C, 0x00, 0x00,   // 15: JMP $18          jump-next
+        0x4C, 0x00, 0x00,   // 18: JMP $1B          jump-next (end of the segment)
+    };
+
+    memcpy(code->bytes, source, sizeof(source));
+    code->pc = sizeof(source);
+
+    rp2a03_text_segment_add_pending_jump(code, &(Rp2a03PendingJump) { .base_jump_pc = 0x0F, .target_pc = 0x18, .byte_index = 0x0E, .ir_offset = 0, .absolute = false });
+    rp2a03_text_segment_add_pending_jump(code, &(Rp2a03PendingJump) { .base_jump_pc = 0x18, .target_pc = 0x18, .byte_index = 0x16, .ir_offset = 0, .absolute = true });
+    rp2a03_text_segment_add_pending_jump(code, &(Rp2a03PendingJump) { .base_jump_pc = 0x1B, .target_pc = 0x1B, .byte_index = 0x19, .ir_offset = 0, .absolute = true });
+
+    Rp2a03PeepholeStats stats = { 0 };
+    flut_expect_compat("Peephole without rules must not change the segment", rp2a03_peephole_optimize(code, 0, &stats) == 0 && code->pc == sizeof(source));
+    flut_expect_compat("Peephole must remove 10 bytes", rp2a03_peephole_optimize(code, RP2A03_PEEPHOLE_ALL, &stats) == 10);
+
+    rp2a03_text_segment_relax_branches(code);
+
+    const uint8_t expected[] = {
+        0xA2, 0x03,         // 00: LDX #$03
+        0x85, 0x10,         // 02: STA $10
+        0xCA,               // 04: DEX
+        0xD0, 0xFB,         // 05: BNE $02
+        0xA2, 0x00,         // 07: LDX #$00
+        0xA5, 0x20,         // 09: LDA $20
+        0xF0, 0x04,         // 0B: BEQ $11
+        0x86, 0x11,         // 0D: STX $11
+        0xA5, 0x21,         // 0F: LDA $21
+    };
+
+    flut_expect_compat("Segment must be 17 bytes long", code->pc == sizeof(expected));
+    flut_expect_compat("Segment must contain the optimized code", memcmp(expected, code->bytes, sizeof(expected)) == 0);
+    flut_expect_compat("The jumps of the removed instructions must be removed", fl_list_length(code->pending_jumps) == 0);
+
+    flut_expect_compat("store-load must be applied once (2 bytes, 3 cycles)",
+        stats.applied[RP2A03_PEEPHOLE_STORE_LOAD] == 1 && stats.bytes[RP2A03_PEEPHOLE_STORE_LOAD] == 2 && stats.cycles[RP2A03_PEEPHOLE_STORE_LOAD] == 3);
+    flut_expect_compat("jump-threading must be applied once (0 bytes, 3 cycles)",
+        stats.applied[RP2A03_PEEPHOLE_JUMP_THREADING] == 1 && stats.bytes[RP2A03_PEEPHOLE_JUMP_THREADING] == 0 && stats.cycles[RP2A03_PEEPHOLE_JUMP_THREADING] == 3);
+    flut_expect_compat("jump-next must be applied twice (6 bytes, 6 cycles)",
+        stats.applied[RP2A03_PEEPHOLE_JUMP_NEXT] == 2 && stats.bytes[RP2A03_PEEPHOLE_JUMP_NEXT] == 6 && stats.cycles[RP2A03_PEEPHOLE_JUMP_NEXT] == 6);
+    flut_expect_compat("reuse-register must be applied once (2 bytes, 2 cycles)",
+        stats.applied[RP2A03_PEEPHOLE_REUSE_REGISTER] == 1 && stats.bytes[RP2A03_PEEPHOLE_REUSE_REGISTER] == 2 && stats.cycles[RP2A03_PEEPHOLE_REUSE_REGISTER] == 2);
+
+    rp2a03_program_free(program);
+}
@@ -8,9 +8,13 @@
 #include "../../../src/front-end/binding/resolve.h"
 #include "../../../src/front-end/symtable.h"
 #include "../../../src/front-end/codegen/zir.h"
+#include "../../../src/zir/passes/forward-temps.h"
 #include "../../../src/back-end/nes/ir/generate.h"
 #include "../../../src/back-end/nes/rp2a03/generate.h"
 #include "../../../src/back-end/nes/rp2a03/rom.h"
+#include "../../../src/back-end/nes/rp2a03/link.h"
+#include "../../../src/back-end/nes/ir/operands/uint.h"
+#include "../../../src/back-end/nes/ir/instructions/alloc.h"
 #include "tests.h"
 
 void zenit_test_nes_rom(void)
@@ -67,11 +71,12 @@ void zenit_test_nes_rom(void)
     flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
     
     ZirProgram *zir_program = zenit_generate_zir(&ctx);
+    zir_forward_temporaries(zir_program);
 
     ZnesContext *znes_context = znes_context_new(false);
     flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
 
-    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program);
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
 
     flut_expect_compat("RP2A03 program must be valid", rp2a03_program != NULL);
 
@@ -98,3 +103,557 @@ void zenit_test_nes_rom(void)
     zir_program_free(zir_program);
     zenit_context_free(&ctx);
 }
+
+void zenit_test_nes_prg_map(void)
+{
+    // Used: $8000-$800F, $8018, $8040-$FFF9. Free: $8010-$8017 (8 bytes) and $8019-$803F (39 bytes)
+    Rp2a03DataSegment *data = rp2a03_data_segment_new(0x8000, 0x8000);
+    memset(data->slots, 1, 0x10);
+    data->slots[0x18] = 1;
+    memset(data->slots + 0x40, 1, 0x7FFA - 0x40);
+
+    Rp2a03PrgMap *map = rp2a03_prg_map_new(data);
+
+    flut_expect_compat("PRG map must contain 2 free ranges", map->count == 2);
+    flut_expect_compat("PRG map must contain 47 free bytes (vectors are never free)", map->free_bytes == 47);
+    flut_expect_compat("PRG map largest free range must be 39 bytes long", map->largest == 39);
+    flut_expect_compat("PRG map fragmentation must be 17%", rp2a03_prg_map_fragmentation(map) == 17);
+
+    uint16_t address = 0;
+    flut_expect_compat("A blob of 6 bytes must be placed in the smallest range that fits", rp2a03_prg_map_allocate(map, 6, &address) && address == 0x8010);
+    flut_expect_compat("A blob of 40 bytes must not fit", !rp2a03_prg_map_allocate(map, 40, &address));
+    flut_expect_compat("A blob of 39 bytes must fill the largest range", rp2a03_prg_map_allocate(map, 39, &address) && address == 0x8019);
+    flut_expect_compat("PRG map must contain 1 free range", map->count == 1 && map->free_bytes == 2 && map->largest == 2);
+
+    char *dump = rp2a03_prg_map_dump(map, fl_cstring_new(0));
+    flut_expect_compat("PRG map dump must report the free ranges", flm_cstring_equals(dump,
+        "; PRG free ranges: 1 (2 bytes free, largest 2 bytes, fragmentation 0%)\n"
+        "; 8016-8017 | 2 bytes\n"
+    ));
+    fl_cstring_free(dump);
+
+    rp2a03_prg_map_free(map);
+    rp2a03_data_segment_free(data);
+}
+
+void zenit_test_nes_rom_best_fit(void)
+{
+    const char *zenit_source = 
+        // DATA leaves a 20 bytes hole ($8001-$8014) and a 7 bytes hole ($8016-$801C) 
+        "#[NES(address: 0x8000)] var a : uint8 = 1;"    "\n"
+        "#[NES(address: 0x8015)] var b : uint8 = 2;"    "\n"
+        "#[NES(address: 0x801D)] var c : uint8 = 3;"    "\n"
+
+        // The startup routine needs 4 bytes + 3 bytes of the JMP to the RESET handler
+        "#[NES(address: 0x00)] var zp : uint8 = 1;"     "\n"
+    ;
+
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+    
+    ZirProgram *zir_program = zenit_generate_zir(&ctx);
+
+    ZnesContext *znes_context = znes_context_new(false);
+    flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
+
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
+
+    flut_expect_compat("RP2A03 program must be valid", rp2a03_program != NULL);
+    flut_expect_compat("Startup routine must be placed in the hole that fits it best", rp2a03_program->startup->base_address == 0x8016);
+    flut_expect_compat("PRG map must keep the first hole untouched", rp2a03_program->prg->count == 2 && rp2a03_program->prg->ranges[0].address == 0x8001 && rp2a03_program->prg->ranges[0].size == 20);
+
+    Rp2a03Rom *nes_rom = rp2a03_rom_new(rp2a03_program);
+
+    flut_expect_compat("NES ROM must be valid", nes_rom != NULL);
+
+    // There is no RESET handler, the startup routine loops forever
+    const uint8_t startup[] = { 0xa9, 0x01, 0x85, 0x00, 0x4c, 0x1a, 0x80 };
+    flut_expect_compat("STARTUP segment must be copied to its place", memcmp(startup, nes_rom->prg_rom.bank + 0x16, sizeof(startup)) == 0);
+    flut_expect_compat("DATA segment must not be overwritten", nes_rom->prg_rom.bank[0x15] == 0x02 && nes_rom->prg_rom.bank[0x1D] == 0x03);
+    flut_expect_compat("RESET vector must point to the startup routine", nes_rom->prg_rom.res_addr == 0x8016);
+
+    rp2a03_rom_free(nes_rom);
+    rp2a03_program_free(rp2a03_program);
+    znes_context_free(znes_context);
+    zir_program_free(zir_program);
+    zenit_context_free(&ctx);
+}
+
+void zenit_test_nes_rom_code(void)
+{
+    const char *zenit_source = 
+        "if (true) {"                                   "\n"
+        "   #[NES(address: 0x00)] var zp = 1;"          "\n"
+        "} else {"                                      "\n"
+        "   #[NES(address: 0x00)] var zp = 2;"          "\n"
+        "}"                                             "\n"
+    ;
+
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+    
+    ZirProgram *zir_program = zenit_generate_zir(&ctx);
+
+    // Scripting mode: the instructions are emitted in the CODE segment
+    ZnesContext *znes_context = znes_context_new(true);
+    flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
+
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
+
+    flut_expect_compat("RP2A03 program must be valid", rp2a03_program != NULL);
+
+    // A text blob is placed by the linker, but it is not part of the reset sequence
+    Rp2a03TextSegment *blob = rp2a03_program_add_blob(rp2a03_program);
+    rp2a03_program_emit_imp(rp2a03_program, blob, NES_OP_RTS);
+    flut_expect_compat("Text blob must be placed", rp2a03_link_place(rp2a03_program, NULL) && blob->base_address == 0x8010);
+
+    Rp2a03Rom *nes_rom = rp2a03_rom_new(rp2a03_program);
+
+    flut_expect_compat("NES ROM must be valid", nes_rom != NULL);
+
+    const uint8_t code[] = { 
+        0xa9, 0x01,         // 8000: LDA #$01
+        0xf0, 0x05,         // 8002: BEQ $05
+        0x85, 0x00,         // 8004: STA $00 (A already contains 1)
+        0x4c, 0x0d, 0x80,   // 8006: JMP $800D
+        0xa9, 0x02,         // 8009: LDA #$02
+        0x85, 0x00,         // 800B: STA $00
+        0x4c, 0x0d, 0x80,   // 800D: JMP $800D (there is no RESET handler)
+        0x60,               // 8010: RTS (text blob)
+    };
+
+    flut_expect_compat("CODE segment must be copied to the ROM", memcmp(code, nes_rom->prg_rom.bank, sizeof(code)) == 0);
+    flut_expect_compat("RESET vector must point to the CODE segment", nes_rom->prg_rom.res_addr == 0x8000);
+
+    rp2a03_rom_free(nes_rom);
+    rp2a03_program_free(rp2a03_program);
+    znes_context_free(znes_context);
+    zir_program_free(zir_program);
+    zenit_context_free(&ctx);
+}
+
+void zenit_test_nes_rom_vectors(void)
+{
+    const char *zenit_source = 
+        "#[NES(address: 0x8000)]"                           "\n"
+        "var reset = [ 0x4C, 0x00, 0x80 ];"                 "\n"
+
+        // The NMI handler points to an unused address
+        "#[NES(address: 0xFFFA)]"                           "\n"
+        "var vectors : []uint16 = [ 0x9000, 0x8000 ];"      "\n"
+    ;
+
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+    
+    ZirProgram *zir_program = zenit_generate_zir(&ctx);
+
+    ZnesContext *znes_context = znes_context_new(false);
+    flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
+
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
+
+    flut_expect_compat("RP2A03 program must be valid", rp2a03_program != NULL);
+
+    Rp2a03Rom *nes_rom = rp2a03_rom_new(rp2a03_program);
+
+    flut_expect_compat("NES ROM must be invalid if a vector points to an unused address", nes_rom == NULL);
+
+    rp2a03_program_free(rp2a03_program);
+    znes_context_free(znes_context);
+    zir_program_free(zir_program);
+    zenit_context_free(&ctx);
+}
+
+static Rp2a03Rom* compile_rom_for(ZnesMapper mapper, const char *zenit_source)
+{
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+    
+    ZirProgram *zir_program = zenit_generate_zir(&ctx);
+
+    ZnesContext *znes_context = znes_context_new(false);
+    znes_context->program->mapper = mapper;
+    flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
+
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
+
+    flut_expect_compat("RP2A03 program must be valid", rp2a03_program != NULL);
+
+    Rp2a03Rom *nes_rom = rp2a03_rom_new(rp2a03_program);
+
+    flut_expect_compat("NES ROM must be valid", nes_rom != NULL);
+
+    rp2a03_program_free(rp2a03_program);
+    znes_context_free(znes_context);
+    zir_program_free(zir_program);
+    zenit_context_free(&ctx);
+
+    return nes_rom;
+}
+
+static Rp2a03Rom* compile_rom(const char *zenit_source)
+{
+    return compile_rom_for(ZNES_MAPPER_NROM, zenit_source);
+}
+
+void zenit_test_nes_rom_layout(void)
+{
+    // The lower half ($8000-$BFFF) and the vectors do not overlap once mirrored: NROM-128
+    Rp2a03Rom *nes_rom = compile_rom(
+        "#[NES(address: 0x8000)]"                           "\n"
+        "var reset = [ 0x4C, 0x00, 0x80 ];"                 "\n"
+        "#[NES(address: 0xFFFA)]"                           "\n"
+        "var vectors : []uint16 = [ 0x8000, 0x8000 ];"      "\n"
+    );
+
+    const uint8_t vectors[] = { 0x00, 0x80, 0x00, 0x80, 0x00, 0x00 };
+
+    flut_expect_compat("Header must declare one PRG-ROM bank", nes_rom->header.prg_rom == 1 && fl_array_length(nes_rom->prg_banks) == RP2A03_PRG_BANK_SIZE);
+    flut_expect_compat("Header must not declare CHR-ROM", nes_rom->header.chr_rom == 0);
+    flut_expect_compat("NROM-128 bank must contain the lower half", nes_rom->prg_banks[0] == 0x4C && nes_rom->prg_banks[2] == 0x80);
+    flut_expect_compat("NROM-128 bank must contain the vectors at its end", memcmp(vectors, nes_rom->prg_banks + RP2A03_PRG_BANK_SIZE - 6, sizeof(vectors)) == 0);
+    rp2a03_rom_free(nes_rom);
+
+    // The code in the upper half ($C000-$FFFF) is mirrored at the same offsets than the lower half
+    nes_rom = compile_rom(
+        "#[NES(address: 0xC000)]"                           "\n"
+        "var reset = [ 0x4C, 0x00, 0xC0 ];"                 "\n"
+        "#[NES(address: 0x8010)]"                           "\n"
+        "var table = [ 1, 2, 3 ];"                          "\n"
+        "#[NES(address: 0xFFFA)]"                           "\n"
+        "var vectors : []uint16 = [ 0xC000, 0xC000 ];"      "\n"
+    );
+
+    flut_expect_compat("Header must declare one PRG-ROM bank if the halves do not overlap", nes_rom->header.prg_rom == 1 && fl_array_length(nes_rom->prg_banks) == RP2A03_PRG_BANK_SIZE);
+    flut_expect_compat("NROM-128 bank must merge both halves", nes_rom->prg_banks[0] == 0x4C && nes_rom->prg_banks[2] == 0xC0 && nes_rom->prg_banks[0x10] == 1);
+    rp2a03_rom_free(nes_rom);
+
+    // $8000 and $C000 are mirrors in NROM-128: NROM-256
+    nes_rom = compile_rom(
+        "#[NES(address: 0x8000)]"                           "\n"
+        "var reset = [ 0x4C, 0x00, 0x80 ];"                 "\n"
+        "#[NES(address: 0xC000)]"                           "\n"
+        "var table = [ 1, 2, 3 ];"                          "\n"
+        "#[NES(address: 0xFFFA)]"                           "\n"
+        "var vectors : []uint16 = [ 0x8000, 0x8000 ];"      "\n"
+    );
+
+    flut_expect_compat("Header must declare two PRG-ROM banks if the halves overlap", nes_rom->header.prg_rom == 2 && fl_array_length(nes_rom->prg_banks) == 2 * RP2A03_PRG_BANK_SIZE);
+    flut_expect_compat("NROM-256 banks must keep both halves", nes_rom->prg_banks[0] == 0x4C && nes_rom->prg_banks[RP2A03_PRG_BANK_SIZE] == 1);
+    rp2a03_rom_free(nes_rom);
+}
+
+static bool generate_ir_for(ZnesMapper mapper, const char *zenit_source)
+{
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+
+    ZirProgram *zir_program = zenit_generate_zir(&ctx);
+
+    ZnesContext *znes_context = znes_context_new(false);
+    znes_context->program->mapper = mapper;
+    bool success = znes_generate_program(znes_context, zir_program);
+
+    znes_context_free(znes_context);
+    zir_program_free(zir_program);
+    zenit_context_free(&ctx);
+
+    return success;
+}
+
+void zenit_test_nes_rom_banks(void)
+{
+    // The level data lives in the switchable bank 3, the copy in RAM needs to select it first
+    Rp2a03Rom *nes_rom = compile_rom_for(ZNES_MAPPER_UXROM,
+        "#[NES(bank: 3)]"                                   "\n"
+        "var level = [ 1, 2, 3 ];"                          "\n"
+        "#[NES(address: 0x300)]"                            "\n"
+        "var copy = level;"                                 "\n"
+    );
+
+    const uint8_t *fixed_bank = nes_rom->prg_banks + 7 * RP2A03_PRG_BANK_SIZE;
+
+    // UxROM: the bus conflicts table, the init routine ($C008) and the select routine ($C00A)
+    const uint8_t trampolines[] = { 
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0xA9, 0x00,                 // LDA #$00
+        0xA8,                       // TAY
+        0x99, 0x00, 0xC0,           // STA $C000,Y
+        0x60                        // RTS
+    };
+
+    const uint8_t startup[] = {
+        0x20, 0x08, 0xC0,           // JSR $C008
+        0xA9, 0x03,                 // LDA #$03
+        0x20, 0x0A, 0xC0,           // JSR $C00A
+        0xAD, 0x00, 0x80,           // LDA $8000
+        0x8D, 0x00, 0x03,           // STA $0300
+    };
+
+    flut_expect_compat("Header must declare the UxROM mapper", nes_rom->header.flag6.flags.mapper_low == ZNES_MAPPER_UXROM && nes_rom->header.flag7.flags.mapper_hi == 0);
+    flut_expect_compat("Header must declare eight PRG-ROM banks", nes_rom->header.prg_rom == 8 && fl_array_length(nes_rom->prg_banks) == 8 * RP2A03_PRG_BANK_SIZE);
+    flut_expect_compat("Bank 3 must contain the level data", nes_rom->prg_banks[3 * RP2A03_PRG_BANK_SIZE] == 1 && nes_rom->prg_banks[3 * RP2A03_PRG_BANK_SIZE + 2] == 3);
+    flut_expect_compat("Unused banks must be empty", nes_rom->prg_banks[RP2A03_PRG_BANK_SIZE] == 0 && nes_rom->prg_banks[0] == 0);
+    flut_expect_compat("Fixed bank must start with the bank switching routines", memcmp(trampolines, fixed_bank, sizeof(trampolines)) == 0);
+    flut_expect_compat("Startup must initialize the mapper and select the bank of the level", memcmp(startup, fixed_bank + sizeof(trampolines), sizeof(startup)) == 0);
+    flut_expect_compat("RESET vector must point to the fixed bank", fixed_bank[RP2A03_PRG_BANK_SIZE - 4] == 0x0F && fixed_bank[RP2A03_PRG_BANK_SIZE - 3] == 0xC0);
+    rp2a03_rom_free(nes_rom);
+
+    // MMC1 uses its serial port to select the banks
+    nes_rom = compile_rom_for(ZNES_MAPPER_MMC1,
+        "#[NES(bank: 1)]"                                   "\n"
+        "var level = [ 1, 2, 3 ];"                          "\n"
+        "#[NES(address: 0x300)]"                            "\n"
+        "var copy = level;"                                 "\n"
+    );
+
+    flut_expect_compat("Header must declare the MMC1 mapper", nes_rom->header.flag6.flags.mapper_low == ZNES_MAPPER_MMC1);
+    flut_expect_compat("Header must declare at least two PRG-ROM banks", nes_rom->header.prg_rom == 4 && nes_rom->prg_banks[RP2A03_PRG_BANK_SIZE] == 1);
+    flut_expect_compat("MMC1 init routine must reset the shift register", nes_rom->prg_banks[3 * RP2A03_PRG_BANK_SIZE] == 0xA9 && nes_rom->prg_banks[3 * RP2A03_PRG_BANK_SIZE + 1] == 0x80);
+    rp2a03_rom_free(nes_rom);
+
+    // Invalid banks
+    flut_expect_compat("NROM board must not accept banked variables", !generate_ir_for(ZNES_MAPPER_NROM,
+        "#[NES(bank: 1)]"                                   "\n"
+        "var level = [ 1, 2, 3 ];"                          "\n"
+        "#[NES(address: 0x300)]"                            "\n"
+        "var copy = level;"                                 "\n"
+    ));
+
+    flut_expect_compat("Bank must be a switchable bank", !generate_ir_for(ZNES_MAPPER_UXROM,
+        "#[NES(bank: 15)]"                                  "\n"
+        "var level = [ 1, 2, 3 ];"                          "\n"
+        "#[NES(address: 0x300)]"                            "\n"
+        "var copy = level;"                                 "\n"
+    ));
+
+    flut_expect_compat("Banked variable must be inside the bank window", !generate_ir_for(ZNES_MAPPER_UXROM,
+        "#[NES(bank: 2, address: 0xC000)]"                  "\n"
+        "var level = [ 1, 2, 3 ];"                          "\n"
+        "#[NES(address: 0x300)]"                            "\n"
+        "var copy = level;"                                 "\n"
+    ));
+}
+
+void zenit_test_nes_rom_chr(void)
+{
+    Rp2a03Rom *nes_rom = compile_rom(
+        "#[NES(segment: chr)]"                              "\n"
+        "var tiles = [ 0x18, 0x3C, 0x7E, 0xFF ];"           "\n"
+        "#[NES(segment: chr, address: 0x1000)]"             "\n"
+        "var sprites = [ 0x01, 0x02 ];"                     "\n"
+        "#[NES(address: 0x8000)]"                           "\n"
+        "var reset = [ 0x4C, 0x00, 0x80 ];"                 "\n"
+    );
+
+    const uint8_t tiles[] = { 0x18, 0x3C, 0x7E, 0xFF };
+    const uint8_t sprites[] = { 0x01, 0x02 };
+
+    flut_expect_compat("Header must declare one CHR-ROM bank", nes_rom->header.chr_rom == 1 && fl_array_length(nes_rom->chr_banks) == RP2A03_CHR_BANK_SIZE);
+    flut_expect_compat("CHR-ROM must contain the first pattern table", memcmp(tiles, nes_rom->chr_banks, sizeof(tiles)) == 0);
+    flut_expect_compat("CHR-ROM must contain the second pattern table", memcmp(sprites, nes_rom->chr_banks + 0x1000, sizeof(sprites)) == 0);
+    flut_expect_compat("PRG-ROM must not contain the CHR data", nes_rom->prg_banks[0] == 0x4C && nes_rom->prg_banks[3] == 0x00);
+    rp2a03_rom_free(nes_rom);
+
+    // Without CHR data, the board uses CHR-RAM
+    nes_rom = compile_rom(
+        "#[NES(address: 0x8000)]"                           "\n"
+        "var reset = [ 0x4C, 0x00, 0x80 ];"                 "\n"
+    );
+
+    flut_expect_compat("Header must not declare CHR-ROM", nes_rom->header.chr_rom == 0 && nes_rom->chr_banks == NULL);
+    rp2a03_rom_free(nes_rom);
+
+    // The CPU cannot read the pattern tables, and there is no code to initialize them
+    flut_expect_compat("CHR variables must not be read", !generate_ir_for(ZNES_MAPPER_NROM,
+        "#[NES(segment: chr)]"                              "\n"
+        "var tiles = [ 1, 2 ];"                             "\n"
+        "#[NES(address: 0x300)]"                            "\n"
+        "var copy = tiles;"                                 "\n"
+    ));
+
+    flut_expect_compat("CHR variables must be initialized with constants", !generate_ir_for(ZNES_MAPPER_NROM,
+        "var value = 1;"                                    "\n"
+        "#[NES(segment: chr)]"                              "\n"
+        "var tiles = [ value, 2 ];"                         "\n"
+    ));
+
+    flut_expect_compat("CHR variables must fit in the pattern tables", !generate_ir_for(ZNES_MAPPER_NROM,
+        "#[NES(segment: chr, address: 0x1FFF)]"             "\n"
+        "var tiles = [ 1, 2 ];"                             "\n"
+    ));
+}
+
+static void write_test_file(const char *path, const uint8_t *bytes, size_t length)
+{
+    FILE *file = fopen(path, "wb");
+    fwrite(bytes, 1, length, file);
+    fclose(file);
+}
+
+void zenit_test_nes_rom_incbin(void)
+{
+    const uint8_t table[] = { 0x10, 0x20, 0x30, 0x40 };
+    const uint8_t tiles[] = { 0x18, 0x3C, 0x7E, 0xFF };
+
+    write_test_file("zenit-incbin-test-table.bin", table, sizeof(table));
+    write_test_file("zenit-incbin-test-tiles.chr", tiles, sizeof(tiles));
+
+    Rp2a03Rom *nes_rom = compile_rom(
+        "#[NES(address: 0x8000)]"                           "\n"
+        "var reset = [ 0x4C, 0x00, 0x80 ];"                 "\n"
+        "#[NES(address: 0x9000)]"                           "\n"
+        "var table = incbin(\"zenit-incbin-test-table.bin\");"  "\n"
+        "#[NES(address: 0x9010)]"                           "\n"
+        "var wide : [4]uint16 = incbin(\"zenit-incbin-test-table.bin\");"  "\n"
+        "#[NES(address: 0x9020)]"                           "\n"
+        "var table_ptr = &table;"                           "\n"
+        "#[NES(segment: chr)]"                              "\n"
+        "var tiles = incbin(\"zenit-incbin-test-tiles.chr\");"  "\n"
+        "#[NES(address: 0x300)]"                            "\n"
+        "var buffer = incbin(\"zenit-incbin-test-table.bin\");" "\n"
+        "#[NES(address: 0x9022)]"                           "\n"
+        "var buffer_ptr = &buffer;"                         "\n"
+    );
+
+    const uint8_t wide[] = { 0x10, 0x00, 0x20, 0x00, 0x30, 0x00, 0x40, 0x00 };
+
+    // The RAM is initialized by the startup code: a copy loop from the image of the file in the ROM
+    const uint8_t buffer_store[] = { 
+        0x9D, 0xFF, 0x02,           // STA $02FF,X
+        0xCA,                       // DEX
+    };
+
+    flut_expect_compat("PRG-ROM must contain the included file", memcmp(table, nes_rom->prg_banks + 0x1000, sizeof(table)) == 0);
+    flut_expect_compat("PRG-ROM must widen the bytes of the file to the members of the array", memcmp(wide, nes_rom->prg_banks + 0x1010, sizeof(wide)) == 0);
+    flut_expect_compat("PRG-ROM must contain the address of the included file", nes_rom->prg_banks[0x1020] == 0x00 && nes_rom->prg_banks[0x1021] == 0x90);
+    flut_expect_compat("CHR-ROM must contain the included file", nes_rom->header.chr_rom == 1 && memcmp(tiles, nes_rom->chr_banks, sizeof(tiles)) == 0);
+
+    bool found_store = false;
+    for (size_t i=0; !found_store && i + sizeof(buffer_store) <= fl_array_length(nes_rom->prg_banks); i++)
+        found_store = memcmp(buffer_store, nes_rom->prg_banks + i, sizeof(buffer_store)) == 0;
+
+    flut_expect_compat("Startup code must initialize the RAM copy of the included file", found_store);
+    rp2a03_rom_free(nes_rom);
+
+    // The blob is opaque: it can be referenced, but it is not expanded to copy its elements
+    flut_expect_compat("Variables initialized with incbin must not be copied", !generate_ir_for(ZNES_MAPPER_NROM,
+        "var table = incbin(\"zenit-incbin-test-table.bin\");"  "\n"
+        "#[NES(address: 0x300)]"                            "\n"
+        "var copy = table;"                                 "\n"
+    ));
+
+    remove("zenit-incbin-test-table.bin");
+    remove("zenit-incbin-test-tiles.chr");
+}
+
+static char* generate_program_error(const char *zenit_source)
+{
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+
+    ZirProgram *zir_program = zenit_generate_zir(&ctx);
+    zir_forward_temporaries(zir_program);
+
+    ZnesContext *znes_context = znes_context_new(false);
+    flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
+
+    char *message = NULL;
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, &message);
+
+    flut_expect_compat("RP2A03 program must not be generated", rp2a03_program == NULL);
+
+    znes_context_free(znes_context);
+    zir_program_free(zir_program);
+    zenit_context_free(&ctx);
+
+    return message;
+}
+
+void zenit_test_nes_rom_errors(void)
+{
+    uint8_t *full = fl_malloc(0x7FF0);
+    memset(full, 1, 0x7FF0);
+    write_test_file("zenit-rom-test-full.bin", full, 0x7FF0);
+    fl_free(full);
+
+    // The DATA segment takes the whole PRG-ROM, there is no room for the startup routine
+    char *message = generate_program_error(
+        "#[NES(address: 0x8000)]"                           "\n"
+        "var full = incbin(\"zenit-rom-test-full.bin\");"   "\n"
+        "#[NES(address: 0x300)]"                            "\n"
+        "var copy = [ 1, 2, 3, 4 ];"                        "\n"
+    );
+
+    flut_vexpect_compat(message != NULL && strstr(message, "The startup routine needs") == message, 
+        "Error must explain that the startup routine does not fit: %s", message != NULL ? message : "(null)");
+
+    fl_cstring_free(message);
+    remove("zenit-rom-test-full.bin");
+
+    // The inner cast truncates a runtime value, the pass keeps the temporal symbols and they do not have memory
+    message = generate_program_error(
+        "var e : uint16 = 0x102;"                           "\n"
+        "var i : uint16 = cast(cast(e : uint8) : uint16);"  "\n"
+    );
+
+    flut_vexpect_compat(message != NULL && strstr(message, "Cannot generate the code of 'i'") != NULL, 
+        "Error must name the declaration: %s", message != NULL ? message : "(null)");
+
+    fl_cstring_free(message);
+
+    // The code generation stops at the first instruction that cannot be emitted
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING,
+        "#[NES(address: 0x300)]"                            "\n"
+        "var value : uint8 = 5;"                            "\n"
+    );
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+
+    ZirProgram *zir_program = zenit_generate_zir(&ctx);
+
+    ZnesContext *znes_context = znes_context_new(false);
+    flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
+
+    // The uint operand has an unknown size, the emitter cannot store it
+    ZnesAllocInstruction *instruction = (ZnesAllocInstruction*) znes_instruction_list_head(znes_context->program->startup->instructions)->value;
+    ((ZnesUintOperand*) instruction->source)->size = ZNES_UINT_UNK;
+
+    message = NULL;
+    flut_expect_compat("RP2A03 program must not be generated", rp2a03_generate_program(znes_context->program, &message) == NULL);
+    flut_vexpect_compat(message != NULL && strstr(message, "Cannot generate the code of 'value'") != NULL, 
+        "Error must name the declaration: %s", message != NULL ? message : "(null)");
+
+    fl_cstring_free(message);
+    znes_context_free(znes_context);
+    zir_program_free(zir_program);
+    zenit_context_free(&ctx);
+}
@@ -0,0 +1,232 @@
+#include <stdio.h>
+
+#include <flut/flut.h>
+#include <fllib/Cstring.h>
+#include "../../../src/front-end/type-check/check.h"
+#include "../../../src/front-end/inference/infer.h"
+#include "../../../src/front-end/parser/parse.h"
+#include "../../../src/front-end/binding/resolve.h"
+#include "../../../src/front-end/symtable.h"
+#include "../../../src/front-end/codegen/zir.h"
+#include "../../../src/zir/passes/forward-temps.h"
+#include "../../../src/back-end/nes/ir/generate.h"
+#include "../../../src/back-end/nes/rp2a03/generate.h"
+#include "../../../src/back-end/nes/rp2a03/rom.h"
+#include "simulator.h"
+#include "tests.h"
+
+void zenit_test_nes_simulate_rom(void)
+{
+    const char *zenit_source =
+        "#[NES(address: 0x00)]"                             "\n"
+        "var bg_color = 0x20;"                              "\n"
+        ""                                                  "\n"
+        "#[NES(address: 0x8000)]"                           "\n"
+        "var reset = ["                                     "\n"
+        "    0x78,                       // SEI"            "\n"
+        "    0xD8,                       // CLD"            "\n"
+        "    0x2C, 0x02, 0x20,           // BIT $2002"      "\n"
+        "    0x10, 0xFB,                 // BPL $8002"      "\n"
+        "    0xA9, 0x88,                 // LDA #$88"       "\n"
+        "    0x8D, 0x00, 0x20,           // STA $2000"      "\n"
+        "    0x4C, 0x0C, 0x80,           // JMP $800C"      "\n"
+        "];"                                                "\n"
+        ""                                                  "\n"
+        "#[NES(address: 0x8010)]"                           "\n"
+        "var nmi : []uint8 = ["                             "\n"
+        "    0xA6, cast(&bg_color),      // LDX $00"        "\n"
+        "    0xE8,                       // INX"            "\n"
+        "    0x86, 0x00,                 // STX $00"        "\n"
+        "    0x8E, 0x01, 0x20,           // STX $2001"      "\n"
+        "    0x40,                       // RTI"            "\n"
+        "];"                                                "\n"
+        ""                                                  "\n"
+        "#[NES(address: 0xFFFA)]"                           "\n"
+        "var vectors : []uint16 = ["                        "\n"
+        "    cast(&nmi),"                                   "\n"
+        "    cast(&reset),"                                 "\n"
+        "];"                                                "\n"
+    ;
+
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+
+    ZirProgram *zir_program = zenit_generate_zir(&ctx);
+    zir_forward_temporaries(zir_program);
+
+    ZnesContext *znes_context = znes_context_new(false);
+    flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
+
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
+
+    flut_expect_compat("RP2A03 program must be valid", rp2a03_program != NULL);
+
+    Rp2a03Rom *nes_rom = rp2a03_rom_new(rp2a03_program);
+
+    flut_expect_compat("NES ROM must be valid", nes_rom != NULL);
+
+    Rp2a03Simulator sim;
+    rp2a03_simulator_init(&sim, nes_rom);
+
+    // The startup routine initializes bg_color (LDA #$20, STA $00) and jumps to the RESET handler (JMP)
+    flut_expect_compat("Program must end in the RESET handler's loop", rp2a03_simulator_run(&sim, 1000) == RP2A03_SIM_TRAP_LOOP && sim.pc == 0x800C);
+    flut_expect_compat("Startup routine must initialize bg_color", sim.ram[0x00] == 0x20);
+    flut_expect_compat("RESET handler must enable the NMI", sim.ppu[0] == 0x88 && sim.a == 0x88);
+    flut_expect_compat("RESET handler must disable the IRQs", sim.p & RP2A03_SIM_FLAG_I);
+    flut_expect_compat("Program must execute 9 instructions", sim.instructions == 9);
+    flut_expect_compat("Program must take 24 cycles (startup 8, RESET handler 16)", sim.cycles == 24);
+
+    // Each NMI increments bg_color and writes it to PPUMASK
+    rp2a03_simulator_nmi(&sim);
+    flut_expect_compat("NMI handler must return to the RESET handler's loop", rp2a03_simulator_run(&sim, 1000) == RP2A03_SIM_TRAP_LOOP && sim.pc == 0x800C);
+    rp2a03_simulator_nmi(&sim);
+    rp2a03_simulator_run(&sim, 1000);
+
+    flut_expect_compat("NMI handler must increment bg_color", sim.ram[0x00] == 0x22 && sim.ppu[1] == 0x22);
+    flut_expect_compat("NMI handler must restore the stack", sim.sp == 0xFD);
+    flut_expect_compat("Each NMI must take 25 cycles (interrupt 7, handler 18)", sim.cycles == 24 + 2 * 25);
+    flut_expect_compat("Program must not write to the PRG-ROM", sim.rom_writes == 0);
+
+    rp2a03_rom_free(nes_rom);
+    rp2a03_program_free(rp2a03_program);
+    znes_context_free(znes_context);
+    zir_program_free(zir_program);
+    zenit_context_free(&ctx);
+}
+
+void zenit_test_nes_simulate_cycles(void)
+{
+    Rp2a03Rom *nes_rom = fl_malloc(sizeof(Rp2a03Rom));
+    memset(nes_rom, 0, sizeof(Rp2a03Rom));
+
+    const uint8_t code[] = {
+        0xA2, 0xFF,         // 8000: LDX #$FF       2
+        0xBD, 0xF0, 0x80,   // 8002: LDA $80F0,X    4 + 1 (crosses to $81EF)
+        0x9D, 0x00, 0x02,   // 8005: STA $0200,X    5 (the stores always pay the extra cycle)
+        0xA0, 0x03,         // 8008: LDY #$03       2
+        0x88,               // 800A: DEY            2 * 3
+        0xD0, 0xFD,         // 800B: BNE $800A      3 * 2 (taken) + 2
+        0x4C, 0xFB, 0x80,   // 800D: JMP $80FB      3
+    };
+
+    const uint8_t page_end[] = {
+        0xA9, 0x01,         // 80FB: LDA #$01       2
+        0xD0, 0x02,         // 80FD: BNE $8101      4 (taken, crosses to the next page)
+        0x00, 0x00,         // 80FF: BRK            Skipped
+        0x4C, 0x01, 0x81,   // 8101: JMP $8101      Trap
+    };
+
+    memcpy(nes_rom->prg_rom.bank, code, sizeof(code));
+    memcpy(nes_rom->prg_rom.bank + 0xFB, page_end, sizeof(page_end));
+    nes_rom->prg_rom.bank[0x1EF] = 0x42;
+    nes_rom->prg_rom.res_addr = 0x8000;
+
+    Rp2a03Simulator sim;
+    rp2a03_simulator_init(&sim, nes_rom);
+
+    flut_expect_compat("Simulator must stop at the cycle limit", rp2a03_simulator_run(&sim, 10) == RP2A03_SIM_CYCLE_LIMIT && sim.cycles == 12 && sim.pc == 0x8008);
+    flut_expect_compat("Simulator must continue after the cycle limit", rp2a03_simulator_run(&sim, 1000) == RP2A03_SIM_TRAP_LOOP && sim.pc == 0x8101);
+    flut_expect_compat("LDA must read across the page", sim.a == 0x01 && sim.ram[0x2FF] == 0x42);
+    flut_expect_compat("Loop must leave Y in 0", sim.y == 0x00 && sim.x == 0xFF);
+    flut_expect_compat("Program must execute 13 instructions", sim.instructions == 13);
+    flut_expect_compat("Program must take 37 cycles", sim.cycles == 37);
+
+    // BRK and the illegal opcodes trap without being executed
+    nes_rom->prg_rom.bank[0x101] = 0x00;
+    rp2a03_simulator_init(&sim, nes_rom);
+    flut_expect_compat("BRK must trap the simulator", rp2a03_simulator_run(&sim, 1000) == RP2A03_SIM_TRAP_BRK && sim.pc == 0x8101 && sim.cycles == 37);
+
+    nes_rom->prg_rom.bank[0x101] = 0x02;
+    rp2a03_simulator_init(&sim, nes_rom);
+    flut_expect_compat("Illegal opcodes must trap the simulator", rp2a03_simulator_run(&sim, 1000) == RP2A03_SIM_TRAP_ILLEGAL && sim.pc == 0x8101);
+
+    fl_free(nes_rom);
+}
+
+void zenit_test_nes_simulate_init_loops(void)
+{
+    // The copied array needs a full page and a partial chunk, the cleared and the filled arrays are full pages
+    char *zenit_source = fl_cstring_dup(
+        "#[NES(address: 0x8000)]"                           "\n"
+        "var reset = [ 0x4C, 0x00, 0x80 ];"                 "\n"
+        "#[NES(address: 0xFFFA)]"                           "\n"
+        "var vectors : []uint16 = [ cast(&reset), cast(&reset) ];"  "\n"
+        "#[NES(address: 0x300)]"                            "\n"
+        "var table : [300]uint8 = ["
+    );
+
+    for (size_t i=0; i < 300; i++)
+        fl_cstring_vappend(&zenit_source, "%s%zu", i > 0 ? ", " : " ", (i * 7 + 1) & 0xFF);
+
+    fl_cstring_append(&zenit_source, " ];\n#[NES(address: 0x500)]\nvar buffer : [256]uint8 = [");
+
+    for (size_t i=0; i < 256; i++)
+        fl_cstring_append(&zenit_source, i > 0 ? ", 0" : " 0");
+
+    fl_cstring_append(&zenit_source, " ];\n#[NES(address: 0x700)]\nvar fill : [256]uint8 = [");
+
+    for (size_t i=0; i < 256; i++)
+        fl_cstring_append(&zenit_source, i > 0 ? ", 0x11" : " 0x11");
+
+    fl_cstring_append(&zenit_source, " ];\n");
+
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+
+    ZirProgram *zir_program = zenit_generate_zir(&ctx);
+    zir_forward_temporaries(zir_program);
+
+    ZnesContext *znes_context = znes_context_new(false);
+    flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
+
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
+
+    flut_expect_compat("RP2A03 program must be valid", rp2a03_program != NULL);
+
+    Rp2a03Rom *nes_rom = rp2a03_rom_new(rp2a03_program);
+
+    flut_expect_compat("NES ROM must be valid", nes_rom != NULL);
+
+    // The RAM starts with a known pattern to catch the stores outside of the variables
+    Rp2a03Simulator sim;
+    rp2a03_simulator_init(&sim, nes_rom);
+    memset(sim.ram, 0x55, sizeof(sim.ram));
+
+    flut_expect_compat("Program must end in the RESET handler's loop", rp2a03_simulator_run(&sim, 100000) == RP2A03_SIM_TRAP_LOOP && sim.pc == 0x8000);
+
+    flut_expect_compat("Copy loop must not write the byte before the array", sim.ram[0x2FF] == 0x55);
+    flut_expect_compat("Copy loop must write the first byte of the array", sim.ram[0x300] == 0x01);
+    flut_expect_compat("Copy loop must write the last byte of the first page", sim.ram[0x3FF] == ((255 * 7 + 1) & 0xFF));
+    flut_expect_compat("Copy loop must write the last byte of the array", sim.ram[0x42B] == ((299 * 7 + 1) & 0xFF));
+    flut_expect_compat("Copy loop must not write the byte after the array", sim.ram[0x42C] == 0x55);
+
+    bool table_copied = true;
+    for (size_t i=0; i < 300 && table_copied; i++)
+        table_copied = sim.ram[0x300 + i] == ((i * 7 + 1) & 0xFF);
+
+    flut_expect_compat("Copy loop must write every byte of the array", table_copied);
+
+    flut_expect_compat("BSS clear must not write the byte before the array", sim.ram[0x4FF] == 0x55);
+    flut_expect_compat("BSS clear must clear the first byte of the array", sim.ram[0x500] == 0x00);
+    flut_expect_compat("BSS clear must clear the last byte of the array", sim.ram[0x5FF] == 0x00);
+    flut_expect_compat("BSS clear must not write the byte after the array", sim.ram[0x600] == 0x55);
+
+    flut_expect_compat("Fill loop must not write the byte before the array", sim.ram[0x6FF] == 0x55);
+    flut_expect_compat("Fill loop must write the first byte of the array", sim.ram[0x700] == 0x11);
+    flut_expect_compat("Fill loop must write the last byte of the array", sim.ram[0x7FF] == 0x11);
+
+    rp2a03_rom_free(nes_rom);
+    rp2a03_program_free(rp2a03_program);
+    znes_context_free(znes_context);
+    zir_program_free(zir_program);
+    zenit_context_free(&ctx);
+    fl_cstring_free(zenit_source);
+}
@@ -0,0 +1,439 @@
+#include <string.h>
+#include "../../../src/back-end/nes/rp2a03/instruction.h"
+#include "simulator.h"
+
+/*
+ * Function: rp2a03_simulator_init
+ *  Prepares the simulator to run the ROM from its RESET vector. The registers take their power up
+ *  values and the cycle counter starts at 0, so it only counts the cycles spent by the program.
+ *
+ * Parameters:
+ *  <Rp2a03Simulator> *sim: The simulator
+ *  <const Rp2a03Rom> *rom: The ROM produced by <rp2a03_rom_new>
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void rp2a03_simulator_init(Rp2a03Simulator *sim, const Rp2a03Rom *rom)
+{
+    memset(sim, 0, sizeof(Rp2a03Simulator));
+    sim->rom = rom;
+    sim->sp = 0xFD;
+    sim->p = RP2A03_SIM_FLAG_I | RP2A03_SIM_FLAG_U;
+    sim->pc = rom->prg_rom.res_addr;
+    sim->status = RP2A03_SIM_RUNNING;
+}
+
+/*
+ * Function: rp2a03_simulator_read
+ *  Reads a byte from the CPU address space: the 2KB of RAM are mirrored up to $1FFF, the PPU registers
+ *  up to $3FFF, and the PRG-ROM is mapped at $8000. The PPU status register always reports the vertical
+ *  blank, so the startup loops that wait for it finish right away.
+ *
+ * Parameters:
+ *  <Rp2a03Simulator> *sim: The simulator
+ *  <uint16_t> address: The address to read
+ *
+ * Returns:
+ *  uint8_t: The byte at the address
+ */
+uint8_t rp2a03_simulator_read(Rp2a03Simulator *sim, uint16_t address)
+{
+    if (address < 0x2000)
+        return sim->ram[address & 0x7FF];
+
+    if (address < 0x4000)
+        return (address & 0x7) == 0x2 ? 0x80 : sim->ppu[address & 0x7];
+
+    if (address < 0x4020)
+        return sim->io[address - 0x4000];
+
+    if (address < 0x8000)
+        return 0;
+
+    const Rp2a03Nrom256 *prg_rom = &sim->rom->prg_rom;
+
+    switch (address)
+    {
+        case 0xFFFA: return prg_rom->nmi_addr & 0xFF;
+        case 0xFFFB: return prg_rom->nmi_addr >> 8;
+        case 0xFFFC: return prg_rom->res_addr & 0xFF;
+        case 0xFFFD: return prg_rom->res_addr >> 8;
+        case 0xFFFE: return prg_rom->irq_addr & 0xFF;
+        case 0xFFFF: return prg_rom->irq_addr >> 8;
+        default: return prg_rom->bank[address - 0x8000];
+    }
+}
+
+/*
+ * Function: rp2a03_simulator_write
+ *  Writes a byte to the CPU address space. The writes to the PRG-ROM are ignored (as in the hardware),
+ *  but they are counted.
+ *
+ * Parameters:
+ *  <Rp2a03Simulator> *sim: The simulator
+ *  <uint16_t> address: The address to write
+ *  <uint8_t> value: The byte to write
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void rp2a03_simulator_write(Rp2a03Simulator *sim, uint16_t address, uint8_t value)
+{
+    if (address < 0x2000)
+        sim->ram[address & 0x7FF] = value;
+    else if (address < 0x4000)
+        sim->ppu[address & 0x7] = value;
+    else if (address < 0x4020)
+        sim->io[address - 0x4000] = value;
+    else if (address >= 0x8000)
+        sim->rom_writes++;
+}
+
+static inline uint16_t read_word(Rp2a03Simulator *sim, uint16_t address)
+{
+    return rp2a03_simulator_read(sim, address) | (rp2a03_simulator_read(sim, address + 1) << 8);
+}
+
+static inline void push(Rp2a03Simulator *sim, uint8_t value)
+{
+    rp2a03_simulator_write(sim, 0x100 | sim->sp--, value);
+}
+
+static inline uint8_t pull(Rp2a03Simulator *sim)
+{
+    return rp2a03_simulator_read(sim, 0x100 | ++sim->sp);
+}
+
+static inline void set_flag(Rp2a03Simulator *sim, uint8_t flag, bool value)
+{
+    sim->p = value ? (sim->p | flag) : (sim->p & ~flag);
+}
+
+static inline uint8_t set_nz(Rp2a03Simulator *sim, uint8_t value)
+{
+    set_flag(sim, RP2A03_SIM_FLAG_Z, value == 0);
+    set_flag(sim, RP2A03_SIM_FLAG_N, value & 0x80);
+    return value;
+}
+
+/*
+ * Function: operand_address
+ *  Returns the effective address of the instruction's operand, and if the indexed modes crossed a page
+ *  boundary. The JMP indirect keeps the 6502 bug: the pointer does not cross a page.
+ */
+static uint16_t operand_address(Rp2a03Simulator *sim, const Rp2a03Instruction *instr, uint16_t pc, bool *page_crossed)
+{
+    uint8_t operand = rp2a03_simulator_read(sim, pc + 1);
+    uint16_t base = 0;
+    uint16_t address = 0;
+
+    switch (instr->mode)
+    {
+        case NES_ADDR_IMM:
+            return pc + 1;
+
+        case NES_ADDR_ZPG:
+            return operand;
+
+        case NES_ADDR_ZPX:
+            return (uint8_t) (operand + sim->x);
+
+        case NES_ADDR_ZPY:
+            return (uint8_t) (operand + sim->y);
+
+        case NES_ADDR_ABS:
+            return read_word(sim, pc + 1);
+
+        case NES_ADDR_ABX:
+        case NES_ADDR_ABY:
+            base = read_word(sim, pc + 1);
+            address = base + (instr->mode == NES_ADDR_ABX ? sim->x : sim->y);
+            *page_crossed = (base & 0xFF00) != (address & 0xFF00);
+            return address;
+
+        case NES_ADDR_IND:
+            base = read_word(sim, pc + 1);
+            return rp2a03_simulator_read(sim, base) | (rp2a03_simulator_read(sim, (base & 0xFF00) | ((base + 1) & 0xFF)) << 8);
+
+        case NES_ADDR_INX:
+            operand += sim->x;
+            return rp2a03_simulator_read(sim, operand) | (rp2a03_simulator_read(sim, (uint8_t) (operand + 1)) << 8);
+
+        case NES_ADDR_INY:
+            base = rp2a03_simulator_read(sim, operand) | (rp2a03_simulator_read(sim, (uint8_t) (operand + 1)) << 8);
+            address = base + sim->y;
+            *page_crossed = (base & 0xFF00) != (address & 0xFF00);
+            return address;
+
+        case NES_ADDR_REL:
+            return pc + 2 + (int8_t) operand;
+
+        case NES_ADDR_IMP:
+            break;
+    }
+
+    return 0;
+}
+
+static inline bool pays_page_cross(Rp2a03Mnemonic mnemonic)
+{
+    // The stores and the read-modify-write instructions always pay the extra cycle (the table includes it)
+    switch (mnemonic)
+    {
+        case NES_OP_ADC: case NES_OP_AND: case NES_OP_CMP: case NES_OP_EOR:
+        case NES_OP_LDA: case NES_OP_LDX: case NES_OP_LDY: case NES_OP_ORA:
+        case NES_OP_SBC:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static inline bool branch_taken(Rp2a03Simulator *sim, Rp2a03Mnemonic mnemonic)
+{
+    switch (mnemonic)
+    {
+        case NES_OP_BCC: return !(sim->p & RP2A03_SIM_FLAG_C);
+        case NES_OP_BCS: return sim->p & RP2A03_SIM_FLAG_C;
+        case NES_OP_BNE: return !(sim->p & RP2A03_SIM_FLAG_Z);
+        case NES_OP_BEQ: return sim->p & RP2A03_SIM_FLAG_Z;
+        case NES_OP_BPL: return !(sim->p & RP2A03_SIM_FLAG_N);
+        case NES_OP_BMI: return sim->p & RP2A03_SIM_FLAG_N;
+        case NES_OP_BVC: return !(sim->p & RP2A03_SIM_FLAG_V);
+        case NES_OP_BVS: return sim->p & RP2A03_SIM_FLAG_V;
+        default: return false;
+    }
+}
+
+static void add_with_carry(Rp2a03Simulator *sim, uint8_t value)
+{
+    // The RP2A03 does not have a decimal mode
+    uint16_t sum = sim->a + value + (sim->p & RP2A03_SIM_FLAG_C);
+    set_flag(sim, RP2A03_SIM_FLAG_C, sum > 0xFF);
+    set_flag(sim, RP2A03_SIM_FLAG_V, ~(sim->a ^ value) & (sim->a ^ sum) & 0x80);
+    sim->a = set_nz(sim, (uint8_t) sum);
+}
+
+static void compare(Rp2a03Simulator *sim, uint8_t reg, uint8_t value)
+{
+    set_flag(sim, RP2A03_SIM_FLAG_C, reg >= value);
+    set_nz(sim, (uint8_t) (reg - value));
+}
+
+static uint8_t shift(Rp2a03Simulator *sim, Rp2a03Mnemonic mnemonic, uint8_t value)
+{
+    uint8_t carry = sim->p & RP2A03_SIM_FLAG_C;
+
+    switch (mnemonic)
+    {
+        case NES_OP_ASL:
+            set_flag(sim, RP2A03_SIM_FLAG_C, value & 0x80);
+            return set_nz(sim, value << 1);
+        case NES_OP_ROL:
+            set_flag(sim, RP2A03_SIM_FLAG_C, value & 0x80);
+            return set_nz(sim, (value << 1) | carry);
+        case NES_OP_LSR:
+            set_flag(sim, RP2A03_SIM_FLAG_C, value & 0x01);
+            return set_nz(sim, value >> 1);
+        default:
+            set_flag(sim, RP2A03_SIM_FLAG_C, value & 0x01);
+            return set_nz(sim, (value >> 1) | (carry << 7));
+    }
+}
+
+/*
+ * Function: rp2a03_simulator_step
+ *  Executes the instruction at the program counter and adds its exact cost to the cycle counter: the
+ *  base cycles from the instruction table, plus one cycle for the reads that cross a page, and one or
+ *  two cycles for the taken branches.
+ *  The simulator traps (without executing the instruction) on a jump or a branch to itself, which is
+ *  how the programs loop forever, on BRK, and on the illegal opcodes.
+ *
+ * Parameters:
+ *  <Rp2a03Simulator> *sim: The simulator
+ *
+ * Returns:
+ *  Rp2a03SimStatus: <RP2A03_SIM_RUNNING> if the instruction was executed, otherwise the trap
+ */
+Rp2a03SimStatus rp2a03_simulator_step(Rp2a03Simulator *sim)
+{
+    if (sim->status != RP2A03_SIM_RUNNING)
+        return sim->status;
+
+    uint16_t pc = sim->pc;
+    uint8_t opcode = rp2a03_simulator_read(sim, pc);
+    const Rp2a03Instruction *instr = rp2a03_instruction_lookup(opcode);
+
+    if (instr->mnemonic == NES_OP_XXX || (instr->mnemonic == NES_OP_NOP && opcode != rp2a03_opcode_lookup(NES_OP_NOP, NES_ADDR_IMP)))
+        return sim->status = RP2A03_SIM_TRAP_ILLEGAL;
+
+    if (instr->mnemonic == NES_OP_BRK)
+        return sim->status = RP2A03_SIM_TRAP_BRK;
+
+    bool page_crossed = false;
+    uint16_t address = operand_address(sim, instr, pc, &page_crossed);
+
+    if ((instr->mnemonic == NES_OP_JMP || instr->mode == NES_ADDR_REL) && address == pc)
+    {
+        if (instr->mnemonic == NES_OP_JMP || branch_taken(sim, instr->mnemonic))
+            return sim->status = RP2A03_SIM_TRAP_LOOP;
+    }
+
+    sim->pc = pc + instr->size;
+    sim->cycles += instr->cycles;
+    sim->instructions++;
+
+    if (page_crossed && pays_page_cross(instr->mnemonic))
+        sim->cycles++;
+
+    switch (instr->mnemonic)
+    {
+        case NES_OP_LDA: sim->a = set_nz(sim, rp2a03_simulator_read(sim, address)); break;
+        case NES_OP_LDX: sim->x = set_nz(sim, rp2a03_simulator_read(sim, address)); break;
+        case NES_OP_LDY: sim->y = set_nz(sim, rp2a03_simulator_read(sim, address)); break;
+        case NES_OP_STA: rp2a03_simulator_write(sim, address, sim->a); break;
+        case NES_OP_STX: rp2a03_simulator_write(sim, address, sim->x); break;
+        case NES_OP_STY: rp2a03_simulator_write(sim, address, sim->y); break;
+
+        case NES_OP_TAX: sim->x = set_nz(sim, sim->a); break;
+        case NES_OP_TAY: sim->y = set_nz(sim, sim->a); break;
+        case NES_OP_TXA: sim->a = set_nz(sim, sim->x); break;
+        case NES_OP_TYA: sim->a = set_nz(sim, sim->y); break;
+        case NES_OP_TSX: sim->x = set_nz(sim, sim->sp); break;
+        case NES_OP_TXS: sim->sp = sim->x; break;
+
+        case NES_OP_INX: sim->x = set_nz(sim, sim->x + 1); break;
+        case NES_OP_INY: sim->y = set_nz(sim, sim->y + 1); break;
+        case NES_OP_DEX: sim->x = set_nz(sim, sim->x - 1); break;
+        case NES_OP_DEY: sim->y = set_nz(sim, sim->y - 1); break;
+        case NES_OP_INC: rp2a03_simulator_write(sim, address, set_nz(sim, rp2a03_simulator_read(sim, address) + 1)); break;
+        case NES_OP_DEC: rp2a03_simulator_write(sim, address, set_nz(sim, rp2a03_simulator_read(sim, address) - 1)); break;
+
+        case NES_OP_ADC: add_with_carry(sim, rp2a03_simulator_read(sim, address)); break;
+        case NES_OP_SBC: add_with_carry(sim, rp2a03_simulator_read(sim, address) ^ 0xFF); break;
+        case NES_OP_AND: sim->a = set_nz(sim, sim->a & rp2a03_simulator_read(sim, address)); break;
+        case NES_OP_ORA: sim->a = set_nz(sim, sim->a | rp2a03_simulator_read(sim, address)); break;
+        case NES_OP_EOR: sim->a = set_nz(sim, sim->a ^ rp2a03_simulator_read(sim, address)); break;
+        case NES_OP_CMP: compare(sim, sim->a, rp2a03_simulator_read(sim, address)); break;
+        case NES_OP_CPX: compare(sim, sim->x, rp2a03_simulator_read(sim, address)); break;
+        case NES_OP_CPY: compare(sim, sim->y, rp2a03_simulator_read(sim, address)); break;
+
+        case NES_OP_BIT:
+        {
+            uint8_t value = rp2a03_simulator_read(sim, address);
+            set_flag(sim, RP2A03_SIM_FLAG_Z, (sim->a & value) == 0);
+            set_flag(sim, RP2A03_SIM_FLAG_N, value & 0x80);
+            set_flag(sim, RP2A03_SIM_FLAG_V, value & 0x40);
+            break;
+        }
+
+        case NES_OP_ASL:
+        case NES_OP_LSR:
+        case NES_OP_ROL:
+        case NES_OP_ROR:
+            if (instr->mode == NES_ADDR_IMP)
+                sim->a = shift(sim, instr->mnemonic, sim->a);
+            else
+                rp2a03_simulator_write(sim, address, shift(sim, instr->mnemonic, rp2a03_simulator_read(sim, address)));
+            break;
+
+        case NES_OP_CLC: set_flag(sim, RP2A03_SIM_FLAG_C, false); break;
+        case NES_OP_SEC: set_flag(sim, RP2A03_SIM_FLAG_C, true); break;
+        case NES_OP_CLI: set_flag(sim, RP2A03_SIM_FLAG_I, false); break;
+        case NES_OP_SEI: set_flag(sim, RP2A03_SIM_FLAG_I, true); break;
+        case NES_OP_CLD: set_flag(sim, RP2A03_SIM_FLAG_D, false); break;
+        case NES_OP_SED: set_flag(sim, RP2A03_SIM_FLAG_D, true); break;
+        case NES_OP_CLV: set_flag(sim, RP2A03_SIM_FLAG_V, false); break;
+
+        case NES_OP_PHA: push(sim, sim->a); break;
+        case NES_OP_PHP: push(sim, sim->p | RP2A03_SIM_FLAG_B | RP2A03_SIM_FLAG_U); break;
+        case NES_OP_PLA: sim->a = set_nz(sim, pull(sim)); break;
+        case NES_OP_PLP: sim->p = (pull(sim) & ~RP2A03_SIM_FLAG_B) | RP2A03_SIM_FLAG_U; break;
+
+        case NES_OP_JMP: sim->pc = address; break;
+
+        case NES_OP_JSR:
+            push(sim, (sim->pc - 1) >> 8);
+            push(sim, (sim->pc - 1) & 0xFF);
+            sim->pc = address;
+            break;
+
+        case NES_OP_RTS:
+            sim->pc = pull(sim);
+            sim->pc |= pull(sim) << 8;
+            sim->pc++;
+            break;
+
+        case NES_OP_RTI:
+            sim->p = (pull(sim) & ~RP2A03_SIM_FLAG_B) | RP2A03_SIM_FLAG_U;
+            sim->pc = pull(sim);
+            sim->pc |= pull(sim) << 8;
+            break;
+
+        case NES_OP_BCC: case NES_OP_BCS: case NES_OP_BNE: case NES_OP_BEQ:
+        case NES_OP_BPL: case NES_OP_BMI: case NES_OP_BVC: case NES_OP_BVS:
+            if (branch_taken(sim, instr->mnemonic))
+            {
+                sim->cycles += (sim->pc & 0xFF00) != (address & 0xFF00) ? 2 : 1;
+                sim->pc = address;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return sim->status;
+}
+
+/*
+ * Function: rp2a03_simulator_run
+ *  Runs the program until it traps or until it spends the given number of cycles. A simulator that
+ *  stopped at the cycle limit can run again.
+ *
+ * Parameters:
+ *  <Rp2a03Simulator> *sim: The simulator
+ *  <uint64_t> max_cycles: The cycle budget for this run
+ *
+ * Returns:
+ *  Rp2a03SimStatus: The trap that stopped the simulator, or <RP2A03_SIM_CYCLE_LIMIT>
+ */
+Rp2a03SimStatus rp2a03_simulator_run(Rp2a03Simulator *sim, uint64_t max_cycles)
+{
+    if (sim->status == RP2A03_SIM_CYCLE_LIMIT)
+        sim->status = RP2A03_SIM_RUNNING;
+
+    uint64_t limit = sim->cycles + max_cycles;
+
+    while (rp2a03_simulator_step(sim) == RP2A03_SIM_RUNNING)
+    {
+        if (sim->cycles >= limit)
+            return sim->status = RP2A03_SIM_CYCLE_LIMIT;
+    }
+
+    return sim->status;
+}
+
+/*
+ * Function: rp2a03_simulator_nmi
+ *  Raises a non-maskable interrupt: the program counter and the flags are pushed to the stack, and the
+ *  program continues at the NMI vector. The interrupt resumes a trapped loop, so the NMI handler can run
+ *  and return to it.
+ *
+ * Parameters:
+ *  <Rp2a03Simulator> *sim: The simulator
+ *
+ * Returns:
+ *  void: This function does not return a value
+ */
+void rp2a03_simulator_nmi(Rp2a03Simulator *sim)
+{
+    push(sim, sim->pc >> 8);
+    push(sim, sim->pc & 0xFF);
+    push(sim, (sim->p & ~RP2A03_SIM_FLAG_B) | RP2A03_SIM_FLAG_U);
+    set_flag(sim, RP2A03_SIM_FLAG_I, true);
+    sim->pc = sim->rom->prg_rom.nmi_addr;
+    sim->cycles += 7;
+    sim->status = RP2A03_SIM_RUNNING;
+}
@@ -0,0 +1,50 @@
+#ifndef ZENIT_TESTS_NES_SIMULATOR_H
+#define ZENIT_TESTS_NES_SIMULATOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "../../../src/back-end/nes/rp2a03/rom.h"
+
+#define RP2A03_SIM_FLAG_C 0x01
+#define RP2A03_SIM_FLAG_Z 0x02
+#define RP2A03_SIM_FLAG_I 0x04
+#define RP2A03_SIM_FLAG_D 0x08
+#define RP2A03_SIM_FLAG_B 0x10
+#define RP2A03_SIM_FLAG_U 0x20
+#define RP2A03_SIM_FLAG_V 0x40
+#define RP2A03_SIM_FLAG_N 0x80
+
+typedef enum Rp2a03SimStatus {
+    RP2A03_SIM_RUNNING,
+    RP2A03_SIM_TRAP_LOOP,
+    RP2A03_SIM_TRAP_BRK,
+    RP2A03_SIM_TRAP_ILLEGAL,
+    RP2A03_SIM_CYCLE_LIMIT,
+} Rp2a03SimStatus;
+
+typedef struct Rp2a03Simulator {
+    const Rp2a03Rom *rom;
+    uint8_t ram[0x800];
+    uint8_t ppu[8];
+    uint8_t io[0x20];
+    uint8_t a;
+    uint8_t x;
+    uint8_t y;
+    uint8_t sp;
+    uint8_t p;
+    uint16_t pc;
+    uint64_t cycles;
+    size_t instructions;
+    size_t rom_writes;
+    Rp2a03SimStatus status;
+} Rp2a03Simulator;
+
+void rp2a03_simulator_init(Rp2a03Simulator *sim, const Rp2a03Rom *rom);
+uint8_t rp2a03_simulator_read(Rp2a03Simulator *sim, uint16_t address);
+void rp2a03_simulator_write(Rp2a03Simulator *sim, uint16_t address, uint8_t value);
+Rp2a03SimStatus rp2a03_simulator_step(Rp2a03Simulator *sim);
+Rp2a03SimStatus rp2a03_simulator_run(Rp2a03Simulator *sim, uint64_t max_cycles);
+void rp2a03_simulator_nmi(Rp2a03Simulator *sim);
+
+#endif /* ZENIT_TESTS_NES_SIMULATOR_H */
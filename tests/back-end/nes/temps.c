@@ -0,0 +1,140 @@
+#include <stdio.h>
+
+#include <flut/flut.h>
+#include "../../../src/front-end/type-check/check.h"
+#include "../../../src/front-end/inference/infer.h"
+#include "../../../src/front-end/parser/parse.h"
+#include "../../../src/front-end/binding/resolve.h"
+#include "../../../src/front-end/symtable.h"
+#include "../../../src/front-end/codegen/zir.h"
+#include "../../../src/back-end/nes/ir/generate.h"
+#include "../../../src/back-end/nes/ir/liveness.h"
+#include "tests.h"
+
+void zenit_test_nes_temp_slots(void)
+{
+    const char *zenit_source =
+        "var b : uint8 = cast(0x1FF : uint8);"              "\n"
+        "var c : uint8 = cast(0x200);"                      "\n"
+        "var d = cast(0x201 : uint8);"                      "\n"
+        "var e : uint16 = cast(&d);"                        "\n"
+        "var f : [2]uint8 = cast([ 0x3FF, 0x4FF ]);"        "\n"
+    ;
+
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+
+    ZirProgram *zir_program = zenit_generate_zir(&ctx);
+
+    // Live ranges: each temporal symbol is defined by a cast and consumed by the next variable instruction
+    ZnesTempSlots *slots = znes_temp_slots_compute(zir_program->global);
+
+    flut_expect_compat("There must be 5 temporal symbols", fl_array_length(slots->ranges) == 5);
+
+    for (size_t i=0; i < fl_array_length(slots->ranges); i++)
+    {
+        ZnesTempLiveRange *range = slots->ranges[i];
+        flut_vexpect_compat(range->start == i * 2 && range->end == i * 2 + 1, "Temporal symbol %s must live between instructions %zu and %zu", range->name, i * 2, i * 2 + 1);
+        flut_vexpect_compat(range->slot == 0, "Temporal symbol %s must reuse the slot 0", range->name);
+    }
+
+    flut_expect_compat("Without slot reuse the temporal symbols need 7 bytes", slots->total_size == 7);
+    flut_expect_compat("With slot reuse the temporal symbols need 2 bytes", slots->peak_size == 2);
+
+    znes_temp_slots_free(slots);
+
+    // The NES program must use the same slots and report the stats
+    ZnesContext *znes_context = znes_context_new(false);
+    flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
+
+    ZnesAlloc *temp = fl_hashtable_get(znes_context->program->allocations, "%tmp4");
+    flut_vexpect_compat(temp != NULL && temp->segment == ZNES_SEGMENT_TEMP, "Temporal symbol %s must exist", "%tmp4");
+    flut_vexpect_compat(temp != NULL && temp->address == 0, "Temporal symbol %s must be placed at slot 0", "%tmp4");
+
+    flut_expect_compat("NES program must track 5 temporal symbols", znes_context->program->temps.count == 5);
+    flut_expect_compat("NES program must track 7 bytes without slot reuse", znes_context->program->temps.total_size == 7);
+    flut_expect_compat("NES program must track a peak of 2 bytes", znes_context->program->temps.peak_size == 2);
+
+    znes_context_free(znes_context);
+    zir_program_free(zir_program);
+    zenit_context_free(&ctx);
+}
+
+void zenit_test_nes_temp_slots_overlap(void)
+{
+    const char *zenit_source =
+        "var a : [3]uint8 = [ cast(0x1FF : uint8), cast(0x2FF : uint8), cast(0x3FF : uint8) ];"   "\n"
+        "var b : uint16 = cast(&a);"                                                            "\n"
+    ;
+
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+
+    ZirProgram *zir_program = zenit_generate_zir(&ctx);
+
+    // The three casts within the array literal are alive at the same time, the last one can reuse the first slot
+    ZnesTempSlots *slots = znes_temp_slots_compute(zir_program->global);
+
+    uint16_t slot = 0xFFFF;
+    flut_expect_compat("There must be 4 temporal symbols", fl_array_length(slots->ranges) == 4);
+    flut_vexpect_compat(znes_temp_slots_get(slots, "%tmp0", &slot) && slot == 0, "Temporal symbol %s must be placed at slot 0", "%tmp0");
+    flut_vexpect_compat(znes_temp_slots_get(slots, "%tmp1", &slot) && slot == 1, "Temporal symbol %s must be placed at slot 1", "%tmp1");
+    flut_vexpect_compat(znes_temp_slots_get(slots, "%tmp2", &slot) && slot == 2, "Temporal symbol %s must be placed at slot 2", "%tmp2");
+    flut_vexpect_compat(znes_temp_slots_get(slots, "%tmp3", &slot) && slot == 0, "Temporal symbol %s must be placed at slot 0", "%tmp3");
+    flut_vexpect_compat(slots->ranges[0]->end == 3, "Temporal symbol %s must be alive until the array initialization", "%tmp0");
+    flut_expect_compat("Without slot reuse the temporal symbols need 5 bytes", slots->total_size == 5);
+    flut_expect_compat("With slot reuse the temporal symbols need 3 bytes", slots->peak_size == 3);
+
+    znes_temp_slots_free(slots);
+    zir_program_free(zir_program);
+    zenit_context_free(&ctx);
+}
+
+void zenit_test_nes_temp_slots_reference(void)
+{
+    const char *zenit_source =
+        "var d : uint8 = 1;"                                        "\n"
+        "var s : [2]&uint8 = [ cast(&d), cast(&d) ];"               "\n"
+    ;
+
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+
+    ZirProgram *zir_program = zenit_generate_zir(&ctx);
+
+    // The second temporal symbol is defined by a variable instruction (%tmp1 : &uint8 = ref @d) instead of a cast,
+    // both of them are alive until the array initialization
+    ZirBasicBlock *block = zir_program->global->cfg.blocks[0];
+    ZirCastInstr *cast = (ZirCastInstr*) block->instructions[2];
+    ZirVariableInstr *reference = zir_variable_instr_new(cast->base.destination, cast->source);
+    reference->attributes = zir_attribute_map_new();
+    block->instructions[2] = (ZirInstr*) reference;
+    zir_instruction_free((ZirInstr*) cast);
+
+    ZnesContext *znes_context = znes_context_new(false);
+    flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
+
+    ZnesAlloc *cast_temp = fl_hashtable_get(znes_context->program->allocations, "%tmp0");
+    ZnesAlloc *reference_temp = fl_hashtable_get(znes_context->program->allocations, "%tmp1");
+
+    flut_vexpect_compat(cast_temp != NULL && cast_temp->address == 0, "Temporal symbol %s must be placed at slot 0", "%tmp0");
+    flut_vexpect_compat(reference_temp != NULL && reference_temp->segment == ZNES_SEGMENT_TEMP && reference_temp->address == 2,
+        "Temporal symbol %s must be placed at slot 2", "%tmp1");
+    flut_expect_compat("NES program must track a peak of 4 bytes", znes_context->program->temps.peak_size == 4);
+
+    znes_context_free(znes_context);
+    zir_program_free(zir_program);
+    zenit_context_free(&ctx);
+}
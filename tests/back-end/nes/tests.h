@@ -6,10 +6,33 @@ void zenit_test_nes_global_vars_array(void);
 void zenit_test_nes_global_vars_zp(void);
 void zenit_test_nes_global_vars_data(void);
 void zenit_test_nes_global_vars_code(void);
+void zenit_test_nes_global_vars_code_tables(void);
+void zenit_test_nes_global_vars_bss(void);
 void zenit_test_nes_global_var_name_clash(void);
 void zenit_test_nes_cast(void);
+void zenit_test_nes_temp_slots(void);
+void zenit_test_nes_temp_slots_overlap(void);
+void zenit_test_nes_temp_slots_reference(void);
 void zenit_test_nes_conditionals(void);
+void zenit_test_nes_conditionals_long_branch(void);
+void zenit_test_nes_branch_relaxation(void);
+void zenit_test_nes_register_tracking(void);
+void zenit_test_nes_peephole(void);
 void zenit_test_nes_program(void);
 void zenit_test_nes_rom(void);
+void zenit_test_nes_prg_map(void);
+void zenit_test_nes_rom_best_fit(void);
+void zenit_test_nes_rom_code(void);
+void zenit_test_nes_rom_vectors(void);
+void zenit_test_nes_rom_layout(void);
+void zenit_test_nes_rom_banks(void);
+void zenit_test_nes_rom_chr(void);
+void zenit_test_nes_rom_incbin(void);
+void zenit_test_nes_rom_errors(void);
+void zenit_test_nes_simulate_rom(void);
+void zenit_test_nes_simulate_cycles(void);
+void zenit_test_nes_simulate_init_loops(void);
+void zenit_test_nes_cost(void);
+void zenit_test_nes_cost_loops(void);
 
 #endif /* ZENIT_TESTS_BACK_END_NES_H */
@@ -6,6 +6,7 @@
 #include "../../../src/front-end/binding/resolve.h"
 #include "../../../src/front-end/symtable.h"
 #include "../../../src/front-end/codegen/zir.h"
+#include "../../../src/zir/passes/forward-temps.h"
 #include "../../../src/back-end/nes/ir/generate.h"
 #include "../../../src/back-end/nes/rp2a03/generate.h"
 #include "tests.h"
@@ -66,7 +67,7 @@ void zenit_test_nes_global_vars(void)
     ZnesContext *znes_context = znes_context_new(false);
     flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
 
-    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program);
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
     
     flut_expect_compat("Data segment at 0x00 should be 0x1 (a)",                 rp2a03_program->data->bytes[0x00] == 0x1);
     flut_expect_compat("Data segment at 0x01 should be 0x2 (b)",                 rp2a03_program->data->bytes[0x01] == 0x2);
@@ -153,7 +154,7 @@ void zenit_test_nes_global_vars_array(void)
     ZnesContext *znes_context = znes_context_new(false);
     flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
 
-    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program);
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
     
     flut_expect_compat("Data segment at 0x00 should be 0xff (a lo)",             rp2a03_program->data->bytes[0x00] == 0xFF);
     flut_expect_compat("Data segment at 0x01 should be 0x01 (a hi)",             rp2a03_program->data->bytes[0x01] == 0x01);
@@ -213,114 +214,101 @@ void zenit_test_nes_global_vars_zp(void)
     flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
     
     ZirProgram *zir_program = zenit_generate_zir(&ctx);
+    zir_forward_temporaries(zir_program);
     
     ZnesContext *znes_context = znes_context_new(false);
     flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
 
-    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program);
+    // The test checks the code of the emitters
+    znes_context->program->peephole_rules = 0;
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
 
     flut_expect_compat("Data segment at 0x00 should be 0x00 (datavar -bss-)",    rp2a03_program->data->bytes[0x00] == 0x00);
     flut_expect_compat("Data segment at 0x01 should be 0x00 (tempvar -bss-)",    rp2a03_program->data->bytes[0x01] == 0x00);
     
-    // zpvar = 1
+    // b2 = false is part of the BSS, it is cleared before any other initialization
     flut_expect_compat("Startup routine at 0x00 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x00] == 0xA9);
-    flut_expect_compat("Startup routine at 0x01 should be 0x01 (#$01)",          rp2a03_program->startup->bytes[0x01] == 0x01);
+    flut_expect_compat("Startup routine at 0x01 should be 0x00 (#$00)",          rp2a03_program->startup->bytes[0x01] == 0x00);
     flut_expect_compat("Startup routine at 0x02 should be 0x85 (STA)",           rp2a03_program->startup->bytes[0x02] == 0x85);
-    flut_expect_compat("Startup routine at 0x03 should be 0x00 ($00)",           rp2a03_program->startup->bytes[0x03] == 0x00);
+    flut_expect_compat("Startup routine at 0x03 should be 0x0D ($0D)",           rp2a03_program->startup->bytes[0x03] == 0x0D);
+
+    // zpvar = 1
+    flut_expect_compat("Startup routine at 0x04 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x04] == 0xA9);
+    flut_expect_compat("Startup routine at 0x05 should be 0x01 (#$01)",          rp2a03_program->startup->bytes[0x05] == 0x01);
+    flut_expect_compat("Startup routine at 0x06 should be 0x85 (STA)",           rp2a03_program->startup->bytes[0x06] == 0x85);
+    flut_expect_compat("Startup routine at 0x07 should be 0x00 ($00)",           rp2a03_program->startup->bytes[0x07] == 0x00);
     
     // datavar = zpvar
-    flut_expect_compat("Startup routine at 0x04 should be 0xA5 (LDA)",           rp2a03_program->startup->bytes[0x04] == 0xA5);
-    flut_expect_compat("Startup routine at 0x05 should be 0x00 ($00)",           rp2a03_program->startup->bytes[0x05] == 0x00);
-    flut_expect_compat("Startup routine at 0x06 should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x06] == 0x8D);
-    flut_expect_compat("Startup routine at 0x07 should be 0x00 ($8000 lo)",      rp2a03_program->startup->bytes[0x07] == 0x00);
-    flut_expect_compat("Startup routine at 0x08 should be 0x80 ($8000 hi)",      rp2a03_program->startup->bytes[0x08] == 0x80);
+    flut_expect_compat("Startup routine at 0x08 should be 0xA5 (LDA)",           rp2a03_program->startup->bytes[0x08] == 0xA5);
+    flut_expect_compat("Startup routine at 0x09 should be 0x00 ($00)",           rp2a03_program->startup->bytes[0x09] == 0x00);
+    flut_expect_compat("Startup routine at 0x0A should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x0A] == 0x8D);
+    flut_expect_compat("Startup routine at 0x0B should be 0x00 ($8000 lo)",      rp2a03_program->startup->bytes[0x0B] == 0x00);
+    flut_expect_compat("Startup routine at 0x0C should be 0x80 ($8000 hi)",      rp2a03_program->startup->bytes[0x0C] == 0x80);
 
     // codevar = zpvar
-    flut_expect_compat("Startup routine at 0x09 should be 0xA5 (LDA)",           rp2a03_program->startup->bytes[0x09] == 0xA5);
-    flut_expect_compat("Startup routine at 0x0A should be 0x00 ($00)",           rp2a03_program->startup->bytes[0x0A] == 0x00);
-    flut_expect_compat("Startup routine at 0x0B should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x0B] == 0x8D);
-    flut_expect_compat("Startup routine at 0x0C should be 0x00 ($2000 lo)",      rp2a03_program->startup->bytes[0x0C] == 0x00);
-    flut_expect_compat("Startup routine at 0x0D should be 0x20 ($2000 hi)",      rp2a03_program->startup->bytes[0x0D] == 0x20);
+    flut_expect_compat("Startup routine at 0x0D should be 0xA5 (LDA)",           rp2a03_program->startup->bytes[0x0D] == 0xA5);
+    flut_expect_compat("Startup routine at 0x0E should be 0x00 ($00)",           rp2a03_program->startup->bytes[0x0E] == 0x00);
+    flut_expect_compat("Startup routine at 0x0F should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x0F] == 0x8D);
+    flut_expect_compat("Startup routine at 0x10 should be 0x00 ($2000 lo)",      rp2a03_program->startup->bytes[0x10] == 0x00);
+    flut_expect_compat("Startup routine at 0x11 should be 0x20 ($2000 hi)",      rp2a03_program->startup->bytes[0x11] == 0x20);
 
     // tempvar = cast(zpvar : uint16)
-    flut_expect_compat("Startup routine at 0x0E should be 0xA5 (LDA)",           rp2a03_program->startup->bytes[0x0E] == 0xA5);
-    flut_expect_compat("Startup routine at 0x0F should be 0x00 ($00)",           rp2a03_program->startup->bytes[0x0F] == 0x00);
-    flut_expect_compat("Startup routine at 0x10 should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x10] == 0x8D);
-    flut_expect_compat("Startup routine at 0x11 should be 0x00 ($8001 lo)",      rp2a03_program->startup->bytes[0x11] == 0x01);
-    flut_expect_compat("Startup routine at 0x12 should be 0x80 ($8001 hi)",      rp2a03_program->startup->bytes[0x12] == 0x80);
-    flut_expect_compat("Startup routine at 0x13 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x13] == 0xA9);
-    flut_expect_compat("Startup routine at 0x14 should be 0x00 (#$00)",          rp2a03_program->startup->bytes[0x14] == 0x00);
-    flut_expect_compat("Startup routine at 0x15 should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x15] == 0x8D);
-    flut_expect_compat("Startup routine at 0x16 should be 0x01 ($8002 lo)",      rp2a03_program->startup->bytes[0x16] == 0x02);
-    flut_expect_compat("Startup routine at 0x17 should be 0x80 ($8002 hi)",      rp2a03_program->startup->bytes[0x17] == 0x80);
+    flut_expect_compat("Startup routine at 0x12 should be 0xA5 (LDA)",           rp2a03_program->startup->bytes[0x12] == 0xA5);
+    flut_expect_compat("Startup routine at 0x13 should be 0x00 ($00)",           rp2a03_program->startup->bytes[0x13] == 0x00);
+    flut_expect_compat("Startup routine at 0x14 should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x14] == 0x8D);
+    flut_expect_compat("Startup routine at 0x15 should be 0x00 ($8001 lo)",      rp2a03_program->startup->bytes[0x15] == 0x01);
+    flut_expect_compat("Startup routine at 0x16 should be 0x80 ($8001 hi)",      rp2a03_program->startup->bytes[0x16] == 0x80);
+    flut_expect_compat("Startup routine at 0x17 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x17] == 0xA9);
+    flut_expect_compat("Startup routine at 0x18 should be 0x00 (#$00)",          rp2a03_program->startup->bytes[0x18] == 0x00);
+    flut_expect_compat("Startup routine at 0x19 should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x19] == 0x8D);
+    flut_expect_compat("Startup routine at 0x1A should be 0x01 ($8002 lo)",      rp2a03_program->startup->bytes[0x1A] == 0x02);
+    flut_expect_compat("Startup routine at 0x1B should be 0x80 ($8002 hi)",      rp2a03_program->startup->bytes[0x1B] == 0x80);
 
     // zpvar2 = zpvar
-    flut_expect_compat("Startup routine at 0x18 should be 0xA5 (LDA)",           rp2a03_program->startup->bytes[0x18] == 0xA5);
-    flut_expect_compat("Startup routine at 0x19 should be 0x00 ($00)",           rp2a03_program->startup->bytes[0x19] == 0x00);
-    flut_expect_compat("Startup routine at 0x1A should be 0x85 (STA)",           rp2a03_program->startup->bytes[0x1A] == 0x85);
-    flut_expect_compat("Startup routine at 0x1B should be 0x01 ($01)",           rp2a03_program->startup->bytes[0x1B] == 0x01);
-
-    // ZP allocation of structs
-    // Allocate x = 1
-    flut_expect_compat("Startup routine at 0x1C should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x1C] == 0xA9);
-    flut_expect_compat("Startup routine at 0x1D should be 0x01 (#$01)",          rp2a03_program->startup->bytes[0x1D] == 0x01);
+    flut_expect_compat("Startup routine at 0x1C should be 0xA5 (LDA)",           rp2a03_program->startup->bytes[0x1C] == 0xA5);
+    flut_expect_compat("Startup routine at 0x1D should be 0x00 ($00)",           rp2a03_program->startup->bytes[0x1D] == 0x00);
     flut_expect_compat("Startup routine at 0x1E should be 0x85 (STA)",           rp2a03_program->startup->bytes[0x1E] == 0x85);
-    flut_expect_compat("Startup routine at 0x1F should be 0x01 ($02)",           rp2a03_program->startup->bytes[0x1F] == 0x02);
-    // Allocate y = 2
-    flut_expect_compat("Startup routine at 0x20 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x20] == 0xA9);
-    flut_expect_compat("Startup routine at 0x21 should be 0x01 (#$02)",          rp2a03_program->startup->bytes[0x21] == 0x02);
-    flut_expect_compat("Startup routine at 0x22 should be 0x85 (STA)",           rp2a03_program->startup->bytes[0x22] == 0x85);
-    flut_expect_compat("Startup routine at 0x23 should be 0x03 ($03)",           rp2a03_program->startup->bytes[0x23] == 0x03);
-
-    // ZP allocation of array of structs
-    // Allocate parr[0] = { a: 1 }
-    flut_expect_compat("Startup routine at 0x24 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x24] == 0xA9);
-    flut_expect_compat("Startup routine at 0x25 should be 0x01 (#$01)",          rp2a03_program->startup->bytes[0x25] == 0x01);
-    flut_expect_compat("Startup routine at 0x26 should be 0x85 (STA)",           rp2a03_program->startup->bytes[0x26] == 0x85);
-    flut_expect_compat("Startup routine at 0x27 should be 0x04 ($04)",           rp2a03_program->startup->bytes[0x27] == 0x04);
-    flut_expect_compat("Startup routine at 0x28 should be 0xA2 (LDX)",           rp2a03_program->startup->bytes[0x28] == 0xA2);
-    flut_expect_compat("Startup routine at 0x29 should be 0x00 (#$00)",          rp2a03_program->startup->bytes[0x29] == 0x00);
-    flut_expect_compat("Startup routine at 0x2A should be 0x86 (STX)",           rp2a03_program->startup->bytes[0x2A] == 0x86);
-    flut_expect_compat("Startup routine at 0x2B should be 0x05 ($05)",           rp2a03_program->startup->bytes[0x2B] == 0x05);
-    // Allocate parr[1] = { a: 2 }
-    flut_expect_compat("Startup routine at 0x2C should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x2C] == 0xA9);
-    flut_expect_compat("Startup routine at 0x2D should be 0x02 (#$02)",          rp2a03_program->startup->bytes[0x2D] == 0x02);
-    flut_expect_compat("Startup routine at 0x2E should be 0x85 (STA)",           rp2a03_program->startup->bytes[0x2E] == 0x85);
-    flut_expect_compat("Startup routine at 0x2F should be 0x06 ($06)",           rp2a03_program->startup->bytes[0x2F] == 0x06);
-    flut_expect_compat("Startup routine at 0x30 should be 0xA2 (LDX)",           rp2a03_program->startup->bytes[0x30] == 0xA2);
-    flut_expect_compat("Startup routine at 0x31 should be 0x00 (#$00)",          rp2a03_program->startup->bytes[0x31] == 0x00);
-    flut_expect_compat("Startup routine at 0x32 should be 0x86 (STX)",           rp2a03_program->startup->bytes[0x32] == 0x86);
-    flut_expect_compat("Startup routine at 0x33 should be 0x07 ($07)",           rp2a03_program->startup->bytes[0x33] == 0x07);
-    // Allocate parr[2] = { a: 3 }
-    flut_expect_compat("Startup routine at 0x34 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x34] == 0xA9);
-    flut_expect_compat("Startup routine at 0x35 should be 0x03 (#$03)",          rp2a03_program->startup->bytes[0x35] == 0x03);
-    flut_expect_compat("Startup routine at 0x36 should be 0x85 (STA)",           rp2a03_program->startup->bytes[0x36] == 0x85);
-    flut_expect_compat("Startup routine at 0x37 should be 0x08 ($08)",           rp2a03_program->startup->bytes[0x37] == 0x08);
-    flut_expect_compat("Startup routine at 0x38 should be 0xA2 (LDX)",           rp2a03_program->startup->bytes[0x38] == 0xA2);
-    flut_expect_compat("Startup routine at 0x39 should be 0x00 (#$00)",          rp2a03_program->startup->bytes[0x39] == 0x00);
-    flut_expect_compat("Startup routine at 0x3A should be 0x86 (STX)",           rp2a03_program->startup->bytes[0x3A] == 0x86);
-    flut_expect_compat("Startup routine at 0x3B should be 0x09 ($09)",           rp2a03_program->startup->bytes[0x3B] == 0x09);
-    // Allocate parr[3] = { a: 0x1FF }
-    flut_expect_compat("Startup routine at 0x3C should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x3C] == 0xA9);
-    flut_expect_compat("Startup routine at 0x3D should be 0xFF (#$FF)",          rp2a03_program->startup->bytes[0x3D] == 0xFF);
-    flut_expect_compat("Startup routine at 0x3E should be 0x85 (STA)",           rp2a03_program->startup->bytes[0x3E] == 0x85);
-    flut_expect_compat("Startup routine at 0x3F should be 0x0A ($0A)",           rp2a03_program->startup->bytes[0x3F] == 0x0A);
-    flut_expect_compat("Startup routine at 0x40 should be 0xA2 (LDX)",           rp2a03_program->startup->bytes[0x40] == 0xA2);
-    flut_expect_compat("Startup routine at 0x41 should be 0x01 (#$01)",          rp2a03_program->startup->bytes[0x41] == 0x01);
-    flut_expect_compat("Startup routine at 0x42 should be 0x86 (STX)",           rp2a03_program->startup->bytes[0x42] == 0x86);
-    flut_expect_compat("Startup routine at 0x43 should be 0x0B ($0B)",           rp2a03_program->startup->bytes[0x43] == 0x0B);
-
-    // ZP allocation of boolean
-    // Allocate b1 = true
-    flut_expect_compat("Startup routine at 0x44 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x44] == 0xA9);
-    flut_expect_compat("Startup routine at 0x45 should be 0x01 (#$01)",          rp2a03_program->startup->bytes[0x45] == 0x01);
-    flut_expect_compat("Startup routine at 0x46 should be 0x85 (STA)",           rp2a03_program->startup->bytes[0x46] == 0x85);
-    flut_expect_compat("Startup routine at 0x47 should be 0x0C ($0C)",           rp2a03_program->startup->bytes[0x47] == 0x0C);
-    // Allocate b2 = false
-    flut_expect_compat("Startup routine at 0x48 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x48] == 0xA9);
-    flut_expect_compat("Startup routine at 0x49 should be 0x00 (#$00)",          rp2a03_program->startup->bytes[0x49] == 0x00);
-    flut_expect_compat("Startup routine at 0x4A should be 0x85 (STA)",           rp2a03_program->startup->bytes[0x4A] == 0x85);
-    flut_expect_compat("Startup routine at 0x4B should be 0x0D ($0D)",           rp2a03_program->startup->bytes[0x4B] == 0x0D);
+    flut_expect_compat("Startup routine at 0x1F should be 0x01 ($01)",           rp2a03_program->startup->bytes[0x1F] == 0x01);
+
+    // The struct, array, and bool initializers only store constants, so the stores are grouped by value
+    // p1.y = 2 and parr[1].a = 2 (lo)
+    flut_expect_compat("Startup routine at 0x20 should be 0xA9 (LDA)",            rp2a03_program->startup->bytes[0x20] == 0xA9);
+    flut_expect_compat("Startup routine at 0x21 should be 0x02 (#$02)",           rp2a03_program->startup->bytes[0x21] == 0x02);
+    flut_expect_compat("Startup routine at 0x22 should be 0x85 (STA)",            rp2a03_program->startup->bytes[0x22] == 0x85);
+    flut_expect_compat("Startup routine at 0x23 should be 0x03 ($03)",            rp2a03_program->startup->bytes[0x23] == 0x03);
+    flut_expect_compat("Startup routine at 0x24 should be 0x85 (STA)",            rp2a03_program->startup->bytes[0x24] == 0x85);
+    flut_expect_compat("Startup routine at 0x25 should be 0x06 ($06)",            rp2a03_program->startup->bytes[0x25] == 0x06);
+    // The high bytes of parr[0..2].a are 0
+    flut_expect_compat("Startup routine at 0x26 should be 0xA2 (LDX)",            rp2a03_program->startup->bytes[0x26] == 0xA2);
+    flut_expect_compat("Startup routine at 0x27 should be 0x00 (#$00)",           rp2a03_program->startup->bytes[0x27] == 0x00);
+    flut_expect_compat("Startup routine at 0x28 should be 0x86 (STX)",            rp2a03_program->startup->bytes[0x28] == 0x86);
+    flut_expect_compat("Startup routine at 0x29 should be 0x05 ($05)",            rp2a03_program->startup->bytes[0x29] == 0x05);
+    flut_expect_compat("Startup routine at 0x2A should be 0x86 (STX)",            rp2a03_program->startup->bytes[0x2A] == 0x86);
+    flut_expect_compat("Startup routine at 0x2B should be 0x07 ($07)",            rp2a03_program->startup->bytes[0x2B] == 0x07);
+    flut_expect_compat("Startup routine at 0x2C should be 0x86 (STX)",            rp2a03_program->startup->bytes[0x2C] == 0x86);
+    flut_expect_compat("Startup routine at 0x2D should be 0x09 ($09)",            rp2a03_program->startup->bytes[0x2D] == 0x09);
+    // parr[2].a = 3 (lo)
+    flut_expect_compat("Startup routine at 0x2E should be 0xA9 (LDA)",            rp2a03_program->startup->bytes[0x2E] == 0xA9);
+    flut_expect_compat("Startup routine at 0x2F should be 0x03 (#$03)",           rp2a03_program->startup->bytes[0x2F] == 0x03);
+    flut_expect_compat("Startup routine at 0x30 should be 0x85 (STA)",            rp2a03_program->startup->bytes[0x30] == 0x85);
+    flut_expect_compat("Startup routine at 0x31 should be 0x08 ($08)",            rp2a03_program->startup->bytes[0x31] == 0x08);
+    // parr[3].a = 0x1FF (lo)
+    flut_expect_compat("Startup routine at 0x32 should be 0xA9 (LDA)",            rp2a03_program->startup->bytes[0x32] == 0xA9);
+    flut_expect_compat("Startup routine at 0x33 should be 0xFF (#$FF)",           rp2a03_program->startup->bytes[0x33] == 0xFF);
+    flut_expect_compat("Startup routine at 0x34 should be 0x85 (STA)",            rp2a03_program->startup->bytes[0x34] == 0x85);
+    flut_expect_compat("Startup routine at 0x35 should be 0x0A ($0A)",            rp2a03_program->startup->bytes[0x35] == 0x0A);
+    // p1.x = 1, parr[0].a = 1 (lo), parr[3].a = 0x1FF (hi), and b1 = true share the last load
+    flut_expect_compat("Startup routine at 0x36 should be 0xA9 (LDA)",            rp2a03_program->startup->bytes[0x36] == 0xA9);
+    flut_expect_compat("Startup routine at 0x37 should be 0x01 (#$01)",           rp2a03_program->startup->bytes[0x37] == 0x01);
+    flut_expect_compat("Startup routine at 0x38 should be 0x85 (STA)",            rp2a03_program->startup->bytes[0x38] == 0x85);
+    flut_expect_compat("Startup routine at 0x39 should be 0x02 ($02)",            rp2a03_program->startup->bytes[0x39] == 0x02);
+    flut_expect_compat("Startup routine at 0x3A should be 0x85 (STA)",            rp2a03_program->startup->bytes[0x3A] == 0x85);
+    flut_expect_compat("Startup routine at 0x3B should be 0x04 ($04)",            rp2a03_program->startup->bytes[0x3B] == 0x04);
+    flut_expect_compat("Startup routine at 0x3C should be 0x85 (STA)",            rp2a03_program->startup->bytes[0x3C] == 0x85);
+    flut_expect_compat("Startup routine at 0x3D should be 0x0B ($0B)",            rp2a03_program->startup->bytes[0x3D] == 0x0B);
+    flut_expect_compat("Startup routine at 0x3E should be 0x85 (STA)",            rp2a03_program->startup->bytes[0x3E] == 0x85);
+    flut_expect_compat("Startup routine at 0x3F should be 0x0C ($0C)",            rp2a03_program->startup->bytes[0x3F] == 0x0C);
+    flut_expect_compat("Startup routine should be 64 bytes long",                 rp2a03_program->startup->pc == 0x40);
 
     rp2a03_program_free(rp2a03_program);
     znes_context_free(znes_context);
@@ -358,11 +346,12 @@ void zenit_test_nes_global_vars_data(void)
     flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
     
     ZirProgram *zir_program = zenit_generate_zir(&ctx);
+    zir_forward_temporaries(zir_program);
     
     ZnesContext *znes_context = znes_context_new(false);
     flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
 
-    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program);
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
 
     // datavar = 1
     flut_expect_compat("Data segment at 0x00 should be 0x01 (datavar)",    rp2a03_program->data->bytes[0x00] == 0x01);
@@ -441,131 +430,253 @@ void zenit_test_nes_global_vars_code(void)
     flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
     
     ZirProgram *zir_program = zenit_generate_zir(&ctx);
+    zir_forward_temporaries(zir_program);
     
     ZnesContext *znes_context = znes_context_new(false);
     flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
 
-    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program);
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
 
     flut_expect_compat("Data segment at 0x00 should be 0x00 (datavar -bss-)",    rp2a03_program->data->bytes[0x00] == 0x00);
     flut_expect_compat("Data segment at 0x01 should be 0x00 (tempvar -bss-)",    rp2a03_program->data->bytes[0x01] == 0x00);
     
-    // codevar = 1
+    // b2 = false is part of the BSS, it is cleared before any other initialization
     flut_expect_compat("Startup routine at 0x00 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x00] == 0xA9);
-    flut_expect_compat("Startup routine at 0x01 should be 0x00 (#$01)",          rp2a03_program->startup->bytes[0x01] == 0x01);
+    flut_expect_compat("Startup routine at 0x01 should be 0x00 (#$00)",          rp2a03_program->startup->bytes[0x01] == 0x00);
     flut_expect_compat("Startup routine at 0x02 should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x02] == 0x8D);
-    flut_expect_compat("Startup routine at 0x03 should be 0x00 ($2000 lo)",      rp2a03_program->startup->bytes[0x03] == 0x00);
-    flut_expect_compat("Startup routine at 0x04 should be 0x20 ($2000 hi)",      rp2a03_program->startup->bytes[0x04] == 0x20);
+    flut_expect_compat("Startup routine at 0x03 should be 0x0D ($200D lo)",      rp2a03_program->startup->bytes[0x03] == 0x0D);
+    flut_expect_compat("Startup routine at 0x04 should be 0x20 ($200D hi)",      rp2a03_program->startup->bytes[0x04] == 0x20);
+
+    // codevar = 1
+    flut_expect_compat("Startup routine at 0x05 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x05] == 0xA9);
+    flut_expect_compat("Startup routine at 0x06 should be 0x00 (#$01)",          rp2a03_program->startup->bytes[0x06] == 0x01);
+    flut_expect_compat("Startup routine at 0x07 should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x07] == 0x8D);
+    flut_expect_compat("Startup routine at 0x08 should be 0x00 ($2000 lo)",      rp2a03_program->startup->bytes[0x08] == 0x00);
+    flut_expect_compat("Startup routine at 0x09 should be 0x20 ($2000 hi)",      rp2a03_program->startup->bytes[0x09] == 0x20);
 
     // datavar = codevar
-    flut_expect_compat("Startup routine at 0x05 should be 0xAD (LDA)",           rp2a03_program->startup->bytes[0x05] == 0xAD);
-    flut_expect_compat("Startup routine at 0x06 should be 0x00 ($2000 lo)",      rp2a03_program->startup->bytes[0x06] == 0x00);
-    flut_expect_compat("Startup routine at 0x07 should be 0x80 ($2000 hi)",      rp2a03_program->startup->bytes[0x07] == 0x20);
-    flut_expect_compat("Startup routine at 0x08 should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x08] == 0x8D);
-    flut_expect_compat("Startup routine at 0x09 should be 0x00 ($8000 lo)",      rp2a03_program->startup->bytes[0x09] == 0x00);
-    flut_expect_compat("Startup routine at 0x0A should be 0x80 ($8000 hi)",      rp2a03_program->startup->bytes[0x0A] == 0x80);
+    flut_expect_compat("Startup routine at 0x0A should be 0xAD (LDA)",           rp2a03_program->startup->bytes[0x0A] == 0xAD);
+    flut_expect_compat("Startup routine at 0x0B should be 0x00 ($2000 lo)",      rp2a03_program->startup->bytes[0x0B] == 0x00);
+    flut_expect_compat("Startup routine at 0x0C should be 0x80 ($2000 hi)",      rp2a03_program->startup->bytes[0x0C] == 0x20);
+    flut_expect_compat("Startup routine at 0x0D should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x0D] == 0x8D);
+    flut_expect_compat("Startup routine at 0x0E should be 0x00 ($8000 lo)",      rp2a03_program->startup->bytes[0x0E] == 0x00);
+    flut_expect_compat("Startup routine at 0x0F should be 0x80 ($8000 hi)",      rp2a03_program->startup->bytes[0x0F] == 0x80);
 
     // zpvar = codevar
-    flut_expect_compat("Startup routine at 0x0B should be 0xAD (LDA)",           rp2a03_program->startup->bytes[0x0B] == 0xAD);
-    flut_expect_compat("Startup routine at 0x0C should be 0x00 ($2000 lo)",      rp2a03_program->startup->bytes[0x0C] == 0x00);
-    flut_expect_compat("Startup routine at 0x0D should be 0x20 ($2000 hi)",      rp2a03_program->startup->bytes[0x0D] == 0x20);
-    flut_expect_compat("Startup routine at 0x0E should be 0x85 (STA)",           rp2a03_program->startup->bytes[0x0E] == 0x85);
-    flut_expect_compat("Startup routine at 0x0F should be 0x00 ($00)",           rp2a03_program->startup->bytes[0x0F] == 0x00);
-
-    // tempvar = cast(codevar : uint16)
     flut_expect_compat("Startup routine at 0x10 should be 0xAD (LDA)",           rp2a03_program->startup->bytes[0x10] == 0xAD);
     flut_expect_compat("Startup routine at 0x11 should be 0x00 ($2000 lo)",      rp2a03_program->startup->bytes[0x11] == 0x00);
     flut_expect_compat("Startup routine at 0x12 should be 0x20 ($2000 hi)",      rp2a03_program->startup->bytes[0x12] == 0x20);
-    flut_expect_compat("Startup routine at 0x13 should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x13] == 0x8D);
-    flut_expect_compat("Startup routine at 0x14 should be 0x01 ($8001 lo)",      rp2a03_program->startup->bytes[0x14] == 0x01);
-    flut_expect_compat("Startup routine at 0x15 should be 0x80 ($8001 hi)",      rp2a03_program->startup->bytes[0x15] == 0x80);
-    flut_expect_compat("Startup routine at 0x16 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x16] == 0xA9);
-    flut_expect_compat("Startup routine at 0x17 should be 0x00 (#$00)",          rp2a03_program->startup->bytes[0x17] == 0x00);
+    flut_expect_compat("Startup routine at 0x13 should be 0x85 (STA)",           rp2a03_program->startup->bytes[0x13] == 0x85);
+    flut_expect_compat("Startup routine at 0x14 should be 0x00 ($00)",           rp2a03_program->startup->bytes[0x14] == 0x00);
+
+    // tempvar = cast(codevar : uint16)
+    flut_expect_compat("Startup routine at 0x15 should be 0xAD (LDA)",           rp2a03_program->startup->bytes[0x15] == 0xAD);
+    flut_expect_compat("Startup routine at 0x16 should be 0x00 ($2000 lo)",      rp2a03_program->startup->bytes[0x16] == 0x00);
+    flut_expect_compat("Startup routine at 0x17 should be 0x20 ($2000 hi)",      rp2a03_program->startup->bytes[0x17] == 0x20);
     flut_expect_compat("Startup routine at 0x18 should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x18] == 0x8D);
-    flut_expect_compat("Startup routine at 0x19 should be 0x02 ($8002 lo)",      rp2a03_program->startup->bytes[0x19] == 0x02);
-    flut_expect_compat("Startup routine at 0x1A should be 0x80 ($8002 hi)",      rp2a03_program->startup->bytes[0x1A] == 0x80);
+    flut_expect_compat("Startup routine at 0x19 should be 0x01 ($8001 lo)",      rp2a03_program->startup->bytes[0x19] == 0x01);
+    flut_expect_compat("Startup routine at 0x1A should be 0x80 ($8001 hi)",      rp2a03_program->startup->bytes[0x1A] == 0x80);
+    flut_expect_compat("Startup routine at 0x1B should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x1B] == 0xA9);
+    flut_expect_compat("Startup routine at 0x1C should be 0x00 (#$00)",          rp2a03_program->startup->bytes[0x1C] == 0x00);
+    flut_expect_compat("Startup routine at 0x1D should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x1D] == 0x8D);
+    flut_expect_compat("Startup routine at 0x1E should be 0x02 ($8002 lo)",      rp2a03_program->startup->bytes[0x1E] == 0x02);
+    flut_expect_compat("Startup routine at 0x1F should be 0x80 ($8002 hi)",      rp2a03_program->startup->bytes[0x1F] == 0x80);
 
     // codevar2 = codevar
-    flut_expect_compat("Startup routine at 0x1B should be 0xAD (LDA)",           rp2a03_program->startup->bytes[0x1B] == 0xAD);
-    flut_expect_compat("Startup routine at 0x1C should be 0x00 ($2000 lo)",      rp2a03_program->startup->bytes[0x1C] == 0x00);
-    flut_expect_compat("Startup routine at 0x1D should be 0x80 ($2000 hi)",      rp2a03_program->startup->bytes[0x1D] == 0x20);
-    flut_expect_compat("Startup routine at 0x1E should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x1E] == 0x8D);
-    flut_expect_compat("Startup routine at 0x1F should be 0x01 ($2001 lo)",      rp2a03_program->startup->bytes[0x1F] == 0x01);
-    flut_expect_compat("Startup routine at 0x20 should be 0x20 ($2001 hi)",      rp2a03_program->startup->bytes[0x20] == 0x20);
+    flut_expect_compat("Startup routine at 0x20 should be 0xAD (LDA)",            rp2a03_program->startup->bytes[0x20] == 0xAD);
+    flut_expect_compat("Startup routine at 0x21 should be 0x00 ($2000 lo)",       rp2a03_program->startup->bytes[0x21] == 0x00);
+    flut_expect_compat("Startup routine at 0x22 should be 0x80 ($2000 hi)",       rp2a03_program->startup->bytes[0x22] == 0x20);
+    flut_expect_compat("Startup routine at 0x23 should be 0x8D (STA)",            rp2a03_program->startup->bytes[0x23] == 0x8D);
+    flut_expect_compat("Startup routine at 0x24 should be 0x01 ($2001 lo)",       rp2a03_program->startup->bytes[0x24] == 0x01);
+    flut_expect_compat("Startup routine at 0x25 should be 0x20 ($2001 hi)",       rp2a03_program->startup->bytes[0x25] == 0x20);
 
     // CODE allocation of structs
     // Allocate x = 1
-    flut_expect_compat("Startup routine at 0x21 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x21] == 0xA9);
-    flut_expect_compat("Startup routine at 0x22 should be 0x01 (#$01)",          rp2a03_program->startup->bytes[0x22] == 0x01);
-    flut_expect_compat("Startup routine at 0x23 should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x23] == 0x8D);
-    flut_expect_compat("Startup routine at 0x24 should be 0x02 ($2002 lo)",      rp2a03_program->startup->bytes[0x24] == 0x02);
-    flut_expect_compat("Startup routine at 0x25 should be 0x20 ($2002 hi)",      rp2a03_program->startup->bytes[0x25] == 0x20);
+    flut_expect_compat("Startup routine at 0x26 should be 0xA9 (LDA)",            rp2a03_program->startup->bytes[0x26] == 0xA9);
+    flut_expect_compat("Startup routine at 0x27 should be 0x01 (#$01)",           rp2a03_program->startup->bytes[0x27] == 0x01);
+    flut_expect_compat("Startup routine at 0x28 should be 0x8D (STA)",            rp2a03_program->startup->bytes[0x28] == 0x8D);
+    flut_expect_compat("Startup routine at 0x29 should be 0x02 ($2002 lo)",       rp2a03_program->startup->bytes[0x29] == 0x02);
+    flut_expect_compat("Startup routine at 0x2A should be 0x20 ($2002 hi)",       rp2a03_program->startup->bytes[0x2A] == 0x20);
     // Allocate y = 2
-    flut_expect_compat("Startup routine at 0x26 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x26] == 0xA9);
-    flut_expect_compat("Startup routine at 0x27 should be 0x02 (#$02)",          rp2a03_program->startup->bytes[0x27] == 0x02);
-    flut_expect_compat("Startup routine at 0x28 should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x28] == 0x8D);
-    flut_expect_compat("Startup routine at 0x29 should be 0x03 ($2003 lo)",      rp2a03_program->startup->bytes[0x29] == 0x03);
-    flut_expect_compat("Startup routine at 0x2A should be 0x20 ($2003 hi)",      rp2a03_program->startup->bytes[0x2A] == 0x20);
+    flut_expect_compat("Startup routine at 0x2B should be 0xA9 (LDA)",            rp2a03_program->startup->bytes[0x2B] == 0xA9);
+    flut_expect_compat("Startup routine at 0x2C should be 0x02 (#$02)",           rp2a03_program->startup->bytes[0x2C] == 0x02);
+    flut_expect_compat("Startup routine at 0x2D should be 0x8D (STA)",            rp2a03_program->startup->bytes[0x2D] == 0x8D);
+    flut_expect_compat("Startup routine at 0x2E should be 0x03 ($2003 lo)",       rp2a03_program->startup->bytes[0x2E] == 0x03);
+    flut_expect_compat("Startup routine at 0x2F should be 0x20 ($2003 hi)",       rp2a03_program->startup->bytes[0x2F] == 0x20);
 
     // CODE allocation of array of structs
-    // Allocate parr[0] = { a: 1 }
-    flut_expect_compat("Startup routine at 0x2B should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x2B] == 0xA9);
-    flut_expect_compat("Startup routine at 0x2C should be 0x01 (#$01)",          rp2a03_program->startup->bytes[0x2C] == 0x01);
-    flut_expect_compat("Startup routine at 0x2D should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x2D] == 0x8D);
-    flut_expect_compat("Startup routine at 0x2E should be 0x04 ($2004 lo)",      rp2a03_program->startup->bytes[0x2E] == 0x04);
-    flut_expect_compat("Startup routine at 0x2F should be 0x20 ($2004 hi)",      rp2a03_program->startup->bytes[0x2F] == 0x20);
-    flut_expect_compat("Startup routine at 0x30 should be 0xA2 (LDX)",           rp2a03_program->startup->bytes[0x30] == 0xA2);
-    flut_expect_compat("Startup routine at 0x31 should be 0x00 (#$00)",          rp2a03_program->startup->bytes[0x31] == 0x00);
-    flut_expect_compat("Startup routine at 0x32 should be 0x8E (STX)",           rp2a03_program->startup->bytes[0x32] == 0x8E);
-    flut_expect_compat("Startup routine at 0x33 should be 0x05 ($2005 lo)",      rp2a03_program->startup->bytes[0x33] == 0x05);
-    flut_expect_compat("Startup routine at 0x34 should be 0x20 ($2005 hi)",      rp2a03_program->startup->bytes[0x34] == 0x20);
-    // Allocate parr[1] = { a: 2 }
-    flut_expect_compat("Startup routine at 0x35 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x35] == 0xA9);
-    flut_expect_compat("Startup routine at 0x36 should be 0x02 (#$02)",          rp2a03_program->startup->bytes[0x36] == 0x02);
-    flut_expect_compat("Startup routine at 0x37 should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x37] == 0x8D);
-    flut_expect_compat("Startup routine at 0x38 should be 0x06 ($2006 lo)",      rp2a03_program->startup->bytes[0x38] == 0x06);
-    flut_expect_compat("Startup routine at 0x39 should be 0x20 ($2006 hi)",      rp2a03_program->startup->bytes[0x39] == 0x20);
-    flut_expect_compat("Startup routine at 0x3A should be 0xA2 (LDX)",           rp2a03_program->startup->bytes[0x3A] == 0xA2);
-    flut_expect_compat("Startup routine at 0x3B should be 0x00 (#$00)",          rp2a03_program->startup->bytes[0x3B] == 0x00);
-    flut_expect_compat("Startup routine at 0x3C should be 0x8E (STX)",           rp2a03_program->startup->bytes[0x3C] == 0x8E);
-    flut_expect_compat("Startup routine at 0x3D should be 0x07 ($2007 lo)",      rp2a03_program->startup->bytes[0x3D] == 0x07);
-    flut_expect_compat("Startup routine at 0x3E should be 0x20 ($2007 hi)",      rp2a03_program->startup->bytes[0x3E] == 0x20);
-    // Allocate parr[2] = { a: 3 }
-    flut_expect_compat("Startup routine at 0x3F should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x3F] == 0xA9);
-    flut_expect_compat("Startup routine at 0x40 should be 0x03 (#$03)",          rp2a03_program->startup->bytes[0x40] == 0x03);
-    flut_expect_compat("Startup routine at 0x41 should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x41] == 0x8D);
-    flut_expect_compat("Startup routine at 0x42 should be 0x08 ($2008 lo)",      rp2a03_program->startup->bytes[0x42] == 0x08);
-    flut_expect_compat("Startup routine at 0x43 should be 0x20 ($2008 hi)",      rp2a03_program->startup->bytes[0x43] == 0x20);
-    flut_expect_compat("Startup routine at 0x44 should be 0xA2 (LDX)",           rp2a03_program->startup->bytes[0x44] == 0xA2);
-    flut_expect_compat("Startup routine at 0x45 should be 0x00 (#$00)",          rp2a03_program->startup->bytes[0x45] == 0x00);
-    flut_expect_compat("Startup routine at 0x46 should be 0x8E (STX)",           rp2a03_program->startup->bytes[0x46] == 0x8E);
-    flut_expect_compat("Startup routine at 0x47 should be 0x09 ($2009 lo)",      rp2a03_program->startup->bytes[0x47] == 0x09);
-    flut_expect_compat("Startup routine at 0x48 should be 0x20 ($2009 hi)",      rp2a03_program->startup->bytes[0x48] == 0x20);
-    // Allocate parr[3] = { a: 0x1FF }
-    flut_expect_compat("Startup routine at 0x49 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x49] == 0xA9);
-    flut_expect_compat("Startup routine at 0x4A should be 0xFF (#$FF)",          rp2a03_program->startup->bytes[0x4A] == 0xFF);
-    flut_expect_compat("Startup routine at 0x4B should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x4B] == 0x8D);
-    flut_expect_compat("Startup routine at 0x4C should be 0x0A ($200A lo)",      rp2a03_program->startup->bytes[0x4C] == 0x0A);
-    flut_expect_compat("Startup routine at 0x4D should be 0x20 ($200A hi)",      rp2a03_program->startup->bytes[0x4D] == 0x20);
-    flut_expect_compat("Startup routine at 0x4E should be 0xA2 (LDX)",           rp2a03_program->startup->bytes[0x4E] == 0xA2);
-    flut_expect_compat("Startup routine at 0x4F should be 0x01 (#$01)",          rp2a03_program->startup->bytes[0x4F] == 0x01);
-    flut_expect_compat("Startup routine at 0x50 should be 0x8E (STX)",           rp2a03_program->startup->bytes[0x50] == 0x8E);
-    flut_expect_compat("Startup routine at 0x51 should be 0x0B ($200B lo)",      rp2a03_program->startup->bytes[0x51] == 0x0B);
-    flut_expect_compat("Startup routine at 0x52 should be 0x20 ($200B hi)",      rp2a03_program->startup->bytes[0x52] == 0x20);
+    // parr = [ { a: 1 }, { a: 2 }, { a: 3 }, { a: 0x1FF } ] is copied from a table in the DATA segment
+    flut_expect_compat("Data segment at 0x05 should be 0x01 (parr table [0] lo)",  rp2a03_program->data->bytes[0x05] == 0x01);
+    flut_expect_compat("Data segment at 0x06 should be 0x00 (parr table [0] hi)",  rp2a03_program->data->bytes[0x06] == 0x00);
+    flut_expect_compat("Data segment at 0x07 should be 0x02 (parr table [1] lo)",  rp2a03_program->data->bytes[0x07] == 0x02);
+    flut_expect_compat("Data segment at 0x08 should be 0x00 (parr table [1] hi)",  rp2a03_program->data->bytes[0x08] == 0x00);
+    flut_expect_compat("Data segment at 0x09 should be 0x03 (parr table [2] lo)",  rp2a03_program->data->bytes[0x09] == 0x03);
+    flut_expect_compat("Data segment at 0x0A should be 0x00 (parr table [2] hi)",  rp2a03_program->data->bytes[0x0A] == 0x00);
+    flut_expect_compat("Data segment at 0x0B should be 0xFF (parr table [3] lo)",  rp2a03_program->data->bytes[0x0B] == 0xFF);
+    flut_expect_compat("Data segment at 0x0C should be 0x01 (parr table [3] hi)",  rp2a03_program->data->bytes[0x0C] == 0x01);
+    flut_expect_compat("Startup routine at 0x30 should be 0xA2 (LDX)",            rp2a03_program->startup->bytes[0x30] == 0xA2);
+    flut_expect_compat("Startup routine at 0x31 should be 0x08 (#$08)",           rp2a03_program->startup->bytes[0x31] == 0x08);
+    flut_expect_compat("Startup routine at 0x32 should be 0xBD (LDA abs,X)",      rp2a03_program->startup->bytes[0x32] == 0xBD);
+    flut_expect_compat("Startup routine at 0x33 should be 0x04 ($8004 lo)",       rp2a03_program->startup->bytes[0x33] == 0x04);
+    flut_expect_compat("Startup routine at 0x34 should be 0x80 ($8004 hi)",       rp2a03_program->startup->bytes[0x34] == 0x80);
+    flut_expect_compat("Startup routine at 0x35 should be 0x9D (STA abs,X)",      rp2a03_program->startup->bytes[0x35] == 0x9D);
+    flut_expect_compat("Startup routine at 0x36 should be 0x03 ($2003 lo)",       rp2a03_program->startup->bytes[0x36] == 0x03);
+    flut_expect_compat("Startup routine at 0x37 should be 0x20 ($2003 hi)",       rp2a03_program->startup->bytes[0x37] == 0x20);
+    flut_expect_compat("Startup routine at 0x38 should be 0xCA (DEX)",            rp2a03_program->startup->bytes[0x38] == 0xCA);
+    flut_expect_compat("Startup routine at 0x39 should be 0xD0 (BNE)",            rp2a03_program->startup->bytes[0x39] == 0xD0);
+    flut_expect_compat("Startup routine at 0x3A should be 0xF7 (-9)",             rp2a03_program->startup->bytes[0x3A] == 0xF7);
 
     // CODE allocation of boolean
     // Allocate b1 = true
-    flut_expect_compat("Startup routine at 0x53 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x53] == 0xA9);
-    flut_expect_compat("Startup routine at 0x54 should be 0x01 (#$01)",          rp2a03_program->startup->bytes[0x54] == 0x01);
-    flut_expect_compat("Startup routine at 0x55 should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x55] == 0x8D);
-    flut_expect_compat("Startup routine at 0x56 should be 0x0C ($200C lo)",      rp2a03_program->startup->bytes[0x56] == 0x0C);
-    flut_expect_compat("Startup routine at 0x57 should be 0x20 ($200C hi)",      rp2a03_program->startup->bytes[0x57] == 0x20);
-    // Allocate b2 = false
-    flut_expect_compat("Startup routine at 0x58 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x58] == 0xA9);
-    flut_expect_compat("Startup routine at 0x59 should be 0x00 (#$00)",          rp2a03_program->startup->bytes[0x59] == 0x00);
-    flut_expect_compat("Startup routine at 0x5A should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x5A] == 0x8D);
-    flut_expect_compat("Startup routine at 0x5B should be 0x0D ($200D lo)",      rp2a03_program->startup->bytes[0x5B] == 0x0D);
-    flut_expect_compat("Startup routine at 0x5C should be 0x20 ($200D hi)",      rp2a03_program->startup->bytes[0x5C] == 0x20);
+    flut_expect_compat("Startup routine at 0x3B should be 0xA9 (LDA)",            rp2a03_program->startup->bytes[0x3B] == 0xA9);
+    flut_expect_compat("Startup routine at 0x3C should be 0x01 (#$01)",           rp2a03_program->startup->bytes[0x3C] == 0x01);
+    flut_expect_compat("Startup routine at 0x3D should be 0x8D (STA)",            rp2a03_program->startup->bytes[0x3D] == 0x8D);
+    flut_expect_compat("Startup routine at 0x3E should be 0x0C ($200C lo)",       rp2a03_program->startup->bytes[0x3E] == 0x0C);
+    flut_expect_compat("Startup routine at 0x3F should be 0x20 ($200C hi)",       rp2a03_program->startup->bytes[0x3F] == 0x20);
+
+    rp2a03_program_free(rp2a03_program);
+    znes_context_free(znes_context);
+    zir_program_free(zir_program);
+    zenit_context_free(&ctx);
+}
+
+void zenit_test_nes_global_vars_code_tables(void)
+{
+    const char *zenit_source = 
+        // Run of the same value: fill loop
+        "#[NES(address: 0x300)]"                                        "\n"
+        "var run = [ 7, 7, 7, 7, 7, 7, 7, 7 ];"                         "\n"
+
+        // Small aggregate: unrolled stores are smaller than the loop
+        "#[NES(address: 0x308)]"                                        "\n"
+        "var small = [ 1, 2 ];"                                         "\n"
+    ;
+
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+    
+    ZirProgram *zir_program = zenit_generate_zir(&ctx);
+    
+    ZnesContext *znes_context = znes_context_new(false);
+    flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
+
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
+
+    // run = [ 7, 7, 7, 7, 7, 7, 7, 7 ]
+    flut_expect_compat("Startup routine at 0x00 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x00] == 0xA9);
+    flut_expect_compat("Startup routine at 0x01 should be 0x07 (#$07)",          rp2a03_program->startup->bytes[0x01] == 0x07);
+    flut_expect_compat("Startup routine at 0x02 should be 0xA2 (LDX)",           rp2a03_program->startup->bytes[0x02] == 0xA2);
+    flut_expect_compat("Startup routine at 0x03 should be 0x08 (#$08)",          rp2a03_program->startup->bytes[0x03] == 0x08);
+    flut_expect_compat("Startup routine at 0x04 should be 0x9D (STA abs,X)",     rp2a03_program->startup->bytes[0x04] == 0x9D);
+    flut_expect_compat("Startup routine at 0x05 should be 0xFF ($02FF lo)",      rp2a03_program->startup->bytes[0x05] == 0xFF);
+    flut_expect_compat("Startup routine at 0x06 should be 0x02 ($02FF hi)",      rp2a03_program->startup->bytes[0x06] == 0x02);
+    flut_expect_compat("Startup routine at 0x07 should be 0xCA (DEX)",           rp2a03_program->startup->bytes[0x07] == 0xCA);
+    flut_expect_compat("Startup routine at 0x08 should be 0xD0 (BNE)",           rp2a03_program->startup->bytes[0x08] == 0xD0);
+    flut_expect_compat("Startup routine at 0x09 should be 0xFA (-6)",            rp2a03_program->startup->bytes[0x09] == 0xFA);
+
+    // small = [ 1, 2 ]
+    flut_expect_compat("Startup routine at 0x0A should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x0A] == 0xA9);
+    flut_expect_compat("Startup routine at 0x0B should be 0x01 (#$01)",          rp2a03_program->startup->bytes[0x0B] == 0x01);
+    flut_expect_compat("Startup routine at 0x0C should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x0C] == 0x8D);
+    flut_expect_compat("Startup routine at 0x0D should be 0x08 ($0308 lo)",      rp2a03_program->startup->bytes[0x0D] == 0x08);
+    flut_expect_compat("Startup routine at 0x0E should be 0x03 ($0308 hi)",      rp2a03_program->startup->bytes[0x0E] == 0x03);
+    flut_expect_compat("Startup routine at 0x0F should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x0F] == 0xA9);
+    flut_expect_compat("Startup routine at 0x10 should be 0x02 (#$02)",          rp2a03_program->startup->bytes[0x10] == 0x02);
+    flut_expect_compat("Startup routine at 0x11 should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x11] == 0x8D);
+    flut_expect_compat("Startup routine at 0x12 should be 0x09 ($0309 lo)",      rp2a03_program->startup->bytes[0x12] == 0x09);
+    flut_expect_compat("Startup routine at 0x13 should be 0x03 ($0309 hi)",      rp2a03_program->startup->bytes[0x13] == 0x03);
+    flut_expect_compat("Startup routine must be 20 bytes long",                  rp2a03_program->startup->pc == 0x14);
+
+    rp2a03_program_free(rp2a03_program);
+    znes_context_free(znes_context);
+    zir_program_free(zir_program);
+    zenit_context_free(&ctx);
+}
+
+void zenit_test_nes_global_vars_bss(void)
+{
+    const char *zenit_source = 
+        // Adjacent zero-initialized arrays in RAM are cleared with a single loop
+        "#[NES(address: 0x300)]"                                        "\n"
+        "var buf1 = [ 0, 0, 0, 0, 0, 0, 0, 0 ];"                        "\n"
+        "#[NES(address: 0x308)]"                                        "\n"
+        "var buf2 = [ 0, 0, 0, 0, 0, 0, 0, 0 ];"                        "\n"
+
+        // Non-zero variables keep their initialization
+        "#[NES(address: 0x310)]"                                        "\n"
+        "var one : uint8 = 1;"                                          "\n"
+
+        // ZP zero-initialized array uses the zero page loop
+        "#[NES(address: 0x10)]"                                         "\n"
+        "var zbuf = [ 0, 0, 0, 0, 0, 0 ];"                              "\n"
+
+        // A single byte is cheaper to clear with a store
+        "#[NES(address: 0x20)]"                                         "\n"
+        "var flag = false;"                                             "\n"
+    ;
+
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+    
+    ZirProgram *zir_program = zenit_generate_zir(&ctx);
+    
+    ZnesContext *znes_context = znes_context_new(false);
+    flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
+
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
+
+    // The ranges are cleared sorted by address
+    flut_expect_compat("Startup routine at 0x00 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x00] == 0xA9);
+    flut_expect_compat("Startup routine at 0x01 should be 0x00 (#$00)",          rp2a03_program->startup->bytes[0x01] == 0x00);
+
+    // zbuf = [ 0, 0, 0, 0, 0, 0 ]
+    flut_expect_compat("Startup routine at 0x02 should be 0xA2 (LDX)",           rp2a03_program->startup->bytes[0x02] == 0xA2);
+    flut_expect_compat("Startup routine at 0x03 should be 0x06 (#$06)",          rp2a03_program->startup->bytes[0x03] == 0x06);
+    flut_expect_compat("Startup routine at 0x04 should be 0x95 (STA zp,X)",      rp2a03_program->startup->bytes[0x04] == 0x95);
+    flut_expect_compat("Startup routine at 0x05 should be 0x0F ($0F)",           rp2a03_program->startup->bytes[0x05] == 0x0F);
+    flut_expect_compat("Startup routine at 0x06 should be 0xCA (DEX)",           rp2a03_program->startup->bytes[0x06] == 0xCA);
+    flut_expect_compat("Startup routine at 0x07 should be 0xD0 (BNE)",           rp2a03_program->startup->bytes[0x07] == 0xD0);
+    flut_expect_compat("Startup routine at 0x08 should be 0xFB (-5)",            rp2a03_program->startup->bytes[0x08] == 0xFB);
+
+    // flag = false
+    flut_expect_compat("Startup routine at 0x09 should be 0x85 (STA)",           rp2a03_program->startup->bytes[0x09] == 0x85);
+    flut_expect_compat("Startup routine at 0x0A should be 0x20 ($20)",           rp2a03_program->startup->bytes[0x0A] == 0x20);
+
+    // buf1 and buf2 are coalesced into a 16 bytes range
+    flut_expect_compat("Startup routine at 0x0B should be 0xA2 (LDX)",           rp2a03_program->startup->bytes[0x0B] == 0xA2);
+    flut_expect_compat("Startup routine at 0x0C should be 0x10 (#$10)",          rp2a03_program->startup->bytes[0x0C] == 0x10);
+    flut_expect_compat("Startup routine at 0x0D should be 0x9D (STA abs,X)",     rp2a03_program->startup->bytes[0x0D] == 0x9D);
+    flut_expect_compat("Startup routine at 0x0E should be 0xFF ($02FF lo)",      rp2a03_program->startup->bytes[0x0E] == 0xFF);
+    flut_expect_compat("Startup routine at 0x0F should be 0x02 ($02FF hi)",      rp2a03_program->startup->bytes[0x0F] == 0x02);
+    flut_expect_compat("Startup routine at 0x10 should be 0xCA (DEX)",           rp2a03_program->startup->bytes[0x10] == 0xCA);
+    flut_expect_compat("Startup routine at 0x11 should be 0xD0 (BNE)",           rp2a03_program->startup->bytes[0x11] == 0xD0);
+    flut_expect_compat("Startup routine at 0x12 should be 0xFA (-6)",            rp2a03_program->startup->bytes[0x12] == 0xFA);
+
+    // one = 1
+    flut_expect_compat("Startup routine at 0x13 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x13] == 0xA9);
+    flut_expect_compat("Startup routine at 0x14 should be 0x01 (#$01)",          rp2a03_program->startup->bytes[0x14] == 0x01);
+    flut_expect_compat("Startup routine at 0x15 should be 0x8D (STA)",           rp2a03_program->startup->bytes[0x15] == 0x8D);
+    flut_expect_compat("Startup routine at 0x16 should be 0x10 ($0310 lo)",      rp2a03_program->startup->bytes[0x16] == 0x10);
+    flut_expect_compat("Startup routine at 0x17 should be 0x03 ($0310 hi)",      rp2a03_program->startup->bytes[0x17] == 0x03);
+    flut_expect_compat("Startup routine must be 24 bytes long",                  rp2a03_program->startup->pc == 0x18);
+
+    rp2a03_program_free(rp2a03_program);
+
+    // If the reset routine clears the RAM, the BSS does not need any code
+    znes_context->program->reset_clears_ram = true;
+    rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
+
+    flut_expect_compat("Startup routine at 0x00 should be 0xA9 (LDA)",           rp2a03_program->startup->bytes[0x00] == 0xA9);
+    flut_expect_compat("Startup routine at 0x01 should be 0x01 (#$01)",          rp2a03_program->startup->bytes[0x01] == 0x01);
+    flut_expect_compat("Startup routine must be 5 bytes long",                   rp2a03_program->startup->pc == 0x05);
 
     rp2a03_program_free(rp2a03_program);
     znes_context_free(znes_context);
@@ -598,7 +709,9 @@ void zenit_test_nes_global_var_name_clash(void)
     ZnesContext *znes_context = znes_context_new(false);
     flut_expect_compat("NES IR should not contain errors", znes_generate_program(znes_context, zir_program));
 
-    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program);
+    // The test checks the code of the emitters
+    znes_context->program->peephole_rules = 0;
+    Rp2a03Program *rp2a03_program = rp2a03_generate_program(znes_context->program, NULL);
 
     flut_expect_compat("Data segment at 0x00 should be 0x02 (a)",                rp2a03_program->data->bytes[0x00] == 0x02);
     flut_expect_compat("Data segment at 0x01 should be 0x02 (x)",                rp2a03_program->data->bytes[0x01] == 0x02);
@@ -0,0 +1,257 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <flut/flut.h>
+#include <fllib/threading/Thread.h>
+#include "../../src/driver/driver.h"
+#include "tests.h"
+
+static const char *main_path = "zenit-driver-test-main.zenit";
+static const char *lib_path = "zenit-driver-test-lib.zenit";
+static const char *rom_path = "zenit-driver-test.nes";
+
+static void write_source(const char *path, const char *source, ZenitDriver *driver, size_t unit)
+{
+    FILE *file = fopen(path, "w");
+    fputs(source, file);
+    fclose(file);
+
+    // The files of the test can be written within the resolution of the file system's timestamps
+    if (driver != NULL)
+        driver->units[unit].modified = 0;
+}
+
+static bool rom_exists(void)
+{
+    FILE *file = fopen(rom_path, "rb");
+
+    if (file == NULL)
+        return false;
+
+    fclose(file);
+    remove(rom_path);
+    return true;
+}
+
+void zenit_test_driver_rebuild(void)
+{
+    write_source(main_path, 
+        "extern var color : uint8;"                                 "\n"
+        "#[NES(address: 0xFFFA)] var vectors : [3]uint16 = ["       "\n"
+        "    cast(&color), 0x8000, 0x8000"                          "\n"
+        "];"                                                        "\n",
+        NULL, 0
+    );
+
+    write_source(lib_path, "#[NES(address: 0x00)] var color = 0x20;", NULL, 0);
+
+    ZenitDriverOptions options = zenit_driver_options_default();
+    options.print_errors = false;
+
+    ZenitDriver *driver = zenit_driver_new(options);
+    zenit_driver_add_file(driver, main_path);
+    zenit_driver_add_file(driver, lib_path);
+
+    flut_expect_compat("First build must succeed", zenit_driver_build(driver, rom_path) == ZENIT_DRIVER_OK && rom_exists());
+    flut_expect_compat("First build must compile all the units", driver->units[0].compilations == 1 && driver->units[1].compilations == 1);
+    flut_expect_compat("Refresh must not report changes if the files did not change", !zenit_driver_refresh(driver));
+
+    // The unit with errors is compiled again, the other one is reused
+    write_source(lib_path, "#[NES(address: 0x00)] var color = undefined;", driver, 1);
+
+    flut_expect_compat("Refresh must report the changed file", zenit_driver_refresh(driver) && !driver->units[0].stale && driver->units[1].stale);
+    flut_expect_compat("Build must fail in the front-end", zenit_driver_build(driver, rom_path) == ZENIT_DRIVER_ERROR_FRONT_END && !rom_exists());
+    flut_expect_compat("Only the changed unit must be compiled", driver->units[0].compilations == 1 && driver->units[1].compilations == 2);
+    flut_expect_compat("Failed build must not be retried if the files did not change", !zenit_driver_refresh(driver));
+
+    // Link errors do not need to compile the units again
+    write_source(lib_path, "#[NES(address: 0x00)] var colour = 0x20;", driver, 1);
+
+    flut_expect_compat("Refresh must report the fixed file", zenit_driver_refresh(driver));
+    flut_expect_compat("Build must fail in the link step", zenit_driver_build(driver, rom_path) == ZENIT_DRIVER_ERROR_ZIR && !rom_exists());
+    flut_expect_compat("Link error must be available in the driver", driver->error != NULL && flm_cstring_equals(driver->error, "Undefined external symbol 'color' in 'zenit-driver-test-main.zenit'"));
+    flut_expect_compat("Link errors must not compile the units again", zenit_driver_build(driver, rom_path) == ZENIT_DRIVER_ERROR_ZIR && driver->units[1].compilations == 3);
+
+    write_source(lib_path, "#[NES(address: 0x00)] var color = 0x40;", driver, 1);
+
+    flut_expect_compat("Rebuild must succeed", zenit_driver_refresh(driver) && zenit_driver_build(driver, rom_path) == ZENIT_DRIVER_OK && rom_exists());
+    flut_expect_compat("Rebuild must reuse the unchanged unit", driver->units[0].compilations == 1 && driver->units[1].compilations == 4);
+
+    zenit_driver_free(driver);
+    remove(main_path);
+    remove(lib_path);
+}
+
+void zenit_test_driver_in_memory(void)
+{
+    ZenitDriverOptions options = zenit_driver_options_default();
+    options.print_errors = false;
+
+    ZenitDriver *driver = zenit_driver_new(options);
+
+    zenit_driver_add_source(driver, "vectors", 
+        "extern var table : [3]uint8;"                                  "\n"
+        "#[NES(address: 0xFFFA)] var vectors : [3]uint16 = ["           "\n"
+        "    cast(&table), cast(&table), cast(&table)"                  "\n"
+        "];"                                                            "\n"
+    );
+
+    size_t table = zenit_driver_add_source(driver, "table", "#[NES(address: 0x8000)] var table = [ 1, 2, 3 ];");
+
+    Rp2a03Rom *rom = NULL;
+    flut_expect_compat("In-memory units must compile", zenit_driver_compile(driver, &rom) == ZENIT_DRIVER_OK && rom != NULL);
+    flut_expect_compat("ROM must contain the table", rom != NULL && rom->prg_rom.bank[0] == 1 && rom->prg_rom.bank[2] == 3);
+    flut_expect_compat("ROM must contain the vectors", rom != NULL && rom->prg_rom.nmi_addr == 0x8000 && rom->prg_rom.irq_addr == 0x8000);
+    rp2a03_rom_free(rom);
+
+    flut_expect_compat("File units must not be replaced", !zenit_driver_set_source(driver, 5, "var a = 1;"));
+    flut_expect_compat("Source must be replaced", zenit_driver_set_source(driver, table, "#[NES(address: 0x8000)] var table = [ 4, 5, 6 ];"));
+
+    rom = NULL;
+    flut_expect_compat("Replaced unit must compile", zenit_driver_compile(driver, &rom) == ZENIT_DRIVER_OK && rom != NULL);
+    flut_expect_compat("ROM must contain the new table", rom != NULL && rom->prg_rom.bank[0] == 4 && rom->prg_rom.bank[2] == 6);
+    flut_expect_compat("Only the replaced unit must be compiled again", driver->units[0].compilations == 1 && driver->units[table].compilations == 2);
+    rp2a03_rom_free(rom);
+
+    // The front-end errors use the name of the unit
+    zenit_driver_set_source(driver, table, "var table = [ 1, 2 ] + 1;");
+
+    ZirProgram *program = NULL;
+    flut_expect_compat("Invalid unit must not compile", zenit_driver_compile_zir(driver, &program) == ZENIT_DRIVER_ERROR_FRONT_END && program == NULL);
+
+    ZenitError *errors = zenit_context_get_errors(&driver->units[table].context);
+    flut_expect_compat("Errors must be available in the unit's context", zenit_context_has_errors(&driver->units[table].context) 
+                                                                            && flm_cstring_equals(errors[0].location.filename, "table"));
+
+    zenit_driver_set_source(driver, table, "var table : [3]uint8 = [ 7, 8, 9 ];");
+
+    flut_expect_compat("ZIR program must compile", zenit_driver_compile_zir(driver, &program) == ZENIT_DRIVER_OK && program != NULL);
+
+    char *codegen = zir_program_dump(program);
+    flut_expect_compat("ZIR program must link the units", strncmp(codegen, "@table : [3]uint8 = [ 7, 8, 9 ]\n", strlen("@table : [3]uint8 = [ 7, 8, 9 ]\n")) == 0);
+
+    fl_cstring_free(codegen);
+    zir_program_free(program);
+    zenit_driver_free(driver);
+}
+
+static bool rom_contains(Rp2a03Rom *rom, const uint8_t *bytes, size_t size)
+{
+    for (size_t i=0; i + size <= fl_array_length(rom->prg_banks); i++)
+        if (memcmp(rom->prg_banks + i, bytes, size) == 0)
+            return true;
+
+    return false;
+}
+
+void zenit_test_driver_reset_clears_ram(void)
+{
+    const char *source =
+        "#[NES(address: 0x8000)] var reset = [ 0x4C, 0x00, 0x80 ];"    "\n"
+        "#[NES(address: 0x300)] var buffer = [ 0, 0, 0, 0, 0, 0, 0, 0 ];"   "\n"
+    ;
+
+    // STA $02FF,X; DEX: the loop that clears the buffer
+    const uint8_t clear_loop[] = { 0x9D, 0xFF, 0x02, 0xCA };
+
+    ZenitDriverOptions options = zenit_driver_options_default();
+    options.print_errors = false;
+
+    ZenitDriver *driver = zenit_driver_new(options);
+    zenit_driver_add_source(driver, "main", source);
+
+    Rp2a03Rom *rom = NULL;
+    flut_expect_compat("Source must compile", zenit_driver_compile(driver, &rom) == ZENIT_DRIVER_OK && rom != NULL);
+    flut_expect_compat("Startup routine must clear the buffer", rom != NULL && rom_contains(rom, clear_loop, sizeof(clear_loop)));
+    rp2a03_rom_free(rom);
+
+    driver->options.reset_clears_ram = true;
+
+    rom = NULL;
+    flut_expect_compat("Source must compile", zenit_driver_compile(driver, &rom) == ZENIT_DRIVER_OK && rom != NULL);
+    flut_expect_compat("Startup routine must not clear the buffer if the reset handler clears the RAM", rom != NULL && !rom_contains(rom, clear_loop, sizeof(clear_loop)));
+    rp2a03_rom_free(rom);
+
+    zenit_driver_free(driver);
+}
+
+static const char *parallel_source =
+    "struct Point { x: uint8; y: uint8; }"                                  "\n"
+    "#[NES(address: 0x300)] var table = [ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 ];" "\n"
+    "#[NES(address: 0x310)] var point = Point { x: 4, y: 5 };"              "\n"
+    "#[NES(address: 0x320)] var ref = &table;"                              "\n"
+    "var flag = true;"                                                      "\n"
+    "if (flag) {"                                                           "\n"
+    "   #[NES(address: 0x330)] var value = cast(511 : uint8);"              "\n"
+    "}"                                                                     "\n"
+;
+
+typedef struct ParallelBuild {
+    ZenitDriverStatus status;
+    Rp2a03Rom *rom;
+} ParallelBuild;
+
+static ZenitDriverStatus compile_source(Rp2a03Rom **rom)
+{
+    ZenitDriverOptions options = zenit_driver_options_default();
+    options.print_errors = false;
+
+    ZenitDriver *driver = zenit_driver_new(options);
+    zenit_driver_add_source(driver, "main", parallel_source);
+
+    ZenitDriverStatus status = zenit_driver_compile(driver, rom);
+    zenit_driver_free(driver);
+
+    return status;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI compile_in_thread(LPVOID args)
+#else
+static void* compile_in_thread(void *args)
+#endif
+{
+    ParallelBuild *build = (ParallelBuild*) args;
+    build->status = compile_source(&build->rom);
+
+    return 0;
+}
+
+static bool roms_equal(Rp2a03Rom *rom, Rp2a03Rom *other)
+{
+    if (rom == NULL || other == NULL)
+        return false;
+
+    if (fl_array_length(rom->prg_banks) != fl_array_length(other->prg_banks) || memcmp(rom->prg_banks, other->prg_banks, fl_array_length(rom->prg_banks)) != 0)
+        return false;
+
+    if ((rom->chr_banks == NULL) != (other->chr_banks == NULL))
+        return false;
+
+    return rom->chr_banks == NULL || (fl_array_length(rom->chr_banks) == fl_array_length(other->chr_banks) 
+        && memcmp(rom->chr_banks, other->chr_banks, fl_array_length(rom->chr_banks)) == 0);
+}
+
+void zenit_test_driver_parallel(void)
+{
+    Rp2a03Rom *expected = NULL;
+    flut_expect_compat("Source must compile in a single thread", compile_source(&expected) == ZENIT_DRIVER_OK && expected != NULL);
+
+    // Each thread uses its own driver
+    ParallelBuild builds[2] = { { .status = ZENIT_DRIVER_OK, .rom = NULL }, { .status = ZENIT_DRIVER_OK, .rom = NULL } };
+    FlThread threads[2];
+
+    for (size_t i=0; i < 2; i++)
+        threads[i] = fl_thread_create(&compile_in_thread, builds + i);
+
+    fl_thread_join_all(threads, 2);
+
+    for (size_t i=0; i < 2; i++)
+    {
+        flut_vexpect_compat(builds[i].status == ZENIT_DRIVER_OK && builds[i].rom != NULL, "Source must compile in thread %zu", i);
+        flut_vexpect_compat(roms_equal(builds[i].rom, expected), "The ROM of thread %zu must match the single-threaded build", i);
+        rp2a03_rom_free(builds[i].rom);
+    }
+
+    rp2a03_rom_free(expected);
+}
@@ -0,0 +1,9 @@
+#ifndef ZENIT_TESTS_DRIVER_H
+#define ZENIT_TESTS_DRIVER_H
+
+void zenit_test_driver_rebuild(void);
+void zenit_test_driver_in_memory(void);
+void zenit_test_driver_reset_clears_ram(void);
+void zenit_test_driver_parallel(void);
+
+#endif /* ZENIT_TESTS_DRIVER_H */
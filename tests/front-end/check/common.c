@@ -63,16 +63,13 @@ void zenit_test_check_type_errors(const char *source, struct ExpectedError *case
     flut_vexpect_compat(!run_success && run_errors == error_count, "Type check pass must fail with %zu error(s) (errors: %zu)", error_count, run_errors);
 
     size_t i=0;
-    struct FlListNode *tmp = fl_list_head(ctx.errors);
-    while (tmp != NULL)
+    ZenitError *error = zenit_context_get_errors(&ctx);
+    for (size_t j=0; j < ctx.errors.length; j++, error++)
     {
-        ZenitError *error = (ZenitError*) tmp->value;
-
         flut_vexpect_compat(error->type == cases[i].type, 
             cases[i].message, 
-            error->location.line, error->location.col, error->message);
+            error->location.line, error->location.col, zenit_error_message(error));
 
-        tmp = tmp->next;
         i++;
     }
     
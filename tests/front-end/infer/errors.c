@@ -24,16 +24,13 @@ void zenit_test_infer_errors(void)
     flut_expect_compat("Infer pass must fail with 1 error", !valid_infer && zenit_context_error_count(&ctx) == 1);
 
     size_t i=0;
-    struct FlListNode *tmp = fl_list_head(ctx.errors);
-    while (tmp != NULL)
+    ZenitError *error = zenit_context_get_errors(&ctx);
+    for (size_t j=0; j < ctx.errors.length; j++, error++)
     {
-        ZenitError *error = (ZenitError*) tmp->value;
-
         flut_vexpect_compat(error->type == ZENIT_ERROR_INFERENCE, 
         "The type of the cast expression cannot be inferred because there is no enough context information (<source>:%u:%u): %s", 
-        error->location.line, error->location.col, error->message);
+        error->location.line, error->location.col, zenit_error_message(error));
 
-        tmp = tmp->next;
         i++;
     }    
 
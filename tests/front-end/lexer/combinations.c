@@ -18,6 +18,7 @@ static struct ZenitLexerTest tests[] = {
     { "#[attr()]",                          (ZenitTokenType[]){ T(HASH), T(LBRACKET), T(ID), T(LPAREN), T(RPAREN), T(RBRACKET), T(EOF) } },
     { "#[attr(key: value)]",                (ZenitTokenType[]){ T(HASH), T(LBRACKET), T(ID), T(LPAREN), T(ID), T(COLON), T(ID), T(RPAREN), T(RBRACKET), T(EOF) } },
     { "#[attr(key: value, key2: value2)]",  (ZenitTokenType[]){ T(HASH), T(LBRACKET), T(ID), T(LPAREN), T(ID), T(COLON), T(ID), T(COMMA), T(ID), T(COLON), T(ID), T(RPAREN), T(RBRACKET), T(EOF) } },
+    { "incbin(\"tiles.chr\");",             (ZenitTokenType[]){ T(INCBIN), T(LPAREN), T(STRING), T(RPAREN), T(SEMICOLON), T(EOF) } },
     { "var isTrue : bool = true;",          (ZenitTokenType[]){ T(VAR), T(ID), T(COLON), T(ID), T(ASSIGN), T(BOOL), T(SEMICOLON), T(EOF) } },
     { "var isFalse : bool = false;",        (ZenitTokenType[]){ T(VAR), T(ID), T(COLON), T(ID), T(ASSIGN), T(BOOL), T(SEMICOLON), T(EOF) } },
 };
@@ -12,6 +12,7 @@ static struct ZenitLexerTest tests[] = {
     { "cast",           (ZenitTokenType[]){ T(CAST), T(EOF) }      },
     { "struct",         (ZenitTokenType[]){ T(STRUCT), T(EOF) }    },
     { "if",             (ZenitTokenType[]){ T(IF), T(EOF) }        },
+    { "incbin",         (ZenitTokenType[]){ T(INCBIN), T(EOF) }    },
 };
 
 void zenit_test_lexer_keywords(void)
@@ -61,21 +61,69 @@ void zenit_test_parser_variable_errors(void)
     bool is_valid = zenit_parse_source(&ctx);
 
     size_t expected_errors = (sizeof(errors) / sizeof(errors[0])) - 1;
-    flut_vexpect_compat(ctx.errors != NULL && fl_list_length(ctx.errors) == expected_errors, "The context object must contain %zu errors", expected_errors);
+    flut_vexpect_compat(zenit_context_error_count(&ctx) == expected_errors, "The context object must contain %zu errors", expected_errors);
 
     size_t i=1;
-    struct FlListNode *tmp = fl_list_head(ctx.errors);
-    while (tmp != NULL)
+    ZenitError *error = zenit_context_get_errors(&ctx);
+    for (size_t j=0; j < ctx.errors.length; j++, error++)
     {
-        ZenitError *error = (ZenitError*) tmp->value;
-
         flut_vexpect_compat(error->location.line == i && error->type == errors[i],
             "Expected %s error: %s at line %u:%u", errors[i] == error->type ? "syntax" : "large integer", 
-            error->message, error->location.line, error->location.col);
+            zenit_error_message(error), error->location.line, error->location.col);
 
-        tmp = tmp->next;
         i++;
     }
 
     zenit_context_free(&ctx);
 }
+
+void zenit_test_parser_error_reporting(void)
+{
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, "");
+
+    char name[] = "token-name";
+
+    // Errors are appended as reported and formatted on demand
+    zenit_context_error(&ctx, (ZenitSourceLocation) { .filename = "a", .line = 3, .col = 1 }, ZENIT_ERROR_SYNTAX, "third %s", "error");
+    zenit_context_error(&ctx, (ZenitSourceLocation) { .filename = "a", .line = 1, .col = 5 }, ZENIT_ERROR_SYNTAX, "%.*s at %u:%d (%%)", 5, name, 1u, -5);
+    zenit_context_error(&ctx, (ZenitSourceLocation) { .filename = "a", .line = 1, .col = 5 }, ZENIT_ERROR_INFERENCE, "second");
+    zenit_context_error(&ctx, (ZenitSourceLocation) { .filename = "a", .line = 1, .col = 1 }, ZENIT_ERROR_SYNTAX, "%-4s|%03x|%c", "x", 10u, 'z');
+
+    // The arguments are copied, so the message must not change
+    name[0] = 'X';
+
+    flut_expect_compat("The context must contain 4 errors", zenit_context_error_count(&ctx) == 4);
+    flut_expect_compat("The messages must not be formatted until they are needed", ctx.errors.errors[1].message == NULL);
+    flut_expect_compat("The errors must be kept in report order until they are requested", !ctx.errors.sorted);
+
+    ZenitError *errors = zenit_context_get_errors(&ctx);
+
+    flut_expect_compat("The errors must be sorted by location", errors[0].location.col == 1 && errors[3].location.line == 3);
+    flut_expect_compat("Errors at the same location must keep the report order", errors[1].sequence == 1 && errors[2].sequence == 2);
+    flut_vexpect_compat(flm_cstring_equals(zenit_error_message(errors + 0), "x   |00a|z"), "Message must be 'x   |00a|z' (%s)", zenit_error_message(errors + 0));
+    flut_vexpect_compat(flm_cstring_equals(zenit_error_message(errors + 1), "token at 1:-5 (%)"), "Message must be 'token at 1:-5 (%%)' (%s)", zenit_error_message(errors + 1));
+    flut_expect_compat("Message without arguments must be copied verbatim", flm_cstring_equals(zenit_error_message(errors + 2), "second"));
+    flut_expect_compat("Formatted message must be cached", zenit_error_message(errors + 3) == zenit_error_message(errors + 3));
+
+    zenit_context_free(&ctx);
+
+    // The error limit stops the passes
+    const char *source =
+        "var : uint8 = 1;"          "\n"
+        "var n3 : = 3;"             "\n"
+        "var n5 = ;"                "\n"
+        "var n7 : [2]uint8 = ;"     "\n"
+    ;
+
+    ctx = zenit_context_new(ZENIT_SOURCE_STRING, source);
+    zenit_context_set_error_limit(&ctx, 2);
+
+    flut_expect_compat("Parsing must fail", !zenit_parse_source(&ctx));
+    flut_vexpect_compat(zenit_context_error_count(&ctx) == 2, "The parser must stop at the error limit (errors: %zu)", zenit_context_error_count(&ctx));
+    flut_expect_compat("The error limit must be reached", zenit_context_error_limit_reached(&ctx));
+
+    zenit_context_error(&ctx, (ZenitSourceLocation) { .filename = "a", .line = 9, .col = 1 }, ZENIT_ERROR_SYNTAX, "dropped");
+    flut_expect_compat("Errors after the limit must be counted but not stored", ctx.errors.length == 2 && ctx.errors.dropped == 1 && zenit_context_error_count(&ctx) == 3);
+
+    zenit_context_free(&ctx);
+}
@@ -1,4 +1,4 @@
-
+#include <stdio.h>
 
 #include <flut/flut.h>
 #include "../../../src/front-end/ast/ast.h"
@@ -85,20 +85,49 @@ void zenit_test_parser_literal_integer_error(void)
     bool is_valid = zenit_parse_source(&ctx);
 
     size_t expected_errors = 1;
-    flut_vexpect_compat(!is_valid && ctx.errors != NULL && fl_list_length(ctx.errors) == expected_errors, "The context object must contain %zu error(s)", expected_errors);
+    flut_vexpect_compat(!is_valid && zenit_context_error_count(&ctx) == expected_errors, "The context object must contain %zu error(s)", expected_errors);
 
     size_t i=1;
-    struct FlListNode *tmp = fl_list_head(ctx.errors);
-    while (tmp != NULL)
+    ZenitError *error = zenit_context_get_errors(&ctx);
+    for (size_t j=0; j < ctx.errors.length; j++, error++)
     {
-        ZenitError *error = (ZenitError*) tmp->value;
-
         flut_vexpect_compat(error->location.line == 1 && error->type == ZENIT_ERROR_LARGE_INTEGER, 
-            "Expected semantic error: %s at line %u:%u", error->message, error->location.line, error->location.col);
+            "Expected semantic error: %s at line %u:%u", zenit_error_message(error), error->location.line, error->location.col);
 
-        tmp = tmp->next;
         i++;
     }
 
     zenit_context_free(&ctx);
 }
+
+void zenit_test_parser_literal_incbin(void)
+{
+    FILE *file = fopen("zenit-incbin-test-parser.bin", "wb");
+    fwrite("\x01\x02\x03", 1, 3, file);
+    fclose(file);
+
+    const char *source = 
+        "incbin(\"zenit-incbin-test-parser.bin\");"     "\n"
+    ;
+
+    const char *ast_dump =
+        "(ast"
+            " (incbin \"zenit-incbin-test-parser.bin\" 3)"
+        ")"
+    ;
+
+    zenit_test_parser_run(source, ast_dump);
+
+    remove("zenit-incbin-test-parser.bin");
+
+    // The file does not exist
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, "incbin(\"zenit-incbin-test-missing.bin\");");
+    bool is_valid = zenit_parse_source(&ctx);
+
+    flut_expect_compat("The context object must contain 1 error", !is_valid && zenit_context_error_count(&ctx) == 1);
+
+    ZenitError *error = zenit_context_get_errors(&ctx);
+    flut_vexpect_compat(error->type == ZENIT_ERROR_FILE, "Expected file error: %s at line %u:%u", zenit_error_message(error), error->location.line, error->location.col);
+
+    zenit_context_free(&ctx);
+}
@@ -180,3 +180,22 @@ void zenit_test_parser_variable_struct(void)
 
     zenit_test_parser_run(source, ast_dump);
 }
+
+void zenit_test_parser_variable_extern(void)
+{
+    const char *source = 
+        "extern var counter : uint8;"                       "\n"
+        "extern var table : [4]uint16;"                     "\n"
+        "var num0 = counter;"                               "\n"
+    ;
+
+    const char *ast_dump =
+        "(ast"
+        " (extern var counter (type uint8))"
+        " (extern var table (type [4]uint16))"
+        " (var num0 (id counter))"
+        ")"
+    ;
+
+    zenit_test_parser_run(source, ast_dump);
+}
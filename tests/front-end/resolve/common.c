@@ -44,16 +44,13 @@ void zenit_test_resolve_errors(const char *source, struct ResolveTestCase *tests
     flut_vexpect_compat(!valid_resolve && zenit_context_error_count(&ctx) == tests_count, "Resolve pass must fail with %zu errors", tests_count);
 
     size_t i=0;
-    struct FlListNode *tmp = fl_list_head(ctx.errors);
-    while (tmp != NULL)
+    ZenitError *error = zenit_context_get_errors(&ctx);
+    for (size_t j=0; j < ctx.errors.length; j++, error++)
     {
-        ZenitError *error = (ZenitError*) tmp->value;
-
         flut_vexpect_compat(error->type == tests[i].error, 
             "L%u:%u: %s (%s)",
-            error->location.line, error->location.col, error->message, tests[i].message);
+            error->location.line, error->location.col, zenit_error_message(error), tests[i].message);
 
-        tmp = tmp->next;
         i++;
     }
 
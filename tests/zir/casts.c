@@ -7,6 +7,7 @@
 #include "../../src/front-end/binding/resolve.h"
 #include "../../src/front-end/symtable.h"
 #include "../../src/front-end/codegen/zir.h"
+#include "../../src/zir/passes/forward-temps.h"
 #include "tests.h"
 
 void zenit_test_generate_ir_casts(void)
@@ -66,3 +67,59 @@ void zenit_test_generate_ir_casts(void)
 
     zir_program_free(program);
 }
+
+void zenit_test_forward_ir_temporaries(void)
+{
+    const char *zenit_source = 
+        "var a : uint16 = 1;"                                       "\n"
+        "var b : uint8 = cast(0x1FF : uint8);"                      "\n"
+        "var d = cast(0x201 : uint8);"                              "\n"
+        "var e : uint16 = cast(&d);"                                "\n"
+        "var f : [2]uint8 = [ cast(0x100 : uint8), 2 ];"            "\n"
+        "var g : uint16 = cast(cast(0x1FF : uint8) : uint16);"      "\n"
+        "var h = { x: cast(0x102 : uint8) };"                       "\n"
+        "var i : uint16 = cast(cast(e : uint8) : uint16);"          "\n"
+        "var j : uint8 = cast(cast(b : uint16) : uint8);"           "\n"
+        "var k = &cast(d : uint16);"                                "\n"
+    ;
+
+    const char *zir_src = 
+        "@a : uint16 = 1"                                           "\n"
+        "@b : uint8 = 255"                                          "\n"
+        "@d : uint8 = 1"                                            "\n"
+        "@e : uint16 = ref @d"                                      "\n"
+        "@f : [2]uint8 = [ 0, 2 ]"                                  "\n"
+        "@g : uint16 = 255"                                         "\n"
+        "@h : { x: uint8 } = { x: 2 }"                              "\n"
+        // The inner cast truncates a runtime value, both casts are kept
+        "%tmp8 : uint8 = cast(@e, uint8)"                           "\n"
+        "%tmp7 : uint16 = cast(%tmp8, uint16)"                      "\n"
+        "@i : uint16 = %tmp7"                                       "\n"
+        // The inner cast does not truncate the value, it is forwarded into the outer one
+        "@j : uint8 = @b"                                           "\n"
+        "@k : &uint16 = ref @d"                                     "\n"
+    ;
+
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+    
+    ZirProgram *program = zenit_generate_zir(&ctx);
+
+    flut_expect_compat("ZIR program must compile", program != NULL);
+
+    zenit_context_free(&ctx);
+
+    flut_expect_compat("The pass must remove 10 temporal symbols", zir_forward_temporaries(program) == 10);
+
+    char *codegen = zir_program_dump(program);
+
+    flut_expect_compat("Generated IR must be equals to the hand-written version", flm_cstring_equals(codegen, zir_src));
+    
+    fl_cstring_free(codegen);
+
+    zir_program_free(program);
+}
@@ -0,0 +1,72 @@
+#include <stdio.h>
+
+#include <flut/flut.h>
+#include "../../src/front-end/type-check/check.h"
+#include "../../src/front-end/inference/infer.h"
+#include "../../src/front-end/parser/parse.h"
+#include "../../src/front-end/binding/resolve.h"
+#include "../../src/front-end/symtable.h"
+#include "../../src/front-end/codegen/zir.h"
+#include "../../src/zir/passes/dead-globals.h"
+#include "tests.h"
+
+void zenit_test_eliminate_dead_globals(void)
+{
+    const char *zenit_source = 
+        // Reachable from the roots
+        "var handler : uint8 = 1;"                                          "\n"
+
+        // Roots: fixed address, the keep attribute and the CHR segment
+        "#[NES(address: 0xFFFA)] var nmi : uint16 = cast(&handler);"        "\n"
+        "#[keep] var table = [ 1, 2, 3 ];"                                  "\n"
+        "#[NES(segment: chr)] var tiles = [ 0x18, 0x3C ];"                  "\n"
+
+        // The branch conditions are roots too
+        "var cond = true;"                                                  "\n"
+        "if (cond) { var inner = 1; }"                                      "\n"
+
+        // Unreferenced globals
+        "var unused_a : uint16 = 2;"                                        "\n"
+        "var unused_b = [ 1, 2, 3, 4 ];"                                    "\n"
+        "var unused_c = &unused_a;"                                         "\n"
+        "var unused_cast : uint8 = cast(0x1FF : uint8);"                    "\n"
+    ;
+
+    const char *zir_src = 
+        "@handler : uint8 = 1"                                              "\n"
+        "%tmp0 : uint16 = cast(ref @handler, uint16)"                       "\n"
+        "@nmi : uint16 = %tmp0 ; #NES(address:65530)"                      "\n"
+        "@table : [3]uint8 = [ 1, 2, 3 ] ; #keep"                           "\n"
+        "@tiles : [2]uint8 = [ 24, 60 ] ; #NES(segment:@chr)"               "\n"
+        "@cond : bool = true"                                               "\n"
+        "if_false @cond jump L2"                                            "\n"
+        "L2:"                                                               "\n"
+    ;
+
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+    
+    ZirProgram *program = zenit_generate_zir(&ctx);
+
+    flut_expect_compat("ZIR program must compile", program != NULL);
+
+    zenit_context_free(&ctx);
+
+    flut_expect_compat("The pass must remove 6 instructions", zir_eliminate_dead_globals(program) == 6);
+
+    char *codegen = zir_program_dump(program);
+    flut_expect_compat("The unreferenced globals must be removed", flm_cstring_equals(codegen, zir_src));
+    fl_cstring_free(codegen);
+
+    flut_expect_compat("The pass must report 5 removed globals", fl_array_length(program->dead_globals) == 5);
+
+    char *report = zir_dead_globals_report(program, 2, fl_cstring_new(0));
+    flut_expect_compat("The report must contain the removed bytes", strstr(report, "5 unused globals removed, 10 bytes") != NULL);
+    fl_cstring_free(report);
+
+    zir_program_free(program);
+}
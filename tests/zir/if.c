@@ -7,6 +7,7 @@
 #include "../../src/front-end/binding/resolve.h"
 #include "../../src/front-end/symtable.h"
 #include "../../src/front-end/codegen/zir.h"
+#include "../../src/zir/passes/fold-if.h"
 #include "tests.h"
 
 void zenit_test_generate_ir_if(void)
@@ -30,40 +31,58 @@ void zenit_test_generate_ir_if(void)
     ;
 
     const char *zir_src = 
-        "if_false true jump 1"                          "\n" // if (true) {}
+        "if_false true jump L2"                         "\n" // if (true) {}
+        "L2:"                                           "\n"
 
-        "if_false true jump 2"                          "\n" // if (true)
+        "if_false true jump L4"                         "\n" // if (true)
         "@a : uint8 = 1"                                "\n" //     var a = 1;
+        "L4:"                                           "\n"
 
-        "if_false true jump 3"                          "\n" // if (true)
+        "if_false true jump L6"                         "\n" // if (true)
         "@b : uint8 = 1"                                "\n" //     var b = 1;
-        "jump 2"                                        "\n" // 
-        "@c : uint8 = 2"                                "\n" // else var c = 2;
+        "jump L7"                                       "\n" // 
+        "L6:"                                           "\n" // else
+        "@c : uint8 = 2"                                "\n" //     var c = 2;
+        "L7:"                                           "\n"
 
-        "if_false true jump 3"                          "\n" // if (true)
+        "if_false true jump L9"                         "\n" // if (true)
         "@d : uint8 = 1"                                "\n" //     var d = 1;
-        "jump 5"                                        "\n" // 
-        "if_false false jump 3"                         "\n" // else if (false)
-        "@e : uint8 = 3"                                "\n" //     var e = 3;
-        "jump 2"                                        "\n" //
-        "@f : uint8 = 2"                                "\n" // else var f = 2;
-
-        "if_false true jump 3"                          "\n" // if (true)
-        "if_false true jump 2"                          "\n" //     if (true)
-        "if_false false jump 1"                         "\n" //         if (false) {}
-
-        "if_false true jump 5"                          "\n" // if (true)
+        "jump L13"                                      "\n" // 
+        "L9:"                                           "\n" // else
+        "if_false false jump L11"                       "\n" //     if (false)
+        "@e : uint8 = 3"                                "\n" //         var e = 3;
+        "jump L12"                                      "\n" //
+        "L11:"                                          "\n" //     else
+        "@f : uint8 = 2"                                "\n" //         var f = 2;
+        "L12:"                                          "\n"
+        "L13:"                                          "\n"
+
+        "if_false true jump L19"                        "\n" // if (true)
+        "if_false true jump L18"                        "\n" //     if (true)
+        "if_false false jump L17"                       "\n" //         if (false) {}
+        "L17:"                                          "\n"
+        "L18:"                                          "\n"
+        "L19:"                                          "\n"
+
+        "if_false true jump L25"                        "\n" // if (true)
         "@x : uint8 = 1"                                "\n" //     var x = 1;
-        "if_false true jump 3"                          "\n" //     if (true) 
-        "if_false false jump 1"                         "\n" //         if (false) {}
+        "if_false true jump L24"                        "\n" //     if (true) 
+        "if_false false jump L23"                       "\n" //         if (false) {}
+        "L23:"                                          "\n"
         "@y : uint8 = 2"                                "\n" //         var y = 2;
-
-        "if_false true jump 6"                          "\n" // if (true)
-        "@j : uint8 = 1"                                "\n" //     var x = 1;
-        "if_false true jump 2"                          "\n" //     if (true) {}
-        "jump 3"                                        "\n" //     else
-        "if_false false jump 1"                         "\n" //         if (false) {}
-        "@k : uint8 = 2"                                "\n" //         var y = 2;
+        "L24:"                                          "\n"
+        "L25:"                                          "\n"
+
+        "if_false true jump L32"                        "\n" // if (true)
+        "@j : uint8 = 1"                                "\n" //     var j = 1;
+        "if_false true jump L28"                        "\n" //     if (true) {}
+        "jump L31"                                      "\n" //     else
+        "L28:"                                          "\n"
+        "if_false false jump L30"                       "\n" //         if (false) {}
+        "L30:"                                          "\n"
+        "@k : uint8 = 2"                                "\n" //         var k = 2;
+        "L31:"                                          "\n"
+        "L32:"                                          "\n"
     ;
 
     ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
@@ -88,3 +107,102 @@ void zenit_test_generate_ir_if(void)
 
     zir_program_free(program);
 }
+
+void zenit_test_fold_ir_if(void)
+{
+    const char *zenit_source = 
+        "var c = true;"                                                                 "\n"
+        "if (true) { var a = 1; } else { var b = 2; }"                                  "\n"
+        "if (false) { var d = 1; } else { var e = 2; }"                                 "\n"
+        "if (c) { var f = 1; if (false) { var g = 2; } } else { var h = 3; }"           "\n"
+        "if (cast(false)) { var i = 1; }"                                               "\n"
+        "if (c) { var j = 1; }"                                                         "\n"
+    ;
+
+    const char *zir_src = 
+        "@c : bool = true"                              "\n" // var c = true;
+        "@a : uint8 = 1"                                "\n" // if (true) var a = 1;
+        "@e : uint8 = 2"                                "\n" // if (false) ... else var e = 2;
+        "if_false @c jump L7"                           "\n" // if (c)
+        "@f : uint8 = 1"                                "\n" //     var f = 1;
+        "jump L8"                                       "\n" //
+        "L7:"                                           "\n" // else
+        "@h : uint8 = 3"                                "\n" //     var h = 3;
+        "L8:"                                           "\n"
+        "if_false @c jump L11"                          "\n" // if (c)
+        "@j : uint8 = 1"                                "\n" //     var j = 1;
+        "L11:"                                          "\n"
+    ;
+
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+    
+    ZirProgram *program = zenit_generate_zir(&ctx);
+
+    flut_expect_compat("ZIR program must compile", program != NULL);
+
+    zenit_context_free(&ctx);
+
+    flut_expect_compat("There must be 4 constant if-false instructions", zir_fold_constant_ifs(program) == 4);
+    
+    char *codegen = zir_program_dump(program);
+
+    flut_expect_compat("Folded IR must be equals to the hand-written version", flm_cstring_equals(codegen, zir_src));
+    
+    fl_cstring_free(codegen);
+
+    zir_program_free(program);
+}
+
+void zenit_test_generate_ir_if_cfg(void)
+{
+    const char *zenit_source = 
+        "var c = true;"                                                                 "\n"
+        "if (c) { var a = 1; } else { var b = 2; }"                                     "\n"
+        "var d = 3;"                                                                    "\n"
+    ;
+
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+    
+    ZirProgram *program = zenit_generate_zir(&ctx);
+
+    flut_expect_compat("ZIR program must compile", program != NULL);
+
+    zenit_context_free(&ctx);
+
+    ZirCfg *cfg = &program->global->cfg;
+
+    flut_expect_compat("The CFG must contain 4 basic blocks", fl_array_length(cfg->blocks) == 4);
+
+    ZirBasicBlock *entry_block = cfg->blocks[0];
+    ZirBasicBlock *then_block = cfg->blocks[1];
+    ZirBasicBlock *else_block = cfg->blocks[2];
+    ZirBasicBlock *exit_block = cfg->blocks[3];
+
+    flut_expect_compat("The entry block must end with an if-false instruction", entry_block->terminator != NULL && entry_block->terminator->type == ZIR_INSTR_IF_FALSE);
+    flut_expect_compat("The if-false instruction must target the else block", zir_cfg_terminator_target(entry_block->terminator) == else_block);
+    flut_expect_compat("The entry block must have 2 successors", fl_array_length(entry_block->successors) == 2);
+    flut_expect_compat("The entry block must not have predecessors", fl_array_length(entry_block->predecessors) == 0);
+
+    flut_expect_compat("The then block must end with a jump to the exit block", then_block->terminator != NULL && zir_cfg_terminator_target(then_block->terminator) == exit_block);
+    flut_expect_compat("The then block must have 1 successor", fl_array_length(then_block->successors) == 1 && then_block->successors[0] == exit_block);
+    flut_expect_compat("The then block's predecessor must be the entry block", fl_array_length(then_block->predecessors) == 1 && then_block->predecessors[0] == entry_block);
+
+    flut_expect_compat("The else block must fall through to the exit block", else_block->terminator == NULL && fl_array_length(else_block->successors) == 1 && else_block->successors[0] == exit_block);
+    flut_expect_compat("The else block's predecessor must be the entry block", fl_array_length(else_block->predecessors) == 1 && else_block->predecessors[0] == entry_block);
+
+    flut_expect_compat("The exit block must have 2 predecessors", fl_array_length(exit_block->predecessors) == 2);
+    flut_expect_compat("The exit block must contain the following statement", fl_array_length(exit_block->instructions) == 1);
+    flut_expect_compat("The CFG must contain 6 instructions", zir_cfg_instruction_count(cfg) == 6);
+
+    zir_program_free(program);
+}
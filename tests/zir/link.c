@@ -0,0 +1,153 @@
+#include <stdio.h>
+
+#include <flut/flut.h>
+#include "../../src/front-end/type-check/check.h"
+#include "../../src/front-end/inference/infer.h"
+#include "../../src/front-end/parser/parse.h"
+#include "../../src/front-end/binding/resolve.h"
+#include "../../src/front-end/symtable.h"
+#include "../../src/front-end/codegen/zir.h"
+#include "../../src/zir/link.h"
+#include "tests.h"
+
+static const char *unit_names[] = { "main", "lib" };
+
+static char* link_sources(const char *main_source, const char *lib_source, char **message)
+{
+    const char *sources[] = { main_source, lib_source };
+    ZenitContext contexts[2];
+    ZirProgram *units[2];
+
+    for (size_t i=0; i < 2; i++)
+    {
+        contexts[i] = zenit_context_new(ZENIT_SOURCE_STRING, sources[i]);
+
+        bool compiled = zenit_parse_source(contexts + i)
+                        && zenit_resolve_symbols(contexts + i)
+                        && zenit_infer_types(contexts + i)
+                        && zenit_check_types(contexts + i);
+
+        flut_expect_compat("Each unit must compile on its own", compiled);
+
+        units[i] = compiled ? zenit_generate_zir(contexts + i) : NULL;
+        flut_expect_compat("ZIR program of each unit must compile", units[i] != NULL);
+    }
+
+    char *codegen = NULL;
+    ZirProgram *program = zir_link_programs(units, unit_names, 2, message);
+
+    if (program != NULL)
+    {
+        codegen = zir_program_dump(program);
+        zir_program_free(program);
+    }
+    else
+    {
+        zir_program_free(units[0]);
+        zir_program_free(units[1]);
+    }
+
+    zenit_context_free(contexts);
+    zenit_context_free(contexts + 1);
+
+    return codegen;
+}
+
+void zenit_test_zir_link(void)
+{
+    const char *main_source = 
+        "extern var counter : uint8;"                                           "\n"
+        "extern var point : Point;"                                             "\n"
+        "struct Point { x: uint8; y: uint8; }"                                  "\n"
+        "var counter_ref = &counter;"                                           "\n"
+        "var copy = point;"                                                     "\n"
+        "if (true) { var tmp = counter; }"                                      "\n"
+    ;
+
+    const char *lib_source =
+        "struct Point { x: uint8; y: uint8; }"                                  "\n"
+        "#[NES(address: 0x10)] var counter : uint8 = 1;"                        "\n"
+        "var point = Point { x: 2, y: 3 };"                                     "\n"
+        "var tmp : uint16 = 4;"                                                 "\n"
+        "if (false) { var other = 5; }"                                         "\n"
+    ;
+
+    // The lib unit defines the symbols main uses, so it is placed first
+    const char *zir_src =
+        "struct Point { x: uint8, y: uint8 }"                                   "\n"
+        "@counter : uint8 = 1 ; #NES(address:16)"                               "\n"
+        "@point : Point = { x: 2, y: 3 }"                                       "\n"
+        "@tmp : uint16 = 4"                                                     "\n"
+        "if_false false jump L3"                                                "\n"
+        "@other : uint8 = 5"                                                    "\n"
+        "L3:"                                                                   "\n"
+        "@counter_ref : &uint8 = ref @counter"                                  "\n"
+        "@copy : Point = @point"                                                "\n"
+        "if_false true jump L6"                                                 "\n"
+        "@tmp$u0 : uint8 = @counter"                                            "\n"
+        "L6:"                                                                   "\n"
+    ;
+
+    char *message = NULL;
+    char *codegen = link_sources(main_source, lib_source, &message);
+
+    flut_expect_compat("Units must link", codegen != NULL && message == NULL);
+    flut_expect_compat("External symbols must be resolved and the clashing locals renamed", codegen != NULL && flm_cstring_equals(codegen, zir_src));
+
+    fl_cstring_free(codegen);
+
+    struct {
+        const char *description;
+        const char *main_source;
+        const char *lib_source;
+        const char *message;
+    } errors[] = {
+        {
+            "Duplicated global symbols must be reported",
+            "var value = 1;",
+            "var value = 2;",
+            "Symbol 'value' is defined in 'main' and in 'lib'"
+        },
+        {
+            "Undefined external symbols must be reported",
+            "extern var value : uint8; var copy = value;",
+            "var other = 2;",
+            "Undefined external symbol 'value' in 'main'"
+        },
+        {
+            "External declarations must match the type of the definition",
+            "extern var value : uint16; var copy = value;",
+            "var value : uint8 = 2;",
+            "External symbol 'value' is declared as 'uint16' in 'main' but it is defined as 'uint8' in 'lib'"
+        },
+        {
+            "Struct declarations must match between units",
+            "struct A { a: uint8; } var a = A { a: 1 };",
+            "struct A { a: uint16; } var b = A { a: 1 };",
+            "Struct 'A' in 'lib' does not match its declaration in another unit"
+        },
+        {
+            "Units must not use symbols of each other",
+            "extern var b : uint8; var a : uint8 = 1; var copy = b;",
+            "extern var a : uint8; var b : uint8 = 2; var copy2 = a;",
+            "Circular dependency between units: 'main' uses symbols of 'lib', and the initializers of a unit run "
+            "after the ones of the units it uses, so units cannot use symbols of each other"
+        },
+        {
+            "Fixed addresses must not overlap between units",
+            "#[NES(address: 0x10)] var a : uint16 = 1;",
+            "#[NES(address: 0x11)] var b : uint8 = 2;",
+            "Variable 'a' in 'main' overlaps variable 'b' in 'lib' at address 0x0011"
+        },
+    };
+
+    for (size_t i=0; i < sizeof(errors) / sizeof(errors[0]); i++)
+    {
+        message = NULL;
+        codegen = link_sources(errors[i].main_source, errors[i].lib_source, &message);
+
+        flut_expect_compat(errors[i].description, codegen == NULL && message != NULL && flm_cstring_equals(message, errors[i].message));
+
+        fl_cstring_free(message);
+    }
+}
@@ -0,0 +1,64 @@
+#include <stdio.h>
+
+#include <flut/flut.h>
+#include "../../src/zir/slab.h"
+#include "../../src/zir/program.h"
+#include "tests.h"
+
+typedef struct SlabElement {
+    size_t index;
+    char padding[13];
+} SlabElement;
+
+static size_t released;
+
+static void release_element(void *element)
+{
+    if (((SlabElement*) element)->index == released)
+        released++;
+}
+
+void zenit_test_zir_slab(void)
+{
+    ZirSlab slab = zir_slab_new(sizeof(SlabElement));
+
+    flut_expect_compat("Empty slab must not allocate elements", slab.length == 0 && fl_array_length(slab.chunks) == 0);
+
+    SlabElement *elements[1000];
+    bool zeroed = true;
+
+    for (size_t i=0; i < 1000; i++)
+    {
+        elements[i] = zir_slab_alloc(&slab);
+        zeroed = zeroed && elements[i]->index == 0 && elements[i]->padding[12] == 0;
+        elements[i]->index = i;
+    }
+
+    bool stable = true;
+    for (size_t i=0; i < 1000; i++)
+        stable = stable && elements[i]->index == i;
+
+    flut_expect_compat("Slab elements must be zeroed", zeroed);
+    flut_expect_compat("Slab elements must not move", stable);
+    flut_expect_compat("Slab must contain 1000 elements", slab.length == 1000);
+    // 32 + 64 + 128 + 256 + 512 = 992, the last 8 elements go to a chunk of 1024
+    flut_expect_compat("Slab chunks must double their capacity", fl_array_length(slab.chunks) == 6 && slab.used == 8);
+
+    released = 0;
+    zir_slab_free(&slab, release_element);
+    flut_expect_compat("Slab must release each element in allocation order", released == 1000);
+
+    // The operand pools allocate each kind of operand from its own slab
+    ZirProgram *program = zir_program_new();
+    ZirUintType *uint8 = zir_type_ctx_new_uint(program->types, ZIR_UINT_8);
+    ZirArrayOperand *array = zir_operand_pool_new_array(program->operands, zir_type_ctx_new_array(program->types, (ZirType*) uint8, 256));
+
+    for (size_t i=0; i < 256; i++)
+        zir_array_operand_add_element(array, (ZirOperand*) zir_operand_pool_new_uint(program->operands, uint8, (ZirUintValue) { .uint8 = (uint8_t) i }));
+
+    flut_expect_compat("Array operands must be allocated from their own slab", program->operands->arrays.length == 1);
+    flut_expect_compat("Uint operands must be allocated from their own slab", program->operands->uints.length == 256 && fl_array_length(program->operands->uints.chunks) == 4);
+    flut_expect_compat("Array operand must contain the elements", fl_array_length(array->elements) == 256 && ((ZirUintOperand*) array->elements[255])->value.uint8 == 255);
+
+    zir_program_free(program);
+}
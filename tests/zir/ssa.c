@@ -0,0 +1,325 @@
+#include <stdio.h>
+
+#include <flut/flut.h>
+#include "../../src/front-end/type-check/check.h"
+#include "../../src/front-end/inference/infer.h"
+#include "../../src/front-end/parser/parse.h"
+#include "../../src/front-end/binding/resolve.h"
+#include "../../src/front-end/symtable.h"
+#include "../../src/front-end/codegen/zir.h"
+#include "../../src/zir/dominance.h"
+#include "../../src/zir/verify.h"
+#include "../../src/zir/passes/ssa.h"
+#include "../../src/zir/passes/manager.h"
+#include "tests.h"
+
+static ZirProgram* generate_zir(const char *zenit_source)
+{
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+    
+    ZirProgram *program = zenit_generate_zir(&ctx);
+
+    flut_expect_compat("ZIR program must compile", program != NULL);
+
+    zenit_context_free(&ctx);
+
+    return program;
+}
+
+/*
+ * Function: redefine_symbol
+ *  Zenit does not support assignments yet, so the tests rewrite the destination of a variable instruction
+ *  to define the same symbol more than once
+ */
+static void redefine_symbol(ZirProgram *program, ZirInstr *instruction, ZirSymbol *symbol)
+{
+    instruction->destination = (ZirOperand*) zir_operand_pool_new_symbol(program->operands, symbol);
+}
+
+static ZirSymbol* defined_symbol(ZirInstr *instruction)
+{
+    return ((ZirSymbolOperand*) instruction->destination)->symbol;
+}
+
+void zenit_test_ssa_construct(void)
+{
+    ZirProgram *program = generate_zir(
+        "var c = true;"                                                                 "\n"
+        "if (c) { var a = 1; } else { var b = 2; }"                                     "\n"
+        "var d = 3;"                                                                    "\n"
+    );
+
+    ZirCfg *cfg = &program->global->cfg;
+    ZirBasicBlock *entry_block = cfg->blocks[0];
+    ZirBasicBlock *then_block = cfg->blocks[1];
+    ZirBasicBlock *else_block = cfg->blocks[2];
+    ZirBasicBlock *exit_block = cfg->blocks[3];
+
+    // @b is redefined as @a, and @d uses @a
+    ZirSymbol *symbol_a = defined_symbol(then_block->instructions[0]);
+    redefine_symbol(program, else_block->instructions[0], symbol_a);
+    ((ZirVariableInstr*) exit_block->instructions[0])->source = (ZirOperand*) zir_operand_pool_new_symbol(program->operands, symbol_a);
+
+    ZirDominance *dominance = zir_dominance_new(cfg);
+
+    flut_expect_compat("The entry block is the immediate dominator of the then block", dominance->idom[then_block->index] == entry_block);
+    flut_expect_compat("The entry block is the immediate dominator of the exit block", dominance->idom[exit_block->index] == entry_block);
+    flut_expect_compat("The entry block dominates the exit block", zir_dominance_dominates(dominance, entry_block, exit_block));
+    flut_expect_compat("The then block does not dominate the exit block", !zir_dominance_dominates(dominance, then_block, exit_block));
+    flut_expect_compat("The dominance frontier of the then block is the exit block", fl_array_length(dominance->frontier[then_block->index]) == 1 && dominance->frontier[then_block->index][0] == exit_block);
+    flut_expect_compat("The dominance frontier of the else block is the exit block", fl_array_length(dominance->frontier[else_block->index]) == 1 && dominance->frontier[else_block->index][0] == exit_block);
+    flut_expect_compat("The dominance frontier of the entry block is empty", fl_array_length(dominance->frontier[entry_block->index]) == 0);
+
+    zir_dominance_free(dominance);
+
+    flut_expect_compat("SSA construction must insert 1 phi instruction", zir_ssa_construct(program) == 1);
+    flut_expect_compat("The program in SSA form must be valid", zir_program_verify(program, NULL));
+
+    char *codegen = zir_program_dump(program);
+    flut_expect_compat("The versions of @a must merge in the exit block", flm_cstring_equals(codegen,
+        "@c : bool = true"                          "\n"
+        "if_false @c jump L2"                       "\n"
+        "L1:"                                       "\n"
+        "@a.1 : uint8 = 1"                          "\n"
+        "jump L3"                                   "\n"
+        "L2:"                                       "\n"
+        "@a.2 : uint8 = 2"                          "\n"
+        "L3:"                                       "\n"
+        "@a.3 : uint8 = phi(@a.1 L1, @a.2 L2)"      "\n"
+        "@d : uint8 = @a.3"                         "\n"
+    ));
+    fl_cstring_free(codegen);
+
+    flut_expect_compat("SSA destruction must remove 1 phi instruction", zir_ssa_destruct(program) == 1);
+    flut_expect_compat("The program out of SSA form must be valid", zir_program_verify(program, NULL));
+
+    codegen = zir_program_dump(program);
+    flut_expect_compat("The versions of @a must be merged back into @a", flm_cstring_equals(codegen,
+        "@c : bool = true"                          "\n"
+        "if_false @c jump L2"                       "\n"
+        "@a : uint8 = 1"                            "\n"
+        "jump L3"                                   "\n"
+        "L2:"                                       "\n"
+        "@a : uint8 = 2"                            "\n"
+        "L3:"                                       "\n"
+        "@d : uint8 = @a"                           "\n"
+    ));
+    fl_cstring_free(codegen);
+
+    zir_program_free(program);
+}
+
+void zenit_test_ssa_destruct_copies(void)
+{
+    ZirProgram *program = generate_zir(
+        "var c = true;"                                                                 "\n"
+        "var a = 1;"                                                                    "\n"
+        "if (c) { var b = 2; }"                                                         "\n"
+        "var d = 3;"                                                                    "\n"
+    );
+
+    ZirCfg *cfg = &program->global->cfg;
+    ZirBasicBlock *entry_block = cfg->blocks[0];
+    ZirBasicBlock *exit_block = cfg->blocks[2];
+
+    ZirSymbol *symbol_a = defined_symbol(entry_block->instructions[1]);
+    redefine_symbol(program, cfg->blocks[1]->instructions[0], symbol_a);
+    ((ZirVariableInstr*) exit_block->instructions[0])->source = (ZirOperand*) zir_operand_pool_new_symbol(program->operands, symbol_a);
+
+    flut_expect_compat("SSA construction must insert 1 phi instruction", zir_ssa_construct(program) == 1);
+
+    char *codegen = zir_program_dump(program);
+    flut_expect_compat("The phi instruction must take @a.1 from the entry block", flm_cstring_equals(codegen,
+        "L0:"                                       "\n"
+        "@c : bool = true"                          "\n"
+        "@a.1 : uint8 = 1"                          "\n"
+        "if_false @c jump L2"                       "\n"
+        "L1:"                                       "\n"
+        "@a.2 : uint8 = 2"                          "\n"
+        "L2:"                                       "\n"
+        "@a.3 : uint8 = phi(@a.1 L0, @a.2 L1)"      "\n"
+        "@d : uint8 = @a.3"                         "\n"
+    ));
+    fl_cstring_free(codegen);
+
+    // A constant replaces @a.1 in the phi instruction, the entry block has 2 successors so the copy
+    // needs its own block
+    ZirPhiInstr *phi = (ZirPhiInstr*) exit_block->instructions[0];
+    phi->sources[0] = ((ZirVariableInstr*) entry_block->instructions[1])->source;
+
+    flut_expect_compat("SSA destruction must remove 1 phi instruction", zir_ssa_destruct(program) == 1);
+    flut_expect_compat("The program out of SSA form must be valid", zir_program_verify(program, NULL));
+    flut_expect_compat("The CFG must contain 4 basic blocks", fl_array_length(cfg->blocks) == 4);
+
+    codegen = zir_program_dump(program);
+    flut_expect_compat("The copy must be placed in the split edge", flm_cstring_equals(codegen,
+        "@c : bool = true"                          "\n"
+        "@a : uint8 = 1"                            "\n"
+        "if_false @c jump L2"                       "\n"
+        "@a : uint8 = 2"                            "\n"
+        "jump L3"                                   "\n"
+        "L2:"                                       "\n"
+        "@a : uint8 = 1"                            "\n"
+        "L3:"                                       "\n"
+        "@d : uint8 = @a"                           "\n"
+    ));
+    fl_cstring_free(codegen);
+
+    zir_program_free(program);
+}
+
+void zenit_test_ssa_destruct_swap(void)
+{
+    ZirProgram *program = generate_zir(
+        "var c = true;"                                                                 "\n"
+        "var a = 1;"                                                                    "\n"
+        "var b = 2;"                                                                    "\n"
+        "if (c) { var x = 3; var y = 4; }"                                              "\n"
+        "var d = 5;"                                                                    "\n"
+        "var e = 6;"                                                                    "\n"
+    );
+
+    ZirCfg *cfg = &program->global->cfg;
+    ZirBasicBlock *entry_block = cfg->blocks[0];
+    ZirBasicBlock *then_block = cfg->blocks[1];
+    ZirBasicBlock *exit_block = cfg->blocks[2];
+
+    ZirSymbol *symbol_a = defined_symbol(entry_block->instructions[1]);
+    ZirSymbol *symbol_b = defined_symbol(entry_block->instructions[2]);
+    redefine_symbol(program, then_block->instructions[0], symbol_a);
+    redefine_symbol(program, then_block->instructions[1], symbol_b);
+    ((ZirVariableInstr*) exit_block->instructions[0])->source = (ZirOperand*) zir_operand_pool_new_symbol(program->operands, symbol_a);
+    ((ZirVariableInstr*) exit_block->instructions[1])->source = (ZirOperand*) zir_operand_pool_new_symbol(program->operands, symbol_b);
+
+    flut_expect_compat("SSA construction must insert 2 phi instructions", zir_ssa_construct(program) == 2);
+
+    // The values that come from the then block are swapped: @a takes @b.2 and @b takes @a.2, the copies
+    // of that edge form a cycle
+    ZirPhiInstr *phi_b = (ZirPhiInstr*) exit_block->instructions[0];
+    ZirPhiInstr *phi_a = (ZirPhiInstr*) exit_block->instructions[1];
+    ZirOperand *source_a = phi_a->sources[1];
+    phi_a->sources[1] = phi_b->sources[1];
+    phi_b->sources[1] = source_a;
+
+    char *codegen = zir_program_dump(program);
+    flut_expect_compat("The phi instructions must swap the values of the then block", flm_cstring_equals(codegen,
+        "L0:"                                       "\n"
+        "@c : bool = true"                          "\n"
+        "@a.1 : uint8 = 1"                          "\n"
+        "@b.1 : uint8 = 2"                          "\n"
+        "if_false @c jump L2"                       "\n"
+        "L1:"                                       "\n"
+        "@a.2 : uint8 = 3"                          "\n"
+        "@b.2 : uint8 = 4"                          "\n"
+        "L2:"                                       "\n"
+        "@b.3 : uint8 = phi(@b.1 L0, @a.2 L1)"      "\n"
+        "@a.3 : uint8 = phi(@a.1 L0, @b.2 L1)"      "\n"
+        "@d : uint8 = @a.3"                         "\n"
+        "@e : uint8 = @b.3"                         "\n"
+    ));
+    fl_cstring_free(codegen);
+
+    flut_expect_compat("SSA destruction must remove 2 phi instructions", zir_ssa_destruct(program) == 2);
+    flut_expect_compat("The program out of SSA form must be valid", zir_program_verify(program, NULL));
+
+    codegen = zir_program_dump(program);
+    flut_expect_compat("The swap must save one of the values in a new symbol", flm_cstring_equals(codegen,
+        "@c : bool = true"                          "\n"
+        "@a : uint8 = 1"                            "\n"
+        "@b : uint8 = 2"                            "\n"
+        "if_false @c jump L2"                       "\n"
+        "@a : uint8 = 3"                            "\n"
+        "@b : uint8 = 4"                            "\n"
+        "@$swap0 : uint8 = @b"                      "\n"
+        "@b : uint8 = @a"                           "\n"
+        "@a : uint8 = @$swap0"                      "\n"
+        "L2:"                                       "\n"
+        "@d : uint8 = @a"                           "\n"
+        "@e : uint8 = @b"                           "\n"
+    ));
+    fl_cstring_free(codegen);
+
+    flut_expect_compat("The swap symbol must be local to the block", zir_symtable_has(&program->global->symtable, "$swap0")
+        && zir_symtable_get(&program->global->symtable, "$swap0")->linkage == ZIR_LINKAGE_LOCAL);
+
+    bool has_phis = false;
+    for (size_t i=0; i < fl_array_length(cfg->blocks) && !has_phis; i++)
+        for (size_t j=0; j < fl_array_length(cfg->blocks[i]->instructions) && !has_phis; j++)
+            has_phis = cfg->blocks[i]->instructions[j]->type == ZIR_INSTR_PHI;
+
+    flut_expect_compat("The phi instructions must not be left for the NES lowering", !has_phis);
+
+    zir_program_free(program);
+}
+
+static size_t break_cfg_pass(ZirProgram *program)
+{
+    program->global->cfg.blocks[0]->index = 7;
+    return 1;
+}
+
+void zenit_test_zir_pass_manager(void)
+{
+    const char *zenit_source = 
+        "if (true) { var a = 1; } else { var b = 2; }"                                  "\n"
+        "if (false) { var c = 3; }"                                                     "\n"
+    ;
+
+    ZirOptLevel levels[] = { ZIR_OPT_O0, ZIR_OPT_O1, ZIR_OPT_O2 };
+
+    for (size_t i=0; i < sizeof(levels) / sizeof(levels[0]); i++)
+    {
+        ZirProgram *program = generate_zir(zenit_source);
+        ZirPassManager *manager = zir_pass_manager_new(levels[i]);
+        zir_pass_manager_register_defaults(manager);
+
+        flut_expect_compat("The passes must leave the program in a valid state", zir_pass_manager_run(manager, program));
+
+        ZirPass *fold_if = NULL;
+        ZirPass *forward_temps = NULL;
+        for (size_t j=0; j < fl_array_length(manager->passes); j++)
+        {
+            ZirPass *pass = &manager->passes[j];
+
+            flut_vexpect_compat(pass->executed == (pass->level <= levels[i]), "Pass %s must run only if its level is enabled at level O%zu", pass->name, i);
+
+            if (flm_cstring_equals(pass->name, "fold-if"))
+                fold_if = pass;
+
+            if (flm_cstring_equals(pass->name, "forward-temps"))
+                forward_temps = pass;
+        }
+
+        flut_vexpect_compat(forward_temps != NULL && forward_temps->executed, "The back end needs the forward-temps pass at level O%zu", i);
+
+        flut_expect_compat("The default pipeline must contain the fold-if pass", fold_if != NULL && fold_if->level == ZIR_OPT_O1);
+
+        if (levels[i] >= ZIR_OPT_O1)
+            flut_expect_compat("fold-if must fold the 2 if statements", fold_if->changes == 2);
+
+        char *report = zir_pass_manager_report(manager, fl_cstring_new(0));
+        flut_vexpect_compat((strstr(report, "fold-if") != NULL) == (levels[i] >= ZIR_OPT_O1), "The report must list the passes executed at level O%zu", i);
+        fl_cstring_free(report);
+
+        zir_pass_manager_free(manager);
+        zir_program_free(program);
+    }
+
+    ZirProgram *program = generate_zir(zenit_source);
+    ZirPassManager *manager = zir_pass_manager_new(ZIR_OPT_O0);
+    zir_pass_manager_register(manager, "break-cfg", ZIR_OPT_O0, &break_cfg_pass);
+
+    flut_expect_compat("The pass manager must report the pass that breaks the CFG", !zir_pass_manager_run(manager, program));
+    flut_expect_compat("The error must name the pass", manager->error != NULL && strstr(manager->error, "break-cfg") != NULL);
+
+    // Restore the index to free the program
+    program->global->cfg.blocks[0]->index = 0;
+
+    zir_pass_manager_free(manager);
+    zir_program_free(program);
+}
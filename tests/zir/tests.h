@@ -4,8 +4,19 @@
 void zenit_test_generate_ir_variables(void);
 void zenit_test_generate_ir_variables_clash(void);
 void zenit_test_generate_ir_casts(void);
+void zenit_test_forward_ir_temporaries(void);
 void zenit_test_generate_ir_struct_decl(void);
 void zenit_test_generate_ir_struct(void);
 void zenit_test_generate_ir_if(void);
+void zenit_test_fold_ir_if(void);
+void zenit_test_generate_ir_if_cfg(void);
+void zenit_test_ssa_construct(void);
+void zenit_test_ssa_destruct_copies(void);
+void zenit_test_ssa_destruct_swap(void);
+void zenit_test_zir_pass_manager(void);
+void zenit_test_eliminate_dead_globals(void);
+void zenit_test_zir_type_interning(void);
+void zenit_test_zir_slab(void);
+void zenit_test_zir_link(void);
 
 #endif /* ZENIT_TESTS_ZIRGEN_H */
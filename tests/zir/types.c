@@ -0,0 +1,104 @@
+#include <stdio.h>
+
+#include <flut/flut.h>
+#include "../../src/front-end/type-check/check.h"
+#include "../../src/front-end/inference/infer.h"
+#include "../../src/front-end/parser/parse.h"
+#include "../../src/front-end/binding/resolve.h"
+#include "../../src/front-end/symtable.h"
+#include "../../src/front-end/codegen/zir.h"
+#include "tests.h"
+
+static ZirOperand* variable_source(ZirProgram *program, size_t index)
+{
+    return ((ZirVariableInstr*) program->global->cfg.blocks[0]->instructions[index])->source;
+}
+
+static ZirType* variable_type(ZirProgram *program, size_t index)
+{
+    return ((ZirSymbolOperand*) program->global->cfg.blocks[0]->instructions[index]->destination)->symbol->type;
+}
+
+void zenit_test_zir_type_interning(void)
+{
+    const char *zenit_source =
+        "struct Point { x: uint8; y: uint8; }"                      "\n"
+        "var a = 0x00;"                                             "\n"
+        "var b = 0x00;"                                             "\n"
+        "var c : uint16 = 0x00;"                                    "\n"
+        "var d = true;"                                             "\n"
+        "var e = true;"                                             "\n"
+        "var f = [ 1, 2 ];"                                         "\n"
+        "var g = [ 3, 4 ];"                                         "\n"
+        "var h = &a;"                                               "\n"
+        "var i = &b;"                                               "\n"
+        "var j = Point { x: 1, y: 2 };"                             "\n"
+        "var k = Point { x: 0, y: 0 };"                             "\n"
+        "var l = { x: 1, y: 2 };"                                   "\n"
+        "var m = { x: 0, y: 0 };"                                   "\n"
+    ;
+
+    const char *zir_src =
+        "struct Point { x: uint8, y: uint8 }"                       "\n"
+        "@a : uint8 = 0"                                            "\n"
+        "@b : uint8 = 0"                                            "\n"
+        "@c : uint16 = 0"                                           "\n"
+        "@d : bool = true"                                          "\n"
+        "@e : bool = true"                                          "\n"
+        "@f : [2]uint8 = [ 1, 2 ]"                                  "\n"
+        "@g : [2]uint8 = [ 3, 4 ]"                                  "\n"
+        "@h : &uint8 = ref @a"                                      "\n"
+        "@i : &uint8 = ref @b"                                      "\n"
+        "@j : Point = { x: 1, y: 2 }"                               "\n"
+        "@k : Point = { x: 0, y: 0 }"                               "\n"
+        "@l : { x: uint8, y: uint8 } = { x: 1, y: 2 }"              "\n"
+        "@m : { x: uint8, y: uint8 } = { x: 0, y: 0 }"              "\n"
+    ;
+
+    ZenitContext ctx = zenit_context_new(ZENIT_SOURCE_STRING, zenit_source);
+
+    flut_expect_compat("Parsing should not contain errors", zenit_parse_source(&ctx));
+    flut_expect_compat("Symbol resolving pass should not contain errors", zenit_resolve_symbols(&ctx));
+    flut_expect_compat("Type inference pass should not contain errors", zenit_infer_types(&ctx));
+    flut_expect_compat("Type check pass should not contain errors", zenit_check_types(&ctx));
+
+    ZirProgram *program = zenit_generate_zir(&ctx);
+
+    flut_expect_compat("ZIR program must compile", program != NULL);
+
+    zenit_context_free(&ctx);
+
+    char *codegen = zir_program_dump(program);
+    flut_expect_compat("Interning must not change the generated ZIR", flm_cstring_equals(codegen, zir_src));
+    fl_cstring_free(codegen);
+
+    // Primitive types are singletons
+    flut_expect_compat("uint8 must be a singleton", variable_type(program, 0) == variable_type(program, 1)
+        && variable_type(program, 0) == (ZirType*) zir_type_ctx_new_uint(program->types, ZIR_UINT_8));
+    flut_expect_compat("uint8 and uint16 must be different types", variable_type(program, 0) != variable_type(program, 2));
+    flut_expect_compat("bool must be a singleton", variable_type(program, 3) == variable_type(program, 4)
+        && variable_type(program, 3) == (ZirType*) zir_type_ctx_new_bool(program->types));
+
+    // Composite types are interned structurally
+    flut_expect_compat("Equal array types must be the same object", variable_type(program, 5) == variable_type(program, 6)
+        && variable_type(program, 5) == (ZirType*) zir_type_ctx_new_array(program->types, variable_type(program, 0), 2));
+    flut_expect_compat("Arrays of different length must be different types", variable_type(program, 5) != (ZirType*) zir_type_ctx_new_array(program->types, variable_type(program, 0), 3));
+    flut_expect_compat("Equal reference types must be the same object", variable_type(program, 7) == variable_type(program, 8));
+    flut_expect_compat("Named structs must be the same object", variable_type(program, 9) == variable_type(program, 10)
+        && variable_type(program, 9) == (ZirType*) zir_type_ctx_get_named_struct(program->types, "Point"));
+    flut_expect_compat("Structurally equal unnamed structs must be the same object", variable_type(program, 11) == variable_type(program, 12));
+    flut_expect_compat("Named and unnamed structs must be different types", variable_type(program, 9) != variable_type(program, 11));
+
+    // Constant operands are shared
+    flut_expect_compat("Repeated uint literals must share the operand", variable_source(program, 0) == variable_source(program, 1));
+    flut_expect_compat("The implicit upcast must reuse the uint8 literal", variable_source(program, 0) == variable_source(program, 2));
+    flut_expect_compat("Literals of different types must not share the operand", variable_source(program, 0)
+        != (ZirOperand*) zir_operand_pool_new_uint(program->operands, zir_type_ctx_new_uint(program->types, ZIR_UINT_16), (ZirUintValue) { .uint16 = 0 }));
+    flut_expect_compat("Repeated bool literals must share the operand", variable_source(program, 3) == variable_source(program, 4));
+
+    ZirStructOperand *point_a = (ZirStructOperand*) variable_source(program, 9);
+    ZirStructOperand *anon_a = (ZirStructOperand*) variable_source(program, 11);
+    flut_expect_compat("Struct members must share the constants", point_a->members[0]->operand == anon_a->members[0]->operand);
+
+    zir_program_free(program);
+}